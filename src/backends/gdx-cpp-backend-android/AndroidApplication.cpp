@@ -28,8 +28,7 @@ using namespace gdx_cpp;
 
 gdx_cpp::backends::android::AndroidApplication::AndroidApplication(gdx_cpp::ApplicationListener* listener,
         const std::string& title, int width, int height, bool useGL20IfAvailable)
-        :  Synchronizable(Gdx::system->getMutexFactory())
-        , title(title)
+        : title(title)
         , useGL20iFAvailable(useGL20IfAvailable)
         , width(width)
         , height(height)
@@ -59,19 +58,21 @@ void backends::android::AndroidApplication::onRunnableStop()
 
 void backends::android::AndroidApplication::run()
 {
+    // nothing may hold on to the last frame's temporaries
+    frameArena.reset();
     graphics->updateTime();
 
     {
-        lock_holder hnd = synchronize();
+        // runnables posted while these run wait for the next frame
+        Runnable::ptr runnable;
+        while (runnables.poll(runnable))
+            executedRunnables.push_back(runnable);
 
-        std::list < Runnable::ptr >::iterator it = runnables.begin();
-        std::list < Runnable::ptr >::iterator end = runnables.end();
-
-        for (;it != end; ++it) {
-            (*it)->run();
+        for (size_t i = 0; i < executedRunnables.size(); i++) {
+            executedRunnables[i]->run();
         }
 
-        runnables.clear();
+        executedRunnables.clear();
     }
 
     listener->render();
@@ -159,8 +160,7 @@ int gdx_cpp::backends::android::AndroidApplication::getVersion()
 
 void gdx_cpp::backends::android::AndroidApplication::postRunnable(Runnable::ptr runnable)
 {
-    lock_holder hnd = synchronize();
-    runnables.push_back(runnable);
+    runnables.put(runnable);
 }
 
 void gdx_cpp::backends::android::AndroidApplication::setLogLevel(int logLevel)
@@ -19,12 +19,11 @@
 #define GDX_CPP_BACKENDS_ANDROID_APPLICATION_HPP
 
 #include <gdx-cpp/Application.hpp>
-#include <list>
+#include <vector>
 #include <gdx-cpp/ApplicationListener.hpp>
 #include "AndroidGraphics.hpp"
 #include <gdx-cpp/implementation/Thread.hpp>
-#include <gdx-cpp/implementation/Mutex.hpp>
-#include <gdx-cpp/utils/Synchronized.hpp>
+#include <gdx-cpp/utils/MpscQueue.hpp>
 #include "AndroidInput.hpp"
 
 namespace gdx_cpp {
@@ -33,7 +32,7 @@ namespace backends {
 
 namespace android {
 
-class AndroidApplication : public Application, public Runnable, public Synchronizable
+class AndroidApplication : public Application, public Runnable
 {
 public:
     AndroidApplication(gdx_cpp::ApplicationListener* listener, const std::string& title, int width, int height, bool useGL20IfAvailable);
@@ -68,7 +67,9 @@ protected:
     AndroidGraphics* graphics;
     AndroidInput* input;
     
-    std::list< Runnable::ptr > runnables;
+    /** posted from any thread, drained by the main loop */
+    utils::MpscQueue< Runnable::ptr > runnables;
+    std::vector< Runnable::ptr > executedRunnables;
 
     gdx_cpp::implementation::Thread::ptr mainLoopThread;
     
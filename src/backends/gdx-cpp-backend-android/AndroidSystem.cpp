@@ -33,25 +33,6 @@
 
 using namespace gdx_cpp::backends::android;
 
-class AndroidMutex : public gdx_cpp::implementation::Mutex {
-public:
-    AndroidMutex()
-    {
-        pthread_mutex_init(&mutex, NULL);
-    }
-    
-    void lock(){
-        pthread_mutex_lock(&mutex);
-    }
-
-   void unlock() {
-       pthread_mutex_unlock(&mutex);
-   }
-
-protected:
-    pthread_mutex_t mutex;
-};
-
 void* run_runnable(void* runnable) {
     ((Runnable*)runnable)->run();
 
@@ -106,11 +87,6 @@ gdx_cpp::implementation::Thread::ptr gdx_cpp::backends::android::AndroidSystem::
     return gdx_cpp::implementation::Thread::ptr(new AndroidThread(t));
 }
 
-gdx_cpp::implementation::Mutex::ptr gdx_cpp::backends::android::AndroidSystem::AndroidMutexFactory::createMutex()
-{
-    return gdx_cpp::implementation::Mutex::ptr(new AndroidMutex);
-}
-
 uint64_t gdx_cpp::backends::android::AndroidSystem::nanoTime()
 {
     static timespec ts;
@@ -39,11 +39,6 @@ public:
         implementation::Thread::ptr createThread(Runnable* t);
 };
 
-class AndroidMutexFactory : public gdx_cpp::implementation::MutexFactory {
-public:
-        implementation::Mutex::ptr createMutex();
-};
-
 public:
     uint64_t nanoTime();
 
@@ -51,10 +46,6 @@ public:
         return &threadFactory;
     }
 
-    AndroidMutexFactory* getMutexFactory() {
-        return &mutexFactory;
-    }
-
     std::string canonicalize(std::string& path);
     void checkDelete(const std::string& path);
     void checkRead(const std::string& path);
@@ -76,7 +67,6 @@ public:
     
 private:
     AndroidThreadFactory threadFactory;
-    AndroidMutexFactory mutexFactory;
 };
 
 }
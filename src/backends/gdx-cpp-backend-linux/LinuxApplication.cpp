@@ -21,6 +21,7 @@
 #include <gdx-cpp/Graphics.hpp>
 #include <gdx-cpp/Gdx.hpp>
 #include <gdx-cpp/implementation/System.hpp>
+#include <gdx-cpp/utils/LockProfiler.hpp>
 
 using namespace gdx_cpp::backends::nix;
 using namespace gdx_cpp;
@@ -28,8 +29,7 @@ using namespace gdx_cpp;
 gdx_cpp::backends::nix::LinuxApplication::LinuxApplication(gdx_cpp::ApplicationListener* listener,
                                                            const std::string& title, int width, int height,
                                                            bool useGL20IfAvailable)
-:  Synchronizable(Gdx::system->getMutexFactory())
-    , width(width)
+: width(width)
     , height(height)
     , title(title)
     , useGL20iFAvailable(useGL20IfAvailable)
@@ -65,6 +65,8 @@ void backends::nix::LinuxApplication::run()
     listener->resize(graphics->getWidth(), graphics->getHeight());
     
     while (true) {
+        // nothing may hold on to the last frame's temporaries
+        frameArena.reset();
         graphics->updateTime();
 
         SDL_Event event;
@@ -79,16 +81,16 @@ void backends::nix::LinuxApplication::run()
         }        
         
         {
-            lock_holder hnd = synchronize();
+            // runnables posted while these run wait for the next frame
+            Runnable::ptr runnable;
+            while (runnables.poll(runnable))
+                executedRunnables.push_back(runnable);
 
-            std::list < Runnable::ptr >::iterator it = runnables.begin();
-            std::list < Runnable::ptr >::iterator end = runnables.end();
-
-            for(;it != end; ++it) {
-                (*it)->run();
+            for (size_t i = 0; i < executedRunnables.size(); i++) {
+                executedRunnables[i]->run();
             }
 
-            runnables.clear();
+            executedRunnables.clear();
         }
         
         listener->render();
@@ -112,6 +114,9 @@ void LinuxApplication::error(const std::string& tag, const char* format, ...)
 
 void gdx_cpp::backends::nix::LinuxApplication::exit()
 {
+#if defined(GDX_CPP_LOCK_PROFILING)
+    utils::LockSite::report(std::cerr);
+#endif
     ::exit(0);
 }
 
@@ -165,8 +170,7 @@ int gdx_cpp::backends::nix::LinuxApplication::getVersion()
 
 void gdx_cpp::backends::nix::LinuxApplication::postRunnable(Runnable::ptr runnable)
 {
-    lock_holder hnd = synchronize();
-    runnables.push_back(runnable);
+    runnables.put(runnable);
 }
 
 void gdx_cpp::backends::nix::LinuxApplication::setLogLevel(int logLevel)
@@ -19,12 +19,11 @@
 #define GDX_CPP_BACKENDS_LINUX_LINUXAPPLICATION_HPP
 
 #include <gdx-cpp/Application.hpp>
-#include <list>
+#include <vector>
 #include <gdx-cpp/ApplicationListener.hpp>
 #include "LinuxGraphics.hpp"
 #include <gdx-cpp/implementation/Thread.hpp>
-#include <gdx-cpp/implementation/Mutex.hpp>
-#include <gdx-cpp/utils/Synchronized.hpp>
+#include <gdx-cpp/utils/MpscQueue.hpp>
 #include "LinuxInput.hpp"
 
 namespace gdx_cpp {
@@ -33,7 +32,7 @@ namespace backends {
 
 namespace nix {
 
-class LinuxApplication : public Application, public Runnable, public Synchronizable
+class LinuxApplication : public Application, public Runnable
 {
 public:
     LinuxApplication(gdx_cpp::ApplicationListener* listener, const std::string& title,
@@ -64,7 +63,9 @@ protected:
     LinuxGraphics* graphics;
     LinuxInput* input;
     
-    std::list< Runnable::ptr > runnables;
+    /** posted from any thread, drained by the main loop */
+    utils::MpscQueue< Runnable::ptr > runnables;
+    std::vector< Runnable::ptr > executedRunnables;
 
     gdx_cpp::implementation::Thread::ptr mainLoopThread;
     
@@ -118,27 +118,7 @@ void LinuxSystem::checkWrite(const std::string& path)
 
 }
 
-class LinuxMutex : public gdx_cpp::implementation::Mutex {
-public:
-    LinuxMutex()
-    {
-        pthread_mutex_init(&mutex, NULL);
-    }
-    
-    void lock(){
-        pthread_mutex_lock(&mutex);
-    }
-
-   void unlock() {
-       pthread_mutex_unlock(&mutex);
-   }
-
-protected:
-    pthread_mutex_t mutex;
-};
-
 void* run_runnable(void* runnable) {
-    std::cout << "chamou runnable" << std::endl;
     ((Runnable*)runnable)->run();
 
     return NULL;
@@ -162,11 +142,12 @@ public:
     }
 
     void join() {
-        std::cout << "antes do join" << std::endl;
+        // the destructor joins as well, joining twice is a no-op
+        if (thread == 0) return;
         if( pthread_join(thread, NULL) != 0) {
             throw std::runtime_error("pthread_join failed");
         }
-        std::cout << "depois do join" << std::endl;
+        thread = 0;
     }
 
     void sleep(long int millis) {
@@ -192,11 +173,6 @@ gdx_cpp::implementation::Thread::ptr gdx_cpp::backends::nix::LinuxSystem::LinuxT
     return gdx_cpp::implementation::Thread::ptr(new LinuxThread(t));
 }
 
-gdx_cpp::implementation::Mutex::ptr gdx_cpp::backends::nix::LinuxSystem::LinuxMutexFactory::createMutex()
-{
-    return gdx_cpp::implementation::Mutex::ptr(new LinuxMutex);
-}
-
 uint64_t gdx_cpp::backends::nix::LinuxSystem::nanoTime()
 {
     static timespec ts;
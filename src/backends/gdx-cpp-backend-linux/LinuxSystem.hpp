@@ -39,11 +39,6 @@ public:
         implementation::Thread::ptr createThread(Runnable* t);
 };
 
-class LinuxMutexFactory : public gdx_cpp::implementation::MutexFactory {
-public:
-        implementation::Mutex::ptr createMutex();
-};
-
 public:
     uint64_t nanoTime();
 
@@ -51,9 +46,6 @@ public:
         return &threadFactory;
     }
 
-    LinuxMutexFactory* getMutexFactory() {
-        return &mutexFactory;
-    }
     std::string canonicalize(std::string& path);
     void checkDelete(const std::string& path);
     void checkRead(const std::string& path);
@@ -75,7 +67,6 @@ public:
     
 private:
     LinuxThreadFactory threadFactory;
-    LinuxMutexFactory mutexFactory;
 };
 
 }
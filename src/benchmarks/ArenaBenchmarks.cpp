@@ -0,0 +1,90 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Benchmark.hpp"
+#include "gdx-cpp/math/CatmullRomSpline.hpp"
+#include "gdx-cpp/math/EarClippingTriangulator.hpp"
+#include "gdx-cpp/utils/FrameArena.hpp"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace gdx_cpp::math;
+using namespace gdx_cpp::utils;
+using namespace gdx_cpp::benchmarks;
+
+namespace {
+
+/** The kind of temporaries a frame builds: a spline path, a triangulated outline, a list of ids and a label. Reported
+ * per frame, the arena is reset at the start of each like the application loop does. */
+class FrameTemporariesBenchmark : public Benchmark {
+public:
+    FrameTemporariesBenchmark (const std::string& name, bool useArena)
+    : Benchmark(name, 1, "frame")
+    , useArena(useArena)
+    {
+        for (int i = 0; i < 8; i++)
+            spline.add(Vector3(i * 10.0f, std::sin(i * 0.8f) * 20, 0));
+        for (int i = 0; i < 64; i++) {
+            float angle = 2 * 3.1415927f * i / 64;
+            float radius = i % 2 ? 100 : 60;
+            outline.push_back(Vector2(std::cos(angle) * radius, std::sin(angle) * radius));
+        }
+    }
+
+    void run () {
+        if (useArena) {
+            arena.reset();
+            LinearAllocator& allocator = arena.local();
+            ArenaVector<Vector3> path = spline.getPath(16, allocator);
+            ArenaVector<Vector2> triangles = triangulator.computeTriangles(outline, allocator);
+            ArenaVector<int> ids(allocator);
+            ArenaString label(allocator);
+            build(path, triangles, ids, label);
+        } else {
+            std::vector<Vector3> path = spline.getPath(16);
+            std::vector<Vector2> triangles = triangulator.computeTriangles(outline);
+            std::vector<int> ids;
+            std::string label;
+            build(path, triangles, ids, label);
+        }
+    }
+
+private:
+    bool useArena;
+    FrameArena arena;
+    CatmullRomSpline spline;
+    EarClippingTriangulator triangulator;
+    std::vector<Vector2> outline;
+
+    template < class Path, class Triangles, class Ids, class Label >
+    void build (const Path& path, const Triangles& triangles, Ids& ids, Label& label) {
+        // growing would leave every outgrown buffer behind in the arena
+        ids.reserve(256);
+        label.reserve(path.size() * 5);
+        for (int i = 0; i < 256; i++)
+            ids.push_back(i);
+        for (unsigned int i = 0; i < path.size(); i++)
+            label += path[i].y > 0 ? "up " : "down ";
+        doNotOptimize(triangles[0].x + label.size() + ids.back());
+    }
+};
+
+FrameTemporariesBenchmark heap("arena/frame-temporaries/heap", false);
+FrameTemporariesBenchmark frameArena("arena/frame-temporaries/frame-arena", true);
+
+}
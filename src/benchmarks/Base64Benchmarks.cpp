@@ -0,0 +1,101 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Benchmark.hpp"
+#include "gdx-cpp/utils/Base64Coder.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace gdx_cpp::utils;
+using namespace gdx_cpp::benchmarks;
+
+namespace {
+
+const int PAYLOAD_SIZE = 1 << 20;
+
+enum Operation {
+    ENCODE,
+    DECODE,
+    /** MIME style, a line break every 76 characters */
+    DECODE_LINES,
+    /** the same through a Base64Decoder, fed in network sized pieces */
+    DECODE_STREAM
+};
+
+/** Encodes or decodes a megabyte of random bytes per run, reported per byte of binary data */
+class Base64Benchmark : public Benchmark {
+public:
+    Base64Benchmark (const std::string& name, Operation operation)
+    : Benchmark(name, PAYLOAD_SIZE, "byte")
+    , operation(operation)
+    {
+    }
+
+    void setUp () {
+        std::mt19937 random(11);
+        data.resize(PAYLOAD_SIZE);
+        for (size_t i = 0; i < data.size(); i++)
+            data[i] = (unsigned char) random();
+        if (operation == DECODE_LINES) text = Base64Coder::encodeLines(&data[0], data.size());
+        else text = Base64Coder::encodeString(std::string(data.begin(), data.end()));
+        out.resize(Base64Coder::decodedMaxLength(text.size()) + Base64Coder::encodedLength(data.size()));
+    }
+
+    void run () {
+        switch (operation) {
+        case ENCODE:
+            doNotOptimize(Base64Coder::encode(&data[0], data.size(), (char*) &out[0]));
+            break;
+        case DECODE:
+        case DECODE_LINES:
+            doNotOptimize(Base64Coder::decode(text.data(), text.size(), &out[0], out.size()));
+            break;
+        case DECODE_STREAM: {
+            const size_t PIECE = 1400;
+            size_t written = 0;
+            for (size_t i = 0; i < text.size(); i += PIECE) {
+                size_t piece = text.size() - i < PIECE ? text.size() - i : PIECE;
+                written += decoder.decode(text.data() + i, piece, &out[written], out.size() - written);
+            }
+            decoder.finish();
+            doNotOptimize(written);
+            break;
+        }
+        }
+    }
+
+    void tearDown () {
+        data = std::vector<unsigned char>();
+        out = std::vector<unsigned char>();
+        text = std::string();
+    }
+
+private:
+    Operation operation;
+    std::vector<unsigned char> data;
+    std::vector<unsigned char> out;
+    std::string text;
+    Base64Decoder decoder;
+};
+
+Base64Benchmark encode("base64/encode", ENCODE);
+Base64Benchmark decode("base64/decode", DECODE);
+Base64Benchmark decodeLines("base64/decode-lines", DECODE_LINES);
+Base64Benchmark decodeStream("base64/decode-stream", DECODE_STREAM);
+
+}
@@ -0,0 +1,247 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Benchmark.hpp"
+#include "gdx-cpp/utils/Simd.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <iomanip>
+#include <locale>
+
+#ifndef GDX_CPP_BENCH_BUILD_TYPE
+#define GDX_CPP_BENCH_BUILD_TYPE ""
+#endif
+
+using namespace gdx_cpp::benchmarks;
+
+Benchmark::Benchmark (const std::string& name, int items, const std::string& unit)
+: items(items)
+, name(name)
+, unit(unit)
+{
+    all().push_back(this);
+}
+
+Benchmark::~Benchmark () {
+    std::vector<Benchmark*>& benchmarks = all();
+    benchmarks.erase(std::remove(benchmarks.begin(), benchmarks.end(), this), benchmarks.end());
+}
+
+const std::string& Benchmark::getName () const {
+    return name;
+}
+
+const std::string& Benchmark::getUnit () const {
+    return unit;
+}
+
+int Benchmark::getItems () const {
+    return items;
+}
+
+std::vector<Benchmark*>& Benchmark::all () {
+    static std::vector<Benchmark*> benchmarks;
+    return benchmarks;
+}
+
+FunctionBenchmark::FunctionBenchmark (const std::string& name, Function function, int items, const std::string& unit)
+: Benchmark(name, items, unit)
+, function(function)
+{
+}
+
+void FunctionBenchmark::run () {
+    function();
+}
+
+static double now () {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/** Runs the benchmark iterations times and returns the elapsed nanoseconds */
+static double sample (Benchmark& benchmark, long long iterations) {
+    double start = now();
+    for (long long i = 0; i < iterations; i++)
+        benchmark.run();
+    return now() - start;
+}
+
+static double median (std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    size_t n = values.size();
+    return n % 2 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2;
+}
+
+/** Two sided 95% quantile of Student's t distribution */
+static double studentT95 (int degreesOfFreedom) {
+    static const double table[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    if (degreesOfFreedom < 1) return 0;
+    if (degreesOfFreedom <= 30) return table[degreesOfFreedom - 1];
+    return 1.96;
+}
+
+Runner::Runner ()
+: samples(20)
+, warmupSamples(3)
+, minSampleTime(20e6)
+{
+}
+
+Result Runner::run (Benchmark& benchmark) {
+    benchmark.setUp();
+
+    // double the iterations until a sample is long enough for the clock's resolution and the noise to not matter
+    long long iterations = 1;
+    while (sample(benchmark, iterations) < minSampleTime && iterations < (1LL << 40))
+        iterations *= 2;
+
+    for (int i = 0; i < warmupSamples; i++)
+        sample(benchmark, iterations);
+
+    double perItem = 1.0 / ((double) iterations * benchmark.getItems());
+    std::vector<double> times(samples);
+    for (int i = 0; i < samples; i++)
+        times[i] = sample(benchmark, iterations) * perItem;
+
+    benchmark.tearDown();
+
+    Result result;
+    result.name = benchmark.getName();
+    result.unit = benchmark.getUnit();
+    result.items = benchmark.getItems();
+    result.iterations = iterations;
+    result.samples = samples;
+    result.min = *std::min_element(times.begin(), times.end());
+    result.max = *std::max_element(times.begin(), times.end());
+
+    double sum = 0;
+    for (int i = 0; i < samples; i++)
+        sum += times[i];
+    result.mean = sum / samples;
+
+    double squares = 0;
+    for (int i = 0; i < samples; i++)
+        squares += (times[i] - result.mean) * (times[i] - result.mean);
+    result.stddev = samples > 1 ? std::sqrt(squares / (samples - 1)) : 0;
+
+    result.median = median(times);
+    std::vector<double> deviations(samples);
+    for (int i = 0; i < samples; i++)
+        deviations[i] = std::fabs(times[i] - result.median);
+    result.mad = 1.4826 * median(deviations);
+
+    double halfWidth = studentT95(samples - 1) * result.stddev / std::sqrt((double) samples);
+    result.ciLow = result.mean - halfWidth;
+    result.ciHigh = result.mean + halfWidth;
+
+    result.outliers = 0;
+    for (int i = 0; i < samples; i++)
+        if (deviations[i] > 3 * result.mad) result.outliers++;
+
+    return result;
+}
+
+std::vector<Result> Runner::runAll (std::ostream& table) {
+    std::vector<Result> results;
+    std::vector<Benchmark*>& benchmarks = Benchmark::all();
+    for (unsigned int i = 0; i < benchmarks.size(); i++) {
+        if (benchmarks[i]->getName().find(filter) == std::string::npos) continue;
+        results.push_back(run(*benchmarks[i]));
+        printRow(table, results.back());
+    }
+    return results;
+}
+
+void Runner::printHeader (std::ostream& out) {
+    out << std::left << std::setw(36) << "benchmark" << std::right
+        << std::setw(16) << "median" << std::setw(13) << "mad" << std::setw(16) << "min"
+        << std::setw(10) << "outliers" << "  unit" << std::endl;
+}
+
+void Runner::printRow (std::ostream& out, const Result& result) {
+    std::ios::fmtflags flags = out.flags();
+    out << std::left << std::setw(36) << result.name << std::right << std::fixed << std::setprecision(2)
+        << std::setw(13) << result.median << " ns" << std::setw(10) << result.mad << " ns"
+        << std::setw(13) << result.min << " ns" << std::setw(10) << result.outliers << "  ns/" << result.unit;
+    // throughput is easier to compare for parsers and codecs
+    if (result.unit == "byte" && result.median > 0) out << "  (" << 1e3 / result.median << " MB/s)";
+    out << std::endl;
+    out.flags(flags);
+}
+
+static void writeString (std::ostream& out, const std::string& value) {
+    out << '"';
+    for (unsigned int i = 0; i < value.size(); i++) {
+        char c = value[i];
+        if (c == '"' || c == '\\') out << '\\' << c;
+        else if ((unsigned char) c < 0x20) out << "\\u00" << "0123456789abcdef"[c >> 4] << "0123456789abcdef"[c & 15];
+        else out << c;
+    }
+    out << '"';
+}
+
+void Runner::writeJson (std::ostream& out, const std::vector<Result>& results) {
+    std::locale previous = out.imbue(std::locale::classic());
+    std::ios::fmtflags flags = out.flags();
+    out << std::setprecision(6);
+
+    char timestamp[32];
+    time_t seconds = std::time(NULL);
+    strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", gmtime(&seconds));
+
+    out << "{\n  \"context\": {\n    \"timestamp\": ";
+    writeString(out, timestamp);
+    out << ",\n    \"instructionSet\": ";
+    writeString(out, gdx_cpp::utils::simd::instructionSet());
+    out << ",\n    \"buildType\": ";
+    writeString(out, GDX_CPP_BENCH_BUILD_TYPE);
+#ifdef __VERSION__
+    out << ",\n    \"compiler\": ";
+    writeString(out, __VERSION__);
+#endif
+    out << "\n  },\n  \"benchmarks\": [";
+
+    for (unsigned int i = 0; i < results.size(); i++) {
+        const Result& result = results[i];
+        out << (i ? ",\n" : "\n") << "    {\"name\": ";
+        writeString(out, result.name);
+        out << ", \"unit\": ";
+        writeString(out, result.unit);
+        out << ", \"itemsPerRun\": " << result.items
+            << ", \"iterations\": " << result.iterations
+            << ", \"samples\": " << result.samples
+            << ", \"minNs\": " << result.min
+            << ", \"maxNs\": " << result.max
+            << ", \"meanNs\": " << result.mean
+            << ", \"medianNs\": " << result.median
+            << ", \"stddevNs\": " << result.stddev
+            << ", \"madNs\": " << result.mad
+            << ", \"ci95Ns\": [" << result.ciLow << ", " << result.ciHigh << "]"
+            << ", \"outliers\": " << result.outliers
+            << ", \"itemsPerSecond\": " << (result.median > 0 ? 1e9 / result.median : 0) << "}";
+    }
+    out << "\n  ]\n}\n";
+
+    out.flags(flags);
+    out.imbue(previous);
+}
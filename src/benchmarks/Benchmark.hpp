@@ -0,0 +1,124 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef GDX_CPP_BENCHMARKS_BENCHMARK_HPP_
+#define GDX_CPP_BENCHMARKS_BENCHMARK_HPP_
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace gdx_cpp {
+namespace benchmarks {
+
+/** A single benchmark case. Subclasses are instantiated statically, which registers them, prepare their data in
+ * setUp and do one unit of work per run() call. Results are reported per item, so a case that draws 1000 sprites per
+ * run reports the time per sprite. */
+class Benchmark {
+public:
+    /** name is "group/case", items the number of items one run() processes */
+    Benchmark (const std::string& name, int items = 1, const std::string& unit = "op");
+    virtual ~Benchmark ();
+
+    virtual void setUp () {}
+    virtual void run () = 0;
+    virtual void tearDown () {}
+
+    const std::string& getName () const;
+    const std::string& getUnit () const;
+    int getItems () const;
+
+    /** All registered benchmarks in registration order */
+    static std::vector<Benchmark*>& all ();
+
+protected:
+    int items;
+
+private:
+    std::string name;
+    std::string unit;
+};
+
+/** Wraps a plain function as a benchmark */
+class FunctionBenchmark : public Benchmark {
+public:
+    typedef void (*Function) ();
+
+    FunctionBenchmark (const std::string& name, Function function, int items = 1, const std::string& unit = "op");
+    void run ();
+
+private:
+    Function function;
+};
+
+/** Keeps the compiler from discarding a computation whose result is otherwise unused */
+template <typename T>
+inline void doNotOptimize (const T& value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+#endif
+}
+
+/** Statistics over the samples of one benchmark, all times in nanoseconds per item */
+struct Result {
+    std::string name;
+    std::string unit;
+    int items;
+    long long iterations;
+    int samples;
+    double min;
+    double max;
+    double mean;
+    double median;
+    double stddev;
+    /** median absolute deviation, scaled to estimate the standard deviation of normally distributed samples */
+    double mad;
+    /** 95% confidence interval of the mean */
+    double ciLow, ciHigh;
+    /** samples further than three MADs from the median */
+    int outliers;
+};
+
+class Runner {
+public:
+    Runner ();
+
+    /** Only benchmarks whose name contains filter are run */
+    std::string filter;
+    /** Measured samples per benchmark */
+    int samples;
+    /** Discarded samples run before measuring */
+    int warmupSamples;
+    /** Minimum duration of a sample, the iteration count is doubled until it is reached */
+    double minSampleTime;
+
+    /** Calibrates, warms up and samples the benchmark */
+    Result run (Benchmark& benchmark);
+    /** Runs every registered benchmark matching the filter, printing a table row for each */
+    std::vector<Result> runAll (std::ostream& table);
+
+    static void printHeader (std::ostream& out);
+    static void printRow (std::ostream& out, const Result& result);
+    static void writeJson (std::ostream& out, const std::vector<Result>& results);
+};
+
+} // namespace gdx_cpp
+} // namespace benchmarks
+
+#endif // GDX_CPP_BENCHMARKS_BENCHMARK_HPP_
@@ -0,0 +1,85 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Benchmark.hpp"
+#include "NullGraphics.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+using namespace gdx_cpp::benchmarks;
+
+static void usage (const char* program) {
+    std::cerr << "usage: " << program << " [options]\n"
+              << "  --filter <text>     only run benchmarks whose name contains text\n"
+              << "  --samples <n>       measured samples per benchmark (default 20)\n"
+              << "  --warmup <n>        discarded samples before measuring (default 3)\n"
+              << "  --min-time <ms>     minimum duration of one sample (default 20)\n"
+              << "  --json <file>       write the results as JSON, - for stdout\n"
+              << "  --list              list the benchmarks and exit\n";
+}
+
+int main (int argc, char** argv) {
+    Runner runner;
+    const char* jsonPath = NULL;
+    bool list = false;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (!strcmp(arg, "--filter") && hasValue) runner.filter = argv[++i];
+        else if (!strcmp(arg, "--samples") && hasValue) runner.samples = std::max(1, atoi(argv[++i]));
+        else if (!strcmp(arg, "--warmup") && hasValue) runner.warmupSamples = std::max(0, atoi(argv[++i]));
+        else if (!strcmp(arg, "--min-time") && hasValue) runner.minSampleTime = atof(argv[++i]) * 1e6;
+        else if (!strcmp(arg, "--json") && hasValue) jsonPath = argv[++i];
+        else if (!strcmp(arg, "--list")) list = true;
+        else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (list) {
+        std::vector<Benchmark*>& benchmarks = Benchmark::all();
+        for (unsigned int i = 0; i < benchmarks.size(); i++)
+            std::cout << benchmarks[i]->getName() << std::endl;
+        return 0;
+    }
+
+    initializeNullBackend(800, 480);
+
+    // with the JSON on stdout the table goes to stderr so the output stays parseable
+    bool jsonToStdout = jsonPath != NULL && !strcmp(jsonPath, "-");
+    std::ostream& table = jsonToStdout ? std::cerr : std::cout;
+    Runner::printHeader(table);
+    std::vector<Result> results = runner.runAll(table);
+
+    if (jsonToStdout) {
+        Runner::writeJson(std::cout, results);
+    } else if (jsonPath != NULL) {
+        std::ofstream file(jsonPath);
+        if (!file) {
+            std::cerr << "couldn't write " << jsonPath << std::endl;
+            return 1;
+        }
+        Runner::writeJson(file, results);
+    }
+
+    return 0;
+}
@@ -0,0 +1,186 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+#include "Benchmark.hpp"
+#include "gdx-cpp/utils/Buffer.hpp"
+#include "gdx-cpp/utils/BufferUtils.hpp"
+#include "gdx-cpp/math/Matrix3.hpp"
+#include "gdx-cpp/math/Matrix4.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace gdx_cpp::math;
+using namespace gdx_cpp::utils;
+using namespace gdx_cpp::benchmarks;
+
+namespace {
+
+/** a sprite's worth of vertices, the unit SpriteCache and SpriteBatch write in */
+const int CHUNK = 20;
+const int CHUNKS = 1 << 14;
+
+enum Operation {
+    /** one checked put(float) per element */
+    PUT_ELEMENT,
+    /** checked bulk put per sprite */
+    PUT_BULK,
+    /** putUnchecked per sprite */
+    PUT_UNCHECKED
+};
+
+/** Fills a float buffer with 16K sprites of vertices per run */
+class BufferPutBenchmark : public Benchmark {
+public:
+    BufferPutBenchmark (const std::string& name, Operation operation)
+    : Benchmark(name, CHUNKS * CHUNK * sizeof(float), "byte")
+    , operation(operation)
+    {
+    }
+
+    void setUp () {
+        buffer = float_buffer(CHUNKS * CHUNK);
+        vertices.resize(CHUNK);
+        for (int i = 0; i < CHUNK; i++)
+            vertices[i] = (float) i;
+    }
+
+    void run () {
+        buffer.clear();
+        const float* src = &vertices[0];
+        switch (operation) {
+        case PUT_ELEMENT:
+            for (int i = 0; i < CHUNKS; i++)
+                for (int j = 0; j < CHUNK; j++)
+                    buffer.put(src[j]);
+            break;
+        case PUT_BULK:
+            for (int i = 0; i < CHUNKS; i++)
+                buffer.put(src, CHUNK, 0, CHUNK);
+            break;
+        case PUT_UNCHECKED:
+            for (int i = 0; i < CHUNKS; i++)
+                buffer.putUnchecked(src, CHUNK);
+            break;
+        }
+        doNotOptimize(buffer.pointer()[buffer.position() - 1]);
+    }
+
+    void tearDown () {
+        buffer = float_buffer();
+        vertices = std::vector<float>();
+    }
+
+private:
+    Operation operation;
+    float_buffer buffer;
+    std::vector<float> vertices;
+};
+
+BufferPutBenchmark putElement("buffer/put-element", PUT_ELEMENT);
+BufferPutBenchmark putBulk("buffer/put-bulk", PUT_BULK);
+BufferPutBenchmark putUnchecked("buffer/put-unchecked", PUT_UNCHECKED);
+
+/** SpriteBatch's vertex layout: x, y, color, u, v */
+const int VERTEX_SIZE = 5;
+const int VERTICES = 1 << 16;
+
+enum BulkOperation {
+    /** 3D positions by a Matrix4, as Mesh::scale and Decal do */
+    TRANSFORM_MATRIX4,
+    /** 2D positions by an affine Matrix3, as SpriteCache's rotated sprites do */
+    TRANSFORM_MATRIX3,
+    /** rgba floats into the color slot */
+    PACK_COLORS,
+    TO_HALF_FLOATS,
+    TO_NORMALIZED_SHORTS,
+    /** repeats one vertex over the buffer */
+    FILL
+};
+
+/** BufferUtils' bulk operations over 64K interleaved vertices per run */
+class BufferUtilsBenchmark : public Benchmark {
+public:
+    BufferUtilsBenchmark (const std::string& name, BulkOperation operation)
+    : Benchmark(name, VERTICES, "vertex")
+    , operation(operation)
+    {
+    }
+
+    void setUp () {
+        vertices.resize(VERTICES * VERTEX_SIZE);
+        colors.resize(VERTICES * 4);
+        halves.resize(VERTICES * VERTEX_SIZE);
+        shorts.resize(VERTICES * VERTEX_SIZE);
+        for (size_t i = 0; i < vertices.size(); i++)
+            vertices[i] = (float)(i % 97) / 97;
+        for (size_t i = 0; i < colors.size(); i++)
+            colors[i] = (float)(i % 31) / 31;
+        matrix4.setToRotation(0, 0, 1, 30);
+        matrix3.setToAffine(1, 2, 0, 0, 30, 1, 1);
+    }
+
+    void run () {
+        float* data = &vertices[0];
+        switch (operation) {
+        case TRANSFORM_MATRIX4:
+            BufferUtils::transform(data, 3, VERTEX_SIZE, VERTICES, matrix4);
+            break;
+        case TRANSFORM_MATRIX3:
+            BufferUtils::transform(data, 2, VERTEX_SIZE, VERTICES, matrix3);
+            break;
+        case PACK_COLORS:
+            BufferUtils::packColors(&colors[0], 4, data + 2, VERTEX_SIZE, VERTICES);
+            break;
+        case TO_HALF_FLOATS:
+            BufferUtils::toHalfFloats(data, &halves[0], VERTICES * VERTEX_SIZE);
+            doNotOptimize(halves[VERTICES - 1]);
+            break;
+        case TO_NORMALIZED_SHORTS:
+            BufferUtils::toNormalizedShorts(data, &shorts[0], VERTICES * VERTEX_SIZE);
+            doNotOptimize(shorts[VERTICES - 1]);
+            break;
+        case FILL:
+            BufferUtils::fill(data, &colors[0], VERTEX_SIZE, VERTICES);
+            break;
+        }
+        doNotOptimize(data[VERTICES - 1]);
+    }
+
+    void tearDown () {
+        vertices = std::vector<float>();
+        colors = std::vector<float>();
+        halves = std::vector<unsigned short>();
+        shorts = std::vector<short>();
+    }
+
+private:
+    BulkOperation operation;
+    std::vector<float> vertices;
+    std::vector<float> colors;
+    std::vector<unsigned short> halves;
+    std::vector<short> shorts;
+    Matrix4 matrix4;
+    Matrix3 matrix3;
+};
+
+BufferUtilsBenchmark transformMatrix4("buffer-utils/transform-matrix4", TRANSFORM_MATRIX4);
+BufferUtilsBenchmark transformMatrix3("buffer-utils/transform-matrix3", TRANSFORM_MATRIX3);
+BufferUtilsBenchmark packColors("buffer-utils/pack-colors", PACK_COLORS);
+BufferUtilsBenchmark toHalfFloats("buffer-utils/to-half-floats", TO_HALF_FLOATS);
+BufferUtilsBenchmark toNormalizedShorts("buffer-utils/to-normalized-shorts", TO_NORMALIZED_SHORTS);
+BufferUtilsBenchmark fill("buffer-utils/fill", FILL);
+
+}
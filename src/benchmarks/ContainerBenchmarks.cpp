@@ -0,0 +1,242 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Benchmark.hpp"
+#include "gdx-cpp/math/Random.hpp"
+#include "gdx-cpp/utils/IdentityMap.hpp"
+#include "gdx-cpp/utils/IntMap.hpp"
+#include "gdx-cpp/utils/ObjectMap.hpp"
+
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace gdx_cpp::math;
+using namespace gdx_cpp::utils;
+using namespace gdx_cpp::benchmarks;
+
+namespace {
+
+// the same operations on both map flavours, so each case is written once
+
+template <typename K, typename V, typename H, typename E>
+inline void put (ObjectMap<K, V, H, E>& map, const K& key, const V& value) {
+    map.put(key, value);
+}
+
+template <typename K, typename V, typename H, typename E>
+inline const V* get (const ObjectMap<K, V, H, E>& map, const K& key) {
+    return map.get(key);
+}
+
+template <typename K, typename V, typename H, typename E>
+inline void remove (ObjectMap<K, V, H, E>& map, const K& key) {
+    map.remove(key);
+}
+
+template <typename K, typename V>
+inline void put (std::unordered_map<K, V>& map, const K& key, const V& value) {
+    map[key] = value;
+}
+
+template <typename K, typename V>
+inline const V* get (const std::unordered_map<K, V>& map, const K& key) {
+    typename std::unordered_map<K, V>::const_iterator it = map.find(key);
+    return it == map.end() ? NULL : &it->second;
+}
+
+template <typename K, typename V>
+inline void remove (std::unordered_map<K, V>& map, const K& key) {
+    map.erase(key);
+}
+
+std::vector<int> randomKeys (int count, uint64_t seed) {
+    Random random(seed);
+    std::vector<int> keys(count);
+    for (int i = 0; i < count; i++)
+        keys[i] = (int) random.nextInt();
+    return keys;
+}
+
+/** Fills an emptied map with random int keys, reported per insertion */
+template <typename Map>
+class IntInsertBenchmark : public Benchmark {
+public:
+    IntInsertBenchmark (const std::string& name, int count)
+    : Benchmark(name, count, "put")
+    , keys(randomKeys(count, 1))
+    {
+    }
+
+    void run () {
+        map.clear();
+        for (size_t i = 0; i < keys.size(); i++)
+            put(map, keys[i], (int) i);
+        doNotOptimize(map);
+    }
+
+private:
+    std::vector<int> keys;
+    Map map;
+};
+
+/** Looks up int keys that are all present, or all absent, reported per lookup */
+template <typename Map>
+class IntGetBenchmark : public Benchmark {
+public:
+    IntGetBenchmark (const std::string& name, int count, bool hit)
+    : Benchmark(name, count, "get")
+    , keys(randomKeys(count, 1))
+    , lookups(hit ? keys : randomKeys(count, 2))
+    {
+    }
+
+    void setUp () {
+        for (size_t i = 0; i < keys.size(); i++)
+            put(map, keys[i], (int) i);
+        // look the keys up in a different order than they were inserted
+        Random random(3);
+        for (size_t i = lookups.size() - 1; i > 0; i--)
+            std::swap(lookups[i], lookups[random.nextInt((int) i + 1)]);
+    }
+
+    void run () {
+        int sum = 0;
+        for (size_t i = 0; i < lookups.size(); i++) {
+            const int* value = get(map, lookups[i]);
+            if (value != NULL) sum += *value;
+        }
+        doNotOptimize(sum);
+    }
+
+private:
+    std::vector<int> keys;
+    std::vector<int> lookups;
+    Map map;
+};
+
+/** Removes and reinserts keys of a full map, reported per removal and insertion pair */
+template <typename Map>
+class IntChurnBenchmark : public Benchmark {
+public:
+    IntChurnBenchmark (const std::string& name, int count)
+    : Benchmark(name, count, "op")
+    , keys(randomKeys(count, 1))
+    {
+    }
+
+    void setUp () {
+        for (size_t i = 0; i < keys.size(); i++)
+            put(map, keys[i], (int) i);
+    }
+
+    void run () {
+        for (size_t i = 0; i < keys.size(); i++) {
+            remove(map, keys[i]);
+            put(map, keys[i] ^ 1, (int) i);
+            keys[i] ^= 1;
+        }
+        doNotOptimize(map);
+    }
+
+private:
+    std::vector<int> keys;
+    Map map;
+};
+
+/** Looks up shader uniform names, the ShaderProgram::fetchUniformLocation pattern */
+template <typename Map>
+class StringGetBenchmark : public Benchmark {
+public:
+    StringGetBenchmark (const std::string& name, int count)
+    : Benchmark(name, count * 4, "get")
+    {
+        for (int i = 0; i < count; i++) {
+            std::stringstream uniform;
+            uniform << "u_uniform" << i;
+            names.push_back(uniform.str());
+        }
+    }
+
+    void setUp () {
+        for (size_t i = 0; i < names.size(); i++)
+            put(map, names[i], (int) i);
+    }
+
+    void run () {
+        int sum = 0;
+        for (int pass = 0; pass < 4; pass++) {
+            for (size_t i = 0; i < names.size(); i++)
+                sum += *get(map, names[i]);
+        }
+        doNotOptimize(sum);
+    }
+
+private:
+    std::vector<std::string> names;
+    Map map;
+};
+
+/** Looks up heap addresses, the Box2D World's b2Fixture to Fixture pattern */
+template <typename Map>
+class PointerGetBenchmark : public Benchmark {
+public:
+    PointerGetBenchmark (const std::string& name, int count)
+    : Benchmark(name, count, "get")
+    {
+        for (int i = 0; i < count; i++)
+            objects.push_back(new int(i));
+    }
+
+    ~PointerGetBenchmark () {
+        for (size_t i = 0; i < objects.size(); i++)
+            delete objects[i];
+    }
+
+    void setUp () {
+        for (size_t i = 0; i < objects.size(); i++)
+            put(map, objects[i], objects[i]);
+    }
+
+    void run () {
+        int sum = 0;
+        for (size_t i = 0; i < objects.size(); i++)
+            sum += **get(map, objects[i]);
+        doNotOptimize(sum);
+    }
+
+private:
+    std::vector<int*> objects;
+    Map map;
+};
+
+IntInsertBenchmark<IntMap<int> > intInsertFlat("maps/int-put-4096/flat", 4096);
+IntInsertBenchmark<std::unordered_map<int, int> > intInsertStd("maps/int-put-4096/std", 4096);
+IntGetBenchmark<IntMap<int> > intHitFlat("maps/int-get-hit-4096/flat", 4096, true);
+IntGetBenchmark<std::unordered_map<int, int> > intHitStd("maps/int-get-hit-4096/std", 4096, true);
+IntGetBenchmark<IntMap<int> > intMissFlat("maps/int-get-miss-4096/flat", 4096, false);
+IntGetBenchmark<std::unordered_map<int, int> > intMissStd("maps/int-get-miss-4096/std", 4096, false);
+IntGetBenchmark<IntMap<int> > intHitLargeFlat("maps/int-get-hit-262144/flat", 262144, true);
+IntGetBenchmark<std::unordered_map<int, int> > intHitLargeStd("maps/int-get-hit-262144/std", 262144, true);
+IntChurnBenchmark<IntMap<int> > intChurnFlat("maps/int-remove-put-4096/flat", 4096);
+IntChurnBenchmark<std::unordered_map<int, int> > intChurnStd("maps/int-remove-put-4096/std", 4096);
+StringGetBenchmark<ObjectMap<std::string, int> > stringFlat("maps/string-get-16/flat", 16);
+StringGetBenchmark<std::unordered_map<std::string, int> > stringStd("maps/string-get-16/std", 16);
+PointerGetBenchmark<IdentityMap<int, int*> > pointerFlat("maps/pointer-get-1024/flat", 1024);
+PointerGetBenchmark<std::unordered_map<int*, int*> > pointerStd("maps/pointer-get-1024/std", 1024);
+
+}
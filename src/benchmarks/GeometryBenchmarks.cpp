@@ -0,0 +1,224 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Benchmark.hpp"
+#include "gdx-cpp/math/EarClippingTriangulator.hpp"
+#include "gdx-cpp/math/Intersector.hpp"
+#include "gdx-cpp/math/collision/BoundingBox.hpp"
+#include "gdx-cpp/math/collision/Ray.hpp"
+#include "gdx-cpp/math/collision/TriangleBVH.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+using namespace gdx_cpp::math;
+using namespace gdx_cpp::math::collision;
+using namespace gdx_cpp::benchmarks;
+
+namespace {
+
+/** Triangulates a star shaped polygon, optionally with a ring shaped hole, reported per input vertex */
+class EarClippingBenchmark : public Benchmark {
+public:
+    EarClippingBenchmark (const std::string& name, int numVertices, bool hole)
+    : Benchmark(name, hole ? numVertices + numVertices / 4 : numVertices, "vertex")
+    , numVertices(numVertices)
+    , hole(hole)
+    {
+    }
+
+    void setUp () {
+        vertices.clear();
+        for (int i = 0; i < numVertices; i++) {
+            float angle = 2 * 3.1415927f * i / numVertices;
+            float radius = i % 2 ? 100 : 60;
+            vertices.push_back(std::cos(angle) * radius);
+            vertices.push_back(std::sin(angle) * radius);
+        }
+        if (hole) {
+            // holes wind the opposite way of the outer contour
+            int holeVertices = numVertices / 4;
+            for (int i = 0; i < holeVertices; i++) {
+                float angle = -2 * 3.1415927f * i / holeVertices;
+                vertices.push_back(std::cos(angle) * 30);
+                vertices.push_back(std::sin(angle) * 30);
+            }
+        }
+    }
+
+    void run () {
+        int holeIndex = numVertices;
+        triangulator.computeTriangles(&vertices[0], vertices.size() / 2, &holeIndex, hole ? 1 : 0, triangles);
+        doNotOptimize(triangles[0]);
+    }
+
+private:
+    int numVertices;
+    bool hole;
+    std::vector<float> vertices;
+    std::vector<short> triangles;
+    EarClippingTriangulator triangulator;
+};
+
+EarClippingBenchmark earClippingSmall("earclipping/star-64", 64, false);
+EarClippingBenchmark earClippingLarge("earclipping/star-2048", 2048, false);
+EarClippingBenchmark earClippingHole("earclipping/star-2048-hole", 2048, true);
+
+/** Queries a BVH over a height field of 2 * size * size triangles, reported per ray or box. Unless it measures the
+ * linear scan itself, setUp checks every query against a brute force answer and throws on a mismatch, so a broken
+ * tree fails the run instead of reporting a fast time. */
+class TriangleBVHBenchmark : public Benchmark {
+public:
+    enum Query {
+        /** closest hit with TriangleBVH::intersectRay */
+        RAY,
+        /** TriangleBVH::intersectRayAny */
+        RAY_ANY,
+        /** closest hit with the linear Intersector::intersectRayTriangles, for comparison */
+        RAY_LINEAR,
+        /** TriangleBVH::overlap */
+        OVERLAP
+    };
+
+    TriangleBVHBenchmark (const std::string& name, int size, Query query, int queries)
+    : Benchmark(name, queries, query == OVERLAP ? "box" : "ray")
+    , size(size)
+    , query(query)
+    {
+    }
+
+    void setUp () {
+        vertices.clear();
+        indices.clear();
+        for (int z = 0; z <= size; z++) {
+            for (int x = 0; x <= size; x++) {
+                vertices.push_back(x);
+                vertices.push_back(2 * std::sin(x * 0.3f) * std::cos(z * 0.25f));
+                vertices.push_back(z);
+            }
+        }
+        for (int z = 0; z < size; z++) {
+            for (int x = 0; x < size; x++) {
+                short corner = z * (size + 1) + x;
+                short next = corner + size + 1;
+                short quad[6] = { corner, next, (short) (corner + 1), (short) (corner + 1), next, (short) (next + 1) };
+                indices.insert(indices.end(), quad, quad + 6);
+            }
+        }
+        bvh.build(&vertices[0], vertices.size() / 3, 3, 0, &indices[0], indices.size());
+
+        // rays start above the field and point in any direction, so some go up or leave the field and miss
+        std::mt19937 random(7);
+        std::uniform_real_distribution<float> unit(-1, 1);
+        rays.resize(items);
+        boxes.resize(items);
+        for (int i = 0; i < items; i++) {
+            float x = (unit(random) + 1) * size * 0.5f, z = (unit(random) + 1) * size * 0.5f;
+            rays[i].set(x, 4 + unit(random), z, unit(random), unit(random) - 0.5f, unit(random));
+            float extent = 0.5f + (unit(random) + 1) * 2;
+            boxes[i].set(Vector3(x - extent, unit(random) * 3 - extent, z - extent),
+                         Vector3(x + extent, unit(random) * 3 + extent, z + extent));
+        }
+
+        if (query != RAY_LINEAR) verify();
+    }
+
+    void run () {
+        int hits = 0;
+        Vector3 intersection;
+        for (int i = 0; i < items; i++) {
+            switch (query) {
+            case RAY:
+                hits += bvh.intersectRay(rays[i], &intersection);
+                break;
+            case RAY_ANY:
+                hits += bvh.intersectRayAny(rays[i]);
+                break;
+            case RAY_LINEAR:
+                hits += Intersector::intersectRayTriangles(rays[i], vertices, indices, 3, &intersection);
+                break;
+            case OVERLAP:
+                found.clear();
+                hits += bvh.overlap(boxes[i], found);
+                break;
+            }
+        }
+        doNotOptimize(hits);
+    }
+
+    void tearDown () {
+        bvh.clear();
+    }
+
+private:
+    void verify () {
+        for (int i = 0; i < items; i++) {
+            Vector3 expected, actual;
+            bool expectHit = Intersector::intersectRayTriangles(rays[i], vertices, indices, 3, &expected);
+            bool hit = query == RAY_ANY ? bvh.intersectRayAny(rays[i]) : bvh.intersectRay(rays[i], &actual);
+            if (hit != expectHit || (hit && query == RAY && actual.dst(expected) > 1e-3f))
+                fail("ray", i);
+        }
+
+        if (query != OVERLAP) return;
+
+        // a tree over a single triangle tests just that triangle, so the scan shares the exact test with the tree
+        // and only the traversal is checked
+        int numTriangles = indices.size() / 3;
+        std::vector<TriangleBVH> single(numTriangles);
+        for (int t = 0; t < numTriangles; t++)
+            single[t].build(&vertices[0], vertices.size() / 3, 3, 0, &indices[t * 3], 3);
+
+        std::vector<int> expected, scratch;
+        for (int i = 0; i < items; i++) {
+            expected.clear();
+            for (int t = 0; t < numTriangles; t++) {
+                scratch.clear();
+                if (single[t].overlap(boxes[i], scratch)) expected.push_back(t);
+            }
+            found.clear();
+            bvh.overlap(boxes[i], found);
+            std::sort(found.begin(), found.end());
+            if (found != expected) fail("box", i);
+        }
+    }
+
+    void fail (const char* what, int index) {
+        std::stringstream message;
+        message << getName() << ": " << what << " " << index << " disagrees with the brute force result";
+        throw std::runtime_error(message.str());
+    }
+
+    int size;
+    Query query;
+    std::vector<float> vertices;
+    std::vector<short> indices;
+    std::vector<Ray> rays;
+    std::vector<collision::BoundingBox> boxes;
+    std::vector<int> found;
+    TriangleBVH bvh;
+};
+
+TriangleBVHBenchmark bvhRay("bvh/ray-closest-8k", 64, TriangleBVHBenchmark::RAY, 256);
+TriangleBVHBenchmark bvhRayAny("bvh/ray-any-8k", 64, TriangleBVHBenchmark::RAY_ANY, 256);
+TriangleBVHBenchmark bvhRayLinear("bvh/ray-linear-8k", 64, TriangleBVHBenchmark::RAY_LINEAR, 16);
+TriangleBVHBenchmark bvhOverlap("bvh/overlap-8k", 64, TriangleBVHBenchmark::OVERLAP, 256);
+
+}
@@ -0,0 +1,214 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Benchmark.hpp"
+#include "gdx-cpp/graphics/Pixmap.hpp"
+#include "gdx-cpp/graphics/Texture.hpp"
+#include "gdx-cpp/graphics/g2d/SpriteBatch.hpp"
+#include "gdx-cpp/graphics/g2d/TextureRegion.hpp"
+
+#include <cstdlib>
+#include <vector>
+#include <zlib.h>
+
+using namespace gdx_cpp::graphics;
+using namespace gdx_cpp::graphics::g2d;
+using namespace gdx_cpp::benchmarks;
+
+/** Sprite batching against the null GL, which isolates the CPU side (vertex generation and buffer management), and the
+ * software pixmap paths: gdx2d blits and image decoding. */
+
+namespace {
+
+const int SPRITE_COUNT = 1000;
+
+Texture::ptr newTexture (int width, int height) {
+    Pixmap::ptr pixmap(new Pixmap(width, height, Pixmap::Format::RGBA8888));
+    pixmap->setColor(1, 0.5f, 0.25f, 1);
+    pixmap->fill();
+    return Texture::ptr(new Texture(pixmap, false));
+}
+
+class SpriteBatchBenchmark : public Benchmark {
+public:
+    SpriteBatchBenchmark (const std::string& name, bool transformed)
+    : Benchmark(name, SPRITE_COUNT, "sprite")
+    , transformed(transformed)
+    , batch(NULL)
+    {
+    }
+
+    void setUp () {
+        batch = new SpriteBatch(SPRITE_COUNT);
+        texture = newTexture(64, 64);
+        region = TextureRegion(texture, 0, 0, 32, 32);
+    }
+
+    void run () {
+        batch->begin();
+        if (transformed) {
+            for (int i = 0; i < SPRITE_COUNT; i++)
+                batch->draw(region, (i * 7) % 800, (i * 13) % 480, 16, 16, 32, 32, 1.5f, 1.5f, (float) i);
+        } else {
+            for (int i = 0; i < SPRITE_COUNT; i++)
+                batch->draw(*texture, (i * 7) % 800, (i * 13) % 480, 32, 32);
+        }
+        batch->end();
+    }
+
+    void tearDown () {
+        delete batch;
+        texture = Texture::ptr();
+    }
+
+private:
+    bool transformed;
+    SpriteBatch* batch;
+    TextureRegion region;
+    Texture::ptr texture;
+};
+
+/** Draws a 256x256 RGBA pixmap into a 512x512 one, optionally blended and scaled, reported per destination pixel */
+class BlitBenchmark : public Benchmark {
+public:
+    BlitBenchmark (const std::string& name, Pixmap::Blending blending, Pixmap::Filter filter, int dstSize)
+    : Benchmark(name, dstSize * dstSize, "pixel")
+    , blending(blending)
+    , filter(filter)
+    , dstSize(dstSize)
+    , src(NULL)
+    , dst(NULL)
+    {
+    }
+
+    void setUp () {
+        src = new Pixmap(SRC_SIZE, SRC_SIZE, Pixmap::Format::RGBA8888);
+        dst = new Pixmap(512, 512, Pixmap::Format::RGBA8888);
+        src->setColor(0.8f, 0.4f, 0.2f, 0.5f);
+        src->fill();
+        dst->setColor(0, 0, 1, 1);
+        dst->fill();
+    }
+
+    void run () {
+        Pixmap::setBlending(blending);
+        Pixmap::setFilter(filter);
+        dst->drawPixmap(*src, 0, 0, SRC_SIZE, SRC_SIZE, 0, 0, dstSize, dstSize);
+    }
+
+    void tearDown () {
+        Pixmap::setBlending(Pixmap::SourceOver);
+        Pixmap::setFilter(Pixmap::BiLinear);
+        delete src;
+        delete dst;
+    }
+
+private:
+    static const int SRC_SIZE = 256;
+
+    Pixmap::Blending blending;
+    Pixmap::Filter filter;
+    int dstSize;
+    Pixmap* src;
+    Pixmap* dst;
+};
+
+void appendChunk (std::vector<unsigned char>& png, const char* type, const std::vector<unsigned char>& data) {
+    unsigned int length = data.size();
+    unsigned char header[8] = {
+        (unsigned char)(length >> 24), (unsigned char)(length >> 16), (unsigned char)(length >> 8), (unsigned char) length,
+        (unsigned char) type[0], (unsigned char) type[1], (unsigned char) type[2], (unsigned char) type[3]
+    };
+    png.insert(png.end(), header, header + 8);
+    png.insert(png.end(), data.begin(), data.end());
+
+    uLong crc = crc32(0, header + 4, 4);
+    if (length) crc = crc32(crc, &data[0], length);
+    unsigned char trailer[4] = {
+        (unsigned char)(crc >> 24), (unsigned char)(crc >> 16), (unsigned char)(crc >> 8), (unsigned char) crc
+    };
+    png.insert(png.end(), trailer, trailer + 4);
+}
+
+/** Encodes a gradient with some noise as an RGBA PNG, so the benchmark needs no data files */
+std::vector<unsigned char> encodePng (int width, int height) {
+    std::vector<unsigned char> raw;
+    raw.reserve((width * 4 + 1) * height);
+    for (int y = 0; y < height; y++) {
+        raw.push_back(0); // no filter
+        for (int x = 0; x < width; x++) {
+            raw.push_back((unsigned char)(x * 255 / width));
+            raw.push_back((unsigned char)(y * 255 / height));
+            raw.push_back((unsigned char)(rand() & 63));
+            raw.push_back(255);
+        }
+    }
+
+    uLongf compressedLength = compressBound(raw.size());
+    std::vector<unsigned char> compressed(compressedLength);
+    compress2(&compressed[0], &compressedLength, &raw[0], raw.size(), Z_DEFAULT_COMPRESSION);
+    compressed.resize(compressedLength);
+
+    unsigned char header[13] = {
+        (unsigned char)(width >> 24), (unsigned char)(width >> 16), (unsigned char)(width >> 8), (unsigned char) width,
+        (unsigned char)(height >> 24), (unsigned char)(height >> 16), (unsigned char)(height >> 8), (unsigned char) height,
+        8, 6, 0, 0, 0 // 8 bit RGBA, deflate, adaptive filtering, no interlace
+    };
+
+    static const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+    std::vector<unsigned char> png(signature, signature + 8);
+    appendChunk(png, "IHDR", std::vector<unsigned char>(header, header + 13));
+    appendChunk(png, "IDAT", compressed);
+    appendChunk(png, "IEND", std::vector<unsigned char>());
+    return png;
+}
+
+class DecodeBenchmark : public Benchmark {
+public:
+    DecodeBenchmark (const std::string& name, int size)
+    : Benchmark(name, size * size, "pixel")
+    , size(size)
+    {
+    }
+
+    void setUp () {
+        png = encodePng(size, size);
+    }
+
+    void run () {
+        Pixmap pixmap(&png[0], 0, png.size());
+        doNotOptimize(pixmap.getPixels()[0]);
+    }
+
+    void tearDown () {
+        std::vector<unsigned char>().swap(png);
+    }
+
+private:
+    int size;
+    std::vector<unsigned char> png;
+};
+
+SpriteBatchBenchmark spriteBatchDraw("spritebatch/draw", false);
+SpriteBatchBenchmark spriteBatchDrawTransformed("spritebatch/draw-transformed", true);
+
+BlitBenchmark blit("gdx2d/blit", Pixmap::None, Pixmap::NearestNeighbour, 256);
+BlitBenchmark blitBlended("gdx2d/blit-blended", Pixmap::SourceOver, Pixmap::NearestNeighbour, 256);
+BlitBenchmark blitScaled("gdx2d/blit-scaled-bilinear", Pixmap::None, Pixmap::BiLinear, 384);
+
+DecodeBenchmark decodePng("image/decode-png", 512);
+
+}
@@ -0,0 +1,134 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Benchmark.hpp"
+#include "StdThreadFactory.hpp"
+#include "gdx-cpp/utils/GzipWriter.hpp"
+#include "gdx-cpp/utils/Inflater.hpp"
+#include "gdx-cpp/utils/JsonWriter.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace gdx_cpp::utils;
+using namespace gdx_cpp::benchmarks;
+
+namespace {
+
+const int ENTITIES = 60000;
+
+/** A save game as JSON, compressible like real ones: repeated keys, small numbers, some noise */
+std::string saveGame () {
+    std::mt19937 random(5);
+    WriteBuffer buffer;
+    JsonWriter json(buffer);
+    json.object().array("entities");
+    for (int i = 0; i < ENTITIES; i++) {
+        json.object().set("id", i).set("type", random() % 3 ? "crate" : "enemy").set("x", (int) (random() % 4096))
+            .set("y", (int) (random() % 4096)).set("health", (float) (random() % 1000) / 10).pop();
+    }
+    json.close();
+    return buffer.toString();
+}
+
+/** Counts what it is given, so only the compression is measured */
+class NullSink : public OutputSink {
+public:
+    NullSink ()
+    : size(0)
+    {
+    }
+
+    void write (const char*, size_t length) {
+        size += length;
+    }
+
+    size_t size;
+};
+
+class StringSink : public OutputSink {
+public:
+    StringSink (std::string& out)
+    : out(out)
+    {
+        out.clear();
+    }
+
+    void write (const char* data, size_t length) {
+        out.append(data, length);
+    }
+
+    std::string& out;
+};
+
+enum Operation {
+    WRITE_SERIAL,
+    WRITE_PARALLEL,
+    INFLATE
+};
+
+/** Compresses or inflates a save game per run, reported per byte of uncompressed data */
+class GzipBenchmark : public Benchmark {
+public:
+    GzipBenchmark (const std::string& name, Operation operation)
+    : Benchmark(name, 1, "byte")
+    , operation(operation)
+    {
+    }
+
+    void setUp () {
+        if (operation == WRITE_PARALLEL) benchmarkJobSystem();
+        data = saveGame();
+        items = (int) data.size();
+
+        StringSink collect(compressed);
+        GzipWriter writer(collect);
+        writer.write(data.data(), data.size());
+        writer.finish();
+        inflated.resize(data.size());
+    }
+
+    void run () {
+        if (operation == INFLATE) {
+            doNotOptimize(Inflater::inflate(compressed.data(), compressed.size(), &inflated[0], inflated.size()));
+            return;
+        }
+        NullSink sink;
+        GzipWriter writer(sink, operation == WRITE_PARALLEL ? &benchmarkJobSystem() : NULL);
+        writer.write(data.data(), data.size());
+        writer.finish();
+        doNotOptimize(sink.size);
+    }
+
+    void tearDown () {
+        data = std::string();
+        compressed = std::string();
+        inflated = std::vector<unsigned char>();
+    }
+
+private:
+    Operation operation;
+    std::string data;
+    std::string compressed;
+    std::vector<unsigned char> inflated;
+};
+
+GzipBenchmark writeSerial("gzip/savegame/write", WRITE_SERIAL);
+GzipBenchmark writeParallel("gzip/savegame/write-parallel", WRITE_PARALLEL);
+GzipBenchmark inflate("gzip/savegame/inflate", INFLATE);
+
+}
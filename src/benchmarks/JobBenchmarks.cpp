@@ -0,0 +1,93 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Benchmark.hpp"
+#include "StdThreadFactory.hpp"
+
+#include <cmath>
+#include <vector>
+
+using namespace gdx_cpp::implementation;
+using namespace gdx_cpp::benchmarks;
+
+namespace {
+
+const int ELEMENTS = 1 << 20;
+
+void transform (const float* in, float* out, int begin, int end) {
+    for (int i = begin; i < end; i++)
+        out[i] = std::sqrt(in[i]) * std::sin(in[i]);
+}
+
+/** A per element transform over 1M floats, either on this thread or split with JobSystem::parallelFor */
+class TransformBenchmark : public Benchmark {
+public:
+    TransformBenchmark (const std::string& name, bool parallel)
+    : Benchmark(name, ELEMENTS, "element")
+    , parallel(parallel)
+    {
+    }
+
+    void setUp () {
+        in.resize(ELEMENTS);
+        out.resize(ELEMENTS);
+        for (int i = 0; i < ELEMENTS; i++)
+            in[i] = (float) i / ELEMENTS;
+        if (parallel) benchmarkJobSystem();
+    }
+
+    void run () {
+        const float* source = &in[0];
+        float* destination = &out[0];
+        if (parallel) {
+            benchmarkJobSystem().parallelFor(0, ELEMENTS, 0, [source, destination] (int begin, int end) {
+                transform(source, destination, begin, end);
+            });
+        } else {
+            transform(source, destination, 0, ELEMENTS);
+        }
+        doNotOptimize(out[ELEMENTS / 2]);
+    }
+
+private:
+    bool parallel;
+    std::vector<float> in;
+    std::vector<float> out;
+};
+
+/** Creates, runs and waits for 1024 empty child jobs, the per job overhead */
+class SpawnBenchmark : public Benchmark {
+public:
+    SpawnBenchmark ()
+    : Benchmark("jobs/spawn-wait-1024", 1024, "job")
+    {
+    }
+
+    void run () {
+        JobSystem& jobs = benchmarkJobSystem();
+        JobSystem::Job* root = jobs.create([] () {});
+        for (int i = 0; i < 1024; i++)
+            jobs.run(jobs.create([] () {}, root));
+        jobs.run(root);
+        jobs.wait(root);
+    }
+};
+
+TransformBenchmark transformSerial("jobs/transform-1M/serial", false);
+TransformBenchmark transformParallel("jobs/transform-1M/parallel", true);
+SpawnBenchmark spawn;
+
+}
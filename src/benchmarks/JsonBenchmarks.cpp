@@ -0,0 +1,160 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Benchmark.hpp"
+#include "gdx-cpp/utils/JsonReader.hpp"
+#include "gdx-cpp/utils/LinearAllocator.hpp"
+
+#include <cstdio>
+#include <random>
+#include <string>
+
+using namespace gdx_cpp::utils;
+using namespace gdx_cpp::benchmarks;
+
+namespace {
+
+const int SKIN_ENTRIES = 6000;
+const int KEYFRAMES = 40000;
+
+/** A skin: colors, texture regions and widget styles keyed by name, mostly short strings and small numbers */
+std::string skinDocument () {
+    std::mt19937 random(42);
+    std::string json = "{\n  \"resources\": {\n    \"colors\": {\n";
+    char line[256];
+    for (int i = 0; i < SKIN_ENTRIES; i++) {
+        snprintf(line, sizeof(line), "      \"color%d\": { \"r\": %.3f, \"g\": %.3f, \"b\": %.3f, \"a\": 1 },\n", i,
+                 random() % 1000 / 1000.0, random() % 1000 / 1000.0, random() % 1000 / 1000.0);
+        json += line;
+    }
+    json += "      \"white\": { \"r\": 1, \"g\": 1, \"b\": 1, \"a\": 1 }\n    },\n    \"regions\": {\n";
+    for (int i = 0; i < SKIN_ENTRIES; i++) {
+        snprintf(line, sizeof(line), "      \"region%d\": { \"x\": %u, \"y\": %u, \"width\": %u, \"height\": %u, "
+                 "\"split\": [4, 4, 4, 4] },\n", i, (unsigned) (random() % 1024), (unsigned) (random() % 1024),
+                 (unsigned) (random() % 64), (unsigned) (random() % 64));
+        json += line;
+    }
+    json += "      \"empty\": {}\n    }\n  },\n  \"styles\": [\n";
+    for (int i = 0; i < SKIN_ENTRIES; i++) {
+        snprintf(line, sizeof(line), "    { \"name\": \"button%d\", \"font\": \"default-font\", \"fontColor\": "
+                 "\"color%u\", \"up\": \"region%u\", \"title\": \"Press \\\"%d\\\"\", \"toggle\": %s },\n", i,
+                 (unsigned) (random() % SKIN_ENTRIES), (unsigned) (random() % SKIN_ENTRIES), i,
+                 i % 2 ? "true" : "false");
+        json += line;
+    }
+    json += "    null\n  ]\n}\n";
+    return json;
+}
+
+/** Animation metadata: long arrays of floats, which makes number parsing the bulk of the work */
+std::string keyframeDocument () {
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> values(-100, 100);
+    std::string json = "{ \"name\": \"walk\", \"frames\": [";
+    char line[128];
+    for (int i = 0; i < KEYFRAMES; i++) {
+        snprintf(line, sizeof(line), "%s[%.4f, %.6g, %.6g, %.6g]", i ? ", " : "", i / 30.0, values(random),
+                 values(random), values(random));
+        json += line;
+    }
+    json += "] }";
+    return json;
+}
+
+/** Counts what it is told, so the SAX case pays for the callbacks but builds nothing */
+class CountingHandler : public JsonHandler {
+public:
+    CountingHandler ()
+    : values(0)
+    , sum(0)
+    {
+    }
+
+    void startObject (const StringView&) {
+        values++;
+    }
+
+    void startArray (const StringView&) {
+        values++;
+    }
+
+    void string (const StringView&, const StringView& value) {
+        values++;
+        sum += value.size();
+    }
+
+    void number (const StringView&, double value, const StringView&) {
+        values++;
+        sum += value;
+    }
+
+    void boolean (const StringView&, bool value) {
+        values++;
+    }
+
+    void null (const StringView&) {
+        values++;
+    }
+
+    int values;
+    double sum;
+};
+
+/** Parses a whole document per run, reported per byte of JSON */
+class JsonBenchmark : public Benchmark {
+public:
+    JsonBenchmark (const std::string& name, std::string (*document) (), bool sax)
+    : Benchmark(name, 1, "byte")
+    , document(document)
+    , sax(sax)
+    {
+    }
+
+    void setUp () {
+        json = document();
+        items = (int) json.size();
+    }
+
+    void run () {
+        if (sax) {
+            CountingHandler handler;
+            reader.parse(json.data(), json.size(), handler);
+            doNotOptimize(handler.sum);
+        } else {
+            const JsonValue* root = reader.parse(json, arena);
+            doNotOptimize(root->size());
+            arena.reset();
+        }
+    }
+
+    void tearDown () {
+        json = std::string();
+    }
+
+private:
+    std::string (*document) ();
+    bool sax;
+    std::string json;
+    JsonReader reader;
+    LinearAllocator arena;
+};
+
+JsonBenchmark skinDom("json/skin/dom", skinDocument, false);
+JsonBenchmark skinSax("json/skin/sax", skinDocument, true);
+JsonBenchmark keyframeDom("json/keyframes/dom", keyframeDocument, false);
+JsonBenchmark keyframeSax("json/keyframes/sax", keyframeDocument, true);
+
+}
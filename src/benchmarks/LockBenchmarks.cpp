@@ -0,0 +1,139 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+#include "Benchmark.hpp"
+#include "gdx-cpp/utils/LockGuard.hpp"
+#include "gdx-cpp/utils/Mutex.hpp"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace gdx_cpp::utils;
+using namespace gdx_cpp::benchmarks;
+
+namespace {
+
+const int LOCKS = 1 << 16;
+
+/** Adapts std::mutex to the tryLock spelling LockGuard uses */
+struct StdMutex {
+    std::mutex mutex;
+
+    void lock () {
+        mutex.lock();
+    }
+
+    bool tryLock () {
+        return mutex.try_lock();
+    }
+
+    void unlock () {
+        mutex.unlock();
+    }
+};
+
+struct SharedRWLock {
+    RWLock rwLock;
+
+    void lock () {
+        rwLock.lockShared();
+    }
+
+    bool tryLock () {
+        return rwLock.tryLockShared();
+    }
+
+    void unlock () {
+        rwLock.unlockShared();
+    }
+};
+
+template <typename Lockable>
+void increment (Lockable* lockable, long* counter, int count) {
+    for (int i = 0; i < count; i++) {
+        LockGuard<Lockable> guard(*lockable);
+        ++*counter;
+    }
+}
+
+/** Takes and releases one lock LOCKS times spread over the threads, reported per acquisition. With one thread that's
+ * the uncontended fast path; with more they fight over the lock and the counter, threads included. */
+template <typename Lockable>
+class LockBenchmark : public Benchmark {
+public:
+    LockBenchmark (const std::string& name, int threads)
+    : Benchmark(name, LOCKS, "lock")
+    , threads(threads)
+    {
+    }
+
+    void setUp () {
+        // glibc skips the atomics in pthread_mutex_lock until the process starts its first thread
+        std::thread([] () {}).join();
+    }
+
+    void run () {
+        Lockable lockable;
+        long counter = 0;
+        if (threads == 1) {
+            increment(&lockable, &counter, LOCKS);
+        } else {
+            std::vector<std::thread> workers;
+            for (int i = 0; i < threads; i++)
+                workers.push_back(std::thread(increment<Lockable>, &lockable, &counter, LOCKS / threads));
+            for (int i = 0; i < threads; i++)
+                workers[i].join();
+        }
+        doNotOptimize(counter);
+    }
+
+private:
+    int threads;
+};
+
+/** The profiled guard's extra tryLock and counters on the uncontended path */
+class ProfiledLockBenchmark : public Benchmark {
+public:
+    ProfiledLockBenchmark ()
+    : Benchmark("locks/profiled-mutex/1t", LOCKS, "lock")
+    , site("benchmark")
+    {
+    }
+
+    void run () {
+        Mutex mutex;
+        long counter = 0;
+        for (int i = 0; i < LOCKS; i++) {
+            LockGuard<Mutex> guard(mutex, site);
+            ++counter;
+        }
+        doNotOptimize(counter);
+    }
+
+private:
+    LockSite site;
+};
+
+LockBenchmark<StdMutex> stdMutex1("locks/std-mutex/1t", 1);
+LockBenchmark<StdMutex> stdMutex4("locks/std-mutex/4t", 4);
+LockBenchmark<Mutex> mutex1("locks/mutex/1t", 1);
+LockBenchmark<Mutex> mutex4("locks/mutex/4t", 4);
+LockBenchmark<RWLock> rwLock1("locks/rwlock/1t", 1);
+LockBenchmark<SharedRWLock> rwLockShared1("locks/rwlock-shared/1t", 1);
+LockBenchmark<SharedRWLock> rwLockShared4("locks/rwlock-shared/4t", 4);
+ProfiledLockBenchmark profiledMutex;
+
+}
@@ -0,0 +1,148 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Benchmark.hpp"
+#include "gdx-cpp/math/Matrix3.hpp"
+#include "gdx-cpp/math/Matrix4.hpp"
+#include "gdx-cpp/math/detail/MatrixKernels.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace gdx_cpp::math;
+using namespace gdx_cpp::benchmarks;
+
+/** The scalar and SIMD matrix kernels side by side, so the speedup of the SIMD paths on the build machine can be read
+ * directly from the results. The batched transforms are reported per vertex. */
+
+namespace {
+
+const int VERTEX_COUNT = 4096;
+const int STRIDE = 5; // x, y, z, u, v
+
+typedef void (*MatrixKernel) (float*, const float*);
+
+/** Multiplies a random matrix by a rotation each run, which keeps the values from growing without bound */
+class MatrixKernelBenchmark : public Benchmark {
+public:
+    MatrixKernelBenchmark (const std::string& name, MatrixKernel kernel, bool matrix3 = false)
+    : Benchmark(name)
+    , kernel(kernel)
+    , matrix3(matrix3)
+    {
+    }
+
+    void setUp () {
+        if (matrix3) {
+            Matrix3 rotation;
+            rotation.setToRotation(30);
+            memcpy(b, rotation.vals, sizeof(rotation.vals));
+        } else {
+            Matrix4 rotation;
+            rotation.setToRotation(0.6f, 0.8f, 0, 60);
+            memcpy(b, rotation.val, sizeof(b));
+        }
+        for (int i = 0; i < 16; i++)
+            a[i] = (rand() % 1000) / 500.0f - 1;
+        a[Matrix4::M00] += 4;
+        a[Matrix4::M11] += 4;
+        a[Matrix4::M22] += 4;
+        a[Matrix4::M33] += 4;
+    }
+
+    void run () {
+        kernel(a, b);
+        doNotOptimize(a);
+    }
+
+private:
+    MatrixKernel kernel;
+    bool matrix3;
+    float a[16], b[16];
+};
+
+typedef void (*VectorKernel) (const float*, const float*, float*, int, int, int);
+
+class VectorKernelBenchmark : public Benchmark {
+public:
+    VectorKernelBenchmark (const std::string& name, VectorKernel kernel, bool inPlace = false)
+    : Benchmark(name, VERTEX_COUNT, "vertex")
+    , kernel(kernel)
+    , inPlace(inPlace)
+    {
+    }
+
+    void setUp () {
+        src.resize(VERTEX_COUNT * STRIDE);
+        dst.resize(VERTEX_COUNT * STRIDE);
+        for (unsigned int i = 0; i < src.size(); i++)
+            src[i] = (rand() % 1000) / 10.0f;
+        Matrix4 rotation;
+        rotation.setToRotation(0.6f, 0.8f, 0, 60);
+        memcpy(mat, rotation.val, sizeof(mat));
+    }
+
+    void run () {
+        float* out = inPlace ? &src[0] : &dst[0];
+        kernel(mat, &src[0], out, VERTEX_COUNT, STRIDE, STRIDE);
+        doNotOptimize(out[0]);
+    }
+
+    void tearDown () {
+        std::vector<float>().swap(src);
+        std::vector<float>().swap(dst);
+    }
+
+private:
+    VectorKernel kernel;
+    bool inPlace;
+    float mat[16];
+    std::vector<float> src, dst;
+};
+
+void scalarInv (float* a, const float*) { detail::scalar::inv4x4(a); }
+void simdInv (float* a, const float*) { detail::simd::inv4x4(a); }
+
+/** The path every caller took before the batched kernels: one Matrix4::mulVec(float*, float*) per vertex */
+void perVertexMulVec (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride) {
+    for (int i = 0; i < numVecs; i++, dst += dstStride) {
+        dst[0] = src[i * srcStride];
+        dst[1] = src[i * srcStride + 1];
+        dst[2] = src[i * srcStride + 2];
+        Matrix4::mulVec((float*) mat, dst);
+    }
+}
+
+MatrixKernelBenchmark mulScalar("matrix4/mul/scalar", detail::scalar::mul4x4);
+MatrixKernelBenchmark mulSimd("matrix4/mul/simd", detail::simd::mul4x4);
+MatrixKernelBenchmark invScalar("matrix4/inv/scalar", scalarInv);
+MatrixKernelBenchmark invSimd("matrix4/inv/simd", simdInv);
+MatrixKernelBenchmark mulAffine("matrix3/mulAffine", detail::scalar::mulAffine3x3, true);
+
+VectorKernelBenchmark mulVecPerVertex("matrix4/mulVec/per-vertex", perVertexMulVec);
+VectorKernelBenchmark mulVecScalar("matrix4/mulVec/scalar", detail::scalar::mulVec4x4);
+VectorKernelBenchmark mulVecSimd("matrix4/mulVec/simd", detail::simd::mulVec4x4);
+VectorKernelBenchmark mulVecInPlaceScalar("matrix4/mulVec-in-place/scalar", detail::scalar::mulVec4x4, true);
+VectorKernelBenchmark mulVecInPlaceSimd("matrix4/mulVec-in-place/simd", detail::simd::mulVec4x4, true);
+VectorKernelBenchmark prjScalar("matrix4/prj/scalar", detail::scalar::prj4x4);
+VectorKernelBenchmark prjSimd("matrix4/prj/simd", detail::simd::prj4x4);
+VectorKernelBenchmark rotScalar("matrix4/rot/scalar", detail::scalar::rot4x4);
+VectorKernelBenchmark rotSimd("matrix4/rot/simd", detail::simd::rot4x4);
+VectorKernelBenchmark mulVec3Scalar("matrix3/mulVec/scalar", detail::scalar::mulVec3x3);
+VectorKernelBenchmark mulVec3Simd("matrix3/mulVec/simd", detail::simd::mulVec3x3);
+
+}
@@ -0,0 +1,487 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "NullGL20.hpp"
+
+using namespace gdx_cpp::benchmarks;
+
+NullGL20::NullGL20 ()
+: handles(0)
+{
+}
+
+void NullGL20::generate (int n, const int* handles) const {
+    int* out = const_cast<int*>(handles);
+    for (int i = 0; i < n; i++)
+        out[i] = ++this->handles;
+}
+
+void NullGL20::glActiveTexture (int texture) const {
+}
+
+void NullGL20::glBindTexture (int target, int texture) const {
+}
+
+void NullGL20::glBlendFunc (int sfactor, int dfactor) const {
+}
+
+void NullGL20::glClear (int mask) const {
+}
+
+void NullGL20::glClearColor (float red, float green, float blue, float alpha) const {
+}
+
+void NullGL20::glClearDepthf (float depth) const {
+}
+
+void NullGL20::glClearStencil (int s) const {
+}
+
+void NullGL20::glColorMask (bool red, bool green, bool blue, bool alpha) const {
+}
+
+void NullGL20::glCompressedTexImage2D (int target, int level, int internalformat, int width, int height, int border, int imageSize, const unsigned char* data) const {
+}
+
+void NullGL20::glCompressedTexSubImage2D (int target, int level, int xoffset, int yoffset, int width, int height, int format, int imageSize, const unsigned char* data) const {
+}
+
+void NullGL20::glCopyTexImage2D (int target, int level, int internalformat, int x, int y, int width, int height, int border) const {
+}
+
+void NullGL20::glCopyTexSubImage2D (int target, int level, int xoffset, int yoffset, int x, int y, int width, int height) const {
+}
+
+void NullGL20::glCullFace (int mode) const {
+}
+
+void NullGL20::glDeleteTextures (int n, const int* textures) const {
+}
+
+void NullGL20::glDepthFunc (int func) const {
+}
+
+void NullGL20::glDepthMask (bool flag) const {
+}
+
+void NullGL20::glDepthRangef (float zNear, float zFar) const {
+}
+
+void NullGL20::glDisable (int cap) const {
+}
+
+void NullGL20::glDrawArrays (int mode, int first, int count) const {
+}
+
+void NullGL20::glDrawElements (int mode, int count, int type, const void* indices) const {
+}
+
+void NullGL20::glEnable (int cap) const {
+}
+
+void NullGL20::glFinish () const {
+}
+
+void NullGL20::glFlush () const {
+}
+
+void NullGL20::glFrontFace (int mode) const {
+}
+
+void NullGL20::glGenTextures (int n, int* textures) const {
+    generate(n, textures);
+}
+
+int NullGL20::glGetError () const {
+    return 0;
+}
+
+void NullGL20::glGetIntegerv (int pname, const int* params) const {
+}
+
+std::string NullGL20::glGetString (int name) const {
+    return "gdx-cpp null renderer";
+}
+
+void NullGL20::glHint (int target, int mode) const {
+}
+
+void NullGL20::glLineWidth (float width) const {
+}
+
+void NullGL20::glPixelStorei (int pname, int param) const {
+}
+
+void NullGL20::glPolygonOffset (float factor, float units) const {
+}
+
+void NullGL20::glReadPixels (int x, int y, int width, int height, int format, int type, const void* pixels) const {
+}
+
+void NullGL20::glScissor (int x, int y, int width, int height) const {
+}
+
+void NullGL20::glStencilFunc (int func, int ref, int mask) const {
+}
+
+void NullGL20::glStencilMask (int mask) const {
+}
+
+void NullGL20::glStencilOp (int fail, int zfail, int zpass) const {
+}
+
+void NullGL20::glTexImage2D (int target, int level, int internalformat, int width, int height, int border, int format, int type, const unsigned char* pixels) const {
+}
+
+void NullGL20::glTexParameterf (int target, int pname, float param) const {
+}
+
+void NullGL20::glTexSubImage2D (int target, int level, int xoffset, int yoffset, int width, int height, int format, int type, const unsigned char* pixels) const {
+}
+
+void NullGL20::glViewport (int x, int y, int width, int height) const {
+}
+
+void NullGL20::glAttachShader (int program, int shader) const {
+}
+
+void NullGL20::glBindAttribLocation (int program, int index, const std::string& name) const {
+}
+
+void NullGL20::glBindBuffer (int target, int buffer) const {
+}
+
+void NullGL20::glBindFramebuffer (int target, int framebuffer) const {
+}
+
+void NullGL20::glBindRenderbuffer (int target, int renderbuffer) const {
+}
+
+void NullGL20::glBlendColor (float red, float green, float blue, float alpha) const {
+}
+
+void NullGL20::glBlendEquation (int mode) const {
+}
+
+void NullGL20::glBlendEquationSeparate (int modeRGB, int modeAlpha) const {
+}
+
+void NullGL20::glBlendFuncSeparate (int srcRGB, int dstRGB, int srcAlpha, int dstAlpha) const {
+}
+
+void NullGL20::glBufferData (int target, int size, const char* data, int usage) const {
+}
+
+void NullGL20::glBufferSubData (int target, int offset, int size, const char* data) const {
+}
+
+int NullGL20::glCheckFramebufferStatus (int target) const {
+    return 0;
+}
+
+void NullGL20::glCompileShader (int shader) const {
+}
+
+int NullGL20::glCreateProgram () const {
+    return ++handles;
+}
+
+int NullGL20::glCreateShader (int type) const {
+    return ++handles;
+}
+
+void NullGL20::glDeleteBuffers (int n, const int* buffers) const {
+}
+
+void NullGL20::glDeleteFramebuffers (int n, const int* framebuffers) const {
+}
+
+void NullGL20::glDeleteProgram (int program) const {
+}
+
+void NullGL20::glDeleteRenderbuffers (int n, const int* renderbuffers) const {
+}
+
+void NullGL20::glDeleteShader (int shader) const {
+}
+
+void NullGL20::glDetachShader (int program, int shader) const {
+}
+
+void NullGL20::glDisableVertexAttribArray (int index) const {
+}
+
+void NullGL20::glDrawElements (int mode, int count, int type, int indices) const {
+}
+
+void NullGL20::glEnableVertexAttribArray (int index) const {
+}
+
+void NullGL20::glFramebufferRenderbuffer (int target, int attachment, int renderbuffertarget, int renderbuffer) const {
+}
+
+void NullGL20::glFramebufferTexture2D (int target, int attachment, int textarget, int texture, int level) const {
+}
+
+void NullGL20::glGenBuffers (int n, const int* buffers) const {
+    generate(n, buffers);
+}
+
+void NullGL20::glGenerateMipmap (int target) const {
+}
+
+void NullGL20::glGenFramebuffers (int n, const int* framebuffers) const {
+    generate(n, framebuffers);
+}
+
+void NullGL20::glGenRenderbuffers (int n, const int* renderbuffers) const {
+    generate(n, renderbuffers);
+}
+
+std::string NullGL20::glGetActiveAttrib (int program, int index, const int* size, const char* type) const {
+    return std::string();
+}
+
+std::string NullGL20::glGetActiveUniform (int program, int index, const int* size, const char* type) const {
+    return std::string();
+}
+
+void NullGL20::glGetAttachedShaders (int program, int maxcount, const char* count, const int* shaders) const {
+}
+
+int NullGL20::glGetAttribLocation (int program, const std::string& name) const {
+    return 0;
+}
+
+void NullGL20::glGetBooleanv (int pname, const char* params) const {
+}
+
+void NullGL20::glGetBufferParameteriv (int target, int pname, const int* params) const {
+}
+
+void NullGL20::glGetFloatv (int pname, const float* params) const {
+}
+
+void NullGL20::glGetFramebufferAttachmentParameteriv (int target, int attachment, int pname, const int* params) const {
+}
+
+void NullGL20::glGetProgramiv (int program, int pname, const int* params) const {
+    *const_cast<int*>(params) = pname == GL_LINK_STATUS ? 1 : 0;
+}
+
+std::string& NullGL20::glGetProgramInfoLog (int program) const {
+    return infoLog;
+}
+
+void NullGL20::glGetRenderbufferParameteriv (int target, int pname, const int* params) const {
+}
+
+void NullGL20::glGetShaderiv (int shader, int pname, const int* params) const {
+    // every shader compiles and links, no program has active uniforms or attributes
+    *const_cast<int*>(params) = pname == GL_COMPILE_STATUS ? 1 : 0;
+}
+
+std::string& NullGL20::glGetShaderInfoLog (int shader) const {
+    return infoLog;
+}
+
+void NullGL20::glGetShaderPrecisionFormat (int shadertype, int precisiontype, const int* range, const int* precision) const {
+}
+
+void NullGL20::glGetShaderSource (int shader, int bufsize, const char* length, const std::string& source) const {
+}
+
+void NullGL20::glGetTexParameterfv (int target, int pname, const float* params) const {
+}
+
+void NullGL20::glGetTexParameteriv (int target, int pname, const int* params) const {
+}
+
+void NullGL20::glGetUniformfv (int program, int location, const float* params) const {
+}
+
+void NullGL20::glGetUniformiv (int program, int location, const int* params) const {
+}
+
+int NullGL20::glGetUniformLocation (int program, const std::string& name) const {
+    return 0;
+}
+
+void NullGL20::glGetVertexAttribfv (int index, int pname, const float* params) const {
+}
+
+void NullGL20::glGetVertexAttribiv (int index, int pname, const int* params) const {
+}
+
+void NullGL20::glGetVertexAttribPointerv (int index, int pname, const char* pointer) const {
+}
+
+bool NullGL20::glIsBuffer (int buffer) const {
+    return false;
+}
+
+bool NullGL20::glIsEnabled (int cap) const {
+    return false;
+}
+
+bool NullGL20::glIsFramebuffer (int framebuffer) const {
+    return false;
+}
+
+bool NullGL20::glIsProgram (int program) const {
+    return false;
+}
+
+bool NullGL20::glIsRenderbuffer (int renderbuffer) const {
+    return false;
+}
+
+bool NullGL20::glIsShader (int shader) const {
+    return false;
+}
+
+bool NullGL20::glIsTexture (int texture) const {
+    return false;
+}
+
+void NullGL20::glLinkProgram (int program) const {
+}
+
+void NullGL20::glReleaseShaderCompiler () const {
+}
+
+void NullGL20::glRenderbufferStorage (int target, int internalformat, int width, int height) const {
+}
+
+void NullGL20::glSampleCoverage (float value, bool invert) const {
+}
+
+void NullGL20::glShaderBinary (int n, const int* shaders, int binaryformat, const char* binary, int length) const {
+}
+
+void NullGL20::glShaderSource (int shader, const std::string& string) const {
+}
+
+void NullGL20::glStencilFuncSeparate (int face, int func, int ref, int mask) const {
+}
+
+void NullGL20::glStencilMaskSeparate (int face, int mask) const {
+}
+
+void NullGL20::glStencilOpSeparate (int face, int fail, int zfail, int zpass) const {
+}
+
+void NullGL20::glTexParameterfv (int target, int pname, const float* params) const {
+}
+
+void NullGL20::glTexParameteri (int target, int pname, int param) const {
+}
+
+void NullGL20::glTexParameteriv (int target, int pname, const int* params) const {
+}
+
+void NullGL20::glUniform1f (int location, float x) const {
+}
+
+void NullGL20::glUniform1fv (int location, int count, const float* v) const {
+}
+
+void NullGL20::glUniform1i (int location, int x) const {
+}
+
+void NullGL20::glUniform1iv (int location, int count, const int* v) const {
+}
+
+void NullGL20::glUniform2f (int location, float x, float y) const {
+}
+
+void NullGL20::glUniform2fv (int location, int count, const float* v) const {
+}
+
+void NullGL20::glUniform2i (int location, int x, int y) const {
+}
+
+void NullGL20::glUniform2iv (int location, int count, const int* v) const {
+}
+
+void NullGL20::glUniform3f (int location, float x, float y, float z) const {
+}
+
+void NullGL20::glUniform3fv (int location, int count, const float* v) const {
+}
+
+void NullGL20::glUniform3i (int location, int x, int y, int z) const {
+}
+
+void NullGL20::glUniform3iv (int location, int count, const int* v) const {
+}
+
+void NullGL20::glUniform4f (int location, float x, float y, float z, float w) const {
+}
+
+void NullGL20::glUniform4fv (int location, int count, const float* v) const {
+}
+
+void NullGL20::glUniform4i (int location, int x, int y, int z, int w) const {
+}
+
+void NullGL20::glUniform4iv (int location, int count, const int* v) const {
+}
+
+void NullGL20::glUniformMatrix2fv (int location, int count, bool transpose, const float* value) const {
+}
+
+void NullGL20::glUniformMatrix3fv (int location, int count, bool transpose, const float* value) const {
+}
+
+void NullGL20::glUniformMatrix4fv (int location, int count, bool transpose, const float* value) const {
+}
+
+void NullGL20::glUseProgram (int program) const {
+}
+
+void NullGL20::glValidateProgram (int program) const {
+}
+
+void NullGL20::glVertexAttrib1f (int indx, float x) const {
+}
+
+void NullGL20::glVertexAttrib1fv (int indx, const float* values) const {
+}
+
+void NullGL20::glVertexAttrib2f (int indx, float x, float y) const {
+}
+
+void NullGL20::glVertexAttrib2fv (int indx, const float* values) const {
+}
+
+void NullGL20::glVertexAttrib3f (int indx, float x, float y, float z) const {
+}
+
+void NullGL20::glVertexAttrib3fv (int indx, const float* values) const {
+}
+
+void NullGL20::glVertexAttrib4f (int indx, float x, float y, float z, float w) const {
+}
+
+void NullGL20::glVertexAttrib4fv (int indx, const float* values) const {
+}
+
+void NullGL20::glVertexAttribPointer (int indx, int size, int type, bool normalized, int stride, const void* ptr) const {
+}
+
+void NullGL20::glVertexAttribPointer (int indx, int size, int type, bool normalized, int stride, int ptr) const {
+}
@@ -0,0 +1,217 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "NullGraphics.hpp"
+#include "gdx-cpp/Gdx.hpp"
+
+#include <cstdarg>
+#include <cstdio>
+
+using namespace gdx_cpp;
+using namespace gdx_cpp::benchmarks;
+
+namespace {
+class NullDisplayMode : public Graphics::DisplayMode {
+public:
+    NullDisplayMode (int width, int height)
+    : DisplayMode(width, height, 60, 32)
+    {
+    }
+};
+}
+
+NullGraphics::NullGraphics (int width, int height)
+: width(width)
+, height(height)
+{
+    displayModes.push_back(NullDisplayMode(width, height));
+}
+
+bool NullGraphics::isGL11Available () {
+    return false;
+}
+
+bool NullGraphics::isGL20Available () {
+    return true;
+}
+
+graphics::GLCommon* NullGraphics::getGLCommon () {
+    return &gl;
+}
+
+graphics::GL10* NullGraphics::getGL10 () {
+    return NULL;
+}
+
+graphics::GL11* NullGraphics::getGL11 () {
+    return NULL;
+}
+
+graphics::GL20* NullGraphics::getGL20 () {
+    return &gl;
+}
+
+graphics::GLU* NullGraphics::getGLU () {
+    return NULL;
+}
+
+int NullGraphics::getWidth () {
+    return width;
+}
+
+int NullGraphics::getHeight () {
+    return height;
+}
+
+float NullGraphics::getDeltaTime () {
+    return 1 / 60.0f;
+}
+
+int NullGraphics::getFramesPerSecond () {
+    return 60;
+}
+
+Graphics::GraphicsType NullGraphics::getType () {
+    return SdlGL;
+}
+
+float NullGraphics::getPpiX () {
+    return 96;
+}
+
+float NullGraphics::getPpiY () {
+    return 96;
+}
+
+float NullGraphics::getPpcX () {
+    return 96 / 2.54f;
+}
+
+float NullGraphics::getPpcY () {
+    return 96 / 2.54f;
+}
+
+float NullGraphics::getDensity () {
+    return 1;
+}
+
+bool NullGraphics::supportsDisplayModeChange () {
+    return false;
+}
+
+std::vector<Graphics::DisplayMode>& NullGraphics::getDisplayModes () {
+    return displayModes;
+}
+
+Graphics::DisplayMode NullGraphics::getDesktopDisplayMode () {
+    return displayModes[0];
+}
+
+bool NullGraphics::setDisplayMode (DisplayMode displayMode) {
+    return false;
+}
+
+bool NullGraphics::setDisplayMode (int width, int height, bool fullscreen) {
+    return false;
+}
+
+void NullGraphics::setTitle (const std::string& title) {
+}
+
+void NullGraphics::setIcon (graphics::Pixmap::ptr pixmap) {
+}
+
+void NullGraphics::setVSync (bool vsync) {
+}
+
+Graphics::BufferFormat NullGraphics::getBufferFormat () {
+    return BufferFormat(8, 8, 8, 8, 16, 0, 0, false);
+}
+
+bool NullGraphics::supportsExtension (const std::string& extension) {
+    return false;
+}
+
+NullApplication::NullApplication (Graphics* graphics)
+: graphics(graphics)
+, logLevel(LOG_ERROR)
+{
+}
+
+Graphics* NullApplication::getGraphics () {
+    return graphics;
+}
+
+Audio* NullApplication::getAudio () {
+    return NULL;
+}
+
+Input* NullApplication::getInput () {
+    return NULL;
+}
+
+Files* NullApplication::getFiles () {
+    return NULL;
+}
+
+void NullApplication::log (const std::string& tag, const char* format, ...) {
+    if (logLevel != LOG_INFO) return;
+    va_list list;
+    va_start(list, format);
+    fprintf(stderr, "%s: ", tag.c_str());
+    vfprintf(stderr, format, list);
+    fprintf(stderr, "\n");
+    va_end(list);
+}
+
+void NullApplication::error (const std::string& tag, const char* format, ...) {
+    if (logLevel == LOG_NONE) return;
+    va_list list;
+    va_start(list, format);
+    fprintf(stderr, "%s: ", tag.c_str());
+    vfprintf(stderr, format, list);
+    fprintf(stderr, "\n");
+    va_end(list);
+}
+
+void NullApplication::setLogLevel (int logLevel) {
+    this->logLevel = logLevel;
+}
+
+Application::ApplicationType NullApplication::getType () {
+    return Desktop;
+}
+
+int NullApplication::getVersion () {
+    return 0;
+}
+
+Preferences* NullApplication::getPreferences (std::string& name) {
+    return NULL;
+}
+
+void NullApplication::postRunnable (Runnable::ptr runnable) {
+    runnable->run();
+}
+
+void NullApplication::exit () {
+}
+
+void gdx_cpp::benchmarks::initializeNullBackend (int width, int height) {
+    static NullGraphics graphics(width, height);
+    static NullApplication application(&graphics);
+    Gdx::initialize(&application, &graphics, NULL, NULL, NULL);
+}
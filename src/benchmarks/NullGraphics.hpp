@@ -0,0 +1,95 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef GDX_CPP_BENCHMARKS_NULLGRAPHICS_HPP_
+#define GDX_CPP_BENCHMARKS_NULLGRAPHICS_HPP_
+
+#include "gdx-cpp/Application.hpp"
+#include "gdx-cpp/Graphics.hpp"
+#include "NullGL20.hpp"
+
+namespace gdx_cpp {
+namespace benchmarks {
+
+/** A headless GL 2.0 Graphics backed by {@link NullGL20} with a fixed size and frame time */
+class NullGraphics : public Graphics {
+public:
+    NullGraphics (int width, int height);
+
+    bool isGL11Available ();
+    bool isGL20Available ();
+    graphics::GLCommon* getGLCommon ();
+    graphics::GL10* getGL10 ();
+    graphics::GL11* getGL11 ();
+    graphics::GL20* getGL20 ();
+    graphics::GLU* getGLU ();
+    int getWidth ();
+    int getHeight ();
+    float getDeltaTime ();
+    int getFramesPerSecond ();
+    GraphicsType getType ();
+    float getPpiX ();
+    float getPpiY ();
+    float getPpcX ();
+    float getPpcY ();
+    float getDensity ();
+    bool supportsDisplayModeChange ();
+    std::vector<DisplayMode>& getDisplayModes ();
+    DisplayMode getDesktopDisplayMode ();
+    bool setDisplayMode (DisplayMode displayMode);
+    bool setDisplayMode (int width, int height, bool fullscreen);
+    void setTitle (const std::string& title);
+    void setIcon (graphics::Pixmap::ptr pixmap);
+    void setVSync (bool vsync);
+    BufferFormat getBufferFormat ();
+    bool supportsExtension (const std::string& extension);
+
+private:
+    NullGL20 gl;
+    int width, height;
+    std::vector<DisplayMode> displayModes;
+};
+
+/** An Application without audio, input or files that logs to stdout and runs posted runnables right away */
+class NullApplication : public Application {
+public:
+    NullApplication (Graphics* graphics);
+
+    Graphics* getGraphics ();
+    Audio* getAudio ();
+    Input* getInput ();
+    Files* getFiles ();
+    void log (const std::string& tag, const char* format, ...);
+    void error (const std::string& tag, const char* format, ...);
+    void setLogLevel (int logLevel);
+    ApplicationType getType ();
+    int getVersion ();
+    Preferences* getPreferences (std::string& name);
+    void postRunnable (Runnable::ptr runnable);
+    void exit ();
+
+private:
+    Graphics* graphics;
+    int logLevel;
+};
+
+/** Installs a NullApplication and NullGraphics of the given size as Gdx::app and Gdx::graphics */
+void initializeNullBackend (int width, int height);
+
+} // namespace gdx_cpp
+} // namespace benchmarks
+
+#endif // GDX_CPP_BENCHMARKS_NULLGRAPHICS_HPP_
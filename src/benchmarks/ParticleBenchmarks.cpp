@@ -0,0 +1,98 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Benchmark.hpp"
+#include "gdx-cpp/graphics/Pixmap.hpp"
+#include "gdx-cpp/graphics/Texture.hpp"
+#include "gdx-cpp/graphics/g2d/ParticleEmitter.hpp"
+#include "gdx-cpp/graphics/g2d/Sprite.hpp"
+
+#include <vector>
+
+using namespace gdx_cpp::graphics;
+using namespace gdx_cpp::graphics::g2d;
+using namespace gdx_cpp::benchmarks;
+
+namespace {
+
+/** A continuous emitter kept at about maxParticles live particles, with velocity, gravity, rotation and a fading
+ * transparency so every per particle update path runs. Reported per particle. */
+class EmitterUpdateBenchmark : public Benchmark {
+public:
+    EmitterUpdateBenchmark (const std::string& name, int maxParticles)
+    : Benchmark(name, maxParticles, "particle")
+    , maxParticles(maxParticles)
+    , emitter(NULL)
+    {
+    }
+
+    void setUp () {
+        Pixmap::ptr pixmap(new Pixmap(32, 32, Pixmap::Format::RGBA8888));
+        texture = Texture::ptr(new Texture(pixmap, false));
+
+        emitter = new ParticleEmitter();
+        emitter->setSprite(Sprite::ptr(new Sprite(texture)));
+        emitter->setMaxParticleCount(maxParticles);
+        emitter->setContinuous(true);
+        emitter->getDuration().setLow(1000);
+        emitter->getEmission().setHigh(maxParticles);
+        emitter->getLife().setHigh(1000);
+        emitter->getScale().setHigh(16, 32);
+
+        emitter->getVelocity().setActive(true);
+        emitter->getVelocity().setHigh(50, 150);
+        emitter->getAngle().setActive(true);
+        emitter->getAngle().setHigh(0, 360);
+        emitter->getGravity().setActive(true);
+        emitter->getGravity().setHigh(-50);
+        emitter->getRotation().setActive(true);
+        emitter->getRotation().setHigh(0, 720);
+
+        std::vector<float> timeline(2), fade(2);
+        timeline[1] = 1;
+        fade[0] = 1;
+        emitter->getTransparency().setHigh(1);
+        emitter->getTransparency().setTimeline(timeline);
+        emitter->getTransparency().setScaling(fade);
+        emitter->getRotation().setTimeline(timeline);
+        emitter->getRotation().setScaling(timeline);
+
+        emitter->setPosition(400, 240);
+        emitter->start();
+
+        // run for longer than a particle lives, so the measured updates see the steady state
+        for (int i = 0; i < 120; i++)
+            emitter->update(1 / 60.0f);
+    }
+
+    void run () {
+        emitter->update(1 / 60.0f);
+    }
+
+    void tearDown () {
+        delete emitter;
+        texture = Texture::ptr();
+    }
+
+private:
+    int maxParticles;
+    ParticleEmitter* emitter;
+    Texture::ptr texture;
+};
+
+EmitterUpdateBenchmark emitterUpdate("particles/emitter-update", 2000);
+
+}
@@ -0,0 +1,76 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Benchmark.hpp"
+#include "Box2D/Box2D.h"
+
+using namespace gdx_cpp::benchmarks;
+
+namespace {
+
+/** Steps a pyramid of boxes resting on the ground, the classic Box2D stacking benchmark. Sleeping is disabled so
+ * every step solves all contacts; reported per step. */
+class PyramidBenchmark : public Benchmark {
+public:
+    PyramidBenchmark (const std::string& name, int rows)
+    : Benchmark(name, 1, "step")
+    , rows(rows)
+    , world(NULL)
+    {
+    }
+
+    void setUp () {
+        world = new b2World(b2Vec2(0, -10), false);
+
+        b2BodyDef groundDef;
+        b2Body* ground = world->CreateBody(&groundDef);
+        b2PolygonShape groundShape;
+        groundShape.SetAsEdge(b2Vec2(-40, 0), b2Vec2(40, 0));
+        ground->CreateFixture(&groundShape, 0);
+
+        b2PolygonShape box;
+        box.SetAsBox(0.5f, 0.5f);
+        for (int row = 0; row < rows; row++) {
+            for (int column = row; column < rows; column++) {
+                b2BodyDef bodyDef;
+                bodyDef.type = b2_dynamicBody;
+                bodyDef.position.Set(-rows * 0.5625f + row * 0.5625f + (column - row) * 1.125f, 0.75f + row);
+                world->CreateBody(&bodyDef)->CreateFixture(&box, 5);
+            }
+        }
+
+        // let the stack settle so the measured steps are the resting contact workload
+        for (int i = 0; i < 60; i++)
+            world->Step(1 / 60.0f, 8, 3);
+    }
+
+    void run () {
+        world->Step(1 / 60.0f, 8, 3);
+    }
+
+    void tearDown () {
+        delete world;
+        world = NULL;
+    }
+
+private:
+    int rows;
+    b2World* world;
+};
+
+PyramidBenchmark pyramid("box2d/world-step-pyramid-20", 20);
+
+}
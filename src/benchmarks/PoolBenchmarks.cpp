@@ -0,0 +1,86 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Benchmark.hpp"
+#include "gdx-cpp/utils/Pool.hpp"
+
+#include <vector>
+
+using namespace gdx_cpp::utils;
+using namespace gdx_cpp::benchmarks;
+
+namespace {
+
+const int OBJECTS = 1024;
+
+/** About the size of a particle's or body's hot state */
+struct Object {
+    Object () : life(0) {
+    }
+
+    float position[2], velocity[2];
+    float rotation, scale, transparency;
+    int life;
+    float tint[8];
+};
+
+/** Obtains OBJECTS objects, touches them and frees them again in a shuffled order, as particles die out of order.
+ * Reported per object. */
+class ObtainFreeBenchmark : public Benchmark {
+public:
+    ObtainFreeBenchmark (const std::string& name, bool pooled)
+    : Benchmark(name, OBJECTS, "object")
+    , pooled(pooled)
+    , pool(OBJECTS)
+    , objects(OBJECTS)
+    , order(OBJECTS)
+    {
+        for (int i = 0; i < OBJECTS; i++)
+            order[i] = (i * 389) % OBJECTS;
+    }
+
+    void run () {
+        for (int i = 0; i < OBJECTS; i++) {
+            Object* object = pooled ? &pool.obtain() : new Object();
+            object->life = i;
+            objects[i] = object;
+        }
+
+        int sum = 0;
+        for (int i = 0; i < OBJECTS; i++)
+            sum += objects[i]->life;
+        doNotOptimize(sum);
+
+        for (int i = 0; i < OBJECTS; i++) {
+            Object* object = objects[order[i]];
+            if (pooled)
+                pool.free(object);
+            else
+                delete object;
+        }
+    }
+
+private:
+    bool pooled;
+    Pool<Object> pool;
+    std::vector<Object*> objects;
+    std::vector<int> order;
+};
+
+ObtainFreeBenchmark pool("pools/obtain-free-1024/pool", true);
+ObtainFreeBenchmark heap("pools/obtain-free-1024/new-delete", false);
+
+}
@@ -0,0 +1,165 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Benchmark.hpp"
+#include "gdx-cpp/utils/AtomicQueue.hpp"
+#include "gdx-cpp/utils/MpmcQueue.hpp"
+#include "gdx-cpp/utils/MpscQueue.hpp"
+
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace gdx_cpp::utils;
+using namespace gdx_cpp::benchmarks;
+
+namespace {
+
+const int ITEMS = 1 << 16;
+const int CAPACITY = 1024;
+const int STOP = -1;
+
+/** The mutex around a std::list that postRunnable used before, as the baseline */
+class LockedList {
+public:
+    bool put (int value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        values.push_back(value);
+        return true;
+    }
+
+    bool poll (int& value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (values.empty()) return false;
+        value = values.front();
+        values.pop_front();
+        return true;
+    }
+
+private:
+    std::mutex mutex;
+    std::list<int> values;
+};
+
+inline bool put (AtomicQueue<int>& queue, int value) {
+    return queue.put(value);
+}
+
+inline bool put (MpmcQueue<int>& queue, int value) {
+    return queue.put(value);
+}
+
+inline bool put (MpscQueue<int>& queue, int value) {
+    queue.put(value);
+    return true;
+}
+
+inline bool put (LockedList& queue, int value) {
+    return queue.put(value);
+}
+
+template <typename Queue>
+void producer (Queue* queue, int count) {
+    for (int i = 0; i < count; i++) {
+        while (!put(*queue, i))
+            std::this_thread::yield();
+    }
+}
+
+template <typename Queue>
+void consumer (Queue* queue, long long* sum) {
+    int value;
+    for (;;) {
+        if (!queue->poll(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (value == STOP) return;
+        *sum += value;
+    }
+}
+
+/** Moves ITEMS ints from the producer threads to the consumer threads, reported per item. The spawn and join of the
+ * threads is included, which is why the item count is large. */
+template <typename Queue>
+class QueueBenchmark : public Benchmark {
+public:
+    QueueBenchmark (const std::string& name, int producers, int consumers)
+    : Benchmark(name, ITEMS, "item")
+    , producers(producers)
+    , consumers(consumers)
+    {
+    }
+
+    void run () {
+        Queue* queue = newQueue((Queue*) NULL);
+        std::vector<long long> sums(consumers);
+        std::vector<std::thread> consumerThreads;
+        for (int i = 0; i < consumers; i++)
+            consumerThreads.push_back(std::thread(consumer<Queue>, queue, &sums[i]));
+
+        std::vector<std::thread> producerThreads;
+        for (int i = 0; i < producers; i++)
+            producerThreads.push_back(std::thread(producer<Queue>, queue, ITEMS / producers));
+        for (int i = 0; i < producers; i++)
+            producerThreads[i].join();
+
+        // the producers are done, so this thread may put even to the single producer queue
+        for (int i = 0; i < consumers; i++) {
+            while (!put(*queue, STOP))
+                std::this_thread::yield();
+        }
+        for (int i = 0; i < consumers; i++)
+            consumerThreads[i].join();
+
+        delete queue;
+        doNotOptimize(sums[0]);
+    }
+
+private:
+    int producers;
+    int consumers;
+
+    static AtomicQueue<int>* newQueue (AtomicQueue<int>*) {
+        return new AtomicQueue<int>(CAPACITY);
+    }
+
+    static MpmcQueue<int>* newQueue (MpmcQueue<int>*) {
+        return new MpmcQueue<int>(CAPACITY);
+    }
+
+    static MpscQueue<int>* newQueue (MpscQueue<int>*) {
+        return new MpscQueue<int>();
+    }
+
+    static LockedList* newQueue (LockedList*) {
+        return new LockedList();
+    }
+};
+
+QueueBenchmark<AtomicQueue<int> > spsc("queues/spsc/1p1c", 1, 1);
+QueueBenchmark<MpmcQueue<int> > mpmc1("queues/mpmc/1p1c", 1, 1);
+QueueBenchmark<MpmcQueue<int> > mpmc2("queues/mpmc/2p2c", 2, 2);
+QueueBenchmark<MpmcQueue<int> > mpmc4("queues/mpmc/4p4c", 4, 4);
+QueueBenchmark<MpscQueue<int> > mpsc1("queues/mpsc/1p1c", 1, 1);
+QueueBenchmark<MpscQueue<int> > mpsc2("queues/mpsc/2p1c", 2, 1);
+QueueBenchmark<MpscQueue<int> > mpsc4("queues/mpsc/4p1c", 4, 1);
+QueueBenchmark<LockedList> locked1("queues/mutex-list/1p1c", 1, 1);
+QueueBenchmark<LockedList> locked2("queues/mutex-list/2p1c", 2, 1);
+QueueBenchmark<LockedList> locked4("queues/mutex-list/4p1c", 4, 1);
+
+}
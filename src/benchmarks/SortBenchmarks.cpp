@@ -0,0 +1,150 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Benchmark.hpp"
+#include "StdThreadFactory.hpp"
+#include "gdx-cpp/utils/RadixSort.hpp"
+#include "gdx-cpp/utils/TimSort.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+using namespace gdx_cpp::utils;
+using namespace gdx_cpp::benchmarks;
+
+namespace {
+
+const int ELEMENTS = 50000;
+
+/** What a depth sort moves around: the key and a handle to the sprite */
+struct DrawItem {
+    float depth;
+    int sprite;
+};
+
+struct ByDepth {
+    bool operator() (const DrawItem& a, const DrawItem& b) const {
+        return a.depth < b.depth;
+    }
+};
+
+uint32_t depthKey (const DrawItem& item) {
+    return RadixSort<DrawItem>::floatKey(item.depth);
+}
+
+enum Algorithm {
+    STD_STABLE_SORT, TIM_SORT, PARALLEL_TIM_SORT, RADIX_SORT
+};
+
+/** Stable sorts ELEMENTS draw items by depth, reported per element. Random input is shuffled depths; nearly sorted
+ * input is last frame's order with a few percent of the items moved, as in a scene where a few sprites change depth.
+ * setUp checks the sort against std::stable_sort on the input and on depths with many ties, and throws on a mismatch,
+ * so a sort that is wrong or not stable fails the run instead of reporting a fast time. */
+class DepthSortBenchmark : public Benchmark {
+public:
+    DepthSortBenchmark (const std::string& name, Algorithm algorithm, bool nearlySorted)
+    : Benchmark(name, ELEMENTS, "element")
+    , algorithm(algorithm)
+    , nearlySorted(nearlySorted)
+    {
+    }
+
+    void setUp () {
+        std::mt19937 random(42);
+        std::uniform_real_distribution<float> depths(-1000, 1000);
+        input.resize(ELEMENTS);
+        for (int i = 0; i < ELEMENTS; i++) {
+            input[i].depth = depths(random);
+            input[i].sprite = i;
+        }
+
+        if (nearlySorted) {
+            std::stable_sort(input.begin(), input.end(), ByDepth());
+            for (int i = 0; i < ELEMENTS / 32; i++)
+                input[random() % ELEMENTS].depth = depths(random);
+        }
+        items = input;
+        if (algorithm == PARALLEL_TIM_SORT) benchmarkJobSystem();
+        if (algorithm == STD_STABLE_SORT) return;
+
+        verify(input, "input");
+
+        // 64 distinct depths, so every run of equal keys has to keep its order; no -0, which radix sorts before 0
+        std::vector<DrawItem> ties(input);
+        for (int i = 0; i < ELEMENTS; i++)
+            ties[i].depth = std::floor(ties[i].depth / 32) * 32;
+        verify(ties, "ties");
+    }
+
+    void run () {
+        std::copy(input.begin(), input.end(), items.begin());
+        sort(items);
+        doNotOptimize(items[ELEMENTS / 2].sprite);
+    }
+
+private:
+    void sort (std::vector<DrawItem>& items) {
+        switch (algorithm) {
+        case STD_STABLE_SORT:
+            std::stable_sort(items.begin(), items.end(), ByDepth());
+            break;
+        case TIM_SORT:
+            timSort.sort(items);
+            break;
+        case PARALLEL_TIM_SORT:
+            timSort.parallelSort(benchmarkJobSystem(), items);
+            break;
+        case RADIX_SORT:
+            radixSort.sort(items, depthKey);
+            break;
+        }
+    }
+
+    void verify (const std::vector<DrawItem>& data, const char* what) {
+        std::vector<DrawItem> expected(data), actual(data);
+        std::stable_sort(expected.begin(), expected.end(), ByDepth());
+        sort(actual);
+        for (int i = 0; i < ELEMENTS; i++) {
+            if (actual[i].depth != expected[i].depth || actual[i].sprite != expected[i].sprite) {
+                std::stringstream message;
+                message << getName() << ": " << what << " element " << i << " disagrees with std::stable_sort";
+                throw std::runtime_error(message.str());
+            }
+        }
+    }
+
+    Algorithm algorithm;
+    bool nearlySorted;
+    std::vector<DrawItem> input;
+    std::vector<DrawItem> items;
+    TimSort<DrawItem, ByDepth> timSort;
+    RadixSort<DrawItem> radixSort;
+};
+
+DepthSortBenchmark stdRandom("sort/depth-50k/random/std-stable-sort", STD_STABLE_SORT, false);
+DepthSortBenchmark timRandom("sort/depth-50k/random/timsort", TIM_SORT, false);
+DepthSortBenchmark parallelRandom("sort/depth-50k/random/timsort-parallel", PARALLEL_TIM_SORT, false);
+DepthSortBenchmark radixRandom("sort/depth-50k/random/radix", RADIX_SORT, false);
+DepthSortBenchmark stdNearly("sort/depth-50k/nearly-sorted/std-stable-sort", STD_STABLE_SORT, true);
+DepthSortBenchmark timNearly("sort/depth-50k/nearly-sorted/timsort", TIM_SORT, true);
+DepthSortBenchmark parallelNearly("sort/depth-50k/nearly-sorted/timsort-parallel", PARALLEL_TIM_SORT, true);
+DepthSortBenchmark radixNearly("sort/depth-50k/nearly-sorted/radix", RADIX_SORT, true);
+
+}
@@ -0,0 +1,74 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "StdThreadFactory.hpp"
+
+#include <chrono>
+#include <thread>
+
+using namespace gdx_cpp::benchmarks;
+using namespace gdx_cpp::implementation;
+
+namespace {
+
+class StdThread : public Thread {
+public:
+    StdThread (Runnable* runnable)
+    : runnable(runnable)
+    {
+    }
+
+    ~StdThread () {
+        join();
+    }
+
+    void start () {
+        thread = std::thread(&Runnable::run, runnable);
+    }
+
+    void yield () {
+        std::this_thread::yield();
+    }
+
+    void sleep (long millis) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(millis));
+    }
+
+    void join () {
+        if (thread.joinable()) thread.join();
+    }
+
+    const std::string getThreadName () {
+        return "benchmark worker";
+    }
+
+private:
+    Runnable* runnable;
+    std::thread thread;
+};
+
+}
+
+Thread::ptr StdThreadFactory::createThread (Runnable* runnable) {
+    return Thread::ptr(new StdThread(runnable));
+}
+
+JobSystem& gdx_cpp::benchmarks::benchmarkJobSystem () {
+    static StdThreadFactory factory;
+    int processors = (int) std::thread::hardware_concurrency();
+    static JobSystem jobSystem(&factory, processors > 1 ? processors - 1 : 0);
+    return jobSystem;
+}
@@ -0,0 +1,38 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef GDX_CPP_BENCHMARKS_STDTHREADFACTORY_HPP_
+#define GDX_CPP_BENCHMARKS_STDTHREADFACTORY_HPP_
+
+#include "gdx-cpp/implementation/JobSystem.hpp"
+#include "gdx-cpp/implementation/ThreadFactory.hpp"
+
+namespace gdx_cpp {
+namespace benchmarks {
+
+/** Creates std::threads, standing in for a backend's ThreadFactory */
+class StdThreadFactory : public implementation::ThreadFactory {
+public:
+    implementation::Thread::ptr createThread (Runnable* runnable);
+};
+
+/** The job system shared by the benchmarks, with a worker for each processor but the main thread's */
+implementation::JobSystem& benchmarkJobSystem ();
+
+} // namespace gdx_cpp
+} // namespace benchmarks
+
+#endif // GDX_CPP_BENCHMARKS_STDTHREADFACTORY_HPP_
@@ -0,0 +1,149 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Benchmark.hpp"
+#include "gdx-cpp/utils/JsonWriter.hpp"
+#include "gdx-cpp/utils/WriteBuffer.hpp"
+#include "gdx-cpp/utils/XmlWriter.hpp"
+
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace gdx_cpp::utils;
+using namespace gdx_cpp::benchmarks;
+
+namespace {
+
+const int ENTITIES = 20000;
+
+struct Entity {
+    std::string name;
+    int id;
+    float x, y, rotation;
+    double health;
+    bool alive;
+};
+
+std::vector<Entity> saveGame () {
+    std::mt19937 random(3);
+    std::uniform_real_distribution<float> position(-5000, 5000);
+    std::vector<Entity> entities(ENTITIES);
+    for (int i = 0; i < ENTITIES; i++) {
+        Entity& entity = entities[i];
+        entity.name = "entity \"" + std::to_string(random() % 1000) + "\"";
+        entity.id = i;
+        entity.x = position(random);
+        entity.y = position(random);
+        entity.rotation = position(random) / 100;
+        entity.health = random() % 10000 / 7.0;
+        entity.alive = i % 3 != 0;
+    }
+    return entities;
+}
+
+enum Format {
+    JSON,
+    XML,
+    /** JSON through an ostringstream, the way strings used to be built */
+    JSON_STREAM
+};
+
+void writeStreamString (std::ostream& out, const std::string& value) {
+    out << '"';
+    for (size_t i = 0; i < value.size(); i++) {
+        if (value[i] == '"' || value[i] == '\\') out << '\\';
+        out << value[i];
+    }
+    out << '"';
+}
+
+/** Writes the same save game per run into a reused buffer, reported per byte of output */
+class WriterBenchmark : public Benchmark {
+public:
+    WriterBenchmark (const std::string& name, Format format)
+    : Benchmark(name, 1, "byte")
+    , format(format)
+    {
+    }
+
+    void setUp () {
+        entities = saveGame();
+        items = (int) write();
+    }
+
+    void run () {
+        doNotOptimize(write());
+    }
+
+    void tearDown () {
+        entities = std::vector<Entity>();
+        buffer.clear();
+    }
+
+private:
+    size_t write () {
+        if (format == JSON_STREAM) {
+            std::ostringstream out;
+            out.precision(17);
+            out << "{\"entities\":[";
+            for (size_t i = 0; i < entities.size(); i++) {
+                const Entity& entity = entities[i];
+                out << (i ? ",{\"name\":" : "{\"name\":");
+                writeStreamString(out, entity.name);
+                out << ",\"id\":" << entity.id << ",\"x\":" << entity.x << ",\"y\":" << entity.y << ",\"rotation\":"
+                    << entity.rotation << ",\"health\":" << entity.health << ",\"alive\":"
+                    << (entity.alive ? "true" : "false") << '}';
+            }
+            out << "]}";
+            return out.str().size();
+        }
+
+        buffer.clear();
+        if (format == JSON) {
+            JsonWriter json(buffer);
+            json.object().array("entities");
+            for (size_t i = 0; i < entities.size(); i++) {
+                const Entity& entity = entities[i];
+                json.object().set("name", entity.name).set("id", entity.id).set("x", entity.x).set("y", entity.y)
+                    .set("rotation", entity.rotation).set("health", entity.health).set("alive", entity.alive).pop();
+            }
+            json.close();
+        } else {
+            XmlWriter xml(buffer);
+            xml.element("save");
+            for (size_t i = 0; i < entities.size(); i++) {
+                const Entity& entity = entities[i];
+                xml.element("entity").attribute("id", entity.id).attribute("x", entity.x).attribute("y", entity.y)
+                    .attribute("rotation", entity.rotation).attribute("health", entity.health)
+                    .attribute("alive", entity.alive).text(entity.name).pop();
+            }
+            xml.close();
+        }
+        return buffer.getSize();
+    }
+
+    Format format;
+    std::vector<Entity> entities;
+    WriteBuffer buffer;
+};
+
+WriterBenchmark jsonWriter("writer/savegame/json", JSON);
+WriterBenchmark xmlWriter("writer/savegame/xml", XML);
+WriterBenchmark jsonStream("writer/savegame/json-ostringstream", JSON_STREAM);
+
+}
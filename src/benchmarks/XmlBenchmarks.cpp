@@ -0,0 +1,163 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Benchmark.hpp"
+#include "gdx-cpp/graphics/g2d/tiled/TiledLoader.hpp"
+#include "gdx-cpp/utils/Base64Coder.hpp"
+#include "gdx-cpp/utils/GzipWriter.hpp"
+#include "gdx-cpp/utils/XmlReader.hpp"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace gdx_cpp::utils;
+using namespace gdx_cpp::graphics::g2d::tiled;
+using namespace gdx_cpp::benchmarks;
+
+namespace {
+
+const int MAP_SIZE = 256;
+const int LAYERS = 4;
+
+enum DataFormat {
+    XML_DATA, CSV_DATA, BASE64_DATA, GZIP_DATA
+};
+
+class StringSink : public OutputSink {
+public:
+    void write (const char* data, size_t length) {
+        text.append(data, length);
+    }
+
+    std::string text;
+};
+
+/** A TMX map of LAYERS layers of MAP_SIZE^2 tiles with a few hundred objects. XML tile data, one element per tile, is
+ * the worst case for the parser, several megabytes of small elements; CSV and base64 data are mostly one long text. */
+std::string tmxDocument (DataFormat format) {
+    static const char* encodings[] = { "", " encoding=\"csv\"", " encoding=\"base64\"",
+                                       " encoding=\"base64\" compression=\"gzip\"" };
+    std::mt19937 random(42);
+    char line[256];
+    snprintf(line, sizeof(line), "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<map version=\"1.0\" "
+             "orientation=\"orthogonal\" width=\"%d\" height=\"%d\" tilewidth=\"32\" tileheight=\"32\">\n",
+             MAP_SIZE, MAP_SIZE);
+    std::string tmx = line;
+    tmx += " <tileset firstgid=\"1\" name=\"terrain\" tilewidth=\"32\" tileheight=\"32\">\n"
+           "  <image source=\"terrain.png\" width=\"512\" height=\"512\"/>\n"
+           "  <tile id=\"3\">\n   <properties>\n    <property name=\"solid\" value=\"true\"/>\n   </properties>\n"
+           "  </tile>\n </tileset>\n";
+
+    for (int l = 0; l < LAYERS; l++) {
+        snprintf(line, sizeof(line), " <layer name=\"layer %d\" width=\"%d\" height=\"%d\">\n  <data%s>\n", l, MAP_SIZE,
+                 MAP_SIZE, encodings[format]);
+        tmx += line;
+        std::vector<unsigned char> bytes;
+        for (int i = 0; i < MAP_SIZE * MAP_SIZE; i++) {
+            unsigned int gid = random() % 4 ? (unsigned int) (random() % 256) + 1 : 0;
+            if (format == BASE64_DATA || format == GZIP_DATA) {
+                for (int b = 0; b < 4; b++)
+                    bytes.push_back((unsigned char) (gid >> b * 8));
+                continue;
+            }
+            if (format == CSV_DATA) snprintf(line, sizeof(line), "%u%s", gid, (i + 1) % MAP_SIZE ? "," : ",\n");
+            else snprintf(line, sizeof(line), "   <tile gid=\"%u\"/>\n", gid);
+            tmx += line;
+        }
+        std::string binary(bytes.begin(), bytes.end());
+        if (format == GZIP_DATA) {
+            StringSink sink;
+            GzipWriter writer(sink);
+            writer.write(binary.data(), binary.size());
+            writer.finish();
+            binary = sink.text;
+        }
+        if (format == BASE64_DATA || format == GZIP_DATA) tmx += "   " + Base64Coder::encodeString(binary) + "\n";
+        tmx += "  </data>\n </layer>\n";
+    }
+
+    tmx += " <objectgroup name=\"spawns\" width=\"256\" height=\"256\">\n";
+    for (int i = 0; i < 500; i++) {
+        snprintf(line, sizeof(line), "  <object name=\"spawn %d\" type=\"enemy\" x=\"%u\" y=\"%u\" width=\"32\" "
+                 "height=\"32\"/>\n", i, (unsigned int) (random() % 8192), (unsigned int) (random() % 8192));
+        tmx += line;
+    }
+    tmx += " </objectgroup>\n</map>\n";
+    return tmx;
+}
+
+enum Mode {
+    PULL, DOM, TILED_LOADER
+};
+
+/** Parses a whole map per run, reported per byte of XML */
+class TmxBenchmark : public Benchmark {
+public:
+    TmxBenchmark (const std::string& name, Mode mode, DataFormat format)
+    : Benchmark(name, 1, "byte")
+    , mode(mode)
+    , format(format)
+    {
+    }
+
+    void setUp () {
+        tmx = tmxDocument(format);
+        items = (int) tmx.size();
+    }
+
+    void run () {
+        switch (mode) {
+        case PULL: {
+            XmlReader reader;
+            reader.open(tmx.data(), tmx.size());
+            int elements = 0;
+            while (reader.next() != XmlReader::END_DOCUMENT)
+                if (reader.getEvent() == XmlReader::START_ELEMENT) elements += reader.getAttributeCount();
+            doNotOptimize(elements);
+            break;
+        }
+        case DOM:
+            doNotOptimize(document.parse(tmx.data(), tmx.size())->getChildCount());
+            break;
+        case TILED_LOADER:
+            doNotOptimize(TiledLoader::createMap(tmx.data(), tmx.size())->layers.size());
+            break;
+        }
+    }
+
+    void tearDown () {
+        tmx = std::string();
+        document.clear();
+    }
+
+private:
+    Mode mode;
+    DataFormat format;
+    std::string tmx;
+    XmlDocument document;
+};
+
+TmxBenchmark xmlPull("xml/tmx-xml-data/pull", PULL, XML_DATA);
+TmxBenchmark xmlDom("xml/tmx-xml-data/dom", DOM, XML_DATA);
+TmxBenchmark xmlLoader("xml/tmx-xml-data/tiled-loader", TILED_LOADER, XML_DATA);
+TmxBenchmark csvPull("xml/tmx-csv-data/pull", PULL, CSV_DATA);
+TmxBenchmark csvLoader("xml/tmx-csv-data/tiled-loader", TILED_LOADER, CSV_DATA);
+TmxBenchmark base64Loader("xml/tmx-base64-data/tiled-loader", TILED_LOADER, BASE64_DATA);
+TmxBenchmark gzipLoader("xml/tmx-gzip-data/tiled-loader", TILED_LOADER, GZIP_DATA);
+
+}
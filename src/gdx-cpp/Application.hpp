@@ -23,6 +23,7 @@
 #include <string>
 #include <ostream>
 #include "gdx-cpp/utils/Runnable.hpp"
+#include "gdx-cpp/utils/FrameArena.hpp"
 
 class Runnable;
 
@@ -73,6 +74,15 @@ public:
     virtual void exit () = 0;
     void update();
     void pause();
+
+    /** Scratch memory for temporaries that don't outlive the frame, released by the application loop before each
+     * frame. Allocate through getFrameArena().local(). */
+    utils::FrameArena& getFrameArena () {
+        return frameArena;
+    }
+
+protected:
+    utils::FrameArena frameArena;
 };
 
 }
@@ -48,6 +48,11 @@ Thread& AssetManager::newThread (const Runnable& r) {
 }
 
 void AssetManager::remove (const std::string& fileName) {
+    GDX_CPP_SCOPED_LOCK(assetsLock, "AssetManager::remove");
+    removeAsset(fileName);
+}
+
+void AssetManager::removeAsset (const std::string& fileName) {
     // get the asset and its type
     Class type = assetTypes.get(fileName);
     if (type == null) throw new GdxRuntimeException("Asset '" + fileName + "' not loaded");
@@ -68,8 +73,8 @@ void AssetManager::remove (const std::string& fileName) {
     // remove any dependencies (which might also be reference counted)
     Array<String> dependencies = assetDependencies.remove(fileName);
     if (dependencies != null) {
-for (String dependency : dependencies) {
-            remove(dependency);
+        for (String dependency : dependencies) {
+            removeAsset(dependency);
         }
     }
 }
@@ -92,6 +97,7 @@ bool AssetManager::update () {
 }
 
 void AssetManager::nextTask () {
+    GDX_CPP_SCOPED_LOCK(assetsLock, "AssetManager::nextTask");
     AssetDescriptor::ptr assetDesc = preloadQueue.front();
     preloadQueue.pop_front();
     
@@ -114,8 +120,10 @@ void AssetManager::addTask (const AssetDescriptor& assetDesc) {
 
 bool AssetManager::updateTask () {
     AssetLoadingTask task = tasks.peek();
-    // if the task has finished loading
+    // if the task has finished loading; only publishing the asset needs the lock, loading runs without it
     if (task.update()) {
+        GDX_CPP_SCOPED_LOCK(assetsLock, "AssetManager::updateTask");
+
         // add the asset to the filename lookup
         assetTypes.put(task.assetDesc.fileName, task.assetDesc.type);
 
@@ -206,9 +214,10 @@ void AssetManager::clear () {
         }
     }
 
+    GDX_CPP_SCOPED_LOCK(assetsLock, "AssetManager::clear");
     Array<String> assets = assetTypes.keys().toArray();
-for (String asset : assets) {
-        remove(asset);
+    for (String asset : assets) {
+        removeAsset(asset);
     }
 
     this.assets.clear();
@@ -224,16 +233,18 @@ gdx_cpp::utils::Logger& AssetManager::getLogger () {
 }
 
 std::string& AssetManager::getDiagonistics () {
-    Synchronizable::lock_holder hnd(synchronize());
+    GDX_CPP_SCOPED_SHARED_LOCK(assetsLock, "AssetManager::getDiagnostics");
      std::stringstream buffer;
      AssetTypeMap::iterator it = assetTypes.begin();
      AssetTypeMap::iterator end = assetTypes.end();
      
-     for (; it != end; ++it)
-        buffer << it->first << ", ";
-        int type = assetTypes[it->first];
-        Asset::ptr asset = assets[type][it->first];
-        std::vector<std::string>& dependencies = assetDependencies[it->first];
+     for (; it != end; ++it) {
+        buffer << it->key << ", ";
+        int type = it->value;
+        // operator[] inserts on a miss, which would write under the shared lock
+        const AssetMap* typedAssets = assets.get(type);
+        Asset::ptr asset = typedAssets != NULL ? *typedAssets->get(it->key) : Asset::ptr();
+        const std::vector<std::string>* dependencies = assetDependencies.get(it->key);
 
         buffer << type;
 
@@ -242,9 +253,9 @@ std::string& AssetManager::getDiagonistics () {
             buffer.append(((ReferenceCountedAsset)asset).getRefCount());
         }
 
-        if (dependencies != null) {
+        if (dependencies != NULL) {
             buffer.append(", deps: [");
-for (String dep : dependencies) {
+            for (String dep : *dependencies) {
                 buffer.append(dep);
                 buffer.append(",");
             }
@@ -257,6 +268,7 @@ for (String dep : dependencies) {
 
 void AssetManager::injectDependency(const std::string& parentAssetFilename,
                                     gdx_cpp::assets::AssetDescriptor::ptr dependendAssetDesc) {
+    GDX_CPP_SCOPED_LOCK(assetsLock, "AssetManager::injectDependency");
     // add the asset as a dependency of the parent asset
 
     std::vector<std::string>& dependencies = assetDependencies[parentAssetFilename];
@@ -280,8 +292,8 @@ void AssetManager::injectDependency(const std::string& parentAssetFilename,
 }
 
 void AssetManager::setLoader(gdx_cpp::assets::AssetType& type, gdx_cpp::assets::loaders::AssetLoader* loader) {
-    Synchronizable::lock_holder hnd(synchronize());
-    loaders[type] = loader;
+    GDX_CPP_SCOPED_LOCK(assetsLock, "AssetManager::setLoader");
+    loaders[&type] = loader;
 }
 
 void AssetManager::preload(const std::string& fileName, AssetType& type) {
@@ -290,9 +302,9 @@ void AssetManager::preload(const std::string& fileName, AssetType& type) {
 }
 
 void AssetManager::preload(const std::string& fileName, const gdx_cpp::assets::AssetType& type, gdx_cpp::assets::AssetLoaderParameters::ptr parameter) {
-    Synchronizable::lock_holder hnd(synchronize());
+    GDX_CPP_SCOPED_LOCK(assetsLock, "AssetManager::preload");
 
-    loaders::AssetLoader* loader = loaders[type];
+    loaders::AssetLoader* loader = loaders.get(&type, NULL);
 
     if (loader == NULL) {
         gdx_cpp::Gdx::app->error("AssetManager.hpp") << "No loader for type '" + type.getSimpleName() + "'";
@@ -325,16 +337,18 @@ void AssetManager::preload(const std::string& fileName, const gdx_cpp::assets::A
 }
 
 bool AssetManager::getAssetFileName(const gdx_cpp::assets::Asset& asset, std::string& result) {
-    Synchronizable::lock_holder hnd(synchronize());
+    GDX_CPP_SCOPED_SHARED_LOCK(assetsLock, "AssetManager::getAssetFileName");
+
+    const AssetMap* typedAssets = assets.get(asset.getAssetType());
+    if (typedAssets == NULL) return false;
 
-    const AssetMap& typedAssets = assets[asset.getAssetType()];
-    AssetMap::const_iterator it = typedAssets.begin();
-    AssetMap::const_iterator end = typedAssets.end();
+    AssetMap::const_iterator it = typedAssets->begin();
+    AssetMap::const_iterator end = typedAssets->end();
 
     for (; it != end; ++it) {
-        Asset::ptr otherAsset = typedAssets[it->first];
+        const Asset::ptr& otherAsset = it->value;
         if (*otherAsset == asset) {
-            result = *it;
+            result = it->key;
             return true;
         }
     }
@@ -22,8 +22,8 @@
 #define GDX_CPP_ASSETS_ASSETMANAGER_HPP_
 
 #include "gdx-cpp/utils/Disposable.hpp"
-#include "gdx-cpp/utils/Synchronized.hpp"
-#include "gdx-cpp/implementation/MutexFactory.hpp"
+#include "gdx-cpp/utils/LockGuard.hpp"
+#include "gdx-cpp/utils/Mutex.hpp"
 #include "gdx-cpp/implementation/Thread.hpp"
 #include "gdx-cpp/Application.hpp"
 #include "gdx-cpp/Gdx.hpp"
@@ -32,9 +32,13 @@
 #include "loaders/AssetLoader.hpp"
 #include "AssetDescriptor.hpp"
 
-#include <tr1/unordered_map>
+#include "gdx-cpp/utils/IdentityMap.hpp"
+#include "gdx-cpp/utils/IntMap.hpp"
+#include "gdx-cpp/utils/ObjectMap.hpp"
+
 #include <string>
 #include <list>
+#include <vector>
 #include <cassert>
 
 namespace gdx_cpp {
@@ -52,12 +56,11 @@ class AssetErrorListener;
 class AssetDescriptor;
 
 class AssetManager: public gdx_cpp::utils::Disposable
-            , public Synchronizable
 {
     typedef ref_ptr_maker<AssetDescriptor>::type AssetDescriptorPtr;
-    typedef std::tr1::unordered_map<std::string, Asset::ptr> AssetMap;
+    typedef gdx_cpp::utils::ObjectMap<std::string, Asset::ptr> AssetMap;
     typedef std::list< AssetDescriptorPtr > PreloadQueueType;
-    typedef std::tr1::unordered_map<std::string, int> AssetTypeMap;
+    typedef gdx_cpp::utils::ObjectMap<std::string, int> AssetTypeMap;
 
 public:
     AssetManager();
@@ -77,17 +80,19 @@ public:
 
     template <typename T>
     T& get (const std::string& filename, int type) {
-        Synchronizable::lock_holder hnd(synchronize());
+        // lookups only read, so they can run in parallel; preloading, publishing loaded assets, removing and clearing
+        // take the lock exclusively
+        GDX_CPP_SCOPED_SHARED_LOCK(assetsLock, "AssetManager::get");
 
-        if (assets.count(type) == 0) {
+        const AssetMap* assetsByType = assets.get(type);
+        if (assetsByType == NULL) {
             gdx_cpp::Gdx::app->error("AssetManager.hpp", "Asset '%s' not loaded", filename.c_str());
         }
+        assert(assetsByType != NULL);
 
-        const AssetMap& assetsByType = assets[type];
-        assert(assetsByType.count(filename));
-
-        T& asset = (T&) *assetsByType[filename];
-        return asset;
+        const Asset::ptr* asset = assetsByType->get(filename);
+        assert(asset != NULL);
+        return (T&) **asset;
     }
 
     bool getAssetFileName (const Asset& asset, std::string& result) ;
@@ -97,21 +102,24 @@ public:
 
 protected:
 
-    std::tr1::unordered_map<AssetType, loaders::AssetLoader* > loaders;
-    std::tr1::unordered_map<int, AssetMap > assets;
+    gdx_cpp::utils::IdentityMap<const AssetType, loaders::AssetLoader* > loaders;
+    gdx_cpp::utils::IntMap<AssetMap > assets;
 
     AssetTypeMap assetTypes;
-    std::tr1::unordered_map<std::string, std::vector<std::string> > assetDependencies;
+    gdx_cpp::utils::ObjectMap<std::string, std::vector<std::string> > assetDependencies;
     PreloadQueueType preloadQueue;
     std::list<AssetLoadingTask*> tasks;
 
     AssetErrorListener* errorListener;
+    utils::RWLock assetsLock;
 
     int toLoad;
     int loaded;
 
     void injectDependency (const std::string& parentAssetFilename, AssetDescriptorPtr dependendAssetDesc);
 private:
+    /** remove() without taking the lock, for the recursion into dependencies and for clear() */
+    void removeAsset (const std::string& fileName);
     void nextTask ();
     void addTask (const AssetDescriptor& assetDesc);
     bool updateTask ();
@@ -84,6 +84,8 @@ protected:
     FileHandle (const gdx_cpp::files::File &file, gdx_cpp::Files::FileType type);
 
 private:
+    friend class MappedFile;
+
     gdx_cpp::files::File getFile();
     static bool deleteDirectory (File &file);
 };
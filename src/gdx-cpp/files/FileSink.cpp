@@ -1,4 +1,3 @@
-
 /*
     Copyright 2011 Aevum Software aevum @ aevumlab.com
 
@@ -13,17 +12,27 @@
     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
     See the License for the specific language governing permissions and
     limitations under the License.
-
-    @author Victor Vicente de Carvalho victor.carvalho@aevumlab.com
-    @author Ozires Bortolon de Faria ozires@aevumlab.com
 */
 
-#include "Sort.hpp"
+#include "FileSink.hpp"
+
+#include <stdexcept>
 
-using namespace gdx_cpp::utils;
+using namespace gdx_cpp::files;
 
-Sort& Sort::instance () {
-    if (instance == null) instance = new Sort();
-    return instance;
+FileSink::FileSink (FileHandle& file, bool append)
+: output(file.write(append))
+, path(file.path())
+{
+    if (!output || !output->is_open()) throw std::runtime_error("Error writing file: " + path);
 }
 
+void FileSink::write (const char* data, size_t length) {
+    output->write(data, length);
+    if (!*output) throw std::runtime_error("Error writing file: " + path);
+}
+
+void FileSink::flush () {
+    output->flush();
+    if (!*output) throw std::runtime_error("Error writing file: " + path);
+}
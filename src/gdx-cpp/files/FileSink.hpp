@@ -0,0 +1,42 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef GDX_CPP_FILES_FILESINK_HPP_
+#define GDX_CPP_FILES_FILESINK_HPP_
+
+#include "FileHandle.hpp"
+#include "gdx-cpp/utils/WriteBuffer.hpp"
+
+namespace gdx_cpp {
+namespace files {
+
+/** Streams a WriteBuffer into a file. The file is opened on construction and closed with the sink. */
+class FileSink : public utils::OutputSink {
+public:
+    explicit FileSink (FileHandle& file, bool append = false);
+
+    void write (const char* data, size_t length);
+    void flush ();
+
+private:
+    FileHandle::ofstream_ptr output;
+    std::string path;
+};
+
+} // namespace gdx_cpp
+} // namespace files
+
+#endif // GDX_CPP_FILES_FILESINK_HPP_
@@ -0,0 +1,122 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "MappedFile.hpp"
+#include "FileHandle.hpp"
+
+#include <fstream>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define GDX_CPP_HAS_MMAP
+#endif
+
+using namespace gdx_cpp::files;
+
+MappedFile::MappedFile ()
+: data(NULL)
+, size(0)
+{
+}
+
+MappedFile::MappedFile (const std::string& path)
+: data(NULL)
+, size(0)
+{
+    open(path);
+}
+
+MappedFile::MappedFile (FileHandle& file)
+: data(NULL)
+, size(0)
+{
+    open(file);
+}
+
+MappedFile::~MappedFile () {
+    close();
+}
+
+void MappedFile::open (FileHandle& file) {
+    open(file.getFile().getPath());
+}
+
+void MappedFile::open (const std::string& path) {
+    close();
+
+#ifdef GDX_CPP_HAS_MMAP
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor == -1) throw std::runtime_error("Couldn't open file: " + path);
+
+    struct stat status;
+    if (fstat(descriptor, &status) == -1) {
+        ::close(descriptor);
+        throw std::runtime_error("Couldn't read file size: " + path);
+    }
+
+    // mmap refuses empty files, they simply have no data
+    if (status.st_size > 0) {
+        void* memory = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (memory == MAP_FAILED) {
+            ::close(descriptor);
+            throw std::runtime_error("Couldn't map file: " + path);
+        }
+        madvise(memory, status.st_size, MADV_SEQUENTIAL);
+        data = static_cast<const char*>(memory);
+        size = status.st_size;
+    }
+    ::close(descriptor);
+#else
+    std::ifstream input(path.c_str(), std::ios::in | std::ios::binary);
+    if (!input.is_open()) throw std::runtime_error("Couldn't open file: " + path);
+
+    input.seekg(0, std::ios::end);
+    std::streamoff length = input.tellg();
+    input.seekg(0, std::ios::beg);
+    if (length > 0) {
+        char* buffer = new char[length];
+        if (!input.read(buffer, length)) {
+            delete [] buffer;
+            throw std::runtime_error("Couldn't read file: " + path);
+        }
+        data = buffer;
+        size = length;
+    }
+#endif
+}
+
+void MappedFile::close () {
+    if (data == NULL) return;
+#ifdef GDX_CPP_HAS_MMAP
+    munmap(const_cast<char*>(data), size);
+#else
+    delete [] data;
+#endif
+    data = NULL;
+    size = 0;
+}
+
+const char* MappedFile::getData () const {
+    return data;
+}
+
+size_t MappedFile::getSize () const {
+    return size;
+}
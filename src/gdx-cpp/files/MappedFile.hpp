@@ -0,0 +1,58 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef GDX_CPP_FILES_MAPPEDFILE_HPP_
+#define GDX_CPP_FILES_MAPPEDFILE_HPP_
+
+#include <cstddef>
+#include <string>
+
+namespace gdx_cpp {
+namespace files {
+
+class FileHandle;
+
+/** A file's contents mapped read only into memory, so parsers can work on it in place without copying it into a buffer
+ * first. Pages are only read in as they are touched and can be dropped again by the OS, which keeps huge files cheap
+ * to scan once. Where mapping isn't available the file is read into memory instead. */
+class MappedFile {
+public:
+    MappedFile ();
+    explicit MappedFile (const std::string& path);
+    explicit MappedFile (FileHandle& file);
+    ~MappedFile ();
+
+    /** Maps the file, unmapping the previous one. Throws std::runtime_error if it can't be opened. */
+    void open (const std::string& path);
+    void open (FileHandle& file);
+    void close ();
+
+    /** The file's bytes, not NUL terminated. NULL for an empty file. */
+    const char* getData () const;
+    size_t getSize () const;
+
+private:
+    MappedFile (const MappedFile&);
+    MappedFile& operator= (const MappedFile&);
+
+    const char* data;
+    size_t size;
+};
+
+} // namespace gdx_cpp
+} // namespace files
+
+#endif // GDX_CPP_FILES_MAPPEDFILE_HPP_
@@ -32,7 +32,9 @@
 #include "gdx-cpp/graphics/glutils/IndexBufferObject.hpp"
 #include "gdx-cpp/graphics/glutils/IndexBufferObjectSubData.hpp"
 #include "gdx-cpp/graphics/glutils/ShaderProgram.hpp"
+#include "gdx-cpp/math/Matrix4.hpp"
 #include "gdx-cpp/math/collision/BoundingBox.hpp"
+#include "gdx-cpp/utils/BufferUtils.hpp"
 
 #include <stdexcept>
 #include <iostream>
@@ -62,6 +64,24 @@ Mesh::Mesh(bool isStatic, int maxVertices, int maxIndices, const std::vector< Ve
     addManagedMesh(gdx_cpp::Gdx::app, this);
 }
 
+Mesh::Mesh(bool isStatic, float* vertices, int maxVertices, short* indices, int maxIndices,
+           const std::vector< VertexAttribute >& attributes)
+: vertices(0)
+, autoBind(true)
+, refCount(0)
+{
+    if (gdx_cpp::Gdx::gl20 != NULL || gdx_cpp::Gdx::gl11 != NULL || Mesh::forceVBO) {
+        this->vertices = new glutils::VertexBufferObject(isStatic, vertices, maxVertices, attributes);
+        isVertexArray = false;
+    } else {
+        this->vertices = new glutils::VertexArray(vertices, maxVertices, attributes);
+        isVertexArray = true;
+    }
+    this->indices = new glutils::IndexBufferObject(isStatic, indices, maxIndices);
+
+    addManagedMesh(gdx_cpp::Gdx::app, this);
+}
+
 
 void Mesh::setVertices (const std::vector<float>& vertices) {
     this->vertices->setVertices(&vertices[0], 0, vertices.size());
@@ -321,39 +341,14 @@ std::string Mesh::getManagedStatus () {
 void Mesh::scale (float scaleX,float scaleY,float scaleZ) {
     VertexAttribute& posAttr = getVertexAttribute(VertexAttributes::Usage::Position);
     int offset = posAttr.offset / 4;
-    int numComponents = posAttr.numComponents;
-    int numVertices = getNumVertices();
     int vertexSize = getVertexSize() / 4;
 
-    std::vector<float> vertices(numVertices * vertexSize);
-    getVertices(vertices);
-
-    int idx = offset;
-    switch (numComponents) {
-    case 1:
-        for (int i = 0; i < numVertices; i++) {
-            vertices[idx] *= scaleX;
-            idx += vertexSize;
-        }
-        break;
-    case 2:
-        for (int i = 0; i < numVertices; i++) {
-            vertices[idx] *= scaleX;
-            vertices[idx + 1] *= scaleY;
-            idx += vertexSize;
-        }
-        break;
-    case 3:
-        for (int i = 0; i < numVertices; i++) {
-            vertices[idx] *= scaleX;
-            vertices[idx + 1] *= scaleY;
-            vertices[idx + 2] *= scaleZ;
-            idx += vertexSize;
-        }
-        break;
-    }
+    math::Matrix4 scaling;
+    scaling.setToScaling(scaleX, scaleY, scaleZ);
 
-    setVertices(vertices);
+    // getVerticesBuffer() marks the vertex data dirty, so the scaled positions are uploaded on the next bind
+    utils::BufferUtils::transform(getVerticesBuffer().pointer() + offset, posAttr.numComponents, vertexSize,
+                                  getNumVertices(), scaling);
 }
 Mesh::Mesh(int type, bool isStatic, int maxVertices, int maxIndices, const std::vector< VertexAttribute >& attributes)
 : vertices(0)
@@ -60,6 +60,11 @@ public:
 
     Mesh (int type, bool isStatic, int maxVertices, int maxIndices, const std::vector< gdx_cpp::graphics::VertexAttribute >& attributes) ;
     Mesh (bool isStatic, int maxVertices, int maxIndices, const std::vector<VertexAttribute>& attributes);
+    /** Renders straight from caller owned vertices and indices instead of copying them into buffers of its own. The
+     * memory has to outlive the mesh; writes to it are picked up after getVerticesBuffer() or getIndicesBuffer() mark
+     * the mesh dirty. */
+    Mesh (bool isStatic, float* vertices, int maxVertices, short* indices, int maxIndices,
+          const std::vector<VertexAttribute>& attributes);
 
 
     
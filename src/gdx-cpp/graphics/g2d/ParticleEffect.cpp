@@ -96,6 +96,26 @@ void ParticleEffect::setFlip (bool flipX,bool flipY) {
         emitters[i]->setFlip(flipX, flipY);
 }
 
+void ParticleEffect::setEmissionScale (float scale) {
+    for (unsigned int i = 0, n = emitters.size(); i < n; i++)
+        emitters[i]->setEmissionScale(scale);
+}
+
+int ParticleEffect::getActiveCount () {
+    int count = 0;
+    for (unsigned int i = 0, n = emitters.size(); i < n; i++)
+        count += emitters[i]->getActiveCount();
+    return count;
+}
+
+/** Returns the union of the emitters' bounding boxes. Recomputed on every call. */
+gdx_cpp::math::collision::BoundingBox& ParticleEffect::getBoundingBox () {
+    bounds.inf();
+    for (unsigned int i = 0, n = emitters.size(); i < n; i++)
+        bounds.ext(emitters[i]->getBoundingBox());
+    return bounds;
+}
+
 std::vector< ParticleEmitter * >& ParticleEffect::getEmitters () {
     return emitters;
 }
@@ -21,6 +21,7 @@
 #ifndef GDX_CPP_GRAPHICS_G2D_PARTICLEEFFECT_HPP_
 #define GDX_CPP_GRAPHICS_G2D_PARTICLEEFFECT_HPP_
 #include "gdx-cpp/utils/Disposable.hpp"
+#include "gdx-cpp/math/collision/BoundingBox.hpp"
 #include <vector>
 #include <string>
 #include <gdx-cpp/utils/Aliases.hpp>
@@ -43,7 +44,7 @@ public:
 
     ParticleEffect ();
     ParticleEffect (ParticleEffect& effect);
-    ~ParticleEffect();
+    virtual ~ParticleEffect();
     void start ();
     void update (float delta);
     void draw (SpriteBatch& spriteBatch);
@@ -53,6 +54,9 @@ public:
     void setDuration (int duration);
     void setPosition (float x,float y);
     void setFlip (bool flipX,bool flipY);
+    void setEmissionScale (float scale);
+    int getActiveCount ();
+    gdx_cpp::math::collision::BoundingBox& getBoundingBox ();
     std::vector< ParticleEmitter* >& getEmitters ();
     ParticleEmitter* findEmitter (const std::string& name);
     void save (const File& file);
@@ -71,6 +75,7 @@ protected:
 
 private:
     std::vector<ParticleEmitter *> emitters;
+    gdx_cpp::math::collision::BoundingBox bounds;
 };
 
 } // namespace gdx_cpp
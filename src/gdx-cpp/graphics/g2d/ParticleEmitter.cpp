@@ -32,33 +32,33 @@
 using namespace gdx_cpp::graphics::g2d;
 
 
-ParticleEmitter::ParticleEmitter(): accumulator(0), minParticleCount(0), maxParticleCount(4), x(0),y(0),
+ParticleEmitter::ParticleEmitter(): accumulator(0), emissionScale(1), minParticleCount(0), maxParticleCount(4), x(0),y(0),
         activeCount(0), firstUpdate(false), flipX(false), flipY(false), updateFlags(0),
         allowCompletionVar(false), emission(0), emissionDiff(0), emissionDelta(0), lifeOffset(0),
         lifeOffsetDiff(0), life(0), lifeDiff(0), spawnWidth(0), spawnWidthDiff(0), spawnHeight(0),
         spawnHeightDiff(0), delay(0), delayTimer(0), attached(false), continuous(false), aligned(false),
-        behind(false), additive(true), duration(1), durationTimer(0)
+        behind(false), additive(true), duration(1), durationTimer(0), particlePool(this)
 {
     initialize();
 }
 
-ParticleEmitter::ParticleEmitter(std::istream& reader): accumulator(0), minParticleCount(0), maxParticleCount(4), x(0),y(0),
+ParticleEmitter::ParticleEmitter(std::istream& reader): accumulator(0), emissionScale(1), minParticleCount(0), maxParticleCount(4), x(0),y(0),
         activeCount(0), firstUpdate(false), flipX(false), flipY(false), updateFlags(0),
         allowCompletionVar(false), emission(0), emissionDiff(0), emissionDelta(0), lifeOffset(0),
         lifeOffsetDiff(0), life(0), lifeDiff(0), spawnWidth(0), spawnWidthDiff(0), spawnHeight(0),
         spawnHeightDiff(0), delay(0), delayTimer(0), attached(false), continuous(false), aligned(false),
-        behind(false), additive(true), duration(1), durationTimer(0)
+        behind(false), additive(true), duration(1), durationTimer(0), particlePool(this)
 {
     initialize();
     load(reader);
 }
 
-ParticleEmitter::ParticleEmitter(ParticleEmitter& emitter): accumulator(0), minParticleCount(0), maxParticleCount(4), x(0),y(0),
+ParticleEmitter::ParticleEmitter(ParticleEmitter& emitter): accumulator(0), emissionScale(1), minParticleCount(0), maxParticleCount(4), x(0),y(0),
         activeCount(0), firstUpdate(false), flipX(false), flipY(false), updateFlags(0),
         allowCompletionVar(false), emission(0), emissionDiff(0), emissionDelta(0), lifeOffset(0),
         lifeOffsetDiff(0), life(0), lifeDiff(0), spawnWidth(0), spawnWidthDiff(0), spawnHeight(0),
         spawnHeightDiff(0), delay(0), delayTimer(0), attached(false), continuous(false), aligned(false),
-        behind(false), additive(true), duration(1), durationTimer(0)
+        behind(false), additive(true), duration(1), durationTimer(0), particlePool(this)
 {
     sprite = emitter.sprite;
     name = emitter.name;
@@ -93,13 +93,6 @@ ParticleEmitter::ParticleEmitter(ParticleEmitter& emitter): accumulator(0), minP
 
 ParticleEmitter::~ParticleEmitter()
 {
-    for (unsigned int i = 0; i < particles.size(); i ++)
-    {
-        if (particles[i] != NULL)
-        {
-          delete particles[i];
-        }
-    }
 }
 
 void ParticleEmitter::initialize () {
@@ -122,7 +115,7 @@ void ParticleEmitter::setMaxParticleCount (int maxParticleCount) {
     {
         if (particles[i] != NULL)
         {
-            delete particles[i];
+            particlePool.free(particles[i]);
         }
     }
     particles.clear();
@@ -197,7 +190,7 @@ void ParticleEmitter::update (float delta) {
     }
 
     emissionDelta += deltaMillis;
-    float emissionTime = emission + emissionDiff * emissionValue.getScale(durationTimer / (float)duration);
+    float emissionTime = (emission + emissionDiff * emissionValue.getScale(durationTimer / (float)duration)) * emissionScale;
     if (emissionTime > 0) {
         emissionTime = 1000 / emissionTime;
         if (emissionDelta >= emissionTime) {
@@ -270,7 +263,7 @@ void ParticleEmitter::draw (SpriteBatch& spriteBatch,float delta) {
     }
 
     emissionDelta += deltaMillis;
-    float emissionTime = emission + emissionDiff * emissionValue.getScale(durationTimer / (float)duration);
+    float emissionTime = (emission + emissionDiff * emissionValue.getScale(durationTimer / (float)duration)) * emissionScale;
     if (emissionTime > 0) {
         emissionTime = 1000 / emissionTime;
         if (emissionDelta >= emissionTime) {
@@ -336,8 +329,7 @@ void ParticleEmitter::restart () {
 void ParticleEmitter::activateParticle (int index) {
     Particle * particle = particles[index];
     if (particle == NULL) {
-        particles[index] = particle = new Particle(sprite);
-        particle->flip(flipX, flipY);
+        particles[index] = particle = &particlePool.obtain();
     }
 
     float percent = durationTimer / (float)duration;
@@ -545,6 +537,8 @@ void ParticleEmitter::setPosition (float x,float y) {
 
 void ParticleEmitter::setSprite (gdx_cpp::graphics::g2d::Sprite::ptr sprite) {
     this->sprite = sprite;
+    // pooled particles still carry the old texture
+    particlePool.clear();
     if (sprite == NULL) return;
     float originX = sprite->getOriginX();
     float originY = sprite->getOriginY();
@@ -743,6 +737,7 @@ void ParticleEmitter::setImagePath (const std::string& imagePath) {
 void ParticleEmitter::setFlip (bool flipX,bool flipY) {
     this->flipX = flipX;
     this->flipY = flipY;
+    particlePool.clear();
     if (particles.size() == 0) return;
     for (unsigned int i = 0, n = particles.size(); i < n; i++) {
         Particle * particle = particles[i];
@@ -750,6 +745,31 @@ void ParticleEmitter::setFlip (bool flipX,bool flipY) {
     }
 }
 
+/** Scales the emission rate without touching the loaded emission values, so an external budget can throttle the
+ * emitter. 1 emits at the full rate and 0 stops emitting new particles (the min particle count is still honored). */
+void ParticleEmitter::setEmissionScale (float scale) {
+    emissionScale = scale < 0 ? 0 : (scale > 1 ? 1 : scale);
+}
+
+float ParticleEmitter::getEmissionScale () {
+    return emissionScale;
+}
+
+/** Returns the bounding box of the active particles, including the emitter position. The box lies on the z = 0
+ * plane and is recomputed on every call. */
+gdx_cpp::math::collision::BoundingBox& ParticleEmitter::getBoundingBox () {
+    bounds.inf();
+    bounds.ext(x, y, 0);
+    for (unsigned int index = 0; index < active.size(); index++) {
+        if (active[index]) {
+            const gdx_cpp::math::Rectangle& r = particles[index]->getBoundingRectangle();
+            bounds.ext(r.x, r.y, 0);
+            bounds.ext(r.x + r.width, r.y + r.height, 0);
+        }
+    }
+    return bounds;
+}
+
 // trim from start
 inline std::string& ltrim(std::string &s) {
     s.erase(s.begin(), std::find_if(s.begin(), s.end(), std::not1(std::ptr_fun<int, int>(std::isspace))));
@@ -906,6 +926,17 @@ ParticleEmitter::Particle::Particle(Sprite::ptr s) : Sprite(s), life(0), current
         transparency(0), transparencyDiff(0),wind(0), windDiff(0),gravity(0), gravityDiff(0)
 {
 
+}
+//------------------------ParticlePool------------------------------------
+ParticleEmitter::ParticlePool::ParticlePool(ParticleEmitter* emitter) : emitter(emitter)
+{
+}
+
+ParticleEmitter::Particle* ParticleEmitter::ParticlePool::construct(void* memory)
+{
+    Particle* particle = new (memory) Particle(emitter->sprite);
+    particle->flip(emitter->flipX, emitter->flipY);
+    return particle;
 }
 //------------------------ParticleValue-----------------------------------
 ParticleEmitter::ParticleValue::ParticleValue():active(false), alwaysActive(false)
@@ -22,6 +22,8 @@
 #define GDX_CPP_GRAPHICS_G2D_PARTICLEEMITTER_HPP_
 #include <vector>
 #include "Sprite.hpp"
+#include "gdx-cpp/math/collision/BoundingBox.hpp"
+#include "gdx-cpp/utils/Pool.hpp"
 #include <string>
 
 namespace gdx_cpp {
@@ -55,6 +57,18 @@ public:
 
     };
 
+    /** Carves the emitter's particles out of contiguous slabs, built from the emitter's current sprite */
+    class ParticlePool : public gdx_cpp::utils::Pool<Particle> {
+    public:
+        ParticlePool (ParticleEmitter* emitter);
+
+    protected:
+        Particle* construct (void* memory);
+
+    private:
+        ParticleEmitter* emitter;
+    };
+
     class ParticleValue {
     public:
         ParticleValue();
@@ -226,6 +240,9 @@ public:
     std::string getImagePath ();
     void setImagePath (const std::string& imagePath);
     void setFlip (bool flipX,bool flipY);
+    void setEmissionScale (float scale);
+    float getEmissionScale ();
+    gdx_cpp::math::collision::BoundingBox& getBoundingBox ();
     void save (std::ostream& output);
     void load (std::istream& reader);
 
@@ -271,7 +288,10 @@ private:
     SpawnShapeValue spawnShapeValue;
 
     float accumulator;
+    float emissionScale;
+    gdx_cpp::math::collision::BoundingBox bounds;
     Sprite::ptr sprite;
+    ParticlePool particlePool;
     std::vector<Particle *> particles;
     int minParticleCount, maxParticleCount;
     float x, y;
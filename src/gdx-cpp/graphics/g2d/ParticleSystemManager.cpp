@@ -0,0 +1,185 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "ParticleSystemManager.hpp"
+#include "ParticleEffect.hpp"
+#include "gdx-cpp/graphics/Camera.hpp"
+#include "gdx-cpp/math/collision/BoundingBox.hpp"
+
+using namespace gdx_cpp::graphics::g2d;
+
+const float ParticleSystemManager::SOFT_LIMIT = 0.75f;
+
+ParticleSystemManager::ParticleSystemManager (int particleBudget) : camera(NULL), particleBudget(particleBudget),
+        activeCount(0), visibleCount(0), emissionScale(1), lodDistance(0), lodUpdateInterval(4), culledUpdateInterval(30)
+{
+}
+
+ParticleSystemManager::~ParticleSystemManager () {
+    clear();
+}
+
+/** Adds an effect, the manager takes ownership of it */
+void ParticleSystemManager::add (ParticleEffect* effect) {
+    ManagedEffect managed;
+    managed.effect = effect;
+    managed.pendingDelta = 0;
+    managed.skippedFrames = 0;
+    managed.visible = true;
+    managed.occluded = false;
+    effect->setEmissionScale(emissionScale);
+    effects.push_back(managed);
+}
+
+/** Copies the prototype, positions and starts the copy and adds it to the manager */
+ParticleEffect* ParticleSystemManager::spawn (ParticleEffect& prototype, float x, float y) {
+    ParticleEffect* effect = new ParticleEffect(prototype);
+    effect->setPosition(x, y);
+    effect->start();
+    add(effect);
+    return effect;
+}
+
+/** Removes and deletes the effect */
+void ParticleSystemManager::remove (ParticleEffect* effect) {
+    int index = indexOf(effect);
+    if (index == -1) return;
+    delete effects[index].effect;
+    effects.erase(effects.begin() + index);
+}
+
+void ParticleSystemManager::clear () {
+    for (unsigned int i = 0, n = effects.size(); i < n; i++)
+        delete effects[i].effect;
+    effects.clear();
+    activeCount = 0;
+    visibleCount = 0;
+}
+
+void ParticleSystemManager::update (float delta) {
+    updateEmissionScale();
+
+    int activeCount = 0;
+    int visibleCount = 0;
+    for (unsigned int i = 0; i < effects.size();) {
+        ManagedEffect& managed = effects[i];
+        ParticleEffect* effect = managed.effect;
+
+        gdx_cpp::math::collision::BoundingBox& bounds = effect->getBoundingBox();
+        managed.visible = camera == NULL || camera->frustum.boundsInFrustum(bounds);
+
+        // an interval of 0 freezes the effect, so time spent frozen must not be replayed once it thaws
+        int interval = updateInterval(managed, bounds);
+        if (interval > 0) managed.pendingDelta += delta;
+        if (interval > 0 && ++managed.skippedFrames >= interval) {
+            effect->setEmissionScale(emissionScale);
+            effect->update(managed.pendingDelta);
+            managed.pendingDelta = 0;
+            managed.skippedFrames = 0;
+
+            if (effect->isComplete()) {
+                delete effect;
+                effects.erase(effects.begin() + i);
+                continue;
+            }
+        }
+
+        activeCount += effect->getActiveCount();
+        if (managed.visible) visibleCount++;
+        i++;
+    }
+    this->activeCount = activeCount;
+    this->visibleCount = visibleCount;
+}
+
+void ParticleSystemManager::draw (SpriteBatch& spriteBatch) {
+    for (unsigned int i = 0, n = effects.size(); i < n; i++) {
+        if (effects[i].visible) effects[i].effect->draw(spriteBatch);
+    }
+}
+
+/** Sets the camera used for culling and level of detail, NULL disables both */
+void ParticleSystemManager::setCamera (gdx_cpp::graphics::Camera* camera) {
+    this->camera = camera;
+}
+
+void ParticleSystemManager::setParticleBudget (int particleBudget) {
+    this->particleBudget = particleBudget;
+}
+
+int ParticleSystemManager::getParticleBudget () {
+    return particleBudget;
+}
+
+/** Effects whose center is farther than this from the camera are updated at the LOD rate, 0 disables it */
+void ParticleSystemManager::setLodDistance (float distance) {
+    lodDistance = distance;
+}
+
+void ParticleSystemManager::setLodUpdateInterval (int frames) {
+    lodUpdateInterval = frames < 1 ? 1 : frames;
+}
+
+/** Number of frames between updates of effects outside the camera, 0 freezes them until they are visible again */
+void ParticleSystemManager::setCulledUpdateInterval (int frames) {
+    culledUpdateInterval = frames < 0 ? 0 : frames;
+}
+
+void ParticleSystemManager::setOccluded (ParticleEffect* effect, bool occluded) {
+    int index = indexOf(effect);
+    if (index != -1) effects[index].occluded = occluded;
+}
+
+int ParticleSystemManager::getActiveCount () {
+    return activeCount;
+}
+
+int ParticleSystemManager::getEffectCount () {
+    return effects.size();
+}
+
+int ParticleSystemManager::getVisibleCount () {
+    return visibleCount;
+}
+
+float ParticleSystemManager::getEmissionScale () {
+    return emissionScale;
+}
+
+int ParticleSystemManager::indexOf (ParticleEffect* effect) {
+    for (unsigned int i = 0, n = effects.size(); i < n; i++) {
+        if (effects[i].effect == effect) return i;
+    }
+    return -1;
+}
+
+int ParticleSystemManager::updateInterval (ManagedEffect& managed, gdx_cpp::math::collision::BoundingBox& bounds) {
+    if (!managed.visible) return culledUpdateInterval;
+    if (managed.occluded) return lodUpdateInterval;
+    if (camera != NULL && lodDistance > 0 && camera->position.dst(bounds.getCenter()) > lodDistance)
+        return lodUpdateInterval;
+    return 1;
+}
+
+void ParticleSystemManager::updateEmissionScale () {
+    float softLimit = particleBudget * SOFT_LIMIT;
+    if (activeCount <= softLimit)
+        emissionScale = 1;
+    else if (activeCount >= particleBudget)
+        emissionScale = 0;
+    else
+        emissionScale = (particleBudget - activeCount) / (particleBudget - softLimit);
+}
@@ -0,0 +1,100 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef GDX_CPP_GRAPHICS_G2D_PARTICLESYSTEMMANAGER_HPP_
+#define GDX_CPP_GRAPHICS_G2D_PARTICLESYSTEMMANAGER_HPP_
+
+#include <vector>
+
+namespace gdx_cpp {
+namespace math {
+namespace collision {
+class BoundingBox;
+}
+}
+namespace graphics {
+class Camera;
+namespace g2d {
+
+class SpriteBatch;
+class ParticleEffect;
+
+/** Owns a set of {@link ParticleEffect}s and keeps their total live particle count under a global budget.
+ *
+ * When the live count approaches the budget every effect's emission rate is scaled down, reaching zero at the budget.
+ * If a camera is set, effects whose bounds are outside its frustum are neither drawn nor updated every frame; they are
+ * ticked every {@link #setCulledUpdateInterval(int)} frames with the accumulated time so one shot effects still
+ * finish; an interval of 0 freezes them until they are visible again. Effects farther than the LOD distance from the
+ * camera, or flagged as occluded, are updated every {@link #setLodUpdateInterval(int)} frames. Completed effects are
+ * deleted. */
+class ParticleSystemManager {
+public:
+    ParticleSystemManager (int particleBudget);
+    ~ParticleSystemManager ();
+
+    void add (ParticleEffect* effect);
+    ParticleEffect* spawn (ParticleEffect& prototype, float x, float y);
+    void remove (ParticleEffect* effect);
+    void clear ();
+
+    void update (float delta);
+    void draw (SpriteBatch& spriteBatch);
+
+    void setCamera (gdx_cpp::graphics::Camera* camera);
+    void setParticleBudget (int particleBudget);
+    int getParticleBudget ();
+    void setLodDistance (float distance);
+    void setLodUpdateInterval (int frames);
+    void setCulledUpdateInterval (int frames);
+    void setOccluded (ParticleEffect* effect, bool occluded);
+
+    int getActiveCount ();
+    int getEffectCount ();
+    int getVisibleCount ();
+    float getEmissionScale ();
+
+    /** Fraction of the budget below which effects emit at their full rate */
+    static const float SOFT_LIMIT;
+
+private:
+    struct ManagedEffect {
+        ParticleEffect* effect;
+        float pendingDelta;
+        int skippedFrames;
+        bool visible;
+        bool occluded;
+    };
+
+    int indexOf (ParticleEffect* effect);
+    int updateInterval (ManagedEffect& managed, gdx_cpp::math::collision::BoundingBox& bounds);
+    void updateEmissionScale ();
+
+    std::vector<ManagedEffect> effects;
+    gdx_cpp::graphics::Camera* camera;
+    int particleBudget;
+    int activeCount;
+    int visibleCount;
+    float emissionScale;
+    float lodDistance;
+    int lodUpdateInterval;
+    int culledUpdateInterval;
+};
+
+} // namespace gdx_cpp
+} // namespace graphics
+} // namespace g2d
+
+#endif // GDX_CPP_GRAPHICS_G2D_PARTICLESYSTEMMANAGER_HPP_
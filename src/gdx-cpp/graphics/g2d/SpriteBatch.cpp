@@ -1031,10 +1031,7 @@ color(Color::WHITE.toFloatBits())
 
 SpriteBatch::~SpriteBatch()
 {
-    if (mesh) {
-        delete mesh;
-    }
-
+    // mesh is one of the buffers
     if (shader) {
         delete shader;
     }
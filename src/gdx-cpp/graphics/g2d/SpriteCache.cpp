@@ -27,6 +27,8 @@
 #include "gdx-cpp/utils/NumberUtils.hpp"
 #include "gdx-cpp/graphics/glutils/ShaderProgram.hpp"
 #include "gdx-cpp/math/MathUtils.hpp"
+#include "gdx-cpp/math/Matrix3.hpp"
+#include "gdx-cpp/utils/BufferUtils.hpp"
 #include <string.h>
 #include <stdexcept>
 
@@ -433,81 +435,6 @@ void SpriteCache::add (gdx_cpp::graphics::Texture::ptr texture,float x,float y,f
 }
 
 void SpriteCache::add (gdx_cpp::graphics::Texture::ptr texture,float x,float y,float originX,float originY,float width,float height,float scaleX,float scaleY,float rotation,int srcX,int srcY,int srcWidth,int srcHeight,bool flipX,bool flipY) {
-
-    // bottom left and top right corner points relative to origin
-    float worldOriginX = x + originX;
-    float worldOriginY = y + originY;
-    float fx = -originX;
-    float fy = -originY;
-    float fx2 = width - originX;
-    float fy2 = height - originY;
-
-    // scale
-    if (scaleX != 1 || scaleY != 1) {
-        fx *= scaleX;
-        fy *= scaleY;
-        fx2 *= scaleX;
-        fy2 *= scaleY;
-    }
-
-    // construct corner points, start from top left and go counter clockwise
-    float p1x = fx;
-    float p1y = fy;
-    float p2x = fx;
-    float p2y = fy2;
-    float p3x = fx2;
-    float p3y = fy2;
-    float p4x = fx2;
-    float p4y = fy;
-
-    float x1;
-    float y1;
-    float x2;
-    float y2;
-    float x3;
-    float y3;
-    float x4;
-    float y4;
-
-    // rotate
-    if (rotation != 0) {
-        float cos = math::utils::cosDeg(rotation);
-        float sin = math::utils::sinDeg(rotation);
-
-        x1 = cos * p1x - sin * p1y;
-        y1 = sin * p1x + cos * p1y;
-
-        x2 = cos * p2x - sin * p2y;
-        y2 = sin * p2x + cos * p2y;
-
-        x3 = cos * p3x - sin * p3y;
-        y3 = sin * p3x + cos * p3y;
-
-        x4 = x1 + (x3 - x2);
-        y4 = y3 - (y2 - y1);
-    } else {
-        x1 = p1x;
-        y1 = p1y;
-
-        x2 = p2x;
-        y2 = p2y;
-
-        x3 = p3x;
-        y3 = p3y;
-
-        x4 = p4x;
-        y4 = p4y;
-    }
-
-    x1 += worldOriginX;
-    y1 += worldOriginY;
-    x2 += worldOriginX;
-    y2 += worldOriginY;
-    x3 += worldOriginX;
-    y3 += worldOriginY;
-    x4 += worldOriginX;
-    y4 += worldOriginY;
-
     float invTexWidth = 1.0f / texture->getWidth();
     float invTexHeight = 1.0f / texture->getHeight();
     float u = srcX * invTexWidth;
@@ -527,51 +454,7 @@ void SpriteCache::add (gdx_cpp::graphics::Texture::ptr texture,float x,float y,f
         v2 = tmp;
     }
 
-    tempVertices[0] = x1;
-    tempVertices[1] = y1;
-    tempVertices[2] = color;
-    tempVertices[3] = u;
-    tempVertices[4] = v;
-
-    tempVertices[5] = x2;
-    tempVertices[6] = y2;
-    tempVertices[7] = color;
-    tempVertices[8] = u;
-    tempVertices[9] = v2;
-
-    tempVertices[10] = x3;
-    tempVertices[11] = y3;
-    tempVertices[12] = color;
-    tempVertices[13] = u2;
-    tempVertices[14] = v2;
-
-    if (mesh->getNumIndices() > 0) {
-        tempVertices[15] = x4;
-        tempVertices[16] = y4;
-        tempVertices[17] = color;
-        tempVertices[18] = u2;
-        tempVertices[19] = v;
-        add(texture, tempVertices, 30, 0, 20);
-    } else {
-        tempVertices[15] = x3;
-        tempVertices[16] = y3;
-        tempVertices[17] = color;
-        tempVertices[18] = u2;
-        tempVertices[19] = v2;
-
-        tempVertices[20] = x4;
-        tempVertices[21] = y4;
-        tempVertices[22] = color;
-        tempVertices[23] = u2;
-        tempVertices[24] = v;
-
-        tempVertices[25] = x1;
-        tempVertices[26] = y1;
-        tempVertices[27] = color;
-        tempVertices[28] = u;
-        tempVertices[29] = v;
-        add(texture, tempVertices, 30, 0, 30);
-    }
+    addTransformed(texture, x, y, originX, originY, width, height, scaleX, scaleY, rotation, u, v, u2, v2);
 }
 
 void SpriteCache::add (TextureRegion::ptr region,float x,float y) {
@@ -634,131 +517,55 @@ void SpriteCache::add (TextureRegion::ptr region,float x,float y,float width,flo
 }
 
 void SpriteCache::add (TextureRegion::ptr region, float x, float y, float originX, float originY, float width, float height, float scaleX, float scaleY, float rotation) {
+    addTransformed(region->getTexture(), x, y, originX, originY, width, height, scaleX, scaleY, rotation, region->u,
+                   region->v2, region->u2, region->v);
+}
 
-    // bottom left and top right corner points relative to origin
-    float worldOriginX = x + originX;
-    float worldOriginY = y + originY;
+void SpriteCache::addTransformed (Texture::ptr texture, float x, float y, float originX, float originY, float width,
+                                  float height, float scaleX, float scaleY, float rotation, float u, float v, float u2,
+                                  float v2) {
+    // corner points relative to origin, start from bottom left and go clockwise
     float fx = -originX;
     float fy = -originY;
     float fx2 = width - originX;
     float fy2 = height - originY;
 
-    // scale
-    if (scaleX != 1 || scaleY != 1) {
-        fx *= scaleX;
-        fy *= scaleY;
-        fx2 *= scaleX;
-        fy2 *= scaleY;
+    float corners[4][4] = {
+        { fx, fy, u, v },
+        { fx, fy2, u, v2 },
+        { fx2, fy2, u2, v2 },
+        { fx2, fy, u2, v }
+    };
+
+    // with indices the quad is 4 vertices, otherwise two triangles sharing the 1st and 3rd corner
+    int numVertices = mesh->getNumIndices() > 0 ? 4 : 6;
+    static const int triangles[6] = { 0, 1, 2, 2, 3, 0 };
+    for (int i = 0; i < numVertices; i++) {
+        const float* corner = corners[numVertices == 4 ? i : triangles[i]];
+        float* vertex = tempVertices + i * Sprite::VERTEX_SIZE;
+        vertex[0] = corner[0];
+        vertex[1] = corner[1];
+        vertex[2] = color;
+        vertex[3] = corner[2];
+        vertex[4] = corner[3];
     }
 
-    // construct corner points, start from top left and go counter clockwise
-    float p1x = fx;
-    float p1y = fy;
-    float p2x = fx;
-    float p2y = fy2;
-    float p3x = fx2;
-    float p3y = fy2;
-    float p4x = fx2;
-    float p4y = fy;
-
-    float x1;
-    float y1;
-    float x2;
-    float y2;
-    float x3;
-    float y3;
-    float x4;
-    float y4;
-
-    // rotate
-    if (rotation != 0) {
-        float cos = math::utils::cosDeg(rotation);
-        float sin = math::utils::sinDeg(rotation);
-
-        x1 = cos * p1x - sin * p1y;
-        y1 = sin * p1x + cos * p1y;
-
-        x2 = cos * p2x - sin * p2y;
-        y2 = sin * p2x + cos * p2y;
-
-        x3 = cos * p3x - sin * p3y;
-        y3 = sin * p3x + cos * p3y;
-
-        x4 = x1 + (x3 - x2);
-        y4 = y3 - (y2 - y1);
-    } else {
-        x1 = p1x;
-        y1 = p1y;
-
-        x2 = p2x;
-        y2 = p2y;
-
-        x3 = p3x;
-        y3 = p3y;
-
-        x4 = p4x;
-        y4 = p4y;
-    }
-
-    x1 += worldOriginX;
-    y1 += worldOriginY;
-    x2 += worldOriginX;
-    y2 += worldOriginY;
-    x3 += worldOriginX;
-    y3 += worldOriginY;
-    x4 += worldOriginX;
-    y4 += worldOriginY;
-
-    float u = region->u;
-    float v = region->v2;
-    float u2 = region->u2;
-    float v2 = region->v;
-
-    tempVertices[0] = x1;
-    tempVertices[1] = y1;
-    tempVertices[2] = color;
-    tempVertices[3] = u;
-    tempVertices[4] = v;
-
-    tempVertices[5] = x2;
-    tempVertices[6] = y2;
-    tempVertices[7] = color;
-    tempVertices[8] = u;
-    tempVertices[9] = v2;
-
-    tempVertices[10] = x3;
-    tempVertices[11] = y3;
-    tempVertices[12] = color;
-    tempVertices[13] = u2;
-    tempVertices[14] = v2;
-
-    if (mesh->getNumIndices() > 0) {
-        tempVertices[15] = x4;
-        tempVertices[16] = y4;
-        tempVertices[17] = color;
-        tempVertices[18] = u2;
-        tempVertices[19] = v;
-        add(region->getTexture(), tempVertices, 30, 0, 20);
-    } else {
-        tempVertices[15] = x3;
-        tempVertices[16] = y3;
-        tempVertices[17] = color;
-        tempVertices[18] = u2;
-        tempVertices[19] = v2;
-
-        tempVertices[20] = x4;
-        tempVertices[21] = y4;
-        tempVertices[22] = color;
-        tempVertices[23] = u2;
-        tempVertices[24] = v;
-
-        tempVertices[25] = x1;
-        tempVertices[26] = y1;
-        tempVertices[27] = color;
-        tempVertices[28] = u;
-        tempVertices[29] = v;
-        add(region->getTexture(), tempVertices, Sprite::SPRITE_SIZE, 0, 30);
-    }
+    // scale, rotate and move to the world origin in a single affine transform
+    float cos = rotation != 0 ? math::utils::cosDeg(rotation) : 1;
+    float sin = rotation != 0 ? math::utils::sinDeg(rotation) : 0;
+    math::Matrix3 transform;
+    transform.vals[0] = cos * scaleX;
+    transform.vals[1] = sin * scaleX;
+    transform.vals[2] = 0;
+    transform.vals[3] = -sin * scaleY;
+    transform.vals[4] = cos * scaleY;
+    transform.vals[5] = 0;
+    transform.vals[6] = x + originX;
+    transform.vals[7] = y + originY;
+    transform.vals[8] = 1;
+    utils::BufferUtils::transform(tempVertices, 2, Sprite::VERTEX_SIZE, numVertices, transform);
+
+    add(texture, tempVertices, 30, 0, numVertices * Sprite::VERTEX_SIZE);
 }
 
 void SpriteCache::add (Sprite& sprite) {
@@ -87,6 +87,10 @@ public:
     void setShader (gdx_cpp::graphics::glutils::ShaderProgram* shader);
 
 private:
+    /** Adds a width x height quad scaled and rotated around its origin, transforming the corners in one batch */
+    void addTransformed (Texture::ptr texture, float x, float y, float originX, float originY, float width,
+                         float height, float scaleX, float scaleY, float rotation, float u, float v, float u2, float v2);
+
     static float tempVertices[Sprite::VERTEX_SIZE * 6];
 
     Mesh* mesh;
@@ -18,23 +18,34 @@
     @author Ozires Bortolon de Faria ozires@aevumlab.com
 */
 
+
 #ifndef GDX_CPP_GRAPHICS_G2D_TILED_TILESET_HPP_
 #define GDX_CPP_GRAPHICS_G2D_TILED_TILESET_HPP_
 
+#include <string>
+
 namespace gdx_cpp {
 namespace graphics {
 namespace g2d {
 namespace tiled {
 
+/** A tileset of a TMX map: the image its tiles are cut from and the ids it covers, starting at firstgid */
 class TileSet {
 public:
-
-
-protected:
-
-
-private:
-
+    TileSet ()
+    : firstgid(0)
+    , tileWidth(0)
+    , tileHeight(0)
+    , margin(0)
+    , spacing(0)
+    {
+    }
+
+    std::string name;
+    int firstgid;
+    int tileWidth, tileHeight;
+    int margin, spacing;
+    std::string imageName;
 };
 
 } // namespace gdx_cpp
@@ -18,16 +18,27 @@
     @author Ozires Bortolon de Faria ozires@aevumlab.com
 */
 
+
 #include "TiledLayer.hpp"
 
 using namespace gdx_cpp::graphics::g2d::tiled;
 
-int TiledLayer::getWidth () {
-    if (tiles[0] == null) return 0;
-    return tiles[0].length;
+TiledLayer::TiledLayer ()
+: width(0)
+, height(0)
+{
+}
+
+void TiledLayer::setSize (int width, int height) {
+    this->width = width;
+    this->height = height;
+    tiles.assign(width * height, 0);
 }
 
-int TiledLayer::getHeight () {
-    return tiles.length;
+int TiledLayer::getWidth () const {
+    return width;
 }
 
+int TiledLayer::getHeight () const {
+    return height;
+}
@@ -18,24 +18,44 @@
     @author Ozires Bortolon de Faria ozires@aevumlab.com
 */
 
+
 #ifndef GDX_CPP_GRAPHICS_G2D_TILED_TILEDLAYER_HPP_
 #define GDX_CPP_GRAPHICS_G2D_TILED_TILEDLAYER_HPP_
 
+#include <map>
+#include <string>
+#include <vector>
+
 namespace gdx_cpp {
 namespace graphics {
 namespace g2d {
 namespace tiled {
 
+/** A layer of tile ids, 0 where there is no tile. The ids keep Tiled's flip flags in their top bits. */
 class TiledLayer {
 public:
-    int getWidth ();
-    int getHeight ();
+    TiledLayer ();
 
-protected:
+    /** Sizes the layer and clears it */
+    void setSize (int width, int height);
+    int getWidth () const;
+    int getHeight () const;
 
+    int getTile (int row, int col) const {
+        return tiles[row * width + col];
+    }
 
-private:
+    void setTile (int row, int col, int id) {
+        tiles[row * width + col] = id;
+    }
 
+    std::string name;
+    std::map<std::string, std::string> properties;
+    /** the ids row by row, the first row at the top */
+    std::vector<int> tiles;
+
+private:
+    int width, height;
 };
 
 } // namespace gdx_cpp
@@ -18,787 +18,274 @@
     @author Ozires Bortolon de Faria ozires@aevumlab.com
 */
 
-#include "TiledLoader.hpp"
-
-using namespace gdx_cpp::graphics::g2d::tiled;
-
-TiledMap& TiledLoader::createMap (const gdx_cpp::files::FileHandle& tmxFile) {
-
-    final TiledMap map;
-
-    map = new TiledMap();
-    map.tmxFile = tmxFile;
-
-    try {
-        new XmlReader() {
-
-            Stack<String> currBranch = new Stack<String>();
-
-            boolean awaitingData = false;
-            TiledLayer currLayer;
-            int currLayerWidth = 0, currLayerHeight = 0;
-            TileSet currTileSet;
-            TiledObjectGroup currObjectGroup;
-            TiledObject currObject;
-            int currTile;
-
-            class Property {
-                String parentType, name, value;
-            }
-
-            Property currProperty;
-
-            String encoding, dataString, compression;
-            byte[] data;
-
-            int dataCounter = 0, row, col;
-
-            @Override
-            protected void open (String name) {
-                currBranch.push(name);
-
-                if ("layer".equals(name)) {
-                    currLayer = new TiledLayer();
-                    return;
-                }
-
-                if ("tileset".equals(name)) {
-                    currTileSet = new TileSet();
-                    return;
-                }
-
-                if ("data".equals(name)) {
-                    dataString = ""; // clear the string for new data
-                    awaitingData = true;
-                    return;
-                }
-
-                if ("objectgroup".equals(name)) {
-                    currObjectGroup = new TiledObjectGroup();
-                    return;
-                }
-
-                if ("object".equals(name)) {
-                    currObject = new TiledObject();
-                    return;
-                }
-
-                if ("property".equals(name)) {
-                    currProperty = new Property();
-                    currProperty.parentType = currBranch.get(currBranch.size() - 3);
-                    return;
-                }
-            }
-
-            @Override
-            protected void attribute (String name, String value) {
-                String element = currBranch.peek();
-
-                if ("layer".equals(element)) {
-                    if ("width".equals(name)) {
-                        currLayerWidth = Integer.parseInt(value);
-                    } else if ("height".equals(name)) {
-                        currLayerHeight = Integer.parseInt(value);
-                    }
-
-                    if (currLayerWidth != 0 && currLayerHeight != 0) {
-                        currLayer.tiles = new int[currLayerHeight][currLayerWidth];
-                    }
-                    return;
-                }
-
-                if ("tileset".equals(element)) {
-                    if ("firstgid".equals(name)) {
-                        currTileSet.firstgid = Integer.parseInt(value);
-                        return;
-                    }
-                    if ("tilewidth".equals(name)) {
-                        currTileSet.tileWidth = Integer.parseInt(value);
-                        return;
-                    }
-                    if ("tileheight".equals(name)) {
-                        currTileSet.tileHeight = Integer.parseInt(value);
-                        return;
-                    }
-                    if ("name".equals(name)) {
-                        currTileSet.name = value;
-                        return;
-                    }
-                    if ("spacing".equals(name)) {
-                        currTileSet.spacing = Integer.parseInt(value);
-                        return;
-                    }
-                    if ("margin".equals(name)) {
-                        currTileSet.margin = Integer.parseInt(value);
-                        return;
-                    }
-                    return;
-                }
-
-                if ("image".equals(element)) {
-                    if ("source".equals(name)) {
-                        currTileSet.imageName = value;
-                        return;
-                    }
-                    return;
-                }
-
-                if ("data".equals(element)) {
-                    if ("encoding".equals(name)) {
-                        encoding = value;
-                        return;
-                    }
-                    if ("compression".equals(name)) {
-                        compression = value;
-                        return;
-                    }
-                    return;
-                }
-
-                if ("objectgroup".equals(element)) {
-                    if ("name".equals(name)) {
-                        currObjectGroup.name = value;
-                        return;
-                    }
-                    if ("height".equals(name)) {
-                        currObjectGroup.height = Integer.parseInt(value);
-                        return;
-                    }
-                    if ("width".equals(name)) {
-                        currObjectGroup.width = Integer.parseInt(value);
-                        return;
-                    }
-                    return;
-                }
-
-                if ("object".equals(element)) {
-                    if ("name".equals(name)) {
-                        currObject.name = value;
-                        return;
-                    }
-                    if ("type".equals(name)) {
-                        currObject.type = value;
-                        return;
-                    }
-                    if ("x".equals(name)) {
-                        currObject.x = Integer.parseInt(value);
-                        return;
-                    }
-                    if ("y".equals(name)) {
-                        currObject.y = Integer.parseInt(value);
-                        return;
-                    }
-                    if ("width".equals(name)) {
-                        currObject.width = Integer.parseInt(value);
-                        return;
-                    }
-                    if ("height".equals(name)) {
-                        currObject.height = Integer.parseInt(value);
-                        return;
-                    }
-                    if ("gid".equals(name)) {
-                        currObject.gid = Integer.parseInt(value);
-                        return;
-                    }
-                    return;
-                }
-
-                if ("map".equals(element)) {
-                    if ("orientation".equals(name)) {
-                        map.orientation = value;
-                        return;
-                    }
-                    if ("width".equals(name)) {
-                        map.width = Integer.parseInt(value);
-                        return;
-                    }
-                    if ("height".equals(name)) {
-                        map.height = Integer.parseInt(value);
-                        return;
-                    }
-                    if ("tilewidth".equals(name)) {
-                        map.tileWidth = Integer.parseInt(value);
-                        return;
-                    }
-                    if ("tileheight".equals(name)) {
-                        map.tileHeight = Integer.parseInt(value);
-                        return;
-                    }
-                    return;
-                }
-
-                if ("tile".equals(element)) {
-                    if (awaitingData) { // Actually getting tile data
-                        if ("gid".equals(name)) {
-                            col = dataCounter % currLayerWidth;
-                            row = dataCounter / currLayerWidth;
-                            if (row < currLayerHeight) {
-                                currLayer.tiles[row][col] = Integer.parseInt(value);
-                            } else {
-                                Gdx.app.log("TiledLoader", "Warning: extra XML gid values ignored! Your map is likely corrupt!");
-                            }
-                            dataCounter++;
-                        }
-                    } else { // Not getting tile data, must be a tile Id (for properties)
-                        if ("id".equals(name)) {
-                            currTile = Integer.parseInt(value);
-                        }
-                    }
-                    return;
-                }
-
-                if ("property".equals(element)) {
-                    if ("name".equals(name)) {
-                        currProperty.name = value;
-                        return;
-                    }
-                    if ("value".equals(name)) {
-                        currProperty.value = value;
-                        return;
-                    }
-                    return;
-                }
-            }
-
-            @Override
-            protected void text (String text) {
-                if (awaitingData) {
-                    dataString = dataString.concat(text);
-                }
-            }
-
-            @Override
-            protected void close () {
-                String element = currBranch.pop();
-
-                if ("layer".equals(element)) {
-                    map.layers.add(currLayer);
-                    currLayer = null;
-                    return;
-                }
-
-                if ("tileset".equals(element)) {
-                    map.tileSets.add(currTileSet);
-                    currTileSet = null;
-                    return;
-                }
-
-                if ("object".equals(element)) {
-                    currObjectGroup.objects.add(currObject);
-                    currObject = null;
-                    return;
-                }
-
-                if ("objectgroup".equals(element)) {
-                    map.objectGroups.add(currObjectGroup);
-                    currObjectGroup = null;
-                    return;
-                }
-
-                if ("property".equals(element)) {
-                    putProperty(currProperty);
-                    currProperty = null;
-                    return;
-                }
-
-                if ("data".equals(element)) {
-
-                    // decode and uncompress the data
-                    if ("base64".equals(encoding)) {
-                        if (dataString == null | "".equals(dataString.trim())) return;
-
-                        data = Base64Coder.decode(dataString.trim());
-
-                        if ("gzip".equals(compression)) {
-                            unGZip();
-                        } else if ("zlib".equals(compression)) {
-                            unZlib();
-                        } else if (compression == null) {
-                            arrangeData();
-                        }
-
-                    } else if ("csv".equals(encoding) && compression == null) {
-                        fromCSV();
-
-                    } else if (encoding == null && compression == null) {
-                        // startElement() handles most of this
-                        dataCounter = 0;// reset counter in case another layer comes through
-                    } else {
-                        throw new GdxRuntimeException("Unsupported encoding and/or compression format");
-                    }
-
-                    awaitingData = false;
-                    return;
-                }
 
-                if ("property".equals(element)) {
-                    putProperty(currProperty);
-                    currProperty = null;
-                }
-            }
-
-            private void putProperty (Property property) {
-                if ("tile".equals(property.parentType)) {
-                    map.setTileProperty(currTile + currTileSet.firstgid, property.name, property.value);
-                    return;
-                }
-
-                if ("map".equals(property.parentType)) {
-                    map.properties.put(property.name, property.value);
-                    return;
-                }
-
-                if ("layer".equals(property.parentType)) {
-                    currLayer.properties.put(property.name, property.value);
-                    return;
-                }
-
-                if ("objectgroup".equals(property.parentType)) {
-                    currObjectGroup.properties.put(property.name, property.value);
-                    return;
-                }
-
-                if ("object".equals(property.parentType)) {
-                    currObject.properties.put(property.name, property.value);
-                    return;
-                }
-            }
-
-            private void fromCSV () {
-                StringTokenizer st = new StringTokenizer(dataString.trim(), ",");
-                for (int row = 0; row < currLayerHeight; row++) {
-                    for (int col = 0; col < currLayerWidth; col++) {
-                        currLayer.tiles[row][col] = Integer.parseInt(st.nextToken().trim());
-                    }
-                }
-            }
-
-            private void arrangeData () {
-                int byteCounter = 0;
-                for (int row = 0; row < currLayerHeight; row++) {
-                    for (int col = 0; col < currLayerWidth; col++) {
-                        currLayer.tiles[row][col] = unsignedByteToInt(data[byteCounter++])
-                                                    | unsignedByteToInt(data[byteCounter++]) << 8 | unsignedByteToInt(data[byteCounter++]) << 16
-                                                    | unsignedByteToInt(data[byteCounter++]) << 24;
-                    }
-                }
-            }
-
-            private void unZlib () {
-                Inflater zlib = new Inflater();
-                byte[] readTemp = new byte[4];
-
-                zlib.setInput(data, 0, data.length);
-
-                for (int row = 0; row < currLayerHeight; row++) {
-                    for (int col = 0; col < currLayerWidth; col++) {
-                        try {
-                            zlib.inflate(readTemp, 0, 4);
-                            currLayer.tiles[row][col] = unsignedByteToInt(readTemp[0]) | unsignedByteToInt(readTemp[1]) << 8
-                                                        | unsignedByteToInt(readTemp[2]) << 16 | unsignedByteToInt(readTemp[3]) << 24;
-                        } catch (DataFormatException e) {
-                            throw new GdxRuntimeException("Error Reading TMX Layer Data.", e);
-                        }
-                    }
-                }
-            }
+#include "TiledLoader.hpp"
+#include "gdx-cpp/Gdx.hpp"
+#include "gdx-cpp/files/MappedFile.hpp"
+#include "gdx-cpp/utils/Base64Coder.hpp"
+#include "gdx-cpp/utils/Inflater.hpp"
+#include "gdx-cpp/utils/XmlReader.hpp"
 
-            private void unGZip () {
-                GZIPInputStream GZIS = null;
-                try {
-                    GZIS = new GZIPInputStream(new ByteArrayInputStream(data), data.length);
-                } catch (IOException e) {
-                    throw new GdxRuntimeException("Error Reading TMX Layer Data - IOException: " + e.getMessage());
-                }
+#include <algorithm>
+#include <stdexcept>
 
-                // Read the GZIS data into an array, 4 bytes = 1 GID
-                byte[] readTemp = new byte[4];
-                for (int row = 0; row < currLayerHeight; row++) {
-                    for (int col = 0; col < currLayerWidth; col++) {
-                        try {
-                            GZIS.read(readTemp, 0, 4);
-                            currLayer.tiles[row][col] = unsignedByteToInt(readTemp[0]) | unsignedByteToInt(readTemp[1]) << 8
-                                                        | unsignedByteToInt(readTemp[2]) << 16 | unsignedByteToInt(readTemp[3]) << 24;
-                        } catch (IOException e) {
-                            throw new GdxRuntimeException("Error Reading TMX Layer Data.", e);
-                        }
-                    }
-                }
-            }
-        } .parse(tmxFile);
-    } catch (IOException e) {
-        throw new GdxRuntimeException("Error Parsing TMX file", e);
+using namespace gdx_cpp::graphics::g2d::tiled;
+using gdx_cpp::utils::Base64Coder;
+using gdx_cpp::utils::Base64Decoder;
+using gdx_cpp::utils::Inflater;
+using gdx_cpp::utils::StringView;
+using gdx_cpp::utils::XmlReader;
+
+namespace {
+
+/** What is being read. The objects are filled in place at the back of their vectors, which is safe because elements of
+ * one kind never nest. */
+struct LoadState {
+    LoadState (TiledMap& map)
+    : map(map)
+    , layer(NULL)
+    , tileSet(NULL)
+    , objectGroup(NULL)
+    , object(NULL)
+    , tile(0)
+    , awaitingData(false)
+    , base64(false)
+    , dataCounter(0)
+    {
+    }
+
+    TiledMap& map;
+    TiledLayer* layer;
+    TileSet* tileSet;
+    TiledObjectGroup* objectGroup;
+    TiledObject* object;
+    /** the id of the <tile> whose properties are read */
+    int tile;
+    bool awaitingData;
+    std::string encoding, compression;
+    std::string dataString;
+    /** base64 data is decoded as it arrives, straight into the layer's tiles unless it is compressed */
+    bool base64;
+    Base64Decoder decoder;
+    /** compressed data, inflated into the tiles once all of it is read */
+    std::vector<unsigned char> compressed;
+    /** bytes of base64 data or <tile> elements read */
+    int dataCounter;
+    /** the names of the open elements */
+    std::vector<StringView> branch;
+};
+
+void putProperty (LoadState& state, const StringView& parentType, const std::string& name, const std::string& value) {
+    if (parentType == StringView("tile")) {
+        if (state.tileSet != NULL) state.map.setTileProperty(state.tile + state.tileSet->firstgid, name, value);
+    } else if (parentType == StringView("map")) {
+        state.map.properties[name] = value;
+    } else if (parentType == StringView("layer")) {
+        if (state.layer != NULL) state.layer->properties[name] = value;
+    } else if (parentType == StringView("objectgroup")) {
+        if (state.objectGroup != NULL) state.objectGroup->properties[name] = value;
+    } else if (parentType == StringView("object")) {
+        if (state.object != NULL) state.object->properties[name] = value;
     }
-
-    return map;
 }
 
-void TiledLoader::open (const std::string& name) {
-    currBranch.push(name);
-
-    if ("layer".equals(name)) {
-        currLayer = new TiledLayer();
-        return;
-    }
-
-    if ("tileset".equals(name)) {
-        currTileSet = new TileSet();
-        return;
-    }
-
-    if ("data".equals(name)) {
-        dataString = ""; // clear the string for new data
-        awaitingData = true;
-        return;
-    }
-
-    if ("objectgroup".equals(name)) {
-        currObjectGroup = new TiledObjectGroup();
-        return;
-    }
-
-    if ("object".equals(name)) {
-        currObject = new TiledObject();
-        return;
-    }
-
-    if ("property".equals(name)) {
-        currProperty = new Property();
-        currProperty.parentType = currBranch.get(currBranch.size() - 3);
-        return;
+void fromCSV (LoadState& state) {
+    TiledLayer& layer = *state.layer;
+    const char* c = state.dataString.data();
+    const char* end = c + state.dataString.size();
+    int count = layer.getWidth() * layer.getHeight();
+    for (int i = 0; i < count; i++) {
+        while (c != end && (*c == ',' || *c == ' ' || *c == '\n' || *c == '\r' || *c == '\t'))
+            c++;
+        if (c == end || (unsigned char) (*c - '0') >= 10)
+            throw std::runtime_error("Error reading TMX layer data: not enough tiles");
+        unsigned int id = 0;
+        for (; c != end && (unsigned char) (*c - '0') < 10; c++)
+            id = id * 10 + (*c - '0');
+        layer.tiles[i] = (int) id;
     }
 }
 
-void TiledLoader::attribute (const std::string& name,const std::string& value) {
-    String element = currBranch.peek();
-
-    if ("layer".equals(element)) {
-        if ("width".equals(name)) {
-            currLayerWidth = Integer.parseInt(value);
-        } else if ("height".equals(name)) {
-            currLayerHeight = Integer.parseInt(value);
-        }
-
-        if (currLayerWidth != 0 && currLayerHeight != 0) {
-            currLayer.tiles = new int[currLayerHeight][currLayerWidth];
-        }
-        return;
-    }
-
-    if ("tileset".equals(element)) {
-        if ("firstgid".equals(name)) {
-            currTileSet.firstgid = Integer.parseInt(value);
-            return;
-        }
-        if ("tilewidth".equals(name)) {
-            currTileSet.tileWidth = Integer.parseInt(value);
-            return;
-        }
-        if ("tileheight".equals(name)) {
-            currTileSet.tileHeight = Integer.parseInt(value);
-            return;
-        }
-        if ("name".equals(name)) {
-            currTileSet.name = value;
-            return;
-        }
-        if ("spacing".equals(name)) {
-            currTileSet.spacing = Integer.parseInt(value);
-            return;
-        }
-        if ("margin".equals(name)) {
-            currTileSet.margin = Integer.parseInt(value);
-            return;
-        }
-        return;
-    }
-
-    if ("image".equals(element)) {
-        if ("source".equals(name)) {
-            currTileSet.imageName = value;
-            return;
-        }
-        return;
-    }
-
-    if ("data".equals(element)) {
-        if ("encoding".equals(name)) {
-            encoding = value;
-            return;
-        }
-        if ("compression".equals(name)) {
-            compression = value;
-            return;
-        }
-        return;
-    }
-
-    if ("objectgroup".equals(element)) {
-        if ("name".equals(name)) {
-            currObjectGroup.name = value;
-            return;
-        }
-        if ("height".equals(name)) {
-            currObjectGroup.height = Integer.parseInt(value);
-            return;
-        }
-        if ("width".equals(name)) {
-            currObjectGroup.width = Integer.parseInt(value);
-            return;
-        }
-        return;
-    }
-
-    if ("object".equals(element)) {
-        if ("name".equals(name)) {
-            currObject.name = value;
-            return;
-        }
-        if ("type".equals(name)) {
-            currObject.type = value;
-            return;
-        }
-        if ("x".equals(name)) {
-            currObject.x = Integer.parseInt(value);
-            return;
-        }
-        if ("y".equals(name)) {
-            currObject.y = Integer.parseInt(value);
-            return;
-        }
-        if ("width".equals(name)) {
-            currObject.width = Integer.parseInt(value);
-            return;
-        }
-        if ("height".equals(name)) {
-            currObject.height = Integer.parseInt(value);
-            return;
-        }
-        if ("gid".equals(name)) {
-            currObject.gid = Integer.parseInt(value);
-            return;
-        }
-        return;
-    }
-
-    if ("map".equals(element)) {
-        if ("orientation".equals(name)) {
-            map.orientation = value;
-            return;
-        }
-        if ("width".equals(name)) {
-            map.width = Integer.parseInt(value);
-            return;
-        }
-        if ("height".equals(name)) {
-            map.height = Integer.parseInt(value);
-            return;
-        }
-        if ("tilewidth".equals(name)) {
-            map.tileWidth = Integer.parseInt(value);
-            return;
-        }
-        if ("tileheight".equals(name)) {
-            map.tileHeight = Integer.parseInt(value);
-            return;
-        }
-        return;
+/** Decodes a piece of base64 layer data into the tiles, which are stored as little endian 32 bit gids, or into the
+ * compressed data */
+void appendBase64 (LoadState& state, const StringView& text) {
+    unsigned char* out;
+    size_t capacity;
+    if (state.compression.empty()) {
+        TiledLayer& layer = *state.layer;
+        size_t size = layer.tiles.size() * sizeof(int);
+        out = size ? (unsigned char*) &layer.tiles[0] + state.dataCounter : NULL;
+        capacity = size - state.dataCounter;
+    } else {
+        size_t needed = state.dataCounter + Base64Coder::decodedMaxLength(text.size());
+        if (state.compressed.size() < needed) state.compressed.resize(std::max(needed, state.compressed.size() * 2));
+        out = &state.compressed[state.dataCounter];
+        capacity = state.compressed.size() - state.dataCounter;
     }
-
-    if ("tile".equals(element)) {
-        if (awaitingData) { // Actually getting tile data
-            if ("gid".equals(name)) {
-                col = dataCounter % currLayerWidth;
-                row = dataCounter / currLayerWidth;
-                if (row < currLayerHeight) {
-                    currLayer.tiles[row][col] = Integer.parseInt(value);
-                } else {
-                    Gdx.app.log("TiledLoader", "Warning: extra XML gid values ignored! Your map is likely corrupt!");
-                }
-                dataCounter++;
-            }
-        } else { // Not getting tile data, must be a tile Id (for properties)
-            if ("id".equals(name)) {
-                currTile = Integer.parseInt(value);
-            }
-        }
-        return;
-    }
-
-    if ("property".equals(element)) {
-        if ("name".equals(name)) {
-            currProperty.name = value;
-            return;
-        }
-        if ("value".equals(name)) {
-            currProperty.value = value;
-            return;
-        }
-        return;
-    }
-}
-
-void TiledLoader::text (const std::string& text) {
-    if (awaitingData) {
-        dataString = dataString.concat(text);
+    try {
+        state.dataCounter += state.decoder.decode(text.data, text.size(), out, capacity);
+    } catch (std::runtime_error& e) {
+        throw std::runtime_error(std::string("Error reading TMX layer data: ") + e.what());
     }
 }
 
-void TiledLoader::close () {
-    String element = currBranch.pop();
-
-    if ("layer".equals(element)) {
-        map.layers.add(currLayer);
-        currLayer = null;
-        return;
-    }
-
-    if ("tileset".equals(element)) {
-        map.tileSets.add(currTileSet);
-        currTileSet = null;
-        return;
-    }
-
-    if ("object".equals(element)) {
-        currObjectGroup.objects.add(currObject);
-        currObject = null;
-        return;
-    }
-
-    if ("objectgroup".equals(element)) {
-        map.objectGroups.add(currObjectGroup);
-        currObjectGroup = null;
-        return;
-    }
-
-    if ("property".equals(element)) {
-        putProperty(currProperty);
-        currProperty = null;
-        return;
-    }
-
-    if ("data".equals(element)) {
-
-        // decode and uncompress the data
-        if ("base64".equals(encoding)) {
-            if (dataString == null | "".equals(dataString.trim())) return;
-
-            data = Base64Coder.decode(dataString.trim());
-
-            if ("gzip".equals(compression)) {
-                unGZip();
-            } else if ("zlib".equals(compression)) {
-                unZlib();
-            } else if (compression == null) {
-                arrangeData();
-            }
-
-        } else if ("csv".equals(encoding) && compression == null) {
-            fromCSV();
-
-        } else if (encoding == null && compression == null) {
-            // startElement() handles most of this
-            dataCounter = 0;// reset counter in case another layer comes through
-        } else {
-            throw new GdxRuntimeException("Unsupported encoding and/or compression format");
+void fromBase64 (LoadState& state) {
+    TiledLayer& layer = *state.layer;
+    size_t size = layer.tiles.size() * sizeof(int);
+    try {
+        state.decoder.finish();
+        if (!state.compression.empty()) {
+            const unsigned char* compressed = state.dataCounter ? &state.compressed[0] : NULL;
+            unsigned char* tiles = size ? (unsigned char*) &layer.tiles[0] : NULL;
+            state.dataCounter = (int) Inflater::inflate(compressed, state.dataCounter, tiles, size);
         }
-
-        awaitingData = false;
-        return;
+    } catch (std::runtime_error& e) {
+        throw std::runtime_error(std::string("Error reading TMX layer data: ") + e.what());
     }
+    if ((size_t) state.dataCounter != size)
+        throw std::runtime_error("Error reading TMX layer data: not enough tiles");
 
-    if ("property".equals(element)) {
-        putProperty(currProperty);
-        currProperty = null;
+    const unsigned int one = 1;
+    if (*(const unsigned char*) &one == 1) return;
+    for (size_t i = 0; i < layer.tiles.size(); i++) {
+        const unsigned char* bytes = (const unsigned char*) &layer.tiles[i];
+        layer.tiles[i] = (int) (bytes[0] | bytes[1] << 8 | bytes[2] << 16 | (unsigned int) bytes[3] << 24);
     }
 }
 
-void TiledLoader::putProperty (const Property& property) {
-    if ("tile".equals(property.parentType)) {
-        map.setTileProperty(currTile + currTileSet.firstgid, property.name, property.value);
-        return;
-    }
-
-    if ("map".equals(property.parentType)) {
-        map.properties.put(property.name, property.value);
-        return;
-    }
-
-    if ("layer".equals(property.parentType)) {
-        currLayer.properties.put(property.name, property.value);
-        return;
+void open (LoadState& state, XmlReader& reader) {
+    const StringView& name = reader.getName();
+    state.branch.push_back(name);
+    TiledMap& map = state.map;
+
+    if (state.awaitingData && name == StringView("tile")) {
+        // tile data as XML, one element per tile, by far the most elements of such a map
+        TiledLayer& layer = *state.layer;
+        if (state.dataCounter < layer.getWidth() * layer.getHeight()) {
+            layer.tiles[state.dataCounter] = reader.getIntAttribute("gid");
+        } else if (state.dataCounter == layer.getWidth() * layer.getHeight() && gdx_cpp::Gdx::app != NULL) {
+            gdx_cpp::Gdx::app->log("TiledLoader", "Warning: extra XML gid values ignored! Your map is likely corrupt!");
+        }
+        state.dataCounter++;
+    } else if (name == StringView("map")) {
+        map.orientation = reader.getAttribute("orientation").str();
+        map.width = reader.getIntAttribute("width");
+        map.height = reader.getIntAttribute("height");
+        map.tileWidth = reader.getIntAttribute("tilewidth");
+        map.tileHeight = reader.getIntAttribute("tileheight");
+    } else if (name == StringView("layer")) {
+        map.layers.push_back(TiledLayer());
+        state.layer = &map.layers.back();
+        state.layer->name = reader.getAttribute("name").str();
+        state.layer->setSize(reader.getIntAttribute("width"), reader.getIntAttribute("height"));
+    } else if (name == StringView("tileset")) {
+        map.tileSets.push_back(TileSet());
+        state.tileSet = &map.tileSets.back();
+        TileSet& tileSet = *state.tileSet;
+        tileSet.name = reader.getAttribute("name").str();
+        tileSet.firstgid = reader.getIntAttribute("firstgid");
+        tileSet.tileWidth = reader.getIntAttribute("tilewidth");
+        tileSet.tileHeight = reader.getIntAttribute("tileheight");
+        tileSet.spacing = reader.getIntAttribute("spacing");
+        tileSet.margin = reader.getIntAttribute("margin");
+    } else if (name == StringView("image")) {
+        if (state.tileSet != NULL) state.tileSet->imageName = reader.getAttribute("source").str();
+    } else if (name == StringView("data")) {
+        if (state.layer == NULL) throw std::runtime_error("Error reading TMX: data outside of a layer");
+        state.encoding = reader.getAttribute("encoding").str();
+        state.compression = reader.getAttribute("compression").str();
+        state.dataString.clear();
+        state.dataCounter = 0;
+        state.awaitingData = true;
+        state.base64 = state.encoding == "base64"
+                       && (state.compression.empty() || state.compression == "gzip" || state.compression == "zlib");
+        state.decoder.reset();
+    } else if (name == StringView("objectgroup")) {
+        map.objectGroups.push_back(TiledObjectGroup());
+        state.objectGroup = &map.objectGroups.back();
+        state.objectGroup->name = reader.getAttribute("name").str();
+        state.objectGroup->width = reader.getIntAttribute("width");
+        state.objectGroup->height = reader.getIntAttribute("height");
+    } else if (name == StringView("object")) {
+        if (state.objectGroup == NULL) return;
+        state.objectGroup->objects.push_back(TiledObject());
+        state.object = &state.objectGroup->objects.back();
+        TiledObject& object = *state.object;
+        object.name = reader.getAttribute("name").str();
+        object.type = reader.getAttribute("type").str();
+        object.x = reader.getIntAttribute("x");
+        object.y = reader.getIntAttribute("y");
+        object.width = reader.getIntAttribute("width");
+        object.height = reader.getIntAttribute("height");
+        object.gid = reader.getIntAttribute("gid");
+    } else if (name == StringView("tile")) {
+        // a tile id, for properties
+        state.tile = reader.getIntAttribute("id");
+    } else if (name == StringView("property")) {
+        // property > properties > parent
+        if (state.branch.size() < 3) return;
+        putProperty(state, state.branch[state.branch.size() - 3], reader.getAttribute("name").str(),
+                    reader.getAttribute("value").str());
     }
+}
 
-    if ("objectgroup".equals(property.parentType)) {
-        currObjectGroup.properties.put(property.name, property.value);
-        return;
-    }
+void close (LoadState& state) {
+    StringView name = state.branch.back();
+    state.branch.pop_back();
 
-    if ("object".equals(property.parentType)) {
-        currObject.properties.put(property.name, property.value);
+    if (state.awaitingData && name == StringView("tile")) {
         return;
-    }
-}
-
-void TiledLoader::fromCSV () {
-    StringTokenizer st = new StringTokenizer(dataString.trim(), ",");
-    for (int row = 0; row < currLayerHeight; row++) {
-        for (int col = 0; col < currLayerWidth; col++) {
-            currLayer.tiles[row][col] = Integer.parseInt(st.nextToken().trim());
+    } else if (name == StringView("layer")) {
+        state.layer = NULL;
+    } else if (name == StringView("tileset")) {
+        state.tileSet = NULL;
+    } else if (name == StringView("object")) {
+        state.object = NULL;
+    } else if (name == StringView("objectgroup")) {
+        state.objectGroup = NULL;
+    } else if (name == StringView("data")) {
+        state.awaitingData = false;
+        if (state.base64) {
+            fromBase64(state);
+        } else if (state.encoding == "csv" && state.compression.empty()) {
+            fromCSV(state);
+        } else if (!state.encoding.empty() || !state.compression.empty()) {
+            throw std::runtime_error("Unsupported TMX encoding and/or compression format: " + state.encoding + " "
+                                     + state.compression);
         }
     }
 }
 
-void TiledLoader::arrangeData () {
-    int byteCounter = 0;
-    for (int row = 0; row < currLayerHeight; row++) {
-        for (int col = 0; col < currLayerWidth; col++) {
-            currLayer.tiles[row][col] = unsignedByteToInt(data[byteCounter++])
-                                        | unsignedByteToInt(data[byteCounter++]) << 8 | unsignedByteToInt(data[byteCounter++]) << 16
-                                        | unsignedByteToInt(data[byteCounter++]) << 24;
-        }
-    }
 }
 
-void TiledLoader::unZlib () {
-    Inflater zlib = new Inflater();
-    byte[] readTemp = new byte[4];
-
-    zlib.setInput(data, 0, data.length);
-
-    for (int row = 0; row < currLayerHeight; row++) {
-        for (int col = 0; col < currLayerWidth; col++) {
-            try {
-                zlib.inflate(readTemp, 0, 4);
-                currLayer.tiles[row][col] = unsignedByteToInt(readTemp[0]) | unsignedByteToInt(readTemp[1]) << 8
-                                            | unsignedByteToInt(readTemp[2]) << 16 | unsignedByteToInt(readTemp[3]) << 24;
-            } catch (DataFormatException e) {
-                throw new GdxRuntimeException("Error Reading TMX Layer Data.", e);
-            }
-        }
-    }
+TiledMap::ptr TiledLoader::createMap (files::FileHandle& tmxFile) {
+    files::MappedFile file(tmxFile);
+    TiledMap::ptr map = createMap(file.getData(), file.getSize());
+    map->tmxFile.reset(new files::FileHandle(tmxFile));
+    return map;
 }
 
-void TiledLoader::unGZip () {
-    GZIPInputStream GZIS = null;
-    try {
-        GZIS = new GZIPInputStream(new ByteArrayInputStream(data), data.length);
-    } catch (IOException e) {
-        throw new GdxRuntimeException("Error Reading TMX Layer Data - IOException: " + e.getMessage());
-    }
-
-    // Read the GZIS data into an array, 4 bytes = 1 GID
-    byte[] readTemp = new byte[4];
-    for (int row = 0; row < currLayerHeight; row++) {
-        for (int col = 0; col < currLayerWidth; col++) {
-            try {
-                GZIS.read(readTemp, 0, 4);
-                currLayer.tiles[row][col] = unsignedByteToInt(readTemp[0]) | unsignedByteToInt(readTemp[1]) << 8
-                                            | unsignedByteToInt(readTemp[2]) << 16 | unsignedByteToInt(readTemp[3]) << 24;
-            } catch (IOException e) {
-                throw new GdxRuntimeException("Error Reading TMX Layer Data.", e);
-            }
+TiledMap::ptr TiledLoader::createMap (const char* tmx, size_t length) {
+    TiledMap::ptr map(new TiledMap());
+    LoadState state(*map);
+    XmlReader reader;
+    reader.open(tmx, length);
+
+    while (true) {
+        switch (reader.next()) {
+        case XmlReader::START_ELEMENT:
+            open(state, reader);
+            break;
+        case XmlReader::END_ELEMENT:
+            close(state);
+            break;
+        case XmlReader::TEXT:
+            if (!state.awaitingData) break;
+            if (state.base64) appendBase64(state, reader.getText());
+            else state.dataString.append(reader.getText().data, reader.getText().size());
+            break;
+        case XmlReader::END_DOCUMENT:
+            return map;
         }
     }
 }
-
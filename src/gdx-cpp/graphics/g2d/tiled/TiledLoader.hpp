@@ -18,30 +18,26 @@
     @author Ozires Bortolon de Faria ozires@aevumlab.com
 */
 
+
 #ifndef GDX_CPP_GRAPHICS_G2D_TILED_TILEDLOADER_HPP_
 #define GDX_CPP_GRAPHICS_G2D_TILED_TILEDLOADER_HPP_
 
+#include "TiledMap.hpp"
+
+#include <cstddef>
+
 namespace gdx_cpp {
 namespace graphics {
 namespace g2d {
 namespace tiled {
 
+/** Loads TMX maps saved by Tiled. The file is mapped and streamed through an XmlReader, so no XML tree is built. Layer
+ * data may be CSV, base64, gzip or zlib compressed base64, or one <tile> element per tile. Throws std::runtime_error
+ * for malformed maps and unsupported encodings. */
 class TiledLoader {
 public:
-    static TiledMap& createMap (const gdx_cpp::files::FileHandle& tmxFile);
-
-protected:
-    void open (const std::string& name);
-    void attribute (const std::string& name,const std::string& value);
-    void text (const std::string& text);
-    void close ();
-
-private:
-    void putProperty (const Property& property);
-    void fromCSV ();
-    void arrangeData ();
-    void unZlib ();
-    void unGZip ();
+    static TiledMap::ptr createMap (files::FileHandle& tmxFile);
+    static TiledMap::ptr createMap (const char* tmx, size_t length);
 };
 
 } // namespace gdx_cpp
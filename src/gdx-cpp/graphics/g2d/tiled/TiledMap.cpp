@@ -18,32 +18,26 @@
     @author Ozires Bortolon de Faria ozires@aevumlab.com
 */
 
+
 #include "TiledMap.hpp"
 
 using namespace gdx_cpp::graphics::g2d::tiled;
 
-void TiledMap::setTileProperty (int id,const std::string& name,const std::string& value) {
-for (TileProperty tp : tileProperties) {
-        if (tp.id == id) {
-            tp.propertyMap.put(name, value);
-            return;
-        }
-    }
-
-    // no TileProperty found with the correct id, add a new one
-    TileProperty tempProperty = new TileProperty();
-    tempProperty.id = id;
-    tempProperty.propertyMap.put(name, value);
-    tileProperties.add(tempProperty);
+TiledMap::TiledMap ()
+: width(0)
+, height(0)
+, tileWidth(0)
+, tileHeight(0)
+{
 }
 
-std::string& TiledMap::getTileProperty (int id,const std::string& name) {
-for (TileProperty tp : tileProperties) {
-        if (tp.id == id) {
-            return tp.propertyMap.get(name);
-        }
-    }
-
-    return null;
+void TiledMap::setTileProperty (int id, const std::string& name, const std::string& value) {
+    tileProperties[id][name] = value;
 }
 
+std::string TiledMap::getTileProperty (int id, const std::string& name) const {
+    std::map<int, Properties>::const_iterator tile = tileProperties.find(id);
+    if (tile == tileProperties.end()) return std::string();
+    Properties::const_iterator property = tile->second.find(name);
+    return property != tile->second.end() ? property->second : std::string();
+}
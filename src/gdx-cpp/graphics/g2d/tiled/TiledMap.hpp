@@ -18,24 +18,48 @@
     @author Ozires Bortolon de Faria ozires@aevumlab.com
 */
 
+
 #ifndef GDX_CPP_GRAPHICS_G2D_TILED_TILEDMAP_HPP_
 #define GDX_CPP_GRAPHICS_G2D_TILED_TILEDMAP_HPP_
 
+#include "TileSet.hpp"
+#include "TiledLayer.hpp"
+#include "TiledObjectGroup.hpp"
+#include "gdx-cpp/files/FileHandle.hpp"
+#include "gdx-cpp/utils/Aliases.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
 namespace gdx_cpp {
 namespace graphics {
 namespace g2d {
 namespace tiled {
 
+/** A map loaded from a TMX file by TiledLoader */
 class TiledMap {
 public:
-    void setTileProperty (int id,const std::string& name,const std::string& value);
-    std::string& getTileProperty (int id,const std::string& name);
+    typedef ref_ptr_maker<TiledMap>::type ptr;
+    typedef std::map<std::string, std::string> Properties;
 
-protected:
+    TiledMap ();
 
+    void setTileProperty (int id, const std::string& name, const std::string& value);
+    /** The property of the tile with the global id, empty if it has none */
+    std::string getTileProperty (int id, const std::string& name) const;
 
-private:
+    std::string orientation;
+    int width, height, tileWidth, tileHeight;
+    /** the file the map was loaded from, tileset images are relative to it. NULL for maps parsed from memory. */
+    ref_ptr_maker<files::FileHandle>::type tmxFile;
+    std::vector<TiledLayer> layers;
+    std::vector<TileSet> tileSets;
+    std::vector<TiledObjectGroup> objectGroups;
+    Properties properties;
 
+private:
+    std::map<int, Properties> tileProperties;
 };
 
 } // namespace gdx_cpp
@@ -18,23 +18,33 @@
     @author Ozires Bortolon de Faria ozires@aevumlab.com
 */
 
+
 #ifndef GDX_CPP_GRAPHICS_G2D_TILED_TILEDOBJECT_HPP_
 #define GDX_CPP_GRAPHICS_G2D_TILED_TILEDOBJECT_HPP_
 
+#include <map>
+#include <string>
+
 namespace gdx_cpp {
 namespace graphics {
 namespace g2d {
 namespace tiled {
 
+/** An object of an object group, in pixels. gid is the tile it shows, if any. */
 class TiledObject {
 public:
-
-
-protected:
-
-
-private:
-
+    TiledObject ()
+    : x(0)
+    , y(0)
+    , width(0)
+    , height(0)
+    , gid(0)
+    {
+    }
+
+    std::string name, type;
+    int x, y, width, height, gid;
+    std::map<std::string, std::string> properties;
 };
 
 } // namespace gdx_cpp
@@ -18,9 +18,16 @@
     @author Ozires Bortolon de Faria ozires@aevumlab.com
 */
 
+
 #ifndef GDX_CPP_GRAPHICS_G2D_TILED_TILEDOBJECTGROUP_HPP_
 #define GDX_CPP_GRAPHICS_G2D_TILED_TILEDOBJECTGROUP_HPP_
 
+#include "TiledObject.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
 namespace gdx_cpp {
 namespace graphics {
 namespace g2d {
@@ -28,13 +35,16 @@ namespace tiled {
 
 class TiledObjectGroup {
 public:
-
-
-protected:
-
-
-private:
-
+    TiledObjectGroup ()
+    : width(0)
+    , height(0)
+    {
+    }
+
+    std::string name;
+    int width, height;
+    std::vector<TiledObject> objects;
+    std::map<std::string, std::string> properties;
 };
 
 } // namespace gdx_cpp
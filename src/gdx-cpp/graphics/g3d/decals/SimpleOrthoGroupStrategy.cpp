@@ -19,6 +19,7 @@
 */
 
 #include "SimpleOrthoGroupStrategy.hpp"
+#include "gdx-cpp/utils/Sort.hpp"
 
 using namespace gdx_cpp::graphics::g3d::decals;
 
@@ -28,7 +29,7 @@ int SimpleOrthoGroupStrategy::decideGroup (const Decal& decal) {
 
 void SimpleOrthoGroupStrategy::beforeGroup (int group,gdx_cpp::utils::ArrayDecal>& contents) {
     if (group == GROUP_BLEND) {
-        Sort.instance().sort(contents, comparator);
+        gdx_cpp::utils::Sort::instance().sort(contents, comparator);
         Gdx.gl10.glEnable(GL10.GL_BLEND);
         // no need for writing into the z buffer if transparent decals are the last thing to be rendered
         // and they are rendered back to front
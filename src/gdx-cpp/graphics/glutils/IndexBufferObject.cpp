@@ -161,4 +161,16 @@ IndexBufferObject::IndexBufferObject(int maxIndices)
     usage = GL11::GL_STATIC_DRAW;
 }
 
-
+IndexBufferObject::IndexBufferObject(bool isStatic, short* indices, int maxIndices)
+: buffer(utils::short_buffer::wrap(indices, maxIndices))
+, byteBuffer(utils::byte_buffer::wrap((char*) indices, maxIndices * 2))
+, bufferHandle(0)
+, isDirect(true)
+, isDirty(true)
+, isBound(false)
+, usage(0)
+, tmpHandle(0)
+{
+    bufferHandle = createBufferObject();
+    usage = isStatic ? GL11::GL_STATIC_DRAW : GL11::GL_DYNAMIC_DRAW;
+}
@@ -32,6 +32,9 @@ public:
 
     IndexBufferObject (bool isStatic, int maxIndices) ;
     IndexBufferObject (int maxIndices) ;
+    /** Uses maxIndices indices of caller owned memory as the buffer instead of allocating one. The memory has to
+     * outlive the object; its current contents are uploaded on the next bind. */
+    IndexBufferObject (bool isStatic, short* indices, int maxIndices) ;
     
     int getNumIndices ();
     int getNumMaxIndices ();
@@ -146,13 +146,13 @@ IndexBufferObjectSubData::IndexBufferObjectSubData(bool isStatic, int maxIndices
 :
 tmpHandle(0)
 , byteBuffer(maxIndices * 2)
-, buffer(byteBuffer.convert<short>())
 , bufferHandle(0)
 , isDirect(true)
 , isDirty(true)
 , isBound(false)
 , usage(isStatic ? GL11::GL_STATIC_DRAW : GL11::GL_DYNAMIC_DRAW)
 {
+    buffer = byteBuffer.convert<short>();
     // if (Gdx.app.getType() == ApplicationType.Android
     // && Gdx.app.getVersion() < 5) {
     // byteBuffer = ByteBuffer.allocate(maxIndices * 2);
@@ -169,13 +169,13 @@ IndexBufferObjectSubData::IndexBufferObjectSubData(int maxIndices)
 :
 tmpHandle(0)
 , byteBuffer(maxIndices * 2)
-, buffer(byteBuffer.convert<short>())
 , bufferHandle(0)
 , isDirect(true)
 , isDirty(true)
 , isBound(false)
 , usage(GL11::GL_STATIC_DRAW)
 {
+    buffer = byteBuffer.convert<short>();
     buffer.flip();
     byteBuffer.flip();
     bufferHandle = createBufferObject();
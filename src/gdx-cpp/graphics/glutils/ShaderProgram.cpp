@@ -23,7 +23,6 @@
 #include "gdx-cpp/Gdx.hpp"
 #include "gdx-cpp/Graphics.hpp"
 #include "gdx-cpp/Application.hpp"
-#include <tr1/unordered_map>
 #include <stdexcept>
 #include "gdx-cpp/math/Matrix3.hpp"
 #include "gdx-cpp/math/Matrix4.hpp"
@@ -41,7 +40,7 @@ const std::string ShaderProgram::TEXCOORD_ATTRIBUTE = "a_texCoord";
 const std::string ShaderProgram::TANGENT_ATTRIBUTE = "a_tangent";
 const std::string ShaderProgram::BINORMAL_ATTRIBUTE = "a_binormal";
 
-std::tr1::unordered_map <gdx_cpp::Application *, std::set<ShaderProgram *> * > ShaderProgram::shaders;
+gdx_cpp::utils::IdentityMap<gdx_cpp::Application, std::set<ShaderProgram *> * > ShaderProgram::shaders;
 
 bool ShaderProgram::pedantic = true;
 int ShaderProgram::intbuf = 0;
@@ -145,29 +144,22 @@ bool ShaderProgram::isCompiled () {
 
 int ShaderProgram::fetchAttributeLocation (const std::string& name) {
     gdx_cpp::graphics::GL20 * gl = gdx_cpp::Gdx::graphics->getGL20();
-    int location;
-    if (attributes.count(name) == 0)
-    {
-        location = gl->glGetAttribLocation(program, name);
-        if (location != -1) attributes[name] = location;
-    } else
-    {
-        location = attributes[name];
-    }
+    const int* cached = attributes.get(name);
+    if (cached != NULL) return *cached;
+
+    int location = gl->glGetAttribLocation(program, name);
+    if (location != -1) attributes.put(name, location);
     return location;
 }
 
 int ShaderProgram::fetchUniformLocation (const std::string& name) {
     gdx_cpp::graphics::GL20 * gl = gdx_cpp::Gdx::graphics->getGL20();
-    int location;
-    if (uniforms.count(name) == 0) {
-        location = gl->glGetUniformLocation(program, name);
-        if (location == -1 && pedantic)throw std::runtime_error("no uniform with name '" + name + "' in shader");
-        uniforms[name] = location;
-    }else
-    {
-        location = uniforms[name];
-    }
+    const int* cached = uniforms.get(name);
+    if (cached != NULL) return *cached;
+
+    int location = gl->glGetUniformLocation(program, name);
+    if (location == -1 && pedantic)throw std::runtime_error("no uniform with name '" + name + "' in shader");
+    uniforms.put(name, location);
     return location;
 }
 
@@ -299,7 +291,7 @@ void ShaderProgram::setVertexAttribute (const std::string& name, int size, int t
     gdx_cpp::graphics::GL20 * gl = gdx_cpp::Gdx::graphics->getGL20();
     checkManaged();
     int location = fetchAttributeLocation(name);
-    gl->glVertexAttribPointer(location, size, type, normalize, stride, buffer);
+    gl->glVertexAttribPointer(location, size, type, normalize, stride, buffer->pointer() + buffer->position());
 }
 
 void ShaderProgram::setVertexAttribute (const std::string& name, int size, int type, bool normalize, int stride, int offset) {
@@ -327,7 +319,8 @@ void ShaderProgram::dispose () {
     gl->glDeleteShader(vertexShaderHandle);
     gl->glDeleteShader(fragmentShaderHandle);
     gl->glDeleteProgram(program);
-    if (shaders.count(Gdx::app) > 0) shaders[Gdx::app]->erase(this);
+    std::set<ShaderProgram *> * managedResources = shaders.get(Gdx::app, NULL);
+    if (managedResources != NULL) managedResources->erase(this);
 }
 
 void ShaderProgram::disableVertexAttribute (const std::string& name) {
@@ -354,26 +347,16 @@ void ShaderProgram::checkManaged () {
 }
 
 void ShaderProgram::addManagedShader (gdx_cpp::Application* app, ShaderProgram* shaderProgram) {
-    std::set<ShaderProgram *> *  managedResources;
-
-    if (shaders.count(app) > 0)
-    {
-      managedResources =  shaders[app];
-    }
-    else
-    {
-      managedResources =  new std::set<ShaderProgram *>;
-      shaders[app] = managedResources;
-    }
+    std::set<ShaderProgram *> * & managedResources = shaders[app];
+    if (managedResources == NULL) managedResources = new std::set<ShaderProgram *>;
     managedResources->insert(shaderProgram);
 }
 
 void ShaderProgram::invalidateAllShaderPrograms (gdx_cpp::Application* app) {
     if (gdx_cpp::Gdx::graphics->getGL20() == NULL) return;
 
-    if (shaders.count(app) > 0) return;
-
-    std::set<ShaderProgram *> * shaderList = shaders[app];
+    std::set<ShaderProgram *> * shaderList = shaders.get(app, NULL);
+    if (shaderList == NULL) return;
 
     std::set<ShaderProgram *>::iterator it;
     for ( it=shaderList->begin() ; it != shaderList->end(); it++ )
@@ -384,15 +367,15 @@ void ShaderProgram::invalidateAllShaderPrograms (gdx_cpp::Application* app) {
 }
 
 void ShaderProgram::clearAllShaderPrograms (gdx_cpp::Application* app) {
-    shaders.erase(app);
+    shaders.remove(app);
 }
 
 std::string ShaderProgram::getManagedStatus () {
     std::stringstream builder;
     builder << "Managed shaders/app: { ";
-    std::tr1::unordered_map<gdx_cpp::Application *, std::set<ShaderProgram *> * >::iterator it;
+    utils::IdentityMap<gdx_cpp::Application, std::set<ShaderProgram *> * >::iterator it;
     for (it = shaders.begin(); it != shaders.end(); ++it) {
-        builder << it->second->size();
+        builder << it->value->size();
         builder << " ";
     }
     builder << "}";
@@ -406,7 +389,7 @@ void ShaderProgram::setAttributef (std::string& name,float value1,float value2,f
 }
 
 void ShaderProgram::ensureBufferCapacity (int numBytes) {
-    if (buffer.capacity() != numBytes) {
+    if (buffer.capacity() < numBytes) {
         buffer = gdx_cpp::utils::byte_buffer(numBytes);
         floatBuffer = buffer.convert<float>();
         intBuffer = buffer.convert<int>();
@@ -425,8 +408,8 @@ void ShaderProgram::fetchUniforms () {
         type=0;
         std::string name =  Gdx::gl20->glGetActiveUniform(program, i, &params, (char *) &type);
         int location = Gdx::gl20->glGetUniformLocation(program, name);
-        uniforms[name] =  location;
-        uniformTypes[name] = type;
+        uniforms.put(name, location);
+        uniformTypes.put(name, type);
         uniformNames[i] = name;
     }
 }
@@ -443,40 +426,34 @@ void ShaderProgram::fetchAttributes () {
         type = 0;
         std::string name = Gdx::gl20->glGetActiveAttrib(program, i, &params, (char*) &type);
         int location = Gdx::gl20->glGetAttribLocation(program, name);
-        attributes[name] = location;
-        attributeTypes[name] = type;
+        attributes.put(name, location);
+        attributeTypes.put(name, type);
         attributeNames[i] = name;
     }
 }
 
 bool ShaderProgram::hasAttribute (const std::string& name) {
-    return attributes.count(name) > 0;
+    return attributes.containsKey(name);
 }
 
 int ShaderProgram::getAttributeType (const std::string& name) {
-    return attributes[name];
+    return attributeTypes.get(name, 0);
 }
 
 int ShaderProgram::getAttributeLocation (const std::string& name) {
-    if (attributes.count(name) == 0)
-        return -1;
-    else
-        return attributes[name];
+    return attributes.get(name, -1);
 }
 
 bool ShaderProgram::hasUniform (const std::string& name) {
-    return uniforms.count(name) > 0;
+    return uniforms.containsKey(name);
 }
 
 int ShaderProgram::getUniformType (const std::string& name) {
-    return attributes[name];
+    return uniformTypes.get(name, 0);
 }
 
 int ShaderProgram::getUniformLocation (const std::string& name) {
-    if (uniforms.count(name) == 0)
-        return -1;
-    else
-        return uniforms[name];
+    return uniforms.get(name, -1);
 }
 
 std::vector<std::string>& ShaderProgram::getAttributes () {
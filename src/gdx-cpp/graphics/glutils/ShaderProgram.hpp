@@ -24,7 +24,8 @@
 #include "gdx-cpp/utils/Disposable.hpp"
 #include <set>
 #include <string>
-#include <tr1/unordered_map>
+#include <gdx-cpp/utils/IdentityMap.hpp>
+#include <gdx-cpp/utils/ObjectMap.hpp>
 #include <gdx-cpp/Application.hpp>
 #include <gdx-cpp/utils/Buffer.hpp>
 
@@ -112,20 +113,20 @@ private:
     void fetchUniforms ();
     void fetchAttributes ();
 
-    static std::tr1::unordered_map <gdx_cpp::Application *, std::set< ShaderProgram* > * > shaders;
+    static utils::IdentityMap<gdx_cpp::Application, std::set< ShaderProgram* > * > shaders;
 
     std::string log;
     bool isCompiledVar;
 
 //     const
-    std::tr1::unordered_map <std::string, int> uniforms;
+    utils::ObjectMap<std::string, int> uniforms;
 //     const
-    std::tr1::unordered_map <std::string, int> uniformTypes;
+    utils::ObjectMap<std::string, int> uniformTypes;
     std::vector<std::string> uniformNames;
 
-    std::tr1::unordered_map <std::string, int> attributes;
+    utils::ObjectMap<std::string, int> attributes;
 //     const
-    std::tr1::unordered_map <std::string, int> attributeTypes;
+    utils::ObjectMap<std::string, int> attributeTypes;
     std::vector<std::string> attributeNames;
 
     int program;
@@ -141,11 +141,20 @@ gdx_cpp::graphics::VertexAttributes& VertexArray::getAttributes () {
 
 VertexArray::VertexArray(int numVertices, const gdx_cpp::graphics::VertexAttributes& attributes)
 :
-attributes(attributes),
-isBound(false)
+attributes(attributes)
 , byteBuffer(this->attributes.vertexSize * numVertices)
+, isBound(false)
 {
     buffer = byteBuffer.convert<float>();
     buffer.flip();
     byteBuffer.flip();
 }
+
+VertexArray::VertexArray(float* vertices, int numVertices, const gdx_cpp::graphics::VertexAttributes& attributes)
+:
+attributes(attributes)
+, byteBuffer(utils::byte_buffer::wrap((char*) vertices, this->attributes.vertexSize * numVertices))
+, isBound(false)
+{
+    buffer = byteBuffer.convert<float>();
+}
@@ -31,6 +31,8 @@ class VertexArray : public VertexData {
 public:
 
     VertexArray (int numVertices, const gdx_cpp::graphics::VertexAttributes& attributes) ;
+    /** Points GL straight at numVertices vertices of caller owned memory, which has to outlive the object */
+    VertexArray (float* vertices, int numVertices, const gdx_cpp::graphics::VertexAttributes& attributes) ;
     
     void dispose ();
     utils::float_buffer& getBuffer ();
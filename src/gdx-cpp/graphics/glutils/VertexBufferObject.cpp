@@ -245,9 +245,8 @@ VertexBufferObject::VertexBufferObject(bool isStatic, int numVertices, const gdx
 , isStatic(isStatic)
 , byteBuffer(attributes.vertexSize * numVertices)
 {
-//TODO:     byteBuffer.order(ByteOrder.nativeOrder());
-    byteBuffer.flip();
     buffer = byteBuffer.convert<float>();
+    byteBuffer.flip();
     buffer.flip();
     
     bufferHandle = createBufferObject();
@@ -276,5 +275,21 @@ bufferHandle(0)
     usage = isStatic ? GL11::GL_STATIC_DRAW : GL11::GL_DYNAMIC_DRAW;
 }
 
+VertexBufferObject::VertexBufferObject(bool isStatic, float* vertices, int numVertices,
+                                       const gdx_cpp::graphics::VertexAttributes& attributes)
+:
+bufferHandle(0)
+, tmpHandle(0)
+, isDirect(true)
+, usage(0)
+, isDirty(true)
+, attributes(attributes)
+, isBound(false)
+, isStatic(isStatic)
+, byteBuffer(utils::byte_buffer::wrap((char*) vertices, attributes.vertexSize * numVertices))
+{
+    buffer = byteBuffer.convert<float>();
 
-
+    bufferHandle = createBufferObject();
+    usage = isStatic ? GL11::GL_STATIC_DRAW : GL11::GL_DYNAMIC_DRAW;
+}
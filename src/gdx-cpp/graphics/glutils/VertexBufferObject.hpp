@@ -35,6 +35,10 @@ public:
 
     VertexBufferObject (bool isStatic, int numVertices, const gdx_cpp::graphics::VertexAttributes& attributes);
     VertexBufferObject (bool isStatic, int numVertices, const std::vector< gdx_cpp::graphics::VertexAttribute >& attributes);
+    /** Uses numVertices vertices of caller owned memory as the buffer instead of allocating one. The memory has to
+     * outlive the object; its current contents are uploaded on the next bind. */
+    VertexBufferObject (bool isStatic, float* vertices, int numVertices,
+                        const gdx_cpp::graphics::VertexAttributes& attributes);
     
     gdx_cpp::graphics::VertexAttributes& getAttributes ();
     int getNumVertices ();
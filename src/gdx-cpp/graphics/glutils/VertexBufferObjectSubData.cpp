@@ -25,6 +25,8 @@
 #include "gdx-cpp/graphics/GL20.hpp"
 #include "gdx-cpp/graphics/glutils/ShaderProgram.hpp"
 
+#include <sstream>
+
 using namespace gdx_cpp::graphics::glutils;
 using namespace gdx_cpp::graphics;
 using namespace gdx_cpp;
@@ -258,8 +260,8 @@ VertexBufferObjectSubData::VertexBufferObjectSubData(bool isStatic, int numVerti
         , attributes(attributes)
         , isStatic(isStatic)
         , byteBuffer(this->attributes.vertexSize * numVertices)
-        , buffer(byteBuffer.convert<float>())
 {
+    buffer = byteBuffer.convert<float>();
     bufferHandle = createBufferObject();
     buffer.flip();
     byteBuffer.flip();
@@ -0,0 +1,382 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "JobSystem.hpp"
+#include "ThreadFactory.hpp"
+#include "gdx-cpp/utils/CacheLine.hpp"
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace gdx_cpp::implementation;
+
+namespace {
+
+/** A Chase-Lev deque of fixed capacity: the owner pushes and pops at the bottom, other threads steal from the top */
+template <typename T>
+class WorkStealingDeque
+{
+public:
+    enum { CAPACITY = 4096 };
+
+    WorkStealingDeque()
+    : top(0)
+    , bottom(0)
+    {
+        for (int i = 0; i < CAPACITY; i++)
+            items[i].store(NULL, std::memory_order_relaxed);
+    }
+
+    /** Owner only. Returns false if the deque is full. */
+    bool push(T* item) {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_acquire);
+        if (b - t >= CAPACITY) return false;
+        items[b & (CAPACITY - 1)].store(item, std::memory_order_relaxed);
+        // publishes the item to the thieves that acquire bottom
+        bottom.store(b + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Owner only, takes the most recently pushed item */
+    T* pop() {
+        int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return NULL;
+        }
+
+        T* item = items[b & (CAPACITY - 1)].load(std::memory_order_relaxed);
+        if (t == b) {
+            // the last item, race the thieves for it
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) item = NULL;
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    /** Any thread, takes the oldest item */
+    T* steal() {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b) return NULL;
+
+        T* item = items[t & (CAPACITY - 1)].load(std::memory_order_relaxed);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) return NULL;
+        return item;
+    }
+
+private:
+    std::atomic<int64_t> top;
+    char padding0[GDX_CPP_CACHE_LINE_SIZE];
+    std::atomic<int64_t> bottom;
+    char padding1[GDX_CPP_CACHE_LINE_SIZE];
+    std::atomic<T*> items[CAPACITY];
+};
+
+uint64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+class JobSystem::Job
+{
+public:
+    Job(const Function& function, Job* parent)
+    : function(function)
+    , parent(parent)
+    , unfinished(1)
+    {
+    }
+
+    Function function;
+    Job* parent;
+    /** the job itself plus its unfinished children */
+    std::atomic<int> unfinished;
+};
+
+struct JobSystem::Worker
+{
+    Worker(int index)
+    : index(index)
+    , randomState(index * 0x9E3779B9u + 1)
+    {
+        reset();
+    }
+
+    void reset() {
+        jobsExecuted.store(0, std::memory_order_relaxed);
+        jobsStolen.store(0, std::memory_order_relaxed);
+        busyTime.store(0, std::memory_order_relaxed);
+        idleTime.store(0, std::memory_order_relaxed);
+    }
+
+    /** xorshift, picks where to start looking for work to steal */
+    uint32_t nextRandom() {
+        randomState ^= randomState << 13;
+        randomState ^= randomState >> 17;
+        randomState ^= randomState << 5;
+        return randomState;
+    }
+
+    int index;
+    WorkStealingDeque<Job> deque;
+    uint32_t randomState;
+
+    // only written by the worker's own thread
+    std::atomic<uint64_t> jobsExecuted;
+    std::atomic<uint64_t> jobsStolen;
+    std::atomic<uint64_t> busyTime;
+    std::atomic<uint64_t> idleTime;
+    char padding[GDX_CPP_CACHE_LINE_SIZE];
+};
+
+class JobSystem::WorkerRunnable final : public Runnable
+{
+public:
+    WorkerRunnable(JobSystem* system, Worker* worker)
+    : system(system)
+    , worker(worker)
+    {
+    }
+
+    void run() {
+        system->workerLoop(worker);
+    }
+
+    void onRunnableStop() {
+    }
+
+private:
+    JobSystem* system;
+    Worker* worker;
+};
+
+static thread_local const JobSystem* currentSystem = NULL;
+static thread_local void* currentThreadWorker = NULL;
+
+JobSystem::JobSystem(ThreadFactory* factory, int workerCount)
+: injected(1024)
+, pendingJobs(0)
+, sleepingWorkers(0)
+, running(true)
+{
+    if (workerCount < 0) throw std::runtime_error("workerCount must be >= 0");
+
+    for (int i = 0; i <= workerCount; i++)
+        workers.push_back(new Worker(i));
+
+    currentSystem = this;
+    currentThreadWorker = workers[0];
+
+    for (int i = 1; i <= workerCount; i++) {
+        WorkerRunnable* runnable = new WorkerRunnable(this, workers[i]);
+        runnables.push_back(runnable);
+        threads.push_back(factory->createThread(runnable));
+        threads.back()->start();
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        running.store(false);
+        wakeUp.notify_all();
+    }
+
+    for (size_t i = 0; i < threads.size(); i++)
+        threads[i]->join();
+    threads.clear();
+
+    for (size_t i = 0; i < runnables.size(); i++)
+        delete runnables[i];
+    for (size_t i = 0; i < workers.size(); i++)
+        delete workers[i];
+
+    if (currentSystem == this) {
+        currentSystem = NULL;
+        currentThreadWorker = NULL;
+    }
+}
+
+JobSystem::Job* JobSystem::create(const Function& function, Job* parent) {
+    if (parent != NULL) parent->unfinished.fetch_add(1, std::memory_order_relaxed);
+    return new Job(function, parent);
+}
+
+void JobSystem::run(Job* job) {
+    Worker* worker = currentWorker();
+
+    pendingJobs.fetch_add(1);
+    bool queued = worker != NULL ? worker->deque.push(job) : injected.put(job);
+    if (!queued) {
+        // no room left, run it right away rather than block
+        pendingJobs.fetch_sub(1);
+        execute(job, worker);
+        return;
+    }
+
+    if (sleepingWorkers.load() > 0) {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        wakeUp.notify_one();
+    }
+}
+
+void JobSystem::wait(Job* job) {
+    Worker* worker = currentWorker();
+
+    while (job->unfinished.load(std::memory_order_acquire) > 0) {
+        Job* next = findJob(worker);
+        if (next != NULL) {
+            execute(next, worker);
+        } else {
+            uint64_t start = now();
+            std::this_thread::yield();
+            if (worker != NULL) worker->idleTime.fetch_add(now() - start, std::memory_order_relaxed);
+        }
+    }
+
+    delete job;
+}
+
+void JobSystem::parallelFor(int begin, int end, int grainSize, const RangeFunction& function) {
+    int count = end - begin;
+    if (count <= 0) return;
+
+    if (grainSize <= 0) {
+        int ranges = getThreadCount() * 4;
+        grainSize = (count + ranges - 1) / ranges;
+    }
+
+    if (count <= grainSize || workers.size() == 1) {
+        function(begin, end);
+        return;
+    }
+
+    Job* root = create(Function([] () {}));
+    for (int start = begin; start < end;) {
+        int stop = start + (end - start < grainSize ? end - start : grainSize);
+        run(create([&function, start, stop] () { function(start, stop); }, root));
+        start = stop;
+    }
+    run(root);
+    wait(root);
+}
+
+int JobSystem::getThreadCount() const {
+    return (int) workers.size();
+}
+
+JobSystem::WorkerStats JobSystem::getStats(int thread) const {
+    const Worker* worker = workers.at(thread);
+    WorkerStats stats;
+    stats.jobsExecuted = worker->jobsExecuted.load(std::memory_order_relaxed);
+    stats.jobsStolen = worker->jobsStolen.load(std::memory_order_relaxed);
+    stats.busyTime = worker->busyTime.load(std::memory_order_relaxed);
+    stats.idleTime = worker->idleTime.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void JobSystem::resetStats() {
+    for (size_t i = 0; i < workers.size(); i++)
+        workers[i]->reset();
+}
+
+JobSystem::Worker* JobSystem::currentWorker() const {
+    return currentSystem == this ? static_cast<Worker*>(currentThreadWorker) : NULL;
+}
+
+JobSystem::Job* JobSystem::findJob(Worker* worker) {
+    Job* job = worker != NULL ? worker->deque.pop() : NULL;
+
+    if (job == NULL && !injected.poll(job)) job = NULL;
+
+    if (job == NULL) {
+        int count = (int) workers.size();
+        int start = worker != NULL ? (int) (worker->nextRandom() % count) : 0;
+        for (int i = 0; i < count && job == NULL; i++) {
+            Worker* victim = workers[(start + i) % count];
+            if (victim == worker) continue;
+            job = victim->deque.steal();
+            if (job != NULL && worker != NULL) worker->jobsStolen.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    if (job != NULL) pendingJobs.fetch_sub(1, std::memory_order_relaxed);
+    return job;
+}
+
+void JobSystem::execute(Job* job, Worker* worker) {
+    uint64_t start = now();
+    job->function();
+    finish(job);
+
+    if (worker != NULL) {
+        worker->busyTime.fetch_add(now() - start, std::memory_order_relaxed);
+        worker->jobsExecuted.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void JobSystem::finish(Job* job) {
+    // once the count drops to zero a waiting thread may release a root job, so read the parent first
+    Job* parent = job->parent;
+    if (job->unfinished.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+    if (parent != NULL) {
+        delete job;
+        finish(parent);
+    }
+}
+
+void JobSystem::workerLoop(Worker* worker) {
+    currentSystem = this;
+    currentThreadWorker = worker;
+
+    int spins = 0;
+    uint64_t idleStart = now();
+    while (running.load(std::memory_order_acquire)) {
+        Job* job = findJob(worker);
+        if (job != NULL) {
+            worker->idleTime.fetch_add(now() - idleStart, std::memory_order_relaxed);
+            execute(job, worker);
+            spins = 0;
+            idleStart = now();
+        } else if (++spins < 64) {
+            std::this_thread::yield();
+        } else {
+            sleep();
+            spins = 0;
+        }
+    }
+    worker->idleTime.fetch_add(now() - idleStart, std::memory_order_relaxed);
+}
+
+void JobSystem::sleep() {
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    // paired with run(): either it sees this worker sleeping, or this sees its job pending
+    sleepingWorkers.fetch_add(1);
+    while (running.load() && pendingJobs.load() <= 0)
+        wakeUp.wait(lock);
+    sleepingWorkers.fetch_sub(1);
+}
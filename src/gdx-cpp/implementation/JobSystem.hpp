@@ -0,0 +1,115 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef GDX_CPP_IMPLEMENTATION_JOBSYSTEM_HPP
+#define GDX_CPP_IMPLEMENTATION_JOBSYSTEM_HPP
+
+#include "Thread.hpp"
+#include "gdx-cpp/utils/MpmcQueue.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <stdint.h>
+#include <vector>
+
+namespace gdx_cpp {
+
+namespace implementation {
+
+class ThreadFactory;
+
+/** A work-stealing job scheduler.
+ *
+ * Every worker thread, and the thread that created the JobSystem, owns a deque of jobs: it pushes and pops at one end
+ * while idle workers steal from the other, so work spreads without a central queue. Jobs run() from any other thread go
+ * through a shared queue. A job finishes when its function and all of its children are done; wait() keeps the calling
+ * thread executing jobs until then instead of blocking, so jobs may create and wait for other jobs.
+ *
+ * Jobs created without a parent must be waited for exactly once, which releases them; child jobs are released when they
+ * finish. Children have to be created before their parent finishes, i.e. by the parent's function or before the parent
+ * is run. */
+class JobSystem
+{
+public:
+    class Job;
+    typedef std::function<void ()> Function;
+    typedef std::function<void (int begin, int end)> RangeFunction;
+
+    /** Time is in nanoseconds. Idle time includes looking for work to steal. */
+    struct WorkerStats {
+        uint64_t jobsExecuted;
+        uint64_t jobsStolen;
+        uint64_t busyTime;
+        uint64_t idleTime;
+    };
+
+    /** Starts workerCount threads from the factory. The calling thread also executes jobs while it waits. */
+    JobSystem(ThreadFactory* factory, int workerCount);
+    /** Stops and joins the workers. Jobs still queued are not executed. */
+    ~JobSystem();
+
+    /** Creates a job; if parent is given, the parent doesn't finish before it */
+    Job* create(const Function& function, Job* parent = NULL);
+    /** Queues the job for execution */
+    void run(Job* job);
+    /** Executes other jobs until the job and its children are finished, then releases it */
+    void wait(Job* job);
+
+    /** Calls function on consecutive subranges of [begin, end) of at most grainSize elements in parallel and waits for
+     * all of them. A grainSize of 0 picks one that gives each thread a few ranges to balance. */
+    void parallelFor(int begin, int end, int grainSize, const RangeFunction& function);
+
+    /** The number of threads executing jobs: the workers and the thread that created the JobSystem */
+    int getThreadCount() const;
+    /** Stats of thread 0, the creating thread, up to getThreadCount() - 1. Only accurate while no jobs run. */
+    WorkerStats getStats(int thread) const;
+    void resetStats();
+
+private:
+    struct Worker;
+    class WorkerRunnable;
+
+    JobSystem(const JobSystem&);
+    JobSystem& operator=(const JobSystem&);
+
+    Job* findJob(Worker* worker);
+    void execute(Job* job, Worker* worker);
+    void finish(Job* job);
+    Worker* currentWorker() const;
+    void workerLoop(Worker* worker);
+    void sleep();
+
+    std::vector<Worker*> workers;
+    std::vector<Thread::ptr> threads;
+    std::vector<WorkerRunnable*> runnables;
+    /** jobs run from threads that have no deque */
+    utils::MpmcQueue<Job*> injected;
+
+    /** jobs queued but not yet taken by a thread, lets idle workers decide to sleep */
+    std::atomic<int> pendingJobs;
+    std::atomic<int> sleepingWorkers;
+    std::atomic<bool> running;
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+};
+
+}
+
+}
+
+#endif // GDX_CPP_IMPLEMENTATION_JOBSYSTEM_HPP
@@ -1,40 +0,0 @@
-/*
-    Copyright 2011 <copyright holder> <email>
-
-    Licensed under the Apache License, Version 2.0 (the "License");
-    you may not use this file except in compliance with the License.
-    You may obtain a copy of the License at
-
-        http://www.apache.org/licenses/LICENSE-2.0
-
-    Unless required by applicable law or agreed to in writing, software
-    distributed under the License is distributed on an "AS IS" BASIS,
-    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
-    See the License for the specific language governing permissions and
-    limitations under the License.
-*/
-
-
-#ifndef GDX_CPP_IMPLEMENTATION_MUTEX_HPP
-#define GDX_CPP_IMPLEMENTATION_MUTEX_HPP
-
-#include "gdx-cpp/utils/Aliases.hpp"
-
-namespace gdx_cpp {
-
-namespace implementation {
-
-class Mutex
-{
-public:
-    typedef ref_ptr_maker<Mutex>::type ptr;
-    
-    virtual void lock() = 0;
-    virtual void unlock() = 0;
-};
-
-}
-
-}
-
-#endif // GDX_CPP_IMPLEMENTATION_MUTEX_HPP
@@ -1,4 +1,7 @@
 #include <gdx-cpp/implementation/System.hpp>
+#include <gdx-cpp/implementation/JobSystem.hpp>
+
+#include <thread>
 
 using namespace gdx_cpp::implementation;
 
@@ -13,3 +16,26 @@ const int System::ACCESS_READ    = 0x04;
 const int System::ACCESS_WRITE   = 0x02;
 const int System::ACCESS_EXECUTE = 0x01;
 
+System::System()
+: jobSystem(NULL)
+{
+}
+
+System::~System()
+{
+    delete jobSystem;
+}
+
+int System::getProcessorCount()
+{
+    int count = (int) std::thread::hardware_concurrency();
+    return count > 0 ? count : 1;
+}
+
+JobSystem* System::getJobSystem()
+{
+    gdx_cpp::utils::callOnce(jobSystemCreated, [this] () {
+        jobSystem = new JobSystem(getThreadFactory(), getProcessorCount() - 1);
+    });
+    return jobSystem;
+}
@@ -20,17 +20,21 @@
 
 #include <sys/types.h>
 #include <gdx-cpp/files/File.hpp>
-#include "MutexFactory.hpp"
 #include "ThreadFactory.hpp"
+#include <gdx-cpp/utils/Mutex.hpp>
 #include <stdint.h>
 
 namespace gdx_cpp {
 
 namespace implementation {
 
+class JobSystem;
+
 class System
 {
 public:
+    System();
+    virtual ~System();
 
   /* -- Attribute accessors -- */
 
@@ -91,8 +95,17 @@ public:
     virtual bool createDirectory(const gdx_cpp::files::File &f) = 0;
     virtual bool rename(gdx_cpp::files::File &f1, const gdx_cpp::files::File &f2) = 0;
     virtual uint64_t nanoTime() = 0;
-    virtual MutexFactory* getMutexFactory() = 0;
     virtual ThreadFactory* getThreadFactory() = 0;
+
+    /** The number of hardware threads, at least 1 */
+    virtual int getProcessorCount();
+    /** The engine's job system, created on first use with a worker for each processor but the one of the calling
+     * thread, which should be the main loop's */
+    JobSystem* getJobSystem();
+
+private:
+    JobSystem* jobSystem;
+    utils::OnceFlag jobSystemCreated;
 };
 
 }
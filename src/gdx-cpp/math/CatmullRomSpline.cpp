@@ -20,71 +20,66 @@
 
 #include "CatmullRomSpline.hpp"
 
-using namespace gdx_cpp::math;
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
 
-gdx_cpp::math::CatmullRomSpline::CatmullRomSpline()
-{
-}
+using namespace gdx_cpp::math;
 
-void CatmullRomSpline::add (const Vector3& point) {
-    controlPoints.push_back(point);
+/** Point on the segment from controlPoints[segment + 1] to controlPoints[segment + 2] */
+static inline void hermite (const std::vector<Vector3>& controlPoints, int segment, float t, Vector3& out) {
+    const Vector3& p0 = controlPoints[segment];
+    const Vector3& p1 = controlPoints[segment + 1];
+    const Vector3& p2 = controlPoints[segment + 2];
+    const Vector3& p3 = controlPoints[segment + 3];
+
+    float t2 = t * t, t3 = t2 * t;
+    float h1 = 2 * t3 - 3 * t2 + 1;
+    float h2 = -2 * t3 + 3 * t2;
+    // the tangents (p2 - p0) / 2 and (p3 - p1) / 2 are folded into the weights
+    float h3 = (t3 - 2 * t2 + t) * 0.5f;
+    float h4 = (t3 - t2) * 0.5f;
+
+    out.x = h1 * p1.x + h2 * p2.x + h3 * (p2.x - p0.x) + h4 * (p3.x - p1.x);
+    out.y = h1 * p1.y + h2 * p2.y + h3 * (p2.y - p0.y) + h4 * (p3.y - p1.y);
+    out.z = h1 * p1.z + h2 * p2.z + h3 * (p2.z - p0.z) + h4 * (p3.z - p1.z);
 }
 
-std::vector<Vector3>& CatmullRomSpline::getControlPoints () {
-    return controlPoints;
+static inline void hermiteDerivative (const std::vector<Vector3>& controlPoints, int segment, float t, Vector3& out) {
+    const Vector3& p0 = controlPoints[segment];
+    const Vector3& p1 = controlPoints[segment + 1];
+    const Vector3& p2 = controlPoints[segment + 2];
+    const Vector3& p3 = controlPoints[segment + 3];
+
+    float t2 = t * t;
+    float h1 = 6 * t2 - 6 * t;
+    float h2 = -6 * t2 + 6 * t;
+    float h3 = (3 * t2 - 4 * t + 1) * 0.5f;
+    float h4 = (3 * t2 - 2 * t) * 0.5f;
+
+    out.x = h1 * p1.x + h2 * p2.x + h3 * (p2.x - p0.x) + h4 * (p3.x - p1.x);
+    out.y = h1 * p1.y + h2 * p2.y + h3 * (p2.y - p0.y) + h4 * (p3.y - p1.y);
+    out.z = h1 * p1.z + h2 * p2.z + h3 * (p2.z - p0.z) + h4 * (p3.z - p1.z);
 }
 
-CatmullRomSpline::vector3_vector_ptr CatmullRomSpline::getPath (int numPoints) {
-    vector3_vector_ptr points = vector3_vector_ptr (new std::vector<Vector3>());
-
-    if (controlPoints.size() < 4) return points;
-
-    Vector3 T1;
-    Vector3 T2;
-
-    for (unsigned int i = 1; i <= controlPoints.size() - 3; i++) {
-        points->push_back(controlPoints[i]);
-        float increment = 1.0f / (numPoints + 1);
-        float t = increment;
-
-        T1.set(controlPoints[i + 1].sub(controlPoints[i - 1])).mul(0.5f);
-        T2.set(controlPoints[i + 2].sub(controlPoints[i])).mul(0.5f);
-
-        for (int j = 0; j < numPoints; j++) {
-            float h1 = 2 * t * t * t - 3 * t * t + 1; // calculate basis
-            // function 1
-            float h2 = -2 * t * t * t + 3 * t * t; // calculate basis
-            // function 2
-            float h3 = t * t * t - 2 * t * t + t; // calculate basis
-            // function 3
-            float h4 = t * t * t - t * t; // calculate basis function 4
-
-            Vector3 point(controlPoints[i]);
-            point.mul(h1);
-            point.add(controlPoints[i + 1].tmp().mul(h2));
-            point.add(T1.tmp().mul(h3));
-            point.add(T2.tmp().mul(h4));
-            points->push_back(point);
-            t += increment;
-        }
+/** Shared by the std::vector and frame arena forms */
+template < class Points >
+static void computePath (const std::vector<Vector3>& controlPoints, Points& points, int numPoints) {
+    if (controlPoints.size() < 4) {
+        points.clear();
+        return;
     }
 
-    if (controlPoints.size() >= 4) points->push_back(controlPoints[controlPoints.size() - 2]);
-
-    return points;
-}
-
-void CatmullRomSpline::getPath (std::vector<Vector3>& points, int numPoints) {
+    points.resize((controlPoints.size() - 3) * (numPoints + 1) + 1);
     int idx = 0;
-    if (controlPoints.size() < 4) return;
 
     for (unsigned int i = 1; i <= controlPoints.size() - 3; i++) {
         points[idx++] = controlPoints[i];
         float increment = 1.0f / (numPoints + 1);
         float t = increment;
 
-        T1.set(controlPoints[i + 1]).sub(controlPoints[i - 1]).mul(0.5f);
-        T2.set(controlPoints[i + 2]).sub(controlPoints[i]).mul(0.5f);
+        Vector3 T1 = Vector3(controlPoints[i + 1]).sub(controlPoints[i - 1]).mul(0.5f);
+        Vector3 T2 = Vector3(controlPoints[i + 2]).sub(controlPoints[i]).mul(0.5f);
 
         for (int j = 0; j < numPoints; j++) {
             float h1 = 2 * t * t * t - 3 * t * t + 1; // calculate basis
@@ -95,10 +90,10 @@ void CatmullRomSpline::getPath (std::vector<Vector3>& points, int numPoints) {
             // function 3
             float h4 = t * t * t - t * t; // calculate basis function 4
 
-            Vector3 point = points[idx++].set(controlPoints[i]).mul(h1);
-            point.add(controlPoints[i + 1].tmp().mul(h2));
-            point.add(T1.tmp().mul(h3));
-            point.add(T2.tmp().mul(h4));
+            Vector3& point = points[idx++].set(controlPoints[i]).mul(h1);
+            point.add(Vector3(controlPoints[i + 1]).mul(h2));
+            point.add(Vector3(T1).mul(h3));
+            point.add(Vector3(T2).mul(h4));
             t += increment;
         }
     }
@@ -106,22 +101,24 @@ void CatmullRomSpline::getPath (std::vector<Vector3>& points, int numPoints) {
     points[idx].set(controlPoints[controlPoints.size() - 2]);
 }
 
-CatmullRomSpline::vector3_vector_ptr CatmullRomSpline::getTangents (int numPoints) {
-    vector3_vector_ptr tangents = vector3_vector_ptr(new std::vector<Vector3>());
-
-    if (controlPoints.size() < 4) return tangents;
+template < class Points >
+static void computeTangents (const std::vector<Vector3>& controlPoints, Points& tangents, int numPoints) {
+    if (controlPoints.size() < 4) {
+        tangents.clear();
+        return;
+    }
 
-    Vector3 T1;
-    Vector3 T2;
+    tangents.resize((controlPoints.size() - 3) * (numPoints + 1) + 1);
+    int idx = 0;
 
     for (unsigned int i = 1; i <= controlPoints.size() - 3; i++) {
         float increment = 1.0f / (numPoints + 1);
         float t = increment;
 
-        T1.set(controlPoints[i + 1]).sub(controlPoints[i - 1]).mul(0.5f);
-        T2.set(controlPoints[i + 2]).sub(controlPoints[i]).mul(0.5f);
+        Vector3 T1 = Vector3(controlPoints[i + 1]).sub(controlPoints[i - 1]).mul(0.5f);
+        Vector3 T2 = Vector3(controlPoints[i + 2]).sub(controlPoints[i]).mul(0.5f);
 
-        tangents->push_back(Vector3(T1).nor());
+        tangents[idx++].set(T1).nor();
 
         for (int j = 0; j < numPoints; j++) {
             float h1 = 6 * t * t - 6 * t; // calculate basis function 1
@@ -129,43 +126,93 @@ CatmullRomSpline::vector3_vector_ptr CatmullRomSpline::getTangents (int numPoint
             float h3 = 3 * t * t - 4 * t + 1; // calculate basis function 3
             float h4 = 3 * t * t - 2 * t; // calculate basis function 4
 
-            Vector3 point(controlPoints[i]);
-            point.mul(h1);
-            point.add(controlPoints[i + 1].tmp().mul(h2));
-            point.add(T1.tmp().mul(h3));
-            point.add(T2.tmp().mul(h4));
-            tangents->push_back(point.nor());
+            Vector3& point = tangents[idx++].set(controlPoints[i]).mul(h1);
+            point.add(Vector3(controlPoints[i + 1]).mul(h2));
+            point.add(Vector3(T1).mul(h3));
+            point.add(Vector3(T2).mul(h4));
+            point.nor();
             t += increment;
         }
     }
 
-    if (controlPoints.size() >= 4)
-        tangents->push_back(T1.set(controlPoints[controlPoints.size() - 1]).sub(controlPoints[controlPoints.size() - 3])
-                            .mul(0.5f).cpy().nor());
+    tangents[idx].set(controlPoints[controlPoints.size() - 1]).sub(controlPoints[controlPoints.size() - 3]).mul(0.5f).nor();
+}
+
+gdx_cpp::math::CatmullRomSpline::CatmullRomSpline()
+: samplesPerSegment(DEFAULT_ARC_LENGTH_SAMPLES)
+{
+}
 
+void CatmullRomSpline::add (const Vector3& point) {
+    controlPoints.push_back(point);
+    arcLengths.clear();
+}
+
+std::vector<Vector3>& CatmullRomSpline::getControlPoints () {
+    return controlPoints;
+}
+
+std::vector<Vector3> CatmullRomSpline::getPath (int numPoints) const {
+    std::vector<Vector3> points;
+    getPath(points, numPoints);
+    return points;
+}
+
+void CatmullRomSpline::getPath (std::vector<Vector3>& points, int numPoints) const {
+    computePath(controlPoints, points, numPoints);
+}
+
+gdx_cpp::utils::ArenaVector<Vector3> CatmullRomSpline::getPath (int numPoints,
+                                                                gdx_cpp::utils::LinearAllocator& arena) const {
+    gdx_cpp::utils::ArenaVector<Vector3> points(arena);
+    computePath(controlPoints, points, numPoints);
+    return points;
+}
+
+std::vector<Vector3> CatmullRomSpline::getTangents (int numPoints) const {
+    std::vector<Vector3> tangents;
+    getTangents(tangents, numPoints);
     return tangents;
 }
 
-CatmullRomSpline::vector3_vector_ptr CatmullRomSpline::getTangentNormals2D (int numPoints) {
-    vector3_vector_ptr tangents = vector3_vector_ptr(new std::vector<Vector3>());
+void CatmullRomSpline::getTangents (std::vector<Vector3>& tangents, int numPoints) const {
+    computeTangents(controlPoints, tangents, numPoints);
+}
+
+gdx_cpp::utils::ArenaVector<Vector3> CatmullRomSpline::getTangents (int numPoints,
+                                                                    gdx_cpp::utils::LinearAllocator& arena) const {
+    gdx_cpp::utils::ArenaVector<Vector3> tangents(arena);
+    computeTangents(controlPoints, tangents, numPoints);
+    return tangents;
+}
 
-    if (controlPoints.size() < 4) return tangents;
 
-    Vector3 T1;
-    Vector3 T2;
+std::vector<Vector3> CatmullRomSpline::getTangentNormals2D (int numPoints) const {
+    std::vector<Vector3> normals;
+    getTangentNormals2D(normals, numPoints);
+    return normals;
+}
+
+void CatmullRomSpline::getTangentNormals2D (std::vector<Vector3>& normals, int numPoints) const {
+    if (controlPoints.size() < 4) {
+        normals.clear();
+        return;
+    }
+
+    normals.resize((controlPoints.size() - 3) * (numPoints + 1));
+    int idx = 0;
 
     for (unsigned int i = 1; i <= controlPoints.size() - 3; i++) {
         float increment = 1.0f / (numPoints + 1);
         float t = increment;
 
-        T1.set(controlPoints[i + 1]).sub(controlPoints[i - 1]).mul(0.5f);
-        T2.set(controlPoints[i + 2]).sub(controlPoints[i]).mul(0.5f);
+        Vector3 T1 = Vector3(controlPoints[i + 1]).sub(controlPoints[i - 1]).mul(0.5f);
+        Vector3 T2 = Vector3(controlPoints[i + 2]).sub(controlPoints[i]).mul(0.5f);
 
-        Vector3 normal = Vector3(T1).nor();
+        Vector3& normal = normals[idx++].set(T1).nor();
         float x = normal.x;
         normal.x = normal.y;
         normal.y = -x;
-        tangents->push_back(normal);
 
         for (int j = 0; j < numPoints; j++) {
             float h1 = 6 * t * t - 6 * t; // calculate basis function 1
@@ -173,48 +220,132 @@ CatmullRomSpline::vector3_vector_ptr CatmullRomSpline::getTangentNormals2D (int
             float h3 = 3 * t * t - 4 * t + 1; // calculate basis function 3
             float h4 = 3 * t * t - 2 * t; // calculate basis function 4
 
-            Vector3 point(controlPoints[i]);
-            point.mul(h1);
-            point.add(controlPoints[i + 1].tmp().mul(h2));
-            point.add(T1.tmp().mul(h3));
-            point.add(T2.tmp().mul(h4));
+            Vector3& point = normals[idx++].set(controlPoints[i]).mul(h1);
+            point.add(Vector3(controlPoints[i + 1]).mul(h2));
+            point.add(Vector3(T1).mul(h3));
+            point.add(Vector3(T2).mul(h4));
             point.nor();
             x = point.x;
             point.x = point.y;
             point.y = -x;
-            tangents->push_back(point);
             t += increment;
         }
     }
-
-    return tangents;
 }
 
-CatmullRomSpline::vector3_vector_ptr CatmullRomSpline::getTangentNormals (int numPoints,const Vector3& up) {
-    vector3_vector_ptr tangents = getTangents(numPoints);
-    vector3_vector_ptr normals = vector3_vector_ptr(new std::vector<Vector3>());
+std::vector<Vector3> CatmullRomSpline::getTangentNormals (int numPoints, const Vector3& up) const {
+    std::vector<Vector3> normals;
+    getTangentNormals(normals, numPoints, up);
+    return normals;
+}
 
-    vector3_vector_ptr::element_type::iterator it = tangents->begin();
-    vector3_vector_ptr::element_type::iterator end = tangents->end();
+void CatmullRomSpline::getTangentNormals (std::vector<Vector3>& normals, int numPoints, const Vector3& up) const {
+    getTangents(normals, numPoints);
 
-    for (;it != end; ++it)
-        normals->push_back(it->crs(up).nor());
+    for (unsigned int i = 0; i < normals.size(); i++)
+        normals[i].crs(up).nor();
+}
 
+std::vector<Vector3> CatmullRomSpline::getTangentNormals (int numPoints, const std::vector<Vector3>& up) const {
+    std::vector<Vector3> normals;
+    getTangentNormals(normals, numPoints, up);
     return normals;
 }
 
-CatmullRomSpline::vector3_vector_ptr CatmullRomSpline::getTangentNormals (int numPoints, std::vector<Vector3>& up) {
-    vector3_vector_ptr tangents = getTangents(numPoints);
-    vector3_vector_ptr normals = vector3_vector_ptr(new std::vector<Vector3>());
+void CatmullRomSpline::getTangentNormals (std::vector<Vector3>& normals, int numPoints, const std::vector<Vector3>& up) const {
+    getTangents(normals, numPoints);
 
-    vector3_vector_ptr::element_type::iterator it = tangents->begin();
-    vector3_vector_ptr::element_type::iterator end = tangents->end();
+    for (unsigned int i = 0; i < normals.size(); i++)
+        normals[i].crs(up[i]).nor();
+}
+
+void CatmullRomSpline::updateArcLengths (int samplesPerSegment) {
+    this->samplesPerSegment = std::max(1, samplesPerSegment);
+    arcLengths.clear();
+    if (controlPoints.size() < 4) return;
 
-    int i = 0;
-    for (;it != end; ++it) {
-        normals->push_back(it->crs(up[i++]).nor());
+    int segments = controlPoints.size() - 3;
+    arcLengths.resize(segments * this->samplesPerSegment + 1);
+    arcLengths[0] = 0;
+
+    Vector3 previous = controlPoints[1];
+    Vector3 point;
+    float length = 0;
+    int idx = 1;
+    for (int segment = 0; segment < segments; segment++) {
+        for (int k = 1; k <= this->samplesPerSegment; k++) {
+            hermite(controlPoints, segment, (float) k / this->samplesPerSegment, point);
+            length += point.dst(previous);
+            arcLengths[idx++] = length;
+            previous = point;
+        }
     }
+}
 
-    return normals;
+float CatmullRomSpline::getLength () const {
+    return arcLengths.empty() ? 0 : arcLengths.back();
 }
 
+int CatmullRomSpline::locate (float distance, int hint, int& segment, float& t) const {
+    // checked in release builds too, arcLengths[last] below would read out of bounds
+    if (arcLengths.empty())
+        throw std::runtime_error("updateArcLengths has to be called on a spline with at least 4 control points before "
+                                 "querying by distance");
+
+    int last = arcLengths.size() - 1;
+    if (distance <= 0) {
+        segment = 0;
+        t = 0;
+        return 0;
+    }
+    if (distance >= arcLengths[last]) {
+        segment = last / samplesPerSegment - 1;
+        t = 1;
+        return last - 1;
+    }
+
+    int k = -1;
+    if (hint >= 0 && hint < last && arcLengths[hint] <= distance) {
+        // nearby entries are found by walking, far ones fall back to the binary search
+        for (int steps = 0; steps < 8; steps++, hint++) {
+            if (arcLengths[hint + 1] > distance) {
+                k = hint;
+                break;
+            }
+        }
+    }
+    if (k == -1) k = std::upper_bound(arcLengths.begin(), arcLengths.end(), distance) - arcLengths.begin() - 1;
+
+    float span = arcLengths[k + 1] - arcLengths[k];
+    float fraction = span > 0 ? (distance - arcLengths[k]) / span : 0;
+    segment = k / samplesPerSegment;
+    t = (k - segment * samplesPerSegment + fraction) / samplesPerSegment;
+    return k;
+}
+
+Vector3& CatmullRomSpline::valueAt (Vector3& out, float distance) const {
+    int segment;
+    float t;
+    locate(distance, -1, segment, t);
+    hermite(controlPoints, segment, t, out);
+    return out;
+}
+
+Vector3& CatmullRomSpline::derivativeAt (Vector3& out, float distance) const {
+    int segment;
+    float t;
+    locate(distance, -1, segment, t);
+    hermiteDerivative(controlPoints, segment, t, out);
+    return out;
+}
+
+void CatmullRomSpline::valuesAt (const float* distances, int count, Vector3* points, Vector3* derivatives) const {
+    int hint = 0;
+    for (int i = 0; i < count; i++) {
+        int segment;
+        float t;
+        hint = locate(distances[i], hint, segment, t);
+        hermite(controlPoints, segment, t, points[i]);
+        if (derivatives != NULL) hermiteDerivative(controlPoints, segment, t, derivatives[i]);
+    }
+}
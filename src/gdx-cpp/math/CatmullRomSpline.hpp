@@ -21,37 +21,72 @@
 #ifndef GDX_CPP_MATH_CATMULLROMSPLINE_HPP_
 #define GDX_CPP_MATH_CATMULLROMSPLINE_HPP_
 
+#include <cstddef>
 #include <vector>
 #include "Vector3.hpp"
-#include "gdx-cpp/utils/Aliases.hpp"
+#include "gdx-cpp/utils/LinearAllocator.hpp"
 
 namespace gdx_cpp {
 namespace math {
 
 class Vector3;
-  
+
+/** The out-parameter forms resize the given vector and overwrite its contents, so a vector kept around between calls
+ * is reused without allocating, and the arena forms build their result as a frame temporary. None of the const methods
+ * touch shared state, concurrent readers are safe.
+ *
+ * The spline runs from the second to the second to last control point. For constant speed movement along it call
+ * {@link #updateArcLengths} once after the control points are set up and query by distance with {@link #valueAt} and
+ * {@link #derivativeAt}; the table is dropped by {@link #add} and has to be rebuilt when the control points are
+ * edited through {@link #getControlPoints}. */
 class CatmullRomSpline {
 public:
     CatmullRomSpline();
 
-    typedef ref_ptr_maker< std::vector<Vector3> >::type vector3_vector_ptr;
-    
     void add (const Vector3& point);
     std::vector<Vector3>& getControlPoints ();
-    vector3_vector_ptr getPath (int numPoints);
-    void getPath (std::vector<Vector3>& points, int numPoints);
-    
-    vector3_vector_ptr getTangents (int numPoints);
-    vector3_vector_ptr getTangentNormals2D (int numPoints);
-    vector3_vector_ptr getTangentNormals (int numPoints,const Vector3& up);
-    vector3_vector_ptr getTangentNormals (int numPoints, std::vector<Vector3>& up);
-    
-    Vector3 T1;
-    Vector3 T2;
+    std::vector<Vector3> getPath (int numPoints) const;
+    void getPath (std::vector<Vector3>& points, int numPoints) const;
+    utils::ArenaVector<Vector3> getPath (int numPoints, utils::LinearAllocator& arena) const;
+
+    std::vector<Vector3> getTangents (int numPoints) const;
+    void getTangents (std::vector<Vector3>& tangents, int numPoints) const;
+    utils::ArenaVector<Vector3> getTangents (int numPoints, utils::LinearAllocator& arena) const;
+    std::vector<Vector3> getTangentNormals2D (int numPoints) const;
+    void getTangentNormals2D (std::vector<Vector3>& normals, int numPoints) const;
+    std::vector<Vector3> getTangentNormals (int numPoints, const Vector3& up) const;
+    void getTangentNormals (std::vector<Vector3>& normals, int numPoints, const Vector3& up) const;
+    std::vector<Vector3> getTangentNormals (int numPoints, const std::vector<Vector3>& up) const;
+    void getTangentNormals (std::vector<Vector3>& normals, int numPoints, const std::vector<Vector3>& up) const;
+
+    /** Builds the table mapping distance along the spline to the spline parameter, sampling each segment at
+     * samplesPerSegment evenly spaced parameters. Until there is a table, which takes at least 4 control points, the
+     * queries by distance throw std::runtime_error. */
+    void updateArcLengths (int samplesPerSegment = DEFAULT_ARC_LENGTH_SAMPLES);
+    /** Length of the spline as measured by the last {@link #updateArcLengths} */
+    float getLength () const;
+    /** Point at the given distance from the start, clamped to [0, getLength()] */
+    Vector3& valueAt (Vector3& out, float distance) const;
+    /** Derivative with respect to the spline parameter at the given distance from the start; its direction is the
+     * direction of travel */
+    Vector3& derivativeAt (Vector3& out, float distance) const;
+    /** Evaluates count distances into points, and into derivatives if not NULL. Ascending distances are found by
+     * walking the table instead of searching it. */
+    void valuesAt (const float* distances, int count, Vector3* points, Vector3* derivatives = NULL) const;
+
+    static const int DEFAULT_ARC_LENGTH_SAMPLES = 32;
+
 protected:
 
 private:
+  /** Maps a distance to a segment and the parameter within it, starting the search at hint */
+  int locate (float distance, int hint, int& segment, float& t) const;
+
   std::vector<Vector3> controlPoints;
+  /** Distance from the start at every 1 / samplesPerSegment step of the parameter, segments * samplesPerSegment + 1
+   * entries */
+  std::vector<float> arcLengths;
+  int samplesPerSegment;
 };
 
 } // namespace gdx_cpp
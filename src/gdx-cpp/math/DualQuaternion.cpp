@@ -0,0 +1,164 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "DualQuaternion.hpp"
+#include "Vector3.hpp"
+
+#include <cmath>
+#include <cstddef>
+
+using namespace gdx_cpp::math;
+
+/** dual = 0.5 * (translation, 0) * rotation */
+static inline void dualPart (const float* q, const float* t, float* dual) {
+    dual[0] = 0.5f * (t[0] * q[3] + t[1] * q[2] - t[2] * q[1]);
+    dual[1] = 0.5f * (-t[0] * q[2] + t[1] * q[3] + t[2] * q[0]);
+    dual[2] = 0.5f * (t[0] * q[1] - t[1] * q[0] + t[2] * q[3]);
+    dual[3] = -0.5f * (t[0] * q[0] + t[1] * q[1] + t[2] * q[2]);
+}
+
+/** Applies a normalized dual quaternion to a point, optionally also rotating a normal */
+static inline void transformPoint (const float* real, const float* dual, float* position, float* normal) {
+    float rx = real[0], ry = real[1], rz = real[2], rw = real[3];
+
+    // translation = 2 * (rw * d.xyz - dw * r.xyz + r.xyz x d.xyz)
+    float tx = 2 * (rw * dual[0] - dual[3] * rx + ry * dual[2] - rz * dual[1]);
+    float ty = 2 * (rw * dual[1] - dual[3] * ry + rz * dual[0] - rx * dual[2]);
+    float tz = 2 * (rw * dual[2] - dual[3] * rz + rx * dual[1] - ry * dual[0]);
+
+    // v' = v + 2 * r.xyz x (r.xyz x v + rw * v)
+    float px = position[0], py = position[1], pz = position[2];
+    float cx = ry * pz - rz * py + rw * px;
+    float cy = rz * px - rx * pz + rw * py;
+    float cz = rx * py - ry * px + rw * pz;
+    position[0] = px + 2 * (ry * cz - rz * cy) + tx;
+    position[1] = py + 2 * (rz * cx - rx * cz) + ty;
+    position[2] = pz + 2 * (rx * cy - ry * cx) + tz;
+
+    if (normal != NULL) {
+        float nx = normal[0], ny = normal[1], nz = normal[2];
+        cx = ry * nz - rz * ny + rw * nx;
+        cy = rz * nx - rx * nz + rw * ny;
+        cz = rx * ny - ry * nx + rw * nz;
+        normal[0] = nx + 2 * (ry * cz - rz * cy);
+        normal[1] = ny + 2 * (rz * cx - rx * cz);
+        normal[2] = nz + 2 * (rx * cy - ry * cx);
+    }
+}
+
+DualQuaternion::DualQuaternion ()
+: real(0, 0, 0, 1)
+, dual(0, 0, 0, 0)
+{
+}
+
+DualQuaternion::DualQuaternion (const Quaternion& rotation, const Vector3& translation) {
+    set(rotation, translation);
+}
+
+DualQuaternion& DualQuaternion::set (const Quaternion& rotation, const Vector3& translation) {
+    float q[4] = { rotation.x, rotation.y, rotation.z, rotation.w };
+    float t[3] = { translation.x, translation.y, translation.z };
+    float d[4];
+    dualPart(q, t, d);
+
+    real.set(rotation);
+    dual.set(d[0], d[1], d[2], d[3]);
+    return *this;
+}
+
+DualQuaternion& DualQuaternion::idt () {
+    real.set(0, 0, 0, 1);
+    dual.set(0, 0, 0, 0);
+    return *this;
+}
+
+void DualQuaternion::getTranslation (Vector3& translation) const {
+    float r[4] = { real.x, real.y, real.z, real.w };
+    float d[4] = { dual.x, dual.y, dual.z, dual.w };
+    float p[3] = { 0, 0, 0 };
+    transformPoint(r, d, p, NULL);
+    translation.set(p[0], p[1], p[2]);
+}
+
+void DualQuaternion::transform (Vector3& point) const {
+    float r[4] = { real.x, real.y, real.z, real.w };
+    float d[4] = { dual.x, dual.y, dual.z, dual.w };
+    float p[3] = { point.x, point.y, point.z };
+    transformPoint(r, d, p, NULL);
+    point.set(p[0], p[1], p[2]);
+}
+
+void DualQuaternion::fromRotationTranslation (const float* rotations, int rotationStride, const float* translations,
+                                              int translationStride, float* dualQuaternions, int count) {
+    for (int i = 0; i < count; i++) {
+        const float* q = rotations + i * rotationStride;
+        float* out = dualQuaternions + i * 8;
+        dualPart(q, translations + i * translationStride, out + 4);
+        out[0] = q[0];
+        out[1] = q[1];
+        out[2] = q[2];
+        out[3] = q[3];
+    }
+}
+
+void DualQuaternion::skin (const float* dualQuaternions, const int* joints, const float* weights, int influences,
+                           const float* src, float* dst, int numVertices, int vertexSize, int positionOffset,
+                           int normalOffset) {
+    for (int v = 0; v < numVertices; v++) {
+        const int* vertexJoints = joints + v * influences;
+        const float* vertexWeights = weights + v * influences;
+
+        float blend[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+        const float* pivot = dualQuaternions + vertexJoints[0] * 8;
+        for (int k = 0; k < influences; k++) {
+            float weight = vertexWeights[k];
+            if (weight == 0) continue;
+
+            const float* dq = dualQuaternions + vertexJoints[k] * 8;
+            // keep all joints in the pivot's hemisphere so antipodal rotations don't cancel out
+            if (dq[0] * pivot[0] + dq[1] * pivot[1] + dq[2] * pivot[2] + dq[3] * pivot[3] < 0) weight = -weight;
+            for (int c = 0; c < 8; c++)
+                blend[c] += weight * dq[c];
+        }
+
+        float len = std::sqrt(blend[0] * blend[0] + blend[1] * blend[1] + blend[2] * blend[2] + blend[3] * blend[3]);
+        float invLen = len > 0 ? 1 / len : 0;
+        for (int c = 0; c < 8; c++)
+            blend[c] *= invLen;
+
+        const float* in = src + v * vertexSize;
+        float* out = dst + v * vertexSize;
+        float position[3] = { in[positionOffset], in[positionOffset + 1], in[positionOffset + 2] };
+        float normal[3];
+        if (normalOffset != -1) {
+            normal[0] = in[normalOffset];
+            normal[1] = in[normalOffset + 1];
+            normal[2] = in[normalOffset + 2];
+        }
+
+        transformPoint(blend, blend + 4, position, normalOffset != -1 ? normal : NULL);
+
+        out[positionOffset] = position[0];
+        out[positionOffset + 1] = position[1];
+        out[positionOffset + 2] = position[2];
+        if (normalOffset != -1) {
+            out[normalOffset] = normal[0];
+            out[normalOffset + 1] = normal[1];
+            out[normalOffset + 2] = normal[2];
+        }
+    }
+}
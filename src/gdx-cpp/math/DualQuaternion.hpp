@@ -0,0 +1,65 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef GDX_CPP_MATH_DUALQUATERNION_HPP_
+#define GDX_CPP_MATH_DUALQUATERNION_HPP_
+
+#include "Quaternion.hpp"
+
+namespace gdx_cpp {
+namespace math {
+
+class Vector3;
+
+/** A rigid transformation stored as a unit dual quaternion: the real part is the rotation, the dual part half the
+ * translation times the rotation. Unlike matrices, dual quaternions can be blended linearly without the volume loss
+ * of linear blend skinning at twisting joints.
+ *
+ * The static functions work on arrays of 8 floats per transformation, the real part's x, y, z, w followed by the dual
+ * part's, so a skeleton's joints can be converted and skinned in bulk. */
+class DualQuaternion {
+public:
+    DualQuaternion ();
+    DualQuaternion (const Quaternion& rotation, const Vector3& translation);
+
+    DualQuaternion& set (const Quaternion& rotation, const Vector3& translation);
+    DualQuaternion& idt ();
+    /** Extracts the translation, the rotation is the real part */
+    void getTranslation (Vector3& translation) const;
+    /** Rotates and then translates the point */
+    void transform (Vector3& point) const;
+
+    /** Converts count rotations (x, y, z, w, rotationStride floats apart) and translations (x, y, z,
+     * translationStride floats apart) to packed dual quaternions */
+    static void fromRotationTranslation (const float* rotations, int rotationStride, const float* translations,
+                                         int translationStride, float* dualQuaternions, int count);
+
+    /** Dual quaternion skinning: blends the joints influencing each vertex by weight and transforms the vertex' position,
+     * and its normal if normalOffset is not -1, from src into dst. Vertex v is influenced by the joints
+     * joints[v * influences + k] with the weights weights[v * influences + k], k < influences; weights of unused slots
+     * must be 0. vertexSize and the offsets are in floats, src and dst may be the same array. */
+    static void skin (const float* dualQuaternions, const int* joints, const float* weights, int influences,
+                      const float* src, float* dst, int numVertices, int vertexSize, int positionOffset,
+                      int normalOffset);
+
+    Quaternion real;
+    Quaternion dual;
+};
+
+} // namespace gdx_cpp
+} // namespace math
+
+#endif // GDX_CPP_MATH_DUALQUATERNION_HPP_
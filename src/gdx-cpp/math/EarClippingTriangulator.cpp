@@ -22,223 +22,633 @@
 
 #include <algorithm>
 #include <cmath>
-
-#include "MathUtils.hpp"
+#include <limits>
+#include <stdexcept>
 
 using namespace gdx_cpp::math;
 
-std::vector<Vector2> EarClippingTriangulator::computeTriangles (const std::vector<Vector2>& polygon) {
-    std::vector<Vector2> triangles;
-    std::vector<Vector2> vertices(polygon);
-
-    /*
-     * ESpitz: For the sake of performance, we only need to test for eartips while the polygon has more than three verts. If
-     * there are only three verts left to test, or there were only three verts to begin with, there is no need to continue with
-     * this loop.
-     */
-    while (vertices.size() > 3) {
-        // TODO Usually(Always?) only the Types of the vertices next to the
-        // ear change! --> Improve
-        std::vector<int> vertexTypes = this->classifyVertices(vertices);
-
-        int vertexCount = vertices.size();
-        for (int index = 0; index < vertexCount; index++) {
-            if (this->isEarTip(vertices, index, vertexTypes)) {
-                this->cutEarTip(vertices, index, triangles);
-                break;
-            }
-        }
+struct EarClippingTriangulator::CompareX {
+    CompareX (const std::vector<Node>& nodes) : nodes(nodes) {
     }
 
-    /*
-     * ESpitz: If there are only three verts left to test, or there were only three verts to begin with, we have the final
-     * triangle.
-     */
-    if (vertices.size() == 3) {
-        triangles.insert(triangles.end(), vertices.begin(), vertices.end());
+    bool operator() (int a, int b) const {
+        return nodes[a].x < nodes[b].x;
     }
 
-    return triangles;
-}
-
-bool EarClippingTriangulator::areVerticesClockwise (const std::vector<Vector2>& pVertices) {
-    int vertexCount = pVertices.size();
+    const std::vector<Node>& nodes;
+};
 
-    float area = 0;
-    for (int i = 0; i < vertexCount; i++) {
-        const Vector2& p1 = pVertices[i];
-        const Vector2& p2 = pVertices[EarClippingTriangulator::computeNextIndex(pVertices, i)];
-        area += p1.x * p2.y - p2.x * p1.y;
-    }
+std::vector<Vector2> EarClippingTriangulator::computeTriangles (const std::vector<Vector2>& polygon) {
+    computeTriangles(polygon, indices);
 
-    if (area < 0) {
-        return true;
-    } else {
-        return false;
+    std::vector<Vector2> triangles;
+    triangles.reserve(indices.size());
+    for (unsigned int i = 0; i < indices.size(); i++) {
+        triangles.push_back(polygon[indices[i] & 0xffff]);
     }
+    return triangles;
 }
 
-std::vector<int> EarClippingTriangulator::classifyVertices (std::vector<Vector2>& pVertices) {
-    int vertexCount = pVertices.size();
-
-    std::vector<int> vertexTypes(vertexCount);
-    this->concaveVertexCount = 0;
+gdx_cpp::utils::ArenaVector<Vector2> EarClippingTriangulator::computeTriangles (const std::vector<Vector2>& polygon,
+                                                                                gdx_cpp::utils::LinearAllocator& arena) {
+    computeTriangles(polygon, indices);
 
-    /* Ensure vertices are in clockwise order. */
-    if (!EarClippingTriangulator::areVerticesClockwise(pVertices)) {
-      std::reverse(pVertices.begin(),pVertices.end());
+    gdx_cpp::utils::ArenaVector<Vector2> triangles(arena);
+    triangles.reserve(indices.size());
+    for (unsigned int i = 0; i < indices.size(); i++) {
+        triangles.push_back(polygon[indices[i] & 0xffff]);
     }
+    return triangles;
+}
 
-    for (int index = 0; index < vertexCount; index++) {
-        int previousIndex = EarClippingTriangulator::computePreviousIndex(pVertices, index);
-        int nextIndex = EarClippingTriangulator::computeNextIndex(pVertices, index);
+void EarClippingTriangulator::computeTriangles (const std::vector<Vector2>& polygon, std::vector<short>& triangles) {
+    coordinates.resize(polygon.size() * 2);
+    for (unsigned int i = 0; i < polygon.size(); i++) {
+        coordinates[i * 2] = polygon[i].x;
+        coordinates[i * 2 + 1] = polygon[i].y;
+    }
+    computeTriangles(coordinates.empty() ? NULL : &coordinates[0], polygon.size(), NULL, 0, triangles);
+}
 
-        const Vector2& previousVertex = pVertices[previousIndex];
-        const Vector2& currentVertex = pVertices[index];
-        const Vector2& nextVertex = pVertices[nextIndex];
+gdx_cpp::utils::ArenaVector<short> EarClippingTriangulator::computeTriangles (const float* vertices, int numVertices,
+                                                                              const int* holeIndices, int numHoles,
+                                                                              gdx_cpp::utils::LinearAllocator& arena) {
+    computeTriangles(vertices, numVertices, holeIndices, numHoles, indices);
+    return gdx_cpp::utils::ArenaVector<short>(indices.begin(), indices.end(), arena);
+}
 
-        if (EarClippingTriangulator::isTriangleConvex(previousVertex.x, previousVertex.y, currentVertex.x, currentVertex.y,
-                nextVertex.x, nextVertex.y)) {
-            vertexTypes[index] = CONVEX;
-        } else {
-            vertexTypes[index] = CONCAVE;
-            this->concaveVertexCount++;
+void EarClippingTriangulator::computeTriangles (const float* vertices, int numVertices, const int* holeIndices,
+                                                int numHoles, std::vector<short>& triangles) {
+    triangles.clear();
+    nodes.clear();
+    if (numVertices > 65536) throw std::runtime_error("EarClippingTriangulator supports at most 65536 vertices");
+
+    int outerLength = numHoles > 0 ? holeIndices[0] : numVertices;
+    int outerNode = linkedList(vertices, 0, outerLength, true);
+    if (outerNode == -1 || nodes[outerNode].next == nodes[outerNode].prev) return;
+
+    if (numHoles > 0) outerNode = eliminateHoles(vertices, numVertices, holeIndices, numHoles, outerNode);
+
+    double minX = 0, minY = 0, invSize = 0;
+    if (numVertices > HASH_THRESHOLD) {
+        double maxX = minX = vertices[0];
+        double maxY = minY = vertices[1];
+        for (int i = 1; i < outerLength; i++) {
+            double x = vertices[i * 2], y = vertices[i * 2 + 1];
+            if (x < minX) minX = x;
+            if (y < minY) minY = y;
+            if (x > maxX) maxX = x;
+            if (y > maxY) maxY = y;
         }
+        invSize = std::max(maxX - minX, maxY - minY);
+        invSize = invSize != 0 ? 32767 / invSize : 0;
     }
 
-    return vertexTypes;
+    triangles.reserve((numVertices + numHoles * 2) * 3);
+    earcutLinked(outerNode, triangles, minX, minY, invSize, 0);
 }
 
-bool EarClippingTriangulator::isTriangleConvex (float pX1, float pY1, float pX2, float pY2, float pX3,
-                                                float pY3) {
-    if (EarClippingTriangulator::computeSpannedAreaSign(pX1, pY1, pX2, pY2, pX3, pY3) < 0) {
-        return false;
+/** Builds a ring from the vertices in [start, end) with the given winding */
+int EarClippingTriangulator::linkedList (const float* vertices, int start, int end, bool clockwise) {
+    double sum = 0;
+    for (int i = start, j = end - 1; i < end; j = i++) {
+        sum += ((double) vertices[j * 2] - vertices[i * 2]) * ((double) vertices[i * 2 + 1] + vertices[j * 2 + 1]);
+    }
+
+    int last = -1;
+    if (clockwise == (sum > 0)) {
+        for (int i = start; i < end; i++)
+            last = insertNode(i, vertices[i * 2], vertices[i * 2 + 1], last);
     } else {
-        return true;
+        for (int i = end - 1; i >= start; i--)
+            last = insertNode(i, vertices[i * 2], vertices[i * 2 + 1], last);
     }
-}
 
-int EarClippingTriangulator::computeSpannedAreaSign (float pX1, float pY1, float pX2, float pY2,
-                                                     float pX3, float pY3) {
-    /*
-     * Espitz: using doubles corrects for very rare cases where we run into floating point imprecision in the area test, causing
-     * the method to return a 0 when it should have returned -1 or 1.
-     */
-    float area = 0;
+    if (last != -1 && equals(last, nodes[last].next)) {
+        int next = nodes[last].next;
+        removeNode(last);
+        last = next;
+    }
 
-    area += pX1 * (pY3 - pY2);
-    area += pX2 * (pY1 - pY3);
-    area += pX3 * (pY2 - pY1);
+    return last;
+}
+
+/** Removes duplicate and collinear points */
+int EarClippingTriangulator::filterPoints (int start, int end) {
+    if (start == -1) return start;
+    if (end == -1) end = start;
+
+    int p = start;
+    bool again;
+    do {
+        again = false;
+
+        if (!nodes[p].steiner && (equals(p, nodes[p].next) || area(nodes[p].prev, p, nodes[p].next) == 0)) {
+            removeNode(p);
+            p = end = nodes[p].prev;
+            if (p == nodes[p].next) break;
+            again = true;
+        } else {
+            p = nodes[p].next;
+        }
+    } while (again || p != end);
 
-    return (int) utils::signum(area);
+    return end;
 }
 
-bool EarClippingTriangulator::isAnyVertexInTriangle (std::vector<Vector2>& pVertices, const std::vector<int>& pVertexTypes, float pX1,
-                                                     float pY1, float pX2, float pY2, float pX3, float pY3) {
-    int i = 0;
+void EarClippingTriangulator::earcutLinked (int ear, std::vector<short>& triangles, double minX, double minY,
+                                            double invSize, int pass) {
+    if (ear == -1) return;
 
-    int vertexCount = pVertices.size();
-    while (i < vertexCount - 1) {
-        if ((pVertexTypes[i] == CONCAVE)) {
-            Vector2& currentVertex = pVertices[i];
+    if (pass == 0 && invSize != 0) indexCurve(ear, minX, minY, invSize);
 
-            float currentVertexX = currentVertex.x;
-            float currentVertexY = currentVertex.y;
+    int stop = ear;
+    while (nodes[ear].prev != nodes[ear].next) {
+        int prev = nodes[ear].prev;
+        int next = nodes[ear].next;
 
-            int areaSign1 = EarClippingTriangulator::computeSpannedAreaSign(pX1, pY1, pX2, pY2, currentVertexX,
-                                  currentVertexY);
-            int areaSign2 = EarClippingTriangulator::computeSpannedAreaSign(pX2, pY2, pX3, pY3, currentVertexX,
-                                  currentVertexY);
-            int areaSign3 = EarClippingTriangulator::computeSpannedAreaSign(pX3, pY3, pX1, pY1, currentVertexX,
-                                  currentVertexY);
+        if (invSize != 0 ? isEarHashed(ear, minX, minY, invSize) : isEar(ear)) {
+            triangles.push_back(nodes[prev].i);
+            triangles.push_back(nodes[ear].i);
+            triangles.push_back(nodes[next].i);
 
-            if (areaSign1 > 0 && areaSign2 > 0 && areaSign3 > 0) {
-                return true;
-            } else if (areaSign1 <= 0 && areaSign2 <= 0 && areaSign3 <= 0) {
-                return true;
+            removeNode(ear);
+
+            // skipping the next vertex leads to less sliver triangles
+            ear = stop = nodes[next].next;
+            continue;
+        }
+
+        ear = next;
+
+        // went through the whole ring without finding an ear, try to repair the remaining polygon
+        if (ear == stop) {
+            if (pass == 0) {
+                earcutLinked(filterPoints(ear), triangles, minX, minY, invSize, 1);
+            } else if (pass == 1) {
+                ear = cureLocalIntersections(filterPoints(ear), triangles);
+                earcutLinked(ear, triangles, minX, minY, invSize, 2);
+            } else if (pass == 2) {
+                splitEarcut(ear, triangles, minX, minY, invSize);
             }
+            break;
         }
-        i++;
     }
-    return false;
 }
 
-bool EarClippingTriangulator::isEarTip (std::vector<Vector2>& pVertices, int pEarTipIndex, const std::vector<int>& pVertexTypes) {
-    if (this->concaveVertexCount != 0) {
-        Vector2& previousVertex = pVertices[EarClippingTriangulator::computePreviousIndex(pVertices, pEarTipIndex)];
-        Vector2& currentVertex = pVertices[pEarTipIndex];
-        Vector2& nextVertex = pVertices[EarClippingTriangulator::computeNextIndex(pVertices, pEarTipIndex)];
+bool EarClippingTriangulator::isEar (int ear) const {
+    const Node& a = nodes[nodes[ear].prev];
+    const Node& b = nodes[ear];
+    const Node& c = nodes[b.next];
 
-        if (EarClippingTriangulator::isAnyVertexInTriangle(pVertices, pVertexTypes, previousVertex.x, previousVertex.y,
-                currentVertex.x, currentVertex.y, nextVertex.x, nextVertex.y)) {
+    // reflex, can't be an ear
+    if (area(b.prev, ear, b.next) >= 0) return false;
+
+    for (int p = c.next; p != b.prev; p = nodes[p].next) {
+        const Node& n = nodes[p];
+        if ((c.x - n.x) * (a.y - n.y) >= (a.x - n.x) * (c.y - n.y)
+                && (a.x - n.x) * (b.y - n.y) >= (b.x - n.x) * (a.y - n.y)
+                && (b.x - n.x) * (c.y - n.y) >= (c.x - n.x) * (b.y - n.y)
+                && area(n.prev, p, n.next) >= 0)
             return false;
-        } else {
-            return true;
+    }
+
+    return true;
+}
+
+bool EarClippingTriangulator::isEarHashed (int ear, double minX, double minY, double invSize) const {
+    const Node& a = nodes[nodes[ear].prev];
+    const Node& b = nodes[ear];
+    const Node& c = nodes[b.next];
+
+    if (area(b.prev, ear, b.next) >= 0) return false;
+
+    double minTX = std::min(a.x, std::min(b.x, c.x));
+    double minTY = std::min(a.y, std::min(b.y, c.y));
+    double maxTX = std::max(a.x, std::max(b.x, c.x));
+    double maxTY = std::max(a.y, std::max(b.y, c.y));
+
+    // only points whose z-order code lies within the ear's bounds can be inside it
+    int minZ = zOrder(minTX, minTY, minX, minY, invSize);
+    int maxZ = zOrder(maxTX, maxTY, minX, minY, invSize);
+
+    int p = b.prevZ, n = b.nextZ;
+    while (true) {
+        bool down = p != -1 && nodes[p].z >= minZ;
+        bool up = n != -1 && nodes[n].z <= maxZ;
+        if (!down && !up) break;
+
+        for (int k = 0; k < 2; k++) {
+            if (k == 0 ? !down : !up) continue;
+            int q = k == 0 ? p : n;
+            const Node& m = nodes[q];
+            if (q != b.prev && q != b.next
+                    && (c.x - m.x) * (a.y - m.y) >= (a.x - m.x) * (c.y - m.y)
+                    && (a.x - m.x) * (b.y - m.y) >= (b.x - m.x) * (a.y - m.y)
+                    && (b.x - m.x) * (c.y - m.y) >= (c.x - m.x) * (b.y - m.y)
+                    && area(m.prev, q, m.next) >= 0)
+                return false;
         }
-    } else {
-        return true;
+
+        if (down) p = nodes[p].prevZ;
+        if (up) n = nodes[n].nextZ;
     }
+
+    return true;
 }
 
-void EarClippingTriangulator::cutEarTip (std::vector<Vector2>& pVertices, int pEarTipIndex, std::vector<Vector2>& pTriangles) {
-    int previousIndex = EarClippingTriangulator::computePreviousIndex(pVertices, pEarTipIndex);
-    int nextIndex = EarClippingTriangulator::computeNextIndex(pVertices, pEarTipIndex);
+/** Cuts off the triangles formed by two edges crossing each other, as found in self touching outlines */
+int EarClippingTriangulator::cureLocalIntersections (int start, std::vector<short>& triangles) {
+    int p = start;
+    do {
+        int a = nodes[p].prev;
+        int b = nodes[nodes[p].next].next;
 
-    if (!EarClippingTriangulator::isCollinear(pVertices, previousIndex, pEarTipIndex, nextIndex)) {
-        pTriangles.push_back(pVertices[previousIndex]);
-        pTriangles.push_back(pVertices[pEarTipIndex]);
-        pTriangles.push_back(pVertices[nextIndex]);
+        if (!equals(a, b) && intersects(a, p, nodes[p].next, b) && locallyInside(a, b) && locallyInside(b, a)) {
+            triangles.push_back(nodes[a].i);
+            triangles.push_back(nodes[p].i);
+            triangles.push_back(nodes[b].i);
+
+            int next = nodes[p].next;
+            removeNode(p);
+            removeNode(next);
+
+            p = start = b;
+        }
+        p = nodes[p].next;
+    } while (p != start);
+
+    return filterPoints(p);
+}
+
+/** Splits the polygon in two along a valid diagonal and triangulates both halves */
+void EarClippingTriangulator::splitEarcut (int start, std::vector<short>& triangles, double minX, double minY,
+                                           double invSize) {
+    int a = start;
+    do {
+        int b = nodes[nodes[a].next].next;
+        while (b != nodes[a].prev) {
+            if (nodes[a].i != nodes[b].i && isValidDiagonal(a, b)) {
+                int c = splitPolygon(a, b);
+
+                a = filterPoints(a, nodes[a].next);
+                c = filterPoints(c, nodes[c].next);
+
+                earcutLinked(a, triangles, minX, minY, invSize, 0);
+                earcutLinked(c, triangles, minX, minY, invSize, 0);
+                return;
+            }
+            b = nodes[b].next;
+        }
+        a = nodes[a].next;
+    } while (a != start);
+}
+
+/** Links every hole into the outer ring through a bridge, left to right */
+int EarClippingTriangulator::eliminateHoles (const float* vertices, int numVertices, const int* holeIndices,
+                                             int numHoles, int outerNode) {
+    holeQueue.clear();
+    for (int i = 0; i < numHoles; i++) {
+        int start = holeIndices[i];
+        int end = i < numHoles - 1 ? holeIndices[i + 1] : numVertices;
+        int list = linkedList(vertices, start, end, false);
+        if (list == -1) continue;
+        if (list == nodes[list].next) nodes[list].steiner = true;
+        holeQueue.push_back(getLeftmost(list));
     }
 
-    pVertices.erase(pVertices.begin() + pEarTipIndex);
-    
-    if (pVertices.size() >= 3) {
-        EarClippingTriangulator::removeCollinearNeighborEarsAfterRemovingEarTip(pVertices, pEarTipIndex);
+    std::sort(holeQueue.begin(), holeQueue.end(), CompareX(nodes));
+
+    for (unsigned int i = 0; i < holeQueue.size(); i++) {
+        outerNode = eliminateHole(holeQueue[i], outerNode);
+        outerNode = filterPoints(outerNode, nodes[outerNode].next);
     }
+
+    return outerNode;
 }
 
-void EarClippingTriangulator::removeCollinearNeighborEarsAfterRemovingEarTip (std::vector<Vector2>& pVertices,
-                                                                              int pEarTipCutIndex) {
-    int collinearityCheckNextIndex = pEarTipCutIndex % pVertices.size();
-    int collinearCheckPreviousIndex = EarClippingTriangulator::computePreviousIndex(pVertices, collinearityCheckNextIndex);
+int EarClippingTriangulator::eliminateHole (int hole, int outerNode) {
+    int bridge = findHoleBridge(hole, outerNode);
+    if (bridge == -1) return outerNode;
+
+    int bridgeReverse = splitPolygon(bridge, hole);
+    int filteredBridge = filterPoints(bridge, nodes[bridge].next);
+    filterPoints(bridgeReverse, nodes[bridgeReverse].next);
 
-    if (EarClippingTriangulator::isCollinear(pVertices, collinearityCheckNextIndex)) {
-      pVertices.erase(pVertices.begin() + collinearityCheckNextIndex);
+    return outerNode == bridge ? filteredBridge : outerNode;
+}
 
-        if (pVertices.size() > 3) {
-            /* Update */
-            collinearCheckPreviousIndex = EarClippingTriangulator::computePreviousIndex(pVertices, collinearityCheckNextIndex);
-            if (EarClippingTriangulator::isCollinear(pVertices, collinearCheckPreviousIndex)) {
-              pVertices.erase(pVertices.begin() + collinearCheckPreviousIndex);
+/** David Eberly's algorithm for finding a bridge between a hole and the outer polygon */
+int EarClippingTriangulator::findHoleBridge (int hole, int outerNode) const {
+    int p = outerNode;
+    double hx = nodes[hole].x;
+    double hy = nodes[hole].y;
+    double qx = -std::numeric_limits<double>::max();
+    int m = -1;
+
+    // find a segment intersected by a ray from the hole's leftmost point to the left; the segment's endpoint with
+    // lesser x will be the potential connection point
+    do {
+        const Node& n = nodes[p];
+        const Node& next = nodes[n.next];
+        if (hy <= n.y && hy >= next.y && next.y != n.y) {
+            double x = n.x + (hy - n.y) * (next.x - n.x) / (next.y - n.y);
+            if (x <= hx && x > qx) {
+                qx = x;
+                if (x == hx) {
+                    if (hy == n.y) return p;
+                    if (hy == next.y) return n.next;
+                }
+                m = n.x < next.x ? p : n.next;
             }
         }
-    } else if (EarClippingTriangulator::isCollinear(pVertices, collinearCheckPreviousIndex)) {
-      pVertices.erase(pVertices.begin() + collinearCheckPreviousIndex);
-    }
+        p = n.next;
+    } while (p != outerNode);
+
+    if (m == -1) return -1;
+
+    // hole touches the outer segment
+    if (hx == qx) return m;
+
+    // look for points inside the triangle of the hole point, the segment intersection and the endpoint; if there are
+    // none, the endpoint is a valid connection, otherwise take the point with the minimum angle to the ray
+    int stop = m;
+    double mx = nodes[m].x;
+    double my = nodes[m].y;
+    double tanMin = std::numeric_limits<double>::max();
+
+    double ax = hy < my ? hx : qx, cx = hy < my ? qx : hx;
+    p = m;
+    do {
+        const Node& n = nodes[p];
+        if (hx >= n.x && n.x >= mx && hx != n.x
+                && (cx - n.x) * (hy - n.y) >= (ax - n.x) * (hy - n.y)
+                && (ax - n.x) * (my - n.y) >= (mx - n.x) * (hy - n.y)
+                && (mx - n.x) * (hy - n.y) >= (cx - n.x) * (my - n.y)) {
+            double tan = std::fabs(hy - n.y) / (hx - n.x);
+
+            if (locallyInside(p, hole)
+                    && (tan < tanMin || (tan == tanMin && (n.x > nodes[m].x
+                                                           || (n.x == nodes[m].x && sectorContainsSector(m, p)))))) {
+                m = p;
+                tanMin = tan;
+            }
+        }
+        p = n.next;
+    } while (p != stop);
+
+    return m;
+}
+
+/** Whether the sector in vertex m contains the sector in vertex p in the same coordinates */
+bool EarClippingTriangulator::sectorContainsSector (int m, int p) const {
+    return area(nodes[m].prev, m, nodes[p].prev) < 0 && area(nodes[p].next, m, nodes[m].next) < 0;
+}
+
+/** Computes the z-order of every vertex and links them into a list sorted by it */
+void EarClippingTriangulator::indexCurve (int start, double minX, double minY, double invSize) {
+    int p = start;
+    do {
+        Node& n = nodes[p];
+        if (n.z == -1) n.z = zOrder(n.x, n.y, minX, minY, invSize);
+        n.prevZ = n.prev;
+        n.nextZ = n.next;
+        p = n.next;
+    } while (p != start);
+
+    nodes[nodes[p].prevZ].nextZ = -1;
+    nodes[p].prevZ = -1;
+
+    sortLinked(p);
+}
+
+/** Simon Tatham's linked list merge sort */
+int EarClippingTriangulator::sortLinked (int list) {
+    int inSize = 1;
+    int numMerges;
+
+    do {
+        int p = list;
+        int tail = -1;
+        list = -1;
+        numMerges = 0;
+
+        while (p != -1) {
+            numMerges++;
+            int q = p;
+            int pSize = 0;
+            for (int i = 0; i < inSize; i++) {
+                pSize++;
+                q = nodes[q].nextZ;
+                if (q == -1) break;
+            }
+            int qSize = inSize;
+
+            while (pSize > 0 || (qSize > 0 && q != -1)) {
+                int e;
+                if (pSize != 0 && (qSize == 0 || q == -1 || nodes[p].z <= nodes[q].z)) {
+                    e = p;
+                    p = nodes[p].nextZ;
+                    pSize--;
+                } else {
+                    e = q;
+                    q = nodes[q].nextZ;
+                    qSize--;
+                }
+
+                if (tail != -1) nodes[tail].nextZ = e;
+                else list = e;
+
+                nodes[e].prevZ = tail;
+                tail = e;
+            }
+
+            p = q;
+        }
+
+        nodes[tail].nextZ = -1;
+        inSize *= 2;
+    } while (numMerges > 1);
+
+    return list;
+}
+
+/** Interleaves the bits of the coordinates scaled to 15 bits */
+int EarClippingTriangulator::zOrder (double x, double y, double minX, double minY, double invSize) {
+    unsigned int ix = (unsigned int) ((x - minX) * invSize);
+    unsigned int iy = (unsigned int) ((y - minY) * invSize);
+
+    ix = (ix | (ix << 8)) & 0x00FF00FF;
+    ix = (ix | (ix << 4)) & 0x0F0F0F0F;
+    ix = (ix | (ix << 2)) & 0x33333333;
+    ix = (ix | (ix << 1)) & 0x55555555;
+
+    iy = (iy | (iy << 8)) & 0x00FF00FF;
+    iy = (iy | (iy << 4)) & 0x0F0F0F0F;
+    iy = (iy | (iy << 2)) & 0x33333333;
+    iy = (iy | (iy << 1)) & 0x55555555;
+
+    return (int) (ix | (iy << 1));
 }
 
-bool EarClippingTriangulator::isCollinear (const std::vector<Vector2>& pVertices, int pIndex) {
-    int previousIndex = EarClippingTriangulator::computePreviousIndex(pVertices, pIndex);
-    int nextIndex = EarClippingTriangulator::computeNextIndex(pVertices, pIndex);
+int EarClippingTriangulator::getLeftmost (int start) const {
+    int p = start, leftmost = start;
+    do {
+        if (nodes[p].x < nodes[leftmost].x || (nodes[p].x == nodes[leftmost].x && nodes[p].y < nodes[leftmost].y))
+            leftmost = p;
+        p = nodes[p].next;
+    } while (p != start);
 
-    return EarClippingTriangulator::isCollinear(pVertices, previousIndex, pIndex, nextIndex);
+    return leftmost;
 }
 
-bool EarClippingTriangulator::isCollinear (const std::vector<Vector2>& pVertices, int pPreviousIndex, int pIndex,
-                                           int pNextIndex) {
-    const Vector2& previousVertex = pVertices.at(pPreviousIndex);
-    const Vector2& vertex = pVertices.at(pIndex);
-    const Vector2& nextVertex = pVertices.at(pNextIndex);
+bool EarClippingTriangulator::isValidDiagonal (int a, int b) const {
+    const Node& na = nodes[a];
+    const Node& nb = nodes[b];
 
-    return EarClippingTriangulator::computeSpannedAreaSign(previousVertex.x, previousVertex.y, vertex.x, vertex.y, nextVertex.x,
-            nextVertex.y) == 0;
+    // doesn't intersect other edges
+    if (nodes[na.next].i == nb.i || nodes[na.prev].i == nb.i || intersectsPolygon(a, b)) return false;
+
+    // locally visible and not opposite facing sectors, or a zero length diagonal
+    return (locallyInside(a, b) && locallyInside(b, a) && middleInside(a, b)
+            && (area(na.prev, a, nb.prev) != 0 || area(a, nb.prev, b) != 0))
+           || (equals(a, b) && area(na.prev, a, na.next) > 0 && area(nb.prev, b, nb.next) > 0);
+}
+
+double EarClippingTriangulator::area (int p, int q, int r) const {
+    const Node& np = nodes[p];
+    const Node& nq = nodes[q];
+    const Node& nr = nodes[r];
+    return (nq.y - np.y) * (nr.x - nq.x) - (nq.x - np.x) * (nr.y - nq.y);
 }
 
-int EarClippingTriangulator::computePreviousIndex (const std::vector<Vector2>& pVertices, int pIndex) {
-    return pIndex == 0 ? pVertices.size() - 1 : pIndex - 1;
+bool EarClippingTriangulator::equals (int p1, int p2) const {
+    return nodes[p1].x == nodes[p2].x && nodes[p1].y == nodes[p2].y;
 }
 
-int EarClippingTriangulator::computeNextIndex (const std::vector<Vector2>& pVertices, int pIndex) {
-    return pIndex == (pVertices.size() - 1) ? 0 : pIndex + 1;
+static inline int sign (double value) {
+    return value > 0 ? 1 : value < 0 ? -1 : 0;
 }
 
+bool EarClippingTriangulator::intersects (int p1, int q1, int p2, int q2) const {
+    int o1 = sign(area(p1, q1, p2));
+    int o2 = sign(area(p1, q1, q2));
+    int o3 = sign(area(p2, q2, p1));
+    int o4 = sign(area(p2, q2, q1));
+
+    if (o1 != o2 && o3 != o4) return true;
+
+    // collinear cases
+    if (o1 == 0 && onSegment(p1, p2, q1)) return true;
+    if (o2 == 0 && onSegment(p1, q2, q1)) return true;
+    if (o3 == 0 && onSegment(p2, p1, q2)) return true;
+    if (o4 == 0 && onSegment(p2, q1, q2)) return true;
+
+    return false;
+}
+
+/** For collinear points p, q, r, whether q lies on segment pr */
+bool EarClippingTriangulator::onSegment (int p, int q, int r) const {
+    const Node& np = nodes[p];
+    const Node& nq = nodes[q];
+    const Node& nr = nodes[r];
+    return nq.x <= std::max(np.x, nr.x) && nq.x >= std::min(np.x, nr.x)
+           && nq.y <= std::max(np.y, nr.y) && nq.y >= std::min(np.y, nr.y);
+}
+
+bool EarClippingTriangulator::intersectsPolygon (int a, int b) const {
+    int p = a;
+    do {
+        int next = nodes[p].next;
+        if (nodes[p].i != nodes[a].i && nodes[next].i != nodes[a].i && nodes[p].i != nodes[b].i
+                && nodes[next].i != nodes[b].i && intersects(p, next, a, b))
+            return true;
+        p = next;
+    } while (p != a);
+
+    return false;
+}
+
+/** Whether the diagonal ab lies locally inside the polygon at a */
+bool EarClippingTriangulator::locallyInside (int a, int b) const {
+    const Node& na = nodes[a];
+    return area(na.prev, a, na.next) < 0
+           ? area(a, b, na.next) >= 0 && area(a, na.prev, b) >= 0
+           : area(a, b, na.prev) < 0 || area(a, na.next, b) < 0;
+}
+
+/** Whether the middle of the diagonal ab is inside the polygon */
+bool EarClippingTriangulator::middleInside (int a, int b) const {
+    int p = a;
+    bool inside = false;
+    double px = (nodes[a].x + nodes[b].x) / 2;
+    double py = (nodes[a].y + nodes[b].y) / 2;
+    do {
+        const Node& n = nodes[p];
+        const Node& next = nodes[n.next];
+        if (((n.y > py) != (next.y > py)) && next.y != n.y && (px < (next.x - n.x) * (py - n.y) / (next.y - n.y) + n.x))
+            inside = !inside;
+        p = n.next;
+    } while (p != a);
+
+    return inside;
+}
+
+/** Links a and b with a bridge. If a and b are in the same ring the polygon is split in two, if they are in different
+ * rings (a hole) they are merged into one. Returns the duplicate of b. */
+int EarClippingTriangulator::splitPolygon (int a, int b) {
+    int a2 = insertNode(nodes[a].i, nodes[a].x, nodes[a].y, -1);
+    int b2 = insertNode(nodes[b].i, nodes[b].x, nodes[b].y, -1);
+    int an = nodes[a].next;
+    int bp = nodes[b].prev;
+
+    nodes[a].next = b;
+    nodes[b].prev = a;
+
+    nodes[a2].next = an;
+    nodes[an].prev = a2;
+
+    nodes[b2].next = a2;
+    nodes[a2].prev = b2;
+
+    nodes[bp].next = b2;
+    nodes[b2].prev = bp;
+
+    return b2;
+}
+
+/** Creates a node and links it after last, or into a ring of its own if last is -1 */
+int EarClippingTriangulator::insertNode (int i, double x, double y, int last) {
+    Node node;
+    node.i = i;
+    node.x = x;
+    node.y = y;
+    node.z = -1;
+    node.prevZ = -1;
+    node.nextZ = -1;
+    node.steiner = false;
+
+    int p = nodes.size();
+    if (last == -1) {
+        node.prev = p;
+        node.next = p;
+        nodes.push_back(node);
+    } else {
+        node.next = nodes[last].next;
+        node.prev = last;
+        nodes.push_back(node);
+        nodes[nodes[last].next].prev = p;
+        nodes[last].next = p;
+    }
+
+    return p;
+}
+
+void EarClippingTriangulator::removeNode (int p) {
+    Node& n = nodes[p];
+    nodes[n.next].prev = n.prev;
+    nodes[n.prev].next = n.next;
+
+    if (n.prevZ != -1) nodes[n.prevZ].nextZ = n.nextZ;
+    if (n.nextZ != -1) nodes[n.nextZ].prevZ = n.prevZ;
+}
@@ -21,42 +21,93 @@
 #ifndef GDX_CPP_MATH_EARCLIPPINGTRIANGULATOR_HPP_
 #define GDX_CPP_MATH_EARCLIPPINGTRIANGULATOR_HPP_
 
-#include <list>
 #include <vector>
 
 #include "Vector2.hpp"
-#include "gdx-cpp/utils/Aliases.hpp"
+#include "gdx-cpp/utils/LinearAllocator.hpp"
 
 namespace gdx_cpp {
 namespace math {
 
+/** Triangulates simple polygons, optionally with holes, by ear clipping.
+ *
+ * The polygon is kept as a doubly linked ring of vertices so cutting an ear is O(1), and for polygons with more than
+ * {@link #HASH_THRESHOLD} vertices the ear tests only look at the vertices whose z-order (Morton) code falls inside the
+ * candidate ear's bounds. Self touching and slightly degenerate input is repaired by falling back to curing local
+ * intersections and splitting the polygon along a valid diagonal.
+ *
+ * The index based overloads write into a caller provided vector and the triangulator keeps its working storage
+ * between calls, so reusing one instance does not allocate once its buffers have grown to the largest polygon seen. */
 class EarClippingTriangulator {
 public:
-  std::vector<Vector2> computeTriangles (const std::vector<Vector2>& polygon);
+    /** Returns the triangles as a list of vertices, three per triangle */
+    std::vector<Vector2> computeTriangles (const std::vector<Vector2>& polygon);
+
+    /** Like computeTriangles(polygon), with the result allocated from arena, e.g. the frame arena */
+    utils::ArenaVector<Vector2> computeTriangles (const std::vector<Vector2>& polygon, utils::LinearAllocator& arena);
+
+    /** Clears triangles and fills it with indices into polygon, three per triangle */
+    void computeTriangles (const std::vector<Vector2>& polygon, std::vector<short>& triangles);
+
+    /** Clears triangles and fills it with indices into vertices, three per triangle.
+     * @param vertices x,y pairs; the outer contour comes first, followed by the holes
+     * @param numVertices number of x,y pairs, at most 65536
+     * @param holeIndices index of the first vertex of each hole, in ascending order; may be NULL if numHoles is 0 */
+    void computeTriangles (const float* vertices, int numVertices, const int* holeIndices, int numHoles,
+                           std::vector<short>& triangles);
+
+    /** Like the overload above, with the indices allocated from arena */
+    utils::ArenaVector<short> computeTriangles (const float* vertices, int numVertices, const int* holeIndices,
+                                                int numHoles, utils::LinearAllocator& arena);
+
+    /** Vertex count above which the ear tests use the z-order hash */
+    static const int HASH_THRESHOLD = 80;
 
 private:
-    static bool areVerticesClockwise (const std::vector<Vector2>& pVertices);
-    std::vector<int> classifyVertices (std::vector< gdx_cpp::math::Vector2 >& pVertices);
-    static bool isTriangleConvex (float pX1, float pY1, float pX2, float pY2, float pX3,
-                                  float pY3);
-    static int computeSpannedAreaSign (float pX1, float pY1, float pX2, float pY2,
-                                       float pX3, float pY3);
-    static bool isAnyVertexInTriangle (std::vector<Vector2>& pVertices, const std::vector<int>& pVertexTypes, float pX1,
-                                       float pY1, float pX2, float pY2, float pX3, float pY3);
-    bool isEarTip (std::vector<Vector2>& pVertices, int pEarTipIndex, const std::vector<int>& pVertexTypes);
-    void cutEarTip (std::vector< gdx_cpp::math::Vector2 >& pVertices, int pEarTipIndex, std::vector< gdx_cpp::math::Vector2 >& pTriangles);
-    static void removeCollinearNeighborEarsAfterRemovingEarTip (std::vector<Vector2>& pVertices,
-                                                                int pEarTipCutIndex);
-    static bool isCollinear (const std::vector<Vector2>& pVertices, int pIndex);
-    static bool isCollinear (const std::vector<Vector2>& pVertices, int pPreviousIndex, int pIndex,
-                             int pNextIndex);
-    static int computePreviousIndex (const std::vector< gdx_cpp::math::Vector2 >& pVertices, int pIndex);
-    static int computeNextIndex (const std::vector<Vector2>& pVertices, int pIndex);
-
-    const static int CONCAVE = 1;
-    const static int CONVEX = -1;
-    
-    int concaveVertexCount;
+    struct Node {
+        /** index of the vertex in the source data */
+        int i;
+        double x, y;
+        int prev, next;
+        /** z-order code and links of the z-order sorted list, -1 when not hashed */
+        int z;
+        int prevZ, nextZ;
+        bool steiner;
+    };
+
+    struct CompareX;
+
+    int linkedList (const float* vertices, int start, int end, bool clockwise);
+    int filterPoints (int start, int end = -1);
+    void earcutLinked (int ear, std::vector<short>& triangles, double minX, double minY, double invSize, int pass);
+    bool isEar (int ear) const;
+    bool isEarHashed (int ear, double minX, double minY, double invSize) const;
+    int cureLocalIntersections (int start, std::vector<short>& triangles);
+    void splitEarcut (int start, std::vector<short>& triangles, double minX, double minY, double invSize);
+    int eliminateHoles (const float* vertices, int numVertices, const int* holeIndices, int numHoles, int outerNode);
+    int eliminateHole (int hole, int outerNode);
+    int findHoleBridge (int hole, int outerNode) const;
+    bool sectorContainsSector (int m, int p) const;
+    void indexCurve (int start, double minX, double minY, double invSize);
+    int sortLinked (int list);
+    static int zOrder (double x, double y, double minX, double minY, double invSize);
+    int getLeftmost (int start) const;
+    bool isValidDiagonal (int a, int b) const;
+    double area (int p, int q, int r) const;
+    bool equals (int p1, int p2) const;
+    bool intersects (int p1, int q1, int p2, int q2) const;
+    bool onSegment (int p, int q, int r) const;
+    bool intersectsPolygon (int a, int b) const;
+    bool locallyInside (int a, int b) const;
+    bool middleInside (int a, int b) const;
+    int splitPolygon (int a, int b);
+    int insertNode (int i, double x, double y, int last);
+    void removeNode (int p);
+
+    std::vector<Node> nodes;
+    std::vector<int> holeQueue;
+    std::vector<float> coordinates;
+    std::vector<short> indices;
 };
 
 } // namespace gdx_cpp
@@ -24,6 +24,8 @@
 #include "Matrix4.hpp"
 #include "collision/BoundingBox.hpp"
 
+#include "gdx-cpp/utils/Simd.hpp"
+
 #include <string.h>
 
 using namespace gdx_cpp::math;
@@ -33,7 +35,10 @@ Vector3 Frustum::clipSpacePlanePoints[] = { Vector3(-1, -1, -1), Vector3(1, -1,
         Vector3(1, 1, -1), Vector3(-1, 1, -1), // near clip
         Vector3(-1, -1, 1), Vector3(1, -1, 1), Vector3(1, 1, 1), Vector3(-1, 1, 1)}; // far clip
 
-float Frustum::clipSpacePlanePointsArray[8 * 3];
+float Frustum::clipSpacePlanePointsArray[8 * 3] = { -1, -1, -1, 1, -1, -1, 1, 1, -1, -1, 1, -1,
+        -1, -1, 1, 1, -1, 1, 1, 1, 1, -1, 1, 1 };
+
+static const int bitCount[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
 
 Frustum::Frustum()
 {
@@ -50,7 +55,7 @@ gdx_cpp::math::Frustum::~Frustum()
 }
 
 void Frustum::update (const Matrix4& inverseProjectionView) {
-    memcpy(planePointsArray, clipSpacePlanePointsArray, 24 );
+    memcpy(planePointsArray, clipSpacePlanePointsArray, sizeof(planePointsArray));
 
     Matrix4::prj(inverseProjectionView.val, planePointsArray, 0, 8, 3);
     for (int i = 0, j = 0; i < 8; i++) {
@@ -92,17 +97,180 @@ bool Frustum::sphereInFrustumWithoutNearFar (const Vector3& center,float radius)
 }
 
 bool Frustum::boundsInFrustum (gdx_cpp::math::collision::BoundingBox& bounds) {
-    const std::vector<Vector3>& corners = bounds.getCorners();
-    int len = corners.size();
+    // the box is outside a plane when the corner farthest along the plane normal is behind it
+    for (int i = 0; i < 6; i++) {
+        const Vector3& normal = planes[i]->normal;
+        float x = normal.x > 0 ? bounds.max.x : bounds.min.x;
+        float y = normal.y > 0 ? bounds.max.y : bounds.min.y;
+        float z = normal.z > 0 ? bounds.max.z : bounds.min.z;
+        if (normal.x * x + normal.y * y + normal.z * z + planes[i]->d < 0) return false;
+    }
 
-    for (int i = 0, len2 = 6; i < len2; i++) {
-        int out = 0;
+    return true;
+}
 
-        for (int j = 0; j < len; j++)
-          if (planes[i]->testPoint(corners[j]) == Plane::PlaneSide_Back) out++;
+int Frustum::spheresInFrustum (const float* x, const float* y, const float* z, const float* radius, int count,
+                               unsigned int* visible) {
+    memset(visible, 0, ((count + 31) / 32) * sizeof(unsigned int));
+    int visibleCount = 0;
+    int i = 0;
 
-        if (out == 8) return false;
+#if defined(GDX_CPP_SIMD_SSE)
+    __m128 nx[6], ny[6], nz[6], d[6];
+    for (int p = 0; p < 6; p++) {
+        nx[p] = _mm_set1_ps(planes[p]->normal.x);
+        ny[p] = _mm_set1_ps(planes[p]->normal.y);
+        nz[p] = _mm_set1_ps(planes[p]->normal.z);
+        d[p] = _mm_set1_ps(planes[p]->d);
     }
 
-    return true;
-}
\ No newline at end of file
+    for (; i + 4 <= count; i += 4) {
+        __m128 cx = _mm_loadu_ps(x + i);
+        __m128 cy = _mm_loadu_ps(y + i);
+        __m128 cz = _mm_loadu_ps(z + i);
+        __m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radius + i));
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+        for (int p = 0; p < 6; p++) {
+            __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx[p], cx), _mm_mul_ps(ny[p], cy)),
+                                     _mm_add_ps(_mm_mul_ps(nz[p], cz), d[p]));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(dist, negRadius));
+        }
+
+        int bits = _mm_movemask_ps(inside);
+        visible[i >> 5] |= (unsigned int) bits << (i & 31);
+        visibleCount += bitCount[bits];
+    }
+#elif defined(GDX_CPP_SIMD_NEON)
+    float32x4_t nx[6], ny[6], nz[6], d[6];
+    for (int p = 0; p < 6; p++) {
+        nx[p] = vdupq_n_f32(planes[p]->normal.x);
+        ny[p] = vdupq_n_f32(planes[p]->normal.y);
+        nz[p] = vdupq_n_f32(planes[p]->normal.z);
+        d[p] = vdupq_n_f32(planes[p]->d);
+    }
+
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t cx = vld1q_f32(x + i);
+        float32x4_t cy = vld1q_f32(y + i);
+        float32x4_t cz = vld1q_f32(z + i);
+        float32x4_t negRadius = vnegq_f32(vld1q_f32(radius + i));
+        uint32x4_t inside = vdupq_n_u32(0xffffffff);
+
+        for (int p = 0; p < 6; p++) {
+            float32x4_t dist = vmlaq_f32(vmlaq_f32(vmlaq_f32(d[p], nx[p], cx), ny[p], cy), nz[p], cz);
+            inside = vandq_u32(inside, vcgeq_f32(dist, negRadius));
+        }
+
+        int bits = (vgetq_lane_u32(inside, 0) & 1) | (vgetq_lane_u32(inside, 1) & 2)
+                   | (vgetq_lane_u32(inside, 2) & 4) | (vgetq_lane_u32(inside, 3) & 8);
+        visible[i >> 5] |= (unsigned int) bits << (i & 31);
+        visibleCount += bitCount[bits];
+    }
+#endif
+
+    for (; i < count; i++) {
+        bool inside = true;
+        for (int p = 0; p < 6 && inside; p++) {
+            const Vector3& normal = planes[p]->normal;
+            inside = normal.x * x[i] + normal.y * y[i] + normal.z * z[i] + planes[p]->d >= -radius[i];
+        }
+
+        if (inside) {
+            visible[i >> 5] |= 1u << (i & 31);
+            visibleCount++;
+        }
+    }
+
+    return visibleCount;
+}
+
+int Frustum::boundsInFrustum (const float* minX, const float* minY, const float* minZ, const float* maxX,
+                              const float* maxY, const float* maxZ, int count, unsigned int* visible) {
+    memset(visible, 0, ((count + 31) / 32) * sizeof(unsigned int));
+    int visibleCount = 0;
+    int i = 0;
+
+    // per plane, which of min/max gives the corner farthest along the normal
+    bool useMaxX[6], useMaxY[6], useMaxZ[6];
+    for (int p = 0; p < 6; p++) {
+        useMaxX[p] = planes[p]->normal.x > 0;
+        useMaxY[p] = planes[p]->normal.y > 0;
+        useMaxZ[p] = planes[p]->normal.z > 0;
+    }
+
+#if defined(GDX_CPP_SIMD_SSE)
+    __m128 nx[6], ny[6], nz[6], d[6];
+    for (int p = 0; p < 6; p++) {
+        nx[p] = _mm_set1_ps(planes[p]->normal.x);
+        ny[p] = _mm_set1_ps(planes[p]->normal.y);
+        nz[p] = _mm_set1_ps(planes[p]->normal.z);
+        d[p] = _mm_set1_ps(planes[p]->d);
+    }
+
+    __m128 zero = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4) {
+        __m128 x0 = _mm_loadu_ps(minX + i), x1 = _mm_loadu_ps(maxX + i);
+        __m128 y0 = _mm_loadu_ps(minY + i), y1 = _mm_loadu_ps(maxY + i);
+        __m128 z0 = _mm_loadu_ps(minZ + i), z1 = _mm_loadu_ps(maxZ + i);
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+        for (int p = 0; p < 6; p++) {
+            __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx[p], useMaxX[p] ? x1 : x0),
+                                                _mm_mul_ps(ny[p], useMaxY[p] ? y1 : y0)),
+                                     _mm_add_ps(_mm_mul_ps(nz[p], useMaxZ[p] ? z1 : z0), d[p]));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(dist, zero));
+        }
+
+        int bits = _mm_movemask_ps(inside);
+        visible[i >> 5] |= (unsigned int) bits << (i & 31);
+        visibleCount += bitCount[bits];
+    }
+#elif defined(GDX_CPP_SIMD_NEON)
+    float32x4_t nx[6], ny[6], nz[6], d[6];
+    for (int p = 0; p < 6; p++) {
+        nx[p] = vdupq_n_f32(planes[p]->normal.x);
+        ny[p] = vdupq_n_f32(planes[p]->normal.y);
+        nz[p] = vdupq_n_f32(planes[p]->normal.z);
+        d[p] = vdupq_n_f32(planes[p]->d);
+    }
+
+    float32x4_t zero = vdupq_n_f32(0);
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t x0 = vld1q_f32(minX + i), x1 = vld1q_f32(maxX + i);
+        float32x4_t y0 = vld1q_f32(minY + i), y1 = vld1q_f32(maxY + i);
+        float32x4_t z0 = vld1q_f32(minZ + i), z1 = vld1q_f32(maxZ + i);
+        uint32x4_t inside = vdupq_n_u32(0xffffffff);
+
+        for (int p = 0; p < 6; p++) {
+            float32x4_t dist = vmlaq_f32(d[p], nx[p], useMaxX[p] ? x1 : x0);
+            dist = vmlaq_f32(dist, ny[p], useMaxY[p] ? y1 : y0);
+            dist = vmlaq_f32(dist, nz[p], useMaxZ[p] ? z1 : z0);
+            inside = vandq_u32(inside, vcgeq_f32(dist, zero));
+        }
+
+        int bits = (vgetq_lane_u32(inside, 0) & 1) | (vgetq_lane_u32(inside, 1) & 2)
+                   | (vgetq_lane_u32(inside, 2) & 4) | (vgetq_lane_u32(inside, 3) & 8);
+        visible[i >> 5] |= (unsigned int) bits << (i & 31);
+        visibleCount += bitCount[bits];
+    }
+#endif
+
+    for (; i < count; i++) {
+        bool inside = true;
+        for (int p = 0; p < 6 && inside; p++) {
+            const Vector3& normal = planes[p]->normal;
+            float x = useMaxX[p] ? maxX[i] : minX[i];
+            float y = useMaxY[p] ? maxY[i] : minY[i];
+            float z = useMaxZ[p] ? maxZ[i] : minZ[i];
+            inside = normal.x * x + normal.y * y + normal.z * z + planes[p]->d >= 0;
+        }
+
+        if (inside) {
+            visible[i >> 5] |= 1u << (i & 31);
+            visibleCount++;
+        }
+    }
+
+    return visibleCount;
+}
@@ -42,6 +42,18 @@ public:
     bool sphereInFrustum (const Vector3& center,float radius);
     bool sphereInFrustumWithoutNearFar (const Vector3& center,float radius);
     bool boundsInFrustum (gdx_cpp::math::collision::BoundingBox& bounds);
+
+    /** Batched versions of {@link #sphereInFrustum} and {@link #boundsInFrustum} taking the objects as structure of
+     * arrays. Bit i of visible (see {@link #isVisible}) is set when object i is at least partially inside the frustum;
+     * visible must hold (count + 31) / 32 words, all of which are overwritten. Returns the number of visible objects. */
+    int spheresInFrustum (const float* x, const float* y, const float* z, const float* radius, int count,
+                          unsigned int* visible);
+    int boundsInFrustum (const float* minX, const float* minY, const float* minZ, const float* maxX, const float* maxY,
+                         const float* maxZ, int count, unsigned int* visible);
+
+    static bool isVisible (const unsigned int* visible, int index) {
+        return (visible[index >> 5] & (1u << (index & 31))) != 0;
+    }
 //     collision::Ray& calculatePickRay (float screen_width,float screen_height,float mouse_x,float mouse_y,const Vector3& pos,const Vector3& dir,const Vector3& up);
     static void main ();
 
@@ -54,17 +66,6 @@ protected:
     static Vector3 clipSpacePlanePoints[];
     static float clipSpacePlanePointsArray[];
     float planePointsArray[24];
-private:
-    static class init {
-        init() {
-            int j = 0;
-            for (int i = 0; i < 8; ++i) {
-                clipSpacePlanePointsArray[j++] = clipSpacePlanePoints[i].x;
-                clipSpacePlanePointsArray[j++] = clipSpacePlanePoints[i].y;
-                clipSpacePlanePointsArray[j++] = clipSpacePlanePoints[i].z;
-            }
-        }
-    } _i;
 };
 
 } // namespace gdx_cpp
@@ -38,19 +38,6 @@
 using namespace gdx_cpp::math;
 
 
-Vector3 Intersector::v0;
-Vector3 Intersector::v1;
-Vector3 Intersector::v2;
-Vector3 Intersector::tmp;
-Vector3 Intersector::tmp1;
-Vector3 Intersector::tmp2;
-Vector3 Intersector::tmp3;
-Vector3 Intersector::best;
-Plane Intersector::p = Plane(Vector3(), 0);
-Vector3 Intersector::i;
-Vector3 Intersector::dir;
-Vector3 Intersector::start;
-
 float Intersector::getLowestPositiveRoot (float a,float b,float c) {
     float det = b * b - 4 * a * c;
     if (det < 0) return std::numeric_limits<float>::quiet_NaN();
@@ -74,9 +61,12 @@ float Intersector::getLowestPositiveRoot (float a,float b,float c) {
 }
 
 bool Intersector::isPointInTriangle (const Vector3& point, const Vector3& t1, const Vector3& t2, const Vector3& t3) {
-    v0.set(t1).sub(point);
-    v1.set(t2).sub(point);
-    v2.set(t3).sub(point);
+    Vector3 v0(t1);
+    v0.sub(point);
+    Vector3 v1(t2);
+    v1.sub(point);
+    Vector3 v2(t3);
+    v2.sub(point);
 
     float ab = v0.dot(v1);
     float ac = v0.dot(v2);
@@ -90,7 +80,8 @@ bool Intersector::isPointInTriangle (const Vector3& point, const Vector3& t1, co
 }
 
 bool Intersector::intersectSegmentPlane (const Vector3& start,const Vector3& end, Plane& plane, Vector3* intersection) {
-    Vector3 dir = end.tmp().sub(start);
+    Vector3 dir(end);
+    dir.sub(start);
     float denom = dir.dot(plane.getNormal());
     float t = -(start.dot(plane.getNormal()) + plane.getD()) / denom;
     if (t < 0 || t > 1) return false;
@@ -118,15 +109,16 @@ bool Intersector::isPointInPolygon (std::vector<Vector2>& polygon,const Vector2&
 }
 
 float Intersector::distanceLinePoint (const Vector2& start,const Vector2& end,const Vector2& point) {
-    tmp.set(end.x, end.y, 0).sub(start.x, start.y, 0);
+    Vector3 tmp(end.x - start.x, end.y - start.y, 0);
     float l = tmp.len();
-    tmp2.set(start.x, start.y, 0).sub(point.x, point.y, 0);
+    Vector3 tmp2(start.x - point.x, start.y - point.y, 0);
     return tmp.crs(tmp2).len() / l;
 }
 
 bool Intersector::intersectSegmentCircle (const Vector2& start,const Vector2& end,const Vector2& center,float squareRadius) {
-    tmp.set(end.x - start.x, end.y - start.y, 0);
-    tmp1.set(center.x - start.x, center.y - start.y, 0);
+    Vector3 tmp(end.x - start.x, end.y - start.y, 0);
+    Vector3 tmp1(center.x - start.x, center.y - start.y, 0);
+    Vector3 tmp2;
     float l = tmp.len();
     float u = tmp1.dot(tmp.nor());
     if (u <= 0) {
@@ -134,8 +126,8 @@ bool Intersector::intersectSegmentCircle (const Vector2& start,const Vector2& en
     } else if (u >= l) {
         tmp2.set(end.x, end.y, 0);
     } else {
-        tmp3.set(tmp.mul(u)); // remember tmp is already normalized
-        tmp2.set(tmp3.x + start.x, tmp3.y + start.y, 0);
+        tmp.mul(u); // remember tmp is already normalized
+        tmp2.set(tmp.x + start.x, tmp.y + start.y, 0);
     }
 
     float x = center.x - tmp2.x;
@@ -149,8 +141,9 @@ float Intersector::intersectSegmentCircleDisplace (const Vector2& start,const Ve
     float d = start.dst(end);
     u /= (d * d);
     if (u < 0 || u > 1) return std::numeric_limits<float>::infinity();
-    tmp.set(end.x, end.y, 0).sub(start.x, start.y, 0);
-    tmp2.set(start.x, start.y, 0).add(tmp.mul(u));
+    Vector3 tmp(end.x - start.x, end.y - start.y, 0);
+    Vector3 tmp2(start.x, start.y, 0);
+    tmp2.add(tmp.mul(u));
     d = tmp2.dst(point.x, point.y, 0);
     if (d < radius) {
         displacement.set(point).sub(tmp2.x, tmp2.y).nor();
@@ -165,7 +158,7 @@ bool Intersector::intersectRayPlane (const gdx_cpp::math::collision::Ray& ray, P
         float t = -(ray.origin.dot(plane.getNormal()) + plane.getD()) / denom;
         if (t < 0) return false;
 
-        if (intersection != NULL) intersection->set(ray.origin).add(ray.direction.tmp().mul(t));
+        if (intersection != NULL) intersection->set(ray.origin).add(ray.direction.x * t, ray.direction.y * t, ray.direction.z * t);
         return true;
     } else if (plane.testPoint(ray.origin) == Plane::PlaneSide_OnPlane) {
         if (intersection != NULL) intersection->set(ray.origin);
@@ -175,12 +168,17 @@ bool Intersector::intersectRayPlane (const gdx_cpp::math::collision::Ray& ray, P
 }
 
 bool Intersector::intersectRayTriangle (const gdx_cpp::math::collision::Ray& ray,const Vector3& t1,const Vector3& t2,const Vector3& t3, Vector3* intersection) {
+    Plane p(Vector3(), 0);
     p.set(t1, t2, t3);
+    Vector3 i;
     if (!intersectRayPlane(ray, p, &i)) return false;
 
-    v0.set(t3).sub(t1);
-    v1.set(t2).sub(t1);
-    v2.set(i).sub(t1);
+    Vector3 v0(t3);
+    v0.sub(t1);
+    Vector3 v1(t2);
+    v1.sub(t1);
+    Vector3 v2(i);
+    v2.sub(t1);
 
     float dot00 = v0.dot(v0);
     float dot01 = v0.dot(v1);
@@ -204,9 +202,10 @@ bool Intersector::intersectRayTriangle (const gdx_cpp::math::collision::Ray& ray
 }
 
 bool Intersector::intersectRaySphere (const gdx_cpp::math::collision::Ray& ray,const Vector3& center,float radius, Vector3* intersection) {
-    dir.set(ray.direction).nor();
-    start.set(ray.origin);
-    float b = 2 * (dir.dot(start.tmp().sub(center)));
+    Vector3 dir(ray.direction);
+    dir.nor();
+    Vector3 start(ray.origin);
+    float b = 2 * (dir.dot(Vector3(start).sub(center)));
     float c = start.dst2(center) - radius * radius;
     float disc = b * b - 4 * c;
     if (disc < 0) return false;
@@ -238,12 +237,12 @@ bool Intersector::intersectRaySphere (const gdx_cpp::math::collision::Ray& ray,c
 
     // if t0 is less than zero, the intersection point is at t1
     if (t0 < 0) {
-        if (intersection != NULL) intersection->set(start).add(dir.tmp().mul(t1));
+        if (intersection != NULL) intersection->set(start).add(dir.mul(t1));
         return true;
     }
     // else the intersection point is at t0
     else {
-        if (intersection != NULL) intersection->set(start).add(dir.tmp().mul(t0));
+        if (intersection != NULL) intersection->set(start).add(dir.mul(t0));
         return true;
     }
 }
@@ -293,6 +292,7 @@ bool Intersector::intersectRayBoundsFast (const gdx_cpp::math::collision::Ray& r
 bool Intersector::intersectRayTriangles (const gdx_cpp::math::collision::Ray& ray, const std::vector<float>& triangles, Vector3* intersection) {
     float min_dist = std::numeric_limits<float>::max();
     bool hit = false;
+    Vector3 tmp, best;
 
     if ((triangles.size() / 3) % 3 != 0)
     {
@@ -301,12 +301,12 @@ bool Intersector::intersectRayTriangles (const gdx_cpp::math::collision::Ray& ra
     }
 
     for (unsigned int i = 0; i < triangles.size() - 6; i += 9) {
-        bool result = intersectRayTriangle(ray, tmp1.set(triangles[i], triangles[i + 1], triangles[i + 2]),
-                                              tmp2.set(triangles[i + 3], triangles[i + 4], triangles[i + 5]),
-                                              tmp3.set(triangles[i + 6], triangles[i + 7], triangles[i + 8]), &tmp);
+        bool result = intersectRayTriangle(ray, Vector3(triangles[i], triangles[i + 1], triangles[i + 2]),
+                                              Vector3(triangles[i + 3], triangles[i + 4], triangles[i + 5]),
+                                              Vector3(triangles[i + 6], triangles[i + 7], triangles[i + 8]), &tmp);
 
         if (result == true) {
-            float dist = ray.origin.tmp().sub(tmp).len();
+            float dist = tmp.dst(ray.origin);
             if (dist < min_dist) {
                 min_dist = dist;
                 best.set(tmp);
@@ -326,6 +326,7 @@ bool Intersector::intersectRayTriangles (const gdx_cpp::math::collision::Ray& ra
 bool Intersector::intersectRayTriangles (const gdx_cpp::math::collision::Ray& ray, const std::vector<float>& vertices, const std::vector<short>& indices, int vertexSize, Vector3* intersection) {
     float min_dist = std::numeric_limits<float>::max();
     bool hit = false;
+    Vector3 tmp, best;
 
     if ((indices.size() % 3) != 0)
     {
@@ -338,12 +339,12 @@ bool Intersector::intersectRayTriangles (const gdx_cpp::math::collision::Ray& ra
         int i2 = indices[i + 1] * vertexSize;
         int i3 = indices[i + 2] * vertexSize;
 
-        bool result = intersectRayTriangle(ray, tmp1.set(vertices[i1], vertices[i1 + 1], vertices[i1 + 2]),
-                                              tmp2.set(vertices[i2], vertices[i2 + 1], vertices[i2 + 2]),
-                                              tmp3.set(vertices[i3], vertices[i3 + 1], vertices[i3 + 2]), &tmp);
+        bool result = intersectRayTriangle(ray, Vector3(vertices[i1], vertices[i1 + 1], vertices[i1 + 2]),
+                                              Vector3(vertices[i2], vertices[i2 + 1], vertices[i2 + 2]),
+                                              Vector3(vertices[i3], vertices[i3 + 1], vertices[i3 + 2]), &tmp);
 
         if (result == true) {
-            float dist = ray.origin.tmp().sub(tmp).len();
+            float dist = tmp.dst(ray.origin);
             if (dist < min_dist) {
                 min_dist = dist;
                 best.set(tmp);
@@ -362,6 +363,8 @@ bool Intersector::intersectRayTriangles (const gdx_cpp::math::collision::Ray& ra
 
 bool Intersector::intersectRayTriangles (const gdx_cpp::math::collision::Ray& ray, const std::vector<gdx_cpp::math::Vector3>& triangles, gdx_cpp::math::Vector3* intersection) {
     float min_dist = std::numeric_limits<float>::max();
+    bool hit = false;
+    Vector3 tmp, best;
 
     if (triangles.size() % 3 != 0)
     {
@@ -373,15 +376,16 @@ bool Intersector::intersectRayTriangles (const gdx_cpp::math::collision::Ray& ra
         bool result = intersectRayTriangle(ray, triangles.at(i), triangles.at(i + 1), triangles.at(i + 2), &tmp);
 
         if (result == true) {
-            float dist = ray.origin.tmp().sub(tmp).len();
+            float dist = tmp.dst(ray.origin);
             if (dist < min_dist) {
                 min_dist = dist;
                 best.set(tmp);
+                hit = true;
             }
         }
     }
 
-    if (best == NULL)
+    if (hit == false)
         return false;
     else {
         if (intersection != NULL) intersection->set(best);
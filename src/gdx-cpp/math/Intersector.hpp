@@ -66,20 +66,6 @@ public:
 protected:
     static float det (float a, float b, float c, float d);
     static double detd (double a, double b, double c, double d);
-    static Vector3 tmp;
-    static Vector3 best;
-    static Vector3 tmp1;
-    static Vector3 tmp2;
-    static Vector3 tmp3;
-
-private:
-    static Vector3 v0;
-    static Vector3 v1;
-    static Vector3 v2;
-    static Plane p;
-    static Vector3 i;
-    static Vector3 dir;
-    static Vector3 start;
 };
 
 } // namespace gdx_cpp
@@ -1,4 +1,5 @@
 #include "MathUtils.hpp"
+#include "detail/SimdLanes.hpp"
 
 using namespace gdx_cpp::math::utils;
 
@@ -24,12 +25,10 @@ detail::detail() {
     }
 }
 
-detail __detail;
-
 const float detail::PI = 3.14159265f;
-const int detail::SIN_BITS = 13;
-const int detail::SIN_MASK = ~(-1 << SIN_BITS);
-const int detail::SIN_COUNT = (SIN_MASK + 1);
+const int detail::SIN_BITS;
+const int detail::SIN_MASK;
+const int detail::SIN_COUNT;
 
 const float detail::radFull = (detail::PI * 2.0f);
 const float detail::degFull = 360.0f;
@@ -39,10 +38,10 @@ const float detail::degToIndex = (detail::SIN_COUNT / detail::degFull);
 const float detail::radiansToDegrees = (180.0f / 3.1415927f);
 const float detail::degreesToRadians = (detail::PI / 180.f);
 
-const int detail::ATAN2_BITS = 7;
-const int detail::ATAN2_BITS2 = 14;
-const int detail::ATAN2_MASK  = 16383;
-const int detail::ATAN2_COUNT = 16384;
+const int detail::ATAN2_BITS;
+const int detail::ATAN2_BITS2;
+const int detail::ATAN2_MASK;
+const int detail::ATAN2_COUNT;
 const float detail::INV_ATAN2_DIM_MINUS_1 = (1.0f / (detail::ATAN2_DIM - 1));
 
 float detail::_sin[SIN_COUNT];
@@ -52,5 +51,65 @@ const float detail::BIG_ENOUGH_FLOOR = detail::BIG_ENOUGH_INT;
 const float detail::CEIL = 0.9999999;
 const float detail::BIG_ENOUGH_CEIL = gdx_cpp::utils::NumberUtils::longBitsToDouble(gdx_cpp::utils::NumberUtils::doubleToLongBits(detail::BIG_ENOUGH_INT + 1) - 1);
 const float detail::BIG_ENOUGH_ROUND = detail::BIG_ENOUGH_INT + 0.5f;
-const int detail::ATAN2_DIM = 128;
+const int detail::ATAN2_DIM;
 float detail::_atan2[ATAN2_COUNT];
+
+// fills the tables, defined after the constants it reads
+detail __detail;
+
+namespace {
+
+using gdx_cpp::math::detail::ScalarLane;
+#if defined(GDX_CPP_SIMD_SSE) || defined(GDX_CPP_SIMD_NEON)
+using gdx_cpp::math::detail::SimdLane;
+#endif
+using gdx_cpp::math::detail::sinCosLane;
+using gdx_cpp::math::detail::atan2Lane;
+
+template <class L>
+inline int sinCosLoop (int i, const float* radians, float* sinOut, float* cosOut, int count, bool accurate) {
+    for (; i + L::WIDTH <= count; i += L::WIDTH) {
+        typename L::F s, c;
+        sinCosLane<L>(L::load(radians + i), sinOut != NULL ? &s : NULL, cosOut != NULL ? &c : NULL, accurate);
+        if (sinOut != NULL) L::store(sinOut + i, s);
+        if (cosOut != NULL) L::store(cosOut + i, c);
+    }
+    return i;
+}
+
+template <class L>
+inline int atan2Loop (int i, const float* y, const float* x, float* out, int count, bool accurate) {
+    for (; i + L::WIDTH <= count; i += L::WIDTH)
+        L::store(out + i, atan2Lane<L>(L::load(y + i), L::load(x + i), accurate));
+    return i;
+}
+
+void sinCosArray (const float* radians, float* sinOut, float* cosOut, int count, bool accurate) {
+    int i = 0;
+#if defined(GDX_CPP_SIMD_SSE) || defined(GDX_CPP_SIMD_NEON)
+    i = sinCosLoop<SimdLane>(i, radians, sinOut, cosOut, count, accurate);
+#endif
+    sinCosLoop<ScalarLane>(i, radians, sinOut, cosOut, count, accurate);
+}
+
+}
+
+void gdx_cpp::math::utils::sin (const float* radians, float* out, int count, Precision precision) {
+    sinCosArray(radians, out, NULL, count, precision == ACCURATE);
+}
+
+void gdx_cpp::math::utils::cos (const float* radians, float* out, int count, Precision precision) {
+    sinCosArray(radians, NULL, out, count, precision == ACCURATE);
+}
+
+void gdx_cpp::math::utils::sinCos (const float* radians, float* sinOut, float* cosOut, int count, Precision precision) {
+    sinCosArray(radians, sinOut, cosOut, count, precision == ACCURATE);
+}
+
+void gdx_cpp::math::utils::atan2 (const float* y, const float* x, float* out, int count, Precision precision) {
+    int i = 0;
+#if defined(GDX_CPP_SIMD_SSE) || defined(GDX_CPP_SIMD_NEON)
+    i = atan2Loop<SimdLane>(i, y, x, out, count, precision == ACCURATE);
+#endif
+    atan2Loop<ScalarLane>(i, y, x, out, count, precision == ACCURATE);
+}
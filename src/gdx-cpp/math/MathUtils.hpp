@@ -24,6 +24,7 @@
 #include <cstdlib>
 #include <cmath>
 #include <iostream>
+#include "Random.hpp"
 #include "gdx-cpp/utils/NumberUtils.hpp"
 
 namespace gdx_cpp {
@@ -34,9 +35,9 @@ namespace utils {
 
 struct detail {
     static const float PI;
-    static const int SIN_BITS;
-    static const int SIN_MASK;
-    static const int SIN_COUNT;
+    static const int SIN_BITS = 13;
+    static const int SIN_MASK = (1 << SIN_BITS) - 1;
+    static const int SIN_COUNT = SIN_MASK + 1;
     
     static const float radFull;
     static const float degFull;
@@ -46,10 +47,10 @@ struct detail {
     static const float radiansToDegrees;
     static const float degreesToRadians;
     
-    static const int ATAN2_BITS;
-    static const int ATAN2_BITS2;
-    static const int ATAN2_MASK;
-    static const int ATAN2_COUNT;
+    static const int ATAN2_BITS = 7;
+    static const int ATAN2_BITS2 = ATAN2_BITS << 1;
+    static const int ATAN2_MASK = (1 << ATAN2_BITS2) - 1;
+    static const int ATAN2_COUNT = ATAN2_MASK + 1;
     static const float INV_ATAN2_DIM_MINUS_1;
     
     static float _sin[];
@@ -60,7 +61,7 @@ struct detail {
     static const float BIG_ENOUGH_CEIL;
     static const float BIG_ENOUGH_ROUND;
 
-    static const int ATAN2_DIM;
+    static const int ATAN2_DIM = 1 << ATAN2_BITS;
     static float _atan2[];
 
     detail () ;
@@ -118,21 +119,38 @@ inline float atan2 (float y, float x) {
     return (detail::_atan2[yi * detail::ATAN2_DIM + xi] + add) * mul;
 }
 
+/** Precision of the array versions of sin, cos and atan2. FAST is still more accurate than the lookup tables behind
+ * the single value versions (about 3e-4 for sin and cos, 2e-4 radians for atan2), ACCURATE is within a few ulp of
+ * the float results of the C library for arguments up to a few thousand radians. */
+enum Precision {
+    FAST,
+    ACCURATE
+};
+
+/** Computes the sine of count angles in radians, out may alias radians */
+void sin (const float* radians, float* out, int count, Precision precision = ACCURATE);
+void cos (const float* radians, float* out, int count, Precision precision = ACCURATE);
+void sinCos (const float* radians, float* sinOut, float* cosOut, int count, Precision precision = ACCURATE);
+/** Computes atan2(y[i], x[i]) for count pairs, out may alias y or x */
+void atan2 (const float* y, const float* x, float* out, int count, Precision precision = ACCURATE);
+
 /** Returns a random number between 0 (inclusive) and the specified value (inclusive). */
 inline int random (int range) {
-    return std::rand() % range + 1;
+    return Random::local().nextInt(range + 1);
 }
 
+/** Returns a random number between start (inclusive) and end (inclusive). */
 inline int random (int start, int end) {
-    return start + random(end - start + 1);
+    return start + Random::local().nextInt(end - start + 1);
 }
 
 inline bool randomBoolean () {
-    return std::rand() % 2;
+    return Random::local().nextBoolean();
 }
 
+/** Returns a random number between 0 (inclusive) and 1 (exclusive). */
 inline float random () {
-    return ( std::rand() / (static_cast<float>(RAND_MAX) + 1.0f));
+    return Random::local().nextFloat();
 }
 
 inline float random (float range) {
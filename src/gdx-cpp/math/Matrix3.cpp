@@ -25,6 +25,7 @@
 #include "gdx-cpp/Gdx.hpp"
 #include "gdx-cpp/Application.hpp"
 #include "Vector3.hpp"
+#include "detail/MatrixKernels.hpp"
 #include <string.h>
 
 using namespace gdx_cpp::math;
@@ -38,6 +39,7 @@ Matrix3::Matrix3()
 
 Matrix3::Matrix3(const Matrix3& other)
 {
+    set(other);
 }
 
 Matrix3::~Matrix3()
@@ -46,7 +48,7 @@ Matrix3::~Matrix3()
 
 Matrix3& Matrix3::operator=(const Matrix3& other)
 {
-    return *this;
+    return set(other);
 }
 
 bool Matrix3::operator==(const Matrix3& other) const
@@ -54,7 +56,7 @@ bool Matrix3::operator==(const Matrix3& other) const
     if (this == &other)
         return true;
 
-    return memcmp(this->vals, other.vals, 9) == 0;
+    return memcmp(this->vals, other.vals, sizeof(vals)) == 0;
 }
 
 Matrix3& Matrix3::idt() {
@@ -99,6 +101,13 @@ Matrix3& Matrix3::mul(const Matrix3& m) {
     return *this;
 }
 
+/** Multiplies this matrix with the given one, assuming both are affine (bottom row 0, 0, 1). Cheaper than {@link #mul}
+ * for 2D scene graph transforms. */
+Matrix3& Matrix3::mulAffine(const Matrix3& m) {
+    detail::scalar::mulAffine3x3(vals, m.vals);
+    return *this;
+}
+
 Matrix3& Matrix3::setToRotation(float angle) {
     angle = DEGREE_TO_RAD * angle;
     float cos = (float)std::cos(angle);
@@ -151,6 +160,32 @@ Matrix3& Matrix3::setToScaling(float sx, float sy) {
     return *this;
 }
 
+/** Sets this matrix to translation(x + originX, y + originY) * rotation * scaling * translation(-originX, -originY) in a
+ * single pass, rotation in degrees. */
+Matrix3& Matrix3::setToAffine(float x, float y, float originX, float originY, float rotation, float scaleX, float scaleY) {
+    float cos = 1;
+    float sin = 0;
+    if (rotation != 0) {
+        rotation = DEGREE_TO_RAD * rotation;
+        cos = (float)std::cos(rotation);
+        sin = (float)std::sin(rotation);
+    }
+
+    this->vals[0] = cos * scaleX;
+    this->vals[1] = sin * scaleX;
+    this->vals[2] = 0;
+
+    this->vals[3] = -sin * scaleY;
+    this->vals[4] = cos * scaleY;
+    this->vals[5] = 0;
+
+    this->vals[6] = x + originX - (vals[0] * originX + vals[3] * originY);
+    this->vals[7] = y + originY - (vals[1] * originX + vals[4] * originY);
+    this->vals[8] = 1;
+
+    return *this;
+}
+
 std::string Matrix3::toString() {
     std::stringstream ss;
     ss << "[" << vals[0] << "|" << vals[3] << "|" << vals[6] << "]\n" << "[" << vals[1] << "|" << vals[4] << "|" << vals[7] << "]\n" << "["
@@ -225,6 +260,10 @@ float* Matrix3::getValues() {
     return vals;
 }
 
+void Matrix3::mulVec (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride) {
+    detail::simd::mulVec3x3(mat, src, dst, numVecs, srcStride, dstStride);
+}
+
 
 
 
@@ -37,9 +37,11 @@ public:
 
     Matrix3& idt();
     Matrix3& mul(const Matrix3& m);
+    Matrix3& mulAffine(const Matrix3& m);
     Matrix3& setToRotation(float angle);
     Matrix3& setToTranslation(float x, float y);
     Matrix3& setToScaling(float sx, float sy);
+    Matrix3& setToAffine(float x, float y, float originX, float originY, float rotation, float scaleX, float scaleY);
     std::string toString();
     float det();
     Matrix3& inv();
@@ -48,6 +50,9 @@ public:
     Matrix3& trn(float x, float y);
     float* getValues();
 
+    /** Transforms numVecs 2D points read from src into dst, treating mat as an affine transform. Strides are in floats,
+     * src and dst may alias if the strides match. */
+    static void mulVec (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride);
 
     const static int length = 9;
     float vals[length];
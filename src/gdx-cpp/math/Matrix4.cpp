@@ -19,6 +19,7 @@
 #include "Matrix3.hpp"
 #include "MathUtils.hpp"
 #include "Quaternion.hpp"
+#include "detail/MatrixKernels.hpp"
 
 #include <string>
 #include <sstream>
@@ -29,8 +30,6 @@
 
 using namespace gdx_cpp::math;
 
-float _tmp[16];
-
 Matrix4::Matrix4(const Matrix4& other)
 {
   this->set(other);
@@ -135,8 +134,8 @@ void Matrix4::set(Vector3& xAxis, Vector3& yAxis, Vector3& zAxis, const Vector3&
     val[M33] = 1;
 }
  
-Matrix4::ptr Matrix4::cpy() {
-    return Matrix4::ptr(new Matrix4(*this));
+Matrix4 Matrix4::cpy() {
+    return Matrix4(*this);
 }
 
 Matrix4& Matrix4::trn(const Vector3& vector) {
@@ -158,59 +157,30 @@ float* Matrix4::getValues() {
 }
 
 Matrix4& Matrix4::mul(const Matrix4& matrix) {
-    _tmp[M00] = val[M00] * matrix.val[M00] + val[M01] * matrix.val[M10] + val[M02] * matrix.val[M20] + val[M03]
-                 * matrix.val[M30];
-    _tmp[M01] = val[M00] * matrix.val[M01] + val[M01] * matrix.val[M11] + val[M02] * matrix.val[M21] + val[M03]
-                 * matrix.val[M31];
-    _tmp[M02] = val[M00] * matrix.val[M02] + val[M01] * matrix.val[M12] + val[M02] * matrix.val[M22] + val[M03]
-                 * matrix.val[M32];
-    _tmp[M03] = val[M00] * matrix.val[M03] + val[M01] * matrix.val[M13] + val[M02] * matrix.val[M23] + val[M03]
-                 * matrix.val[M33];
-    _tmp[M10] = val[M10] * matrix.val[M00] + val[M11] * matrix.val[M10] + val[M12] * matrix.val[M20] + val[M13]
-                 * matrix.val[M30];
-    _tmp[M11] = val[M10] * matrix.val[M01] + val[M11] * matrix.val[M11] + val[M12] * matrix.val[M21] + val[M13]
-                 * matrix.val[M31];
-    _tmp[M12] = val[M10] * matrix.val[M02] + val[M11] * matrix.val[M12] + val[M12] * matrix.val[M22] + val[M13]
-                 * matrix.val[M32];
-    _tmp[M13] = val[M10] * matrix.val[M03] + val[M11] * matrix.val[M13] + val[M12] * matrix.val[M23] + val[M13]
-                * matrix.val[M33];
-    _tmp[M20] = val[M20] * matrix.val[M00] + val[M21] * matrix.val[M10] + val[M22] * matrix.val[M20] + val[M23]
-                * matrix.val[M30];
-    _tmp[M21] = val[M20] * matrix.val[M01] + val[M21] * matrix.val[M11] + val[M22] * matrix.val[M21] + val[M23]
-                * matrix.val[M31];
-    _tmp[M22] = val[M20] * matrix.val[M02] + val[M21] * matrix.val[M12] + val[M22] * matrix.val[M22] + val[M23]
-                 * matrix.val[M32];
-    _tmp[M23] = val[M20] * matrix.val[M03] + val[M21] * matrix.val[M13] + val[M22] * matrix.val[M23] + val[M23]
-                 * matrix.val[M33];
-    _tmp[M30] = val[M30] * matrix.val[M00] + val[M31] * matrix.val[M10] + val[M32] * matrix.val[M20] + val[M33]
-                * matrix.val[M30];
-    _tmp[M31] = val[M30] * matrix.val[M01] + val[M31] * matrix.val[M11] + val[M32] * matrix.val[M21] + val[M33]
-                * matrix.val[M31];
-    _tmp[M32] = val[M30] * matrix.val[M02] + val[M31] * matrix.val[M12] + val[M32] * matrix.val[M22] + val[M33]
-                * matrix.val[M32];
-    _tmp[M33] = val[M30] * matrix.val[M03] + val[M31] * matrix.val[M13] + val[M32] * matrix.val[M23] + val[M33]
-                 * matrix.val[M33];
-    return this->set(_tmp);
+    // the compiler vectorizes the scalar kernel well enough that simd::mul4x4 measures slower, see matrix4/mul
+    detail::scalar::mul4x4(val, matrix.val);
+    return *this;
 }
 
 Matrix4& Matrix4::tra() {
-    _tmp[M00] = val[M00];
-    _tmp[M01] = val[M10];
-    _tmp[M02] = val[M20];
-    _tmp[M03] = val[M30];
-    _tmp[M10] = val[M01];
-    _tmp[M11] = val[M11];
-    _tmp[M12] = val[M21];
-    _tmp[M13] = val[M31];
-    _tmp[M20] = val[M02];
-    _tmp[M21] = val[M12];
-    _tmp[M22] = val[M22];
-    _tmp[M23] = val[M32];
-    _tmp[M30] = val[M03];
-    _tmp[M31] = val[M13];
-    _tmp[M32] = val[M23];
-    _tmp[M33] = val[M33];
-    return this->set(_tmp);
+    float tmp[16];
+    tmp[M00] = val[M00];
+    tmp[M01] = val[M10];
+    tmp[M02] = val[M20];
+    tmp[M03] = val[M30];
+    tmp[M10] = val[M01];
+    tmp[M11] = val[M11];
+    tmp[M12] = val[M21];
+    tmp[M13] = val[M31];
+    tmp[M20] = val[M02];
+    tmp[M21] = val[M12];
+    tmp[M22] = val[M22];
+    tmp[M23] = val[M32];
+    tmp[M30] = val[M03];
+    tmp[M31] = val[M13];
+    tmp[M32] = val[M23];
+    tmp[M33] = val[M33];
+    return this->set(tmp);
 }
 
 /** Sets the matrix to an identity matrix
@@ -237,68 +207,10 @@ Matrix4& Matrix4::idt() {
 }
 
 Matrix4& Matrix4::inv() {
-    float l_det = val[M30] * val[M21] * val[M12] * val[M03] - val[M20] * val[M31] * val[M12] * val[M03] - val[M30] * val[M11]
-                  * val[M22] * val[M03] + val[M10] * val[M31] * val[M22] * val[M03] + val[M20] * val[M11] * val[M32] * val[M03] - val[M10]
-                  * val[M21] * val[M32] * val[M03] - val[M30] * val[M21] * val[M02] * val[M13] + val[M20] * val[M31] * val[M02] * val[M13]
-                  *                        + val[M30] * val[M01] * val[M22] * val[M13] - val[M00] * val[M31] * val[M22] * val[M13] - val[M20] * val[M01] * val[M32]
-                  * val[M13] + val[M00] * val[M21] * val[M32] * val[M13] + val[M30] * val[M11] * val[M02] * val[M23] - val[M10] * val[M31]
-                  * val[M02] * val[M23] - val[M30] * val[M01] * val[M12] * val[M23] + val[M00] * val[M31] * val[M12] * val[M23] + val[M10]
-                  * val[M01] * val[M32] * val[M23] - val[M00] * val[M11] * val[M32] * val[M23] - val[M20] * val[M11] * val[M02] * val[M33]
-                  *                        + val[M10] * val[M21] * val[M02] * val[M33] + val[M20] * val[M01] * val[M12] * val[M33] - val[M00] * val[M21] * val[M12]
-                  * val[M33] - val[M10] * val[M01] * val[M22] * val[M33] + val[M00] * val[M11] * val[M22] * val[M33];
-    if (l_det == 0) {
+    if (!detail::simd::inv4x4(val)) {
       std::cerr << "non-invertible matrix" << std::endl;
       assert(false);
     }
-    float inv_det = 1.0f / l_det;
-    _tmp[M00] = val[M12] * val[M23] * val[M31] - val[M13] * val[M22] * val[M31] + val[M13] * val[M21] * val[M32] - val[M11]
-                * val[M23] * val[M32] - val[M12] * val[M21] * val[M33] + val[M11] * val[M22] * val[M33];
-    _tmp[M01] = val[M03] * val[M22] * val[M31] - val[M02] * val[M23] * val[M31] - val[M03] * val[M21] * val[M32] + val[M01]
-                * val[M23] * val[M32] + val[M02] * val[M21] * val[M33] - val[M01] * val[M22] * val[M33];
-    _tmp[M02] = val[M02] * val[M13] * val[M31] - val[M03] * val[M12] * val[M31] + val[M03] * val[M11] * val[M32] - val[M01]
-                * val[M13] * val[M32] - val[M02] * val[M11] * val[M33] + val[M01] * val[M12] * val[M33];
-    _tmp[M03] = val[M03] * val[M12] * val[M21] - val[M02] * val[M13] * val[M21] - val[M03] * val[M11] * val[M22] + val[M01]
-                * val[M13] * val[M22] + val[M02] * val[M11] * val[M23] - val[M01] * val[M12] * val[M23];
-    _tmp[M10] = val[M13] * val[M22] * val[M30] - val[M12] * val[M23] * val[M30] - val[M13] * val[M20] * val[M32] + val[M10]
-                * val[M23] * val[M32] + val[M12] * val[M20] * val[M33] - val[M10] * val[M22] * val[M33];
-    _tmp[M11] = val[M02] * val[M23] * val[M30] - val[M03] * val[M22] * val[M30] + val[M03] * val[M20] * val[M32] - val[M00]
-                * val[M23] * val[M32] - val[M02] * val[M20] * val[M33] + val[M00] * val[M22] * val[M33];
-    _tmp[M12] = val[M03] * val[M12] * val[M30] - val[M02] * val[M13] * val[M30] - val[M03] * val[M10] * val[M32] + val[M00]
-                * val[M13] * val[M32] + val[M02] * val[M10] * val[M33] - val[M00] * val[M12] * val[M33];
-    _tmp[M13] = val[M02] * val[M13] * val[M20] - val[M03] * val[M12] * val[M20] + val[M03] * val[M10] * val[M22] - val[M00]
-                * val[M13] * val[M22] - val[M02] * val[M10] * val[M23] + val[M00] * val[M12] * val[M23];
-    _tmp[M20] = val[M11] * val[M23] * val[M30] - val[M13] * val[M21] * val[M30] + val[M13] * val[M20] * val[M31] - val[M10]
-                * val[M23] * val[M31] - val[M11] * val[M20] * val[M33] + val[M10] * val[M21] * val[M33];
-    _tmp[M21] = val[M03] * val[M21] * val[M30] - val[M01] * val[M23] * val[M30] - val[M03] * val[M20] * val[M31] + val[M00]
-                * val[M23] * val[M31] + val[M01] * val[M20] * val[M33] - val[M00] * val[M21] * val[M33];
-    _tmp[M22] = val[M01] * val[M13] * val[M30] - val[M03] * val[M11] * val[M30] + val[M03] * val[M10] * val[M31] - val[M00]
-                * val[M13] * val[M31] - val[M01] * val[M10] * val[M33] + val[M00] * val[M11] * val[M33];
-    _tmp[M23] = val[M03] * val[M11] * val[M20] - val[M01] * val[M13] * val[M20] - val[M03] * val[M10] * val[M21] + val[M00]
-                * val[M13] * val[M21] + val[M01] * val[M10] * val[M23] - val[M00] * val[M11] * val[M23];
-    _tmp[M30] = val[M12] * val[M21] * val[M30] - val[M11] * val[M22] * val[M30] - val[M12] * val[M20] * val[M31] + val[M10]
-                * val[M22] * val[M31] + val[M11] * val[M20] * val[M32] - val[M10] * val[M21] * val[M32];
-    _tmp[M31] = val[M01] * val[M22] * val[M30] - val[M02] * val[M21] * val[M30] + val[M02] * val[M20] * val[M31] - val[M00]
-                * val[M22] * val[M31] - val[M01] * val[M20] * val[M32] + val[M00] * val[M21] * val[M32];
-    _tmp[M32] = val[M02] * val[M11] * val[M30] - val[M01] * val[M12] * val[M30] - val[M02] * val[M10] * val[M31] + val[M00]
-                * val[M12] * val[M31] + val[M01] * val[M10] * val[M32] - val[M00] * val[M11] * val[M32];
-    _tmp[M33] = val[M01] * val[M12] * val[M20] - val[M02] * val[M11] * val[M20] + val[M02] * val[M10] * val[M21] - val[M00]
-                * val[M12] * val[M21] - val[M01] * val[M10] * val[M22] + val[M00] * val[M11] * val[M22];
-    val[M00] = _tmp[M00] * inv_det;
-    val[M01] = _tmp[M01] * inv_det;
-    val[M02] = _tmp[M02] * inv_det;
-    val[M03] = _tmp[M03] * inv_det;
-    val[M10] = _tmp[M10] * inv_det;
-    val[M11] = _tmp[M11] * inv_det;
-    val[M12] = _tmp[M12] * inv_det;
-    val[M13] = _tmp[M13] * inv_det;
-    val[M20] = _tmp[M20] * inv_det;
-    val[M21] = _tmp[M21] * inv_det;
-    val[M22] = _tmp[M22] * inv_det;
-    val[M23] = _tmp[M23] * inv_det;
-    val[M30] = _tmp[M30] * inv_det;
-    val[M31] = _tmp[M31] * inv_det;
-    val[M32] = _tmp[M32] * inv_det;
-    val[M33] = _tmp[M33] * inv_det;
     return *this;
 }
 
@@ -306,11 +218,11 @@ float Matrix4::det() {
     return val[M30] * val[M21] * val[M12] * val[M03] - val[M20] * val[M31] * val[M12] * val[M03] - val[M30] * val[M11]
            * val[M22] * val[M03] + val[M10] * val[M31] * val[M22] * val[M03] + val[M20] * val[M11] * val[M32] * val[M03] - val[M10]
            * val[M21] * val[M32] * val[M03] - val[M30] * val[M21] * val[M02] * val[M13] + val[M20] * val[M31] * val[M02] * val[M13]
-           *                        + val[M30] * val[M01] * val[M22] * val[M13] - val[M00] * val[M31] * val[M22] * val[M13] - val[M20] * val[M01] * val[M32]
+           + val[M30] * val[M01] * val[M22] * val[M13] - val[M00] * val[M31] * val[M22] * val[M13] - val[M20] * val[M01] * val[M32]
            * val[M13] + val[M00] * val[M21] * val[M32] * val[M13] + val[M30] * val[M11] * val[M02] * val[M23] - val[M10] * val[M31]
            * val[M02] * val[M23] - val[M30] * val[M01] * val[M12] * val[M23] + val[M00] * val[M31] * val[M12] * val[M23] + val[M10]
            * val[M01] * val[M32] * val[M23] - val[M00] * val[M11] * val[M32] * val[M23] - val[M20] * val[M11] * val[M02] * val[M33]
-           *                        + val[M10] * val[M21] * val[M02] * val[M33] + val[M20] * val[M01] * val[M12] * val[M33] - val[M00] * val[M21] * val[M12]
+           + val[M10] * val[M21] * val[M02] * val[M33] + val[M20] * val[M01] * val[M12] * val[M33] - val[M00] * val[M21] * val[M12]
            * val[M33] - val[M10] * val[M01] * val[M22] * val[M33] + val[M00] * val[M11] * val[M22] * val[M33];
 }
 
@@ -418,24 +330,23 @@ Matrix4& Matrix4::setToTranslationAndScaling (float translationX, float translat
     return *this;
 }
 
-static Quaternion quat;
-
 Matrix4& Matrix4::setToRotation(Vector3 axis, float angle) {
     idt();
     if (angle == 0) return *this;
+    Quaternion quat;
     return this->set(quat.set(axis, angle));
 }
 
-static Vector3 tmpV;
-
 Matrix4& Matrix4::setToRotation(float axisX, float axisY, float axisZ, float angle) {
     idt();
     if (angle == 0) return *this;
-    return this->set(quat.set(tmpV.set(axisX, axisY, axisZ), angle));
+    Quaternion quat;
+    return this->set(quat.set(Vector3(axisX, axisY, axisZ), angle));
 }
 
 Matrix4& Matrix4::setFromEulerAngles(float yaw, float pitch, float roll) {
     idt();
+    Quaternion quat;
     quat.setEulerAngles(yaw, pitch, roll);
     return this->set(quat);
 }
@@ -456,15 +367,14 @@ Matrix4& Matrix4::setToScaling(float x, float y, float z) {
     return *this;
 }
 
-static Vector3 l_vez;
-static Vector3 l_vex;
-static Vector3 l_vey;
-
 Matrix4& Matrix4::setToLookAt(const Vector3& direction, const Vector3& up) {
-    l_vez.set(direction).nor();
-    l_vex.set(direction).nor();
+    Vector3 l_vez(direction);
+    l_vez.nor();
+    Vector3 l_vex(direction);
+    l_vex.nor();
     l_vex.crs(up).nor();
-    l_vey.set(l_vex).crs(l_vez).nor();
+    Vector3 l_vey(l_vex);
+    l_vey.crs(l_vez).nor();
     idt();
     val[M00] = l_vex.x;
     val[M01] = l_vex.y;
@@ -479,25 +389,22 @@ Matrix4& Matrix4::setToLookAt(const Vector3& direction, const Vector3& up) {
     return *this;
 }
 
-static Vector3 tmpVec;
-static Matrix4 tmpMat;
-
 Matrix4& Matrix4::setToLookAt(Vector3& position, const Vector3& target, const Vector3& up) {
-    tmpVec.set(target).sub(position);
-    setToLookAt(tmpVec, up);
-    this->mul(tmpMat.setToTranslation(position.tmp().mul(-1)));
+    Vector3 tmpVec(target);
+    setToLookAt(tmpVec.sub(position), up);
+    Matrix4 tmpMat;
+    this->mul(tmpMat.setToTranslation(-position.x, -position.y, -position.z));
 
     return *this;
 }
 
-static Vector3 right;
-static Vector3 tmpForward;
-static Vector3 tmpUp;
-
 Matrix4& Matrix4::setToWorld(const Vector3& position, const Vector3& forward, const Vector3& up) {
-    tmpForward.set(forward).nor();
-    right.set(tmpForward).crs(up).nor();
-    tmpUp.set(right).crs(tmpForward).nor();
+    Vector3 tmpForward(forward);
+    tmpForward.nor();
+    Vector3 right(tmpForward);
+    right.crs(up).nor();
+    Vector3 tmpUp(right);
+    tmpUp.crs(tmpForward).nor();
 
     this->set(right, tmpUp, tmpForward, position);
     return *this;
@@ -563,24 +470,7 @@ Matrix4& Matrix4::toNormalMatrix() {
 }
 
 void Matrix4::mul (float* mata, float* matb) {
-    float tmp[16];
-    tmp[M00] = mata[M00] * matb[M00] + mata[M01] * matb[M10] + mata[M02] * matb[M20] + mata[M03] * matb[M30];
-    tmp[M01] = mata[M00] * matb[M01] + mata[M01] * matb[M11] + mata[M02] * matb[M21] + mata[M03] * matb[M31];
-    tmp[M02] = mata[M00] * matb[M02] + mata[M01] * matb[M12] + mata[M02] * matb[M22] + mata[M03] * matb[M32];
-    tmp[M03] = mata[M00] * matb[M03] + mata[M01] * matb[M13] + mata[M02] * matb[M23] + mata[M03] * matb[M33];
-    tmp[M10] = mata[M10] * matb[M00] + mata[M11] * matb[M10] + mata[M12] * matb[M20] + mata[M13] * matb[M30];
-    tmp[M11] = mata[M10] * matb[M01] + mata[M11] * matb[M11] + mata[M12] * matb[M21] + mata[M13] * matb[M31];
-    tmp[M12] = mata[M10] * matb[M02] + mata[M11] * matb[M12] + mata[M12] * matb[M22] + mata[M13] * matb[M32];
-    tmp[M13] = mata[M10] * matb[M03] + mata[M11] * matb[M13] + mata[M12] * matb[M23] + mata[M13] * matb[M33];
-    tmp[M20] = mata[M20] * matb[M00] + mata[M21] * matb[M10] + mata[M22] * matb[M20] + mata[M23] * matb[M30];
-    tmp[M21] = mata[M20] * matb[M01] + mata[M21] * matb[M11] + mata[M22] * matb[M21] + mata[M23] * matb[M31];
-    tmp[M22] = mata[M20] * matb[M02] + mata[M21] * matb[M12] + mata[M22] * matb[M22] + mata[M23] * matb[M32];
-    tmp[M23] = mata[M20] * matb[M03] + mata[M21] * matb[M13] + mata[M22] * matb[M23] + mata[M23] * matb[M33];
-    tmp[M30] = mata[M30] * matb[M00] + mata[M31] * matb[M10] + mata[M32] * matb[M20] + mata[M33] * matb[M30];
-    tmp[M31] = mata[M30] * matb[M01] + mata[M31] * matb[M11] + mata[M32] * matb[M21] + mata[M33] * matb[M31];
-    tmp[M32] = mata[M30] * matb[M02] + mata[M31] * matb[M12] + mata[M32] * matb[M22] + mata[M33] * matb[M32];
-    tmp[M33] = mata[M30] * matb[M03] + mata[M31] * matb[M13] + mata[M32] * matb[M23] + mata[M33] * matb[M33];
-    memcpy(mata, tmp, sizeof(float) *  16);
+    detail::scalar::mul4x4(mata, matb);
 }
 
 void Matrix4::mulVec (float* mat, float* vec) {
@@ -593,11 +483,11 @@ void Matrix4::mulVec (float* mat, float* vec) {
 }
 
 void Matrix4::mulVec (float* mat, float* vecs, int offset, int numVecs, int stride) {
-    float* vecPtr = vecs + offset;
-    for (int i = 0; i < numVecs; i++) {
-        mulVec(mat, vecPtr);
-        vecPtr += stride;
-    }
+    detail::simd::mulVec4x4(mat, vecs + offset, vecs + offset, numVecs, stride, stride);
+}
+
+void Matrix4::mulVec (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride) {
+    detail::simd::mulVec4x4(mat, src, dst, numVecs, srcStride, dstStride);
 }
 
 void Matrix4::prj (const float* mat, float* vec) {
@@ -611,11 +501,11 @@ void Matrix4::prj (const float* mat, float* vec) {
 }
 
 void Matrix4::prj (const float* mat, float* vecs, int offset, int numVecs, int stride)  {
-    float* vecPtr = vecs + offset;
-    for (int i = 0; i < numVecs; i++) {
-        prj(mat, vecPtr);
-        vecPtr += stride;
-    }
+    detail::simd::prj4x4(mat, vecs + offset, vecs + offset, numVecs, stride, stride);
+}
+
+void Matrix4::prj (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride) {
+    detail::simd::prj4x4(mat, src, dst, numVecs, srcStride, dstStride);
 }
 
 void Matrix4::rot (float* mat, float* vec) {
@@ -628,80 +518,26 @@ void Matrix4::rot (float* mat, float* vec) {
 }
 
 void Matrix4::rot (float* mat, float* vecs, int offset, int numVecs, int stride)  {
-    float* vecPtr = vecs + offset;
-    for (int i = 0; i < numVecs; i++) {
-        rot(mat, vecPtr);
-        vecPtr += stride;
-    }
+    detail::simd::rot4x4(mat, vecs + offset, vecs + offset, numVecs, stride, stride);
+}
+
+void Matrix4::rot (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride) {
+    detail::simd::rot4x4(mat, src, dst, numVecs, srcStride, dstStride);
 }
 
 float Matrix4::det (float* val) {
   return val[M30] * val[M21] * val[M12] * val[M03] - val[M20] * val[M31] * val[M12] * val[M03] - val[M30] * val[M11]
   * val[M22] * val[M03] + val[M10] * val[M31] * val[M22] * val[M03] + val[M20] * val[M11] * val[M32] * val[M03] - val[M10]
   * val[M21] * val[M32] * val[M03] - val[M30] * val[M21] * val[M02] * val[M13] + val[M20] * val[M31] * val[M02] * val[M13]
-  *          + val[M30] * val[M01] * val[M22] * val[M13] - val[M00] * val[M31] * val[M22] * val[M13] - val[M20] * val[M01] * val[M32]
+  + val[M30] * val[M01] * val[M22] * val[M13] - val[M00] * val[M31] * val[M22] * val[M13] - val[M20] * val[M01] * val[M32]
   * val[M13] + val[M00] * val[M21] * val[M32] * val[M13] + val[M30] * val[M11] * val[M02] * val[M23] - val[M10] * val[M31]
   * val[M02] * val[M23] - val[M30] * val[M01] * val[M12] * val[M23] + val[M00] * val[M31] * val[M12] * val[M23] + val[M10]
   * val[M01] * val[M32] * val[M23] - val[M00] * val[M11] * val[M32] * val[M23] - val[M20] * val[M11] * val[M02] * val[M33]
-  *          + val[M10] * val[M21] * val[M02] * val[M33] + val[M20] * val[M01] * val[M12] * val[M33] - val[M00] * val[M21] * val[M12]
+  + val[M10] * val[M21] * val[M02] * val[M33] + val[M20] * val[M01] * val[M12] * val[M33] - val[M00] * val[M21] * val[M12]
   * val[M33] - val[M10] * val[M01] * val[M22] * val[M33] + val[M00] * val[M11] * val[M22] * val[M33];
 }
 
 bool Matrix4::inv (float* val) {
-    float tmp[16];
-    float l_det = det(val);
-    if (l_det == 0) return false;
-
-    tmp[M00] = val[M12] * val[M23] * val[M31] - val[M13] * val[M22] * val[M31] + val[M13] * val[M21] * val[M32] - val[M11]
-               * val[M23] * val[M32] - val[M12] * val[M21] * val[M33] + val[M11] * val[M22] * val[M33];
-    tmp[M01] = val[M03] * val[M22] * val[M31] - val[M02] * val[M23] * val[M31] - val[M03] * val[M21] * val[M32] + val[M01]
-               * val[M23] * val[M32] + val[M02] * val[M21] * val[M33] - val[M01] * val[M22] * val[M33];
-    tmp[M02] = val[M02] * val[M13] * val[M31] - val[M03] * val[M12] * val[M31] + val[M03] * val[M11] * val[M32] - val[M01]
-               * val[M13] * val[M32] - val[M02] * val[M11] * val[M33] + val[M01] * val[M12] * val[M33];
-    tmp[M03] = val[M03] * val[M12] * val[M21] - val[M02] * val[M13] * val[M21] - val[M03] * val[M11] * val[M22] + val[M01]
-               * val[M13] * val[M22] + val[M02] * val[M11] * val[M23] - val[M01] * val[M12] * val[M23];
-    tmp[M10] = val[M13] * val[M22] * val[M30] - val[M12] * val[M23] * val[M30] - val[M13] * val[M20] * val[M32] + val[M10]
-               * val[M23] * val[M32] + val[M12] * val[M20] * val[M33] - val[M10] * val[M22] * val[M33];
-    tmp[M11] = val[M02] * val[M23] * val[M30] - val[M03] * val[M22] * val[M30] + val[M03] * val[M20] * val[M32] - val[M00]
-               * val[M23] * val[M32] - val[M02] * val[M20] * val[M33] + val[M00] * val[M22] * val[M33];
-    tmp[M12] = val[M03] * val[M12] * val[M30] - val[M02] * val[M13] * val[M30] - val[M03] * val[M10] * val[M32] + val[M00]
-               * val[M13] * val[M32] + val[M02] * val[M10] * val[M33] - val[M00] * val[M12] * val[M33];
-    tmp[M13] = val[M02] * val[M13] * val[M20] - val[M03] * val[M12] * val[M20] + val[M03] * val[M10] * val[M22] - val[M00]
-               * val[M13] * val[M22] - val[M02] * val[M10] * val[M23] + val[M00] * val[M12] * val[M23];
-    tmp[M20] = val[M11] * val[M23] * val[M30] - val[M13] * val[M21] * val[M30] + val[M13] * val[M20] * val[M31] - val[M10]
-               * val[M23] * val[M31] - val[M11] * val[M20] * val[M33] + val[M10] * val[M21] * val[M33];
-    tmp[M21] = val[M03] * val[M21] * val[M30] - val[M01] * val[M23] * val[M30] - val[M03] * val[M20] * val[M31] + val[M00]
-               * val[M23] * val[M31] + val[M01] * val[M20] * val[M33] - val[M00] * val[M21] * val[M33];
-    tmp[M22] = val[M01] * val[M13] * val[M30] - val[M03] * val[M11] * val[M30] + val[M03] * val[M10] * val[M31] - val[M00]
-               * val[M13] * val[M31] - val[M01] * val[M10] * val[M33] + val[M00] * val[M11] * val[M33];
-    tmp[M23] = val[M03] * val[M11] * val[M20] - val[M01] * val[M13] * val[M20] - val[M03] * val[M10] * val[M21] + val[M00]
-               * val[M13] * val[M21] + val[M01] * val[M10] * val[M23] - val[M00] * val[M11] * val[M23];
-    tmp[M30] = val[M12] * val[M21] * val[M30] - val[M11] * val[M22] * val[M30] - val[M12] * val[M20] * val[M31] + val[M10]
-               * val[M22] * val[M31] + val[M11] * val[M20] * val[M32] - val[M10] * val[M21] * val[M32];
-    tmp[M31] = val[M01] * val[M22] * val[M30] - val[M02] * val[M21] * val[M30] + val[M02] * val[M20] * val[M31] - val[M00]
-               * val[M22] * val[M31] - val[M01] * val[M20] * val[M32] + val[M00] * val[M21] * val[M32];
-    tmp[M32] = val[M02] * val[M11] * val[M30] - val[M01] * val[M12] * val[M30] - val[M02] * val[M10] * val[M31] + val[M00]
-               * val[M12] * val[M31] + val[M01] * val[M10] * val[M32] - val[M00] * val[M11] * val[M32];
-    tmp[M33] = val[M01] * val[M12] * val[M20] - val[M02] * val[M11] * val[M20] + val[M02] * val[M10] * val[M21] - val[M00]
-               * val[M12] * val[M21] - val[M01] * val[M10] * val[M22] + val[M00] * val[M11] * val[M22];
-
-    float inv_det = 1.0f / l_det;
-    val[M00] = tmp[M00] * inv_det;
-    val[M01] = tmp[M01] * inv_det;
-    val[M02] = tmp[M02] * inv_det;
-    val[M03] = tmp[M03] * inv_det;
-    val[M10] = tmp[M10] * inv_det;
-    val[M11] = tmp[M11] * inv_det;
-    val[M12] = tmp[M12] * inv_det;
-    val[M13] = tmp[M13] * inv_det;
-    val[M20] = tmp[M20] * inv_det;
-    val[M21] = tmp[M21] * inv_det;
-    val[M22] = tmp[M22] * inv_det;
-    val[M23] = tmp[M23] * inv_det;
-    val[M30] = tmp[M30] * inv_det;
-    val[M31] = tmp[M31] * inv_det;
-    val[M32] = tmp[M32] * inv_det;
-    val[M33] = tmp[M33] * inv_det;
-    return true;
+    return detail::simd::inv4x4(val);
 }
 
@@ -62,7 +62,7 @@ public:
     Matrix4& set(const float* values);
     Matrix4& set(const Quaternion& quaternion);
     void set(Vector3& xAxis, Vector3& yAxis, Vector3& zAxis, const Vector3& pos);
-    Matrix4::ptr cpy();
+    Matrix4 cpy();
     Matrix4& trn(const Vector3& vector);
     Matrix4& trn(float x, float y, float z);
     float* getValues();
@@ -104,6 +104,12 @@ public:
     static void prj (const float* mat, float* vec);
     static void mulVec (float* mat, float* vecs, int offset, int numVecs, int stride);
     static void mulVec (float* mat, float* vec);
+
+    /** Batched versions reading the vectors from src and writing them to dst, e.g. to transform model space vertices
+     * into a separate vertex buffer. Only x, y and z are written; src and dst may alias if the strides match. */
+    static void rot (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride);
+    static void prj (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride);
+    static void mulVec (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride);
     static void mul (float* mata, float* matb);
 
     const static int length = 16;
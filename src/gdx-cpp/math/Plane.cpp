@@ -29,8 +29,8 @@ Plane::Plane (const Vector3& normal, float d) : d(d) {
 }
 
 void Plane::set (const Vector3& point1,const Vector3& point2,const Vector3& point3) {
-    Vector3 l = point1.tmp().sub(point2);
-    Vector3 r = point2.tmp2().sub(point3);
+    Vector3 l = Vector3(point1).sub(point2);
+    Vector3 r = Vector3(point2).sub(point3);
     Vector3 nor = l.crs(r).nor();
     normal.set(nor);
     d = -point1.dot(nor);
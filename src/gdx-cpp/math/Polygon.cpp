@@ -18,27 +18,29 @@
     @author Ozires Bortolon de Faria ozires@aevumlab.com
 */
 
+
 #include "Polygon.hpp"
 
 #include <cassert>
 #include <iostream>
 
-#include "MathUtils.hpp"
-#include "gdx-cpp/Gdx.hpp"
-#include "gdx-cpp/Application.hpp"
+#include "Matrix3.hpp"
+#include "gdx-cpp/utils/Simd.hpp"
 
 using namespace gdx_cpp::math;
 
 Polygon::Polygon(const std::vector< float >& vertices)
-  : vertices(vertices)
+  : localVertices(vertices)
   , x(0)
   , y(0)
   , originX(0)
   , originY(0)
   , rotation(0)
   , scaleX(1)
-  , scaleY(1)  
-  , dirty(false)
+  , scaleY(1)
+  , verticesDirty(true)
+  , boundsDirty(true)
+  , edgesDirty(true)
 {
   if (vertices.size() < 6) {
      std::cerr << "polygons must contain at least 3 points." << std::endl;
@@ -47,94 +49,87 @@ Polygon::Polygon(const std::vector< float >& vertices)
 }
 
 std::vector<float>& Polygon::getVertices () {
-    if (!dirty) return vertices;
-
-    int numFloats = vertices.size();
-
-    float translateX = x + originX;
-    float translateY = y + originY;
-    float cos = utils::cosDeg(rotation);
-    float sin = utils::sinDeg(rotation);
-    
-    float x, y;
-    
-    for (int i = 0; i < numFloats; i += 2) {
-        x = vertices[i];
-        y = vertices[i + 1];
-
-        // move vertices to local coordinates
-        x -= translateX;
-        y -= translateY;
+    return localVertices;
+}
 
-        // scale if needed
-        if (scaleX != 1 || scaleY != 1) {
-            x *= scaleX;
-            y *= scaleY;
-        }
+void Polygon::setVertices (const std::vector<float>& vertices) {
+    if (vertices.size() < 6) {
+        std::cerr << "polygons must contain at least 3 points." << std::endl;
+        assert(false);
+    }
+    localVertices = vertices;
+    dirty();
+}
 
-        // rotate if needed
-        if (rotation != 0) {
-            x = cos * x - sin * y;
-            y = sin * x + cos * y;
-        }
+const std::vector<float>& Polygon::getTransformedVertices () {
+    if (!verticesDirty) return worldVertices;
+    verticesDirty = false;
 
-        // move vertices back to world coordinates
-        x += translateX;
-        y += translateY;
+    int numFloats = localVertices.size();
+    worldVertices.resize(numFloats);
 
-        vertices[i] = x;
-        vertices[i + 1] = y;
+    if (x == 0 && y == 0 && rotation == 0 && scaleX == 1 && scaleY == 1) {
+        std::copy(localVertices.begin(), localVertices.end(), worldVertices.begin());
+        return worldVertices;
     }
 
-    dirty = false;
+    Matrix3 transform;
+    transform.setToAffine(x, y, originX, originY, rotation, scaleX, scaleY);
+    Matrix3::mulVec(transform.vals, &localVertices[0], &worldVertices[0], numFloats / 2, 2, 2);
 
-    return vertices;
+    return worldVertices;
 }
 
 void Polygon::setOrigin (float originX,float originY) {
     this->originX = originX;
     this->originY = originY;
-    dirty = true;
+    dirty();
 }
 
 void Polygon::setPosition (float x,float y) {
     this->x = x;
     this->y = y;
-    dirty = true;
+    dirty();
 }
 
 void Polygon::translate (float x,float y) {
     this->x += x;
     this->y += y;
-    dirty = true;
+    dirty();
 }
 
 void Polygon::setRotation (float degrees) {
     this->rotation = degrees;
-    dirty = true;
+    dirty();
 }
 
 void Polygon::rotate (float degrees) {
     rotation += degrees;
-    dirty = true;
+    dirty();
 }
 
 void Polygon::setScale (float scaleX,float scaleY) {
     this->scaleX = scaleX;
     this->scaleY = scaleY;
-    dirty = true;
+    dirty();
 }
 
 void Polygon::scale (float amount) {
     this->scaleX += amount;
     this->scaleY += amount;
-    dirty = true;
+    dirty();
+}
+
+void Polygon::dirty () {
+    verticesDirty = true;
+    boundsDirty = true;
+    edgesDirty = true;
 }
 
 float Polygon::area () {
     float area = 0;
 
-    const std::vector<float>& vertices = getVertices();
+    const std::vector<float>& vertices = getTransformedVertices();
     int numFloats = vertices.size();
 
     int x1, y1, x2, y2;
@@ -152,8 +147,10 @@ float Polygon::area () {
 }
 
 Rectangle& Polygon::getBoundingRectangle () {
+    if (!boundsDirty) return bounds;
+    boundsDirty = false;
 
-    const std::vector<float>& vertices = getVertices();
+    const std::vector<float>& vertices = getTransformedVertices();
 
     float minX = vertices[0];
     float minY = vertices[1];
@@ -177,22 +174,126 @@ Rectangle& Polygon::getBoundingRectangle () {
     return bounds;
 }
 
-bool Polygon::contains (float x,float y) {
-    const std::vector<float>& vertices = getVertices();
+void Polygon::updateEdges () {
+    if (!edgesDirty) return;
+    edgesDirty = false;
+
+    const std::vector<float>& vertices = getTransformedVertices();
     int numFloats = vertices.size();
-    int intersects = 0;
 
+    edges.clear();
     for (int i = 0; i < numFloats; i += 2) {
         float x1 = vertices[i];
         float y1 = vertices[i + 1];
         float x2 = vertices[(i + 2) % numFloats];
         float y2 = vertices[(i + 3) % numFloats];
-        gdx_cpp::Gdx::app->log("Poly Test: ", "Testing Point (%f,%f) against (%f %f) and (%f,%f)", x, y, x1, y1, x2, y2);
-        if (((y1 <= y && y < y2) || (y2 <= y && y < y1)) && x < ((x2 - x1) / (y2 - y1) * (y - y1) + x1)) intersects++;
+
+        // horizontal edges are never crossed
+        if (y1 == y2) continue;
+
+        edges.push_back(x1);
+        edges.push_back(y1);
+        edges.push_back(y2);
+        edges.push_back((x2 - x1) / (y2 - y1));
+    }
+}
+
+/** Counts the crossings of a ray from (x, y) towards +x with the edges */
+static inline bool isInside (const std::vector<float>& edges, float x, float y) {
+    int intersects = 0;
+    for (unsigned int i = 0; i < edges.size(); i += 4) {
+        float x1 = edges[i];
+        float y1 = edges[i + 1];
+        float y2 = edges[i + 2];
+        if (((y1 <= y && y < y2) || (y2 <= y && y < y1)) && x < (edges[i + 3] * (y - y1) + x1)) intersects++;
     }
     return (intersects & 1) == 1;
 }
 
+bool Polygon::contains (float x,float y) {
+    updateEdges();
+    return isInside(edges, x, y);
+}
+
+void Polygon::containsMany (const float* xs, const float* ys, int n, uint8_t* out) {
+    const Rectangle& bounds = getBoundingRectangle();
+    updateEdges();
+
+    const float minX = bounds.x, minY = bounds.y;
+    const float maxX = bounds.x + bounds.width, maxY = bounds.y + bounds.height;
+    int i = 0;
+#if defined(GDX_CPP_SIMD_SSE) || defined(GDX_CPP_SIMD_NEON)
+    const float* e = edges.empty() ? NULL : &edges[0];
+    const int numEdges = edges.size() / 4;
+#endif
+
+#if defined(GDX_CPP_SIMD_SSE)
+    const __m128 boundsMinX = _mm_set1_ps(minX), boundsMinY = _mm_set1_ps(minY);
+    const __m128 boundsMaxX = _mm_set1_ps(maxX), boundsMaxY = _mm_set1_ps(maxY);
+    for (; i + 4 <= n; i += 4) {
+        __m128 px = _mm_loadu_ps(xs + i);
+        __m128 py = _mm_loadu_ps(ys + i);
+        __m128 inBounds = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(px, boundsMinX), _mm_cmple_ps(px, boundsMaxX)),
+                                     _mm_and_ps(_mm_cmpge_ps(py, boundsMinY), _mm_cmple_ps(py, boundsMaxY)));
+
+        // the parity of the crossings is kept as a lane mask that each crossed edge flips
+        __m128 inside = _mm_setzero_ps();
+        if (_mm_movemask_ps(inBounds) != 0) {
+            for (int j = 0; j < numEdges; j++) {
+                const float* edge = e + j * 4;
+                __m128 y1 = _mm_set1_ps(edge[1]);
+                __m128 y2 = _mm_set1_ps(edge[2]);
+                __m128 crosses = _mm_or_ps(_mm_and_ps(_mm_cmple_ps(y1, py), _mm_cmplt_ps(py, y2)),
+                                           _mm_and_ps(_mm_cmple_ps(y2, py), _mm_cmplt_ps(py, y1)));
+                __m128 ix = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edge[3]), _mm_sub_ps(py, y1)), _mm_set1_ps(edge[0]));
+                inside = _mm_xor_ps(inside, _mm_and_ps(crosses, _mm_cmplt_ps(px, ix)));
+            }
+            inside = _mm_and_ps(inside, inBounds);
+        }
+
+        int mask = _mm_movemask_ps(inside);
+        out[i] = mask & 1;
+        out[i + 1] = (mask >> 1) & 1;
+        out[i + 2] = (mask >> 2) & 1;
+        out[i + 3] = (mask >> 3) & 1;
+    }
+#elif defined(GDX_CPP_SIMD_NEON)
+    const float32x4_t boundsMinX = vdupq_n_f32(minX), boundsMinY = vdupq_n_f32(minY);
+    const float32x4_t boundsMaxX = vdupq_n_f32(maxX), boundsMaxY = vdupq_n_f32(maxY);
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t px = vld1q_f32(xs + i);
+        float32x4_t py = vld1q_f32(ys + i);
+        uint32x4_t inBounds = vandq_u32(vandq_u32(vcgeq_f32(px, boundsMinX), vcleq_f32(px, boundsMaxX)),
+                                        vandq_u32(vcgeq_f32(py, boundsMinY), vcleq_f32(py, boundsMaxY)));
+
+        uint32x4_t inside = vdupq_n_u32(0);
+        uint32x2_t any = vorr_u32(vget_low_u32(inBounds), vget_high_u32(inBounds));
+        if ((vget_lane_u32(any, 0) | vget_lane_u32(any, 1)) != 0) {
+            for (int j = 0; j < numEdges; j++) {
+                const float* edge = e + j * 4;
+                float32x4_t y1 = vdupq_n_f32(edge[1]);
+                float32x4_t y2 = vdupq_n_f32(edge[2]);
+                uint32x4_t crosses = vorrq_u32(vandq_u32(vcleq_f32(y1, py), vcltq_f32(py, y2)),
+                                               vandq_u32(vcleq_f32(y2, py), vcltq_f32(py, y1)));
+                float32x4_t ix = vmlaq_n_f32(vdupq_n_f32(edge[0]), vsubq_f32(py, y1), edge[3]);
+                inside = veorq_u32(inside, vandq_u32(crosses, vcltq_f32(px, ix)));
+            }
+            inside = vandq_u32(inside, inBounds);
+        }
+
+        out[i] = vgetq_lane_u32(inside, 0) & 1;
+        out[i + 1] = vgetq_lane_u32(inside, 1) & 1;
+        out[i + 2] = vgetq_lane_u32(inside, 2) & 1;
+        out[i + 3] = vgetq_lane_u32(inside, 3) & 1;
+    }
+#endif
+
+    for (; i < n; i++) {
+        float x = xs[i], y = ys[i];
+        out[i] = x >= minX && x <= maxX && y >= minY && y <= maxY && isInside(edges, x, y) ? 1 : 0;
+    }
+}
+
 float Polygon::getX () {
     return x;
 }
@@ -220,4 +321,3 @@ float Polygon::getScaleX () {
 float Polygon::getScaleY () {
     return scaleY;
 }
-
@@ -21,6 +21,7 @@
 #ifndef GDX_CPP_MATH_POLYGON_HPP_
 #define GDX_CPP_MATH_POLYGON_HPP_
 
+#include <stdint.h>
 #include <vector>
 #include "Rectangle.hpp"
 
@@ -29,11 +30,18 @@ namespace math {
 
 class Rectangle;
 
+/** A polygon given by x,y pairs in local coordinates and a position, origin, rotation and scale. The transformed
+ * vertices and the bounding rectangle are computed once and cached until one of the setters changes the
+ * transformation; call {@link #dirty} after modifying the local vertices in place. */
 class Polygon {
 public:
     Polygon (const std::vector<float>& vertices);
-  
+
+    /** Returns the vertices in local coordinates */
     std::vector<float>& getVertices ();
+    void setVertices (const std::vector<float>& vertices);
+    /** Returns the vertices with the polygon's transformation applied */
+    const std::vector<float>& getTransformedVertices ();
 
     void setOrigin (float originX,float originY);
     void setPosition (float x,float y);
@@ -42,9 +50,12 @@ public:
     void rotate (float degrees);
     void setScale (float scaleX,float scaleY);
     void scale (float amount);
+    void dirty ();
     float area ();
     Rectangle& getBoundingRectangle ();
     bool contains (float x,float y);
+    /** Tests n points at once, writing 1 to out[i] if (xs[i], ys[i]) is inside the polygon and 0 otherwise */
+    void containsMany (const float* xs, const float* ys, int n, uint8_t* out);
     float getX ();
     float getY ();
     float getOriginX ();
@@ -57,12 +68,19 @@ protected:
 
 
 private:
-  std::vector<float> vertices;
+  /** Edges that can be crossed by a horizontal ray, as x1, y1, y2 and dx/dy */
+  void updateEdges ();
+
+  std::vector<float> localVertices;
+  std::vector<float> worldVertices;
+  std::vector<float> edges;
   float x, y;
   float originX, originY;
   float rotation;
   float scaleX, scaleY;
-  bool dirty;
+  bool verticesDirty;
+  bool boundsDirty;
+  bool edgesDirty;
   Rectangle bounds;
 };
 
@@ -20,6 +20,7 @@
 #include "Vector3.hpp"
 #include "Matrix4.hpp"
 #include "MathUtils.hpp"
+#include "detail/SimdLanes.hpp"
 #include <cstdlib>
 #include <cmath>
 #include <string>
@@ -27,8 +28,6 @@
 
 using namespace gdx_cpp::math;
 
-Quaternion Quaternion::tmp1(0, 0, 0, 0);
-Quaternion Quaternion::tmp2(0, 0, 0, 0);
 const float Quaternion::NORMALIZATION_TOLERANCE = 0.00001f;
 
 Quaternion::Quaternion () : x(0), y(0), z(0), w(0)
@@ -157,9 +156,9 @@ Quaternion& Quaternion::conjugate ()
 
 void Quaternion::transform (Vector3& v)
 {
-    tmp1.set(*this);
+    Quaternion tmp2(*this);
     tmp2.conjugate();
-    tmp2.mulLeft(tmp1.set(v.x, v.y, v.z, 0)).mulLeft(*this);
+    tmp2.mulLeft(Quaternion(v.x, v.y, v.z, 0)).mulLeft(*this);
     v.x = tmp2.x;
     v.y = tmp2.y;
     v.z = tmp2.z;
@@ -332,4 +331,136 @@ Quaternion& Quaternion::mul (float scalar)
     this->z *= scalar;
     this->w *= scalar;
     return *this;
-}
\ No newline at end of file
+}
+
+namespace {
+
+using gdx_cpp::math::detail::ScalarLane;
+#if defined(GDX_CPP_SIMD_SSE) || defined(GDX_CPP_SIMD_NEON)
+using gdx_cpp::math::detail::SimdLane;
+#endif
+
+/** Interpolates L::WIDTH quaternions per step, working on one register per component */
+template <class L>
+int interpolateLoop (int i, const float* start, const float* end, float* out, int count, float alpha, int stride,
+                     bool spherical) {
+    typedef typename L::F F;
+    typedef typename L::M M;
+
+    const F t = L::set(alpha), zero = L::set(0), one = L::set(1);
+    for (; i + L::WIDTH <= count; i += L::WIDTH) {
+        F ax, ay, az, aw, bx, by, bz, bw;
+        L::loadTransposed(start + i * stride, stride, ax, ay, az, aw);
+        L::loadTransposed(end + i * stride, stride, bx, by, bz, bw);
+
+        F d = L::add(L::add(L::mul(ax, bx), L::mul(ay, by)), L::add(L::mul(az, bz), L::mul(aw, bw)));
+
+        // q and -q are the same rotation, take the shorter way around
+        M flip = L::lessThan(d, zero);
+        bx = L::select(flip, L::sub(zero, bx), bx);
+        by = L::select(flip, L::sub(zero, by), by);
+        bz = L::select(flip, L::sub(zero, bz), bz);
+        bw = L::select(flip, L::sub(zero, bw), bw);
+        d = L::abs(d);
+
+        F scale0 = L::sub(one, t), scale1 = t;
+        if (spherical) {
+            // nearly parallel quaternions fall back to the linear weights, sin theta would vanish
+            M close = L::lessThan(L::set(0.9995f), d);
+            F sinTheta = L::sqrt(L::max(zero, L::sub(one, L::mul(d, d))));
+            F theta = gdx_cpp::math::detail::atan2Lane<L>(sinTheta, d, true);
+            F sin0, sin1;
+            gdx_cpp::math::detail::sinCosLane<L>(L::mul(scale0, theta), &sin0, NULL, true);
+            gdx_cpp::math::detail::sinCosLane<L>(L::mul(t, theta), &sin1, NULL, true);
+            F invSinTheta = L::div(one, L::select(close, one, sinTheta));
+            scale0 = L::select(close, scale0, L::mul(sin0, invSinTheta));
+            scale1 = L::select(close, scale1, L::mul(sin1, invSinTheta));
+        }
+
+        F x = L::add(L::mul(scale0, ax), L::mul(scale1, bx));
+        F y = L::add(L::mul(scale0, ay), L::mul(scale1, by));
+        F z = L::add(L::mul(scale0, az), L::mul(scale1, bz));
+        F w = L::add(L::mul(scale0, aw), L::mul(scale1, bw));
+
+        F invLen = L::rsqrt(L::add(L::add(L::mul(x, x), L::mul(y, y)), L::add(L::mul(z, z), L::mul(w, w))));
+        L::storeTransposed(out + i * stride, stride, L::mul(x, invLen), L::mul(y, invLen), L::mul(z, invLen),
+                           L::mul(w, invLen));
+    }
+    return i;
+}
+
+template <class L>
+int toMatricesLoop (int i, const float* quaternions, int stride, const float* translations, int translationStride,
+                    float* matrices, int count) {
+    typedef typename L::F F;
+
+    const F one = L::set(1), two = L::set(2);
+    for (; i + L::WIDTH <= count; i += L::WIDTH) {
+        F x, y, z, w;
+        L::loadTransposed(quaternions + i * stride, stride, x, y, z, w);
+
+        F xx = L::mul(x, x), xy = L::mul(x, y), xz = L::mul(x, z), xw = L::mul(x, w);
+        F yy = L::mul(y, y), yz = L::mul(y, z), yw = L::mul(y, w);
+        F zz = L::mul(z, z), zw = L::mul(z, w);
+
+        // the 3x3 rotation in column major order, as Matrix4::set(const Quaternion&)
+        float rotation[9][4];
+        L::store(rotation[0], L::sub(one, L::mul(two, L::add(yy, zz))));
+        L::store(rotation[1], L::mul(two, L::add(xy, zw)));
+        L::store(rotation[2], L::mul(two, L::sub(xz, yw)));
+        L::store(rotation[3], L::mul(two, L::sub(xy, zw)));
+        L::store(rotation[4], L::sub(one, L::mul(two, L::add(xx, zz))));
+        L::store(rotation[5], L::mul(two, L::add(yz, xw)));
+        L::store(rotation[6], L::mul(two, L::add(xz, yw)));
+        L::store(rotation[7], L::mul(two, L::sub(yz, xw)));
+        L::store(rotation[8], L::sub(one, L::mul(two, L::add(xx, yy))));
+
+        for (int k = 0; k < L::WIDTH; k++) {
+            float* matrix = matrices + (i + k) * 16;
+            for (int column = 0; column < 3; column++) {
+                matrix[column * 4] = rotation[column * 3][k];
+                matrix[column * 4 + 1] = rotation[column * 3 + 1][k];
+                matrix[column * 4 + 2] = rotation[column * 3 + 2][k];
+                matrix[column * 4 + 3] = 0;
+            }
+
+            if (translations != NULL) {
+                const float* translation = translations + (i + k) * translationStride;
+                matrix[12] = translation[0];
+                matrix[13] = translation[1];
+                matrix[14] = translation[2];
+            } else {
+                matrix[12] = matrix[13] = matrix[14] = 0;
+            }
+            matrix[15] = 1;
+        }
+    }
+    return i;
+}
+
+}
+
+void Quaternion::slerp (const float* start, const float* end, float* out, int count, float alpha, int stride) {
+    int i = 0;
+#if defined(GDX_CPP_SIMD_SSE) || defined(GDX_CPP_SIMD_NEON)
+    i = interpolateLoop<SimdLane>(i, start, end, out, count, alpha, stride, true);
+#endif
+    interpolateLoop<ScalarLane>(i, start, end, out, count, alpha, stride, true);
+}
+
+void Quaternion::nlerp (const float* start, const float* end, float* out, int count, float alpha, int stride) {
+    int i = 0;
+#if defined(GDX_CPP_SIMD_SSE) || defined(GDX_CPP_SIMD_NEON)
+    i = interpolateLoop<SimdLane>(i, start, end, out, count, alpha, stride, false);
+#endif
+    interpolateLoop<ScalarLane>(i, start, end, out, count, alpha, stride, false);
+}
+
+void Quaternion::toMatrices (const float* quaternions, int stride, const float* translations, int translationStride,
+                             float* matrices, int count) {
+    int i = 0;
+#if defined(GDX_CPP_SIMD_SSE) || defined(GDX_CPP_SIMD_NEON)
+    i = toMatricesLoop<SimdLane>(i, quaternions, stride, translations, translationStride, matrices, count);
+#endif
+    toMatricesLoop<ScalarLane>(i, quaternions, stride, translations, translationStride, matrices, count);
+}
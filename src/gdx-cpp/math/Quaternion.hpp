@@ -66,6 +66,17 @@ public:
     Quaternion& slerp (Quaternion& end, float alpha);
     float dot (const Quaternion& other);
     Quaternion& mul (float scalar);
+
+    /** Batch interpolation of count quaternions stored as x, y, z, w, the quaternions of each array stride floats
+     * apart (4 when packed, 8 for the MD5 joint layout with the quaternion at offset 4). out may alias start or end.
+     * Unlike {@link #slerp(Quaternion&, float)} end is not modified and the results are normalized. */
+    static void slerp (const float* start, const float* end, float* out, int count, float alpha, int stride = 4);
+    /** Normalized linear interpolation, cheaper than slerp but not constant speed for large angles */
+    static void nlerp (const float* start, const float* end, float* out, int count, float alpha, int stride = 4);
+    /** Writes count column major 4x4 matrices, the rotation of each quaternion followed by the translation at the
+     * same index; translations are x, y, z and may be NULL. */
+    static void toMatrices (const float* quaternions, int stride, const float* translations, int translationStride,
+                            float* matrices, int count);
     
     float x;
     float y;
@@ -73,8 +84,6 @@ public:
     float w;	
 private:
    
-    static Quaternion tmp1;
-    static Quaternion tmp2;
     static const float NORMALIZATION_TOLERANCE;//TODO falta inicializar
 };
 
@@ -0,0 +1,84 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Random.hpp"
+
+#include <atomic>
+#include <ctime>
+
+using namespace gdx_cpp::math;
+
+static std::atomic<uint64_t> seedUniquifier(UINT64_C(8682522807148012));
+
+static uint64_t splitMix64 (uint64_t& x) {
+    uint64_t z = (x += UINT64_C(0x9E3779B97F4A7C15));
+    z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+    return z ^ (z >> 31);
+}
+
+Random::Random () {
+    uint64_t unique = seedUniquifier.fetch_add(UINT64_C(181783497276652981));
+    setSeed(unique ^ ((uint64_t) std::time(NULL) << 20) ^ (uint64_t) std::clock());
+}
+
+Random::Random (uint64_t seed) {
+    setSeed(seed);
+}
+
+void Random::setSeed (uint64_t seed) {
+    uint64_t x = seed;
+    setState(splitMix64(x), splitMix64(x));
+}
+
+void Random::setState (uint64_t seed0, uint64_t seed1) {
+    // the all zero state would only ever produce zeros
+    if (seed0 == 0 && seed1 == 0) seed1 = 1;
+    this->seed0 = seed0;
+    this->seed1 = seed1;
+}
+
+uint64_t Random::getState (int index) const {
+    return index == 0 ? seed0 : seed1;
+}
+
+void Random::nextFloats (float* out, int count) {
+    // two floats per step, from the upper and lower 24 of the 48 best bits
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {
+        uint64_t bits = nextLong();
+        out[i] = (bits >> 40) * (1.0f / (1 << 24));
+        out[i + 1] = ((bits >> 16) & 0xffffff) * (1.0f / (1 << 24));
+    }
+    if (i < count) out[i] = nextFloat();
+}
+
+void Random::nextFloats (float* out, int count, float low, float high) {
+    nextFloats(out, count);
+    float range = high - low;
+    for (int i = 0; i < count; i++)
+        out[i] = low + out[i] * range;
+}
+
+void Random::nextInts (int* out, int count, int n) {
+    for (int i = 0; i < count; i++)
+        out[i] = nextInt(n);
+}
+
+Random& Random::local () {
+    static thread_local Random random;
+    return random;
+}
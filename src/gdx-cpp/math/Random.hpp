@@ -0,0 +1,100 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef GDX_CPP_MATH_RANDOM_HPP_
+#define GDX_CPP_MATH_RANDOM_HPP_
+
+#include <stdint.h>
+
+namespace gdx_cpp {
+namespace math {
+
+/** Pseudo random number generator based on xoroshiro128+, with 128 bits of state and a period of 2^128 - 1. It is
+ * much faster than std::rand() and has no hidden shared state: give each system that needs reproducible sequences its
+ * own instance, and use {@link #local} (which {@link utils::random} uses) for everything else.
+ *
+ * An instance must not be used from several threads at once. */
+class Random {
+public:
+    /** Seeds the generator from the clock and a process wide counter, so instances created together still differ */
+    Random ();
+    explicit Random (uint64_t seed);
+
+    /** Expands the seed into the state with splitmix64; equal seeds give equal sequences */
+    void setSeed (uint64_t seed);
+    void setState (uint64_t seed0, uint64_t seed1);
+    uint64_t getState (int index) const;
+
+    uint64_t nextLong ();
+    uint32_t nextInt ();
+    /** Returns a value between 0 (inclusive) and n (exclusive), n must be positive */
+    int nextInt (int n);
+    bool nextBoolean ();
+    /** Returns a value between 0 (inclusive) and 1 (exclusive) */
+    float nextFloat ();
+    double nextDouble ();
+
+    /** Fills out with values between 0 (inclusive) and 1 (exclusive) */
+    void nextFloats (float* out, int count);
+    /** Fills out with values between low (inclusive) and high (exclusive) */
+    void nextFloats (float* out, int count, float low, float high);
+    /** Fills out with values between 0 (inclusive) and n (exclusive) */
+    void nextInts (int* out, int count, int n);
+
+    /** Returns the calling thread's generator */
+    static Random& local ();
+
+private:
+    uint64_t seed0, seed1;
+};
+
+inline uint64_t Random::nextLong () {
+    uint64_t s0 = seed0;
+    uint64_t s1 = seed1;
+    uint64_t result = s0 + s1;
+
+    s1 ^= s0;
+    seed0 = ((s0 << 24) | (s0 >> 40)) ^ s1 ^ (s1 << 16);
+    seed1 = (s1 << 37) | (s1 >> 27);
+
+    return result;
+}
+
+inline uint32_t Random::nextInt () {
+    // the upper bits of xoroshiro128+ are the stronger ones
+    return (uint32_t)(nextLong() >> 32);
+}
+
+inline int Random::nextInt (int n) {
+    return (int)(((uint64_t) nextInt() * (uint32_t) n) >> 32);
+}
+
+inline bool Random::nextBoolean () {
+    return (nextLong() >> 63) != 0;
+}
+
+inline float Random::nextFloat () {
+    return (nextLong() >> 40) * (1.0f / (1 << 24));
+}
+
+inline double Random::nextDouble () {
+    return (nextLong() >> 11) * (1.0 / (UINT64_C(1) << 53));
+}
+
+} // namespace gdx_cpp
+} // namespace math
+
+#endif // GDX_CPP_MATH_RANDOM_HPP_
@@ -26,7 +26,6 @@
 
 using namespace gdx_cpp::math;
 
-Vector2 Vector2::_tmp;
 
 Vector2::Vector2() : x(0.0), y(0.0)
 {
@@ -143,8 +142,10 @@ Vector2& Vector2::sub (float x, float y) {
     return *this;
 }
 
-Vector2& Vector2::tmp () {
-    return _tmp.set(*this);
+/** A copy of this vector. libgdx returns a shared scratch vector here; the copy lives on the caller's stack and can't
+ * be clobbered by another call. */
+Vector2 Vector2::tmp () const {
+    return *this;
 }
 
 Vector2& Vector2::mul (const Matrix3& mat) {
@@ -185,7 +186,7 @@ Vector2 Vector2::rotate (float angle) {
 
 Vector2 Vector2::lerp (Vector2& target, float alpha) {
     Vector2 r = this->mul(1.0f - alpha);
-    r.add(target.tmp().mul(alpha));
+    r.add(target.x * alpha, target.y * alpha);
     return r;
 }
 
@@ -50,7 +50,7 @@ public:
     float dst2 (const Vector2& v);
     std::string toString ();
     Vector2& sub (float x, float y);
-    Vector2& tmp ();
+    Vector2 tmp () const;
     Vector2& mul (const Matrix3& mat);
     float crs (const Vector2& v);
     float crs (float x, float y);
@@ -61,9 +61,6 @@ public:
     
     float x;
     float y;
-
-private:
-    static Vector2 _tmp;
 };
 
 }
@@ -29,10 +29,6 @@ Vector3 Vector3::X(1, 0, 0);
 Vector3 Vector3::Y(0, 1, 0);
 Vector3 Vector3::Z(0, 0, 1);
 
-Vector3 Vector3::_tmp;
-Vector3 Vector3::_tmp2;
-Vector3 Vector3::_tmp3;
-
 Vector3::Vector3() : x(0),y(0),z(0)
 {
 }
@@ -88,16 +84,18 @@ Vector3 Vector3::cpy() {
     return Vector3(*this);
 }
 
-Vector3& Vector3::tmp() const {
-    return _tmp.set(*this);
+/** A copy of this vector. libgdx returns one of three shared scratch vectors from tmp(), tmp2() and tmp3(); the copy
+ * lives on the caller's stack and can't be clobbered by another call. */
+Vector3 Vector3::tmp() const {
+    return *this;
 }
 
-Vector3& Vector3::tmp2() const {
-    return _tmp2.set(*this);
+Vector3 Vector3::tmp2() const {
+    return *this;
 }
 
-Vector3& Vector3::tmp3() const {
-    return _tmp3.set(*this);
+Vector3 Vector3::tmp3() const {
+    return *this;
 }
 
 Vector3& Vector3::add(const Vector3& vector) {
@@ -206,14 +204,14 @@ bool Vector3::isZero() {
 
 Vector3 Vector3::lerp(Vector3& target, float alpha) {
     Vector3 r = this->mul(1.0f - alpha);
-    r.add(target.tmp().mul(alpha));
+    r.add(target.x * alpha, target.y * alpha, target.z * alpha);
     return r;
 }
 
 Vector3& Vector3::slerp(Vector3& target, float alpha) {
     float dot = this->dot(target);
     if (dot > 0.99995f || dot < 0.9995f) {
-        this->add(target.tmp().sub(*this).mul(alpha));
+        this->add(Vector3(target).sub(*this).mul(alpha));
         this->nor();
         return *this;
     }
@@ -223,7 +221,7 @@ Vector3& Vector3::slerp(Vector3& target, float alpha) {
 
     float theta0 = (float)std::acos(dot);
     float theta = theta0 * alpha;
-    Vector3 v2 = target.tmp().sub(x * dot, y * dot, z * dot);
+    Vector3 v2 = Vector3(target).sub(x * dot, y * dot, z * dot);
     v2.nor();
     return this->mul((float)std::cos(theta)).add(v2.mul((float)std::sin(theta))).nor();
 }
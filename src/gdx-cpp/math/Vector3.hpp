@@ -42,9 +42,9 @@ public:
     Vector3& set(const Vector3& vector);
     Vector3& set(const float* values);
     Vector3 cpy();
-    Vector3& tmp() const;
-    Vector3& tmp2() const;
-    Vector3& tmp3() const;
+    Vector3 tmp() const;
+    Vector3 tmp2() const;
+    Vector3 tmp3() const;
 
     
     Vector3& add(const Vector3& vector);
@@ -89,10 +89,6 @@ public:
     static Vector3 X;
     static Vector3 Y;
     static Vector3 Z;
-private:
-    static Vector3 _tmp;
-    static Vector3 _tmp2;
-    static Vector3 _tmp3;
 };
 
 }
@@ -29,8 +29,11 @@
 
 using namespace gdx_cpp::math::collision;
 
-BoundingBox::BoundingBox (const BoundingBox& bounds) : crn_dirty(true) {
-    this->crn.reserve(8);
+BoundingBox::BoundingBox () : crn(8), crn_dirty(true) {
+    this->clr();
+}
+
+BoundingBox::BoundingBox (const BoundingBox& bounds) : crn(8), crn_dirty(true) {
     this->set(bounds);
 }
 
@@ -35,6 +35,7 @@ namespace collision {
 
 class BoundingBox {
 public:
+   BoundingBox ();
    BoundingBox (const BoundingBox& bounds);
    
     gdx_cpp::math::Vector3& getCenter ();
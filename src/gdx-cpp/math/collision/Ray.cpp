@@ -28,8 +28,6 @@
 using namespace gdx_cpp::math::collision;
 using namespace gdx_cpp::math;
 
-Vector3 Ray::tmp = Vector3();
-
 gdx_cpp::math::collision::Ray::Ray()
 {
     direction.nor();
@@ -47,14 +45,14 @@ Ray Ray::cpy () {
     return Ray(this->origin, this->direction);
 }
 
-gdx_cpp::math::Vector3& Ray::getEndPoint (float distance) {
+gdx_cpp::math::Vector3 Ray::getEndPoint (float distance) {
     gdx_cpp::math::Vector3 o(origin);
-    return o.add(direction.tmp().mul(distance));
+    return o.add(direction.x * distance, direction.y * distance, direction.z * distance);
 }
 
 Ray& Ray::mul (const gdx_cpp::math::Matrix4& matrix) {
-    tmp.set(origin).add(direction);
-    tmp.mul(matrix);
+    Vector3 tmp(origin);
+    tmp.add(direction).mul(matrix);
     origin.mul(matrix);
     direction.set(tmp.sub(origin));
     return *this;
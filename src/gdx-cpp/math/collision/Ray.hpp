@@ -35,7 +35,7 @@ public:
     Ray (Vector3& origin, Vector3& direction);
     Ray();
     Ray cpy ();
-    Vector3& getEndPoint (float distance);
+    Vector3 getEndPoint (float distance);
     Ray& mul (const gdx_cpp::math::Matrix4& matrix);
     std::string toString ();
     Ray& set (const gdx_cpp::math::Vector3& origin,const gdx_cpp::math::Vector3& direction);
@@ -44,9 +44,6 @@ public:
 
     Vector3 origin;
     Vector3 direction;
-protected:
-    static Vector3 tmp;
-
 };
 
 } // namespace gdx_cpp
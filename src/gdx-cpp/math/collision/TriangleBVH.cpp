@@ -0,0 +1,535 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "TriangleBVH.hpp"
+#include "Ray.hpp"
+#include "BoundingBox.hpp"
+#include "gdx-cpp/math/Vector3.hpp"
+#include "gdx-cpp/graphics/Mesh.hpp"
+#include "gdx-cpp/graphics/VertexAttribute.hpp"
+#include "gdx-cpp/graphics/VertexAttributes.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+using namespace gdx_cpp::math::collision;
+using namespace gdx_cpp::math;
+
+static const int BIN_COUNT = 12;
+static const int MAX_DEPTH = 60;
+static const int STACK_SIZE = 64;
+
+static inline float surfaceArea (const float* min, const float* max) {
+    float dx = max[0] - min[0], dy = max[1] - min[1], dz = max[2] - min[2];
+    return dx * dy + dy * dz + dz * dx;
+}
+
+static inline void growBounds (float* min, float* max, const float* otherMin, const float* otherMax) {
+    for (int a = 0; a < 3; a++) {
+        if (otherMin[a] < min[a]) min[a] = otherMin[a];
+        if (otherMax[a] > max[a]) max[a] = otherMax[a];
+    }
+}
+
+static inline void resetBounds (float* min, float* max) {
+    min[0] = min[1] = min[2] = std::numeric_limits<float>::max();
+    max[0] = max[1] = max[2] = -std::numeric_limits<float>::max();
+}
+
+/** Slab test, distance is the entry distance of the ray into the box */
+static inline bool intersectBox (const float* min, const float* max, const float* origin, const float* invDirection,
+                                 float maxDistance, float& distance) {
+    float t0 = 0, t1 = maxDistance;
+    for (int a = 0; a < 3; a++) {
+        float tNear = (min[a] - origin[a]) * invDirection[a];
+        float tFar = (max[a] - origin[a]) * invDirection[a];
+        if (tNear > tFar) {
+            float t = tNear;
+            tNear = tFar;
+            tFar = t;
+        }
+        if (tNear > t0) t0 = tNear;
+        if (tFar < t1) t1 = tFar;
+        if (t0 > t1) return false;
+    }
+    distance = t0;
+    return true;
+}
+
+static inline bool overlapBoxes (const float* minA, const float* maxA, const float* minB, const float* maxB) {
+    return minA[0] <= maxB[0] && maxA[0] >= minB[0] && minA[1] <= maxB[1] && maxA[1] >= minB[1]
+           && minA[2] <= maxB[2] && maxA[2] >= minB[2];
+}
+
+static inline void cross (const float* a, const float* b, float* out) {
+    out[0] = a[1] * b[2] - a[2] * b[1];
+    out[1] = a[2] * b[0] - a[0] * b[2];
+    out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+static inline float dot (const float* a, const float* b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+/** Separating axis test between a triangle and a box given by center and half extents, after Akenine-Moller. The box
+ * face axes are assumed to have been tested already by comparing the triangle's bounds. */
+static bool overlapTriangleBox (const float* triangle, const float* center, const float* halfSize) {
+    float v[3][3];
+    for (int i = 0; i < 3; i++)
+        for (int a = 0; a < 3; a++)
+            v[i][a] = triangle[i * 3 + a] - center[a];
+
+    float edges[3][3];
+    for (int a = 0; a < 3; a++) {
+        edges[0][a] = v[1][a] - v[0][a];
+        edges[1][a] = v[2][a] - v[1][a];
+        edges[2][a] = v[0][a] - v[2][a];
+    }
+
+    for (int e = 0; e < 3; e++) {
+        for (int a = 0; a < 3; a++) {
+            float unit[3] = { 0, 0, 0 };
+            unit[a] = 1;
+            float axis[3];
+            cross(unit, edges[e], axis);
+
+            float p0 = dot(axis, v[0]), p1 = dot(axis, v[1]), p2 = dot(axis, v[2]);
+            float min = std::min(p0, std::min(p1, p2));
+            float max = std::max(p0, std::max(p1, p2));
+            float radius = halfSize[0] * std::fabs(axis[0]) + halfSize[1] * std::fabs(axis[1])
+                           + halfSize[2] * std::fabs(axis[2]);
+            if (min > radius || max < -radius) return false;
+        }
+    }
+
+    float normal[3];
+    cross(edges[0], edges[1], normal);
+    float radius = halfSize[0] * std::fabs(normal[0]) + halfSize[1] * std::fabs(normal[1])
+                   + halfSize[2] * std::fabs(normal[2]);
+    return std::fabs(dot(normal, v[0])) <= radius;
+}
+
+TriangleBVH::TriangleBVH () : numVertices(0) {
+}
+
+void TriangleBVH::build (const float* vertices, int numVertices, int vertexSize, int positionOffset,
+                         const short* indices, int numIndices) {
+    clear();
+    this->numVertices = numVertices;
+
+    int numTriangles = (indices != NULL ? numIndices : numVertices) / 3;
+    vertexIndices.resize(numTriangles * 3);
+    for (int i = 0; i < numTriangles * 3; i++) {
+        int index = indices != NULL ? (indices[i] & 0xffff) : i;
+        if (index >= numVertices) {
+            std::stringstream ss;
+            ss << "index " << index << " out of range, mesh has " << numVertices << " vertices";
+            throw std::runtime_error(ss.str());
+        }
+        vertexIndices[i] = index;
+    }
+    if (numTriangles == 0) return;
+
+    std::vector<float> triBounds(numTriangles * 6);
+    std::vector<int> order(numTriangles);
+    for (int t = 0; t < numTriangles; t++) {
+        float* min = &triBounds[t * 6];
+        float* max = min + 3;
+        resetBounds(min, max);
+        for (int k = 0; k < 3; k++) {
+            const float* p = vertices + vertexIndices[t * 3 + k] * vertexSize + positionOffset;
+            growBounds(min, max, p, p);
+        }
+        order[t] = t;
+    }
+
+    nodes.reserve(numTriangles * 2);
+    nodes.push_back(Node());
+    buildNode(0, 0, numTriangles, 0, triBounds, order);
+
+    // store the triangles in leaf order so a leaf reads one contiguous block
+    triangleIds = order;
+    std::vector<int> sourceIndices(vertexIndices);
+    for (int t = 0; t < numTriangles; t++)
+        for (int k = 0; k < 3; k++)
+            vertexIndices[t * 3 + k] = sourceIndices[order[t] * 3 + k];
+
+    readTriangles(vertices, vertexSize, positionOffset);
+}
+
+void TriangleBVH::build (gdx_cpp::graphics::Mesh& mesh) {
+    gdx_cpp::graphics::VertexAttribute& position = mesh.getVertexAttribute(gdx_cpp::graphics::VertexAttributes::Usage::Position);
+    if (position.numComponents != 3) throw std::runtime_error("TriangleBVH needs three component positions");
+
+    int vertexSize = mesh.getVertexSize() / 4;
+    std::vector<float> vertices(mesh.getNumVertices() * vertexSize);
+    std::vector<short> indices(mesh.getNumIndices());
+    if (vertices.empty()) {
+        clear();
+        return;
+    }
+
+    mesh.getVertices(vertices);
+    if (!indices.empty()) mesh.getIndices(indices);
+    build(&vertices[0], mesh.getNumVertices(), vertexSize, position.offset / 4, indices.empty() ? NULL : &indices[0],
+          indices.size());
+}
+
+void TriangleBVH::refit (const float* vertices, int vertexSize, int positionOffset) {
+    if (nodes.empty()) return;
+    readTriangles(vertices, vertexSize, positionOffset);
+    updateBounds();
+}
+
+void TriangleBVH::refit (gdx_cpp::graphics::Mesh& mesh) {
+    if (nodes.empty()) return;
+    if ((int) mesh.getNumVertices() < numVertices) throw std::runtime_error("mesh has fewer vertices than the BVH was built with");
+
+    gdx_cpp::graphics::VertexAttribute& position = mesh.getVertexAttribute(gdx_cpp::graphics::VertexAttributes::Usage::Position);
+    int vertexSize = mesh.getVertexSize() / 4;
+    std::vector<float> vertices(mesh.getNumVertices() * vertexSize);
+    mesh.getVertices(vertices);
+    refit(&vertices[0], vertexSize, position.offset / 4);
+}
+
+void TriangleBVH::clear () {
+    nodes.clear();
+    vertexIndices.clear();
+    positions.clear();
+    triangleIds.clear();
+    numVertices = 0;
+}
+
+void TriangleBVH::buildNode (int nodeIndex, int start, int count, int depth, std::vector<float>& triBounds,
+                             std::vector<int>& order) {
+    float min[3], max[3], centroidMin[3], centroidMax[3];
+    resetBounds(min, max);
+    resetBounds(centroidMin, centroidMax);
+    for (int i = start; i < start + count; i++) {
+        const float* bounds = &triBounds[order[i] * 6];
+        growBounds(min, max, bounds, bounds + 3);
+        float centroid[3] = { (bounds[0] + bounds[3]) * 0.5f, (bounds[1] + bounds[4]) * 0.5f,
+                              (bounds[2] + bounds[5]) * 0.5f };
+        growBounds(centroidMin, centroidMax, centroid, centroid);
+    }
+
+    Node& node = nodes[nodeIndex];
+    for (int a = 0; a < 3; a++) {
+        node.min[a] = min[a];
+        node.max[a] = max[a];
+    }
+    node.start = start;
+    node.count = count;
+    if (count <= MIN_LEAF_SIZE || depth >= MAX_DEPTH) return;
+
+    // binned surface area heuristic over the centroids
+    int bestAxis = -1, bestSplit = 0;
+    float bestCost = std::numeric_limits<float>::max();
+    for (int axis = 0; axis < 3; axis++) {
+        float extent = centroidMax[axis] - centroidMin[axis];
+        if (extent <= 0) continue;
+        float scale = BIN_COUNT / extent;
+
+        int binCount[BIN_COUNT];
+        float binMin[BIN_COUNT][3], binMax[BIN_COUNT][3];
+        for (int b = 0; b < BIN_COUNT; b++) {
+            binCount[b] = 0;
+            resetBounds(binMin[b], binMax[b]);
+        }
+
+        for (int i = start; i < start + count; i++) {
+            const float* bounds = &triBounds[order[i] * 6];
+            int b = (int)(((bounds[axis] + bounds[axis + 3]) * 0.5f - centroidMin[axis]) * scale);
+            if (b >= BIN_COUNT) b = BIN_COUNT - 1;
+            binCount[b]++;
+            growBounds(binMin[b], binMax[b], bounds, bounds + 3);
+        }
+
+        float leftArea[BIN_COUNT];
+        int leftCount[BIN_COUNT];
+        float accMin[3], accMax[3];
+        resetBounds(accMin, accMax);
+        int acc = 0;
+        for (int b = 0; b < BIN_COUNT - 1; b++) {
+            acc += binCount[b];
+            if (binCount[b] > 0) growBounds(accMin, accMax, binMin[b], binMax[b]);
+            leftCount[b] = acc;
+            leftArea[b] = acc > 0 ? surfaceArea(accMin, accMax) : 0;
+        }
+
+        resetBounds(accMin, accMax);
+        acc = 0;
+        for (int b = BIN_COUNT - 1; b > 0; b--) {
+            acc += binCount[b];
+            if (binCount[b] > 0) growBounds(accMin, accMax, binMin[b], binMax[b]);
+            if (leftCount[b - 1] == 0 || acc == 0) continue;
+
+            float cost = leftArea[b - 1] * leftCount[b - 1] + surfaceArea(accMin, accMax) * acc;
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = b;
+            }
+        }
+    }
+
+    // all centroids coincide, nothing to split on
+    if (bestAxis == -1) return;
+
+    // splitting costs one box test for the children, measured in triangle tests
+    float area = surfaceArea(min, max);
+    if (bestCost + area >= count * area && count <= MAX_LEAF_SIZE) return;
+
+    float scale = BIN_COUNT / (centroidMax[bestAxis] - centroidMin[bestAxis]);
+    int mid = start;
+    for (int i = start; i < start + count; i++) {
+        const float* bounds = &triBounds[order[i] * 6];
+        int b = (int)(((bounds[bestAxis] + bounds[bestAxis + 3]) * 0.5f - centroidMin[bestAxis]) * scale);
+        if (b >= BIN_COUNT) b = BIN_COUNT - 1;
+        if (b < bestSplit) std::swap(order[i], order[mid++]);
+    }
+
+    int leftCount = mid - start;
+    nodes[nodeIndex].count = 0;
+
+    int left = nodes.size();
+    nodes.push_back(Node());
+    buildNode(left, start, leftCount, depth + 1, triBounds, order);
+
+    int right = nodes.size();
+    nodes.push_back(Node());
+    buildNode(right, mid, count - leftCount, depth + 1, triBounds, order);
+
+    nodes[nodeIndex].start = right;
+}
+
+void TriangleBVH::readTriangles (const float* vertices, int vertexSize, int positionOffset) {
+    positions.resize(vertexIndices.size() * 3);
+    for (unsigned int i = 0; i < vertexIndices.size(); i++) {
+        const float* p = vertices + vertexIndices[i] * vertexSize + positionOffset;
+        positions[i * 3] = p[0];
+        positions[i * 3 + 1] = p[1];
+        positions[i * 3 + 2] = p[2];
+    }
+}
+
+void TriangleBVH::updateBounds () {
+    // children are stored after their parent, so walking backwards visits them first
+    for (int i = nodes.size() - 1; i >= 0; i--) {
+        Node& node = nodes[i];
+        resetBounds(node.min, node.max);
+        if (node.count > 0) {
+            for (int t = node.start; t < node.start + node.count; t++)
+                for (int k = 0; k < 3; k++) {
+                    const float* p = &positions[(t * 3 + k) * 3];
+                    growBounds(node.min, node.max, p, p);
+                }
+        } else {
+            growBounds(node.min, node.max, nodes[i + 1].min, nodes[i + 1].max);
+            growBounds(node.min, node.max, nodes[node.start].min, nodes[node.start].max);
+        }
+    }
+}
+
+/** Moller-Trumbore, both faces count as hits */
+bool TriangleBVH::intersectTriangle (int triangle, const float* origin, const float* direction, float maxDistance,
+                                     float& distance) const {
+    const float* p = &positions[triangle * 9];
+    float edge1[3] = { p[3] - p[0], p[4] - p[1], p[5] - p[2] };
+    float edge2[3] = { p[6] - p[0], p[7] - p[1], p[8] - p[2] };
+
+    float pvec[3];
+    cross(direction, edge2, pvec);
+    float det = dot(edge1, pvec);
+    if (det == 0) return false;
+    float invDet = 1.0f / det;
+
+    float tvec[3] = { origin[0] - p[0], origin[1] - p[1], origin[2] - p[2] };
+    float u = dot(tvec, pvec) * invDet;
+    if (u < 0 || u > 1) return false;
+
+    float qvec[3];
+    cross(tvec, edge1, qvec);
+    float v = dot(direction, qvec) * invDet;
+    if (v < 0 || u + v > 1) return false;
+
+    float t = dot(edge2, qvec) * invDet;
+    if (t < 0 || t >= maxDistance) return false;
+
+    distance = t;
+    return true;
+}
+
+bool TriangleBVH::intersectRay (const Ray& ray, Vector3* intersection, int* triangle, float maxDistance) const {
+    if (nodes.empty()) return false;
+
+    float origin[3] = { ray.origin.x, ray.origin.y, ray.origin.z };
+    float direction[3] = { ray.direction.x, ray.direction.y, ray.direction.z };
+    float invDirection[3] = { 1.0f / direction[0], 1.0f / direction[1], 1.0f / direction[2] };
+
+    struct Entry {
+        int node;
+        float distance;
+    } stack[STACK_SIZE];
+
+    float distance;
+    if (!intersectBox(nodes[0].min, nodes[0].max, origin, invDirection, maxDistance, distance)) return false;
+
+    int size = 0;
+    stack[size].node = 0;
+    stack[size++].distance = distance;
+
+    float closest = maxDistance;
+    int hit = -1;
+    while (size > 0) {
+        Entry entry = stack[--size];
+        if (entry.distance >= closest) continue;
+
+        const Node& node = nodes[entry.node];
+        if (node.count > 0) {
+            for (int t = node.start; t < node.start + node.count; t++) {
+                if (intersectTriangle(t, origin, direction, closest, distance)) {
+                    closest = distance;
+                    hit = t;
+                }
+            }
+            continue;
+        }
+
+        int left = entry.node + 1, right = node.start;
+        float leftDistance, rightDistance;
+        bool hitLeft = intersectBox(nodes[left].min, nodes[left].max, origin, invDirection, closest, leftDistance);
+        bool hitRight = intersectBox(nodes[right].min, nodes[right].max, origin, invDirection, closest, rightDistance);
+
+        // push the farther child first so the nearer one is visited next
+        if (hitLeft && hitRight && leftDistance < rightDistance) {
+            stack[size].node = right;
+            stack[size++].distance = rightDistance;
+            stack[size].node = left;
+            stack[size++].distance = leftDistance;
+        } else {
+            if (hitLeft) {
+                stack[size].node = left;
+                stack[size++].distance = leftDistance;
+            }
+            if (hitRight) {
+                stack[size].node = right;
+                stack[size++].distance = rightDistance;
+            }
+        }
+    }
+
+    if (hit == -1) return false;
+
+    if (intersection != NULL)
+        intersection->set(origin[0] + direction[0] * closest, origin[1] + direction[1] * closest,
+                          origin[2] + direction[2] * closest);
+    if (triangle != NULL) *triangle = triangleIds[hit];
+    return true;
+}
+
+bool TriangleBVH::intersectRayAny (const Ray& ray, float maxDistance) const {
+    if (nodes.empty()) return false;
+
+    float origin[3] = { ray.origin.x, ray.origin.y, ray.origin.z };
+    float direction[3] = { ray.direction.x, ray.direction.y, ray.direction.z };
+    float invDirection[3] = { 1.0f / direction[0], 1.0f / direction[1], 1.0f / direction[2] };
+
+    int stack[STACK_SIZE];
+    int size = 0;
+    stack[size++] = 0;
+
+    float distance;
+    while (size > 0) {
+        const int index = stack[--size];
+        const Node& node = nodes[index];
+        if (!intersectBox(node.min, node.max, origin, invDirection, maxDistance, distance)) continue;
+
+        if (node.count > 0) {
+            for (int t = node.start; t < node.start + node.count; t++)
+                if (intersectTriangle(t, origin, direction, maxDistance, distance)) return true;
+        } else {
+            stack[size++] = node.start;
+            stack[size++] = index + 1;
+        }
+    }
+
+    return false;
+}
+
+int TriangleBVH::overlap (const BoundingBox& bounds, std::vector<int>& triangles) const {
+    if (nodes.empty()) return 0;
+
+    float min[3] = { bounds.min.x, bounds.min.y, bounds.min.z };
+    float max[3] = { bounds.max.x, bounds.max.y, bounds.max.z };
+    float center[3], halfSize[3];
+    for (int a = 0; a < 3; a++) {
+        center[a] = (min[a] + max[a]) * 0.5f;
+        halfSize[a] = (max[a] - min[a]) * 0.5f;
+    }
+
+    int found = 0;
+    int stack[STACK_SIZE];
+    int size = 0;
+    stack[size++] = 0;
+
+    while (size > 0) {
+        const int index = stack[--size];
+        const Node& node = nodes[index];
+        if (!overlapBoxes(node.min, node.max, min, max)) continue;
+
+        if (node.count > 0) {
+            for (int t = node.start; t < node.start + node.count; t++) {
+                const float* p = &positions[t * 9];
+                float triMin[3], triMax[3];
+                resetBounds(triMin, triMax);
+                growBounds(triMin, triMax, p, p);
+                growBounds(triMin, triMax, p + 3, p + 3);
+                growBounds(triMin, triMax, p + 6, p + 6);
+
+                if (overlapBoxes(triMin, triMax, min, max) && overlapTriangleBox(p, center, halfSize)) {
+                    triangles.push_back(triangleIds[t]);
+                    found++;
+                }
+            }
+        } else {
+            stack[size++] = node.start;
+            stack[size++] = index + 1;
+        }
+    }
+
+    return found;
+}
+
+int TriangleBVH::getTriangleCount () const {
+    return triangleIds.size();
+}
+
+int TriangleBVH::getNodeCount () const {
+    return nodes.size();
+}
+
+void TriangleBVH::getBounds (BoundingBox& bounds) const {
+    if (nodes.empty()) {
+        bounds.inf();
+        return;
+    }
+    bounds.set(Vector3(nodes[0].min[0], nodes[0].min[1], nodes[0].min[2]),
+               Vector3(nodes[0].max[0], nodes[0].max[1], nodes[0].max[2]));
+}
@@ -0,0 +1,103 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef GDX_CPP_MATH_COLLISION_TRIANGLEBVH_HPP_
+#define GDX_CPP_MATH_COLLISION_TRIANGLEBVH_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace gdx_cpp {
+namespace graphics {
+class Mesh;
+}
+namespace math {
+class Vector3;
+namespace collision {
+
+class Ray;
+class BoundingBox;
+
+/** Bounding volume hierarchy over the triangles of a mesh, for picking and line of sight queries that
+ * {@link Intersector#intersectRayTriangles} would answer with a linear scan.
+ *
+ * The tree is built with the surface area heuristic over binned triangle centroids and stored depth first in a flat
+ * node array. Positions are read from interleaved vertex arrays: vertexSize and positionOffset are in floats and
+ * positions must have three components. Indices may be NULL, in which case every three vertices form a triangle.
+ * Triangle indices returned by the queries refer to the triangle order of the source data.
+ *
+ * {@link #refit} recomputes the node bounds from new vertex positions with the same topology, e.g. after skinning; the
+ * tree gets less efficient the more the mesh deforms away from the pose it was built in. */
+class TriangleBVH {
+public:
+    TriangleBVH ();
+
+    void build (const float* vertices, int numVertices, int vertexSize, int positionOffset, const short* indices,
+                int numIndices);
+    void build (gdx_cpp::graphics::Mesh& mesh);
+    void refit (const float* vertices, int vertexSize, int positionOffset);
+    void refit (gdx_cpp::graphics::Mesh& mesh);
+    void clear ();
+
+    /** Finds the closest triangle hit by the ray within maxDistance, measured in units of the ray direction's length.
+     * intersection and triangle may be NULL. */
+    bool intersectRay (const Ray& ray, Vector3* intersection, int* triangle = NULL, float maxDistance = 3.4e38f) const;
+    /** Returns as soon as any triangle is hit within maxDistance, for occlusion and line of sight tests */
+    bool intersectRayAny (const Ray& ray, float maxDistance = 3.4e38f) const;
+    /** Appends the indices of the triangles overlapping the box to triangles and returns how many were added */
+    int overlap (const BoundingBox& bounds, std::vector<int>& triangles) const;
+
+    int getTriangleCount () const;
+    int getNodeCount () const;
+    void getBounds (BoundingBox& bounds) const;
+
+    /** Triangles per leaf below which a node is never split */
+    static const int MIN_LEAF_SIZE = 2;
+    /** Triangles per leaf above which a node is always split, even if the heuristic prefers a leaf */
+    static const int MAX_LEAF_SIZE = 16;
+
+private:
+    struct Node {
+        float min[3];
+        float max[3];
+        /** first triangle for a leaf, index of the second child for an inner node; the first child follows the node */
+        int start;
+        /** number of triangles for a leaf, 0 for an inner node */
+        int count;
+    };
+
+    void buildNode (int nodeIndex, int start, int count, int depth, std::vector<float>& triBounds,
+                    std::vector<int>& order);
+    void readTriangles (const float* vertices, int vertexSize, int positionOffset);
+    void updateBounds ();
+    bool intersectTriangle (int triangle, const float* origin, const float* direction, float maxDistance,
+                            float& distance) const;
+
+    std::vector<Node> nodes;
+    /** vertex indices of each triangle, in tree order */
+    std::vector<int> vertexIndices;
+    /** positions of the three vertices of each triangle, in tree order */
+    std::vector<float> positions;
+    /** source index of each triangle, in tree order */
+    std::vector<int> triangleIds;
+    int numVertices;
+};
+
+} // namespace gdx_cpp
+} // namespace math
+} // namespace collision
+
+#endif // GDX_CPP_MATH_COLLISION_TRIANGLEBVH_HPP_
@@ -0,0 +1,711 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "MatrixKernels.hpp"
+
+#include "SimdLanes.hpp"
+
+#include <string.h>
+
+namespace gdx_cpp {
+namespace math {
+namespace detail {
+
+// Column major element offsets, same as Matrix4::Mxx
+enum {
+    M00 = 0, M01 = 4, M02 = 8, M03 = 12,
+    M10 = 1, M11 = 5, M12 = 9, M13 = 13,
+    M20 = 2, M21 = 6, M22 = 10, M23 = 14,
+    M30 = 3, M31 = 7, M32 = 11, M33 = 15
+};
+
+namespace {
+
+/** Vectors of D components times a Matrix4, a missing y or z being 0 and a missing w 1, L::WIDTH vectors at a time
+ * with a lane type from SimdLanes.hpp; returns how many vectors that covered. With SimdLane each register holds one
+ * component of four vectors, which beats broadcasting one vector per register when it has only one or two
+ * components. Every component is read before any is written, so src == dst is safe. */
+template <class L, int D>
+int mulVecLanes (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride) {
+    typedef typename L::F F;
+    F m[16];
+    for (int i = 0; i < 16; i++)
+        m[i] = L::set(mat[i]);
+
+    int done = 0;
+    for (; done + L::WIDTH <= numVecs; done += L::WIDTH, src += srcStride * L::WIDTH, dst += dstStride * L::WIDTH) {
+        F in[D];
+        for (int c = 0; c < D; c++)
+            in[c] = L::gather(src + c, srcStride);
+        for (int r = 0; r < D; r++) {
+            F out = L::mul(in[0], m[r]);
+            for (int c = 1; c < D && c < 3; c++)
+                out = L::add(out, L::mul(in[c], m[c * 4 + r]));
+            out = L::add(out, D > 3 ? L::mul(in[D - 1], m[12 + r]) : m[12 + r]);
+            L::scatter(dst + r, dstStride, out);
+        }
+    }
+    return done;
+}
+
+/** mulVecLanes for a Matrix3 and two components, the third column being the translation */
+template <class L>
+int mulVec3Lanes (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride) {
+    typedef typename L::F F;
+    F m[9];
+    for (int i = 0; i < 9; i++)
+        m[i] = L::set(mat[i]);
+
+    int done = 0;
+    for (; done + L::WIDTH <= numVecs; done += L::WIDTH, src += srcStride * L::WIDTH, dst += dstStride * L::WIDTH) {
+        F x = L::gather(src, srcStride);
+        F y = L::gather(src + 1, srcStride);
+        for (int r = 0; r < 2; r++)
+            L::scatter(dst + r, dstStride, L::add(L::add(L::mul(x, m[r]), L::mul(y, m[3 + r])), m[6 + r]));
+    }
+    return done;
+}
+
+}
+
+namespace scalar {
+
+void mul4x4 (float* mata, const float* matb) {
+    float tmp[16];
+    tmp[M00] = mata[M00] * matb[M00] + mata[M01] * matb[M10] + mata[M02] * matb[M20] + mata[M03] * matb[M30];
+    tmp[M01] = mata[M00] * matb[M01] + mata[M01] * matb[M11] + mata[M02] * matb[M21] + mata[M03] * matb[M31];
+    tmp[M02] = mata[M00] * matb[M02] + mata[M01] * matb[M12] + mata[M02] * matb[M22] + mata[M03] * matb[M32];
+    tmp[M03] = mata[M00] * matb[M03] + mata[M01] * matb[M13] + mata[M02] * matb[M23] + mata[M03] * matb[M33];
+    tmp[M10] = mata[M10] * matb[M00] + mata[M11] * matb[M10] + mata[M12] * matb[M20] + mata[M13] * matb[M30];
+    tmp[M11] = mata[M10] * matb[M01] + mata[M11] * matb[M11] + mata[M12] * matb[M21] + mata[M13] * matb[M31];
+    tmp[M12] = mata[M10] * matb[M02] + mata[M11] * matb[M12] + mata[M12] * matb[M22] + mata[M13] * matb[M32];
+    tmp[M13] = mata[M10] * matb[M03] + mata[M11] * matb[M13] + mata[M12] * matb[M23] + mata[M13] * matb[M33];
+    tmp[M20] = mata[M20] * matb[M00] + mata[M21] * matb[M10] + mata[M22] * matb[M20] + mata[M23] * matb[M30];
+    tmp[M21] = mata[M20] * matb[M01] + mata[M21] * matb[M11] + mata[M22] * matb[M21] + mata[M23] * matb[M31];
+    tmp[M22] = mata[M20] * matb[M02] + mata[M21] * matb[M12] + mata[M22] * matb[M22] + mata[M23] * matb[M32];
+    tmp[M23] = mata[M20] * matb[M03] + mata[M21] * matb[M13] + mata[M22] * matb[M23] + mata[M23] * matb[M33];
+    tmp[M30] = mata[M30] * matb[M00] + mata[M31] * matb[M10] + mata[M32] * matb[M20] + mata[M33] * matb[M30];
+    tmp[M31] = mata[M30] * matb[M01] + mata[M31] * matb[M11] + mata[M32] * matb[M21] + mata[M33] * matb[M31];
+    tmp[M32] = mata[M30] * matb[M02] + mata[M31] * matb[M12] + mata[M32] * matb[M22] + mata[M33] * matb[M32];
+    tmp[M33] = mata[M30] * matb[M03] + mata[M31] * matb[M13] + mata[M32] * matb[M23] + mata[M33] * matb[M33];
+    memcpy(mata, tmp, sizeof(float) * 16);
+}
+
+bool inv4x4 (float* val) {
+    float tmp[16];
+    tmp[M00] = val[M12] * val[M23] * val[M31] - val[M13] * val[M22] * val[M31] + val[M13] * val[M21] * val[M32] - val[M11]
+               * val[M23] * val[M32] - val[M12] * val[M21] * val[M33] + val[M11] * val[M22] * val[M33];
+    tmp[M01] = val[M03] * val[M22] * val[M31] - val[M02] * val[M23] * val[M31] - val[M03] * val[M21] * val[M32] + val[M01]
+               * val[M23] * val[M32] + val[M02] * val[M21] * val[M33] - val[M01] * val[M22] * val[M33];
+    tmp[M02] = val[M02] * val[M13] * val[M31] - val[M03] * val[M12] * val[M31] + val[M03] * val[M11] * val[M32] - val[M01]
+               * val[M13] * val[M32] - val[M02] * val[M11] * val[M33] + val[M01] * val[M12] * val[M33];
+    tmp[M03] = val[M03] * val[M12] * val[M21] - val[M02] * val[M13] * val[M21] - val[M03] * val[M11] * val[M22] + val[M01]
+               * val[M13] * val[M22] + val[M02] * val[M11] * val[M23] - val[M01] * val[M12] * val[M23];
+    tmp[M10] = val[M13] * val[M22] * val[M30] - val[M12] * val[M23] * val[M30] - val[M13] * val[M20] * val[M32] + val[M10]
+               * val[M23] * val[M32] + val[M12] * val[M20] * val[M33] - val[M10] * val[M22] * val[M33];
+    tmp[M11] = val[M02] * val[M23] * val[M30] - val[M03] * val[M22] * val[M30] + val[M03] * val[M20] * val[M32] - val[M00]
+               * val[M23] * val[M32] - val[M02] * val[M20] * val[M33] + val[M00] * val[M22] * val[M33];
+    tmp[M12] = val[M03] * val[M12] * val[M30] - val[M02] * val[M13] * val[M30] - val[M03] * val[M10] * val[M32] + val[M00]
+               * val[M13] * val[M32] + val[M02] * val[M10] * val[M33] - val[M00] * val[M12] * val[M33];
+    tmp[M13] = val[M02] * val[M13] * val[M20] - val[M03] * val[M12] * val[M20] + val[M03] * val[M10] * val[M22] - val[M00]
+               * val[M13] * val[M22] - val[M02] * val[M10] * val[M23] + val[M00] * val[M12] * val[M23];
+    tmp[M20] = val[M11] * val[M23] * val[M30] - val[M13] * val[M21] * val[M30] + val[M13] * val[M20] * val[M31] - val[M10]
+               * val[M23] * val[M31] - val[M11] * val[M20] * val[M33] + val[M10] * val[M21] * val[M33];
+    tmp[M21] = val[M03] * val[M21] * val[M30] - val[M01] * val[M23] * val[M30] - val[M03] * val[M20] * val[M31] + val[M00]
+               * val[M23] * val[M31] + val[M01] * val[M20] * val[M33] - val[M00] * val[M21] * val[M33];
+    tmp[M22] = val[M01] * val[M13] * val[M30] - val[M03] * val[M11] * val[M30] + val[M03] * val[M10] * val[M31] - val[M00]
+               * val[M13] * val[M31] - val[M01] * val[M10] * val[M33] + val[M00] * val[M11] * val[M33];
+    tmp[M23] = val[M03] * val[M11] * val[M20] - val[M01] * val[M13] * val[M20] - val[M03] * val[M10] * val[M21] + val[M00]
+               * val[M13] * val[M21] + val[M01] * val[M10] * val[M23] - val[M00] * val[M11] * val[M23];
+    tmp[M30] = val[M12] * val[M21] * val[M30] - val[M11] * val[M22] * val[M30] - val[M12] * val[M20] * val[M31] + val[M10]
+               * val[M22] * val[M31] + val[M11] * val[M20] * val[M32] - val[M10] * val[M21] * val[M32];
+    tmp[M31] = val[M01] * val[M22] * val[M30] - val[M02] * val[M21] * val[M30] + val[M02] * val[M20] * val[M31] - val[M00]
+               * val[M22] * val[M31] - val[M01] * val[M20] * val[M32] + val[M00] * val[M21] * val[M32];
+    tmp[M32] = val[M02] * val[M11] * val[M30] - val[M01] * val[M12] * val[M30] - val[M02] * val[M10] * val[M31] + val[M00]
+               * val[M12] * val[M31] + val[M01] * val[M10] * val[M32] - val[M00] * val[M11] * val[M32];
+    tmp[M33] = val[M01] * val[M12] * val[M20] - val[M02] * val[M11] * val[M20] + val[M02] * val[M10] * val[M21] - val[M00]
+               * val[M12] * val[M21] - val[M01] * val[M10] * val[M22] + val[M00] * val[M11] * val[M22];
+
+    // tmp is the adjugate, expanding the first row against it gives the determinant
+    float l_det = val[M00] * tmp[M00] + val[M01] * tmp[M10] + val[M02] * tmp[M20] + val[M03] * tmp[M30];
+    if (l_det == 0) return false;
+
+    float inv_det = 1.0f / l_det;
+    for (int i = 0; i < 16; i++)
+        val[i] = tmp[i] * inv_det;
+    return true;
+}
+
+void mulVec4x4 (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride) {
+    for (int i = 0; i < numVecs; i++, src += srcStride, dst += dstStride) {
+        float x = src[0] * mat[M00] + src[1] * mat[M01] + src[2] * mat[M02] + mat[M03];
+        float y = src[0] * mat[M10] + src[1] * mat[M11] + src[2] * mat[M12] + mat[M13];
+        float z = src[0] * mat[M20] + src[1] * mat[M21] + src[2] * mat[M22] + mat[M23];
+        dst[0] = x;
+        dst[1] = y;
+        dst[2] = z;
+    }
+}
+
+void prj4x4 (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride) {
+    for (int i = 0; i < numVecs; i++, src += srcStride, dst += dstStride) {
+        float inv_w = 1.0f / (src[0] * mat[M30] + src[1] * mat[M31] + src[2] * mat[M32] + mat[M33]);
+        float x = (src[0] * mat[M00] + src[1] * mat[M01] + src[2] * mat[M02] + mat[M03]) * inv_w;
+        float y = (src[0] * mat[M10] + src[1] * mat[M11] + src[2] * mat[M12] + mat[M13]) * inv_w;
+        float z = (src[0] * mat[M20] + src[1] * mat[M21] + src[2] * mat[M22] + mat[M23]) * inv_w;
+        dst[0] = x;
+        dst[1] = y;
+        dst[2] = z;
+    }
+}
+
+void rot4x4 (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride) {
+    for (int i = 0; i < numVecs; i++, src += srcStride, dst += dstStride) {
+        float x = src[0] * mat[M00] + src[1] * mat[M01] + src[2] * mat[M02];
+        float y = src[0] * mat[M10] + src[1] * mat[M11] + src[2] * mat[M12];
+        float z = src[0] * mat[M20] + src[1] * mat[M21] + src[2] * mat[M22];
+        dst[0] = x;
+        dst[1] = y;
+        dst[2] = z;
+    }
+}
+
+void mulAffine3x3 (float* mata, const float* matb) {
+    float v00 = mata[0] * matb[0] + mata[3] * matb[1];
+    float v10 = mata[1] * matb[0] + mata[4] * matb[1];
+    float v01 = mata[0] * matb[3] + mata[3] * matb[4];
+    float v11 = mata[1] * matb[3] + mata[4] * matb[4];
+    float v02 = mata[0] * matb[6] + mata[3] * matb[7] + mata[6];
+    float v12 = mata[1] * matb[6] + mata[4] * matb[7] + mata[7];
+
+    mata[0] = v00;
+    mata[1] = v10;
+    mata[2] = 0;
+    mata[3] = v01;
+    mata[4] = v11;
+    mata[5] = 0;
+    mata[6] = v02;
+    mata[7] = v12;
+    mata[8] = 1;
+}
+
+void mulVec3x3 (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride) {
+    for (int i = 0; i < numVecs; i++, src += srcStride, dst += dstStride) {
+        float x = src[0] * mat[0] + src[1] * mat[3] + mat[6];
+        float y = src[0] * mat[1] + src[1] * mat[4] + mat[7];
+        dst[0] = x;
+        dst[1] = y;
+    }
+}
+
+void mulVecN4x4 (const float* mat, int dimensions, const float* src, float* dst, int numVecs, int srcStride,
+                 int dstStride) {
+    switch (dimensions) {
+    case 1:
+        mulVecLanes<ScalarLane, 1>(mat, src, dst, numVecs, srcStride, dstStride);
+        break;
+    case 2:
+        mulVecLanes<ScalarLane, 2>(mat, src, dst, numVecs, srcStride, dstStride);
+        break;
+    case 3:
+        mulVec4x4(mat, src, dst, numVecs, srcStride, dstStride);
+        break;
+    case 4:
+        mulVecLanes<ScalarLane, 4>(mat, src, dst, numVecs, srcStride, dstStride);
+        break;
+    }
+}
+
+void mulVecN3x3 (const float* mat, int dimensions, const float* src, float* dst, int numVecs, int srcStride,
+                 int dstStride) {
+    if (dimensions == 2) {
+        mulVec3x3(mat, src, dst, numVecs, srcStride, dstStride);
+        return;
+    }
+    for (int i = 0; i < numVecs; i++, src += srcStride, dst += dstStride) {
+        float x = src[0] * mat[0] + src[1] * mat[3] + src[2] * mat[6];
+        float y = src[0] * mat[1] + src[1] * mat[4] + src[2] * mat[7];
+        float z = src[0] * mat[2] + src[1] * mat[5] + src[2] * mat[8];
+        dst[0] = x;
+        dst[1] = y;
+        dst[2] = z;
+    }
+}
+
+}
+
+namespace simd {
+
+#if defined(GDX_CPP_SIMD_SSE)
+
+static inline void storeXYZ (float* dst, __m128 v) {
+    _mm_storel_pi((__m64*) dst, v);
+    _mm_store_ss(dst + 2, _mm_movehl_ps(v, v));
+}
+
+void mul4x4 (float* mata, const float* matb) {
+    __m128 c0 = _mm_loadu_ps(mata);
+    __m128 c1 = _mm_loadu_ps(mata + 4);
+    __m128 c2 = _mm_loadu_ps(mata + 8);
+    __m128 c3 = _mm_loadu_ps(mata + 12);
+
+    __m128 result[4];
+    for (int j = 0; j < 4; j++) {
+        const float* b = matb + j * 4;
+        __m128 r = _mm_mul_ps(c0, _mm_set1_ps(b[0]));
+        r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(b[1])));
+        r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(b[2])));
+        result[j] = _mm_add_ps(r, _mm_mul_ps(c3, _mm_set1_ps(b[3])));
+    }
+
+    _mm_storeu_ps(mata, result[0]);
+    _mm_storeu_ps(mata + 4, result[1]);
+    _mm_storeu_ps(mata + 8, result[2]);
+    _mm_storeu_ps(mata + 12, result[3]);
+}
+
+/** Cramer's rule with 2x2 sub determinants, after Intel's "Streaming SIMD Extensions - Inverse of 4x4 Matrix". */
+bool inv4x4 (float* val) {
+    __m128 row0 = _mm_loadu_ps(val);
+    __m128 row1 = _mm_loadu_ps(val + 4);
+    __m128 row2 = _mm_loadu_ps(val + 8);
+    __m128 row3 = _mm_loadu_ps(val + 12);
+    _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+    row1 = _mm_shuffle_ps(row1, row1, 0x4E);
+    row3 = _mm_shuffle_ps(row3, row3, 0x4E);
+
+    __m128 minor0, minor1, minor2, minor3, tmp;
+
+    tmp = _mm_mul_ps(row2, row3);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+    minor0 = _mm_mul_ps(row1, tmp);
+    minor1 = _mm_mul_ps(row0, tmp);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+    minor0 = _mm_sub_ps(_mm_mul_ps(row1, tmp), minor0);
+    minor1 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor1);
+    minor1 = _mm_shuffle_ps(minor1, minor1, 0x4E);
+
+    tmp = _mm_mul_ps(row1, row2);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+    minor0 = _mm_add_ps(_mm_mul_ps(row3, tmp), minor0);
+    minor3 = _mm_mul_ps(row0, tmp);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+    minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row3, tmp));
+    minor3 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor3);
+    minor3 = _mm_shuffle_ps(minor3, minor3, 0x4E);
+
+    tmp = _mm_mul_ps(_mm_shuffle_ps(row1, row1, 0x4E), row3);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+    row2 = _mm_shuffle_ps(row2, row2, 0x4E);
+    minor0 = _mm_add_ps(_mm_mul_ps(row2, tmp), minor0);
+    minor2 = _mm_mul_ps(row0, tmp);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+    minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row2, tmp));
+    minor2 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor2);
+    minor2 = _mm_shuffle_ps(minor2, minor2, 0x4E);
+
+    tmp = _mm_mul_ps(row0, row1);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+    minor2 = _mm_add_ps(_mm_mul_ps(row3, tmp), minor2);
+    minor3 = _mm_sub_ps(_mm_mul_ps(row2, tmp), minor3);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+    minor2 = _mm_sub_ps(_mm_mul_ps(row3, tmp), minor2);
+    minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row2, tmp));
+
+    tmp = _mm_mul_ps(row0, row3);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+    minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row2, tmp));
+    minor2 = _mm_add_ps(_mm_mul_ps(row1, tmp), minor2);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+    minor1 = _mm_add_ps(_mm_mul_ps(row2, tmp), minor1);
+    minor2 = _mm_sub_ps(minor2, _mm_mul_ps(row1, tmp));
+
+    tmp = _mm_mul_ps(row0, row2);
+    tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+    minor1 = _mm_add_ps(_mm_mul_ps(row3, tmp), minor1);
+    minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row1, tmp));
+    tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+    minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row3, tmp));
+    minor3 = _mm_add_ps(_mm_mul_ps(row1, tmp), minor3);
+
+    __m128 det = _mm_mul_ps(row0, minor0);
+    det = _mm_add_ps(_mm_shuffle_ps(det, det, 0x4E), det);
+    det = _mm_add_ss(_mm_shuffle_ps(det, det, 0xB1), det);
+    float l_det = _mm_cvtss_f32(det);
+    if (l_det == 0) return false;
+
+    __m128 inv_det = _mm_set1_ps(1.0f / l_det);
+    _mm_storeu_ps(val, _mm_mul_ps(inv_det, minor0));
+    _mm_storeu_ps(val + 4, _mm_mul_ps(inv_det, minor1));
+    _mm_storeu_ps(val + 8, _mm_mul_ps(inv_det, minor2));
+    _mm_storeu_ps(val + 12, _mm_mul_ps(inv_det, minor3));
+    return true;
+}
+
+// The three and four component kernels keep one vector per register and broadcast its components against the matrix
+// columns. Three of four lanes do useful work, and on interleaved vertices this measured faster than transposing four
+// vectors per register, which pays for gathering and scattering every component with scalar loads and stores.
+void mulVec4x4 (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride) {
+    __m128 c0 = _mm_loadu_ps(mat);
+    __m128 c1 = _mm_loadu_ps(mat + 4);
+    __m128 c2 = _mm_loadu_ps(mat + 8);
+    __m128 c3 = _mm_loadu_ps(mat + 12);
+    for (int i = 0; i < numVecs; i++, src += srcStride, dst += dstStride) {
+        __m128 r = _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(src[0])), _mm_mul_ps(c1, _mm_set1_ps(src[1])));
+        r = _mm_add_ps(r, _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(src[2])), c3));
+        storeXYZ(dst, r);
+    }
+}
+
+void prj4x4 (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride) {
+    __m128 c0 = _mm_loadu_ps(mat);
+    __m128 c1 = _mm_loadu_ps(mat + 4);
+    __m128 c2 = _mm_loadu_ps(mat + 8);
+    __m128 c3 = _mm_loadu_ps(mat + 12);
+    for (int i = 0; i < numVecs; i++, src += srcStride, dst += dstStride) {
+        __m128 r = _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(src[0])), _mm_mul_ps(c1, _mm_set1_ps(src[1])));
+        r = _mm_add_ps(r, _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(src[2])), c3));
+        storeXYZ(dst, _mm_div_ps(r, _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3))));
+    }
+}
+
+void rot4x4 (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride) {
+    __m128 c0 = _mm_loadu_ps(mat);
+    __m128 c1 = _mm_loadu_ps(mat + 4);
+    __m128 c2 = _mm_loadu_ps(mat + 8);
+    for (int i = 0; i < numVecs; i++, src += srcStride, dst += dstStride) {
+        __m128 r = _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(src[0])), _mm_mul_ps(c1, _mm_set1_ps(src[1])));
+        storeXYZ(dst, _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(src[2]))));
+    }
+}
+
+/** Four components in, four out: the matrix times a homogeneous vector */
+static void mulHomogeneous4x4 (const float* mat, const float* src, float* dst, int numVecs, int srcStride,
+                               int dstStride) {
+    __m128 c0 = _mm_loadu_ps(mat);
+    __m128 c1 = _mm_loadu_ps(mat + 4);
+    __m128 c2 = _mm_loadu_ps(mat + 8);
+    __m128 c3 = _mm_loadu_ps(mat + 12);
+    for (int i = 0; i < numVecs; i++, src += srcStride, dst += dstStride) {
+        __m128 r = _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(src[0])), _mm_mul_ps(c1, _mm_set1_ps(src[1])));
+        r = _mm_add_ps(r, _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(src[2])), _mm_mul_ps(c3, _mm_set1_ps(src[3]))));
+        _mm_storeu_ps(dst, r);
+    }
+}
+
+static void mulLinear3x3 (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride) {
+    __m128 c0 = _mm_setr_ps(mat[0], mat[1], mat[2], 0);
+    __m128 c1 = _mm_setr_ps(mat[3], mat[4], mat[5], 0);
+    __m128 c2 = _mm_setr_ps(mat[6], mat[7], mat[8], 0);
+    for (int i = 0; i < numVecs; i++, src += srcStride, dst += dstStride) {
+        __m128 r = _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(src[0])), _mm_mul_ps(c1, _mm_set1_ps(src[1])));
+        storeXYZ(dst, _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(src[2]))));
+    }
+}
+
+/** Packed x,y pairs, as in Polygon: two points per register, no gathering needed. Returns how many were done. */
+static int mulPackedPairs3x3 (const float* mat, const float* src, float* dst, int numVecs) {
+    __m128 m0 = _mm_setr_ps(mat[0], mat[1], mat[0], mat[1]);
+    __m128 m1 = _mm_setr_ps(mat[3], mat[4], mat[3], mat[4]);
+    __m128 m2 = _mm_setr_ps(mat[6], mat[7], mat[6], mat[7]);
+    int done = 0;
+    for (; done + 2 <= numVecs; done += 2, src += 4, dst += 4) {
+        __m128 v = _mm_loadu_ps(src);
+        __m128 xx = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 0, 0));
+        __m128 yy = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 1, 1));
+        _mm_storeu_ps(dst, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, xx), _mm_mul_ps(m1, yy)), m2));
+    }
+    return done;
+}
+
+#elif defined(GDX_CPP_SIMD_NEON)
+
+static inline void storeXYZ (float* dst, float32x4_t v) {
+    vst1_f32(dst, vget_low_f32(v));
+    vst1q_lane_f32(dst + 2, v, 2);
+}
+
+/** _mm_shuffle_ps(v, v, 0x4E) */
+static inline float32x4_t swapHalves (float32x4_t v) {
+    return vextq_f32(v, v, 2);
+}
+
+/** _mm_shuffle_ps(v, v, 0xB1) */
+static inline float32x4_t swapPairs (float32x4_t v) {
+    return vrev64q_f32(v);
+}
+
+void mul4x4 (float* mata, const float* matb) {
+    float32x4_t c0 = vld1q_f32(mata);
+    float32x4_t c1 = vld1q_f32(mata + 4);
+    float32x4_t c2 = vld1q_f32(mata + 8);
+    float32x4_t c3 = vld1q_f32(mata + 12);
+
+    float32x4_t result[4];
+    for (int j = 0; j < 4; j++) {
+        const float* b = matb + j * 4;
+        float32x4_t r = vmulq_n_f32(c0, b[0]);
+        r = vmlaq_n_f32(r, c1, b[1]);
+        r = vmlaq_n_f32(r, c2, b[2]);
+        result[j] = vmlaq_n_f32(r, c3, b[3]);
+    }
+
+    vst1q_f32(mata, result[0]);
+    vst1q_f32(mata + 4, result[1]);
+    vst1q_f32(mata + 8, result[2]);
+    vst1q_f32(mata + 12, result[3]);
+}
+
+/** The SSE inverse above, with vext and vrev64 for the half and pair swaps */
+bool inv4x4 (float* val) {
+    float32x4_t row0 = vld1q_f32(val);
+    float32x4_t row1 = vld1q_f32(val + 4);
+    float32x4_t row2 = vld1q_f32(val + 8);
+    float32x4_t row3 = vld1q_f32(val + 12);
+    SimdLane::transpose(row0, row1, row2, row3);
+    row1 = swapHalves(row1);
+    row3 = swapHalves(row3);
+
+    float32x4_t minor0, minor1, minor2, minor3, tmp;
+
+    tmp = vmulq_f32(row2, row3);
+    tmp = swapPairs(tmp);
+    minor0 = vmulq_f32(row1, tmp);
+    minor1 = vmulq_f32(row0, tmp);
+    tmp = swapHalves(tmp);
+    minor0 = vsubq_f32(vmulq_f32(row1, tmp), minor0);
+    minor1 = vsubq_f32(vmulq_f32(row0, tmp), minor1);
+    minor1 = swapHalves(minor1);
+
+    tmp = vmulq_f32(row1, row2);
+    tmp = swapPairs(tmp);
+    minor0 = vaddq_f32(vmulq_f32(row3, tmp), minor0);
+    minor3 = vmulq_f32(row0, tmp);
+    tmp = swapHalves(tmp);
+    minor0 = vsubq_f32(minor0, vmulq_f32(row3, tmp));
+    minor3 = vsubq_f32(vmulq_f32(row0, tmp), minor3);
+    minor3 = swapHalves(minor3);
+
+    tmp = vmulq_f32(swapHalves(row1), row3);
+    tmp = swapPairs(tmp);
+    row2 = swapHalves(row2);
+    minor0 = vaddq_f32(vmulq_f32(row2, tmp), minor0);
+    minor2 = vmulq_f32(row0, tmp);
+    tmp = swapHalves(tmp);
+    minor0 = vsubq_f32(minor0, vmulq_f32(row2, tmp));
+    minor2 = vsubq_f32(vmulq_f32(row0, tmp), minor2);
+    minor2 = swapHalves(minor2);
+
+    tmp = vmulq_f32(row0, row1);
+    tmp = swapPairs(tmp);
+    minor2 = vaddq_f32(vmulq_f32(row3, tmp), minor2);
+    minor3 = vsubq_f32(vmulq_f32(row2, tmp), minor3);
+    tmp = swapHalves(tmp);
+    minor2 = vsubq_f32(vmulq_f32(row3, tmp), minor2);
+    minor3 = vsubq_f32(minor3, vmulq_f32(row2, tmp));
+
+    tmp = vmulq_f32(row0, row3);
+    tmp = swapPairs(tmp);
+    minor1 = vsubq_f32(minor1, vmulq_f32(row2, tmp));
+    minor2 = vaddq_f32(vmulq_f32(row1, tmp), minor2);
+    tmp = swapHalves(tmp);
+    minor1 = vaddq_f32(vmulq_f32(row2, tmp), minor1);
+    minor2 = vsubq_f32(minor2, vmulq_f32(row1, tmp));
+
+    tmp = vmulq_f32(row0, row2);
+    tmp = swapPairs(tmp);
+    minor1 = vaddq_f32(vmulq_f32(row3, tmp), minor1);
+    minor3 = vsubq_f32(minor3, vmulq_f32(row1, tmp));
+    tmp = swapHalves(tmp);
+    minor1 = vsubq_f32(minor1, vmulq_f32(row3, tmp));
+    minor3 = vaddq_f32(vmulq_f32(row1, tmp), minor3);
+
+    float32x4_t det = vmulq_f32(row0, minor0);
+    det = vaddq_f32(swapHalves(det), det);
+    det = vaddq_f32(swapPairs(det), det);
+    float l_det = vgetq_lane_f32(det, 0);
+    if (l_det == 0) return false;
+
+    float32x4_t inv_det = vdupq_n_f32(1.0f / l_det);
+    vst1q_f32(val, vmulq_f32(inv_det, minor0));
+    vst1q_f32(val + 4, vmulq_f32(inv_det, minor1));
+    vst1q_f32(val + 8, vmulq_f32(inv_det, minor2));
+    vst1q_f32(val + 12, vmulq_f32(inv_det, minor3));
+    return true;
+}
+
+void mulVec4x4 (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride) {
+    float32x4_t c0 = vld1q_f32(mat);
+    float32x4_t c1 = vld1q_f32(mat + 4);
+    float32x4_t c2 = vld1q_f32(mat + 8);
+    float32x4_t c3 = vld1q_f32(mat + 12);
+    for (int i = 0; i < numVecs; i++, src += srcStride, dst += dstStride) {
+        float32x4_t r = vmlaq_n_f32(c3, c0, src[0]);
+        r = vmlaq_n_f32(r, c1, src[1]);
+        storeXYZ(dst, vmlaq_n_f32(r, c2, src[2]));
+    }
+}
+
+void prj4x4 (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride) {
+    float32x4_t c0 = vld1q_f32(mat);
+    float32x4_t c1 = vld1q_f32(mat + 4);
+    float32x4_t c2 = vld1q_f32(mat + 8);
+    float32x4_t c3 = vld1q_f32(mat + 12);
+    for (int i = 0; i < numVecs; i++, src += srcStride, dst += dstStride) {
+        float32x4_t r = vmlaq_n_f32(c3, c0, src[0]);
+        r = vmlaq_n_f32(r, c1, src[1]);
+        r = vmlaq_n_f32(r, c2, src[2]);
+        storeXYZ(dst, vmulq_n_f32(r, 1.0f / vgetq_lane_f32(r, 3)));
+    }
+}
+
+void rot4x4 (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride) {
+    float32x4_t c0 = vld1q_f32(mat);
+    float32x4_t c1 = vld1q_f32(mat + 4);
+    float32x4_t c2 = vld1q_f32(mat + 8);
+    for (int i = 0; i < numVecs; i++, src += srcStride, dst += dstStride) {
+        float32x4_t r = vmulq_n_f32(c0, src[0]);
+        r = vmlaq_n_f32(r, c1, src[1]);
+        storeXYZ(dst, vmlaq_n_f32(r, c2, src[2]));
+    }
+}
+
+static void mulHomogeneous4x4 (const float* mat, const float* src, float* dst, int numVecs, int srcStride,
+                               int dstStride) {
+    float32x4_t c0 = vld1q_f32(mat);
+    float32x4_t c1 = vld1q_f32(mat + 4);
+    float32x4_t c2 = vld1q_f32(mat + 8);
+    float32x4_t c3 = vld1q_f32(mat + 12);
+    for (int i = 0; i < numVecs; i++, src += srcStride, dst += dstStride) {
+        float32x4_t r = vmulq_n_f32(c0, src[0]);
+        r = vmlaq_n_f32(r, c1, src[1]);
+        r = vmlaq_n_f32(r, c2, src[2]);
+        vst1q_f32(dst, vmlaq_n_f32(r, c3, src[3]));
+    }
+}
+
+static void mulLinear3x3 (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride) {
+    float32x4_t c0 = { mat[0], mat[1], mat[2], 0 };
+    float32x4_t c1 = { mat[3], mat[4], mat[5], 0 };
+    float32x4_t c2 = { mat[6], mat[7], mat[8], 0 };
+    for (int i = 0; i < numVecs; i++, src += srcStride, dst += dstStride) {
+        float32x4_t r = vmulq_n_f32(c0, src[0]);
+        r = vmlaq_n_f32(r, c1, src[1]);
+        storeXYZ(dst, vmlaq_n_f32(r, c2, src[2]));
+    }
+}
+
+/** Packed x,y pairs, as in Polygon: vld2 deinterleaves four points at a time. Returns how many were done. */
+static int mulPackedPairs3x3 (const float* mat, const float* src, float* dst, int numVecs) {
+    int done = 0;
+    for (; done + 4 <= numVecs; done += 4, src += 8, dst += 8) {
+        float32x4x2_t v = vld2q_f32(src);
+        float32x4x2_t r;
+        r.val[0] = vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(mat[6]), v.val[0], mat[0]), v.val[1], mat[3]);
+        r.val[1] = vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(mat[7]), v.val[0], mat[1]), v.val[1], mat[4]);
+        vst2q_f32(dst, r);
+    }
+    return done;
+}
+
+#else
+
+void mul4x4 (float* mata, const float* matb) {
+    scalar::mul4x4(mata, matb);
+}
+
+bool inv4x4 (float* val) {
+    return scalar::inv4x4(val);
+}
+
+void mulVec4x4 (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride) {
+    scalar::mulVec4x4(mat, src, dst, numVecs, srcStride, dstStride);
+}
+
+void prj4x4 (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride) {
+    scalar::prj4x4(mat, src, dst, numVecs, srcStride, dstStride);
+}
+
+void rot4x4 (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride) {
+    scalar::rot4x4(mat, src, dst, numVecs, srcStride, dstStride);
+}
+
+void mulVec3x3 (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride) {
+    scalar::mulVec3x3(mat, src, dst, numVecs, srcStride, dstStride);
+}
+
+#endif
+
+#if defined(GDX_CPP_SIMD_SSE) || defined(GDX_CPP_SIMD_NEON)
+
+// Two components leave half of a broadcast register idle, so these go through the transposed loop
+void mulVec3x3 (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride) {
+    int done = srcStride == 2 && dstStride == 2 ? mulPackedPairs3x3(mat, src, dst, numVecs) : 0;
+    done += mulVec3Lanes<SimdLane>(mat, src + done * srcStride, dst + done * dstStride, numVecs - done, srcStride,
+                                   dstStride);
+    scalar::mulVec3x3(mat, src + done * srcStride, dst + done * dstStride, numVecs - done, srcStride, dstStride);
+}
+
+void mulVecN4x4 (const float* mat, int dimensions, const float* src, float* dst, int numVecs, int srcStride,
+                 int dstStride) {
+    int done = 0;
+    switch (dimensions) {
+    case 1:
+        done = mulVecLanes<SimdLane, 1>(mat, src, dst, numVecs, srcStride, dstStride);
+        mulVecLanes<ScalarLane, 1>(mat, src + done * srcStride, dst + done * dstStride, numVecs - done, srcStride,
+                                   dstStride);
+        break;
+    case 2:
+        done = mulVecLanes<SimdLane, 2>(mat, src, dst, numVecs, srcStride, dstStride);
+        mulVecLanes<ScalarLane, 2>(mat, src + done * srcStride, dst + done * dstStride, numVecs - done, srcStride,
+                                   dstStride);
+        break;
+    case 3:
+        mulVec4x4(mat, src, dst, numVecs, srcStride, dstStride);
+        break;
+    case 4:
+        mulHomogeneous4x4(mat, src, dst, numVecs, srcStride, dstStride);
+        break;
+    }
+}
+
+void mulVecN3x3 (const float* mat, int dimensions, const float* src, float* dst, int numVecs, int srcStride,
+                 int dstStride) {
+    if (dimensions == 2)
+        mulVec3x3(mat, src, dst, numVecs, srcStride, dstStride);
+    else
+        mulLinear3x3(mat, src, dst, numVecs, srcStride, dstStride);
+}
+
+#else
+
+void mulVecN4x4 (const float* mat, int dimensions, const float* src, float* dst, int numVecs, int srcStride,
+                 int dstStride) {
+    scalar::mulVecN4x4(mat, dimensions, src, dst, numVecs, srcStride, dstStride);
+}
+
+void mulVecN3x3 (const float* mat, int dimensions, const float* src, float* dst, int numVecs, int srcStride,
+                 int dstStride) {
+    scalar::mulVecN3x3(mat, dimensions, src, dst, numVecs, srcStride, dstStride);
+}
+
+#endif
+
+}
+
+}
+}
+}
@@ -0,0 +1,67 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef GDX_CPP_MATH_DETAIL_MATRIXKERNELS_HPP
+#define GDX_CPP_MATH_DETAIL_MATRIXKERNELS_HPP
+
+namespace gdx_cpp {
+namespace math {
+namespace detail {
+
+/** Raw kernels behind the float* statics of Matrix4 and Matrix3. Matrices are column major, as in Matrix4::val and
+ * Matrix3::vals. The vector kernels read numVecs vectors from src and write them to dst, advancing srcStride and
+ * dstStride floats per vector; src and dst may alias when the strides are equal. Only the components a kernel
+ * produces are written, so interleaved attributes after the position are left untouched.
+ *
+ * mulVecN4x4 takes vectors of 1 to 4 components, a missing y or z being 0 and a missing w 1, and writes all of them;
+ * mulVec4x4 is its three component case. mulVecN3x3 takes two components, the affine transform of mulVec3x3, or three
+ * for a plain 3x3 multiplication. Other dimensions are ignored.
+ *
+ * The scalar namespace holds the portable reference implementation, the simd namespace the SSE2/NEON one (which
+ * falls back to the scalar code when SIMD is unavailable, see utils/Simd.hpp). Both are exposed so they can be
+ * compared by the benchmarks. mulAffine3x3 is scalar only: its six multiply-adds leave nothing for SIMD to win. */
+namespace scalar {
+void mul4x4 (float* mata, const float* matb);
+bool inv4x4 (float* val);
+void mulVec4x4 (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride);
+void prj4x4 (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride);
+void rot4x4 (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride);
+void mulAffine3x3 (float* mata, const float* matb);
+void mulVec3x3 (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride);
+void mulVecN4x4 (const float* mat, int dimensions, const float* src, float* dst, int numVecs, int srcStride,
+                 int dstStride);
+void mulVecN3x3 (const float* mat, int dimensions, const float* src, float* dst, int numVecs, int srcStride,
+                 int dstStride);
+}
+
+namespace simd {
+void mul4x4 (float* mata, const float* matb);
+bool inv4x4 (float* val);
+void mulVec4x4 (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride);
+void prj4x4 (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride);
+void rot4x4 (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride);
+void mulVec3x3 (const float* mat, const float* src, float* dst, int numVecs, int srcStride, int dstStride);
+void mulVecN4x4 (const float* mat, int dimensions, const float* src, float* dst, int numVecs, int srcStride,
+                 int dstStride);
+void mulVecN3x3 (const float* mat, int dimensions, const float* src, float* dst, int numVecs, int srcStride,
+                 int dstStride);
+}
+
+}
+}
+}
+
+#endif // GDX_CPP_MATH_DETAIL_MATRIXKERNELS_HPP
@@ -0,0 +1,307 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef GDX_CPP_MATH_DETAIL_SIMDLANES_HPP
+#define GDX_CPP_MATH_DETAIL_SIMDLANES_HPP
+
+#include <cmath>
+#include <cstddef>
+
+#include "gdx-cpp/utils/Simd.hpp"
+
+namespace gdx_cpp {
+namespace math {
+namespace detail {
+
+/** Lane types for kernels written once as templates: ScalarLane handles one float at a time (the tails, and everything
+ * when SIMD is off), SimdLane four at a time with SSE2 or NEON. SimdLane is only defined when GDX_CPP_SIMD_SSE or
+ * GDX_CPP_SIMD_NEON is. */
+struct ScalarLane {
+    typedef float F;
+    typedef int I;
+    typedef bool M;
+    static const int WIDTH = 1;
+
+    static F load (const float* p) { return *p; }
+    static void store (float* p, F v) { *p = v; }
+    static F set (float v) { return v; }
+    static F add (F a, F b) { return a + b; }
+    static F sub (F a, F b) { return a - b; }
+    static F mul (F a, F b) { return a * b; }
+    static F div (F a, F b) { return a / b; }
+    static F min (F a, F b) { return a < b ? a : b; }
+    static F max (F a, F b) { return a > b ? a : b; }
+    static F abs (F a) { return std::fabs(a); }
+    static F sqrt (F a) { return std::sqrt(a); }
+    static F rsqrt (F a) { return 1.0f / std::sqrt(a); }
+    static I roundToInt (F a) { return (int) std::floor(a + 0.5f); }
+    static F toFloat (I a) { return (float) a; }
+    static I addInt (I a, int b) { return a + b; }
+    static M testBit (I a, int bit) { return (a & bit) != 0; }
+    static M lessThan (F a, F b) { return a < b; }
+    static M equal (F a, F b) { return a == b; }
+    static F select (M m, F a, F b) { return m ? a : b; }
+    /** Set for negative values including -0, unlike lessThan(a, 0) */
+    static M signBit (F a) { return std::signbit(a); }
+    static F copySign (F magnitude, F sign) { return std::copysign(magnitude, sign); }
+
+    static F gather (const float* p, int stride) { return *p; }
+    static void scatter (float* p, int stride, F v) { *p = v; }
+    static void loadTransposed (const float* p, int stride, F& x, F& y, F& z, F& w) {
+        x = p[0];
+        y = p[1];
+        z = p[2];
+        w = p[3];
+    }
+    static void storeTransposed (float* p, int stride, F x, F y, F z, F w) {
+        p[0] = x;
+        p[1] = y;
+        p[2] = z;
+        p[3] = w;
+    }
+};
+
+#if defined(GDX_CPP_SIMD_SSE)
+struct SimdLane {
+    typedef __m128 F;
+    typedef __m128i I;
+    typedef __m128 M;
+    static const int WIDTH = 4;
+
+    static F load (const float* p) { return _mm_loadu_ps(p); }
+    static void store (float* p, F v) { _mm_storeu_ps(p, v); }
+    static F set (float v) { return _mm_set1_ps(v); }
+    static F add (F a, F b) { return _mm_add_ps(a, b); }
+    static F sub (F a, F b) { return _mm_sub_ps(a, b); }
+    static F mul (F a, F b) { return _mm_mul_ps(a, b); }
+    static F div (F a, F b) { return _mm_div_ps(a, b); }
+    static F min (F a, F b) { return _mm_min_ps(a, b); }
+    static F max (F a, F b) { return _mm_max_ps(a, b); }
+    static F abs (F a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    static F sqrt (F a) { return _mm_sqrt_ps(a); }
+    static F rsqrt (F a) {
+        // one Newton-Raphson step takes the 12 bit estimate to about 22 bits
+        F r = _mm_rsqrt_ps(a);
+        return _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), r),
+                          _mm_sub_ps(_mm_set1_ps(3.0f), _mm_mul_ps(_mm_mul_ps(a, r), r)));
+    }
+    static I roundToInt (F a) { return _mm_cvtps_epi32(a); }
+    static F toFloat (I a) { return _mm_cvtepi32_ps(a); }
+    static I addInt (I a, int b) { return _mm_add_epi32(a, _mm_set1_epi32(b)); }
+    static M testBit (I a, int bit) {
+        __m128i b = _mm_set1_epi32(bit);
+        return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(a, b), b));
+    }
+    static M lessThan (F a, F b) { return _mm_cmplt_ps(a, b); }
+    static M equal (F a, F b) { return _mm_cmpeq_ps(a, b); }
+    static F select (M m, F a, F b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+    static M signBit (F a) { return _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(a), 31)); }
+    static F copySign (F magnitude, F sign) {
+        F mask = _mm_set1_ps(-0.0f);
+        return _mm_or_ps(_mm_andnot_ps(mask, magnitude), _mm_and_ps(mask, sign));
+    }
+
+    /** p[0], p[stride], p[stride * 2] and p[stride * 3] in one register, and back */
+    static F gather (const float* p, int stride) { return _mm_setr_ps(p[0], p[stride], p[stride * 2], p[stride * 3]); }
+    static void scatter (float* p, int stride, F v) {
+        _mm_store_ss(p, v);
+        _mm_store_ss(p + stride, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)));
+        _mm_store_ss(p + stride * 2, _mm_movehl_ps(v, v));
+        _mm_store_ss(p + stride * 3, _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)));
+    }
+
+    /** Loads four groups of four floats, stride floats apart, as one register per component */
+    static void loadTransposed (const float* p, int stride, F& x, F& y, F& z, F& w) {
+        x = _mm_loadu_ps(p);
+        y = _mm_loadu_ps(p + stride);
+        z = _mm_loadu_ps(p + stride * 2);
+        w = _mm_loadu_ps(p + stride * 3);
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+    }
+    static void storeTransposed (float* p, int stride, F x, F y, F z, F w) {
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+        _mm_storeu_ps(p, x);
+        _mm_storeu_ps(p + stride, y);
+        _mm_storeu_ps(p + stride * 2, z);
+        _mm_storeu_ps(p + stride * 3, w);
+    }
+};
+#elif defined(GDX_CPP_SIMD_NEON)
+struct SimdLane {
+    typedef float32x4_t F;
+    typedef int32x4_t I;
+    typedef uint32x4_t M;
+    static const int WIDTH = 4;
+
+    static F load (const float* p) { return vld1q_f32(p); }
+    static void store (float* p, F v) { vst1q_f32(p, v); }
+    static F set (float v) { return vdupq_n_f32(v); }
+    static F add (F a, F b) { return vaddq_f32(a, b); }
+    static F sub (F a, F b) { return vsubq_f32(a, b); }
+    static F mul (F a, F b) { return vmulq_f32(a, b); }
+    static F div (F a, F b) {
+        // two Newton-Raphson steps on the reciprocal estimate, ARMv7 has no vector division
+        F r = vrecpeq_f32(b);
+        r = vmulq_f32(vrecpsq_f32(b, r), r);
+        r = vmulq_f32(vrecpsq_f32(b, r), r);
+        return vmulq_f32(a, r);
+    }
+    static F min (F a, F b) { return vminq_f32(a, b); }
+    static F max (F a, F b) { return vmaxq_f32(a, b); }
+    static F abs (F a) { return vabsq_f32(a); }
+    static F rsqrt (F a) {
+        F r = vrsqrteq_f32(a);
+        r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a, r), r), r);
+        return vmulq_f32(vrsqrtsq_f32(vmulq_f32(a, r), r), r);
+    }
+    static F sqrt (F a) {
+        return vbslq_f32(vceqq_f32(a, vdupq_n_f32(0)), vdupq_n_f32(0), vmulq_f32(a, rsqrt(a)));
+    }
+    static I roundToInt (F a) {
+        // vcvtq truncates, round half away from zero instead
+        F half = vbslq_f32(vcltq_f32(a, vdupq_n_f32(0)), vdupq_n_f32(-0.5f), vdupq_n_f32(0.5f));
+        return vcvtq_s32_f32(vaddq_f32(a, half));
+    }
+    static F toFloat (I a) { return vcvtq_f32_s32(a); }
+    static I addInt (I a, int b) { return vaddq_s32(a, vdupq_n_s32(b)); }
+    static M testBit (I a, int bit) { return vtstq_s32(a, vdupq_n_s32(bit)); }
+    static M lessThan (F a, F b) { return vcltq_f32(a, b); }
+    static M equal (F a, F b) { return vceqq_f32(a, b); }
+    static F select (M m, F a, F b) { return vbslq_f32(m, a, b); }
+    static M signBit (F a) { return vreinterpretq_u32_s32(vshrq_n_s32(vreinterpretq_s32_f32(a), 31)); }
+    static F copySign (F magnitude, F sign) { return vbslq_f32(vdupq_n_u32(0x80000000), sign, magnitude); }
+
+    static F gather (const float* p, int stride) {
+        F v = vld1q_dup_f32(p);
+        v = vld1q_lane_f32(p + stride, v, 1);
+        v = vld1q_lane_f32(p + stride * 2, v, 2);
+        return vld1q_lane_f32(p + stride * 3, v, 3);
+    }
+    static void scatter (float* p, int stride, F v) {
+        vst1q_lane_f32(p, v, 0);
+        vst1q_lane_f32(p + stride, v, 1);
+        vst1q_lane_f32(p + stride * 2, v, 2);
+        vst1q_lane_f32(p + stride * 3, v, 3);
+    }
+
+    static void transpose (F& x, F& y, F& z, F& w) {
+        float32x4x2_t t01 = vtrnq_f32(x, y);
+        float32x4x2_t t23 = vtrnq_f32(z, w);
+        x = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+        y = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+        z = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+        w = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+    }
+    static void loadTransposed (const float* p, int stride, F& x, F& y, F& z, F& w) {
+        x = vld1q_f32(p);
+        y = vld1q_f32(p + stride);
+        z = vld1q_f32(p + stride * 2);
+        w = vld1q_f32(p + stride * 3);
+        transpose(x, y, z, w);
+    }
+    static void storeTransposed (float* p, int stride, F x, F y, F z, F w) {
+        transpose(x, y, z, w);
+        vst1q_f32(p, x);
+        vst1q_f32(p + stride, y);
+        vst1q_f32(p + stride * 2, z);
+        vst1q_f32(p + stride * 3, w);
+    }
+};
+#endif
+
+/** Reduces x to r in [-pi/4, pi/4] with x = r + q * pi/2 and evaluates minimax polynomials (from Cephes) for sin r and
+ * cos r, then picks and negates them by quadrant. pi/2 is split in three parts so the reduction stays exact for
+ * larger arguments. */
+template <class L>
+inline void sinCosLane (typename L::F x, typename L::F* sinOut, typename L::F* cosOut, bool accurate) {
+    typedef typename L::F F;
+    typedef typename L::I I;
+
+    I q = L::roundToInt(L::mul(x, L::set(0.636619772f)));
+    F qf = L::toFloat(q);
+    F r = L::sub(x, L::mul(qf, L::set(1.5703125f)));
+    r = L::sub(r, L::mul(qf, L::set(4.837512969970703125e-4f)));
+    r = L::sub(r, L::mul(qf, L::set(7.54978995489188216e-8f)));
+
+    F z = L::mul(r, r);
+    F s, c;
+    if (accurate) {
+        s = L::add(L::mul(L::set(-1.9515295891e-4f), z), L::set(8.3321608736e-3f));
+        s = L::add(L::mul(s, z), L::set(-1.6666654611e-1f));
+        c = L::add(L::mul(L::set(2.443315711809948e-5f), z), L::set(-1.388731625493765e-3f));
+        c = L::add(L::mul(c, z), L::set(4.166664568298827e-2f));
+    } else {
+        s = L::add(L::mul(L::set(8.3321608736e-3f), z), L::set(-1.6666654611e-1f));
+        c = L::set(4.166664568298827e-2f);
+    }
+    s = L::add(L::mul(L::mul(s, z), r), r);
+    c = L::add(L::sub(L::mul(L::mul(c, z), z), L::mul(z, L::set(0.5f))), L::set(1.0f));
+
+    // odd quadrants swap sine and cosine
+    typename L::M swap = L::testBit(q, 1);
+    F zero = L::set(0);
+    if (sinOut != NULL) {
+        F v = L::select(swap, c, s);
+        *sinOut = L::select(L::testBit(q, 2), L::sub(zero, v), v);
+    }
+    if (cosOut != NULL) {
+        F v = L::select(swap, s, c);
+        *cosOut = L::select(L::testBit(L::addInt(q, 1), 2), L::sub(zero, v), v);
+    }
+}
+
+/** atan of the ratio of the smaller to the larger magnitude, unfolded into the full circle by octant */
+template <class L>
+inline typename L::F atan2Lane (typename L::F y, typename L::F x, bool accurate) {
+    typedef typename L::F F;
+    typedef typename L::M M;
+
+    F zero = L::set(0);
+    F ax = L::abs(x), ay = L::abs(y);
+    F mn = L::min(ax, ay), mx = L::max(ax, ay);
+    M bothZero = L::equal(mx, zero);
+    F a = L::select(bothZero, zero, L::div(mn, L::select(bothZero, L::set(1), mx)));
+
+    F r;
+    if (accurate) {
+        // a > tan(pi/8) is mapped to (a - 1) / (a + 1) around pi/4
+        M big = L::lessThan(L::set(0.414213562f), a);
+        F t = L::select(big, L::div(L::sub(a, L::set(1)), L::add(a, L::set(1))), a);
+        F z = L::mul(t, t);
+        F p = L::add(L::mul(L::set(8.05374449538e-2f), z), L::set(-1.38776856032e-1f));
+        p = L::add(L::mul(p, z), L::set(1.99777106478e-1f));
+        p = L::add(L::mul(p, z), L::set(-3.33329491539e-1f));
+        r = L::add(L::mul(L::mul(p, z), t), t);
+        r = L::select(big, L::add(r, L::set(0.785398163f)), r);
+    } else {
+        F z = L::mul(a, a);
+        F p = L::add(L::mul(L::set(-0.0464964749f), z), L::set(0.15931422f));
+        p = L::add(L::mul(p, z), L::set(-0.327622764f));
+        r = L::add(L::mul(L::mul(p, z), a), a);
+    }
+
+    // the signs are taken from the sign bits so -0 lands on the same side of the branch cut as in the C library:
+    // atan2(-0, -1) is -pi and atan2(-0, 1) is -0
+    r = L::select(L::lessThan(ax, ay), L::sub(L::set(1.570796327f), r), r);
+    r = L::select(L::signBit(x), L::sub(L::set(3.141592654f), r), r);
+    return L::copySign(r, y);
+}
+
+}
+}
+}
+
+#endif // GDX_CPP_MATH_DETAIL_SIMDLANES_HPP
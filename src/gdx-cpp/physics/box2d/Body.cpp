@@ -72,7 +72,7 @@ Fixture& Body::createFixture (const Shape& _shape,float density) {
 
 void Body::destroyFixture (Fixture& fixture) {
     body->DestroyFixture(fixture.addr);
-    this->world->fixtures.erase(fixture.addr);
+    this->world->fixtures.remove(fixture.addr);
     this->fixtures.erase(&fixture);
     this->world->freeFixtures.free(&fixture);
 }
@@ -208,14 +208,14 @@ Body& World::createBody (const BodyDef& def) {
 }
 
 void World::destroyBody (Body& body) {
-    this->bodies.erase(body.body);
+    this->bodies.remove(body.body);
     std::set<Fixture *>::iterator it = body.getFixtureList().begin();
     for (; it != body.getFixtureList().end(); ++it)
-        this->fixtures.erase((*it)->addr);
+        this->fixtures.remove((*it)->addr);
 
     std::set<JointEdge *>::iterator itj = body.getJointList().begin();
     for (; itj != body.getJointList().end(); ++itj)
-        this->joints.erase((*itj)->joint->addr);
+        this->joints.remove((*itj)->joint->addr);
     addr->DestroyBody(body.body);
     freeBodies.free(&body);
 }
@@ -392,7 +392,7 @@ b2Joint* World::createProperJoint (gdx_cpp::physics::box2d::JointDef& def) {
 }
 
 void World::destroyJoint (Joint& joint) {
-    joints.erase(joint.addr);
+    joints.remove(joint.addr);
     joint.jointEdgeA->other->joints.erase(joint.jointEdgeB);
     joint.jointEdgeB->other->joints.erase(joint.jointEdgeA);
     this->addr->DestroyJoint(joint.addr);
@@ -26,7 +26,7 @@
 #include <vector>
 #include "Fixture.hpp"
 #include <gdx-cpp/utils/Pool.hpp>
-#include <tr1/unordered_map>
+#include <gdx-cpp/utils/IdentityMap.hpp>
 #include "ContactListener.hpp"
 #include "ContactFilter.hpp"
 
@@ -96,12 +96,28 @@ public:
     void postSolve (b2Contact* contact, b2ContactImpulse* impulse);
     bool reportFixture (b2Fixture* addr);
 
-    gdx_cpp::utils::Pool<Body> freeBodies;
-    gdx_cpp::utils::Pool<Fixture> freeFixtures;
+    /** Freed bodies hand their fixtures back to freeFixtures right away instead of on their next use */
+    class BodyPool : public gdx_cpp::utils::Pool<Body> {
+    protected:
+        void reset (Body& body) {
+            body.reset(NULL);
+        }
+    };
+
+    /** Freed fixtures drop their reference to the body */
+    class FixturePool : public gdx_cpp::utils::Pool<Fixture> {
+    protected:
+        void reset (Fixture& fixture) {
+            fixture.reset(Body::ptr(), NULL);
+        }
+    };
+
+    BodyPool freeBodies;
+    FixturePool freeFixtures;
     
-    std::tr1::unordered_map<b2Fixture*, Fixture*> fixtures;
-    std::tr1::unordered_map<b2Body*, Body*> bodies;
-    std::tr1::unordered_map<b2Joint*, Joint*> joints;
+    gdx_cpp::utils::IdentityMap<b2Fixture, Fixture*> fixtures;
+    gdx_cpp::utils::IdentityMap<b2Body, Body*> bodies;
+    gdx_cpp::utils::IdentityMap<b2Joint, Joint*> joints;
     ContactFilter::ptr contactFilterVar;
     ContactListener::ptr contactListener;
 
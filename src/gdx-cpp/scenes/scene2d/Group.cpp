@@ -19,22 +19,16 @@
 */
 
 #include "Group.hpp"
+#include "gdx-cpp/utils/Sort.hpp"
 
 using namespace gdx_cpp::scenes::scene2d;
 
 void Group::updateTransform () {
-    if (originX != 0 || originY != 0)
-        transform.setToTranslation(originX, originY);
-    else
-        transform.idt();
-    if (rotation != 0) transform.mul(scenetransform.setToRotation(rotation));
-    if (scaleX != 1 || scaleY != 1) transform.mul(scenetransform.setToScaling(scaleX, scaleY));
-    if (originX != 0 || originY != 0) transform.mul(scenetransform.setToTranslation(-originX, -originY));
-    transform.trn(x, y);
+    transform.setToAffine(x, y, originX, originY, rotation, scaleX, scaleY);
 
     if (parent != null) {
         scenetransform.set(parent.scenetransform);
-        scenetransform.mul(transform);
+        scenetransform.mulAffine(transform);
     } else {
         scenetransform.set(transform);
     }
@@ -435,7 +429,7 @@ void Group::clear () {
 }
 
 void Group::sortChildren (const Comparator<Actor>& comparator) {
-    Collections.sort(this.children, comparator);
+    gdx_cpp::utils::Sort::instance().sort(children, comparator);
 }
 
 void Group::unfocusAll () {
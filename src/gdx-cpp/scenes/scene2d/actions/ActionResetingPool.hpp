@@ -18,23 +18,31 @@
     @author Ozires Bortolon de Faria ozires@aevumlab.com
 */
 
-#ifndef GDX_CPP_SCENES_SCENE2D_ACTIONS_ACTIONRESETINGPOOL<T EXTENDS ACTION>_HPP_
-#define GDX_CPP_SCENES_SCENE2D_ACTIONS_ACTIONRESETINGPOOL<T EXTENDS ACTION>_HPP_
+
+#ifndef GDX_CPP_SCENES_SCENE2D_ACTIONS_ACTIONRESETINGPOOL_HPP_
+#define GDX_CPP_SCENES_SCENE2D_ACTIONS_ACTIONRESETINGPOOL_HPP_
+
+#include <gdx-cpp/utils/Pool.hpp>
 
 namespace gdx_cpp {
 namespace scenes {
 namespace scene2d {
 namespace actions {
 
-class ActionResetingPool {
+/** A pool of actions that resets each action as it is freed, so obtain() always hands out a fresh one. T must be an
+ * Action. */
+template < class T >
+class ActionResetingPool : public gdx_cpp::utils::Pool<T> {
 public:
-    T& obtain ();
+    ActionResetingPool (int initialCapacity = 16, int _max = std::numeric_limits<int>::max())
+    : gdx_cpp::utils::Pool<T>(initialCapacity, _max)
+    {
+    }
 
 protected:
-
-
-private:
-
+    void reset (T& action) {
+        action.reset();
+    }
 };
 
 } // namespace gdx_cpp
@@ -42,4 +50,4 @@ private:
 } // namespace scene2d
 } // namespace actions
 
-#endif // GDX_CPP_SCENES_SCENE2D_ACTIONS_ACTIONRESETINGPOOL<T EXTENDS ACTION>_HPP_
+#endif // GDX_CPP_SCENES_SCENE2D_ACTIONS_ACTIONRESETINGPOOL_HPP_
@@ -18,26 +18,106 @@
     @author Ozires Bortolon de Faria ozires@aevumlab.com
 */
 
-#ifndef GDX_CPP_UTILS_ATOMICQUEUE<T>_HPP_
-#define GDX_CPP_UTILS_ATOMICQUEUE<T>_HPP_
+#ifndef GDX_CPP_UTILS_ATOMICQUEUE_HPP_
+#define GDX_CPP_UTILS_ATOMICQUEUE_HPP_
+
+#include "CacheLine.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <utility>
 
 namespace gdx_cpp {
 namespace utils {
 
+/** A bounded lock-free queue that allows one thread to call put and another thread to call poll.
+ *
+ * The values live in a ring whose capacity is rounded up to a power of two. Each side only writes its own counter, and
+ * the counters are a cache line apart; each side also keeps a copy of the other's counter and only rereads it when the
+ * ring looks full or empty, so in the common case put and poll touch no shared cache line besides the slot itself. Use
+ * MpmcQueue when more than one thread puts or polls. */
+template <typename T>
 class AtomicQueue {
 public:
-    bool put (const T& value);
-    T& poll ();
+    explicit AtomicQueue (int capacity)
+    : tail(0)
+    , cachedHead(0)
+    , head(0)
+    , cachedTail(0)
+    {
+        if (capacity < 1) throw std::runtime_error("capacity must be > 0");
+        size_t size = 1;
+        while (size < (size_t) capacity)
+            size <<= 1;
+        mask = size - 1;
+        values = static_cast<T*>(::operator new(sizeof(T) * size));
+    }
+
+    ~AtomicQueue () {
+        size_t end = tail.load(std::memory_order_relaxed);
+        for (size_t h = head.load(std::memory_order_relaxed); h != end; h++)
+            values[h & mask].~T();
+        ::operator delete(values);
+    }
+
+    /** Adds the value to the queue, returning false if the queue is full */
+    bool put (const T& value) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - cachedHead > mask) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (t - cachedHead > mask) return false;
+        }
+        new (&values[t & mask]) T(value);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
 
-protected:
+    /** Moves the oldest value into value, returning false if the queue is empty */
+    bool poll (T& value) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == cachedTail) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (h == cachedTail) return false;
+        }
+        T& slot = values[h & mask];
+        value = std::move(slot);
+        slot.~T();
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
 
+    /** The number of queued values. Only exact if neither side is running concurrently. */
+    int size () const {
+        return (int) (tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire));
+    }
+
+    int capacity () const {
+        return (int) mask + 1;
+    }
 
 private:
-    int next (int idx);
-    AtomicReferenceArray<T> queue;
+    AtomicQueue (const AtomicQueue&);
+    AtomicQueue& operator= (const AtomicQueue&);
+
+    // read-only after construction
+    T* values;
+    size_t mask;
+    char padding0[GDX_CPP_CACHE_LINE_SIZE];
+
+    // written by the producer
+    std::atomic<size_t> tail;
+    size_t cachedHead;
+    char padding1[GDX_CPP_CACHE_LINE_SIZE];
+
+    // written by the consumer
+    std::atomic<size_t> head;
+    size_t cachedTail;
+    char padding2[GDX_CPP_CACHE_LINE_SIZE];
 };
 
 } // namespace gdx_cpp
 } // namespace utils
 
-#endif // GDX_CPP_UTILS_ATOMICQUEUE<T>_HPP_
+#endif // GDX_CPP_UTILS_ATOMICQUEUE_HPP_
@@ -17,119 +17,313 @@
     @author Victor Vicente de Carvalho victor.carvalho@aevumlab.com
     @author Ozires Bortolon de Faria ozires@aevumlab.com
 */
-
-#include "Base64Coder.hpp"
-
-using namespace gdx_cpp::utils;
-
-std::string& Base64Coder::encodeString (const std::string& s) {
-    return new String(encode(s.getBytes()));
-}
-
-std::string& Base64Coder::encodeLines () {
-    return encodeLines(in, 0, in.length, 76, systemLineSeparator);
-}
-
-std::string& Base64Coder::encodeLines (int iOff,int iLen,int lineLen,const std::string& lineSeparator) {
-    int blockLen = (lineLen * 3) / 4;
-    if (blockLen <= 0) throw new IllegalArgumentException();
-    int lines = (iLen + blockLen - 1) / blockLen;
-    int bufLen = ((iLen + 2) / 3) * 4 + lines * lineSeparator.length();
-    StringBuilder buf = new StringBuilder(bufLen);
-    int ip = 0;
-    while (ip < iLen) {
-        int l = Math.min(iLen - ip, blockLen);
-        buf.append(encode(in, iOff + ip, l));
-        buf.append(lineSeparator);
-        ip += l;
-    }
-    return buf.toString();
-}
-
-char* Base64Coder::encode () {
-    return encode(in, 0, in.length);
-}
-
-char* Base64Coder::encode (int iLen) {
-    return encode(in, 0, iLen);
-}
-
-char* Base64Coder::encode (int iOff,int iLen) {
-    int oDataLen = (iLen * 4 + 2) / 3; // output length without padding
-    int oLen = ((iLen + 2) / 3) * 4; // output length including padding
-    char[] out = new char[oLen];
-    int ip = iOff;
-    int iEnd = iOff + iLen;
-    int op = 0;
-    while (ip < iEnd) {
-        int i0 = in[ip++] & 0xff;
-        int i1 = ip < iEnd ? in[ip++] & 0xff : 0;
-        int i2 = ip < iEnd ? in[ip++] & 0xff : 0;
-        int o0 = i0 >>> 2;
-        int o1 = ((i0 & 3) << 4) | (i1 >>> 4);
-        int o2 = ((i1 & 0xf) << 2) | (i2 >>> 6);
-        int o3 = i2 & 0x3F;
-        out[op++] = map1[o0];
-        out[op++] = map1[o1];
-        out[op] = op < oDataLen ? map1[o2] : '=';
-        op++;
-        out[op] = op < oDataLen ? map1[o3] : '=';
-        op++;
-    }
-    return out;
-}
-
-std::string& Base64Coder::decodeString (const std::string& s) {
-    return new String(decode(s));
-}
-
-char* Base64Coder::decodeLines (const std::string& s) {
-    char[] buf = new char[s.length()];
-    int p = 0;
-    for (int ip = 0; ip < s.length(); ip++) {
-        char c = s.charAt(ip);
-        if (c != ' ' && c != '\r' && c != '\n' && c != '\t') buf[p++] = c;
-    }
-    return decode(buf, 0, p);
-}
-
-char* Base64Coder::decode (const std::string& s) {
-    return decode(s.toCharArray());
-}
-
-char* Base64Coder::decode () {
-    return decode(in, 0, in.length);
-}
-
-char* Base64Coder::decode (int iOff,int iLen) {
-    if (iLen % 4 != 0) throw new IllegalArgumentException("Length of Base64 encoded input string is not a multiple of 4.");
-    while (iLen > 0 && in[iOff + iLen - 1] == '=')
-        iLen--;
-    int oLen = (iLen * 3) / 4;
-    byte[] out = new byte[oLen];
-    int ip = iOff;
-    int iEnd = iOff + iLen;
-    int op = 0;
-    while (ip < iEnd) {
-        int i0 = in[ip++];
-        int i1 = in[ip++];
-        int i2 = ip < iEnd ? in[ip++] : 'A';
-        int i3 = ip < iEnd ? in[ip++] : 'A';
-        if (i0 > 127 || i1 > 127 || i2 > 127 || i3 > 127)
-            throw new IllegalArgumentException("Illegal character in Base64 encoded data.");
-        int b0 = map2[i0];
-        int b1 = map2[i1];
-        int b2 = map2[i2];
-        int b3 = map2[i3];
-        if (b0 < 0 || b1 < 0 || b2 < 0 || b3 < 0)
-            throw new IllegalArgumentException("Illegal character in Base64 encoded data.");
-        int o0 = (b0 << 2) | (b1 >>> 4);
-        int o1 = ((b1 & 0xf) << 4) | (b2 >>> 2);
-        int o2 = ((b2 & 3) << 6) | b3;
-        out[op++] = (byte)o0;
-        if (op < oLen) out[op++] = (byte)o1;
-        if (op < oLen) out[op++] = (byte)o2;
-    }
-    return out;
-}
-
+
+#include "Base64Coder.hpp"
+#include "Simd.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace gdx_cpp::utils;
+
+namespace {
+
+const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+enum {
+    WHITESPACE = 64,
+    PADDING = 65,
+    INVALID = 255
+};
+
+/** The sextet of each character, or one of the values above */
+const struct DecodeTable {
+    DecodeTable () {
+        for (int i = 0; i < 256; i++)
+            values[i] = INVALID;
+        for (int i = 0; i < 64; i++)
+            values[(unsigned char) alphabet[i]] = (unsigned char) i;
+        values[(unsigned char) ' '] = values[(unsigned char) '\t'] = WHITESPACE;
+        values[(unsigned char) '\n'] = values[(unsigned char) '\r'] = WHITESPACE;
+        values[(unsigned char) '='] = PADDING;
+    }
+
+    unsigned char values[256];
+} decodeTable;
+
+#if defined(GDX_CPP_SIMD_SSE)
+
+/** 16 characters of 12 bytes, reads 14 */
+inline void encodeBlock (const unsigned char* in, char* out) {
+    __m128i x = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*) in), _mm_loadl_epi64((const __m128i*) (in + 6)));
+    // three bytes per 32 bit lane, b0 | b1 << 8 | b2 << 16
+    x = _mm_or_si128(_mm_and_si128(x, _mm_set1_epi64x(0xffffff)),
+                     _mm_slli_epi64(_mm_and_si128(x, _mm_set1_epi64x(0xffffff000000LL)), 8));
+
+    // the four sextets, one per byte
+    __m128i s = _mm_and_si128(_mm_srli_epi32(x, 2), _mm_set1_epi32(0x3f));
+    s = _mm_or_si128(s, _mm_and_si128(_mm_slli_epi32(x, 12), _mm_set1_epi32(0x3000)));
+    s = _mm_or_si128(s, _mm_and_si128(_mm_srli_epi32(x, 4), _mm_set1_epi32(0x0f00)));
+    s = _mm_or_si128(s, _mm_and_si128(_mm_slli_epi32(x, 10), _mm_set1_epi32(0x3c0000)));
+    s = _mm_or_si128(s, _mm_and_si128(_mm_srli_epi32(x, 6), _mm_set1_epi32(0x030000)));
+    s = _mm_or_si128(s, _mm_and_si128(_mm_slli_epi32(x, 8), _mm_set1_epi32(0x3f000000)));
+
+    // 'A' + s, 'a' - 26 + s, '0' - 52 + s, then '+' and '/'
+    __m128i offset = _mm_set1_epi8('A');
+    offset = _mm_add_epi8(offset, _mm_and_si128(_mm_cmpgt_epi8(s, _mm_set1_epi8(25)), _mm_set1_epi8(6)));
+    offset = _mm_add_epi8(offset, _mm_and_si128(_mm_cmpgt_epi8(s, _mm_set1_epi8(51)), _mm_set1_epi8(-75)));
+    offset = _mm_add_epi8(offset, _mm_and_si128(_mm_cmpeq_epi8(s, _mm_set1_epi8(62)), _mm_set1_epi8(-15)));
+    offset = _mm_add_epi8(offset, _mm_and_si128(_mm_cmpeq_epi8(s, _mm_set1_epi8(63)), _mm_set1_epi8(-12)));
+    _mm_storeu_si128((__m128i*) out, _mm_add_epi8(s, offset));
+}
+
+inline __m128i inRange (__m128i c, char first, char last) {
+    return _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8(first - 1)), _mm_cmplt_epi8(c, _mm_set1_epi8(last + 1)));
+}
+
+/** 16 characters to 12 bytes, writes 14. False, having written nothing, if any of them is not in the alphabet. */
+inline bool decodeBlock (const unsigned char* in, unsigned char* out) {
+    __m128i c = _mm_loadu_si128((const __m128i*) in);
+    // bytes above 127 compare as negative and are in no range
+    __m128i upper = inRange(c, 'A', 'Z');
+    __m128i lower = inRange(c, 'a', 'z');
+    __m128i digit = inRange(c, '0', '9');
+    __m128i plus = _mm_cmpeq_epi8(c, _mm_set1_epi8('+'));
+    __m128i slash = _mm_cmpeq_epi8(c, _mm_set1_epi8('/'));
+    __m128i valid = _mm_or_si128(_mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, plus)), slash);
+    if (_mm_movemask_epi8(valid) != 0xffff) return false;
+
+    __m128i offset = _mm_and_si128(upper, _mm_set1_epi8(-'A'));
+    offset = _mm_or_si128(offset, _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+    offset = _mm_or_si128(offset, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+    offset = _mm_or_si128(offset, _mm_and_si128(plus, _mm_set1_epi8(62 - '+')));
+    offset = _mm_or_si128(offset, _mm_and_si128(slash, _mm_set1_epi8(63 - '/')));
+    __m128i s = _mm_add_epi8(c, offset);
+
+    // pairs of sextets to 12 bits, then pairs of those to 24 bits per 32 bit lane
+    __m128i pairs = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(s, _mm_set1_epi16(0xff)), 6), _mm_srli_epi16(s, 8));
+    __m128i groups = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+
+    // big endian within the lane, then the four 3 byte groups packed through two 6 byte halves
+    __m128i bytes = _mm_or_si128(_mm_srli_epi32(groups, 16), _mm_and_si128(groups, _mm_set1_epi32(0xff00)));
+    bytes = _mm_or_si128(bytes, _mm_slli_epi32(_mm_and_si128(groups, _mm_set1_epi32(0xff)), 16));
+    bytes = _mm_or_si128(_mm_and_si128(bytes, _mm_set1_epi64x(0xffffff)),
+                         _mm_srli_epi64(_mm_and_si128(bytes, _mm_set1_epi64x(0xffffff00000000LL)), 8));
+    _mm_storel_epi64((__m128i*) out, bytes);
+    _mm_storel_epi64((__m128i*) (out + 6), _mm_unpackhi_epi64(bytes, bytes));
+    return true;
+}
+
+const size_t ENCODE_BLOCK_IN = 12, ENCODE_BLOCK_READ = 14, ENCODE_BLOCK_OUT = 16;
+const size_t DECODE_BLOCK_IN = 16, DECODE_BLOCK_OUT = 12, DECODE_BLOCK_WRITE = 14;
+
+#elif defined(GDX_CPP_SIMD_NEON)
+
+inline uint8x16_t toAscii (uint8x16_t s) {
+    uint8x16_t offset = vdupq_n_u8('A');
+    offset = vaddq_u8(offset, vandq_u8(vcgtq_u8(s, vdupq_n_u8(25)), vdupq_n_u8(6)));
+    offset = vaddq_u8(offset, vandq_u8(vcgtq_u8(s, vdupq_n_u8(51)), vdupq_n_u8((unsigned char) -75)));
+    offset = vaddq_u8(offset, vandq_u8(vceqq_u8(s, vdupq_n_u8(62)), vdupq_n_u8((unsigned char) -15)));
+    offset = vaddq_u8(offset, vandq_u8(vceqq_u8(s, vdupq_n_u8(63)), vdupq_n_u8((unsigned char) -12)));
+    return vaddq_u8(s, offset);
+}
+
+/** 64 characters of 48 bytes */
+inline void encodeBlock (const unsigned char* in, char* out) {
+    uint8x16x3_t x = vld3q_u8(in);
+    uint8x16_t mask = vdupq_n_u8(0x3f);
+    uint8x16x4_t s;
+    s.val[0] = toAscii(vshrq_n_u8(x.val[0], 2));
+    s.val[1] = toAscii(vandq_u8(vorrq_u8(vshlq_n_u8(x.val[0], 4), vshrq_n_u8(x.val[1], 4)), mask));
+    s.val[2] = toAscii(vandq_u8(vorrq_u8(vshlq_n_u8(x.val[1], 2), vshrq_n_u8(x.val[2], 6)), mask));
+    s.val[3] = toAscii(vandq_u8(x.val[2], mask));
+    vst4q_u8((unsigned char*) out, s);
+}
+
+inline uint8x16_t inRange (uint8x16_t c, unsigned char first, unsigned char last) {
+    return vandq_u8(vcgeq_u8(c, vdupq_n_u8(first)), vcleq_u8(c, vdupq_n_u8(last)));
+}
+
+/** Sextets of the characters, valid cleared in the lanes of anything outside the alphabet */
+inline uint8x16_t toSextets (uint8x16_t c, uint8x16_t& valid) {
+    uint8x16_t upper = inRange(c, 'A', 'Z');
+    uint8x16_t lower = inRange(c, 'a', 'z');
+    uint8x16_t digit = inRange(c, '0', '9');
+    uint8x16_t plus = vceqq_u8(c, vdupq_n_u8('+'));
+    uint8x16_t slash = vceqq_u8(c, vdupq_n_u8('/'));
+    valid = vandq_u8(valid, vorrq_u8(vorrq_u8(vorrq_u8(upper, lower), vorrq_u8(digit, plus)), slash));
+
+    uint8x16_t offset = vandq_u8(upper, vdupq_n_u8((unsigned char) -'A'));
+    offset = vorrq_u8(offset, vandq_u8(lower, vdupq_n_u8((unsigned char) (26 - 'a'))));
+    offset = vorrq_u8(offset, vandq_u8(digit, vdupq_n_u8((unsigned char) (52 - '0'))));
+    offset = vorrq_u8(offset, vandq_u8(plus, vdupq_n_u8((unsigned char) (62 - '+'))));
+    offset = vorrq_u8(offset, vandq_u8(slash, vdupq_n_u8((unsigned char) (63 - '/'))));
+    return vaddq_u8(c, offset);
+}
+
+/** 64 characters to 48 bytes. False, having written nothing, if any of them is not in the alphabet. */
+inline bool decodeBlock (const unsigned char* in, unsigned char* out) {
+    uint8x16x4_t c = vld4q_u8(in);
+    uint8x16_t valid = vdupq_n_u8(0xff);
+    uint8x16_t a = toSextets(c.val[0], valid);
+    uint8x16_t b = toSextets(c.val[1], valid);
+    uint8x16_t d = toSextets(c.val[2], valid);
+    uint8x16_t e = toSextets(c.val[3], valid);
+    uint8x8_t folded = vand_u8(vget_low_u8(valid), vget_high_u8(valid));
+    if (vget_lane_u64(vreinterpret_u64_u8(folded), 0) != ~(uint64_t) 0) return false;
+
+    uint8x16x3_t bytes;
+    bytes.val[0] = vorrq_u8(vshlq_n_u8(a, 2), vshrq_n_u8(b, 4));
+    bytes.val[1] = vorrq_u8(vshlq_n_u8(b, 4), vshrq_n_u8(d, 2));
+    bytes.val[2] = vorrq_u8(vshlq_n_u8(d, 6), e);
+    vst3q_u8(out, bytes);
+    return true;
+}
+
+const size_t ENCODE_BLOCK_IN = 48, ENCODE_BLOCK_READ = 48, ENCODE_BLOCK_OUT = 64;
+const size_t DECODE_BLOCK_IN = 64, DECODE_BLOCK_OUT = 48, DECODE_BLOCK_WRITE = 48;
+
+#endif
+
+/** Decodes whole groups of four alphabet characters, stopping at the first group with anything else in it or when out
+ * is full. Returns the number of groups. */
+size_t decodeGroups (const unsigned char* in, size_t length, unsigned char* out, size_t capacity) {
+    const unsigned char* c = in;
+    const unsigned char* end = in + length;
+    unsigned char* o = out;
+#if defined(GDX_CPP_SIMD_SSE) || defined(GDX_CPP_SIMD_NEON)
+    while ((size_t) (end - c) >= DECODE_BLOCK_IN && capacity - (o - out) >= DECODE_BLOCK_WRITE) {
+        if (!decodeBlock(c, o)) break;
+        c += DECODE_BLOCK_IN;
+        o += DECODE_BLOCK_OUT;
+    }
+#endif
+    const unsigned char* values = decodeTable.values;
+    while (end - c >= 4 && capacity - (o - out) >= 3) {
+        unsigned int a = values[c[0]], b = values[c[1]], d = values[c[2]], e = values[c[3]];
+        if ((a | b | d | e) >= 64) break;
+        unsigned int group = a << 18 | b << 12 | d << 6 | e;
+        o[0] = (unsigned char) (group >> 16);
+        o[1] = (unsigned char) (group >> 8);
+        o[2] = (unsigned char) group;
+        c += 4;
+        o += 3;
+    }
+    return (c - in) / 4;
+}
+
+}
+
+size_t Base64Coder::encode (const unsigned char* data, size_t length, char* out) {
+    const unsigned char* in = data;
+    const unsigned char* end = data + length;
+    char* o = out;
+#if defined(GDX_CPP_SIMD_SSE) || defined(GDX_CPP_SIMD_NEON)
+    for (; (size_t) (end - in) >= ENCODE_BLOCK_READ; in += ENCODE_BLOCK_IN, o += ENCODE_BLOCK_OUT)
+        encodeBlock(in, o);
+#endif
+    for (; end - in >= 3; in += 3, o += 4) {
+        unsigned int group = in[0] << 16 | in[1] << 8 | in[2];
+        o[0] = alphabet[group >> 18];
+        o[1] = alphabet[(group >> 12) & 0x3f];
+        o[2] = alphabet[(group >> 6) & 0x3f];
+        o[3] = alphabet[group & 0x3f];
+    }
+    if (in != end) {
+        unsigned int group = in[0] << 16 | (end - in > 1 ? in[1] << 8 : 0);
+        o[0] = alphabet[group >> 18];
+        o[1] = alphabet[(group >> 12) & 0x3f];
+        o[2] = end - in > 1 ? alphabet[(group >> 6) & 0x3f] : '=';
+        o[3] = '=';
+        o += 4;
+    }
+    return o - out;
+}
+
+std::string Base64Coder::encodeString (const std::string& s) {
+    std::string result(encodedLength(s.size()), '\0');
+    if (!s.empty()) encode((const unsigned char*) s.data(), s.size(), &result[0]);
+    return result;
+}
+
+std::string Base64Coder::encodeLines (const unsigned char* data, size_t length, int lineLength,
+                                      const std::string& lineSeparator) {
+    size_t blockLength = lineLength / 4 * 3;
+    if (blockLength == 0) throw std::runtime_error("Line length must be at least 4.");
+    size_t lines = (length + blockLength - 1) / blockLength;
+    std::string result(encodedLength(length) + lines * lineSeparator.size(), '\0');
+    char* out = lines ? &result[0] : NULL;
+    for (size_t done = 0; done < length; done += blockLength) {
+        size_t block = length - done < blockLength ? length - done : blockLength;
+        out += encode(data + done, block, out);
+        out = std::copy(lineSeparator.begin(), lineSeparator.end(), out);
+    }
+    return result;
+}
+
+size_t Base64Coder::decode (const char* in, size_t length, unsigned char* out, size_t capacity) {
+    Base64Decoder decoder;
+    size_t written = decoder.decode(in, length, out, capacity);
+    decoder.finish();
+    return written;
+}
+
+std::string Base64Coder::decodeString (const std::string& s) {
+    std::string result(decodedMaxLength(s.size()), '\0');
+    result.resize(decode(s.data(), s.size(), (unsigned char*) &result[0], result.size()));
+    return result;
+}
+
+Base64Decoder::Base64Decoder () {
+    reset();
+}
+
+void Base64Decoder::reset () {
+    bits = 0;
+    bitCount = 0;
+    padding = -1;
+}
+
+size_t Base64Decoder::decode (const char* in, size_t length, unsigned char* out, size_t capacity) {
+    const unsigned char* c = (const unsigned char*) in;
+    const unsigned char* end = c + length;
+    unsigned char* o = out;
+    unsigned char* limit = out + capacity;
+
+    while (c != end) {
+        if (bitCount == 0 && padding == -1) {
+            size_t groups = decodeGroups(c, end - c, o, limit - o);
+            c += groups * 4;
+            o += groups * 3;
+            if (c == end) break;
+        }
+
+        // one character at a time up to the next whole group, or past whatever stopped decodeGroups
+        unsigned char value = decodeTable.values[*c++];
+        if (value < 64) {
+            if (padding != -1) throw std::runtime_error("Invalid base64 data: characters after the padding");
+            bits = bits << 6 | value;
+            bitCount += 6;
+            if (bitCount >= 8) {
+                if (o == limit) throw std::runtime_error("Base64 data decodes to more bytes than the buffer holds");
+                bitCount -= 8;
+                *o++ = (unsigned char) (bits >> bitCount);
+                bits &= (1u << bitCount) - 1;
+            }
+        } else if (value == PADDING) {
+            // two sextets of a group take two '=', three take one
+            if (padding == -1) padding = bitCount == 4 ? 2 : bitCount == 2 ? 1 : 0;
+            if (padding == 0) throw std::runtime_error("Invalid base64 data: misplaced padding");
+            padding--;
+        } else if (value != WHITESPACE) {
+            throw std::runtime_error("Invalid base64 character: '" + std::string(1, (char) c[-1]) + "'");
+        }
+    }
+    return o - out;
+}
+
+void Base64Decoder::finish () {
+    bool truncated = bitCount == 6;
+    reset();
+    if (truncated) throw std::runtime_error("Invalid base64 data: truncated group");
+}
@@ -21,28 +21,58 @@
 #ifndef GDX_CPP_UTILS_BASE64CODER_HPP_
 #define GDX_CPP_UTILS_BASE64CODER_HPP_
 
+#include <cstddef>
+#include <string>
+
 namespace gdx_cpp {
 namespace utils {
 
+/** Base64 with the standard alphabet and padding, vectorized with SSE2 or NEON. Everything works on caller buffers,
+ * the std::string overloads are for convenience. Decoding skips whitespace, accepts missing padding and throws
+ * std::runtime_error for anything else that is not base64. */
 class Base64Coder {
 public:
-    static std::string& encodeString (const std::string& s);
-    static std::string& encodeLines ();
-    static std::string& encodeLines (int iOff,int iLen,int lineLen,const std::string& lineSeparator);
-    static char* encode ();
-    static char* encode (int iLen);
-    static char* encode (int iOff,int iLen);
-    static std::string& decodeString (const std::string& s);
-    static char* decodeLines (const std::string& s);
-    static char* decode (const std::string& s);
-    static char* decode ();
-    static char* decode (int iOff,int iLen);
+    static size_t encodedLength (size_t length) {
+        return (length + 2) / 3 * 4;
+    }
 
-protected:
+    /** The most bytes length characters can decode to, also in the middle of a Base64Decoder stream */
+    static size_t decodedMaxLength (size_t length) {
+        return length / 4 * 3 + 3;
+    }
 
+    /** Encodes length bytes into out, which must have room for encodedLength(length) characters. Returns the number of
+     * characters written. */
+    static size_t encode (const unsigned char* data, size_t length, char* out);
+    static std::string encodeString (const std::string& s);
+    /** Breaks the output into lines of at most lineLength characters, each followed by the separator */
+    static std::string encodeLines (const unsigned char* data, size_t length, int lineLength = 76,
+                                    const std::string& lineSeparator = "\n");
 
-private:
+    /** Decodes length characters into out, throwing if they decode to more than capacity bytes. Returns the number of
+     * bytes written. */
+    static size_t decode (const char* in, size_t length, unsigned char* out, size_t capacity);
+    static std::string decodeString (const std::string& s);
+};
 
+/** Decodes base64 that arrives in pieces, such as the text events of an XML reader, straight into the caller's
+ * buffer. Pieces may split groups of four anywhere. */
+class Base64Decoder {
+public:
+    Base64Decoder ();
+
+    /** Decodes the next length characters into out, see Base64Coder::decode */
+    size_t decode (const char* in, size_t length, unsigned char* out, size_t capacity);
+    /** Checks that the data did not end in the middle of a byte, and resets the decoder */
+    void finish ();
+    void reset ();
+
+private:
+    /** The bits of the current group not yet written, bitCount of them */
+    unsigned int bits;
+    int bitCount;
+    /** The '=' still allowed, -1 until the first one */
+    int padding;
 };
 
 } // namespace gdx_cpp
@@ -0,0 +1,69 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+#include "Buffer.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+using namespace gdx_cpp::utils;
+
+namespace {
+
+struct AlignedDeleter {
+    void operator() (char* memory) const {
+#ifdef _WIN32
+        _aligned_free(memory);
+#else
+        std::free(memory);
+#endif
+    }
+};
+
+struct NoDeleter {
+    void operator() (char*) const {
+    }
+};
+
+}
+
+buffer_base::char_ptr buffer_base::allocate (size_t size) {
+    if (size == 0) return char_ptr();
+
+#ifdef _WIN32
+    void* memory = _aligned_malloc(size, alignment);
+    if (memory == NULL) throw std::bad_alloc();
+#else
+    void* memory = NULL;
+    if (posix_memalign(&memory, alignment, size) != 0) throw std::bad_alloc();
+#endif
+    return char_ptr((char*) memory, AlignedDeleter());
+}
+
+buffer_base::char_ptr buffer_base::external (void* memory) {
+    return char_ptr((char*) memory, NoDeleter());
+}
+
+void buffer_base::throwOutOfBounds (const char* what, int index, int bound) {
+    char message[96];
+    snprintf(message, sizeof(message), "%s: %d (bound %d)", what, index, bound);
+    throw std::runtime_error(message);
+}
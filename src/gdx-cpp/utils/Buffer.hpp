@@ -14,26 +14,35 @@
     limitations under the License.
 */
 
-
 #ifndef GDX_CPP_UTILS_BUFFER_HPP
 #define GDX_CPP_UTILS_BUFFER_HPP
 
 #include "Aliases.hpp"
+#include "CacheLine.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
 #include <stdexcept>
 #include <vector>
-#include <sstream>
-#include <string.h>
-#include <cassert>
 
 namespace gdx_cpp {
 
 namespace utils {
 
+/** The untyped part of a buffer: a view of `_capacity` elements starting at `data`, and the storage it points into.
+ * `bf` owns the storage and is shared by every buffer viewing it, so views, slices and conversions never copy. For
+ * memory wrapped with wrap() it owns nothing and the caller has to keep the memory alive. */
 struct buffer_base {
 public:
     typedef ref_ptr_maker<char>::type char_ptr;
-    buffer_base(char_ptr bf, int capacity, int position, int mark, int limit)
+
+    /** Storage allocated by buffers starts on a cache line, which also satisfies aligned SSE and NEON loads */
+    static const size_t alignment = GDX_CPP_CACHE_LINE_SIZE;
+
+    buffer_base(char_ptr bf, char* data, int capacity, int position, int mark, int limit)
             : bf(bf)
+            , data(data)
             , _capacity(capacity)
             , _position(position)
             , _mark(mark)
@@ -41,178 +50,222 @@ public:
     {
     }
 
-    buffer_base(const buffer_base& other)
-            : bf(other.bf), _capacity(other._capacity), _position(other._position),
-            _mark(other._mark), _limit(other._limit)
-    {
-    }
-
-    buffer_base() : _capacity(0)
+    buffer_base() : data(NULL)
+            , _capacity(0)
             , _position(0)
             , _mark(-1)
             , _limit(0) {
     }
 
+    /** Allocates size bytes aligned to alignment. The memory is not zeroed. */
+    static char_ptr allocate(size_t size);
+    /** Shares memory owned by the caller, nothing is freed when the last buffer goes away */
+    static char_ptr external(void* memory);
+
+    static void throwOutOfBounds(const char* what, int index, int bound);
+
     char_ptr bf;
+    char* data;
     int _capacity;
     int _position;
     int _mark;
     int _limit;
 };
 
+/** A java.nio style buffer of T: elements are read and written at the position, up to the limit, which is at most the
+ * capacity. Positions, limits and capacities are counted in elements of T.
+ *
+ * Copying a buffer, slice(), duplicate() and convert() all create views sharing the same storage, each with its own
+ * position and limit. The checked accessors throw std::runtime_error; the *Unchecked bulk operations only assert, for
+ * loops whose bounds are already known to fit. */
 template <typename T>
 struct buffer : public buffer_base {
-    buffer(int mark, int pos, int lim , int capacity)
-            : buffer_base(buffer_base::char_ptr(new char[capacity]), capacity, pos, mark, lim)
+    /** Allocates storage for capacity elements */
+    buffer(int mark, int pos, int lim, int capacity)
+            : buffer_base(buffer_base::allocate(capacity * sizeof(T)), NULL, capacity, pos, mark, lim)
     {
-#ifdef DEBUG
-        T* debug_buffer = (T*) bf.get();
-#endif
-        limit(lim);
-        position(pos);
-        if (mark >= 0) {
-            if (mark > pos) {
-                std::stringstream ss;
-                ss << " mark > position: (" << mark << " > " << pos + ")";
-                throw std::runtime_error(ss.str());
-            }
-        }
+        data = bf.get();
+        check(mark, pos, lim);
     }
 
-    buffer(buffer_base::char_ptr bf, int mark, int pos, int lim, int capacity)
-            : buffer_base(bf , capacity, pos, mark, lim)
+    /** A view of capacity elements at data, kept alive by bf */
+    buffer(buffer_base::char_ptr bf, T* data, int mark, int pos, int lim, int capacity)
+            : buffer_base(bf, (char*) data, capacity, pos, mark, lim)
     {
-#ifdef DEBUG
-        T* debug_buffer = (T*) bf.get();
-#endif
-
-        limit(lim);
-        position(pos);
-        if (mark >= 0) {
-            if (mark > pos) {
-                std::stringstream ss;
-                ss << " mark > position: (" << mark << " > " << pos + ")";
-                throw std::runtime_error(ss.str());
-            }
-        }
+        check(mark, pos, lim);
     }
 
     buffer() : buffer_base() {
     }
 
-    int capacity() {
+    buffer(const buffer_base& other)
+            : buffer_base(other)
+    {
+    }
+
+    /** Views capacity elements owned by the caller, with the position at 0 and the limit at the capacity. The memory
+     * has to outlive every buffer viewing it. */
+    static buffer<T> wrap(T* memory, int capacity) {
+        return buffer<T>(buffer_base::external(memory), memory, -1, 0, capacity, capacity);
+    }
+
+    int capacity() const {
         return _capacity;
     }
 
-    int position() {
+    int position() const {
         return _position;
     }
 
+    int limit() const {
+        return _limit;
+    }
+
+    T* pointer() {
+        return (T*) data;
+    }
+
+    const T* pointer() const {
+        return (const T*) data;
+    }
+
+    /** The elements between the position and the limit as a new buffer starting at 0, sharing this one's storage */
+    buffer<T> slice() const {
+        return buffer<T>(bf, (T*) data + _position, -1, 0, remaining(), remaining());
+    }
+
+    /** length elements from offset, ignoring the position and limit, as a new buffer sharing this one's storage */
+    buffer<T> slice(int offset, int length) const {
+        checkBounds(offset, length, _capacity);
+        return buffer<T>(bf, (T*) data + offset, -1, 0, length, length);
+    }
+
+    /** Another view of the same elements with its own position, limit and mark */
+    buffer<T> duplicate() const {
+        return *this;
+    }
+
+    /** Views the bytes between the position and the limit as elements of Other, sharing this buffer's storage. The
+     * new buffer's limit is its capacity, any bytes that don't fill a whole element are left out. */
     template <typename Other>
-    buffer<Other> convert() {
-        int new_cap = this->remaining() >> (sizeof(Other) > 4 ? 3 : sizeof(Other) <= 2 ? 1 : 2);
-        return buffer<Other>(this->bf, -1, 0, new_cap, new_cap);
+    buffer<Other> convert() const {
+        int new_cap = (int) ((size_t) remaining() * sizeof(T) / sizeof(Other));
+        return buffer<Other>(bf, (Other*) (data + _position * sizeof(T)), -1, 0, new_cap, new_cap);
     }
 
     void put(const T& value) {
-        ((T*)bf.get())[nextPutIndex()] = value;
+        ((T*) data)[nextPutIndex()] = value;
     }
 
     T& get() {
-        return ((T*)bf.get())[nextGetIndex()];
+        return ((T*) data)[nextGetIndex()];
     }
 
     T& get(const int position) {
-        return ((T*)bf.get())[checkIndex(position)];
+        return ((T*) data)[checkIndex(position)];
+    }
+
+    const T& get(const int position) const {
+        return ((const T*) data)[checkIndex(position)];
     }
 
     buffer<T>& get(T* dst, int dstSize, int offset, int length) {
         checkBounds(offset, length, dstSize);
         if (length > remaining())
-            throw std::runtime_error("buffer underflow");
-        int end = offset + length;
-        for (int i = offset; i < end; i++)
-            dst[i] = get();
-        return *this;
+            throwOutOfBounds("buffer underflow", _position + length, _limit);
+        return getUnchecked(dst + offset, length);
     }
 
     buffer<T>& get(std::vector<T>& dst, int offset, int length) {
-        return get(&dst[0], dst.size(), offset, length);
+        return get(dst.empty() ? NULL : &dst[0], dst.size(), offset, length);
+    }
+
+    /** Reads length elements into dst without checking the limit in release builds */
+    buffer<T>& getUnchecked(T* dst, int length) {
+        assert(length >= 0 && length <= remaining());
+        memcpy(dst, (T*) data + _position, sizeof(T) * length);
+        _position += length;
+        return *this;
     }
 
     T& operator[](int position) {
-        return ((T*)bf.get())[checkIndex(position)];
+        return ((T*) data)[checkIndex(position)];
+    }
+
+    const T& operator[](int position) const {
+        return ((const T*) data)[checkIndex(position)];
     }
 
     buffer<T>& position(int newPosition) {
         if ((newPosition > _limit) || (newPosition < 0))
-            throw std::runtime_error("");
+            throwOutOfBounds("invalid position", newPosition, _limit);
         _position = newPosition;
         if (_mark > _position) clearMark();
         return *this;
     }
 
-    int limit() {
-        return _limit;
-    }
-
     buffer<T>& limit(int newLimit)
     {
         if ((newLimit > _capacity) || (newLimit < 0))
-            throw std::runtime_error("");
+            throwOutOfBounds("invalid limit", newLimit, _capacity);
         _limit = newLimit;
         if (_position > _limit) _position = _limit;
         if (_mark > _position) clearMark();
         return *this;
     }
 
+    /** Copies count elements of U from array + offset to the start of the buffer, like libgdx' BufferUtils.copy: the
+     * position ends up at 0 and the limit at the end of the copied data */
     template <typename U>
     void copy(const U* array, int count, int offset) {
-        T* casted_array = (T*) bf.get();
-        memcpy(casted_array, &array[offset], sizeof(U) * count);
-        limit((count * sizeof(U)) / sizeof(T));
+        if (count < 0 || count * sizeof(U) > _capacity * sizeof(T))
+            throwOutOfBounds("buffer overflow", (int) (count * sizeof(U) / sizeof(T)), _capacity);
+        copyUnchecked(array, count, offset);
     }
 
     template <typename U>
     void copy(const std::vector<U>& array, int count, int offset) {
-        T* casted_array = (T*) bf.get();
-        memcpy(casted_array, &array[offset], sizeof(U) * count);
-        limit((count * sizeof(U)) / sizeof(T));
+        checkBounds(offset, count, array.size());
+        copy(array.empty() ? NULL : &array[0], count, offset);
     }
 
-    buffer<T>& compact() {
-        int pos = position();
-        int lim = limit();
-        assert (pos <= lim);
-        int rem = (pos <= lim ? lim - pos : 0);
+    /** copy() without checking the capacity in release builds */
+    template <typename U>
+    void copyUnchecked(const U* array, int count, int offset) {
+        assert(count >= 0 && count * sizeof(U) <= _capacity * sizeof(T));
+        memcpy(data, array + offset, sizeof(U) * count);
+        _position = 0;
+        _limit = (count * sizeof(U)) / sizeof(T);
+        clearMark();
+    }
 
-        //rem << 2? wtf?
-        memcpy(bf.get(), bf.get() + position(), rem << 2);
+    buffer<T>& compact() {
+        int rem = remaining();
+        memmove(data, (T*) data + _position, sizeof(T) * rem);
 
-        position(rem);
-        limit(capacity());
+        _position = rem;
+        _limit = _capacity;
         discardMark();
-        
+
         return *this;
     }
 
     buffer<T>& reset() {
         int m = _mark;
         if (m < 0)
-            throw std::runtime_error("buffer underflow");
+            throwOutOfBounds("invalid mark", m, _position);
         _position = m;
         return *this;
     }
 
-
-    //SHIVER ME TIMBERS!!! YARRRR
+    /** The start of the buffer's storage for passing to GL, regardless of the position */
     template <typename U>
     operator U*() {
-        return (U*) bf.get();
+        return (U*) data;
     }
 
     buffer<T>& mark() {
-        mark = _position;
+        _mark = _position;
         return *this;
     }
 
@@ -236,25 +289,19 @@ struct buffer : public buffer_base {
         return *this;
     }
 
-    int remaining() {
+    int remaining() const {
         return _limit - _position;
     }
 
-    bool hasRemaining() {
+    bool hasRemaining() const {
         return _position < _limit;
     }
 
     buffer<T>& put(const T* src, int size, int offset, int length) {
         checkBounds(offset, length, size);
         if (length > remaining())
-            throw std::runtime_error("buffer overflow");
-
-        T* casted_array = (T*) bf.get();
-        memcpy(&casted_array[_position], &src[offset], sizeof(T) * length);
-        
-        _position += length;
-        
-        return *this;
+            throwOutOfBounds("buffer overflow", _position + length, _limit);
+        return putUnchecked(src + offset, length);
     }
 
     buffer<T>& put(const T* src, int size) {
@@ -266,32 +313,26 @@ struct buffer : public buffer_base {
     }
 
     buffer<T>& put(const std::vector<T>& src, int offset, int length) {
-        checkBounds(offset, length, src.size());
-        if (length > remaining())
-            throw std::runtime_error("buffer overflow");
+        return put(src.empty() ? NULL : &src[0], src.size(), offset, length);
+    }
 
-        T* casted_array = (T*) bf.get();
-        memcpy(&casted_array[_position], &src[offset], sizeof(T) * length);
-        
+    /** Writes length elements from src without checking the limit in release builds */
+    buffer<T>& putUnchecked(const T* src, int length) {
+        assert(length >= 0 && length <= remaining());
+        memcpy((T*) data + _position, src, sizeof(T) * length);
         _position += length;
-        
         return *this;
     }
 
-    buffer(const buffer_base& other)
-            : buffer_base(other)
-    {
-    }
-
     int nextGetIndex() {
         if (_position >= _limit)
-            throw std::runtime_error("buffer underflow");
+            throwOutOfBounds("buffer underflow", _position, _limit);
         return _position++;
     }
 
     int nextGetIndex(int nb) {
         if (_limit - _position < nb)
-            throw std::runtime_error("buffer underflow");
+            throwOutOfBounds("buffer underflow", _position + nb, _limit);
         int p = _position;
         _position += nb;
         return p;
@@ -299,27 +340,27 @@ struct buffer : public buffer_base {
 
     int nextPutIndex() {
         if (_position >= _limit)
-            throw std::runtime_error("buffer overflow");
+            throwOutOfBounds("buffer overflow", _position, _limit);
         return _position++;
     }
 
     int nextPutIndex(int nb) {
         if (_limit - _position < nb)
-            throw std::runtime_error("buffer overflow");
+            throwOutOfBounds("buffer overflow", _position + nb, _limit);
         int p = _position;
         _position += nb;
         return p;
     }
 
-    int checkIndex(int i) {
+    int checkIndex(int i) const {
         if ((i < 0) || (i >= _limit))
-            throw std::runtime_error("invalid index");
+            throwOutOfBounds("invalid index", i, _limit);
         return i;
     }
 
-    int checkIndex(int i, int nb) {
+    int checkIndex(int i, int nb) const {
         if ((i < 0) || (nb > _limit - i))
-            throw std::runtime_error();
+            throwOutOfBounds("invalid index", i + nb, _limit);
         return i;
     }
 
@@ -329,21 +370,24 @@ struct buffer : public buffer_base {
 
     static void checkBounds(int off, int len, int size) {
         if ((off | len | (off + len) | (size - (off + len))) < 0)
-            throw std::runtime_error("index out of bounds");
+            throwOutOfBounds("index out of bounds", off + len, size);
     }
 
-    int _markValue() {
+    int _markValue() const {
         return _mark;
     }
 
     void clearMark() {
         _mark = -1;
     }
-protected:
 
-#ifdef DEBUG
-    T* debug_buffer;
-#endif
+private:
+    void check(int mark, int pos, int lim) {
+        limit(lim);
+        position(pos);
+        if (mark > pos)
+            throwOutOfBounds("mark > position", mark, pos);
+    }
 };
 
 template <typename T>
@@ -1,173 +1,265 @@
-
-/*
-    Copyright 2011 Aevum Software aevum @ aevumlab.com
-
-    Licensed under the Apache License, Version 2.0 (the "License");
-    you may not use this file except in compliance with the License.
-    You may obtain a copy of the License at
-
-        http://www.apache.org/licenses/LICENSE-2.0
-
-    Unless required by applicable law or agreed to in writing, software
-    distributed under the License is distributed on an "AS IS" BASIS,
-    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
-    See the License for the specific language governing permissions and
-    limitations under the License.
-
-    @author Victor Vicente de Carvalho victor.carvalho@aevumlab.com
-    @author Ozires Bortolon de Faria ozires@aevumlab.com
-*/
-
-#include "BufferUtils.hpp"
-
-using namespace gdx_cpp::utils;
-
-void BufferUtils::copy (const Buffer& dst,int numFloats,int offset) {
-    copyJni(src, dst, numFloats, offset);
-    dst.position(0);
-
-    if (dst instanceof ByteBuffer)
-        dst.limit(numFloats << 2);
-    else if (dst instanceof FloatBuffer) dst.limit(numFloats);
-}
-
-void BufferUtils::copy (int srcOffset,const Buffer& dst,int numElements) {
-    copyJni(src, srcOffset, dst, positionInBytes(dst), numElements);
-    dst.limit(dst.position() + bytesToElements(dst, numElements));
-}
-
-void BufferUtils::copy (int srcOffset,const Buffer& dst,int numElements) {
-    copyJni(src, srcOffset << 1, dst, positionInBytes(dst), numElements << 1);
-    dst.limit(dst.position() + bytesToElements(dst, numElements << 1));
-}
-
-void BufferUtils::copy (int srcOffset,const Buffer& dst,int numElements) {
-    copyJni(src, srcOffset << 1, dst, positionInBytes(dst), numElements << 1);
-    dst.limit(dst.position() + bytesToElements(dst, numElements << 1));
-}
-
-void BufferUtils::copy (int srcOffset,const Buffer& dst,int numElements) {
-    copyJni(src, srcOffset << 2, dst, positionInBytes(dst), numElements << 2);
-    dst.limit(dst.position() + bytesToElements(dst, numElements << 2));
-}
-
-void BufferUtils::copy (int srcOffset,const Buffer& dst,int numElements) {
-    copyJni(src, srcOffset << 3, dst, positionInBytes(dst), numElements << 3);
-    dst.limit(dst.position() + bytesToElements(dst, numElements << 3));
-}
-
-void BufferUtils::copy (int srcOffset,const Buffer& dst,int numElements) {
-    copyJni(src, srcOffset << 2, dst, positionInBytes(dst), numElements << 2);
-    dst.limit(dst.position() + bytesToElements(dst, numElements << 2));
-}
-
-void BufferUtils::copy (int srcOffset,const Buffer& dst,int numElements) {
-    copyJni(src, srcOffset << 3, dst, positionInBytes(dst), numElements << 3);
-    dst.limit(dst.position() + bytesToElements(dst, numElements << 3));
-}
-
-void BufferUtils::copy (const Buffer& src,const Buffer& dst,int numElements) {
-    int numBytes = elementsToBytes(src, numElements);
-    copyJni(src, positionInBytes(src), dst, positionInBytes(dst), numBytes);
-    dst.limit(dst.position() + bytesToElements(dst, numBytes));
-}
-
-int BufferUtils::positionInBytes (const Buffer& dst) {
-    if (dst instanceof ByteBuffer)
-        return dst.position();
-    else if (dst instanceof ShortBuffer)
-        return dst.position() << 1;
-    else if (dst instanceof CharBuffer)
-        return dst.position() << 1;
-    else if (dst instanceof IntBuffer)
-        return dst.position() << 2;
-    else if (dst instanceof LongBuffer)
-        return dst.position() << 3;
-    else if (dst instanceof FloatBuffer)
-        return dst.position() << 2;
-    else if (dst instanceof DoubleBuffer)
-        return dst.position() << 3;
-    else
-        throw new GdxRuntimeException("Can't copy to a " + dst.getClass().getName() + " instance");
-}
-
-int BufferUtils::bytesToElements (const Buffer& dst,int bytes) {
-    if (dst instanceof ByteBuffer)
-        return bytes;
-    else if (dst instanceof ShortBuffer)
-        return bytes >>> 1;
-    else if (dst instanceof CharBuffer)
-        return bytes >>> 1;
-    else if (dst instanceof IntBuffer)
-        return bytes >>> 2;
-    else if (dst instanceof LongBuffer)
-        return bytes >>> 3;
-    else if (dst instanceof FloatBuffer)
-        return bytes >>> 2;
-    else if (dst instanceof DoubleBuffer)
-        return bytes >>> 3;
-    else
-        throw new GdxRuntimeException("Can't copy to a " + dst.getClass().getName() + " instance");
-}
-
-int BufferUtils::elementsToBytes (const Buffer& dst,int elements) {
-    if (dst instanceof ByteBuffer)
-        return elements;
-    else if (dst instanceof ShortBuffer)
-        return elements << 1;
-    else if (dst instanceof CharBuffer)
-        return elements << 1;
-    else if (dst instanceof IntBuffer)
-        return elements << 2;
-    else if (dst instanceof LongBuffer)
-        return elements << 3;
-    else if (dst instanceof FloatBuffer)
-        return elements << 2;
-    else if (dst instanceof DoubleBuffer)
-        return elements << 3;
-    else
-        throw new GdxRuntimeException("Can't copy to a " + dst.getClass().getName() + " instance");
-}
-
-FloatBuffer& BufferUtils::newFloatBuffer (int numFloats) {
-    ByteBuffer buffer = ByteBuffer.allocateDirect(numFloats * 4);
-    buffer.order(ByteOrder.nativeOrder());
-    return buffer.asFloatBuffer();
-}
-
-DoubleBuffer& BufferUtils::newDoubleBuffer (int numDoubles) {
-    ByteBuffer buffer = ByteBuffer.allocateDirect(numDoubles * 8);
-    buffer.order(ByteOrder.nativeOrder());
-    return buffer.asDoubleBuffer();
-}
-
-ByteBuffer& BufferUtils::newByteBuffer (int numBytes) {
-    ByteBuffer buffer = ByteBuffer.allocateDirect(numBytes);
-    buffer.order(ByteOrder.nativeOrder());
-    return buffer;
-}
-
-ShortBuffer& BufferUtils::newShortBuffer (int numShorts) {
-    ByteBuffer buffer = ByteBuffer.allocateDirect(numShorts * 2);
-    buffer.order(ByteOrder.nativeOrder());
-    return buffer.asShortBuffer();
-}
-
-CharBuffer& BufferUtils::newCharBuffer (int numChars) {
-    ByteBuffer buffer = ByteBuffer.allocateDirect(numChars * 2);
-    buffer.order(ByteOrder.nativeOrder());
-    return buffer.asCharBuffer();
-}
-
-IntBuffer& BufferUtils::newIntBuffer (int numInts) {
-    ByteBuffer buffer = ByteBuffer.allocateDirect(numInts * 4);
-    buffer.order(ByteOrder.nativeOrder());
-    return buffer.asIntBuffer();
-}
-
-LongBuffer& BufferUtils::newLongBuffer (int numLongs) {
-    ByteBuffer buffer = ByteBuffer.allocateDirect(numLongs * 8);
-    buffer.order(ByteOrder.nativeOrder());
-    return buffer.asLongBuffer();
-}
-
+
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    @author Victor Vicente de Carvalho victor.carvalho@aevumlab.com
+    @author Ozires Bortolon de Faria ozires@aevumlab.com
+*/
+
+#include "BufferUtils.hpp"
+#include "Simd.hpp"
+#include "gdx-cpp/math/Matrix3.hpp"
+#include "gdx-cpp/math/Matrix4.hpp"
+#include "gdx-cpp/math/detail/MatrixKernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <stdint.h>
+
+using namespace gdx_cpp::utils;
+using namespace gdx_cpp;
+
+namespace {
+
+/** fill() copies at most this many floats at a time, so the source stays in L1 */
+const size_t FILL_CHUNK = 4096;
+
+inline float clamp (float value, float min, float max) {
+    // NaN ends up at min, as with the SIMD max/min order below
+    return value > min ? (value < max ? value : max) : min;
+}
+
+inline float packColor (const float* rgba) {
+    uint32_t color = ((uint32_t) (255 * clamp(rgba[3], 0, 1)) << 24) | ((uint32_t) (255 * clamp(rgba[2], 0, 1)) << 16)
+                     | ((uint32_t) (255 * clamp(rgba[1], 0, 1)) << 8) | (uint32_t) (255 * clamp(rgba[0], 0, 1));
+    color &= 0xfeffffff;
+    float bits;
+    memcpy(&bits, &color, sizeof(bits));
+    return bits;
+}
+
+/** Round to nearest even without F16C, after Fabian Giesen's float_to_half_fast3_rtne. The SSE2 version below is the
+ * same algorithm with the branches turned into selects. */
+inline unsigned short toHalf (float value) {
+    uint32_t f;
+    memcpy(&f, &value, sizeof(f));
+    uint32_t sign = f & 0x80000000u;
+    f ^= sign;
+
+    uint32_t half;
+    if (f >= 0x47800000u) {
+        // too large for a half: infinity, or a quiet NaN
+        half = f > 0x7f800000u ? 0x7e00 : 0x7c00;
+    } else if (f < 0x38800000u) {
+        // subnormal half: adding 0.5 lines the mantissa up with the half's and lets the FPU do the rounding
+        float shifted;
+        memcpy(&shifted, &f, sizeof(shifted));
+        shifted += 0.5f;
+        memcpy(&half, &shifted, sizeof(half));
+        half -= 0x3f000000u;
+    } else {
+        uint32_t mantissaOdd = (f >> 13) & 1;
+        // rebias the exponent from 127 to 15 and round the 13 dropped bits, ties to even
+        f += 0xc8000fffu + mantissaOdd;
+        half = f >> 13;
+    }
+    return (unsigned short) (half | (sign >> 16));
+}
+
+inline short toNormalizedShort (float value) {
+    return (short) std::lrint(clamp(value, -1, 1) * 32767);
+}
+
+#if defined(GDX_CPP_SIMD_SSE)
+
+/** Clamps r, g, b, a to [0, 1] and scales them to 255, truncating like Color::toFloatBits */
+inline __m128i colorComponents (const float* rgba) {
+    __m128 clamped = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(rgba), _mm_setzero_ps()), _mm_set1_ps(1));
+    return _mm_cvttps_epi32(_mm_mul_ps(clamped, _mm_set1_ps(255)));
+}
+
+/** toHalf() for four floats, each half in the low 16 bits of its lane with the sign extended above */
+inline __m128i toHalves (__m128 f) {
+    __m128 sign = _mm_and_ps(f, _mm_castsi128_ps(_mm_set1_epi32(0x80000000)));
+    __m128 absolute = _mm_xor_ps(f, sign);
+    __m128i bits = _mm_castps_si128(absolute);
+
+    __m128i nan = _mm_castps_si128(_mm_cmpunord_ps(absolute, absolute));
+    __m128i special = _mm_or_si128(_mm_set1_epi32(0x7c00), _mm_and_si128(nan, _mm_set1_epi32(0x200)));
+
+    __m128i magic = _mm_set1_epi32(0x3f000000);
+    __m128i subnormalHalf = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absolute, _mm_castsi128_ps(magic))), magic);
+    __m128i mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(bits, 18), 31);
+    __m128i rebiased = _mm_sub_epi32(_mm_add_epi32(bits, _mm_set1_epi32(0xc8000fff)), mantissaOdd);
+    __m128i normalHalf = _mm_srli_epi32(rebiased, 13);
+
+    __m128i subnormal = _mm_cmpgt_epi32(_mm_set1_epi32(0x38800000), bits);
+    __m128i finite = _mm_or_si128(_mm_and_si128(subnormal, subnormalHalf), _mm_andnot_si128(subnormal, normalHalf));
+    __m128i regular = _mm_cmpgt_epi32(_mm_set1_epi32(0x47800000), bits);
+    __m128i half = _mm_or_si128(_mm_and_si128(regular, finite), _mm_andnot_si128(regular, special));
+    return _mm_or_si128(half, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+}
+
+#elif defined(GDX_CPP_SIMD_NEON)
+
+inline uint32x4_t colorComponents (const float* rgba) {
+    float32x4_t clamped = vminq_f32(vmaxq_f32(vld1q_f32(rgba), vdupq_n_f32(0)), vdupq_n_f32(1));
+    return vcvtq_u32_f32(vmulq_n_f32(clamped, 255));
+}
+
+#endif
+
+float* vectors (buffer<float>& data, int dimensions, int stride, int count, int offset) {
+    long long end = (long long) offset + (long long) (count - 1) * stride + dimensions;
+    if (count > 0 && (offset < 0 || end > data.remaining()))
+        throw std::runtime_error("vectors exceed the buffer's limit");
+    return data.pointer() + data.position() + offset;
+}
+
+}
+
+void BufferUtils::copy (const float* src, buffer<float>& dst, int numFloats, int offset) {
+    dst.copy(src, numFloats, offset);
+}
+
+void BufferUtils::transform (float* data, int dimensions, int stride, int count, const math::Matrix4& matrix) {
+    if (dimensions < 1 || dimensions > 4)
+        throw std::runtime_error("a Matrix4 transforms vectors of 1 to 4 dimensions");
+    math::detail::simd::mulVecN4x4(matrix.val, dimensions, data, data, count, stride, stride);
+}
+
+void BufferUtils::transform (float* data, int dimensions, int stride, int count, const math::Matrix3& matrix) {
+    if (dimensions < 2 || dimensions > 3)
+        throw std::runtime_error("a Matrix3 transforms vectors of 2 or 3 dimensions");
+    math::detail::simd::mulVecN3x3(matrix.vals, dimensions, data, data, count, stride, stride);
+}
+
+void BufferUtils::transform (buffer<float>& data, int dimensions, int stride, int count, const math::Matrix4& matrix,
+                             int offset) {
+    transform(vectors(data, dimensions, stride, count, offset), dimensions, stride, count, matrix);
+}
+
+void BufferUtils::transform (buffer<float>& data, int dimensions, int stride, int count, const math::Matrix3& matrix,
+                             int offset) {
+    transform(vectors(data, dimensions, stride, count, offset), dimensions, stride, count, matrix);
+}
+
+void BufferUtils::packColors (const float* src, int srcStride, float* dst, int dstStride, int count) {
+#if defined(GDX_CPP_SIMD_SSE)
+    const __m128i mask = _mm_set1_epi32(0xfeffffff);
+    for (; count >= 4; count -= 4, src += srcStride * 4, dst += dstStride * 4) {
+        // saturating down to bytes leaves r, g, b, a in memory order
+        __m128i c0 = colorComponents(src);
+        __m128i c1 = colorComponents(src + srcStride);
+        __m128i c2 = colorComponents(src + srcStride * 2);
+        __m128i c3 = colorComponents(src + srcStride * 3);
+        __m128i packed = _mm_and_si128(_mm_packus_epi16(_mm_packs_epi32(c0, c1), _mm_packs_epi32(c2, c3)), mask);
+        if (dstStride == 1) {
+            _mm_storeu_si128((__m128i*) dst, packed);
+        } else {
+            GDX_CPP_ALIGN(16) float colors[4];
+            _mm_store_si128((__m128i*) colors, packed);
+            dst[0] = colors[0];
+            dst[dstStride] = colors[1];
+            dst[dstStride * 2] = colors[2];
+            dst[dstStride * 3] = colors[3];
+        }
+    }
+#elif defined(GDX_CPP_SIMD_NEON)
+    const uint32x4_t mask = vdupq_n_u32(0xfeffffff);
+    for (; count >= 4; count -= 4, src += srcStride * 4, dst += dstStride * 4) {
+        uint32x4_t c0 = colorComponents(src);
+        uint32x4_t c1 = colorComponents(src + srcStride);
+        uint32x4_t c2 = colorComponents(src + srcStride * 2);
+        uint32x4_t c3 = colorComponents(src + srcStride * 3);
+        uint8x16_t bytes = vcombine_u8(vmovn_u16(vcombine_u16(vmovn_u32(c0), vmovn_u32(c1))),
+                                       vmovn_u16(vcombine_u16(vmovn_u32(c2), vmovn_u32(c3))));
+        float32x4_t packed = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_u8(bytes), mask));
+        if (dstStride == 1) {
+            vst1q_f32(dst, packed);
+        } else {
+            vst1q_lane_f32(dst, packed, 0);
+            vst1q_lane_f32(dst + dstStride, packed, 1);
+            vst1q_lane_f32(dst + dstStride * 2, packed, 2);
+            vst1q_lane_f32(dst + dstStride * 3, packed, 3);
+        }
+    }
+#endif
+    for (int i = 0; i < count; i++, src += srcStride, dst += dstStride)
+        *dst = packColor(src);
+}
+
+void BufferUtils::toHalfFloats (const float* src, unsigned short* dst, int count) {
+    int i = 0;
+#if defined(GDX_CPP_SIMD_SSE)
+    for (; i + 8 <= count; i += 8) {
+        // the sign extension survives the signed saturating pack unchanged
+        __m128i halves = _mm_packs_epi32(toHalves(_mm_loadu_ps(src + i)), toHalves(_mm_loadu_ps(src + i + 4)));
+        _mm_storeu_si128((__m128i*) (dst + i), halves);
+    }
+#elif defined(GDX_CPP_SIMD_NEON) && defined(__aarch64__)
+    for (; i + 4 <= count; i += 4)
+        vst1_u16(dst + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i))));
+#endif
+    for (; i < count; i++)
+        dst[i] = toHalf(src[i]);
+}
+
+void BufferUtils::toNormalizedShorts (const float* src, short* dst, int count) {
+    int i = 0;
+#if defined(GDX_CPP_SIMD_SSE)
+    const __m128 min = _mm_set1_ps(-1);
+    const __m128 max = _mm_set1_ps(1);
+    const __m128 range = _mm_set1_ps(32767);
+    for (; i + 8 <= count; i += 8) {
+        __m128i low = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i), min), max), range));
+        __m128i high = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + 4), min), max), range));
+        _mm_storeu_si128((__m128i*) (dst + i), _mm_packs_epi32(low, high));
+    }
+#elif defined(GDX_CPP_SIMD_NEON)
+    const float32x4_t min = vdupq_n_f32(-1);
+    const float32x4_t max = vdupq_n_f32(1);
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t v = vmulq_n_f32(vminq_f32(vmaxq_f32(vld1q_f32(src + i), min), max), 32767);
+        // vcvtq truncates, round half away from zero instead
+        float32x4_t half = vbslq_f32(vcltq_f32(v, vdupq_n_f32(0)), vdupq_n_f32(-0.5f), vdupq_n_f32(0.5f));
+        vst1_s16(dst + i, vqmovn_s32(vcvtq_s32_f32(vaddq_f32(v, half))));
+    }
+#endif
+    for (; i < count; i++)
+        dst[i] = toNormalizedShort(src[i]);
+}
+
+void BufferUtils::fill (float* dst, const float* pattern, int patternLength, int count) {
+    if (patternLength <= 0 || count <= 0) return;
+    if (patternLength == 1) {
+        std::fill(dst, dst + count, pattern[0]);
+        return;
+    }
+
+    // copy the pattern once, then keep doubling what's written; chunks stay whole patterns
+    size_t total = (size_t) patternLength * count;
+    size_t filled = patternLength;
+    size_t chunk = patternLength;
+    memcpy(dst, pattern, sizeof(float) * patternLength);
+    while (filled < total) {
+        size_t length = std::min(chunk, total - filled);
+        memcpy(dst + filled, dst, sizeof(float) * length);
+        filled += length;
+        if (chunk * 2 <= FILL_CHUNK) chunk *= 2;
+    }
+}
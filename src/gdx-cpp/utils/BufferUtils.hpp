@@ -24,36 +24,47 @@
 #include "Buffer.hpp"
 
 namespace gdx_cpp {
+namespace math {
+class Matrix3;
+class Matrix4;
+}
+
 namespace utils {
 
+/** Bulk operations over vertex data, vectorized with SSE2 or NEON where available (see Simd.hpp). Strides and offsets
+ * are counted in floats. The float* versions work on raw memory; the buffer versions start at the buffer's position
+ * and throw if the data they would touch doesn't end before its limit. */
 class BufferUtils {
 public:
-    static void copy (float * value, const gdx_cpp::utils::buffer<float>& dst, int numFloats,int offset);
-
-//     static void copy (const Buffer& dst,int numFloats,int offset);
-//     static void copy (int srcOffset,const Buffer& dst,int numElements);
-//     static void copy (int srcOffset,const Buffer& dst,int numElements);
-//     static void copy (int srcOffset,const Buffer& dst,int numElements);
-//     static void copy (int srcOffset,const Buffer& dst,int numElements);
-//     static void copy (int srcOffset,const Buffer& dst,int numElements);
-//     static void copy (int srcOffset,const Buffer& dst,int numElements);
-//     static void copy (int srcOffset,const Buffer& dst,int numElements);
-//     static void copy (const Buffer& src,const Buffer& dst,int numElements);
-//     static FloatBuffer& newFloatBuffer (int numFloats);
-//     static DoubleBuffer& newDoubleBuffer (int numDoubles);
-//     static ByteBuffer& newByteBuffer (int numBytes);
-//     static ShortBuffer& newShortBuffer (int numShorts);
-//     static CharBuffer& newCharBuffer (int numChars);
-//     static IntBuffer& newIntBuffer (int numInts);
-//     static LongBuffer& newLongBuffer (int numLongs);
-
-protected:
-
-
-private:
-//     static int positionInBytes (const Buffer& dst);
-//     static int bytesToElements (const Buffer& dst,int bytes);
-//     static int elementsToBytes (const Buffer& dst,int elements);
+    /** Copies numFloats floats from src + offset to the start of dst, leaving dst's position at 0 and its limit after
+     * the copied floats */
+    static void copy (const float* src, buffer<float>& dst, int numFloats, int offset);
+
+    /** Multiplies count vectors, stride floats apart, by matrix in place. Each vector has dimensions components (1 to
+     * 4), a missing y or z is taken as 0 and a missing w as 1. Only the vector's own components are written, so
+     * attributes interleaved with it are left alone. */
+    static void transform (float* data, int dimensions, int stride, int count, const math::Matrix4& matrix);
+    /** As above for a Matrix3: with 2 dimensions it's an affine 2D transform, with 3 a plain 3x3 multiplication */
+    static void transform (float* data, int dimensions, int stride, int count, const math::Matrix3& matrix);
+    static void transform (buffer<float>& data, int dimensions, int stride, int count, const math::Matrix4& matrix,
+                           int offset = 0);
+    static void transform (buffer<float>& data, int dimensions, int stride, int count, const math::Matrix3& matrix,
+                           int offset = 0);
+
+    /** Packs count colors, given as r, g, b, a floats srcStride floats apart, into the floats Color::toFloatBits
+     * returns, written dstStride floats apart. Components are clamped to [0, 1]. */
+    static void packColors (const float* src, int srcStride, float* dst, int dstStride, int count);
+
+    /** Converts count floats to IEEE 754 half floats, rounding to nearest even; out of range values become
+     * infinities */
+    static void toHalfFloats (const float* src, unsigned short* dst, int count);
+
+    /** Converts count floats to shorts for normalized GL_SHORT attributes: [-1, 1] maps to [-32767, 32767], values
+     * outside are clamped */
+    static void toNormalizedShorts (const float* src, short* dst, int count);
+
+    /** Writes count copies of the patternLength floats at pattern to dst, back to back */
+    static void fill (float* dst, const float* pattern, int patternLength, int count);
 };
 
 } // namespace gdx_cpp
@@ -1,4 +1,3 @@
-
 /*
     Copyright 2011 Aevum Software aevum @ aevumlab.com
 
@@ -13,18 +12,13 @@
     WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
     See the License for the specific language governing permissions and
     limitations under the License.
-
-    @author Victor Vicente de Carvalho victor.carvalho@aevumlab.com
-    @author Ozires Bortolon de Faria ozires@aevumlab.com
 */
 
-#include "ActionResetingPool<T extends Action>.hpp"
-
-using namespace gdx_cpp::scenes::scene2d::actions;
+#ifndef GDX_CPP_UTILS_CACHELINE_HPP
+#define GDX_CPP_UTILS_CACHELINE_HPP
 
-T& ActionResetingPool<T extends Action>::obtain () {
-    T elem = super.obtain();
-    elem.reset();
-    return elem;
-}
+/** The cache line size assumed by the lock-free containers. Fields written by different threads are kept at least this
+ * far apart, so one thread's writes don't keep evicting the line another thread is working on (false sharing). */
+#define GDX_CPP_CACHE_LINE_SIZE 64
 
+#endif // GDX_CPP_UTILS_CACHELINE_HPP
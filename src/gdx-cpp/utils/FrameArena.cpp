@@ -0,0 +1,101 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "FrameArena.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+using namespace gdx_cpp::utils;
+
+namespace {
+
+std::atomic<unsigned int> nextId(1);
+
+/** The sub-arena a thread used last, checked by id so a FrameArena reusing a dead one's address isn't mistaken for it */
+struct LocalCache {
+    unsigned int arena;
+    LinearAllocator* allocator;
+};
+
+thread_local LocalCache localCache = { 0, NULL };
+
+}
+
+FrameArena::FrameArena (size_t blockSize)
+: id(nextId.fetch_add(1, std::memory_order_relaxed))
+, blockSize(blockSize)
+, peak(0)
+{
+}
+
+FrameArena::~FrameArena () {
+    for (unsigned int i = 0; i < subArenas.size(); i++)
+        delete subArenas[i].allocator;
+}
+
+LinearAllocator& FrameArena::local () {
+    if (localCache.arena == id) return *localCache.allocator;
+    return lookup();
+}
+
+LinearAllocator& FrameArena::lookup () {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::thread::id thread = std::this_thread::get_id();
+
+    LinearAllocator* allocator = NULL;
+    for (unsigned int i = 0; i < subArenas.size() && allocator == NULL; i++)
+        if (subArenas[i].thread == thread) allocator = subArenas[i].allocator;
+
+    if (allocator == NULL) {
+        SubArena subArena = { thread, new LinearAllocator(blockSize) };
+        subArenas.push_back(subArena);
+        allocator = subArena.allocator;
+    }
+
+    localCache.arena = id;
+    localCache.allocator = allocator;
+    return *allocator;
+}
+
+void FrameArena::reset () {
+    std::lock_guard<std::mutex> lock(mutex);
+    peak = std::max(peak, sumUsed());
+    for (unsigned int i = 0; i < subArenas.size(); i++)
+        subArenas[i].allocator->reset();
+}
+
+size_t FrameArena::getUsed () {
+    std::lock_guard<std::mutex> lock(mutex);
+    return sumUsed();
+}
+
+size_t FrameArena::getPeak () {
+    std::lock_guard<std::mutex> lock(mutex);
+    return std::max(peak, sumUsed());
+}
+
+size_t FrameArena::sumUsed () const {
+    size_t used = 0;
+    for (unsigned int i = 0; i < subArenas.size(); i++)
+        used += subArenas[i].allocator->getUsed();
+    return used;
+}
+
+int FrameArena::getThreadCount () {
+    std::lock_guard<std::mutex> lock(mutex);
+    return subArenas.size();
+}
@@ -0,0 +1,77 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef GDX_CPP_UTILS_FRAMEARENA_HPP_
+#define GDX_CPP_UTILS_FRAMEARENA_HPP_
+
+#include "LinearAllocator.hpp"
+
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gdx_cpp {
+namespace utils {
+
+/** Scratch memory for the temporaries of a frame, reset by the application loop before each frame.
+ *
+ * Every thread allocates from a sub-arena of its own, so the render thread and the job system's workers never contend.
+ * A thread's sub-arena is created the first time it asks for one and lives as long as the FrameArena. Memory from the
+ * arena must not be used after the frame it was allocated in. */
+class FrameArena {
+public:
+    explicit FrameArena (size_t blockSize = 256 * 1024);
+    ~FrameArena ();
+
+    /** The calling thread's sub-arena */
+    LinearAllocator& local ();
+
+    /** Releases this frame's allocations on every thread. Only call it when no thread is using the arena. */
+    void reset ();
+
+    /** The bytes allocated in this frame, over all threads */
+    size_t getUsed ();
+
+    /** The most bytes a single frame allocated, over all threads */
+    size_t getPeak ();
+
+    int getThreadCount ();
+
+private:
+    FrameArena (const FrameArena&);
+    FrameArena& operator= (const FrameArena&);
+
+    LinearAllocator& lookup ();
+    /** must hold the mutex */
+    size_t sumUsed () const;
+
+    struct SubArena {
+        std::thread::id thread;
+        LinearAllocator* allocator;
+    };
+
+    const unsigned int id;
+    const size_t blockSize;
+    std::mutex mutex;
+    std::vector<SubArena> subArenas;
+    size_t peak;
+};
+
+} // namespace gdx_cpp
+} // namespace utils
+
+#endif // GDX_CPP_UTILS_FRAMEARENA_HPP_
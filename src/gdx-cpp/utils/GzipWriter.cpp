@@ -0,0 +1,214 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "GzipWriter.hpp"
+#include "gdx-cpp/implementation/JobSystem.hpp"
+
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <zlib.h>
+
+using namespace gdx_cpp::utils;
+using gdx_cpp::implementation::JobSystem;
+
+namespace {
+
+/** The deflate window, how far back a block may refer into the one before */
+const size_t DICTIONARY_SIZE = 32 * 1024;
+
+}
+
+struct GzipWriter::Block {
+    Block (int level, size_t blockSize)
+    : input(DICTIONARY_SIZE + blockSize)
+    , dictionaryLength(0)
+    , inputLength(0)
+    , outputLength(0)
+    , crc(0)
+    , last(false)
+    , pending(false)
+    , job(NULL)
+    {
+        std::memset(&stream, 0, sizeof(stream));
+        // negative window bits for raw deflate, the gzip header and trailer are written around the blocks
+        if (deflateInit2(&stream, level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+            throw std::runtime_error("Error initializing zlib");
+        // room for the block and its sync or final marker
+        output.resize(deflateBound(&stream, blockSize) + 16);
+    }
+
+    ~Block () {
+        deflateEnd(&stream);
+    }
+
+    unsigned char* data () {
+        return &input[DICTIONARY_SIZE];
+    }
+
+    void compress () {
+        deflateReset(&stream);
+        if (dictionaryLength > 0) deflateSetDictionary(&stream, data() - dictionaryLength, dictionaryLength);
+        crc = crc32(0, data(), inputLength);
+
+        stream.next_in = data();
+        stream.avail_in = inputLength;
+        outputLength = 0;
+        while (true) {
+            stream.next_out = &output[outputLength];
+            stream.avail_out = output.size() - outputLength;
+            int result = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+            outputLength = output.size() - stream.avail_out;
+            if (result == Z_STREAM_END || (!last && stream.avail_out > 0)) break;
+            if (result != Z_OK && result != Z_BUF_ERROR) throw std::runtime_error("Error compressing data");
+            output.resize(output.size() * 2);
+        }
+    }
+
+    z_stream stream;
+    /** the dictionary followed by the block's data */
+    std::vector<unsigned char> input;
+    size_t dictionaryLength;
+    size_t inputLength;
+    std::vector<unsigned char> output;
+    size_t outputLength;
+    uLong crc;
+    bool last;
+    /** compressed or compressing, not yet written */
+    bool pending;
+    JobSystem::Job* job;
+    /** what compress() threw on a worker, rethrown on the writing thread when the block is collected */
+    std::exception_ptr error;
+};
+
+GzipWriter::GzipWriter (OutputSink& out, implementation::JobSystem* jobs, int level, size_t blockSize)
+: out(out)
+, jobs(jobs)
+, blockSize(blockSize > 0 ? blockSize : 1)
+, current(0)
+, headerWritten(false)
+, crc(crc32(0, NULL, 0))
+, size(0)
+{
+    // two blocks per thread keep every thread busy while the input of the next ones is collected
+    size_t count = jobs != NULL ? jobs->getThreadCount() * 2 : 1;
+    for (size_t i = 0; i < count; i++)
+        blocks.push_back(new Block(level, this->blockSize));
+}
+
+GzipWriter::~GzipWriter () {
+    for (size_t i = 0; i < blocks.size(); i++) {
+        if (blocks[i]->job != NULL) jobs->wait(blocks[i]->job);
+        delete blocks[i];
+    }
+}
+
+void GzipWriter::write (const char* data, size_t length) {
+    while (length > 0) {
+        Block& block = *blocks[current];
+        size_t count = blockSize - block.inputLength < length ? blockSize - block.inputLength : length;
+        std::memcpy(block.data() + block.inputLength, data, count);
+        block.inputLength += count;
+        data += count;
+        length -= count;
+        if (block.inputLength == blockSize) dispatch(false);
+    }
+}
+
+void GzipWriter::flush () {
+    if (blocks[current]->inputLength > 0) dispatch(false);
+    collectAll();
+    out.flush();
+}
+
+void GzipWriter::finish () {
+    dispatch(true);
+    collectAll();
+    out.flush();
+}
+
+void GzipWriter::dispatch (bool last) {
+    Block& block = *blocks[current];
+    block.last = last;
+    block.pending = true;
+    if (jobs != NULL) {
+        block.job = jobs->create([&block] () {
+            // an exception escaping a job would terminate the worker's thread
+            try {
+                block.compress();
+            } catch (...) {
+                block.error = std::current_exception();
+            }
+        });
+        jobs->run(block.job);
+    } else {
+        block.compress();
+    }
+
+    // the oldest block is reused next, which makes it the next one to write
+    current = (current + 1) % blocks.size();
+    Block& next = *blocks[current];
+    collect(next);
+
+    // the last 32K before the next block, which may reach into the dictionary of a short block
+    size_t available = block.dictionaryLength + block.inputLength;
+    size_t length = last ? 0 : available < DICTIONARY_SIZE ? available : DICTIONARY_SIZE;
+    std::memmove(next.data() - length, block.data() + block.inputLength - length, length);
+    next.dictionaryLength = length;
+    next.inputLength = 0;
+}
+
+void GzipWriter::collect (Block& block) {
+    if (block.job != NULL) {
+        jobs->wait(block.job);
+        block.job = NULL;
+    }
+    if (!block.pending) return;
+    block.pending = false;
+
+    if (block.error) {
+        std::exception_ptr error = block.error;
+        block.error = std::exception_ptr();
+        std::rethrow_exception(error);
+    }
+
+    if (!headerWritten) {
+        // deflate, no flags, no modification time, unknown OS
+        static const char header[10] = { 0x1f, (char) 0x8b, 8, 0, 0, 0, 0, 0, 0, (char) 0xff };
+        out.write(header, sizeof(header));
+        headerWritten = true;
+    }
+    out.write((const char*) &block.output[0], block.outputLength);
+    crc = crc32_combine(crc, block.crc, block.inputLength);
+    size += block.inputLength;
+
+    if (block.last) {
+        char trailer[8];
+        for (int i = 0; i < 4; i++) {
+            trailer[i] = (char) (crc >> i * 8);
+            trailer[4 + i] = (char) (size >> i * 8);
+        }
+        out.write(trailer, sizeof(trailer));
+        headerWritten = false;
+        crc = crc32(0, NULL, 0);
+        size = 0;
+    }
+}
+
+void GzipWriter::collectAll () {
+    for (size_t i = 1; i <= blocks.size(); i++)
+        collect(*blocks[(current + i) % blocks.size()]);
+}
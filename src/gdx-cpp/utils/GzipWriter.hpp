@@ -0,0 +1,81 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef GDX_CPP_UTILS_GZIPWRITER_HPP_
+#define GDX_CPP_UTILS_GZIPWRITER_HPP_
+
+#include "WriteBuffer.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace gdx_cpp {
+
+namespace implementation {
+class JobSystem;
+}
+
+namespace utils {
+
+/** Gzip compresses into another sink, typically a files::FileSink under a WriteBuffer for save games.
+ *
+ * The data is cut into blocks that are compressed independently, on the job system's threads if one is given, and
+ * written in order as one deflate stream: every block but the last ends with a sync flush, and each is primed with the
+ * 32K that precede it, so the output is as small as a serial gzip's and any gzip reader can read it. The input of the
+ * next blocks is collected while earlier ones compress.
+ *
+ * finish() ends the gzip member; the destructor doesn't, so without it the output is truncated. Errors of the output
+ * sink propagate from write(), flush() and finish(), and so do compression errors, which are rethrown on the writing
+ * thread when a block that failed on a worker is collected. */
+class GzipWriter : public OutputSink {
+public:
+    /** level is zlib's, 1 to 9 or -1 for the default of 6 */
+    GzipWriter (OutputSink& out, implementation::JobSystem* jobs = NULL, int level = -1, size_t blockSize = 128 * 1024);
+    ~GzipWriter ();
+
+    void write (const char* data, size_t length);
+    /** Compresses what was written so far and flushes it to the output. The output then inflates to all of it, though
+     * the gzip trailer is still missing. */
+    void flush ();
+    /** Ends the gzip member. Writing afterwards starts another one; readers inflate concatenated members as one. */
+    void finish ();
+
+private:
+    struct Block;
+
+    GzipWriter (const GzipWriter&);
+    GzipWriter& operator= (const GzipWriter&);
+
+    void dispatch (bool last);
+    /** Waits for the block if it is compressing, then writes it if it wasn't yet */
+    void collect (Block& block);
+    void collectAll ();
+
+    OutputSink& out;
+    implementation::JobSystem* jobs;
+    size_t blockSize;
+    /** a ring, blocks[current] collects the input and the others compress in the order after it */
+    std::vector<Block*> blocks;
+    size_t current;
+    bool headerWritten;
+    unsigned long crc;
+    unsigned long size;
+};
+
+} // namespace gdx_cpp
+} // namespace utils
+
+#endif // GDX_CPP_UTILS_GZIPWRITER_HPP_
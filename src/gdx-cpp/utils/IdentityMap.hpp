@@ -18,52 +18,28 @@
     @author Ozires Bortolon de Faria ozires@aevumlab.com
 */
 
-#ifndef GDX_CPP_UTILS_IDENTITYMAP<K, V>_HPP_
-#define GDX_CPP_UTILS_IDENTITYMAP<K, V>_HPP_
+#ifndef GDX_CPP_UTILS_IDENTITYMAP_HPP_
+#define GDX_CPP_UTILS_IDENTITYMAP_HPP_
+
+#include "ObjectMap.hpp"
 
 namespace gdx_cpp {
 namespace utils {
 
-class IdentityMap {
+/** An unordered map that compares keys by identity: the keys are the addresses of the objects, which are neither
+ * owned nor dereferenced by the map. See ObjectMap. */
+template <typename K, typename V>
+class IdentityMap : public ObjectMap<K*, V> {
 public:
-    V& put (const K& key,const V& value);
-    V& get (const K& key);
-    V& remove (const K& key);
-    void clear ();
-    bool containsValue (const Object& value,bool identity);
-    bool containsKey (const K& key);
-    void ensureCapacity (int additionalCapacity);
-    std::string& toString ();
-    Values<V>& values ();
-    Keys<K>& keys ();
-    std::string& toString ();
-    void reset ();
-    void remove ();
-    bool hasNext ();
-    bool hasNext ();
-    V& next ();
-    Iterator<V>& iterator ();
-    Array<V>& toArray ();
-    bool hasNext ();
-    K& next ();
-    Iterator<K>& iterator ();
-    Array<K>& toArray ();
-
-protected:
-
+    IdentityMap () {
+    }
 
-private:
-    void putResize (const K& key,const V& value);
-    void push (const K& insertKey,const V& insertValue,int index1,const K& key1,int index2,const K& key2,int index3,const K& key3);
-    void putStash (const K& key,const V& value);
-    V& getStash (const K& key);
-    bool containsKeyStash (const K& key);
-    void resize (int newSize);
-    int hash2 (long h);
-    int hash3 (long h);
+    explicit IdentityMap (int initialCapacity, float loadFactor = 0.8f)
+    : ObjectMap<K*, V>(initialCapacity, loadFactor) {
+    }
 };
 
 } // namespace gdx_cpp
 } // namespace utils
 
-#endif // GDX_CPP_UTILS_IDENTITYMAP<K, V>_HPP_
+#endif // GDX_CPP_UTILS_IDENTITYMAP_HPP_
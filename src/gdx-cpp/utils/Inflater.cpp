@@ -0,0 +1,110 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Inflater.hpp"
+#include "gdx-cpp/files/MappedFile.hpp"
+
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+using namespace gdx_cpp::utils;
+
+Inflater::Inflater ()
+: finished(false)
+{
+    std::memset(&stream, 0, sizeof(stream));
+    // 15 bits of window, + 32 detects zlib and gzip headers
+    if (inflateInit2(&stream, 15 + 32) != Z_OK) throw std::runtime_error("Error initializing zlib");
+}
+
+Inflater::~Inflater () {
+    inflateEnd(&stream);
+}
+
+void Inflater::reset () {
+    inflateReset(&stream);
+    finished = false;
+}
+
+size_t Inflater::inflate (const unsigned char*& in, size_t& length, unsigned char* out, size_t capacity) {
+    size_t written = 0;
+    // also runs with a full buffer, as the trailer can be read without room for output
+    while (!finished && length > 0) {
+        // zlib counts in unsigned ints
+        uInt inChunk = length < UINT_MAX ? (uInt) length : UINT_MAX;
+        uInt outChunk = capacity - written < UINT_MAX ? (uInt) (capacity - written) : UINT_MAX;
+        stream.next_in = (Bytef*) in;
+        stream.avail_in = inChunk;
+        stream.next_out = out + written;
+        stream.avail_out = outChunk;
+
+        int result = ::inflate(&stream, Z_NO_FLUSH);
+        in += inChunk - stream.avail_in;
+        length -= inChunk - stream.avail_in;
+        written += outChunk - stream.avail_out;
+
+        if (result == Z_STREAM_END) {
+            // another gzip member may follow
+            if (length >= 2 && in[0] == 0x1f && in[1] == 0x8b) inflateReset(&stream);
+            else finished = true;
+        } else if (result == Z_BUF_ERROR) {
+            // no progress possible, the buffer is full
+            break;
+        } else if (result != Z_OK) {
+            throw std::runtime_error(std::string("Error inflating data: ")
+                                     + (stream.msg != NULL ? stream.msg : "corrupt data"));
+        }
+    }
+    return written;
+}
+
+size_t Inflater::inflate (const void* data, size_t length, unsigned char* out, size_t capacity) {
+    Inflater inflater;
+    const unsigned char* in = (const unsigned char*) data;
+    size_t written = inflater.inflate(in, length, out, capacity);
+    if (!inflater.isFinished()) {
+        if (length > 0) throw std::runtime_error("Error inflating data: more data than the buffer holds");
+        throw std::runtime_error("Error inflating data: unexpected end of data");
+    }
+    return written;
+}
+
+void Inflater::inflate (const void* data, size_t length, std::vector<unsigned char>& out) {
+    const unsigned char* in = (const unsigned char*) data;
+    size_t size = length * 4;
+    // the last four bytes of a gzip member are the uncompressed size modulo 2^32
+    if (length >= 18 && in[0] == 0x1f && in[1] == 0x8b) {
+        const unsigned char* isize = in + length - 4;
+        size = isize[0] | isize[1] << 8 | isize[2] << 16 | (size_t) isize[3] << 24;
+    }
+
+    Inflater inflater;
+    size_t written = 0;
+    out.resize(size > 0 ? size : 64);
+    while (true) {
+        written += inflater.inflate(in, length, &out[0] + written, out.size() - written);
+        if (inflater.isFinished()) break;
+        if (length == 0) throw std::runtime_error("Error inflating data: unexpected end of data");
+        out.resize(out.size() * 2);
+    }
+    out.resize(written);
+}
+
+void Inflater::inflate (const files::MappedFile& file, std::vector<unsigned char>& out) {
+    inflate(file.getData(), file.getSize(), out);
+}
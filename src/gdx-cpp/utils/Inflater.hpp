@@ -0,0 +1,68 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef GDX_CPP_UTILS_INFLATER_HPP_
+#define GDX_CPP_UTILS_INFLATER_HPP_
+
+#include <cstddef>
+#include <vector>
+#include <zlib.h>
+
+namespace gdx_cpp {
+
+namespace files {
+class MappedFile;
+}
+
+namespace utils {
+
+/** Inflates zlib or gzip data, told apart by their headers, from memory into caller buffers. Concatenated gzip
+ * members, as written by GzipWriter::finish() more than once, are read as one stream. Errors throw
+ * std::runtime_error. */
+class Inflater {
+public:
+    Inflater ();
+    ~Inflater ();
+
+    /** Inflates from in, advancing it and decreasing length by what was consumed, into out. Returns the number of bytes
+     * written, which is less than capacity only once the input is used up or the data ended. */
+    size_t inflate (const unsigned char*& in, size_t& length, unsigned char* out, size_t capacity);
+    /** The end of the data was reached */
+    bool isFinished () const {
+        return finished;
+    }
+    /** Starts over with new data, keeping the memory */
+    void reset ();
+
+    /** Inflates all of the data into out, throwing if it is truncated or doesn't fit. Returns the number of bytes
+     * written. */
+    static size_t inflate (const void* data, size_t length, unsigned char* out, size_t capacity);
+    /** Inflates all of the data, replacing the contents of out. Gzip data is sized from its trailer up front. */
+    static void inflate (const void* data, size_t length, std::vector<unsigned char>& out);
+    static void inflate (const files::MappedFile& file, std::vector<unsigned char>& out);
+
+private:
+    Inflater (const Inflater&);
+    Inflater& operator= (const Inflater&);
+
+    z_stream stream;
+    bool finished;
+};
+
+} // namespace gdx_cpp
+} // namespace utils
+
+#endif // GDX_CPP_UTILS_INFLATER_HPP_
@@ -18,54 +18,27 @@
     @author Ozires Bortolon de Faria ozires@aevumlab.com
 */
 
-#ifndef GDX_CPP_UTILS_INTMAP<V>_HPP_
-#define GDX_CPP_UTILS_INTMAP<V>_HPP_
+#ifndef GDX_CPP_UTILS_INTMAP_HPP_
+#define GDX_CPP_UTILS_INTMAP_HPP_
+
+#include "ObjectMap.hpp"
 
 namespace gdx_cpp {
 namespace utils {
 
-class IntMap {
+/** An unordered map with int keys, see ObjectMap */
+template <typename V>
+class IntMap : public ObjectMap<int, V> {
 public:
-    V& put (int key,const V& value);
-    void putAll (const IntMap<V>& map);
-    V& get (int key);
-    V& remove (int key);
-    void clear ();
-    bool containsValue (const Object& value,bool identity);
-    bool containsKey (int key);
-    void ensureCapacity (int additionalCapacity);
-    std::string& toString ();
-    Entries<V>& entries ();
-    Values<V>& values ();
-    Keys& keys ();
-    std::string& toString ();
-    void reset ();
-    void remove ();
-    Entry<V>& next ();
-    bool hasNext ();
-    Iterator<Entry<V>>& iterator ();
-    bool hasNext ();
-    V& next ();
-    Iterator<V>& iterator ();
-    Array<V>& toArray ();
-    int next ();
-    IntArray& toArray ();
-
-protected:
-
+    IntMap () {
+    }
 
-private:
-    void putResize (int key,const V& value);
-    void push (int insertKey,const V& insertValue,int index1,int key1,int index2,int key2,int index3,int key3);
-    void putStash (int key,const V& value);
-    V& getStash (int key);
-    bool containsKeyStash (int key);
-    void resize (int newSize);
-    int hash2 (int h);
-    int hash3 (int h);
+    explicit IntMap (int initialCapacity, float loadFactor = 0.8f)
+    : ObjectMap<int, V>(initialCapacity, loadFactor) {
+    }
 };
 
 } // namespace gdx_cpp
 } // namespace utils
 
-#endif // GDX_CPP_UTILS_INTMAP<V>_HPP_
+#endif // GDX_CPP_UTILS_INTMAP_HPP_
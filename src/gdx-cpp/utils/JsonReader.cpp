@@ -1,504 +1,655 @@
-
-/*
-    Copyright 2011 Aevum Software aevum @ aevumlab.com
-
-    Licensed under the Apache License, Version 2.0 (the "License");
-    you may not use this file except in compliance with the License.
-    You may obtain a copy of the License at
-
-        http://www.apache.org/licenses/LICENSE-2.0
-
-    Unless required by applicable law or agreed to in writing, software
-    distributed under the License is distributed on an "AS IS" BASIS,
-    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
-    See the License for the specific language governing permissions and
-    limitations under the License.
-
-    @author Victor Vicente de Carvalho victor.carvalho@aevumlab.com
-    @author Ozires Bortolon de Faria ozires@aevumlab.com
-*/
-
-#include "JsonReader.hpp"
-
-using namespace gdx_cpp::utils;
-
-Object& JsonReader::parse (const std::string& json) {
-    char[] data = json.toCharArray();
-    return parse(data, 0, data.length);
-}
-
-Object& JsonReader::parse (const Reader& reader) throws IOException {
-    char[] data = new char[1024];
-    int offset = 0;
-    while (true) {
-        int length = reader.read(data, offset, data.length - offset);
-        if (length == -1) break;
-        if (length == 0) {
-            char[] newData = new char[data.length * 2];
-            System.arraycopy(data, 0, newData, 0, data.length);
-            data = newData;
-        } else
-            offset += length;
-    }
-    return parse(data, 0, offset);
-}
-
-Object& JsonReader::parse (const InputStream& input) throws IOException {
-    return parse(new InputStreamReader(input, "ISO-8859-1"));
-}
-
-Object& JsonReader::parse (const gdx_cpp::files::FileHandle& file) throws IOException {
-    return parse(file.read());
-}
-
-Object& JsonReader::parse (int offset,int length) {
-    int cs, p = 0, pe = data.length, eof = pe, top = 0;
-    int[] stack = new int[4];
-
-    int s = 0;
-    Array<String> names = new Array(8);
-    boolean needsUnescape = false;
-    RuntimeException parseRuntimeEx = null;
-
-    boolean debug = false;
-    if (debug) System.out.println();
-
-    try {
-
-        // line 3 "../src/com/pennypop/animation/JsonParser.java"
-        {
-            cs = json_start;
-            top = 0;
-        }
-
-        // line 8 "../src/com/pennypop/animation/JsonParser.java"
-        {
-            int _klen;
-            int _trans = 0;
-            int _acts;
-            int _nacts;
-            int _keys;
-            int _goto_targ = 0;
-
-_goto:
-            while (true) {
-                switch (_goto_targ) {
-                case 0:
-                    if (p == pe) {
-                        _goto_targ = 4;
-                        continue _goto;
-                    }
-                    if (cs == 0) {
-                        _goto_targ = 5;
-                        continue _goto;
-                    }
-                case 1:
-_match:
-                    do {
-                        _keys = _json_key_offsets[cs];
-                        _trans = _json_index_offsets[cs];
-                        _klen = _json_single_lengths[cs];
-                        if (_klen > 0) {
-                            int _lower = _keys;
-                            int _mid;
-                            int _upper = _keys + _klen - 1;
-                            while (true) {
-                                if (_upper < _lower) break;
-
-                                _mid = _lower + ((_upper - _lower) >> 1);
-                                if (data[p] < _json_trans_keys[_mid])
-                                    _upper = _mid - 1;
-                                else if (data[p] > _json_trans_keys[_mid])
-                                    _lower = _mid + 1;
-                                else {
-                                    _trans += (_mid - _keys);
-                                    break _match;
-                                }
-                            }
-                            _keys += _klen;
-                            _trans += _klen;
-                        }
-
-                        _klen = _json_range_lengths[cs];
-                        if (_klen > 0) {
-                            int _lower = _keys;
-                            int _mid;
-                            int _upper = _keys + (_klen << 1) - 2;
-                            while (true) {
-                                if (_upper < _lower) break;
-
-                                _mid = _lower + (((_upper - _lower) >> 1) & ~1);
-                                if (data[p] < _json_trans_keys[_mid])
-                                    _upper = _mid - 2;
-                                else if (data[p] > _json_trans_keys[_mid + 1])
-                                    _lower = _mid + 2;
-                                else {
-                                    _trans += ((_mid - _keys) >> 1);
-                                    break _match;
-                                }
-                            }
-                            _trans += _klen;
-                        }
-                    } while (false);
-
-                    _trans = _json_indicies[_trans];
-                    cs = _json_trans_targs[_trans];
-
-                    if (_json_trans_actions[_trans] != 0) {
-                        _acts = _json_trans_actions[_trans];
-                        _nacts = (int)_json_actions[_acts++];
-                        while (_nacts-- > 0) {
-                            switch (_json_actions[_acts++]) {
-                            case 0:
-                                // line 37 "JsonParser.rl"
-                            {
-                                s = p;
-                                needsUnescape = false;
-                            }
-                            break;
-                            case 1:
-                                // line 41 "JsonParser.rl"
-                            {
-                                needsUnescape = true;
-                            }
-                            break;
-                            case 2:
-                                // line 44 "JsonParser.rl"
-                            {
-                                String name = new String(data, s, p - s);
-                                s = p;
-                                if (needsUnescape) name = unescape(name);
-                                if (debug) System.out.println("name: " + name);
-                                names.add(name);
-                            }
-                            break;
-                            case 3:
-                                // line 51 "JsonParser.rl"
-                            {
-                                String value = new String(data, s, p - s);
-                                s = p;
-                                if (needsUnescape) value = unescape(value);
-                                String name = names.size > 0 ? names.pop() : null;
-                                if (debug) System.out.println("string: " + name + "=" + value);
-                                string(name, value);
-                            }
-                            break;
-                            case 4:
-                                // line 59 "JsonParser.rl"
-                            {
-                                String value = new String(data, s, p - s);
-                                s = p;
-                                String name = names.size > 0 ? names.pop() : null;
-                                if (debug) System.out.println("number: " + name + "=" + Float.parseFloat(value));
-                                number(name, value);
-                            }
-                            break;
-                            case 5:
-                                // line 66 "JsonParser.rl"
-                            {
-                                String name = names.size > 0 ? names.pop() : null;
-                                if (debug) System.out.println("null: " + name);
-                                string(name, null);
-                            }
-                            break;
-                            case 6:
-                                // line 71 "JsonParser.rl"
-                            {
-                                String name = names.size > 0 ? names.pop() : null;
-                                if (debug) System.out.println("startObject: " + name);
-                                startObject(name);
-                                {
-                                    if (top == stack.length) {
-                                        int[] newStack = new int[stack.length * 2];
-                                        System.arraycopy(stack, 0, newStack, 0, stack.length);
-                                        stack = newStack;
-                                    }
-                                    {
-                                        stack[top++] = cs;
-                                        cs = 12;
-                                        _goto_targ = 2;
-                                        if (true) continue _goto;
-                                    }
-                                }
-                            }
-                            break;
-                            case 7:
-                                // line 77 "JsonParser.rl"
-                            {
-                                if (debug) System.out.println("endObject");
-                                pop();
-                                {
-                                    cs = stack[--top];
-                                    _goto_targ = 2;
-                                    if (true) continue _goto;
-                                }
-                            }
-                            break;
-                            case 8:
-                                // line 82 "JsonParser.rl"
-                            {
-                                String name = names.size > 0 ? names.pop() : null;
-                                if (debug) System.out.println("startArray: " + name);
-                                startArray(name);
-                                {
-                                    if (top == stack.length) {
-                                        int[] newStack = new int[stack.length * 2];
-                                        System.arraycopy(stack, 0, newStack, 0, stack.length);
-                                        stack = newStack;
-                                    }
-                                    {
-                                        stack[top++] = cs;
-                                        cs = 35;
-                                        _goto_targ = 2;
-                                        if (true) continue _goto;
-                                    }
-                                }
-                            }
-                            break;
-                            case 9:
-                                // line 88 "JsonParser.rl"
-                            {
-                                if (debug) System.out.println("endArray");
-                                pop();
-                                {
-                                    cs = stack[--top];
-                                    _goto_targ = 2;
-                                    if (true) continue _goto;
-                                }
-                            }
-                            break;
-                            // line 186 "../src/com/pennypop/animation/JsonParser.java"
-                            }
-                        }
-                    }
-
-                case 2:
-                    if (cs == 0) {
-                        _goto_targ = 5;
-                        continue _goto;
-                    }
-                    if (++p != pe) {
-                        _goto_targ = 1;
-                        continue _goto;
-                    }
-                case 4:
-                    if (p == eof) {
-                        int __acts = _json_eof_actions[cs];
-                        int __nacts = (int)_json_actions[__acts++];
-                        while (__nacts-- > 0) {
-                            switch (_json_actions[__acts++]) {
-                            case 4:
-                                // line 59 "JsonParser.rl"
-                            {
-                                String value = new String(data, s, p - s);
-                                s = p;
-                                String name = names.size > 0 ? names.pop() : null;
-                                if (debug) System.out.println("number: " + name + "=" + Float.parseFloat(value));
-                                number(name, value);
-                            }
-                            break;
-                            case 5:
-                                // line 66 "JsonParser.rl"
-                            {
-                                String name = names.size > 0 ? names.pop() : null;
-                                if (debug) System.out.println("null: " + name);
-                                string(name, null);
-                            }
-                            break;
-                            // line 225 "../src/com/pennypop/animation/JsonParser.java"
-                            }
-                        }
-                    }
-
-                case 5:
-                }
-                break;
-            }
-        }
-
-        // line 114 "JsonParser.rl"
-
-    } catch (RuntimeException ex) {
-        parseRuntimeEx = ex;
-    }
-
-    if (p < pe) {
-        int lineNumber = 1;
-        for (int i = 0; i < p; i++)
-            if (data[i] == '\n') lineNumber++;
-        throw new IllegalArgumentException("Error parsing JSON on line " + lineNumber + " near: " + new String(data, p, pe - p),
-                                           parseRuntimeEx);
-    } else if (elements.size != 0) {
-        Object element = elements.peek();
-        elements.clear();
-        if (element instanceof ObjectMap)
-            throw new IllegalArgumentException("Error parsing JSON, unmatched brace.");
-        else
-            throw new IllegalArgumentException("Error parsing JSON, unmatched bracket.");
-    }
-    Object root = this.root;
-    this.root = null;
-    return root;
-}
-
-char* JsonReader::init__json_actions_0 () {
-    return new byte[] {0, 1, 0, 1, 1, 1, 2, 1, 3, 1, 4, 1, 5, 1, 6, 1, 7, 1, 8, 1, 9, 2, 0, 2, 2, 0, 3, 2, 4, 7, 2, 4, 9, 2, 5,
-                       7, 2, 5, 9
-                      };
-}
-
-short* JsonReader::init__json_key_offsets_0 () {
-    return new short[] {0, 0, 11, 13, 15, 24, 27, 29, 33, 35, 36, 37, 38, 44, 46, 48, 52, 63, 65, 67, 72, 76, 85, 88, 96, 98,
-                        107, 111, 113, 120, 130, 131, 132, 133, 138, 147, 160, 162, 164, 169, 180, 183, 191, 193, 202, 206, 208, 215, 225, 226,
-                        227, 228, 233, 242, 245, 251, 258, 263, 271, 274, 274
-                       };
-}
-
-char* JsonReader::init__json_trans_keys_0 () {
-    return new char[] {32, 34, 45, 48, 91, 110, 123, 9, 13, 49, 57, 34, 92, 34, 92, 34, 47, 92, 98, 102, 110, 114, 116, 117,
-                       48, 49, 57, 48, 57, 43, 45, 48, 57, 48, 57, 117, 108, 108, 32, 34, 44, 125, 9, 13, 34, 92, 34, 92, 32, 58, 9, 13, 32,
-                       34, 45, 48, 91, 110, 123, 9, 13, 49, 57, 34, 92, 34, 92, 32, 44, 125, 9, 13, 32, 34, 9, 13, 34, 47, 92, 98, 102, 110,
-                       114, 116, 117, 48, 49, 57, 32, 44, 46, 69, 101, 125, 9, 13, 48, 57, 32, 44, 69, 101, 125, 9, 13, 48, 57, 43, 45, 48, 57,
-                       48, 57, 32, 44, 125, 9, 13, 48, 57, 32, 44, 46, 69, 101, 125, 9, 13, 48, 57, 117, 108, 108, 32, 44, 125, 9, 13, 34, 47,
-                       92, 98, 102, 110, 114, 116, 117, 32, 34, 44, 45, 48, 91, 93, 110, 123, 9, 13, 49, 57, 34, 92, 34, 92, 32, 44, 93, 9, 13,
-                       32, 34, 45, 48, 91, 110, 123, 9, 13, 49, 57, 48, 49, 57, 32, 44, 46, 69, 93, 101, 9, 13, 48, 57, 32, 44, 69, 93, 101, 9,
-                       13, 48, 57, 43, 45, 48, 57, 48, 57, 32, 44, 93, 9, 13, 48, 57, 32, 44, 46, 69, 93, 101, 9, 13, 48, 57, 117, 108, 108,
-                       32, 44, 93, 9, 13, 34, 47, 92, 98, 102, 110, 114, 116, 117, 32, 9, 13, 32, 46, 69, 101, 9, 13, 32, 69, 101, 9, 13, 48,
-                       57, 32, 9, 13, 48, 57, 32, 46, 69, 101, 9, 13, 48, 57, 32, 9, 13, 0
-                      };
-}
-
-char* JsonReader::init__json_single_lengths_0 () {
-    return new byte[] {0, 7, 2, 2, 7, 1, 0, 2, 0, 1, 1, 1, 4, 2, 2, 2, 7, 2, 2, 3, 2, 7, 1, 6, 0, 5, 2, 0, 3, 6, 1, 1, 1, 3, 7,
-                       9, 2, 2, 3, 7, 1, 6, 0, 5, 2, 0, 3, 6, 1, 1, 1, 3, 7, 1, 4, 3, 1, 4, 1, 0, 0
-                      };
-}
-
-char* JsonReader::init__json_range_lengths_0 () {
-    return new byte[] {0, 2, 0, 0, 1, 1, 1, 1, 1, 0, 0, 0, 1, 0, 0, 1, 2, 0, 0, 1, 1, 1, 1, 1, 1, 2, 1, 1, 2, 2, 0, 0, 0, 1, 1,
-                       2, 0, 0, 1, 2, 1, 1, 1, 2, 1, 1, 2, 2, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 1, 0, 0
-                      };
-}
-
-short* JsonReader::init__json_index_offsets_0 () {
-    return new short[] {0, 0, 10, 13, 16, 25, 28, 30, 34, 36, 38, 40, 42, 48, 51, 54, 58, 68, 71, 74, 79, 83, 92, 95, 103, 105,
-                        113, 117, 119, 125, 134, 136, 138, 140, 145, 154, 166, 169, 172, 177, 187, 190, 198, 200, 208, 212, 214, 220, 229, 231,
-                        233, 235, 240, 249, 252, 258, 264, 268, 275, 278, 279
-                       };
-}
-
-char* JsonReader::init__json_indicies_0 () {
-    return new byte[] {0, 2, 3, 4, 6, 7, 8, 0, 5, 1, 10, 11, 9, 13, 14, 12, 15, 15, 15, 15, 15, 15, 15, 15, 1, 16, 17, 1, 18,
-                       1, 19, 19, 20, 1, 20, 1, 21, 1, 22, 1, 23, 1, 24, 25, 26, 27, 24, 1, 29, 30, 28, 32, 33, 31, 34, 35, 34, 1, 35, 36, 37,
-                       38, 40, 41, 42, 35, 39, 1, 44, 45, 43, 47, 48, 46, 49, 26, 27, 49, 1, 26, 25, 26, 1, 50, 50, 50, 50, 50, 50, 50, 50, 1,
-                       51, 52, 1, 53, 54, 55, 56, 56, 57, 53, 1, 58, 1, 53, 54, 56, 56, 57, 53, 58, 1, 59, 59, 60, 1, 60, 1, 53, 54, 57, 53,
-                       60, 1, 53, 54, 55, 56, 56, 57, 53, 52, 1, 61, 1, 62, 1, 63, 1, 64, 65, 66, 64, 1, 67, 67, 67, 67, 67, 67, 67, 67, 1, 68,
-                       69, 70, 71, 72, 74, 75, 76, 77, 68, 73, 1, 79, 80, 78, 82, 83, 81, 84, 70, 75, 84, 1, 70, 69, 71, 72, 74, 76, 77, 70,
-                       73, 1, 85, 86, 1, 87, 88, 89, 90, 91, 90, 87, 1, 92, 1, 87, 88, 90, 91, 90, 87, 92, 1, 93, 93, 94, 1, 94, 1, 87, 88, 91,
-                       87, 94, 1, 87, 88, 89, 90, 91, 90, 87, 86, 1, 95, 1, 96, 1, 97, 1, 98, 99, 100, 98, 1, 101, 101, 101, 101, 101, 101,
-                       101, 101, 1, 102, 102, 1, 103, 104, 105, 105, 103, 1, 103, 105, 105, 103, 18, 1, 103, 103, 20, 1, 103, 104, 105, 105,
-                       103, 17, 1, 106, 106, 1, 1, 1, 0
-                      };
-}
-
-char* JsonReader::init__json_trans_targs_0 () {
-    return new byte[] {1, 0, 2, 5, 54, 57, 53, 9, 53, 3, 53, 4, 3, 53, 4, 3, 54, 57, 55, 8, 56, 10, 11, 58, 12, 13, 20, 59, 14,
-                       15, 34, 14, 15, 34, 15, 16, 17, 22, 23, 29, 19, 30, 19, 18, 19, 21, 18, 19, 21, 19, 18, 23, 29, 19, 20, 24, 26, 59, 25,
-                       27, 28, 31, 32, 33, 19, 20, 59, 14, 35, 36, 39, 40, 41, 47, 38, 60, 48, 38, 37, 38, 52, 37, 38, 52, 38, 41, 47, 38, 39,
-                       42, 44, 60, 43, 45, 46, 49, 50, 51, 38, 39, 60, 37, 53, 53, 6, 7, 53
-                      };
-}
-
-char* JsonReader::init__json_trans_actions_0 () {
-    return new byte[] {0, 0, 0, 1, 1, 1, 17, 0, 13, 1, 24, 1, 0, 7, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 15, 1, 21, 1, 0, 5,
-                       0, 0, 0, 0, 1, 1, 1, 17, 0, 13, 1, 24, 1, 0, 7, 0, 0, 3, 0, 0, 9, 9, 0, 0, 27, 0, 0, 0, 0, 0, 0, 11, 11, 33, 3, 0, 0, 0,
-                       1, 1, 1, 17, 19, 0, 13, 1, 24, 1, 0, 7, 0, 0, 0, 0, 9, 9, 0, 0, 30, 0, 0, 0, 0, 0, 0, 11, 11, 36, 3, 0, 9, 0, 0, 11
-                      };
-}
-
-char* JsonReader::init__json_eof_actions_0 () {
-    return new byte[] {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
-                       0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 9, 9, 9, 9, 11, 0, 0
-                      };
-}
-
-void JsonReader::set (const std::string& name,const Object& value) {
-    if (current instanceof ObjectMap)
-        ((ObjectMap)current).put(name, value);
-    else if (current instanceof Array)
-        ((Array)current).add(value);
-    else
-        root = value;
-}
-
-void JsonReader::startObject (const std::string& name) {
-    ObjectMap value = new ObjectMap();
-    if (current != null) set(name, value);
-    elements.add(value);
-    current = value;
-}
-
-void JsonReader::startArray (const std::string& name) {
-    Array value = new Array();
-    if (current != null) set(name, value);
-    elements.add(value);
-    current = value;
-}
-
-void JsonReader::pop () {
-    root = elements.pop();
-    current = elements.size > 0 ? elements.peek() : null;
-}
-
-void JsonReader::string (const std::string& name,const std::string& value) {
-    set(name, value);
-}
-
-void JsonReader::number (const std::string& name,const std::string& value) {
-    set(name, value);
-}
-
-std::string& JsonReader::unescape (const std::string& value) {
-    int length = value.length();
-    StringBuilder buffer = new StringBuilder(length + 16);
-    for (int i = 0; i < length;) {
-        char c = value.charAt(i++);
-        if (c != '\\') {
-            buffer.append(c);
-            continue;
-        }
-        if (i == length) break;
-        c = value.charAt(i++);
-        if (c == 'u') {
-            buffer.append(Character.toChars(Integer.parseInt(value.substring(i, i + 4), 16)));
-            i += 4;
-            continue;
-        }
-        switch (c) {
-        case '"':
-        case '\\':
-        case '/':
-            break;
-        case 'b':
-            c = '\b';
-            break;
-        case 'f':
-            c = '\f';
-            break;
-        case 'n':
-            c = '\n';
-            break;
-        case 'r':
-            c = '\r';
-            break;
-        case 't':
-            c = '\t';
-            break;
-        default:
-            throw new SerializationException("Illegal escaped character: \\" + c);
-        }
-        buffer.append(c);
-    }
-    return buffer.toString();
-}
-
+
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    @author Victor Vicente de Carvalho victor.carvalho@aevumlab.com
+    @author Ozires Bortolon de Faria ozires@aevumlab.com
+*/
+
+
+#include "JsonReader.hpp"
+#include "LinearAllocator.hpp"
+#include "gdx-cpp/files/MappedFile.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <locale>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <stdint.h>
+
+using namespace gdx_cpp::utils;
+
+static const double powersOf10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static bool isDigit (char c) {
+    return (unsigned char) (c - '0') < 10;
+}
+
+static int hexValue (char c) {
+    if (isDigit(c)) return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/** Sets the high bit of the bytes of v that are 0. Only the lowest flagged byte is exact, which is all the scan needs
+ * to know where to look. */
+static uint64_t zeroBytes (uint64_t v) {
+    return (v - UINT64_C(0x0101010101010101)) & ~v & UINT64_C(0x8080808080808080);
+}
+
+/** Skips to the first '"' or '\\' at or after p, eight bytes at a time. Returns end if there is none. */
+static const char* findQuoteOrEscape (const char* p, const char* end) {
+    while (end - p >= 8) {
+        uint64_t chunk;
+        std::memcpy(&chunk, p, 8);
+        if (zeroBytes(chunk ^ UINT64_C(0x2222222222222222)) | zeroBytes(chunk ^ UINT64_C(0x5c5c5c5c5c5c5c5c))) break;
+        p += 8;
+    }
+    while (p != end && *p != '"' && *p != '\\')
+        p++;
+    return p;
+}
+
+static char* writeUtf8 (char* out, uint32_t codePoint) {
+    if (codePoint < 0x80) {
+        *out++ = (char) codePoint;
+    } else if (codePoint < 0x800) {
+        *out++ = (char) (0xc0 | (codePoint >> 6));
+        *out++ = (char) (0x80 | (codePoint & 0x3f));
+    } else if (codePoint < 0x10000) {
+        *out++ = (char) (0xe0 | (codePoint >> 12));
+        *out++ = (char) (0x80 | ((codePoint >> 6) & 0x3f));
+        *out++ = (char) (0x80 | (codePoint & 0x3f));
+    } else {
+        *out++ = (char) (0xf0 | (codePoint >> 18));
+        *out++ = (char) (0x80 | ((codePoint >> 12) & 0x3f));
+        *out++ = (char) (0x80 | ((codePoint >> 6) & 0x3f));
+        *out++ = (char) (0x80 | (codePoint & 0x3f));
+    }
+    return out;
+}
+
+double JsonValue::asDouble () const {
+    switch (type) {
+    case numberValue:
+    case booleanValue:
+        return number;
+    case stringValue:
+        return JsonReader::parseNumber(text.begin(), text.end());
+    default:
+        return 0;
+    }
+}
+
+float JsonValue::asFloat () const {
+    return (float) asDouble();
+}
+
+int JsonValue::asInt () const {
+    return (int) asDouble();
+}
+
+long long JsonValue::asLong () const {
+    return (long long) asDouble();
+}
+
+bool JsonValue::asBoolean () const {
+    switch (type) {
+    case numberValue:
+    case booleanValue:
+        return number != 0;
+    case stringValue:
+        return text == StringView("true");
+    default:
+        return false;
+    }
+}
+
+const JsonValue* JsonValue::get (const StringView& name) const {
+    for (const JsonValue* child = firstChild; child != NULL; child = child->sibling)
+        if (child->name == name) return child;
+    return NULL;
+}
+
+const JsonValue* JsonValue::get (int index) const {
+    if (index < 0) return NULL;
+    const JsonValue* child = firstChild;
+    for (; child != NULL && index > 0; index--)
+        child = child->sibling;
+    return child;
+}
+
+StringView JsonValue::getString (const StringView& name, const StringView& defaultValue) const {
+    const JsonValue* child = get(name);
+    return child != NULL ? child->text : defaultValue;
+}
+
+float JsonValue::getFloat (const StringView& name, float defaultValue) const {
+    const JsonValue* child = get(name);
+    return child != NULL ? child->asFloat() : defaultValue;
+}
+
+int JsonValue::getInt (const StringView& name, int defaultValue) const {
+    const JsonValue* child = get(name);
+    return child != NULL ? child->asInt() : defaultValue;
+}
+
+bool JsonValue::getBoolean (const StringView& name, bool defaultValue) const {
+    const JsonValue* child = get(name);
+    return child != NULL ? child->asBoolean() : defaultValue;
+}
+
+/** Links the values into a tree as they are parsed */
+class JsonReader::DomBuilder {
+public:
+    DomBuilder (JsonReader& reader, LinearAllocator& arena)
+    : reader(reader)
+    , arena(arena)
+    , root(NULL)
+    {
+        reader.parents.clear();
+        reader.lastChildren.clear();
+    }
+
+    void startObject (const StringView& name) {
+        open(add(JsonValue::objectValue, name, StringView()));
+    }
+
+    void startArray (const StringView& name) {
+        open(add(JsonValue::arrayValue, name, StringView()));
+    }
+
+    void pop () {
+        reader.parents.pop_back();
+        reader.lastChildren.pop_back();
+    }
+
+    void string (const StringView& name, const StringView& value) {
+        add(JsonValue::stringValue, name, value);
+    }
+
+    void number (const StringView& name, double value, const StringView& text) {
+        add(JsonValue::numberValue, name, text)->number = value;
+    }
+
+    void boolean (const StringView& name, bool value, const StringView& text) {
+        add(JsonValue::booleanValue, name, text)->number = value ? 1 : 0;
+    }
+
+    void null (const StringView& name, const StringView& text) {
+        add(JsonValue::nullValue, name, text);
+    }
+
+    /** Unescaped names and strings are kept in the arena with the values */
+    char* nameBuffer (size_t length) {
+        return static_cast<char*>(arena.allocate(length, 1));
+    }
+
+    char* stringBuffer (size_t length) {
+        return static_cast<char*>(arena.allocate(length, 1));
+    }
+
+    JsonReader& reader;
+    LinearAllocator& arena;
+    JsonValue* root;
+
+private:
+    JsonValue* add (JsonValue::Type type, const StringView& name, const StringView& text) {
+        JsonValue* value = static_cast<JsonValue*>(arena.allocate(sizeof(JsonValue), alignof(JsonValue)));
+        value->type = type;
+        value->count = 0;
+        value->name = name;
+        value->text = text;
+        value->number = 0;
+        value->firstChild = NULL;
+        value->sibling = NULL;
+
+        if (reader.parents.empty()) {
+            root = value;
+        } else {
+            JsonValue* parent = reader.parents.back();
+            JsonValue*& last = reader.lastChildren.back();
+            if (last == NULL) parent->firstChild = value;
+            else last->sibling = value;
+            last = value;
+            parent->count++;
+        }
+        return value;
+    }
+
+    void open (JsonValue* value) {
+        reader.parents.push_back(value);
+        reader.lastChildren.push_back(NULL);
+    }
+};
+
+/** Forwards the values to a JsonHandler */
+class JsonReader::SaxBuilder {
+public:
+    SaxBuilder (JsonReader& reader, JsonHandler& handler)
+    : reader(reader)
+    , handler(handler)
+    {
+    }
+
+    void startObject (const StringView& name) {
+        handler.startObject(name);
+    }
+
+    void startArray (const StringView& name) {
+        handler.startArray(name);
+    }
+
+    void pop () {
+        handler.pop();
+    }
+
+    void string (const StringView& name, const StringView& value) {
+        handler.string(name, value);
+    }
+
+    void number (const StringView& name, double value, const StringView& text) {
+        handler.number(name, value, text);
+    }
+
+    void boolean (const StringView& name, bool value, const StringView&) {
+        handler.boolean(name, value);
+    }
+
+    void null (const StringView& name, const StringView&) {
+        handler.null(name);
+    }
+
+    /** A name is still needed while its value is unescaped, so they get separate buffers */
+    char* nameBuffer (size_t length) {
+        if (reader.nameScratch.size() < length) reader.nameScratch.resize(length);
+        return &reader.nameScratch[0];
+    }
+
+    char* stringBuffer (size_t length) {
+        if (reader.stringScratch.size() < length) reader.stringScratch.resize(length);
+        return &reader.stringScratch[0];
+    }
+
+    JsonReader& reader;
+    JsonHandler& handler;
+};
+
+namespace {
+
+/** The cursor over the text and the pieces of syntax shared by both builders */
+class Scanner {
+public:
+    Scanner (const char* begin, const char* end)
+    : p(begin)
+    , begin(begin)
+    , end(end)
+    {
+    }
+
+    void error (const char* message) const {
+        int line = 1;
+        const char* lineStart = begin;
+        for (const char* c = begin; c < p; c++) {
+            if (*c == '\n') {
+                line++;
+                lineStart = c + 1;
+            }
+        }
+        std::ostringstream out;
+        out << "Error parsing JSON on line " << line << " near column " << (p - lineStart + 1) << ": " << message;
+        throw std::runtime_error(out.str());
+    }
+
+    /** Skips whitespace and comments, returns false at the end of the text */
+    bool skipWhitespace () {
+        while (p != end) {
+            char c = *p;
+            if (c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+                p++;
+            } else if (c == '/' && end - p >= 2 && p[1] == '/') {
+                while (p != end && *p != '\n')
+                    p++;
+            } else if (c == '/' && end - p >= 2 && p[1] == '*') {
+                p += 2;
+                while (true) {
+                    if (end - p < 2) error("Unterminated comment");
+                    if (p[0] == '*' && p[1] == '/') break;
+                    p++;
+                }
+                p += 2;
+            } else {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    char peek () {
+        if (!skipWhitespace()) error("Unexpected end of document");
+        return *p;
+    }
+
+    void expect (char c) {
+        if (peek() != c) {
+            char message[] = "Expected ' '";
+            message[10] = c;
+            error(message);
+        }
+        p++;
+    }
+
+    /** Reads the string starting at the quote under the cursor. Strings without escapes are returned in place, others
+     * are unescaped into buffer(length). */
+    template < class Buffer >
+    StringView string (Buffer buffer) {
+        const char* start = ++p;
+        p = findQuoteOrEscape(p, end);
+        if (p == end) error("Unterminated string");
+        if (*p == '"') return StringView(start, p++ - start);
+
+        // find the end first, the unescaped string is never longer
+        const char* escape = p;
+        while (true) {
+            p = findQuoteOrEscape(p, end);
+            if (p == end) error("Unterminated string");
+            if (*p == '"') break;
+            if (end - p < 2) error("Unterminated string");
+            p += 2;
+        }
+        const char* stringEnd = p++;
+
+        char* out = buffer(stringEnd - start);
+        char* o = out;
+        std::memcpy(o, start, escape - start);
+        o += escape - start;
+        const char* s = escape;
+        while (s != stringEnd) {
+            if (*s != '\\') {
+                *o++ = *s++;
+                continue;
+            }
+            s++;
+            switch (*s++) {
+            case '"': *o++ = '"'; break;
+            case '\\': *o++ = '\\'; break;
+            case '/': *o++ = '/'; break;
+            case 'b': *o++ = '\b'; break;
+            case 'f': *o++ = '\f'; break;
+            case 'n': *o++ = '\n'; break;
+            case 'r': *o++ = '\r'; break;
+            case 't': *o++ = '\t'; break;
+            case 'u': {
+                uint32_t codePoint = hex4(s, stringEnd);
+                s += 4;
+                if (codePoint >= 0xd800 && codePoint < 0xdc00 && stringEnd - s >= 6 && s[0] == '\\' && s[1] == 'u') {
+                    uint32_t low = hex4(s + 2, stringEnd);
+                    if (low >= 0xdc00 && low < 0xe000) {
+                        codePoint = 0x10000 + ((codePoint - 0xd800) << 10) + (low - 0xdc00);
+                        s += 6;
+                    }
+                }
+                o = writeUtf8(o, codePoint);
+                break;
+            }
+            default:
+                p = s - 1;
+                error("Invalid escape");
+            }
+        }
+        return StringView(out, o - out);
+    }
+
+    /** Reads the number under the cursor */
+    StringView number (double& value) {
+        const char* start = p;
+        if (p != end && *p == '-') p++;
+        const char* digits = p;
+        while (p != end && isDigit(*p))
+            p++;
+        if (p == digits) error("Invalid number");
+        if (p != end && *p == '.') {
+            const char* fraction = ++p;
+            while (p != end && isDigit(*p))
+                p++;
+            if (p == fraction) error("Invalid number");
+        }
+        if (p != end && (*p == 'e' || *p == 'E')) {
+            p++;
+            if (p != end && (*p == '+' || *p == '-')) p++;
+            const char* exponent = p;
+            while (p != end && isDigit(*p))
+                p++;
+            if (p == exponent) error("Invalid number");
+        }
+        value = JsonReader::parseNumber(start, p);
+        return StringView(start, p - start);
+    }
+
+    /** Reads true, false or null, whichever starts under the cursor */
+    StringView literal (const char* word, size_t length) {
+        if ((size_t) (end - p) < length || std::memcmp(p, word, length) != 0) error("Unexpected character");
+        StringView text(p, length);
+        p += length;
+        return text;
+    }
+
+    const char* p;
+    const char* begin;
+    const char* end;
+
+private:
+    uint32_t hex4 (const char* s, const char* stringEnd) {
+        if (stringEnd - s < 4) error("Invalid unicode escape");
+        uint32_t value = 0;
+        for (int i = 0; i < 4; i++) {
+            int digit = hexValue(s[i]);
+            if (digit < 0) error("Invalid unicode escape");
+            value = (value << 4) | digit;
+        }
+        return value;
+    }
+};
+
+template < class Builder >
+struct NameBuffer {
+    Builder* builder;
+    char* operator() (size_t length) const {
+        return builder->nameBuffer(length);
+    }
+};
+
+template < class Builder >
+struct StringBuffer {
+    Builder* builder;
+    char* operator() (size_t length) const {
+        return builder->stringBuffer(length);
+    }
+};
+
+}
+
+double JsonReader::parseNumber (const char* begin, const char* end) {
+    const char* p = begin;
+    bool negative = p != end && *p == '-';
+    if (negative) p++;
+
+    // up to 19 digits fit the mantissa; if it also fits a double exactly and the power of ten is exact, one multiply or
+    // divide is correctly rounded
+    uint64_t mantissa = 0;
+    int digits = 0, exponent = 0;
+    bool dropped = false;
+    while (p != end && isDigit(*p)) {
+        if (digits < 19) {
+            mantissa = mantissa * 10 + (*p - '0');
+            if (mantissa != 0) digits++;
+        } else {
+            exponent++;
+            dropped = true;
+        }
+        p++;
+    }
+    if (p != end && *p == '.') {
+        p++;
+        while (p != end && isDigit(*p)) {
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (*p - '0');
+                if (mantissa != 0) digits++;
+                exponent--;
+            } else {
+                dropped = true;
+            }
+            p++;
+        }
+    }
+    if (p != end && (*p == 'e' || *p == 'E')) {
+        p++;
+        bool negativeExponent = p != end && *p == '-';
+        if (p != end && (*p == '+' || *p == '-')) p++;
+        int written = 0;
+        while (p != end && isDigit(*p)) {
+            if (written < 100000) written = written * 10 + (*p - '0');
+            p++;
+        }
+        exponent += negativeExponent ? -written : written;
+    }
+
+    if (!dropped && mantissa <= (UINT64_C(1) << 53) && exponent >= -22 && exponent <= 22) {
+        double value = (double) mantissa;
+        value = exponent < 0 ? value / powersOf10[-exponent] : value * powersOf10[exponent];
+        return negative ? -value : value;
+    }
+
+    // rare: long mantissas and big exponents go through the stream, with the classic locale so ',' is never the point
+    std::istringstream in(std::string(begin, end - begin));
+    in.imbue(std::locale::classic());
+    double value = 0;
+    in >> value;
+    // out of range the stream fails and clamps to the largest double, strtod returns infinity with the sign
+    if (in.fail() && value != 0) return value < 0 ? -HUGE_VAL : HUGE_VAL;
+    return value;
+}
+
+JsonReader::JsonReader () {
+}
+
+template < class Builder >
+void JsonReader::parseDocument (const char* json, size_t length, Builder& builder) {
+    Scanner scanner(json, json + length);
+    if (length >= 3 && std::memcmp(json, "\xef\xbb\xbf", 3) == 0) scanner.p += 3;
+
+    NameBuffer<Builder> nameBuffer = { &builder };
+    StringBuffer<Builder> stringBuffer = { &builder };
+
+    containers.clear();
+    bool inObject = false;
+    while (true) {
+        StringView name;
+        if (inObject) {
+            if (scanner.peek() != '"') scanner.error("Expected a name");
+            name = scanner.string(nameBuffer);
+            scanner.expect(':');
+        }
+
+        bool closed = true;
+        switch (scanner.peek()) {
+        case '{':
+        case '[': {
+            char open = *scanner.p++;
+            if (open == '{') builder.startObject(name);
+            else builder.startArray(name);
+            if (scanner.peek() == (open == '{' ? '}' : ']')) {
+                scanner.p++;
+                builder.pop();
+            } else {
+                containers.push_back(open);
+                inObject = open == '{';
+                closed = false;
+            }
+            break;
+        }
+        case '"':
+            builder.string(name, scanner.string(stringBuffer));
+            break;
+        case 't':
+            builder.boolean(name, true, scanner.literal("true", 4));
+            break;
+        case 'f':
+            builder.boolean(name, false, scanner.literal("false", 5));
+            break;
+        case 'n':
+            builder.null(name, scanner.literal("null", 4));
+            break;
+        default: {
+            char c = *scanner.p;
+            if (c != '-' && !isDigit(c)) scanner.error("Unexpected character");
+            double value;
+            StringView text = scanner.number(value);
+            builder.number(name, value, text);
+        }
+        }
+        if (!closed) continue;
+
+        // after a value: close containers until one continues with another value
+        while (true) {
+            if (containers.empty()) {
+                if (scanner.skipWhitespace()) scanner.error("Unexpected characters after the document");
+                return;
+            }
+            char close = containers.back() == '{' ? '}' : ']';
+            char c = scanner.peek();
+            if (c == ',') {
+                scanner.p++;
+                // a trailing comma
+                if (scanner.peek() != close) break;
+                c = close;
+            }
+            if (c != close) scanner.error(close == '}' ? "Expected ',' or '}'" : "Expected ',' or ']'");
+            scanner.p++;
+            containers.pop_back();
+            builder.pop();
+        }
+        inObject = containers.back() == '{';
+    }
+}
+
+const JsonValue* JsonReader::parse (const char* json, size_t length, LinearAllocator& arena) {
+    DomBuilder builder(*this, arena);
+    parseDocument(json, length, builder);
+    return builder.root;
+}
+
+const JsonValue* JsonReader::parse (const std::string& json, LinearAllocator& arena) {
+    return parse(json.data(), json.size(), arena);
+}
+
+const JsonValue* JsonReader::parse (const files::MappedFile& file, LinearAllocator& arena) {
+    return parse(file.getData(), file.getSize(), arena);
+}
+
+void JsonReader::parse (const char* json, size_t length, JsonHandler& handler) {
+    SaxBuilder builder(*this, handler);
+    parseDocument(json, length, builder);
+}
+
+void JsonReader::parse (const files::MappedFile& file, JsonHandler& handler) {
+    parse(file.getData(), file.getSize(), handler);
+}
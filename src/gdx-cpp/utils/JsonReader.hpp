@@ -18,40 +18,177 @@
     @author Ozires Bortolon de Faria ozires@aevumlab.com
 */
 
+
 #ifndef GDX_CPP_UTILS_JSONREADER_HPP_
 #define GDX_CPP_UTILS_JSONREADER_HPP_
 
+#include "StringView.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
 namespace gdx_cpp {
+
+namespace files {
+class MappedFile;
+}
+
 namespace utils {
 
+class LinearAllocator;
+
+/** A node of a parsed JSON document. Values live in the LinearAllocator the document was parsed into and are released
+ * with it, never individually. Their names and strings point into the parsed text unless they contained escapes, so
+ * the text has to stay around as long as the values are used. */
+class JsonValue {
+public:
+    enum Type {
+        nullValue, booleanValue, numberValue, stringValue, arrayValue, objectValue
+    };
+
+    Type getType () const {
+        return type;
+    }
+
+    bool isNull () const {
+        return type == nullValue;
+    }
+
+    bool isBoolean () const {
+        return type == booleanValue;
+    }
+
+    bool isNumber () const {
+        return type == numberValue;
+    }
+
+    bool isString () const {
+        return type == stringValue;
+    }
+
+    bool isArray () const {
+        return type == arrayValue;
+    }
+
+    bool isObject () const {
+        return type == objectValue;
+    }
+
+    /** The key of this value in its object, empty for array elements and the root */
+    const StringView& getName () const {
+        return name;
+    }
+
+    /** The characters of a string, or the source text of a number, boolean or null */
+    const StringView& asString () const {
+        return text;
+    }
+
+    /** Strings are converted, booleans are 0 or 1 */
+    double asDouble () const;
+    float asFloat () const;
+    int asInt () const;
+    long long asLong () const;
+    /** Numbers are true if not 0, strings if they are "true" */
+    bool asBoolean () const;
+
+    /** The number of children of an object or array */
+    int size () const {
+        return count;
+    }
+
+    /** The first child of an object or array, NULL if it is empty */
+    const JsonValue* child () const {
+        return firstChild;
+    }
+
+    /** The following child of the same parent, NULL after the last */
+    const JsonValue* next () const {
+        return sibling;
+    }
+
+    /** The first child with the name, NULL if there is none. Walks the children. */
+    const JsonValue* get (const StringView& name) const;
+    /** The child at the index, NULL if out of range. Walks the children. */
+    const JsonValue* get (int index) const;
+
+    StringView getString (const StringView& name, const StringView& defaultValue = StringView()) const;
+    float getFloat (const StringView& name, float defaultValue = 0) const;
+    int getInt (const StringView& name, int defaultValue = 0) const;
+    bool getBoolean (const StringView& name, bool defaultValue = false) const;
+
+private:
+    friend class JsonReader;
+
+    Type type;
+    int count;
+    StringView name;
+    StringView text;
+    double number;
+    JsonValue* firstChild;
+    JsonValue* sibling;
+};
+
+/** Receives a document from JsonReader as it is parsed, without building any JsonValues, for files too big to hold as
+ * a tree. Names and strings are only valid during the call. Every startObject and startArray is matched by a pop. */
+class JsonHandler {
+public:
+    virtual ~JsonHandler () {}
+
+    virtual void startObject (const StringView& name) {}
+    virtual void startArray (const StringView& name) {}
+    /** Ends the innermost object or array */
+    virtual void pop () {}
+    virtual void string (const StringView& name, const StringView& value) {}
+    /** text is the number as written in the document */
+    virtual void number (const StringView& name, double value, const StringView& text) {}
+    virtual void boolean (const StringView& name, bool value) {}
+    virtual void null (const StringView& name) {}
+};
+
+/** Parses JSON in place: strings are views into the text and values are bump allocated from a LinearAllocator, so a
+ * document costs one pass over the text and no heap allocations once the reader's stacks have grown. Besides strict
+ * JSON, comments and trailing commas are accepted as they show up in hand written skins.
+ *
+ * Syntax errors throw std::runtime_error with the line and column. A reader keeps its stacks between documents, so
+ * reuse it but don't share it between threads. */
 class JsonReader {
 public:
-    Object& parse (const std::string& json);
-    Object& parse (const Reader& reader);
-    Object& parse (const InputStream& input);
-    Object& parse (const gdx_cpp::files::FileHandle& file);
-    Object& parse (int offset,int length);
-
-protected:
-    void startObject (const std::string& name);
-    void startArray (const std::string& name);
-    void pop ();
-    void string (const std::string& name,const std::string& value);
-    void number (const std::string& name,const std::string& value);
+    JsonReader ();
+
+    /** Parses the document into values allocated from arena and returns the root. The text has to outlive the
+     * values. */
+    const JsonValue* parse (const char* json, size_t length, LinearAllocator& arena);
+    const JsonValue* parse (const std::string& json, LinearAllocator& arena);
+    /** The file has to stay mapped as long as the values are used */
+    const JsonValue* parse (const files::MappedFile& file, LinearAllocator& arena);
+
+    /** Reports the document to the handler as it is parsed */
+    void parse (const char* json, size_t length, JsonHandler& handler);
+    void parse (const files::MappedFile& file, JsonHandler& handler);
+
+    /** Parses a JSON number, used for numbers written as strings as well */
+    static double parseNumber (const char* begin, const char* end);
 
 private:
-    static char* init__json_actions_0 ();
-    static short* init__json_key_offsets_0 ();
-    static char* init__json_trans_keys_0 ();
-    static char* init__json_single_lengths_0 ();
-    static char* init__json_range_lengths_0 ();
-    static short* init__json_index_offsets_0 ();
-    static char* init__json_indicies_0 ();
-    static char* init__json_trans_targs_0 ();
-    static char* init__json_trans_actions_0 ();
-    static char* init__json_eof_actions_0 ();
-    void set (const std::string& name,const Object& value);
-    std::string& unescape (const std::string& value);
+    class DomBuilder;
+    class SaxBuilder;
+
+    template < class Builder >
+    void parseDocument (const char* json, size_t length, Builder& builder);
+
+    JsonReader (const JsonReader&);
+    JsonReader& operator= (const JsonReader&);
+
+    /** '{' or '[' for each open object or array */
+    std::vector<char> containers;
+    /** open objects and arrays with their last child so far, for building the tree */
+    std::vector<JsonValue*> parents;
+    std::vector<JsonValue*> lastChildren;
+    /** unescaped names and strings for the handler */
+    std::string nameScratch;
+    std::string stringScratch;
 };
 
 } // namespace gdx_cpp
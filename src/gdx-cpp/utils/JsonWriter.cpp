@@ -18,112 +18,238 @@
     @author Ozires Bortolon de Faria ozires@aevumlab.com
 */
 
-#include "JsonWriter.hpp"
-
-using namespace gdx_cpp::utils;
-
-JsonWriter& JsonWriter::object () throws IOException {
-    if (current != null) {
-        if (!current.array) throw new RuntimeException("Current item must be an array.");
-        if (!current.needsComma)
-            current.needsComma = true;
-        else
-            writer.write(",");
-    }
-    stack.push(current = new JsonObject(false));
-    return this;
-}
-
-JsonWriter& JsonWriter::array () throws IOException {
-    if (current != null) {
-        if (!current.array) throw new RuntimeException("Current item must be an array.");
-        if (!current.needsComma)
-            current.needsComma = true;
-        else
-            writer.write(",");
-    }
-    stack.push(current = new JsonObject(true));
-    return this;
-}
-
-JsonWriter& JsonWriter::add (const Object& value) throws IOException {
-    if (!current.array) throw new RuntimeException("Current item must be an array.");
-    if (!current.needsComma)
-        current.needsComma = true;
-    else
-        writer.write(",");
-    if (value == null || value instanceof Number || value instanceof Boolean)
-        writer.write(String.valueOf(value));
-    else {
-        writer.write("\"");
-        writer.write(value.toString());
-        writer.write("\"");
-    }
-    return this;
-}
-
-JsonWriter& JsonWriter::object (const std::string& name) throws IOException {
-    if (current == null || current.array) throw new RuntimeException("Current item must be an object.");
-    if (!current.needsComma)
-        current.needsComma = true;
-    else
-        writer.write(",");
-    writer.write("\"");
-    writer.write(name);
-    writer.write("\":");
-    stack.push(current = new JsonObject(false));
-    return this;
-}
-
-JsonWriter& JsonWriter::array (const std::string& name) throws IOException {
-    if (current == null || current.array) throw new RuntimeException("Current item must be an object.");
-    if (!current.needsComma)
-        current.needsComma = true;
-    else
-        writer.write(",");
-    writer.write("\"");
-    writer.write(name);
-    writer.write("\":");
-    stack.push(current = new JsonObject(true));
-    return this;
-}
-
-JsonWriter& JsonWriter::set (const std::string& name,const Object& value) throws IOException {
-    if (current == null || current.array) throw new RuntimeException("Current item must be an object.");
-    if (!current.needsComma)
-        current.needsComma = true;
-    else
-        writer.write(",");
-    writer.write("\"");
-    writer.write(name);
-    if (value == null || value instanceof Number || value instanceof Boolean) {
-        writer.write("\":");
-        writer.write(String.valueOf(value));
-    } else {
-        writer.write("\":\"");
-        writer.write(value.toString());
-        writer.write("\"");
-    }
-    return this;
-}
-
-JsonWriter& JsonWriter::pop () throws IOException {
-    stack.pop().close();
-    current = stack.peek();
-    return this;
-}
-
-void JsonWriter::write (int off,int len) throws IOException {
-    writer.write(cbuf, off, len);
-}
-
-void JsonWriter::flush () throws IOException {
-    writer.flush();
-}
-
-void JsonWriter::close () throws IOException {
-    while (!stack.isEmpty())
-        pop();
-    writer.close();
-}
-
+
+#include "JsonWriter.hpp"
+#include "WriteBuffer.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+using namespace gdx_cpp::utils;
+
+/** For each byte, 0 if it is copied as it is, else the character after the backslash, 'u' for \u00XX */
+static const struct EscapeTable {
+    EscapeTable () {
+        for (int i = 0; i < 256; i++)
+            escapes[i] = i < 0x20 ? 'u' : 0;
+        escapes[(unsigned char) '"'] = '"';
+        escapes[(unsigned char) '\\'] = '\\';
+        escapes[(unsigned char) '\b'] = 'b';
+        escapes[(unsigned char) '\f'] = 'f';
+        escapes[(unsigned char) '\n'] = 'n';
+        escapes[(unsigned char) '\r'] = 'r';
+        escapes[(unsigned char) '\t'] = 't';
+    }
+
+    char escapes[256];
+} escapeTable;
+
+JsonWriter::JsonWriter (WriteBuffer& out)
+: out(out)
+, needsComma(false)
+{
+}
+
+void JsonWriter::writeString (WriteBuffer& out, const StringView& value) {
+    out.append('"');
+    const char* run = value.begin();
+    for (const char* c = value.begin(); c != value.end(); c++) {
+        char escape = escapeTable.escapes[(unsigned char) *c];
+        if (escape == 0) continue;
+
+        // the characters up to here are copied as one piece
+        out.append(run, c - run);
+        run = c + 1;
+        char* p = out.reserve(6);
+        p[0] = '\\';
+        p[1] = escape;
+        if (escape != 'u') {
+            out.commit(2);
+        } else {
+            p[2] = '0';
+            p[3] = '0';
+            p[4] = "0123456789abcdef"[(*c >> 4) & 0xf];
+            p[5] = "0123456789abcdef"[*c & 0xf];
+            out.commit(6);
+        }
+    }
+    out.append(run, value.end() - run);
+    out.append('"');
+}
+
+void JsonWriter::beforeValue () {
+    if (arrays.empty()) {
+        if (needsComma) throw std::runtime_error("A JSON document has only one root value.");
+    } else {
+        if (!arrays.back()) throw std::runtime_error("Current item must be an array.");
+        if (needsComma) out.append(',');
+    }
+    needsComma = true;
+}
+
+void JsonWriter::beforeName (const StringView& name) {
+    if (arrays.empty() || arrays.back()) throw std::runtime_error("Current item must be an object.");
+    if (needsComma) out.append(',');
+    needsComma = true;
+    writeString(out, name);
+    out.append(':');
+}
+
+void JsonWriter::number (double value) {
+    if (std::isfinite(value)) out.appendDouble(value);
+    else out.append("null", 4);
+}
+
+void JsonWriter::number (float value) {
+    if (std::isfinite(value)) out.appendFloat(value);
+    else out.append("null", 4);
+}
+
+JsonWriter& JsonWriter::object () {
+    beforeValue();
+    out.append('{');
+    arrays.push_back(false);
+    needsComma = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::array () {
+    beforeValue();
+    out.append('[');
+    arrays.push_back(true);
+    needsComma = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::object (const StringView& name) {
+    beforeName(name);
+    out.append('{');
+    arrays.push_back(false);
+    needsComma = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::array (const StringView& name) {
+    beforeName(name);
+    out.append('[');
+    arrays.push_back(true);
+    needsComma = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::add (const StringView& value) {
+    beforeValue();
+    writeString(out, value);
+    return *this;
+}
+
+JsonWriter& JsonWriter::add (const char* value) {
+    return add(StringView(value));
+}
+
+JsonWriter& JsonWriter::add (const std::string& value) {
+    return add(StringView(value));
+}
+
+JsonWriter& JsonWriter::add (double value) {
+    beforeValue();
+    number(value);
+    return *this;
+}
+
+JsonWriter& JsonWriter::add (float value) {
+    beforeValue();
+    number(value);
+    return *this;
+}
+
+JsonWriter& JsonWriter::add (int value) {
+    beforeValue();
+    out.appendInt(value);
+    return *this;
+}
+
+JsonWriter& JsonWriter::add (long long value) {
+    beforeValue();
+    out.appendInt(value);
+    return *this;
+}
+
+JsonWriter& JsonWriter::add (bool value) {
+    beforeValue();
+    if (value) out.append("true", 4);
+    else out.append("false", 5);
+    return *this;
+}
+
+JsonWriter& JsonWriter::addNull () {
+    beforeValue();
+    out.append("null", 4);
+    return *this;
+}
+
+JsonWriter& JsonWriter::set (const StringView& name, const StringView& value) {
+    beforeName(name);
+    writeString(out, value);
+    return *this;
+}
+
+JsonWriter& JsonWriter::set (const StringView& name, const char* value) {
+    return set(name, StringView(value));
+}
+
+JsonWriter& JsonWriter::set (const StringView& name, const std::string& value) {
+    return set(name, StringView(value));
+}
+
+JsonWriter& JsonWriter::set (const StringView& name, double value) {
+    beforeName(name);
+    number(value);
+    return *this;
+}
+
+JsonWriter& JsonWriter::set (const StringView& name, float value) {
+    beforeName(name);
+    number(value);
+    return *this;
+}
+
+JsonWriter& JsonWriter::set (const StringView& name, int value) {
+    beforeName(name);
+    out.appendInt(value);
+    return *this;
+}
+
+JsonWriter& JsonWriter::set (const StringView& name, long long value) {
+    beforeName(name);
+    out.appendInt(value);
+    return *this;
+}
+
+JsonWriter& JsonWriter::set (const StringView& name, bool value) {
+    beforeName(name);
+    if (value) out.append("true", 4);
+    else out.append("false", 5);
+    return *this;
+}
+
+JsonWriter& JsonWriter::setNull (const StringView& name) {
+    beforeName(name);
+    out.append("null", 4);
+    return *this;
+}
+
+JsonWriter& JsonWriter::pop () {
+    if (arrays.empty()) throw std::runtime_error("No object or array to pop.");
+    out.append(arrays.back() ? ']' : '}');
+    arrays.pop_back();
+    needsComma = true;
+    return *this;
+}
+
+void JsonWriter::close () {
+    while (!arrays.empty())
+        pop();
+    out.flush();
+    needsComma = false;
+}
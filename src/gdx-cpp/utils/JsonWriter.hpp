@@ -18,30 +18,70 @@
     @author Ozires Bortolon de Faria ozires@aevumlab.com
 */
 
+
 #ifndef GDX_CPP_UTILS_JSONWRITER_HPP_
 #define GDX_CPP_UTILS_JSONWRITER_HPP_
 
+#include "StringView.hpp"
+
+#include <string>
+#include <vector>
+
 namespace gdx_cpp {
 namespace utils {
 
+class WriteBuffer;
+
+/** Writes compact JSON straight into a WriteBuffer, escaping strings as they are copied. Values are added to arrays
+ * with add() and to objects with set(); using the wrong one throws std::runtime_error. Non finite numbers are written as
+ * null, which JSON has no other way to say. */
 class JsonWriter {
 public:
+    explicit JsonWriter (WriteBuffer& out);
+
     JsonWriter& object ();
     JsonWriter& array ();
-    JsonWriter& add (const Object& value);
-    JsonWriter& object (const std::string& name);
-    JsonWriter& array (const std::string& name);
-    JsonWriter& set (const std::string& name,const Object& value);
+    JsonWriter& object (const StringView& name);
+    JsonWriter& array (const StringView& name);
+
+    JsonWriter& add (const StringView& value);
+    JsonWriter& add (const char* value);
+    JsonWriter& add (const std::string& value);
+    JsonWriter& add (double value);
+    JsonWriter& add (float value);
+    JsonWriter& add (int value);
+    JsonWriter& add (long long value);
+    JsonWriter& add (bool value);
+    JsonWriter& addNull ();
+
+    JsonWriter& set (const StringView& name, const StringView& value);
+    JsonWriter& set (const StringView& name, const char* value);
+    JsonWriter& set (const StringView& name, const std::string& value);
+    JsonWriter& set (const StringView& name, double value);
+    JsonWriter& set (const StringView& name, float value);
+    JsonWriter& set (const StringView& name, int value);
+    JsonWriter& set (const StringView& name, long long value);
+    JsonWriter& set (const StringView& name, bool value);
+    JsonWriter& setNull (const StringView& name);
+
+    /** Ends the innermost object or array */
     JsonWriter& pop ();
-    void write (int off,int len);
-    void flush ();
+    /** Ends all open objects and arrays and flushes the buffer. The writer can start another document afterwards. */
     void close ();
 
-protected:
-
+    /** Appends value as a JSON string, quotes included */
+    static void writeString (WriteBuffer& out, const StringView& value);
 
 private:
+    void beforeValue ();
+    void beforeName (const StringView& name);
+    void number (double value);
+    void number (float value);
 
+    WriteBuffer& out;
+    /** true for each open array, false for objects */
+    std::vector<bool> arrays;
+    bool needsComma;
 };
 
 } // namespace gdx_cpp
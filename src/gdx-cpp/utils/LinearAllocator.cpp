@@ -0,0 +1,98 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "LinearAllocator.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+using namespace gdx_cpp::utils;
+
+LinearAllocator::LinearAllocator (size_t blockSize)
+: current(NULL)
+, top(NULL)
+, end(NULL)
+, usedBefore(0)
+, peak(0)
+{
+    pushBlock(blockSize);
+}
+
+LinearAllocator::~LinearAllocator () {
+    while (current != NULL) {
+        Block* previous = current->previous;
+        std::free(current);
+        current = previous;
+    }
+}
+
+void LinearAllocator::reset () {
+    peak = std::max(peak, getUsed());
+
+    if (current->previous != NULL) {
+        // the frame outgrew the block, next time a single one has to hold it all
+        size_t size = current->size;
+        while (size < peak)
+            size *= 2;
+        while (current != NULL) {
+            Block* previous = current->previous;
+            std::free(current);
+            current = previous;
+        }
+        pushBlock(size);
+    }
+
+    top = begin();
+    usedBefore = 0;
+}
+
+size_t LinearAllocator::getUsed () const {
+    return usedBefore + (top - begin());
+}
+
+size_t LinearAllocator::getPeak () const {
+    return std::max(peak, getUsed());
+}
+
+size_t LinearAllocator::getCapacity () const {
+    size_t capacity = 0;
+    for (Block* block = current; block != NULL; block = block->previous)
+        capacity += block->size;
+    return capacity;
+}
+
+void* LinearAllocator::allocateBlock (size_t size, size_t alignment) {
+    usedBefore += top - begin();
+    pushBlock(std::max(current->size * 2, size + alignment));
+    return allocate(size, alignment);
+}
+
+void LinearAllocator::pushBlock (size_t size) {
+    void* memory = std::malloc(headerSize + size);
+    if (memory == NULL) throw std::bad_alloc();
+
+    Block* block = static_cast<Block*>(memory);
+    block->previous = current;
+    block->size = size;
+    current = block;
+    top = begin();
+    end = top + size;
+}
+
+char* LinearAllocator::begin () const {
+    return reinterpret_cast<char*>(current) + headerSize;
+}
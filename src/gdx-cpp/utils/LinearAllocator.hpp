@@ -0,0 +1,135 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef GDX_CPP_UTILS_LINEARALLOCATOR_HPP_
+#define GDX_CPP_UTILS_LINEARALLOCATOR_HPP_
+
+#include <cstddef>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace gdx_cpp {
+namespace utils {
+
+/** Hands out memory by bumping a pointer through a block and takes it all back at once with reset().
+ *
+ * Meant for temporaries that die together, like everything a frame builds for itself. When the block runs out further
+ * blocks are chained on, and the next reset() replaces them with a single block big enough for the whole peak, so after
+ * the first few frames allocating never reaches the heap. Not thread safe, see FrameArena for one per thread. */
+class LinearAllocator {
+public:
+    explicit LinearAllocator (size_t blockSize = 64 * 1024);
+    ~LinearAllocator ();
+
+    /** @param alignment a power of two */
+    void* allocate (size_t size, size_t alignment = sizeof(void*)) {
+        uintptr_t aligned = ((uintptr_t) top + alignment - 1) & ~(uintptr_t) (alignment - 1);
+        if (aligned + size > (uintptr_t) end) return allocateBlock(size, alignment);
+        top = (char*) aligned + size;
+        return (void*) aligned;
+    }
+
+    /** Takes the memory back if it was the last allocation, otherwise it stays in use until reset() */
+    void deallocate (void* memory, size_t size) {
+        if ((char*) memory + size == top) top = (char*) memory;
+    }
+
+    /** Releases all allocations. Memory handed out before must not be used anymore. */
+    void reset ();
+
+    /** The bytes allocated since the last reset() */
+    size_t getUsed () const;
+
+    /** The most bytes that were in use at once */
+    size_t getPeak () const;
+
+    size_t getCapacity () const;
+
+private:
+    struct Block {
+        Block* previous;
+        size_t size;
+    };
+
+    /** the header is padded so the block's memory starts as aligned as malloc's */
+    static const size_t headerSize = (sizeof(Block) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+    LinearAllocator (const LinearAllocator&);
+    LinearAllocator& operator= (const LinearAllocator&);
+
+    void* allocateBlock (size_t size, size_t alignment);
+    void pushBlock (size_t size);
+    char* begin () const;
+
+    Block* current;
+    char* top;
+    char* end;
+    /** bytes used in the blocks before the current one */
+    size_t usedBefore;
+    size_t peak;
+};
+
+/** An STL allocator drawing from a LinearAllocator, so standard containers can be built as frame temporaries.
+ * Deallocation only gives memory back when it was the most recent allocation. A growing vector allocates its new
+ * buffer before it frees the old one, so every reallocation leaves the old buffer unused until the arena is reset;
+ * reserve() an ArenaVector to its final size up front. */
+template < class T >
+class ArenaAllocator {
+public:
+    typedef T value_type;
+
+    ArenaAllocator (LinearAllocator& arena)
+    : arena(&arena)
+    {
+    }
+
+    template < class U >
+    ArenaAllocator (const ArenaAllocator<U>& other)
+    : arena(other.arena)
+    {
+    }
+
+    T* allocate (size_t count) {
+        return static_cast<T*>(arena->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate (T* memory, size_t count) {
+        arena->deallocate(memory, count * sizeof(T));
+    }
+
+    template < class U >
+    bool operator== (const ArenaAllocator<U>& other) const {
+        return arena == other.arena;
+    }
+
+    template < class U >
+    bool operator!= (const ArenaAllocator<U>& other) const {
+        return arena != other.arena;
+    }
+
+    LinearAllocator* arena;
+};
+
+template < class T >
+using ArenaVector = std::vector< T, ArenaAllocator<T> >;
+
+typedef std::basic_string< char, std::char_traits<char>, ArenaAllocator<char> > ArenaString;
+
+} // namespace gdx_cpp
+} // namespace utils
+
+#endif // GDX_CPP_UTILS_LINEARALLOCATOR_HPP_
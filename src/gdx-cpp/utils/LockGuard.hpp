@@ -17,27 +17,142 @@
  *    @author Ozires Bortolon de Faria ozires@aevumlab.com
  */
 
-
 #ifndef GDX_CPP_UTILS_LOCK_GUARD_HPP
 #define GDX_CPP_UTILS_LOCK_GUARD_HPP
 
-//simple template to mimetize boosts's lock_guard template
-template <typename mutex>
-struct lock_guard {
-    
-    lock_guard(mutex& m) : ref_mutex(m) {
-        ref_mutex.lock();
+#include "LockProfiler.hpp"
+
+#include <cstddef>
+
+namespace gdx_cpp {
+namespace utils {
+
+/** Holds a lock (Mutex, RWLock or anything with lock, tryLock and unlock) until it goes out of scope. Movable, so it
+ * can be returned from functions. The LockSite constructor records whether the lock was contended and how long it
+ * was waited for. */
+template <typename Lockable>
+class LockGuard {
+public:
+    explicit LockGuard (Lockable& lockable)
+    : lockable(&lockable)
+    {
+        lockable.lock();
+    }
+
+    LockGuard (Lockable& lockable, LockSite& site)
+    : lockable(&lockable)
+    {
+        if (lockable.tryLock()) {
+            site.recordUncontended();
+        } else {
+            uint64_t start = LockSite::nanoTime();
+            lockable.lock();
+            site.recordContended(LockSite::nanoTime() - start);
+        }
+    }
+
+    LockGuard (LockGuard&& other)
+    : lockable(other.lockable)
+    {
+        other.lockable = NULL;
+    }
+
+    ~LockGuard () {
+        if (lockable != NULL) lockable->unlock();
+    }
+
+    Lockable& getMutex () const {
+        return *lockable;
+    }
+
+private:
+    LockGuard (const LockGuard&);
+    LockGuard& operator= (const LockGuard&);
+
+    Lockable* lockable;
+};
+
+/** LockGuard for the readers of an RWLock */
+template <typename Lockable>
+class SharedLockGuard {
+public:
+    explicit SharedLockGuard (Lockable& lockable)
+    : lockable(&lockable)
+    {
+        lockable.lockShared();
+    }
+
+    SharedLockGuard (Lockable& lockable, LockSite& site)
+    : lockable(&lockable)
+    {
+        if (lockable.tryLockShared()) {
+            site.recordUncontended();
+        } else {
+            uint64_t start = LockSite::nanoTime();
+            lockable.lockShared();
+            site.recordContended(LockSite::nanoTime() - start);
+        }
+    }
+
+    SharedLockGuard (SharedLockGuard&& other)
+    : lockable(other.lockable)
+    {
+        other.lockable = NULL;
     }
 
-    ~lock_guard() {
-        ref_mutex.unlock();
+    ~SharedLockGuard () {
+        if (lockable != NULL) lockable->unlockShared();
     }
 
-    mutex&  getMutex() const {
-        return ref_mutex;
-    }    
 private:
-    mutex& ref_mutex;
+    SharedLockGuard (const SharedLockGuard&);
+    SharedLockGuard& operator= (const SharedLockGuard&);
+
+    Lockable* lockable;
 };
 
-#endif
\ No newline at end of file
+template <typename Lockable>
+LockGuard<Lockable> lockGuard (Lockable& lockable) {
+    return LockGuard<Lockable>(lockable);
+}
+
+template <typename Lockable>
+LockGuard<Lockable> lockGuard (Lockable& lockable, LockSite& site) {
+    return LockGuard<Lockable>(lockable, site);
+}
+
+template <typename Lockable>
+SharedLockGuard<Lockable> sharedLockGuard (Lockable& lockable) {
+    return SharedLockGuard<Lockable>(lockable);
+}
+
+template <typename Lockable>
+SharedLockGuard<Lockable> sharedLockGuard (Lockable& lockable, LockSite& site) {
+    return SharedLockGuard<Lockable>(lockable, site);
+}
+
+} // namespace gdx_cpp
+} // namespace utils
+
+#define GDX_CPP_LOCK_CONCAT_(a, b) a##b
+#define GDX_CPP_LOCK_CONCAT(a, b) GDX_CPP_LOCK_CONCAT_(a, b)
+
+/** Locks lockable until the end of the enclosing scope. With -DLOCK_PROFILING=ON the acquisitions are counted and
+ * timed under siteName, see LockSite::report; otherwise siteName is ignored and this is a plain LockGuard. */
+#if defined(GDX_CPP_LOCK_PROFILING)
+#define GDX_CPP_SCOPED_LOCK(lockable, siteName) \
+    static gdx_cpp::utils::LockSite GDX_CPP_LOCK_CONCAT(gdxLockSite, __LINE__)(siteName); \
+    auto GDX_CPP_LOCK_CONCAT(gdxLockGuard, __LINE__) = \
+        gdx_cpp::utils::lockGuard(lockable, GDX_CPP_LOCK_CONCAT(gdxLockSite, __LINE__))
+#define GDX_CPP_SCOPED_SHARED_LOCK(lockable, siteName) \
+    static gdx_cpp::utils::LockSite GDX_CPP_LOCK_CONCAT(gdxLockSite, __LINE__)(siteName); \
+    auto GDX_CPP_LOCK_CONCAT(gdxLockGuard, __LINE__) = \
+        gdx_cpp::utils::sharedLockGuard(lockable, GDX_CPP_LOCK_CONCAT(gdxLockSite, __LINE__))
+#else
+#define GDX_CPP_SCOPED_LOCK(lockable, siteName) \
+    auto GDX_CPP_LOCK_CONCAT(gdxLockGuard, __LINE__) = gdx_cpp::utils::lockGuard(lockable)
+#define GDX_CPP_SCOPED_SHARED_LOCK(lockable, siteName) \
+    auto GDX_CPP_LOCK_CONCAT(gdxLockGuard, __LINE__) = gdx_cpp::utils::sharedLockGuard(lockable)
+#endif
+
+#endif
@@ -0,0 +1,83 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "LockProfiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace gdx_cpp::utils;
+
+namespace {
+
+std::atomic<LockSite*> sites(NULL);
+
+bool longerWait (const LockSite* a, const LockSite* b) {
+    return a->getWaitNanos() > b->getWaitNanos();
+}
+
+}
+
+LockSite::LockSite (const char* name)
+: name(name)
+, acquisitions(0)
+, contentions(0)
+, waitNanos(0)
+, next(sites.load(std::memory_order_relaxed))
+{
+    while (!sites.compare_exchange_weak(next, this, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t LockSite::nanoTime () {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+const LockSite* LockSite::first () {
+    return sites.load(std::memory_order_acquire);
+}
+
+void LockSite::report (std::ostream& out) {
+    std::vector<const LockSite*> acquired;
+    for (const LockSite* site = first(); site != NULL; site = site->getNext()) {
+        if (site->getAcquisitions() > 0) acquired.push_back(site);
+    }
+    std::stable_sort(acquired.begin(), acquired.end(), longerWait);
+
+    char line[256];
+    snprintf(line, sizeof(line), "%-40s %14s %12s %14s %14s\n", "lock site", "acquisitions", "contended", "wait ms",
+             "ns/contention");
+    out << line;
+    for (size_t i = 0; i < acquired.size(); i++) {
+        const LockSite* site = acquired[i];
+        uint64_t contended = site->getContentions();
+        snprintf(line, sizeof(line), "%-40s %14llu %11.2f%% %14.3f %14.0f\n", site->getName(),
+                 (unsigned long long) site->getAcquisitions(), 100.0 * contended / site->getAcquisitions(),
+                 site->getWaitNanos() / 1e6, contended ? (double) site->getWaitNanos() / contended : 0.0);
+        out << line;
+    }
+}
+
+void LockSite::resetAll () {
+    for (LockSite* site = sites.load(std::memory_order_acquire); site != NULL; site = site->next) {
+        site->acquisitions.store(0, std::memory_order_relaxed);
+        site->contentions.store(0, std::memory_order_relaxed);
+        site->waitNanos.store(0, std::memory_order_relaxed);
+    }
+}
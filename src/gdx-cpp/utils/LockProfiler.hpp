@@ -0,0 +1,90 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef GDX_CPP_UTILS_LOCKPROFILER_HPP_
+#define GDX_CPP_UTILS_LOCKPROFILER_HPP_
+
+#include <atomic>
+#include <ostream>
+#include <stdint.h>
+
+namespace gdx_cpp {
+namespace utils {
+
+/** How often the lock taken at one place in the code was contended and how long it was waited for. Sites are function
+ * local statics declared by GDX_CPP_SCOPED_LOCK when the library is built with LOCK_PROFILING, and link themselves
+ * into a list that report() walks. The counters are shared by all threads, so profiling adds a cache miss to every
+ * acquisition; compare the sites with each other, not with unprofiled timings. */
+class LockSite {
+public:
+    explicit LockSite (const char* name);
+
+    const char* getName () const {
+        return name;
+    }
+
+    uint64_t getAcquisitions () const {
+        return acquisitions.load(std::memory_order_relaxed);
+    }
+
+    /** Acquisitions that found the lock taken */
+    uint64_t getContentions () const {
+        return contentions.load(std::memory_order_relaxed);
+    }
+
+    /** Total time spent waiting in contended acquisitions */
+    uint64_t getWaitNanos () const {
+        return waitNanos.load(std::memory_order_relaxed);
+    }
+
+    const LockSite* getNext () const {
+        return next;
+    }
+
+    void recordUncontended () {
+        acquisitions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void recordContended (uint64_t nanos) {
+        acquisitions.fetch_add(1, std::memory_order_relaxed);
+        contentions.fetch_add(1, std::memory_order_relaxed);
+        waitNanos.fetch_add(nanos, std::memory_order_relaxed);
+    }
+
+    /** Monotonic clock for timing the waits */
+    static uint64_t nanoTime ();
+
+    /** The most recently created site, or NULL */
+    static const LockSite* first ();
+    /** Writes a table of all sites that were acquired, the longest total wait first */
+    static void report (std::ostream& out);
+    static void resetAll ();
+
+private:
+    LockSite (const LockSite&);
+    LockSite& operator= (const LockSite&);
+
+    const char* name;
+    std::atomic<uint64_t> acquisitions;
+    std::atomic<uint64_t> contentions;
+    std::atomic<uint64_t> waitNanos;
+    LockSite* next;
+};
+
+} // namespace gdx_cpp
+} // namespace utils
+
+#endif // GDX_CPP_UTILS_LOCKPROFILER_HPP_
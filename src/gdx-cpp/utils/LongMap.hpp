@@ -18,54 +18,29 @@
     @author Ozires Bortolon de Faria ozires@aevumlab.com
 */
 
-#ifndef GDX_CPP_UTILS_LONGMAP<V>_HPP_
-#define GDX_CPP_UTILS_LONGMAP<V>_HPP_
+#ifndef GDX_CPP_UTILS_LONGMAP_HPP_
+#define GDX_CPP_UTILS_LONGMAP_HPP_
+
+#include "ObjectMap.hpp"
+
+#include <stdint.h>
 
 namespace gdx_cpp {
 namespace utils {
 
-class LongMap {
+/** An unordered map with 64 bit keys, see ObjectMap */
+template <typename V>
+class LongMap : public ObjectMap<int64_t, V> {
 public:
-    V& put (long key,const V& value);
-    void putAll (const LongMap<V>& map);
-    V& get (long key);
-    V& remove (long key);
-    void clear ();
-    bool containsValue (const Object& value,bool identity);
-    bool containsKey (long key);
-    void ensureCapacity (int additionalCapacity);
-    std::string& toString ();
-    Entries<V>& entries ();
-    Values<V>& values ();
-    Keys& keys ();
-    std::string& toString ();
-    void reset ();
-    void remove ();
-    Entry<V>& next ();
-    bool hasNext ();
-    Iterator<Entry<V>>& iterator ();
-    bool hasNext ();
-    V& next ();
-    Iterator<V>& iterator ();
-    Array<V>& toArray ();
-    long next ();
-    LongArray& toArray ();
-
-protected:
-
+    LongMap () {
+    }
 
-private:
-    void putResize (long key,const V& value);
-    void push (long insertKey,const V& insertValue,int index1,long key1,int index2,long key2,int index3,long key3);
-    void putStash (long key,const V& value);
-    V& getStash (long key);
-    bool containsKeyStash (long key);
-    void resize (int newSize);
-    int hash2 (long h);
-    int hash3 (long h);
+    explicit LongMap (int initialCapacity, float loadFactor = 0.8f)
+    : ObjectMap<int64_t, V>(initialCapacity, loadFactor) {
+    }
 };
 
 } // namespace gdx_cpp
 } // namespace utils
 
-#endif // GDX_CPP_UTILS_LONGMAP<V>_HPP_
+#endif // GDX_CPP_UTILS_LONGMAP_HPP_
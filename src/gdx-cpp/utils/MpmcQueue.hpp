@@ -0,0 +1,140 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef GDX_CPP_UTILS_MPMCQUEUE_HPP_
+#define GDX_CPP_UTILS_MPMCQUEUE_HPP_
+
+#include "CacheLine.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace gdx_cpp {
+namespace utils {
+
+/** A bounded lock-free queue that any number of threads may put to and poll from.
+ *
+ * Every slot of the power-of-two ring carries a sequence number telling whether it is ready to be written or read in
+ * the current lap, so producers and consumers only contend on their own counter, with one compare-and-swap per
+ * operation, and never on each other's. */
+template <typename T>
+class MpmcQueue {
+public:
+    explicit MpmcQueue (int capacity)
+    : enqueuePosition(0)
+    , dequeuePosition(0)
+    {
+        if (capacity < 2) throw std::runtime_error("capacity must be > 1");
+        size_t size = 2;
+        while (size < (size_t) capacity)
+            size <<= 1;
+        mask = size - 1;
+        cells = new Cell[size];
+        for (size_t i = 0; i < size; i++)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    ~MpmcQueue () {
+        // no thread is putting or polling anymore, so the slots between the counters hold the remaining values
+        size_t end = enqueuePosition.load(std::memory_order_relaxed);
+        for (size_t position = dequeuePosition.load(std::memory_order_relaxed); position != end; position++)
+            reinterpret_cast<T*>(cells[position & mask].storage)->~T();
+        delete [] cells;
+    }
+
+    /** Adds the value to the queue, returning false if the queue is full */
+    bool put (const T& value) {
+        Cell* cell;
+        size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &cells[position & mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            ptrdiff_t difference = (ptrdiff_t) sequence - (ptrdiff_t) position;
+            if (difference == 0) {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+            } else if (difference < 0) {
+                // the slot still holds the value from the previous lap
+                return false;
+            } else {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+        new (cell->storage) T(value);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Moves the oldest value into value, returning false if the queue is empty */
+    bool poll (T& value) {
+        Cell* cell;
+        size_t position = dequeuePosition.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &cells[position & mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            ptrdiff_t difference = (ptrdiff_t) sequence - (ptrdiff_t) (position + 1);
+            if (difference == 0) {
+                if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = dequeuePosition.load(std::memory_order_relaxed);
+            }
+        }
+        T* slot = reinterpret_cast<T*>(cell->storage);
+        value = std::move(*slot);
+        slot->~T();
+        // ready for the producer of the next lap
+        cell->sequence.store(position + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** The number of queued values. Only exact if no thread is putting or polling concurrently. */
+    int size () const {
+        return (int) (enqueuePosition.load(std::memory_order_acquire) - dequeuePosition.load(std::memory_order_acquire));
+    }
+
+    int capacity () const {
+        return (int) mask + 1;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    MpmcQueue (const MpmcQueue&);
+    MpmcQueue& operator= (const MpmcQueue&);
+
+    // read-only after construction
+    Cell* cells;
+    size_t mask;
+    char padding0[GDX_CPP_CACHE_LINE_SIZE];
+
+    std::atomic<size_t> enqueuePosition;
+    char padding1[GDX_CPP_CACHE_LINE_SIZE];
+
+    std::atomic<size_t> dequeuePosition;
+    char padding2[GDX_CPP_CACHE_LINE_SIZE];
+};
+
+} // namespace gdx_cpp
+} // namespace utils
+
+#endif // GDX_CPP_UTILS_MPMCQUEUE_HPP_
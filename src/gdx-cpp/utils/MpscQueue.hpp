@@ -0,0 +1,115 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef GDX_CPP_UTILS_MPSCQUEUE_HPP_
+#define GDX_CPP_UTILS_MPSCQUEUE_HPP_
+
+#include "CacheLine.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace gdx_cpp {
+namespace utils {
+
+/** An unbounded lock-free queue that any number of threads may put to and a single thread polls from.
+ *
+ * The values are kept in a linked list: put allocates a node and links it in with a single atomic exchange, so it never
+ * waits on other producers or the consumer. A put that was interrupted between the exchange and linking its node may
+ * hide the values put after it from poll until it completes, so poll returning false doesn't prove that no put has
+ * finished. */
+template <typename T>
+class MpscQueue {
+public:
+    MpscQueue ()
+    : head(new Node())
+    , tail(head.load(std::memory_order_relaxed))
+    {
+    }
+
+    ~MpscQueue () {
+        // the sentinel holds no value, every node after it does
+        Node* node = tail->next.load(std::memory_order_relaxed);
+        delete tail;
+        while (node != NULL) {
+            Node* next = node->next.load(std::memory_order_relaxed);
+            node->value()->~T();
+            delete node;
+            node = next;
+        }
+    }
+
+    void put (const T& value) {
+        Node* node = new Node();
+        try {
+            new (node->storage) T(value);
+        } catch (...) {
+            delete node;
+            throw;
+        }
+        Node* previous = head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    /** Moves the oldest value into value, returning false if the queue is empty. Only one thread may poll. */
+    bool poll (T& value) {
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (next == NULL) return false;
+        value = std::move(*next->value());
+        // next becomes the new sentinel, which holds no value
+        next->value()->~T();
+        delete tail;
+        tail = next;
+        return true;
+    }
+
+    /** Whether poll would find nothing. Only meaningful on the polling thread. */
+    bool empty () const {
+        return tail->next.load(std::memory_order_acquire) == NULL;
+    }
+
+private:
+    /** The value is constructed in place by put and destroyed by poll, so the sentinel needs none */
+    struct Node {
+        std::atomic<Node*> next;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        Node () : next(NULL) {
+        }
+
+        T* value () {
+            return reinterpret_cast<T*>(storage);
+        }
+    };
+
+    MpscQueue (const MpscQueue&);
+    MpscQueue& operator= (const MpscQueue&);
+
+    // swapped by the producers
+    std::atomic<Node*> head;
+    char padding0[GDX_CPP_CACHE_LINE_SIZE];
+
+    // owned by the consumer
+    Node* tail;
+    char padding1[GDX_CPP_CACHE_LINE_SIZE];
+};
+
+} // namespace gdx_cpp
+} // namespace utils
+
+#endif // GDX_CPP_UTILS_MPSCQUEUE_HPP_
@@ -0,0 +1,185 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "Mutex.hpp"
+
+#include <climits>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#endif
+
+using namespace gdx_cpp::utils;
+
+namespace {
+
+/** The most a contended lock spins before sleeping, each spin about a cache miss */
+const int MAX_SPINS = 100;
+
+/** Tells the CPU we're busy waiting, which frees the core for its hyperthread and avoids the memory order violation
+ * penalty when the awaited store arrives */
+inline void cpuRelax () {
+#if defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield");
+#endif
+}
+
+/** Spinning only helps if the owner runs at the same time */
+bool canSpin () {
+    static const bool multicore = std::thread::hardware_concurrency() != 1;
+    return multicore;
+}
+
+/** Sleeps while word still holds value, waking up spuriously is allowed */
+void sleepWhile (std::atomic<uint32_t>& word, uint32_t value) {
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, value, NULL, NULL, 0);
+#else
+    if (word.load(std::memory_order_relaxed) == value)
+        std::this_thread::yield();
+#endif
+}
+
+void wakeSleepers (std::atomic<uint32_t>& word, int count) {
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+#else
+    (void) word;
+    (void) count;
+#endif
+}
+
+}
+
+void Mutex::lockContended () {
+    // like glibc's adaptive mutexes: spin up to about twice as long as it took the last times
+    if (canSpin() && state.load(std::memory_order_relaxed) != CONTENDED) {
+        int estimate = spins.load(std::memory_order_relaxed);
+        int limit = estimate * 2 + 10 < MAX_SPINS ? estimate * 2 + 10 : MAX_SPINS;
+        int spun = 0;
+        bool acquired = false;
+        while (spun < limit) {
+            spun++;
+            cpuRelax();
+            uint32_t current = state.load(std::memory_order_relaxed);
+            if (current == UNLOCKED && state.compare_exchange_weak(current, LOCKED, std::memory_order_acquire,
+                                                                   std::memory_order_relaxed)) {
+                acquired = true;
+                break;
+            }
+            // somebody already sleeps, the owner is in for the long haul
+            if (current == CONTENDED) break;
+        }
+        spins.store(estimate + (spun - estimate) / 8, std::memory_order_relaxed);
+        if (acquired) return;
+    }
+
+    // taking the mutex as CONTENDED makes our unlock wake the other sleepers, we can't know whether there are any
+    while (state.exchange(CONTENDED, std::memory_order_acquire) != UNLOCKED)
+        sleepWhile(state, CONTENDED);
+}
+
+void Mutex::wakeOne () {
+    wakeSleepers(state, 1);
+}
+
+void RWLock::lockContended () {
+    for (int spun = 0;; spun++) {
+        uint32_t current = state.load(std::memory_order_relaxed);
+        if ((current & ~(uint32_t) WRITER_WAITING) == 0) {
+            // neither readers nor a writer, clearing WRITER_WAITING is fine since waiting writers set it again
+            if (state.compare_exchange_weak(current, WRITER, std::memory_order_acquire, std::memory_order_relaxed))
+                return;
+            continue;
+        }
+
+        if ((current & WRITER_WAITING) == 0) {
+            // keep new readers out so this writer isn't starved
+            state.fetch_or(WRITER_WAITING, std::memory_order_relaxed);
+            continue;
+        }
+
+        if (spun < MAX_SPINS && canSpin()) {
+            cpuRelax();
+            continue;
+        }
+        wait(current);
+    }
+}
+
+void RWLock::lockSharedContended () {
+    for (int spun = 0;; spun++) {
+        uint32_t current = state.load(std::memory_order_relaxed);
+        if ((current & (WRITER | WRITER_WAITING)) == 0) {
+            if (state.compare_exchange_weak(current, current + READER, std::memory_order_acquire,
+                                            std::memory_order_relaxed))
+                return;
+            continue;
+        }
+
+        if (spun < MAX_SPINS && canSpin()) {
+            cpuRelax();
+            continue;
+        }
+        wait(current);
+    }
+}
+
+void RWLock::wait (uint32_t current) {
+    // counted before the futex rechecks state; unlock changes state before reading waiters, both sequentially
+    // consistent, so either unlock sees us or the futex sees the new state
+    waiters.fetch_add(1, std::memory_order_seq_cst);
+    sleepWhile(state, current);
+    waiters.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void RWLock::wakeAll () {
+    wakeSleepers(state, INT_MAX);
+}
+
+bool OnceFlag::begin () {
+    for (;;) {
+        uint32_t current = state.load(std::memory_order_acquire);
+        if (current == DONE) return false;
+
+        if (current == NEW) {
+            if (state.compare_exchange_weak(current, RUNNING, std::memory_order_acquire, std::memory_order_relaxed))
+                return true;
+            continue;
+        }
+
+        // running: tell the runner to wake us when it's done
+        if (current == RUNNING_WITH_WAITERS
+            || state.compare_exchange_weak(current, RUNNING_WITH_WAITERS, std::memory_order_relaxed))
+            sleepWhile(state, RUNNING_WITH_WAITERS);
+    }
+}
+
+void OnceFlag::end (bool succeeded) {
+    if (state.exchange(succeeded ? DONE : NEW, std::memory_order_release) == RUNNING_WITH_WAITERS)
+        wakeSleepers(state, INT_MAX);
+}
@@ -0,0 +1,174 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef GDX_CPP_UTILS_MUTEX_HPP_
+#define GDX_CPP_UTILS_MUTEX_HPP_
+
+#include <atomic>
+#include <stdint.h>
+
+namespace gdx_cpp {
+namespace utils {
+
+/** A non-recursive mutex in a single 32 bit word. Uncontended lock and unlock are one atomic instruction each and
+ * inline. A thread that finds the mutex taken spins for a while, adapting the number of spins to how long the mutex was
+ * held the last times, and then sleeps on a futex (on other platforms it yields instead). Usable with LockGuard. */
+class Mutex {
+public:
+    Mutex ()
+    : state(UNLOCKED)
+    , spins(0)
+    {
+    }
+
+    void lock () {
+        uint32_t expected = UNLOCKED;
+        if (!state.compare_exchange_strong(expected, LOCKED, std::memory_order_acquire, std::memory_order_relaxed))
+            lockContended();
+    }
+
+    bool tryLock () {
+        uint32_t expected = UNLOCKED;
+        return state.compare_exchange_strong(expected, LOCKED, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock () {
+        if (state.exchange(UNLOCKED, std::memory_order_release) == CONTENDED)
+            wakeOne();
+    }
+
+private:
+    /** LOCKED means no thread sleeps on the mutex, CONTENDED that some may */
+    enum { UNLOCKED, LOCKED, CONTENDED };
+
+    void lockContended ();
+    void wakeOne ();
+
+    Mutex (const Mutex&);
+    Mutex& operator= (const Mutex&);
+
+    std::atomic<uint32_t> state;
+    /** running estimate of the spins it takes to get the mutex, only a hint so it's updated racily */
+    std::atomic<int> spins;
+};
+
+/** A reader-writer lock: any number of readers or one writer. Writers are preferred, once one waits no new readers
+ * get in, so a reader must not take the lock again while holding it. Not recursive. Usable with LockGuard and, for
+ * the readers, SharedLockGuard. */
+class RWLock {
+public:
+    RWLock ()
+    : state(0)
+    , waiters(0)
+    {
+    }
+
+    void lock () {
+        uint32_t expected = 0;
+        if (!state.compare_exchange_strong(expected, WRITER, std::memory_order_acquire, std::memory_order_relaxed))
+            lockContended();
+    }
+
+    bool tryLock () {
+        uint32_t expected = 0;
+        return state.compare_exchange_strong(expected, WRITER, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    void unlock () {
+        // keeps WRITER_WAITING, another writer is next
+        state.fetch_and(~(uint32_t) WRITER, std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_seq_cst) != 0)
+            wakeAll();
+    }
+
+    void lockShared () {
+        if (!tryLockShared())
+            lockSharedContended();
+    }
+
+    bool tryLockShared () {
+        uint32_t current = state.load(std::memory_order_relaxed);
+        return (current & (WRITER | WRITER_WAITING)) == 0
+               && state.compare_exchange_strong(current, current + READER, std::memory_order_acquire,
+                                                std::memory_order_relaxed);
+    }
+
+    void unlockShared () {
+        uint32_t previous = state.fetch_sub(READER, std::memory_order_seq_cst);
+        // only the last reader out can let a writer in
+        if (previous < 2 * READER && waiters.load(std::memory_order_seq_cst) != 0)
+            wakeAll();
+    }
+
+private:
+    /** the low two bits flag the writer, the rest counts the readers */
+    enum { WRITER = 1, WRITER_WAITING = 2, READER = 4 };
+
+    void lockContended ();
+    void lockSharedContended ();
+    void wait (uint32_t current);
+    void wakeAll ();
+
+    RWLock (const RWLock&);
+    RWLock& operator= (const RWLock&);
+
+    std::atomic<uint32_t> state;
+    /** threads sleeping or about to sleep on state, so unlocking skips the system call when there are none */
+    std::atomic<uint32_t> waiters;
+};
+
+/** Runs a function once however many threads call callOnce with the same flag. Callers that arrive while it runs wait
+ * until it's done; if it throws, the next caller runs it again. Once done, callOnce is a single load. */
+class OnceFlag {
+public:
+    OnceFlag ()
+    : state(NEW)
+    {
+    }
+
+    bool isDone () const {
+        return state.load(std::memory_order_acquire) == DONE;
+    }
+
+    /** Returns true if the caller is to run the function and then call end, false once another caller has run it */
+    bool begin ();
+    void end (bool succeeded);
+
+private:
+    enum { NEW, RUNNING, RUNNING_WITH_WAITERS, DONE };
+
+    OnceFlag (const OnceFlag&);
+    OnceFlag& operator= (const OnceFlag&);
+
+    std::atomic<uint32_t> state;
+};
+
+template <typename Function>
+void callOnce (OnceFlag& flag, Function function) {
+    if (flag.isDone() || !flag.begin()) return;
+    try {
+        function();
+    } catch (...) {
+        flag.end(false);
+        throw;
+    }
+    flag.end(true);
+}
+
+} // namespace gdx_cpp
+} // namespace utils
+
+#endif // GDX_CPP_UTILS_MUTEX_HPP_
@@ -18,53 +18,474 @@
     @author Ozires Bortolon de Faria ozires@aevumlab.com
 */
 
-#ifndef GDX_CPP_UTILS_OBJECTMAP<K, V>_HPP_
-#define GDX_CPP_UTILS_OBJECTMAP<K, V>_HPP_
+#ifndef GDX_CPP_UTILS_OBJECTMAP_HPP_
+#define GDX_CPP_UTILS_OBJECTMAP_HPP_
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <stdint.h>
+#include <utility>
 
 namespace gdx_cpp {
 namespace utils {
 
+/** An unordered map that stores its entries in a single flat array, using open addressing with robin hood probing.
+ *
+ * Each key's hash is scrambled and mapped to a bucket; entries are kept ordered by the distance to their bucket, so a
+ * lookup stops as soon as it meets an entry that is closer to home than the key would be. Removal shifts the following
+ * entries back instead of leaving tombstones. Probing never wraps around: the table has a few overflow slots past the
+ * last bucket and grows when those run out. This makes get, put and remove O(1) with at most a couple of cache misses,
+ * and iteration a linear scan.
+ *
+ * Iterators and pointers to values are invalidated by put and by removing other entries; erase(iterator) returns the
+ * iterator to continue with. A default constructed map doesn't allocate until the first put. */
+template <typename K, typename V, typename Hash = std::hash<K>, typename Equal = std::equal_to<K> >
 class ObjectMap {
 public:
-    V& put (const K& key,const V& value);
-    void putAll (const ObjectMap<K, V>& map);
-    V& get (const K& key);
-    V& remove (const K& key);
-    void clear ();
-    bool containsValue (const Object& value,bool identity);
-    bool containsKey (const K& key);
-    void ensureCapacity (int additionalCapacity);
-    std::string& toString ();
-    Values<V>& values ();
-    Keys<K>& keys ();
-    std::string& toString ();
-    void reset ();
-    void remove ();
-    bool hasNext ();
-    bool hasNext ();
-    V& next ();
-    Iterator<V>& iterator ();
-    Array<V>& toArray ();
-    bool hasNext ();
-    K& next ();
-    Iterator<K>& iterator ();
-    Array<K>& toArray ();
-
-protected:
+    struct Entry {
+        K key;
+        V value;
+
+        Entry (const K& key, const V& value) : key(key), value(value) {
+        }
+    };
+
+    template <typename MapType, typename EntryType>
+    class basic_iterator {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef EntryType value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef EntryType* pointer;
+        typedef EntryType& reference;
+
+        basic_iterator () : map(NULL), index(0) {
+        }
+
+        template <typename OtherMap, typename OtherEntry>
+        basic_iterator (const basic_iterator<OtherMap, OtherEntry>& other) : map(other.map), index(other.index) {
+        }
+
+        reference operator* () const {
+            return map->entries[index];
+        }
+
+        pointer operator-> () const {
+            return &map->entries[index];
+        }
+
+        basic_iterator& operator++ () {
+            index = map->nextOccupied(index + 1);
+            return *this;
+        }
+
+        basic_iterator operator++ (int) {
+            basic_iterator copy(*this);
+            ++*this;
+            return copy;
+        }
+
+        bool operator== (const basic_iterator& other) const {
+            return index == other.index;
+        }
+
+        bool operator!= (const basic_iterator& other) const {
+            return index != other.index;
+        }
+
+    private:
+        friend class ObjectMap;
+        template <typename, typename> friend class basic_iterator;
+
+        basic_iterator (MapType* map, int index) : map(map), index(index) {
+        }
+
+        MapType* map;
+        int index;
+    };
+
+    /** Iterates the entries in table order. The keys must not be modified through it. */
+    typedef basic_iterator<ObjectMap, Entry> iterator;
+    typedef basic_iterator<const ObjectMap, const Entry> const_iterator;
+
+    ObjectMap ()
+    : loadFactor(0.8f) {
+        reset();
+    }
+
+    /** Creates a map that can hold initialCapacity entries before growing. The load factor is the fraction of the
+     * buckets that may be filled, in (0, 1]. */
+    explicit ObjectMap (int initialCapacity, float loadFactor = 0.8f)
+    : loadFactor(loadFactor) {
+        if (initialCapacity < 0) throw std::runtime_error("initialCapacity must be >= 0");
+        if (loadFactor <= 0 || loadFactor > 1) throw std::runtime_error("loadFactor must be > 0 and <= 1");
+        reset();
+        if (initialCapacity > 0) resize(capacityFor(initialCapacity));
+    }
+
+    ObjectMap (const ObjectMap& other)
+    : loadFactor(other.loadFactor), hasher(other.hasher), equal(other.equal) {
+        reset();
+        if (other.capacity == 0) return;
+
+        allocate(other.capacity);
+        for (int i = 0; i < slots; i++) {
+            if (other.distances[i] == 0) continue;
+            new (&entries[i]) Entry(other.entries[i]);
+            distances[i] = other.distances[i];
+            size_++;
+        }
+    }
+
+    ObjectMap (ObjectMap&& other)
+    : loadFactor(other.loadFactor), hasher(other.hasher), equal(other.equal) {
+        reset();
+        swap(other);
+    }
+
+    ObjectMap& operator= (ObjectMap other) {
+        swap(other);
+        return *this;
+    }
+
+    ~ObjectMap () {
+        destroy();
+    }
+
+    void swap (ObjectMap& other) {
+        std::swap(entries, other.entries);
+        std::swap(distances, other.distances);
+        std::swap(capacity, other.capacity);
+        std::swap(slots, other.slots);
+        std::swap(mask, other.mask);
+        std::swap(size_, other.size_);
+        std::swap(threshold, other.threshold);
+        std::swap(loadFactor, other.loadFactor);
+        std::swap(hasher, other.hasher);
+        std::swap(equal, other.equal);
+    }
+
+    /** Sets the value for the key, replacing any previous value. Returns the stored value. */
+    V& put (const K& key, const V& value) {
+        int slot = 0, distance = 0;
+        int index = probe(key, slot, distance);
+        if (index != -1) return entries[index].value = value;
+        // insert may reallocate, so it has to happen before entries is read
+        index = insert(slot, distance, Entry(key, value));
+        return entries[index].value;
+    }
+
+    void putAll (const ObjectMap& map) {
+        ensureCapacity(map.size_);
+        for (const_iterator it = map.begin(); it != map.end(); ++it)
+            put(it->key, it->value);
+    }
+
+    /** Returns the value for the key, inserting a default constructed one if the key isn't in the map */
+    V& operator[] (const K& key) {
+        int slot = 0, distance = 0;
+        int index = probe(key, slot, distance);
+        if (index != -1) return entries[index].value;
+        index = insert(slot, distance, Entry(key, V()));
+        return entries[index].value;
+    }
+
+    /** Returns a pointer to the value for the key, or NULL if the key isn't in the map */
+    V* get (const K& key) {
+        int index = locate(key);
+        return index == -1 ? NULL : &entries[index].value;
+    }
+
+    const V* get (const K& key) const {
+        int index = locate(key);
+        return index == -1 ? NULL : &entries[index].value;
+    }
+
+    /** Returns the value for the key, or defaultValue if the key isn't in the map */
+    V get (const K& key, const V& defaultValue) const {
+        int index = locate(key);
+        return index == -1 ? defaultValue : entries[index].value;
+    }
+
+    /** Removes the key and its value. Returns false if the key wasn't in the map. */
+    bool remove (const K& key) {
+        int index = locate(key);
+        if (index == -1) return false;
+        removeAt(index);
+        return true;
+    }
+
+    bool containsKey (const K& key) const {
+        return locate(key) != -1;
+    }
+
+    /** Returns true if the map contains the value, compared with operator==. This is a linear search. */
+    bool containsValue (const V& value) const {
+        for (const_iterator it = begin(); it != end(); ++it)
+            if (it->value == value) return true;
+        return false;
+    }
 
+    /** Stores the key of the first entry with the value in key, returning false if there is none. This is a linear
+     * search. */
+    bool findKey (const V& value, K& key) const {
+        for (const_iterator it = begin(); it != end(); ++it) {
+            if (it->value == value) {
+                key = it->key;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    iterator find (const K& key) {
+        int index = locate(key);
+        return index == -1 ? end() : iterator(this, index);
+    }
+
+    const_iterator find (const K& key) const {
+        int index = locate(key);
+        return index == -1 ? end() : const_iterator(this, index);
+    }
+
+    /** Removes the entry and returns an iterator to the entry that followed it */
+    iterator erase (iterator position) {
+        int index = position.index;
+        removeAt(index);
+        // the following entries were shifted back, so the next one may now live in this very slot
+        return iterator(this, nextOccupied(index));
+    }
+
+    iterator begin () {
+        return iterator(this, nextOccupied(0));
+    }
+
+    iterator end () {
+        return iterator(this, slots);
+    }
+
+    const_iterator begin () const {
+        return const_iterator(this, nextOccupied(0));
+    }
+
+    const_iterator end () const {
+        return const_iterator(this, slots);
+    }
+
+    /** Increases the size of the backing array to accommodate the specified number of additional entries */
+    void ensureCapacity (int additionalCapacity) {
+        int needed = capacityFor(size_ + additionalCapacity);
+        if (needed > capacity) resize(needed);
+    }
+
+    /** Reduces the size of the backing array to maximumCapacity if it is larger, or to the size of the map if that
+     * needs more room. */
+    void shrink (int maximumCapacity) {
+        if (maximumCapacity < 0) throw std::runtime_error("maximumCapacity must be >= 0");
+        int shrunk = capacityFor(size_ > maximumCapacity ? size_ : maximumCapacity);
+        if (capacity > shrunk) resize(shrunk);
+    }
+
+    void clear () {
+        for (int i = 0; i < slots; i++) {
+            if (distances[i] == 0) continue;
+            entries[i].~Entry();
+            distances[i] = 0;
+        }
+        size_ = 0;
+    }
+
+    /** Clears the map and shrinks the backing array to maximumCapacity if it is larger */
+    void clear (int maximumCapacity) {
+        if (capacity <= capacityFor(maximumCapacity)) {
+            clear();
+            return;
+        }
+        destroy();
+        reset();
+        if (maximumCapacity > 0) resize(capacityFor(maximumCapacity));
+    }
+
+    int size () const {
+        return size_;
+    }
+
+    bool empty () const {
+        return size_ == 0;
+    }
 
 private:
-    void putResize (const K& key,const V& value);
-    void push (const K& insertKey,const V& insertValue,int index1,const K& key1,int index2,const K& key2,int index3,const K& key3);
-    void putStash (const K& key,const V& value);
-    V& getStash (const K& key);
-    bool containsKeyStash (const K& key);
-    void resize (int newSize);
-    int hash2 (long h);
-    int hash3 (long h);
+    /** Stored probe distances are one based, 0 marks an empty slot */
+    enum { maxDistance = 254 };
+
+    Entry* entries;
+    /** One byte per slot plus a terminating 0, so probes always stop before the end of the table */
+    uint8_t* distances;
+    int capacity;
+    int slots;
+    uint32_t mask;
+    int size_;
+    int threshold;
+    float loadFactor;
+    Hash hasher;
+    Equal equal;
+
+    static uint8_t* noDistances () {
+        static uint8_t terminator = 0;
+        return &terminator;
+    }
+
+    void reset () {
+        entries = NULL;
+        distances = noDistances();
+        capacity = 0;
+        slots = 0;
+        mask = 0;
+        size_ = 0;
+        threshold = 0;
+    }
+
+    void destroy () {
+        if (capacity == 0) return;
+        clear();
+        ::operator delete(entries);
+        delete [] distances;
+    }
+
+    void allocate (int newCapacity) {
+        capacity = newCapacity;
+        slots = newCapacity + (newCapacity < maxDistance ? newCapacity : maxDistance);
+        mask = newCapacity - 1;
+        threshold = (int) (newCapacity * loadFactor);
+        if (threshold < 1) threshold = 1;
+        entries = static_cast<Entry*>(::operator new(sizeof(Entry) * slots));
+        distances = new uint8_t[slots + 1];
+        std::memset(distances, 0, slots + 1);
+    }
+
+    int capacityFor (int entryCount) const {
+        int needed = (int) (entryCount / loadFactor) + 1;
+        int result = 8;
+        while (result < needed) {
+            if (result >= (1 << 30)) throw std::runtime_error("ObjectMap is too large");
+            result <<= 1;
+        }
+        return result;
+    }
+
+    int bucket (const K& key) const {
+        // fibonacci hashing spreads sequential integers and aligned pointers over the whole table
+        uint64_t h = (uint64_t) hasher(key) * UINT64_C(0x9E3779B97F4A7C15);
+        return (int) ((uint32_t) (h >> 32) & mask);
+    }
+
+    int nextOccupied (int index) const {
+        while (index < slots && distances[index] == 0)
+            index++;
+        return index;
+    }
+
+    int locate (const K& key) const {
+        int index = bucket(key);
+        for (int distance = 1; distances[index] >= distance; index++, distance++)
+            if (distances[index] == distance && equal(entries[index].key, key)) return index;
+        return -1;
+    }
+
+    /** Returns the index of the key, or -1 and the slot and distance the key would be inserted at */
+    int probe (const K& key, int& slot, int& distance) const {
+        int index = bucket(key);
+        int d = 1;
+        for (; distances[index] >= d; index++, d++)
+            if (distances[index] == d && equal(entries[index].key, key)) return index;
+        slot = index;
+        distance = d;
+        return -1;
+    }
+
+    /** Checks that the load stays below the threshold and that shifting the entries from index up to the next empty
+     * slot fits both the distance bytes and the table */
+    bool canInsert (int index, int distance) const {
+        if (size_ >= threshold || distance > maxDistance) return false;
+        for (; distances[index] != 0; index++)
+            if (distances[index] == maxDistance) return false;
+        return index < slots;
+    }
+
+    /** Inserts an entry whose key is not in the map at the slot found by probe(), growing if it doesn't fit. The
+     * entry is built by the caller before anything moves, so its key and value may refer into this map. */
+    int insert (int slot, int distance, Entry&& entry) {
+        if (canInsert(slot, distance)) return insertAt(slot, distance, std::move(entry));
+        return insertUnique(std::move(entry));
+    }
+
+    int insertUnique (Entry&& entry) {
+        for (;;) {
+            int index = bucket(entry.key);
+            int distance = 1;
+            for (; distances[index] >= distance; index++, distance++)
+                ;
+            if (canInsert(index, distance)) return insertAt(index, distance, std::move(entry));
+            resize(capacity == 0 ? 8 : capacity << 1);
+        }
+    }
+
+    /** Places the entry at index, shifting the richer entries from there up to the next empty slot by one */
+    int insertAt (int index, int distance, Entry&& entry) {
+        int empty = index;
+        while (distances[empty] != 0)
+            empty++;
+
+        for (int i = empty; i > index; i--) {
+            new (&entries[i]) Entry(std::move(entries[i - 1]));
+            entries[i - 1].~Entry();
+            distances[i] = distances[i - 1] + 1;
+        }
+        new (&entries[index]) Entry(std::move(entry));
+        distances[index] = (uint8_t) distance;
+        size_++;
+        return index;
+    }
+
+    /** Removes the entry at index, shifting the following entries back until one is at its bucket */
+    void removeAt (int index) {
+        entries[index].~Entry();
+        int next = index + 1;
+        while (distances[next] > 1) {
+            new (&entries[index]) Entry(std::move(entries[next]));
+            entries[next].~Entry();
+            distances[index] = distances[next] - 1;
+            index = next++;
+        }
+        distances[index] = 0;
+        size_--;
+    }
+
+    void resize (int newCapacity) {
+        Entry* oldEntries = entries;
+        uint8_t* oldDistances = distances;
+        int oldCapacity = capacity;
+        int oldSlots = slots;
+
+        allocate(newCapacity);
+        size_ = 0;
+        for (int i = 0; i < oldSlots; i++) {
+            if (oldDistances[i] == 0) continue;
+            insertUnique(std::move(oldEntries[i]));
+            oldEntries[i].~Entry();
+        }
+
+        if (oldCapacity == 0) return;
+        ::operator delete(oldEntries);
+        delete [] oldDistances;
+    }
 };
 
 } // namespace gdx_cpp
 } // namespace utils
 
-#endif // GDX_CPP_UTILS_OBJECTMAP<K, V>_HPP_
+#endif // GDX_CPP_UTILS_OBJECTMAP_HPP_
@@ -18,76 +18,326 @@
     @author Ozires Bortolon de Faria ozires@aevumlab.com
 */
 
+
 #ifndef GDX_CPP_UTILS_POOL_HPP_
 #define GDX_CPP_UTILS_POOL_HPP_
 
-#include <vector>
-#include <cmath>
+#include <algorithm>
+#include <atomic>
 #include <limits>
+#include <mutex>
+#include <new>
 #include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 namespace gdx_cpp {
 namespace utils {
+
+/** Keeps unused objects around so they can be reused instead of allocated again.
+ *
+ * Objects are constructed in place in contiguous slabs owned by the pool, so pooled objects stay packed in memory and a
+ * warm pool never touches the heap. The pool owns that memory: every object it handed out is destroyed with it, so
+ * obtained objects must not outlive the pool.
+ *
+ * The thread that created the pool obtains and frees through a cache nobody else touches. Other threads may use the
+ * pool too, they go through a shared overflow list guarded by a mutex, which the owning thread spills into and refills
+ * from in batches.
+ *
+ * Subclasses override reset() to clear an object's state when it is freed, and construct() to build objects that have
+ * no default constructor. At most max objects are kept free, surplus ones are destroyed and their slots reused. */
 template < class T >
 class Pool {
 public:
-    int max;
+    /** The maximum number of free objects kept */
+    const int max;
 
-    Pool (int initialCapacity=16, int _max=std::numeric_limits<int>::max(), bool alocate = false) : max(max)
+    /** @param initialCapacity the number of objects the first slab holds
+     * @param allocate whether to allocate the first slab right away rather than on the first obtain() */
+    Pool (int initialCapacity = 16, int _max = std::numeric_limits<int>::max(), bool allocate = false)
+    : max(_max)
+    , owner(std::this_thread::get_id())
+    , nextSlabSize(std::max(initialCapacity, 1))
+    , carve(NULL)
+    , carveLeft(0)
+    , rawSlots(NULL)
+    , shared(false)
+    , localFreeCount(0)
+    , sharedFreeCount(0)
+    , ownerLive(0)
+    , foreignLive(0)
+    , peakCount(0)
     {
-        create(initialCapacity, max, alocate);
+        if (allocate) allocateSlab();
+    }
+
+    virtual ~Pool () {
+        for (unsigned int i = 0; i < slabs.size(); i++) {
+            Slot* slots = slabs[i].slots;
+            for (int j = 0; j < slabs[i].size; j++)
+                if (slots[j].constructed) reinterpret_cast<T*>(slots[j].storage)->~T();
+            delete [] slots;
+        }
     }
 
     T& obtain () {
-      if (freeObjects.size() == 0)
-      {
-        return *newObject();
-      } else {
-        T * ret = freeObjects.back();
-        freeObjects.pop_back();
-        return *ret;
-      }
-        
+        T* object = NULL;
+        if (std::this_thread::get_id() == owner) {
+            if (localFree.empty() && sharedFreeCount.load(std::memory_order_relaxed) > 0) refill();
+            if (!localFree.empty()) {
+                object = localFree.back();
+                localFree.pop_back();
+                localFreeCount.store((int) localFree.size(), std::memory_order_relaxed);
+            } else {
+                object = newObject();
+            }
+            // only this thread writes ownerLive, no need for a locked increment
+            int live = ownerLive.load(std::memory_order_relaxed) + 1;
+            ownerLive.store(live, std::memory_order_relaxed);
+            updatePeak(live + foreignLive.load(std::memory_order_relaxed));
+        } else {
+            markShared();
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!sharedFree.empty()) {
+                    object = sharedFree.back();
+                    sharedFree.pop_back();
+                    sharedFreeCount.store((int) sharedFree.size(), std::memory_order_relaxed);
+                }
+            }
+            if (object == NULL) object = newObject();
+            int live = foreignLive.fetch_add(1, std::memory_order_relaxed) + 1;
+            updatePeak(live + ownerLive.load(std::memory_order_relaxed));
+        }
+        return *object;
     }
 
+    /** Resets the object and puts it back into the pool, or destroys it if the pool already holds max free objects.
+     * The object must have been obtained from this pool. */
     void free (T* object) {
         if (object == NULL) throw std::runtime_error("object cannot be null.");
-        if (freeObjects.size() < max)
-        {
-            freeObjects.push_back(object);
-        } else
-        {
-            delete object;
+        reset(*object);
+
+        if (std::this_thread::get_id() == owner) {
+            ownerLive.store(ownerLive.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+            if ((int) localFree.size() + sharedFreeCount.load(std::memory_order_relaxed) >= max) {
+                destroy(object);
+                return;
+            }
+            localFree.push_back(object);
+            localFreeCount.store((int) localFree.size(), std::memory_order_relaxed);
+            // nobody else would pick the objects up from the shared list
+            if (localFree.size() > localLimit && shared.load(std::memory_order_relaxed)) spill();
+        } else {
+            markShared();
+            foreignLive.fetch_sub(1, std::memory_order_relaxed);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (localFreeCount.load(std::memory_order_relaxed) + (int) sharedFree.size() < max) {
+                    sharedFree.push_back(object);
+                    sharedFreeCount.store((int) sharedFree.size(), std::memory_order_relaxed);
+                    return;
+                }
+            }
+            destroy(object);
         }
     }
+
     void freeVector (std::vector< T* >& objects) {
-        for (int i = 0; i < objects.size(); i++)
+        for (unsigned int i = 0; i < objects.size(); i++)
             free(objects[i]);
     }
+
+    /** Destroys the free objects, their memory stays in the pool. Only the free objects the calling thread can see
+     * are destroyed, so call it from the thread that created the pool. */
     void clear () {
-        freeObjects.clear();
+        std::vector<T*> objects;
+        if (std::this_thread::get_id() == owner) {
+            objects.swap(localFree);
+            localFreeCount.store(0, std::memory_order_relaxed);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            objects.insert(objects.end(), sharedFree.begin(), sharedFree.end());
+            sharedFree.clear();
+            sharedFreeCount.store(0, std::memory_order_relaxed);
+        }
+        for (unsigned int i = 0; i < objects.size(); i++)
+            destroy(objects[i]);
+    }
+
+    /** The number of objects waiting in the pool to be obtained */
+    int getFree () const {
+        return localFreeCount.load(std::memory_order_relaxed) + sharedFreeCount.load(std::memory_order_relaxed);
+    }
+
+    /** The number of objects obtained and not yet freed */
+    int getLive () const {
+        return ownerLive.load(std::memory_order_relaxed) + foreignLive.load(std::memory_order_relaxed);
+    }
+
+    /** The high-water mark of getLive() since the pool was created or resetPeak() was called */
+    int getPeak () const {
+        return peakCount.load(std::memory_order_relaxed);
+    }
+
+    void resetPeak () {
+        peakCount.store(getLive(), std::memory_order_relaxed);
+    }
+
+    /** The number of objects the allocated slabs can hold */
+    int getCapacity () {
+        std::lock_guard<std::mutex> lock(mutex);
+        int capacity = 0;
+        for (unsigned int i = 0; i < slabs.size(); i++)
+            capacity += slabs[i].size;
+        return capacity;
     }
 
 protected:
+    /** Called by free() before the object goes back into the pool */
+    virtual void reset (T& object) {
+    }
+
+    /** Constructs a new object in the given memory, which is suitably sized and aligned for a T. Pools of types without
+     * a default constructor must override it. */
+    virtual T* construct (void* memory) {
+        return constructDefault(memory, std::is_default_constructible<T>());
+    }
 
 private:
-    std::vector<T*> freeObjects;
+    /** Slab entry, the storage comes first so an object's address is its slot's */
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+        Slot* next;
+        bool constructed;
+    };
 
-    void create(int initialCapacity, int max, bool alocate) {
-        freeObjects.reserve(initialCapacity);
-        if (alocate) {
-            for (int i = 0; i<initialCapacity; i++)
-            {
-                freeObjects.push_back(new T());
-            }
-        }
+    struct Slab {
+        Slot* slots;
+        int size;
+    };
+
+    enum {
+        localLimit = 256,
+        refillBatch = 64,
+        maxSlabSize = 1024
+    };
+
+    Pool (const Pool&);
+    Pool& operator= (const Pool&);
+
+    static T* constructDefault (void* memory, std::true_type) {
+        return new (memory) T();
+    }
+
+    static T* constructDefault (void* memory, std::false_type) {
+        throw std::runtime_error("the pooled type has no default constructor, override construct().");
     }
+
     T* newObject () {
-        return new T();
+        Slot* slot = acquireSlot();
+        T* object;
+        try {
+            object = construct(slot->storage);
+        } catch (...) {
+            releaseSlot(slot);
+            throw;
+        }
+        slot->constructed = true;
+        return object;
+    }
+
+    void destroy (T* object) {
+        Slot* slot = reinterpret_cast<Slot*>(object);
+        object->~T();
+        slot->constructed = false;
+        releaseSlot(slot);
     }
+
+    Slot* acquireSlot () {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (rawSlots != NULL) {
+            Slot* slot = rawSlots;
+            rawSlots = slot->next;
+            return slot;
+        }
+        if (carveLeft == 0) allocateSlab();
+        carveLeft--;
+        return carve++;
+    }
+
+    void releaseSlot (Slot* slot) {
+        std::lock_guard<std::mutex> lock(mutex);
+        slot->next = rawSlots;
+        rawSlots = slot;
+    }
+
+    /** Called with the mutex held once the current slab is used up, or from the constructor */
+    void allocateSlab () {
+        Slab slab;
+        slab.size = nextSlabSize;
+        slab.slots = new Slot[slab.size];
+        for (int i = 0; i < slab.size; i++)
+            slab.slots[i].constructed = false;
+        slabs.push_back(slab);
+
+        carve = slab.slots;
+        carveLeft = slab.size;
+        nextSlabSize = std::min(nextSlabSize * 2, (int) maxSlabSize);
+    }
+
+    void updatePeak (int live) {
+        int peak = peakCount.load(std::memory_order_relaxed);
+        while (live > peak && !peakCount.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+        }
+    }
+
+    void markShared () {
+        if (!shared.load(std::memory_order_relaxed)) shared.store(true, std::memory_order_relaxed);
+    }
+
+    void refill () {
+        std::lock_guard<std::mutex> lock(mutex);
+        int count = std::min((int) sharedFree.size(), (int) refillBatch);
+        localFree.insert(localFree.end(), sharedFree.end() - count, sharedFree.end());
+        sharedFree.resize(sharedFree.size() - count);
+        sharedFreeCount.store((int) sharedFree.size(), std::memory_order_relaxed);
+        localFreeCount.store((int) localFree.size(), std::memory_order_relaxed);
+    }
+
+    /** Hands the half of the cache that was freed longest ago to the other threads */
+    void spill () {
+        std::lock_guard<std::mutex> lock(mutex);
+        int count = localFree.size() / 2;
+        sharedFree.insert(sharedFree.end(), localFree.begin(), localFree.begin() + count);
+        localFree.erase(localFree.begin(), localFree.begin() + count);
+        sharedFreeCount.store((int) sharedFree.size(), std::memory_order_relaxed);
+        localFreeCount.store((int) localFree.size(), std::memory_order_relaxed);
+    }
+
+    const std::thread::id owner;
+    std::vector<T*> localFree;
+
+    std::mutex mutex;
+    std::vector<T*> sharedFree;
+    std::vector<Slab> slabs;
+    int nextSlabSize;
+    Slot* carve;
+    int carveLeft;
+    Slot* rawSlots;
+
+    /** set once another thread used the pool, until then the owner keeps all free objects to itself */
+    std::atomic<bool> shared;
+    std::atomic<int> localFreeCount;
+    std::atomic<int> sharedFreeCount;
+    std::atomic<int> ownerLive;
+    std::atomic<int> foreignLive;
+    std::atomic<int> peakCount;
 };
 
 } // namespace gdx_cpp
 } // namespace utils
 
-#endif // GDX_CPP_UTILS_POOL<T>_HPP_
+#endif // GDX_CPP_UTILS_POOL_HPP_
@@ -0,0 +1,122 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef GDX_CPP_UTILS_RADIXSORT_HPP_
+#define GDX_CPP_UTILS_RADIXSORT_HPP_
+
+#include <algorithm>
+#include <cstring>
+#include <stdint.h>
+#include <vector>
+
+namespace gdx_cpp {
+namespace utils {
+
+/** A stable least significant digit radix sort on 32 bit unsigned keys, in linear time.
+ *
+ * Where sorting by a number is enough, like sprites by depth, this beats any comparison sort for large inputs. Keys
+ * are taken once per element through the key function; floatKey and intKey map floats and signed ints to keys that
+ * sort in the same order. Passes over bytes that all keys share are skipped. The buffers are kept between calls. T must
+ * be default constructible and movable. */
+template < class T >
+class RadixSort {
+public:
+    template < class KeyFunction >
+    void sort (std::vector<T>& a, const KeyFunction& key) {
+        if (!a.empty()) sort(&a[0], a.size(), key);
+    }
+
+    template < class KeyFunction >
+    void sort (T* a, int n, const KeyFunction& key) {
+        if (n < 2) return;
+        if ((int) buffer.size() < n) {
+            buffer.resize(n);
+            keys.resize(n);
+            keyBuffer.resize(n);
+        }
+
+        // one pass builds the histograms of all four bytes
+        uint32_t counts[4][256];
+        std::memset(counts, 0, sizeof(counts));
+        for (int i = 0; i < n; i++) {
+            uint32_t k = key(a[i]);
+            keys[i] = k;
+            counts[0][k & 0xff]++;
+            counts[1][(k >> 8) & 0xff]++;
+            counts[2][(k >> 16) & 0xff]++;
+            counts[3][k >> 24]++;
+        }
+
+        T* source = a;
+        T* destination = &buffer[0];
+        uint32_t* sourceKeys = &keys[0];
+        uint32_t* destinationKeys = &keyBuffer[0];
+
+        for (int pass = 0; pass < 4; pass++) {
+            uint32_t* count = counts[pass];
+            int shift = pass * 8;
+            if (count[(sourceKeys[0] >> shift) & 0xff] == (uint32_t) n) continue;
+
+            uint32_t offset = 0;
+            for (int i = 0; i < 256; i++) {
+                uint32_t c = count[i];
+                count[i] = offset;
+                offset += c;
+            }
+
+            for (int i = 0; i < n; i++) {
+                uint32_t k = sourceKeys[i];
+                uint32_t index = count[(k >> shift) & 0xff]++;
+                destination[index] = std::move(source[i]);
+                destinationKeys[index] = k;
+            }
+
+            std::swap(source, destination);
+            std::swap(sourceKeys, destinationKeys);
+        }
+
+        if (source != a) std::move(source, source + n, a);
+    }
+
+    /** Frees the buffers */
+    void releaseBuffers () {
+        std::vector<T>().swap(buffer);
+        std::vector<uint32_t>().swap(keys);
+        std::vector<uint32_t>().swap(keyBuffer);
+    }
+
+    /** Maps a float to a key sorting in the float's order, negative zero before positive zero */
+    static uint32_t floatKey (float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        // negative floats are flipped entirely, positive ones only get the sign bit set
+        return bits ^ ((uint32_t) -(int32_t) (bits >> 31) | 0x80000000u);
+    }
+
+    static uint32_t intKey (int32_t value) {
+        return (uint32_t) value ^ 0x80000000u;
+    }
+
+private:
+    std::vector<T> buffer;
+    std::vector<uint32_t> keys;
+    std::vector<uint32_t> keyBuffer;
+};
+
+} // namespace gdx_cpp
+} // namespace utils
+
+#endif // GDX_CPP_UTILS_RADIXSORT_HPP_
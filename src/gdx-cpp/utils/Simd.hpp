@@ -0,0 +1,54 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef GDX_CPP_UTILS_SIMD_HPP
+#define GDX_CPP_UTILS_SIMD_HPP
+
+/** Selects the instruction set used by the vectorized kernels. Exactly one of GDX_CPP_SIMD_SSE, GDX_CPP_SIMD_NEON
+ * is defined when SIMD is available; define GDX_CPP_NO_SIMD (cmake -DUSE_SIMD=OFF) to force the scalar paths. */
+#if !defined(GDX_CPP_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define GDX_CPP_SIMD_SSE 1
+#include <emmintrin.h>
+#elif !defined(GDX_CPP_NO_SIMD) && (defined(__ARM_NEON__) || defined(__ARM_NEON))
+#define GDX_CPP_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER)
+#define GDX_CPP_ALIGN(bytes) __declspec(align(bytes))
+#else
+#define GDX_CPP_ALIGN(bytes) __attribute__((aligned(bytes)))
+#endif
+
+namespace gdx_cpp {
+namespace utils {
+namespace simd {
+
+inline const char* instructionSet () {
+#if defined(GDX_CPP_SIMD_SSE)
+    return "sse2";
+#elif defined(GDX_CPP_SIMD_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+}
+}
+}
+
+#endif // GDX_CPP_UTILS_SIMD_HPP
@@ -18,21 +18,43 @@
     @author Ozires Bortolon de Faria ozires@aevumlab.com
 */
 
+
 #ifndef GDX_CPP_UTILS_SORT_HPP_
 #define GDX_CPP_UTILS_SORT_HPP_
 
+#include "TimSort.hpp"
+
+#include <functional>
+#include <vector>
+
 namespace gdx_cpp {
 namespace utils {
 
+/** Stable sorting without keeping a TimSort around: every thread gets one per element and comparator type, so its
+ * merge buffer is reused by the next sort of the same kind. */
 class Sort {
 public:
-    Sort& instance ();
-
-protected:
-
-
-private:
-
+    static Sort& instance () {
+        static Sort sorter;
+        return sorter;
+    }
+
+    template < class T >
+    void sort (std::vector<T>& a) {
+        sort(a, std::less<T>());
+    }
+
+    template < class T, class Compare >
+    void sort (std::vector<T>& a, const Compare& compare) {
+        if (!a.empty()) sort(&a[0], 0, a.size(), compare);
+    }
+
+    /** Sorts a[lo, hi) */
+    template < class T, class Compare >
+    void sort (T* a, int lo, int hi, const Compare& compare) {
+        static thread_local TimSort<T, Compare> timSort;
+        timSort.sort(a, lo, hi, compare);
+    }
 };
 
 } // namespace gdx_cpp
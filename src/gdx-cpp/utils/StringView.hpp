@@ -0,0 +1,105 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef GDX_CPP_UTILS_STRINGVIEW_HPP_
+#define GDX_CPP_UTILS_STRINGVIEW_HPP_
+
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+namespace gdx_cpp {
+namespace utils {
+
+/** A pointer and length into characters owned by someone else, usually a parser's input buffer. Not NUL terminated.
+ * Valid only as long as the characters it points at. */
+class StringView {
+public:
+    StringView ()
+    : data(NULL)
+    , length(0)
+    {
+    }
+
+    StringView (const char* data, size_t length)
+    : data(data)
+    , length(length)
+    {
+    }
+
+    StringView (const char* string)
+    : data(string)
+    , length(std::strlen(string))
+    {
+    }
+
+    StringView (const std::string& string)
+    : data(string.data())
+    , length(string.size())
+    {
+    }
+
+    const char* begin () const {
+        return data;
+    }
+
+    const char* end () const {
+        return data + length;
+    }
+
+    size_t size () const {
+        return length;
+    }
+
+    bool empty () const {
+        return length == 0;
+    }
+
+    char operator[] (size_t index) const {
+        return data[index];
+    }
+
+    std::string str () const {
+        return std::string(data, length);
+    }
+
+    bool operator== (const StringView& other) const {
+        return length == other.length && (length == 0 || std::memcmp(data, other.data, length) == 0);
+    }
+
+    bool operator!= (const StringView& other) const {
+        return !(*this == other);
+    }
+
+    bool operator< (const StringView& other) const {
+        size_t common = length < other.length ? length : other.length;
+        int order = common ? std::memcmp(data, other.data, common) : 0;
+        return order < 0 || (order == 0 && length < other.length);
+    }
+
+    const char* data;
+    size_t length;
+};
+
+inline std::ostream& operator<< (std::ostream& out, const StringView& view) {
+    return out.write(view.data, view.length);
+}
+
+} // namespace gdx_cpp
+} // namespace utils
+
+#endif // GDX_CPP_UTILS_STRINGVIEW_HPP_
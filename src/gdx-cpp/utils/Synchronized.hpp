@@ -20,78 +20,68 @@
 #define GDX_CPP_UTILS_SYNCHRONIZED_HPP
 
 #include "LockGuard.hpp"
-#include "gdx-cpp/implementation/Mutex.hpp"
-#include "gdx-cpp/implementation/MutexFactory.hpp"
-#include "gdx-cpp/utils/Aliases.hpp"
+#include "Mutex.hpp"
 
-#include <tr1/shared_ptr.h>
+#include <utility>
 
-class Mutex;
-class Mutex;
-template <typename Object, typename MutexType>
+namespace gdx_cpp {
+namespace utils {
+
+/** Access to an object while holding a lock, released when the synchronized goes out of scope:
+ *     synchronize(queue, mutex)->push_back(value);
+ * Only refers to the object, which must outlive it. */
+template <typename T, typename Lockable = Mutex>
 class synchronized {
-    typedef lock_guard<MutexType> lock_type;
-    typedef typename ref_ptr_maker<Object>::type obj_ptr;
 public:
-    synchronized(obj_ptr obj, MutexType& mutex) :
-        ref_object(obj), lock(mutex)
+    synchronized (T& object, Lockable& lockable)
+    : object(&object)
+    , guard(lockable)
     {
     }
 
-    synchronized(const synchronized<Object, MutexType>& other) :
-        ref_object(other.ref_object), lock(other.lock.getMutex())
-    {        
-    }
-    synchronized(const Object& obj, MutexType& mutex) :
-    ref_object(new Object(obj)), lock(mutex)
+    synchronized (synchronized&& other)
+    : object(other.object)
+    , guard(std::move(other.guard))
     {
     }
 
-    Object* operator ->() {
-        //OMG proxy rules!
-        return ref_object;
+    T* operator-> () const {
+        return object;
     }
 
-    Object& operator *() {
-        return *ref_object.get();
+    T& operator* () const {
+        return *object;
     }
-    
-protected:
-    obj_ptr ref_object;
-    lock_type lock;
-};
 
-template <typename T>
-struct gdx_sync {
-    typedef synchronized<T, gdx_cpp::implementation::Mutex> type;
+private:
+    T* object;
+    LockGuard<Lockable> guard;
 };
 
-template <typename MutexFactory>
-struct Synchronizable {
-    typedef lock_guard<typename MutexFactory::mutex_t> lock_holder;
-    
-    Synchronizable(MutexFactory* fact) :
-        mutex(fact->createMutex())
-    {        
-    }
-    
-    template <typename T>
-    synchronized<T, typename MutexFactory::mutex_t> synchronize(T& obj) {
-        return synchronized<T, typename MutexFactory::mutex_t>(obj, *mutex);
+template <typename T, typename Lockable>
+synchronized<T, Lockable> synchronize (T& object, Lockable& lockable) {
+    return synchronized<T, Lockable>(object, lockable);
+}
+
+/** Base for classes guarding their state with a mutex of their own */
+class Synchronizable {
+public:
+    typedef LockGuard<Mutex> lock_holder;
+
+    lock_holder synchronize () {
+        return lock_holder(syncMutex);
     }
 
-    lock_holder synchronize() {
-        return lock_holder(*mutex);
+    template <typename T>
+    synchronized<T> synchronize (T& object) {
+        return synchronized<T>(object, syncMutex);
     }
 
-private:
-    typename MutexFactory::mutex_ptr mutex;
+protected:
+    Mutex syncMutex;
 };
 
-namespace gdx_cpp {
-    
-typedef Synchronizable<implementation::MutexFactory> Synchronizable;
+} // namespace gdx_cpp
+} // namespace utils
 
-}
 #endif
-class Mutex;
@@ -18,35 +18,562 @@
     @author Ozires Bortolon de Faria ozires@aevumlab.com
 */
 
-#ifndef GDX_CPP_UTILS_TIMSORT<T>_HPP_
-#define GDX_CPP_UTILS_TIMSORT<T>_HPP_
+
+#ifndef GDX_CPP_UTILS_TIMSORT_HPP_
+#define GDX_CPP_UTILS_TIMSORT_HPP_
+
+#include "gdx-cpp/implementation/JobSystem.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
 
 namespace gdx_cpp {
 namespace utils {
 
+/** A stable, adaptive merge sort that runs in close to linear time on partially sorted input, as a sprite list sorted
+ * by depth last frame is.
+ *
+ * The merge buffer is kept between calls, so sorting with the same instance every frame doesn't allocate once the
+ * buffer has grown to the largest input. T must be default constructible and movable. Compare is a strict weak
+ * ordering like std::less. An instance must only sort on one thread at a time, parallelSort spreads the work itself. */
+template < class T, class Compare = std::less<T> >
 class TimSort {
 public:
-    void doSort (const Comparator<T>& c,int lo,int hi);
+    void sort (std::vector<T>& a, const Compare& compare = Compare()) {
+        if (!a.empty()) sort(&a[0], 0, a.size(), compare);
+    }
+
+    /** Sorts a[lo, hi) */
+    void sort (T* a, int lo, int hi, const Compare& compare = Compare()) {
+        int n = hi - lo;
+        if (n < 2) return;
+        if (n >= MIN_MERGE && (int) buffer.size() < n / 2) buffer.resize(n / 2);
+
+        Merger merger(a, buffer.empty() ? NULL : &buffer[0], compare);
+        merger.sort(lo, hi);
+    }
+
+    void parallelSort (implementation::JobSystem& jobs, std::vector<T>& a, const Compare& compare = Compare(),
+                       int minChunk = 8192) {
+        if (!a.empty()) parallelSort(jobs, &a[0], a.size(), compare, minChunk);
+    }
+
+    /** Sorts chunks of a[0, n) on the job system's threads and merges them in parallel rounds. Inputs shorter than two
+     * minChunk sized chunks are sorted on the calling thread. The buffer grows to n elements. */
+    void parallelSort (implementation::JobSystem& jobs, T* a, int n, const Compare& compare = Compare(),
+                       int minChunk = 8192) {
+        int chunks = std::min(jobs.getThreadCount() * 2, n / std::max(minChunk, 1));
+        if (chunks < 2) {
+            sort(a, 0, n, compare);
+            return;
+        }
+
+        if ((int) buffer.size() < n) buffer.resize(n);
+        runs.resize(chunks + 1);
+        for (int i = 0; i <= chunks; i++)
+            runs[i] = (int) ((long long) n * i / chunks);
 
-protected:
+        ParallelContext context = { this, a, &buffer[0], &compare };
+        jobs.parallelFor(0, chunks, 1, [&context] (int begin, int end) {
+            context.sortChunks(begin, end);
+        });
 
+        // merge pairs of runs back and forth between a and the buffer until one is left
+        T* source = a;
+        T* destination = &buffer[0];
+        int pieceSize = std::max(minChunk, n / (jobs.getThreadCount() * 4));
+        while (runs.size() > 2) {
+            pieces.clear();
+            int runCount = runs.size() - 1;
+            for (int i = 0; i < runCount; i += 2) {
+                int end = i + 2 <= runCount ? runs[i + 2] : runs[i + 1];
+                for (int start = runs[i]; start < end; start += pieceSize) {
+                    Piece piece = { i, start - runs[i], std::min(start + pieceSize, end) - runs[i] };
+                    pieces.push_back(piece);
+                }
+            }
+
+            context.source = source;
+            context.destination = destination;
+            jobs.parallelFor(0, pieces.size(), 1, [&context] (int begin, int end) {
+                context.mergePieces(begin, end);
+            });
+
+            int kept = 0;
+            for (int i = 0; i < runCount; i += 2)
+                runs[kept++] = runs[i];
+            runs[kept++] = n;
+            runs.resize(kept);
+            std::swap(source, destination);
+        }
+
+        if (source != a) {
+            context.source = source;
+            jobs.parallelFor(0, n, pieceSize, [&context] (int begin, int end) {
+                std::move(context.source + begin, context.source + end, context.a + begin);
+            });
+        }
+    }
+
+    /** Frees the merge buffer */
+    void releaseBuffer () {
+        std::vector<T>().swap(buffer);
+    }
 
 private:
-    static void reverseRange (int lo,int hi);
-    static int minRunLength (int n);
-    void pushRun (int runBase,int runLen);
-    void mergeCollapse ();
-    void mergeForceCollapse ();
-    void mergeAt (int i);
-    void mergeLo (int base1,int len1,int base2,int len2);
-    void mergeHi (int base1,int len1,int base2,int len2);
-    T* ensureCapacity (int minCapacity);
-    static void rangeCheck (int arrayLen,int fromIndex,int toIndex);
-    int[] runBase;
-    int[] runLen;
+    enum {
+        /** shorter runs are extended with a binary insertion sort */
+        MIN_MERGE = 32,
+        MIN_GALLOP = 7,
+        /** enough for any array whose length fits an int */
+        MAX_RUNS = 49
+    };
+
+    /** One sort of a range. Indices into a are absolute, the merge buffer tmp is indexed from 0 and has to hold half
+     * the range. */
+    class Merger {
+    public:
+        Merger (T* a, T* tmp, const Compare& compare)
+        : a(a)
+        , tmp(tmp)
+        , compare(compare)
+        , minGallop(MIN_GALLOP)
+        , stackSize(0)
+        {
+        }
+
+        void sort (int lo, int hi) {
+            int remaining = hi - lo;
+            if (remaining < MIN_MERGE) {
+                binarySort(lo, hi, lo + countRunAndMakeAscending(lo, hi));
+                return;
+            }
+
+            int minRun = minRunLength(remaining);
+            do {
+                int runLength = countRunAndMakeAscending(lo, hi);
+                if (runLength < minRun) {
+                    int force = remaining <= minRun ? remaining : minRun;
+                    binarySort(lo, lo + force, lo + runLength);
+                    runLength = force;
+                }
+
+                pushRun(lo, runLength);
+                mergeCollapse();
+
+                lo += runLength;
+                remaining -= runLength;
+            } while (remaining != 0);
+
+            mergeForceCollapse();
+        }
+
+    private:
+        T* a;
+        T* tmp;
+        const Compare& compare;
+        int minGallop;
+        int stackSize;
+        int runBase[MAX_RUNS];
+        int runLength[MAX_RUNS];
+
+        /** Sorts a[lo, hi) by insertion, a[lo, start) is already sorted */
+        void binarySort (int lo, int hi, int start) {
+            if (start == lo) start++;
+            for (; start < hi; start++) {
+                T pivot = std::move(a[start]);
+                int left = lo, right = start;
+                while (left < right) {
+                    int middle = (left + right) >> 1;
+                    if (compare(pivot, a[middle]))
+                        right = middle;
+                    else
+                        left = middle + 1;
+                }
+                std::move_backward(a + left, a + start, a + start + 1);
+                a[left] = std::move(pivot);
+            }
+        }
+
+        /** Length of the run starting at lo, reversed if it is strictly descending */
+        int countRunAndMakeAscending (int lo, int hi) {
+            int runHi = lo + 1;
+            if (runHi == hi) return 1;
+
+            if (compare(a[runHi++], a[lo])) {
+                while (runHi < hi && compare(a[runHi], a[runHi - 1]))
+                    runHi++;
+                std::reverse(a + lo, a + runHi);
+            } else {
+                while (runHi < hi && !compare(a[runHi], a[runHi - 1]))
+                    runHi++;
+            }
+            return runHi - lo;
+        }
+
+        static int minRunLength (int n) {
+            int r = 0;
+            while (n >= MIN_MERGE) {
+                r |= n & 1;
+                n >>= 1;
+            }
+            return n + r;
+        }
+
+        void pushRun (int base, int length) {
+            runBase[stackSize] = base;
+            runLength[stackSize] = length;
+            stackSize++;
+        }
+
+        /** Merges runs until the lengths on the stack decrease faster than the Fibonacci numbers */
+        void mergeCollapse () {
+            while (stackSize > 1) {
+                int n = stackSize - 2;
+                if ((n > 0 && runLength[n - 1] <= runLength[n] + runLength[n + 1]) ||
+                    (n > 1 && runLength[n - 2] <= runLength[n] + runLength[n - 1])) {
+                    if (runLength[n - 1] < runLength[n + 1]) n--;
+                } else if (runLength[n] > runLength[n + 1]) {
+                    break;
+                }
+                mergeAt(n);
+            }
+        }
+
+        void mergeForceCollapse () {
+            while (stackSize > 1) {
+                int n = stackSize - 2;
+                if (n > 0 && runLength[n - 1] < runLength[n + 1]) n--;
+                mergeAt(n);
+            }
+        }
+
+        void mergeAt (int i) {
+            int base1 = runBase[i], length1 = runLength[i];
+            int base2 = runBase[i + 1], length2 = runLength[i + 1];
+
+            runLength[i] = length1 + length2;
+            if (i == stackSize - 3) {
+                runBase[i + 1] = runBase[i + 2];
+                runLength[i + 1] = runLength[i + 2];
+            }
+            stackSize--;
+
+            // the elements of run 1 that are already in place and those of run 2 that are, at the end, are skipped
+            int k = gallopRight(a[base2], a, base1, length1, 0);
+            base1 += k;
+            length1 -= k;
+            if (length1 == 0) return;
+
+            length2 = gallopLeft(a[base1 + length1 - 1], a, base2, length2, length2 - 1);
+            if (length2 == 0) return;
+
+            if (length1 <= length2)
+                mergeLo(base1, length1, base2, length2);
+            else
+                mergeHi(base1, length1, base2, length2);
+        }
+
+        /** The position in array[base, base + length) to insert key at, before any equal elements */
+        int gallopLeft (const T& key, const T* array, int base, int length, int hint) const {
+            int lastOffset = 0, offset = 1;
+            if (compare(array[base + hint], key)) {
+                int maxOffset = length - hint;
+                while (offset < maxOffset && compare(array[base + hint + offset], key)) {
+                    lastOffset = offset;
+                    offset = offset < maxOffset / 2 ? (offset << 1) + 1 : maxOffset;
+                }
+                if (offset > maxOffset) offset = maxOffset;
+                lastOffset += hint;
+                offset += hint;
+            } else {
+                int maxOffset = hint + 1;
+                while (offset < maxOffset && !compare(array[base + hint - offset], key)) {
+                    lastOffset = offset;
+                    offset = offset < maxOffset / 2 ? (offset << 1) + 1 : maxOffset;
+                }
+                if (offset > maxOffset) offset = maxOffset;
+                int previous = lastOffset;
+                lastOffset = hint - offset;
+                offset = hint - previous;
+            }
+
+            lastOffset++;
+            while (lastOffset < offset) {
+                int middle = lastOffset + ((offset - lastOffset) >> 1);
+                if (compare(array[base + middle], key))
+                    lastOffset = middle + 1;
+                else
+                    offset = middle;
+            }
+            return offset;
+        }
+
+        /** The position in array[base, base + length) to insert key at, after any equal elements */
+        int gallopRight (const T& key, const T* array, int base, int length, int hint) const {
+            int lastOffset = 0, offset = 1;
+            if (compare(key, array[base + hint])) {
+                int maxOffset = hint + 1;
+                while (offset < maxOffset && compare(key, array[base + hint - offset])) {
+                    lastOffset = offset;
+                    offset = offset < maxOffset / 2 ? (offset << 1) + 1 : maxOffset;
+                }
+                if (offset > maxOffset) offset = maxOffset;
+                int previous = lastOffset;
+                lastOffset = hint - offset;
+                offset = hint - previous;
+            } else {
+                int maxOffset = length - hint;
+                while (offset < maxOffset && !compare(key, array[base + hint + offset])) {
+                    lastOffset = offset;
+                    offset = offset < maxOffset / 2 ? (offset << 1) + 1 : maxOffset;
+                }
+                if (offset > maxOffset) offset = maxOffset;
+                lastOffset += hint;
+                offset += hint;
+            }
+
+            lastOffset++;
+            while (lastOffset < offset) {
+                int middle = lastOffset + ((offset - lastOffset) >> 1);
+                if (compare(key, array[base + middle]))
+                    offset = middle;
+                else
+                    lastOffset = middle + 1;
+            }
+            return offset;
+        }
+
+        /** Merges the adjacent runs in place, run 1 being the shorter one. Its first element must be greater than
+         * run 2's first and its last greater than all of run 2. */
+        void mergeLo (int base1, int length1, int base2, int length2) {
+            std::move(a + base1, a + base1 + length1, tmp);
+            int cursor1 = 0, cursor2 = base2, destination = base1;
+
+            a[destination++] = std::move(a[cursor2++]);
+            if (--length2 == 0) {
+                std::move(tmp + cursor1, tmp + cursor1 + length1, a + destination);
+                return;
+            }
+            if (length1 == 1) {
+                std::move(a + cursor2, a + cursor2 + length2, a + destination);
+                a[destination + length2] = std::move(tmp[cursor1]);
+                return;
+            }
+
+            int minGallop = this->minGallop;
+            for (;;) {
+                int count1 = 0, count2 = 0;
+
+                // one at a time until one run keeps winning
+                do {
+                    if (compare(a[cursor2], tmp[cursor1])) {
+                        a[destination++] = std::move(a[cursor2++]);
+                        count2++;
+                        count1 = 0;
+                        if (--length2 == 0) goto done;
+                    } else {
+                        a[destination++] = std::move(tmp[cursor1++]);
+                        count1++;
+                        count2 = 0;
+                        if (--length1 == 1) goto done;
+                    }
+                } while ((count1 | count2) < minGallop);
+
+                // then gallop until neither run wins by much
+                do {
+                    count1 = gallopRight(a[cursor2], tmp, cursor1, length1, 0);
+                    if (count1 != 0) {
+                        std::move(tmp + cursor1, tmp + cursor1 + count1, a + destination);
+                        destination += count1;
+                        cursor1 += count1;
+                        length1 -= count1;
+                        if (length1 <= 1) goto done;
+                    }
+                    a[destination++] = std::move(a[cursor2++]);
+                    if (--length2 == 0) goto done;
+
+                    count2 = gallopLeft(tmp[cursor1], a, cursor2, length2, 0);
+                    if (count2 != 0) {
+                        std::move(a + cursor2, a + cursor2 + count2, a + destination);
+                        destination += count2;
+                        cursor2 += count2;
+                        length2 -= count2;
+                        if (length2 == 0) goto done;
+                    }
+                    a[destination++] = std::move(tmp[cursor1++]);
+                    if (--length1 == 1) goto done;
+                    minGallop--;
+                } while (count1 >= MIN_GALLOP || count2 >= MIN_GALLOP);
+
+                if (minGallop < 0) minGallop = 0;
+                minGallop += 2;
+            }
+
+        done:
+            this->minGallop = minGallop < 1 ? 1 : minGallop;
+            if (length1 == 1) {
+                std::move(a + cursor2, a + cursor2 + length2, a + destination);
+                a[destination + length2] = std::move(tmp[cursor1]);
+            } else if (length1 == 0) {
+                throw std::runtime_error("Comparison method violates its general contract!");
+            } else {
+                std::move(tmp + cursor1, tmp + cursor1 + length1, a + destination);
+            }
+        }
+
+        /** Like mergeLo, merging from the end with run 2 being the shorter one */
+        void mergeHi (int base1, int length1, int base2, int length2) {
+            std::move(a + base2, a + base2 + length2, tmp);
+            int cursor1 = base1 + length1 - 1, cursor2 = length2 - 1, destination = base2 + length2 - 1;
+
+            a[destination--] = std::move(a[cursor1--]);
+            if (--length1 == 0) {
+                std::move(tmp, tmp + length2, a + destination - (length2 - 1));
+                return;
+            }
+            if (length2 == 1) {
+                destination -= length1;
+                cursor1 -= length1;
+                std::move_backward(a + cursor1 + 1, a + cursor1 + 1 + length1, a + destination + 1 + length1);
+                a[destination] = std::move(tmp[cursor2]);
+                return;
+            }
+
+            int minGallop = this->minGallop;
+            for (;;) {
+                int count1 = 0, count2 = 0;
+
+                do {
+                    if (compare(tmp[cursor2], a[cursor1])) {
+                        a[destination--] = std::move(a[cursor1--]);
+                        count1++;
+                        count2 = 0;
+                        if (--length1 == 0) goto done;
+                    } else {
+                        a[destination--] = std::move(tmp[cursor2--]);
+                        count2++;
+                        count1 = 0;
+                        if (--length2 == 1) goto done;
+                    }
+                } while ((count1 | count2) < minGallop);
+
+                do {
+                    count1 = length1 - gallopRight(tmp[cursor2], a, base1, length1, length1 - 1);
+                    if (count1 != 0) {
+                        destination -= count1;
+                        cursor1 -= count1;
+                        length1 -= count1;
+                        std::move_backward(a + cursor1 + 1, a + cursor1 + 1 + count1, a + destination + 1 + count1);
+                        if (length1 == 0) goto done;
+                    }
+                    a[destination--] = std::move(tmp[cursor2--]);
+                    if (--length2 == 1) goto done;
+
+                    count2 = length2 - gallopLeft(a[cursor1], tmp, 0, length2, length2 - 1);
+                    if (count2 != 0) {
+                        destination -= count2;
+                        cursor2 -= count2;
+                        length2 -= count2;
+                        std::move(tmp + cursor2 + 1, tmp + cursor2 + 1 + count2, a + destination + 1);
+                        if (length2 <= 1) goto done;
+                    }
+                    a[destination--] = std::move(a[cursor1--]);
+                    if (--length1 == 0) goto done;
+                    minGallop--;
+                } while (count1 >= MIN_GALLOP || count2 >= MIN_GALLOP);
+
+                if (minGallop < 0) minGallop = 0;
+                minGallop += 2;
+            }
+
+        done:
+            this->minGallop = minGallop < 1 ? 1 : minGallop;
+            if (length2 == 1) {
+                destination -= length1;
+                cursor1 -= length1;
+                std::move_backward(a + cursor1 + 1, a + cursor1 + 1 + length1, a + destination + 1 + length1);
+                a[destination] = std::move(tmp[cursor2]);
+            } else if (length2 == 0) {
+                throw std::runtime_error("Comparison method violates its general contract!");
+            } else {
+                std::move(tmp, tmp + length2, a + destination - (length2 - 1));
+            }
+        }
+    };
+
+    /** Part of the merge of runs[run, run + 1) with runs[run + 1, run + 2): the output positions [begin, end),
+     * relative to the start of the first run */
+    struct Piece {
+        int run;
+        int begin;
+        int end;
+    };
+
+    /** Shared by the jobs of a parallel sort, kept small so capturing it doesn't allocate */
+    struct ParallelContext {
+        TimSort* sorter;
+        T* a;
+        T* buffer;
+        const Compare* compare;
+        T* source;
+        T* destination;
+
+        void sortChunks (int begin, int end) {
+            const std::vector<int>& runs = sorter->runs;
+            for (int i = begin; i < end; i++) {
+                // the chunk's part of the buffer is more than the half it needs
+                Merger merger(a, buffer + runs[i], *compare);
+                merger.sort(runs[i], runs[i + 1]);
+            }
+        }
+
+        void mergePieces (int begin, int end) {
+            const std::vector<int>& runs = sorter->runs;
+            int runCount = runs.size() - 1;
+            for (int i = begin; i < end; i++) {
+                const Piece& piece = sorter->pieces[i];
+                int start = runs[piece.run];
+                int middle = runs[piece.run + 1];
+                int stop = piece.run + 2 <= runCount ? runs[piece.run + 2] : middle;
+                const T* first = source + start;
+                const T* second = source + middle;
+                int length1 = middle - start, length2 = stop - middle;
+
+                int i1 = coRank(piece.begin, first, length1, second, length2);
+                int i2 = coRank(piece.end, first, length1, second, length2);
+                std::merge(std::make_move_iterator(source + start + i1),
+                           std::make_move_iterator(source + start + i2),
+                           std::make_move_iterator(source + middle + piece.begin - i1),
+                           std::make_move_iterator(source + middle + piece.end - i2),
+                           destination + start + piece.begin, *compare);
+            }
+        }
+
+        /** How many of the first k merged elements come from the first run, ties going to the first run */
+        int coRank (int k, const T* first, int length1, const T* second, int length2) const {
+            int lo = std::max(0, k - length2), hi = std::min(k, length1);
+            while (lo < hi) {
+                int i = lo + (hi - lo) / 2;
+                int j = k - i;
+                if (j > 0 && !(*compare)(second[j - 1], first[i]))
+                    lo = i + 1;
+                else
+                    hi = i;
+            }
+            return lo;
+        }
+    };
+
+    std::vector<T> buffer;
+    std::vector<int> runs;
+    std::vector<Piece> pieces;
 };
 
 } // namespace gdx_cpp
 } // namespace utils
 
-#endif // GDX_CPP_UTILS_TIMSORT<T>_HPP_
+#endif // GDX_CPP_UTILS_TIMSORT_HPP_
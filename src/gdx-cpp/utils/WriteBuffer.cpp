@@ -0,0 +1,174 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include "WriteBuffer.hpp"
+#include "JsonReader.hpp"
+
+#include <clocale>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
+using namespace gdx_cpp::utils;
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#define GDX_CPP_HAS_TO_CHARS
+#endif
+
+WriteBuffer::WriteBuffer (size_t capacity)
+: sink(NULL)
+, begin(NULL)
+, top(NULL)
+, limit(NULL)
+{
+    grow(capacity);
+}
+
+WriteBuffer::WriteBuffer (OutputSink& sink, size_t capacity)
+: sink(&sink)
+, begin(NULL)
+, top(NULL)
+, limit(NULL)
+{
+    grow(capacity);
+}
+
+WriteBuffer::~WriteBuffer () {
+    // the sink gets what is left; a destructor can't report its errors, so they are dropped
+    try {
+        flush();
+    } catch (...) {
+    }
+    std::free(begin);
+}
+
+void WriteBuffer::grow (size_t length) {
+    size_t size = top - begin;
+    size_t capacity = limit - begin;
+    size_t needed = size + length;
+    if (capacity == 0) capacity = 256;
+    while (capacity < needed)
+        capacity *= 2;
+
+    char* memory = static_cast<char*>(std::realloc(begin, capacity));
+    if (memory == NULL) throw std::bad_alloc();
+    begin = memory;
+    top = memory + size;
+    limit = memory + capacity;
+}
+
+void WriteBuffer::makeRoom (size_t length) {
+    if (sink != NULL && top != begin) {
+        sink->write(begin, top - begin);
+        top = begin;
+    }
+    if ((size_t) (limit - top) < length) grow(length);
+}
+
+void WriteBuffer::appendSlow (const char* data, size_t length) {
+    if (sink != NULL) {
+        if (top != begin) {
+            sink->write(begin, top - begin);
+            top = begin;
+        }
+        // more than fits is passed straight through instead of growing the buffer
+        if (length >= (size_t) (limit - begin)) {
+            sink->write(data, length);
+            return;
+        }
+    } else {
+        grow(length);
+    }
+    std::memcpy(top, data, length);
+    top += length;
+}
+
+void WriteBuffer::flush () {
+    if (sink == NULL) return;
+    if (top != begin) sink->write(begin, top - begin);
+    top = begin;
+    sink->flush();
+}
+
+void WriteBuffer::clear () {
+    top = begin;
+}
+
+void WriteBuffer::appendInt (long long value) {
+    char digits[24];
+    char* end = digits + sizeof(digits);
+    char* p = end;
+    unsigned long long magnitude = value < 0 ? 0ull - (unsigned long long) value : (unsigned long long) value;
+    do {
+        *--p = (char) ('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (value < 0) *--p = '-';
+    append(p, end - p);
+}
+
+void WriteBuffer::appendDouble (double value) {
+    commit(formatDouble(reserve(maxNumberLength), value));
+}
+
+void WriteBuffer::appendFloat (float value) {
+    commit(formatFloat(reserve(maxNumberLength), value));
+}
+
+#ifndef GDX_CPP_HAS_TO_CHARS
+/** printf writes the locale's decimal point */
+static int toClassicLocale (char* out, int length) {
+    char point = std::localeconv()->decimal_point[0];
+    if (point != '.') {
+        for (int i = 0; i < length; i++)
+            if (out[i] == point) out[i] = '.';
+    }
+    return length;
+}
+#endif
+
+int WriteBuffer::formatDouble (char* out, double value) {
+#ifdef GDX_CPP_HAS_TO_CHARS
+    return (int) (std::to_chars(out, out + maxNumberLength, value).ptr - out);
+#else
+    // the fewest significant digits that read back to the same value
+    int length = 0;
+    for (int precision = 15; precision <= 17; precision++) {
+        length = toClassicLocale(out, std::snprintf(out, maxNumberLength, "%.*g", precision, value));
+        if (value != value || JsonReader::parseNumber(out, out + length) == value) break;
+    }
+    return length;
+#endif
+}
+
+int WriteBuffer::formatFloat (char* out, float value) {
+#ifdef GDX_CPP_HAS_TO_CHARS
+    return (int) (std::to_chars(out, out + maxNumberLength, value).ptr - out);
+#else
+    int length = 0;
+    for (int precision = 6; precision <= 9; precision++) {
+        length = toClassicLocale(out, std::snprintf(out, maxNumberLength, "%.*g", precision, (double) value));
+        if (value != value || (float) JsonReader::parseNumber(out, out + length) == value) break;
+    }
+    return length;
+#endif
+}
@@ -0,0 +1,126 @@
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#ifndef GDX_CPP_UTILS_WRITEBUFFER_HPP_
+#define GDX_CPP_UTILS_WRITEBUFFER_HPP_
+
+#include "StringView.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+namespace gdx_cpp {
+namespace utils {
+
+/** Where a WriteBuffer hands its bytes when it fills up or is flushed */
+class OutputSink {
+public:
+    virtual ~OutputSink () {}
+
+    virtual void write (const char* data, size_t length) = 0;
+    virtual void flush () {}
+};
+
+/** Bytes appended in place, for writers that shouldn't build strings piece by piece.
+ *
+ * Without a sink the buffer grows as needed and keeps everything until clear(), which keeps the memory, so a buffer
+ * that is reused for every save writes without allocating once it has grown to size. With a sink it has a fixed
+ * capacity and passes its contents on whenever it is full, so huge outputs stream through a small buffer. The
+ * destructor flushes to the sink and ignores its errors, so call flush() when a failed write has to be noticed. Numbers
+ * are formatted the same in every locale, floating point ones as the shortest text that reads back to the same
+ * value. */
+class WriteBuffer {
+public:
+    explicit WriteBuffer (size_t capacity = 4 * 1024);
+    explicit WriteBuffer (OutputSink& sink, size_t capacity = 64 * 1024);
+    ~WriteBuffer ();
+
+    void append (char c) {
+        if (top == limit) makeRoom(1);
+        *top++ = c;
+    }
+
+    void append (const char* data, size_t length) {
+        if ((size_t) (limit - top) < length) {
+            appendSlow(data, length);
+            return;
+        }
+        std::memcpy(top, data, length);
+        top += length;
+    }
+
+    void append (const StringView& text) {
+        append(text.data, text.size());
+    }
+
+    void appendInt (long long value);
+    void appendDouble (double value);
+    /** Shortest as a float, so 0.1f is written as 0.1 */
+    void appendFloat (float value);
+
+    /** Room for at least length more bytes, which are added with commit() once they are written */
+    char* reserve (size_t length) {
+        if ((size_t) (limit - top) < length) makeRoom(length);
+        return top;
+    }
+
+    void commit (size_t length) {
+        top += length;
+    }
+
+    /** Hands everything to the sink and flushes it. Does nothing without a sink. */
+    void flush ();
+    /** Drops the contents, keeping the memory */
+    void clear ();
+
+    /** What was appended since the last flush or clear */
+    const char* getData () const {
+        return begin;
+    }
+
+    size_t getSize () const {
+        return top - begin;
+    }
+
+    std::string toString () const {
+        return std::string(begin, top - begin);
+    }
+
+    /** The most characters appendDouble and appendFloat write */
+    static const int maxNumberLength = 32;
+    /** Formats the number into out, returns the length */
+    static int formatDouble (char* out, double value);
+    static int formatFloat (char* out, float value);
+
+private:
+    WriteBuffer (const WriteBuffer&);
+    WriteBuffer& operator= (const WriteBuffer&);
+
+    void makeRoom (size_t length);
+    void appendSlow (const char* data, size_t length);
+    void grow (size_t length);
+
+    OutputSink* sink;
+    char* begin;
+    char* top;
+    char* limit;
+};
+
+} // namespace gdx_cpp
+} // namespace utils
+
+#endif // GDX_CPP_UTILS_WRITEBUFFER_HPP_
@@ -1,593 +1,560 @@
-
-/*
-    Copyright 2011 Aevum Software aevum @ aevumlab.com
-
-    Licensed under the Apache License, Version 2.0 (the "License");
-    you may not use this file except in compliance with the License.
-    You may obtain a copy of the License at
-
-        http://www.apache.org/licenses/LICENSE-2.0
-
-    Unless required by applicable law or agreed to in writing, software
-    distributed under the License is distributed on an "AS IS" BASIS,
-    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
-    See the License for the specific language governing permissions and
-    limitations under the License.
-
-    @author Victor Vicente de Carvalho victor.carvalho@aevumlab.com
-    @author Ozires Bortolon de Faria ozires@aevumlab.com
-*/
-
-#include "XmlReader.hpp"
-
-using namespace gdx_cpp::utils;
-
-Element& XmlReader::parse (const std::string& xml) {
-    char[] data = xml.toCharArray();
-    return parse(data, 0, data.length);
-}
-
-Element& XmlReader::parse (const Reader& reader) throws IOException {
-    char[] data = new char[1024];
-    int offset = 0;
-    while (true) {
-        int length = reader.read(data, offset, data.length - offset);
-        if (length == -1) break;
-        if (length == 0) {
-            char[] newData = new char[data.length * 2];
-            System.arraycopy(data, 0, newData, 0, data.length);
-            data = newData;
-        } else
-            offset += length;
-    }
-    return parse(data, 0, offset);
-}
-
-Element& XmlReader::parse (const InputStream& input) throws IOException {
-    return parse(new InputStreamReader(input, "ISO-8859-1"));
-}
-
-Element& XmlReader::parse (const gdx_cpp::files::FileHandle& file) throws IOException {
-    return parse(file.read());
-}
-
-Element& XmlReader::parse (int offset,int length) {
-    int cs, p = offset, pe = length;
-
-    int s = 0;
-    String attributeName = null;
-    boolean hasBody = false;
-
-    // line 3 "Xml.java"
-    {
-        cs = xml_start;
-    }
-
-    // line 7 "Xml.java"
-    {
-        int _klen;
-        int _trans = 0;
-        int _acts;
-        int _nacts;
-        int _keys;
-        int _goto_targ = 0;
-
-_goto:
-        while (true) {
-            switch (_goto_targ) {
-            case 0:
-                if (p == pe) {
-                    _goto_targ = 4;
-                    continue _goto;
-                }
-                if (cs == 0) {
-                    _goto_targ = 5;
-                    continue _goto;
-                }
-            case 1:
-_match:
-                do {
-                    _keys = _xml_key_offsets[cs];
-                    _trans = _xml_index_offsets[cs];
-                    _klen = _xml_single_lengths[cs];
-                    if (_klen > 0) {
-                        int _lower = _keys;
-                        int _mid;
-                        int _upper = _keys + _klen - 1;
-                        while (true) {
-                            if (_upper < _lower) break;
-
-                            _mid = _lower + ((_upper - _lower) >> 1);
-                            if (data[p] < _xml_trans_keys[_mid])
-                                _upper = _mid - 1;
-                            else if (data[p] > _xml_trans_keys[_mid])
-                                _lower = _mid + 1;
-                            else {
-                                _trans += (_mid - _keys);
-                                break _match;
-                            }
-                        }
-                        _keys += _klen;
-                        _trans += _klen;
-                    }
-
-                    _klen = _xml_range_lengths[cs];
-                    if (_klen > 0) {
-                        int _lower = _keys;
-                        int _mid;
-                        int _upper = _keys + (_klen << 1) - 2;
-                        while (true) {
-                            if (_upper < _lower) break;
-
-                            _mid = _lower + (((_upper - _lower) >> 1) & ~1);
-                            if (data[p] < _xml_trans_keys[_mid])
-                                _upper = _mid - 2;
-                            else if (data[p] > _xml_trans_keys[_mid + 1])
-                                _lower = _mid + 2;
-                            else {
-                                _trans += ((_mid - _keys) >> 1);
-                                break _match;
-                            }
-                        }
-                        _trans += _klen;
-                    }
-                } while (false);
-
-                _trans = _xml_indicies[_trans];
-                cs = _xml_trans_targs[_trans];
-
-                if (_xml_trans_actions[_trans] != 0) {
-                    _acts = _xml_trans_actions[_trans];
-                    _nacts = (int)_xml_actions[_acts++];
-                    while (_nacts-- > 0) {
-                        switch (_xml_actions[_acts++]) {
-                        case 0:
-                            // line 80 "Xml.rl"
-                        {
-                            s = p;
-                        }
-                        break;
-                        case 1:
-                            // line 81 "Xml.rl"
-                        {
-                            char c = data[s];
-                            if (c == '?' || c == '!') {
-                                if (data[s + 1] == '[' && //
-                                        data[s + 2] == 'C' && //
-                                        data[s + 3] == 'D' && //
-                                        data[s + 4] == 'A' && //
-                                        data[s + 5] == 'T' && //
-                                        data[s + 6] == 'A' && //
-                                        data[s + 7] == '[') {
-                                    s += 8;
-                                    p = s + 2;
-                                    while (data[p - 2] != ']' || data[p - 1] != ']' || data[p] != '>')
-                                        p++;
-                                    text(new String(data, s, p - s - 2));
-                                } else
-                                    while (data[p] != '>')
-                                        p++;
-                                {
-                                    cs = 15;
-                                    _goto_targ = 2;
-                                    if (true) continue _goto;
-                                }
-                            }
-                            hasBody = true;
-                            open(new String(data, s, p - s));
-                        }
-                        break;
-                        case 2:
-                            // line 105 "Xml.rl"
-                        {
-                            hasBody = false;
-                            close();
-                            {
-                                cs = 15;
-                                _goto_targ = 2;
-                                if (true) continue _goto;
-                            }
-                        }
-                        break;
-                        case 3:
-                            // line 110 "Xml.rl"
-                        {
-                            close();
-                            {
-                                cs = 15;
-                                _goto_targ = 2;
-                                if (true) continue _goto;
-                            }
-                        }
-                        break;
-                        case 4:
-                            // line 114 "Xml.rl"
-                        {
-                            if (hasBody) {
-                                cs = 15;
-                                _goto_targ = 2;
-                                if (true) continue _goto;
-                            }
-                        }
-                        break;
-                        case 5:
-                            // line 117 "Xml.rl"
-                        {
-                            attributeName = new String(data, s, p - s);
-                        }
-                        break;
-                        case 6:
-                            // line 120 "Xml.rl"
-                        {
-                            attribute(attributeName, new String(data, s, p - s));
-                        }
-                        break;
-                        case 7:
-                            // line 123 "Xml.rl"
-                        {
-                            int end = p;
-                            while (end != s) {
-                                switch (data[end - 1]) {
-                                case ' ':
-                                case '\t':
-                                case '\n':
-                                case '\r':
-                                    end--;
-                                    continue;
-                                }
-                                break;
-                            }
-                            int current = s;
-                            boolean entityFound = false;
-                            while (current != end) {
-                                if (data[current++] != '&') continue;
-                                int entityStart = current;
-                                while (current != end) {
-                                    if (data[current++] != ';') continue;
-                                    textBuffer.append(data, s, entityStart - s - 1);
-                                    String name = new String(data, entityStart, current - entityStart - 1);
-                                    String value = entity(name);
-                                    textBuffer.append(value != null ? value : name);
-                                    s = current;
-                                    entityFound = true;
-                                    break;
-                                }
-                            }
-                            if (entityFound) {
-                                if (s < end) textBuffer.append(data, s, end - s);
-                                text(textBuffer.toString());
-                                textBuffer.setLength(0);
-                            } else
-                                text(new String(data, s, end - s));
-                        }
-                        break;
-                        // line 190 "Xml.java"
-                        }
-                    }
-                }
-
-            case 2:
-                if (cs == 0) {
-                    _goto_targ = 5;
-                    continue _goto;
-                }
-                if (++p != pe) {
-                    _goto_targ = 1;
-                    continue _goto;
-                }
-            case 4:
-            case 5:
-            }
-            break;
-        }
-    }
-
-    // line 170 "Xml.rl"
-
-    if (p < pe) {
-        int lineNumber = 1;
-        for (int i = 0; i < p; i++)
-            if (data[i] == '\n') lineNumber++;
-        throw new IllegalArgumentException("Error parsing XML on line " + lineNumber + " near: "
-                                           + new String(data, p, Math.min(32, pe - p)));
-    } else if (elements.size != 0) {
-        Element element = elements.peek();
-        elements.clear();
-        throw new IllegalArgumentException("Error parsing XML, unclosed element: " + element.getName());
-    }
-    Element root = this.root;
-    this.root = null;
-    return root;
-}
-
-char* XmlReader::init__xml_actions_0 () {
-    return new byte[] {0, 1, 0, 1, 1, 1, 2, 1, 3, 1, 4, 1, 5, 1, 6, 1, 7, 2, 0, 6, 2, 1, 4, 2, 2, 4};
-}
-
-char* XmlReader::init__xml_key_offsets_0 () {
-    return new byte[] {0, 0, 4, 9, 14, 20, 26, 30, 35, 36, 37, 42, 46, 50, 51, 52, 56, 57, 62, 67, 73, 79, 83, 88, 89, 90, 95,
-                       99, 103, 104, 108, 109, 110, 111, 112, 115
-                      };
-}
-
-char* XmlReader::init__xml_trans_keys_0 () {
-    return new char[] {32, 60, 9, 13, 32, 47, 62, 9, 13, 32, 47, 62, 9, 13, 32, 47, 61, 62, 9, 13, 32, 47, 61, 62, 9, 13, 32,
-                       61, 9, 13, 32, 34, 39, 9, 13, 34, 34, 32, 47, 62, 9, 13, 32, 62, 9, 13, 32, 62, 9, 13, 39, 39, 32, 60, 9, 13, 60, 32,
-                       47, 62, 9, 13, 32, 47, 62, 9, 13, 32, 47, 61, 62, 9, 13, 32, 47, 61, 62, 9, 13, 32, 61, 9, 13, 32, 34, 39, 9, 13, 34,
-                       34, 32, 47, 62, 9, 13, 32, 62, 9, 13, 32, 62, 9, 13, 60, 32, 47, 9, 13, 62, 62, 39, 39, 32, 9, 13, 0
-                      };
-}
-
-char* XmlReader::init__xml_single_lengths_0 () {
-    return new byte[] {0, 2, 3, 3, 4, 4, 2, 3, 1, 1, 3, 2, 2, 1, 1, 2, 1, 3, 3, 4, 4, 2, 3, 1, 1, 3, 2, 2, 1, 2, 1, 1, 1, 1, 1,
-                       0
-                      };
-}
-
-char* XmlReader::init__xml_range_lengths_0 () {
-    return new byte[] {0, 1, 1, 1, 1, 1, 1, 1, 0, 0, 1, 1, 1, 0, 0, 1, 0, 1, 1, 1, 1, 1, 1, 0, 0, 1, 1, 1, 0, 1, 0, 0, 0, 0, 1,
-                       0
-                      };
-}
-
-short* XmlReader::init__xml_index_offsets_0 () {
-    return new short[] {0, 0, 4, 9, 14, 20, 26, 30, 35, 37, 39, 44, 48, 52, 54, 56, 60, 62, 67, 72, 78, 84, 88, 93, 95, 97,
-                        102, 106, 110, 112, 116, 118, 120, 122, 124, 127
-                       };
-}
-
-char* XmlReader::init__xml_indicies_0 () {
-    return new byte[] {0, 2, 0, 1, 2, 1, 1, 2, 3, 5, 6, 7, 5, 4, 9, 10, 1, 11, 9, 8, 13, 1, 14, 1, 13, 12, 15, 16, 15, 1, 16,
-                       17, 18, 16, 1, 20, 19, 22, 21, 9, 10, 11, 9, 1, 23, 24, 23, 1, 25, 11, 25, 1, 20, 26, 22, 27, 29, 30, 29, 28, 32, 31,
-                       30, 34, 1, 30, 33, 36, 37, 38, 36, 35, 40, 41, 1, 42, 40, 39, 44, 1, 45, 1, 44, 43, 46, 47, 46, 1, 47, 48, 49, 47, 1,
-                       51, 50, 53, 52, 40, 41, 42, 40, 1, 54, 55, 54, 1, 56, 42, 56, 1, 57, 1, 57, 34, 57, 1, 1, 58, 59, 58, 51, 60, 53, 61,
-                       62, 62, 1, 1, 0
-                      };
-}
-
-char* XmlReader::init__xml_trans_targs_0 () {
-    return new byte[] {1, 0, 2, 3, 3, 4, 11, 34, 5, 4, 11, 34, 5, 6, 7, 6, 7, 8, 13, 9, 10, 9, 10, 12, 34, 12, 14, 14, 16, 15,
-                       17, 16, 17, 18, 30, 18, 19, 26, 28, 20, 19, 26, 28, 20, 21, 22, 21, 22, 23, 32, 24, 25, 24, 25, 27, 28, 27, 29, 31, 35,
-                       33, 33, 34
-                      };
-}
-
-char* XmlReader::init__xml_trans_actions_0 () {
-    return new byte[] {0, 0, 0, 1, 0, 3, 3, 20, 1, 0, 0, 9, 0, 11, 11, 0, 0, 0, 0, 1, 17, 0, 13, 5, 23, 0, 1, 0, 1, 0, 0, 0,
-                       15, 1, 0, 0, 3, 3, 20, 1, 0, 0, 9, 0, 11, 11, 0, 0, 0, 0, 1, 17, 0, 13, 5, 23, 0, 0, 0, 7, 1, 0, 0
-                      };
-}
-
-void XmlReader::open (const std::string& name) {
-    Element child = new Element(name);
-    Element parent = current;
-    if (parent != null) parent.addChild(child);
-    elements.add(child);
-    current = child;
-}
-
-void XmlReader::attribute (const std::string& name,const std::string& value) {
-    current.setAttribute(name, value);
-}
-
-std::string& XmlReader::entity (const std::string& name) {
-    if (name.equals("lt")) return "<";
-    if (name.equals("gt")) return ">";
-    if (name.equals("amp")) return "&";
-    if (name.equals("apos")) return "'";
-    if (name.equals("quot")) return "\"";
-    return null;
-}
-
-void XmlReader::text (const std::string& text) {
-    String existing = current.getText();
-    current.setText(existing != null ? existing + text : text);
-}
-
-void XmlReader::close () {
-    root = elements.pop();
-    current = elements.size > 0 ? elements.peek() : null;
-}
-
-std::string& XmlReader::getName () {
-    return name;
-}
-
-std::string& XmlReader::getAttribute (const std::string& name) {
-    if (attributes == null) throw new GdxRuntimeException("Element " + name + " doesn't have attribute: " + name);
-    String value = attributes.get(name);
-    if (value == null) throw new GdxRuntimeException("Element " + name + " doesn't have attribute: " + name);
-    return value;
-}
-
-std::string& XmlReader::getAttribute (const std::string& name,const std::string& defaultValue) {
-    if (attributes == null) return defaultValue;
-    String value = attributes.get(name);
-    if (value == null) return defaultValue;
-    return value;
-}
-
-void XmlReader::setAttribute (const std::string& name,const std::string& value) {
-    if (attributes == null) attributes = new ObjectMap(8);
-    attributes.put(name, value);
-}
-
-int XmlReader::getChildCount () {
-    if (children == null) return 0;
-    return children.size;
-}
-
-Element& XmlReader::getChild (int i) {
-    if (children == null) throw new GdxRuntimeException("Element has no children: " + name);
-    return children.get(i);
-}
-
-void XmlReader::addChild (const Element& element) {
-    if (children == null) children = new Array(8);
-    children.add(element);
-}
-
-std::string& XmlReader::getText () {
-    return text;
-}
-
-void XmlReader::setText (const std::string& text) {
-    this.text = text;
-}
-
-std::string& XmlReader::toString () {
-    return toString("");
-}
-
-std::string& XmlReader::toString (const std::string& indent) {
-    StringBuilder buffer = new StringBuilder(128);
-    buffer.append(indent);
-    buffer.append('<');
-    buffer.append(name);
-    if (attributes != null) {
-for (Entry<String, String> entry : attributes.entries()) {
-            buffer.append(' ');
-            buffer.append(entry.key);
-            buffer.append("=\"");
-            buffer.append(entry.value);
-            buffer.append('\"');
-        }
-    }
-    if (children == null && (text == null || text.length() == 0))
-        buffer.append("/>");
-    else {
-        buffer.append(">\n");
-        String childIndent = indent + '\t';
-        if (text != null && text.length() > 0) {
-            buffer.append(childIndent);
-            buffer.append(text);
-            buffer.append('\n');
-        }
-        if (children != null) {
-for (Element child : children) {
-                buffer.append(child.toString(childIndent));
-                buffer.append('\n');
-            }
-        }
-        buffer.append(indent);
-        buffer.append("</");
-        buffer.append(name);
-        buffer.append('>');
-    }
-    return buffer.toString();
-}
-
-Element& XmlReader::getChildByName (const std::string& name) {
-    if (children == null) return null;
-    for (int i = 0; i < children.size; i++) {
-        Element element = children.get(i);
-        if (element.name.equals(name)) return element;
-    }
-    return null;
-}
-
-Element& XmlReader::getChildByNameRecursive (const std::string& name) {
-    if (children == null) return null;
-    for (int i = 0; i < children.size; i++) {
-        Element element = children.get(i);
-        if (element.name.equals(name)) return element;
-        Element found = element.getChildByNameRecursive(name);
-        if (found != null) return found;
-    }
-    return null;
-}
-
-Array<Element>& XmlReader::getChildrenByName (const std::string& name) {
-    Array<Element> children = new Array<Element>();
-    if (this.children == null) return children;
-    for (int i = 0; i < this.children.size; i++) {
-        Element child = this.children.get(i);
-        if (child.name.equals(name)) children.add(child);
-    }
-    return children;
-}
-
-float XmlReader::getFloatAttribute (const std::string& name) {
-    return Float.parseFloat(getAttribute(name));
-}
-
-float XmlReader::getFloatAttribute (const std::string& name,float defaultValue) {
-    String value = getAttribute(name, null);
-    if (value == null) return defaultValue;
-    return Float.parseFloat(value);
-}
-
-int XmlReader::getIntAttribute (const std::string& name) {
-    return Integer.parseInt(getAttribute(name));
-}
-
-int XmlReader::getIntAttribute (const std::string& name,int defaultValue) {
-    String value = getAttribute(name, null);
-    if (value == null) return defaultValue;
-    return Integer.parseInt(value);
-}
-
-bool XmlReader::getBooleanAttribute (const std::string& name) {
-    return Boolean.parseBoolean(getAttribute(name));
-}
-
-bool XmlReader::getBooleanAttribute (const std::string& name,bool defaultValue) {
-    String value = getAttribute(name, null);
-    if (value == null) return defaultValue;
-    return Boolean.parseBoolean(value);
-}
-
-std::string& XmlReader::get (const std::string& name) {
-    String value = get(name, null);
-    if (value == null) throw new GdxRuntimeException("Element " + this.name + " doesn't have attribute or child: " + name);
-    return value;
-}
-
-std::string& XmlReader::get (const std::string& name,const std::string& defaultValue) {
-    if (attributes != null) {
-        String value = attributes.get(name);
-        if (value != null) return value;
-    }
-    Element child = getChildByName(name);
-    if (child == null) return defaultValue;
-    String value = child.getText();
-    if (value == null) return defaultValue;
-    return value;
-}
-
-int XmlReader::getInt (const std::string& name) {
-    String value = get(name, null);
-    if (value == null) throw new GdxRuntimeException("Element " + this.name + " doesn't have attribute or child: " + name);
-    return Integer.parseInt(value);
-}
-
-int XmlReader::getInt (const std::string& name,int defaultValue) {
-    String value = get(name, null);
-    if (value == null) return defaultValue;
-    return Integer.parseInt(value);
-}
-
-float XmlReader::getFloat (const std::string& name) {
-    String value = get(name, null);
-    if (value == null) throw new GdxRuntimeException("Element " + this.name + " doesn't have attribute or child: " + name);
-    return Float.parseFloat(value);
-}
-
-float XmlReader::getFloat (const std::string& name,float defaultValue) {
-    String value = get(name, null);
-    if (value == null) return defaultValue;
-    return Float.parseFloat(value);
-}
-
-bool XmlReader::getBolean (const std::string& name) {
-    String value = get(name, null);
-    if (value == null) throw new GdxRuntimeException("Element " + this.name + " doesn't have attribute or child: " + name);
-    return Boolean.parseBoolean(value);
-}
-
-bool XmlReader::getBoolean (const std::string& name,bool defaultValue) {
-    String value = get(name, null);
-    if (value == null) return defaultValue;
-    return Boolean.parseBoolean(value);
-}
-
+
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    @author Victor Vicente de Carvalho victor.carvalho@aevumlab.com
+    @author Ozires Bortolon de Faria ozires@aevumlab.com
+*/
+
+
+#include "XmlReader.hpp"
+#include "JsonReader.hpp"
+#include "gdx-cpp/files/MappedFile.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <stdint.h>
+
+using namespace gdx_cpp::utils;
+
+enum CharacterClass {
+    WHITESPACE = 1, NAME_END = 2
+};
+
+/** The classes of each character, one lookup instead of a chain of comparisons in the inner loops */
+static const struct CharacterClasses {
+    CharacterClasses () {
+        for (int i = 0; i < 256; i++)
+            classes[i] = 0;
+        classes[(unsigned char) ' '] = classes[(unsigned char) '\n'] = WHITESPACE | NAME_END;
+        classes[(unsigned char) '\r'] = classes[(unsigned char) '\t'] = WHITESPACE | NAME_END;
+        classes[(unsigned char) '>'] = classes[(unsigned char) '/'] = classes[(unsigned char) '='] = NAME_END;
+    }
+
+    unsigned char classes[256];
+} characterClasses;
+
+static bool isWhitespace (char c) {
+    return characterClasses.classes[(unsigned char) c] & WHITESPACE;
+}
+
+static bool isNameEnd (char c) {
+    return characterClasses.classes[(unsigned char) c] & NAME_END;
+}
+
+static char* writeUtf8 (char* out, uint32_t codePoint) {
+    if (codePoint < 0x80) {
+        *out++ = (char) codePoint;
+    } else if (codePoint < 0x800) {
+        *out++ = (char) (0xc0 | (codePoint >> 6));
+        *out++ = (char) (0x80 | (codePoint & 0x3f));
+    } else if (codePoint < 0x10000) {
+        *out++ = (char) (0xe0 | (codePoint >> 12));
+        *out++ = (char) (0x80 | ((codePoint >> 6) & 0x3f));
+        *out++ = (char) (0x80 | (codePoint & 0x3f));
+    } else {
+        *out++ = (char) (0xf0 | (codePoint >> 18));
+        *out++ = (char) (0x80 | ((codePoint >> 12) & 0x3f));
+        *out++ = (char) (0x80 | ((codePoint >> 6) & 0x3f));
+        *out++ = (char) (0x80 | (codePoint & 0x3f));
+    }
+    return out;
+}
+
+/** FNV-1a */
+static unsigned int hashName (const StringView& name) {
+    unsigned int hash = 2166136261u;
+    for (size_t i = 0; i < name.size(); i++)
+        hash = (hash ^ (unsigned char) name[i]) * 16777619u;
+    return hash;
+}
+
+XmlReader::XmlReader ()
+: p(NULL)
+, begin(NULL)
+, end(NULL)
+, event(END_DOCUMENT)
+, closePending(false)
+, sawRoot(false)
+, decoded(4 * 1024)
+{
+}
+
+void XmlReader::open (const char* xml, size_t length) {
+    begin = p = xml;
+    end = xml + length;
+    if (length >= 3 && std::memcmp(xml, "\xef\xbb\xbf", 3) == 0) p += 3;
+    event = END_DOCUMENT;
+    name = text = StringView();
+    attributes.clear();
+    elements.clear();
+    closePending = false;
+    sawRoot = false;
+    decoded.reset();
+}
+
+void XmlReader::open (const files::MappedFile& file) {
+    open(file.getData(), file.getSize());
+}
+
+XmlReader::Event XmlReader::next () {
+    if (closePending) {
+        // the END_ELEMENT of <element/>
+        closePending = false;
+        attributes.clear();
+        elements.pop_back();
+        return event = END_ELEMENT;
+    }
+    if (event == END_DOCUMENT && sawRoot) return event;
+
+    attributes.clear();
+    decoded.reset();
+    while (true) {
+        if (p == end) {
+            if (!elements.empty()) error("Unclosed element");
+            if (!sawRoot) error("No root element");
+            return event = END_DOCUMENT;
+        }
+
+        if (*p != '<') {
+            // most text between tags is indentation, which is skipped without searching for the next tag
+            const char* start = p;
+            skipWhitespace();
+            if (p == end || *p == '<') continue;
+            if (elements.empty()) error("Text outside of the root element");
+            p = static_cast<const char*>(std::memchr(p, '<', end - p));
+            if (p == NULL) p = end;
+            text = decode(start, p);
+            return event = TEXT;
+        }
+
+        if (readTag()) return event;
+    }
+}
+
+/** Reads the markup at the cursor, returns false for markup that is skipped */
+bool XmlReader::readTag () {
+    const char* start = p;
+    size_t left = end - p;
+    char second = left >= 2 ? p[1] : 0;
+
+    if (second == '?') {
+        skipPast("?>", "Unterminated processing instruction");
+        return false;
+    }
+    if (second == '!' && left >= 4 && std::memcmp(p, "<!--", 4) == 0) {
+        p += 4;
+        skipPast("-->", "Unterminated comment");
+        return false;
+    }
+    if (second == '!' && left >= 9 && std::memcmp(p, "<![CDATA[", 9) == 0) {
+        if (elements.empty()) error("Text outside of the root element");
+        p += 9;
+        const char* data = p;
+        skipPast("]]>", "Unterminated CDATA section");
+        if (p - 3 == data) return false;
+        text = StringView(data, p - 3 - data);
+        event = TEXT;
+        return true;
+    }
+    if (second == '!') {
+        // a doctype, with its internal subset in brackets
+        int brackets = 0;
+        for (p += 2; p != end; p++) {
+            if (*p == '[') brackets++;
+            else if (*p == ']') brackets--;
+            else if (*p == '>' && brackets <= 0) break;
+        }
+        if (p == end) {
+            p = start;
+            error("Unterminated doctype");
+        }
+        p++;
+        return false;
+    }
+
+    if (second == '/') {
+        p += 2;
+        name = readName();
+        skipWhitespace();
+        if (p == end || *p != '>') error("Expected '>'");
+        if (elements.empty() || !(elements.back() == name)) {
+            p = start;
+            error("Closing tag doesn't match the open element");
+        }
+        p++;
+        elements.pop_back();
+        event = END_ELEMENT;
+        return true;
+    }
+
+    if (elements.empty() && sawRoot) error("More than one root element");
+    p++;
+    name = readName();
+    while (true) {
+        skipWhitespace();
+        if (p == end) error("Unterminated tag");
+        if (*p == '>') {
+            p++;
+            break;
+        }
+        if (*p == '/') {
+            if (end - p < 2 || p[1] != '>') error("Expected '>'");
+            p += 2;
+            closePending = true;
+            break;
+        }
+
+        Attribute attribute;
+        attribute.name = readName();
+        skipWhitespace();
+        if (p == end || *p != '=') error("Expected '='");
+        p++;
+        skipWhitespace();
+        if (p == end || (*p != '"' && *p != '\'')) error("Expected a quoted value");
+        // values are short, a plain loop beats searching twice for the quote and for entities
+        char quote = *p++;
+        const char* value = p;
+        bool entities = false;
+        while (p != end && *p != quote) {
+            entities |= *p == '&';
+            p++;
+        }
+        if (p == end) {
+            p = value;
+            error("Unterminated attribute value");
+        }
+        attribute.value = entities ? decode(value, p) : StringView(value, p - value);
+        p++;
+        attributes.push_back(attribute);
+    }
+
+    elements.push_back(name);
+    sawRoot = true;
+    event = START_ELEMENT;
+    return true;
+}
+
+StringView XmlReader::readName () {
+    const char* start = p;
+    while (p != end && !isNameEnd(*p))
+        p++;
+    if (p == start) error("Expected a name");
+    return StringView(start, p - start);
+}
+
+void XmlReader::skipWhitespace () {
+    while (p != end && isWhitespace(*p))
+        p++;
+}
+
+void XmlReader::skipPast (const char* terminator, const char* message) {
+    size_t length = std::strlen(terminator);
+    const char* start = p;
+    while (true) {
+        p = static_cast<const char*>(std::memchr(p, terminator[0], end - p));
+        if (p == NULL || (size_t) (end - p) < length) {
+            p = start;
+            error(message);
+        }
+        if (std::memcmp(p, terminator, length) == 0) break;
+        p++;
+    }
+    p += length;
+}
+
+/** Replaces entities, the text stays in place if it has none */
+StringView XmlReader::decode (const char* start, const char* stop) {
+    const char* ampersand = static_cast<const char*>(std::memchr(start, '&', stop - start));
+    if (ampersand == NULL) return StringView(start, stop - start);
+
+    // an entity is never shorter than what it stands for
+    char* out = static_cast<char*>(decoded.allocate(stop - start, 1));
+    char* o = out;
+    const char* s = start;
+    while (s != stop) {
+        if (*s != '&') {
+            *o++ = *s++;
+            continue;
+        }
+        const char* semicolon = static_cast<const char*>(std::memchr(s, ';', stop - s));
+        if (semicolon == NULL) {
+            p = s;
+            error("Unterminated entity");
+        }
+        StringView entity(s + 1, semicolon - s - 1);
+        if (entity == StringView("lt")) *o++ = '<';
+        else if (entity == StringView("gt")) *o++ = '>';
+        else if (entity == StringView("amp")) *o++ = '&';
+        else if (entity == StringView("quot")) *o++ = '"';
+        else if (entity == StringView("apos")) *o++ = '\'';
+        else if (entity.size() >= 2 && entity[0] == '#') {
+            bool hex = entity[1] == 'x';
+            uint32_t codePoint = 0;
+            size_t i = hex ? 2 : 1;
+            if (i == entity.size()) {
+                p = s;
+                error("Invalid character reference");
+            }
+            for (; i < entity.size(); i++) {
+                char c = entity[i];
+                int digit = c >= '0' && c <= '9' ? c - '0' : !hex ? -1 : c >= 'a' && c <= 'f' ? c - 'a' + 10
+                            : c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+                if (digit < 0 || codePoint > 0x10ffff) {
+                    p = s;
+                    error("Invalid character reference");
+                }
+                codePoint = codePoint * (hex ? 16 : 10) + digit;
+            }
+            if (codePoint > 0x10ffff) {
+                p = s;
+                error("Invalid character reference");
+            }
+            o = writeUtf8(o, codePoint);
+        } else {
+            p = s;
+            error("Unknown entity");
+        }
+        s = semicolon + 1;
+    }
+    return StringView(out, o - out);
+}
+
+void XmlReader::error (const char* message) const {
+    int line = 1;
+    const char* lineStart = begin;
+    for (const char* c = begin; c < p; c++) {
+        if (*c == '\n') {
+            line++;
+            lineStart = c + 1;
+        }
+    }
+    std::ostringstream out;
+    out << "Error parsing XML on line " << line << " near column " << (p - lineStart + 1) << ": " << message;
+    throw std::runtime_error(out.str());
+}
+
+StringView XmlReader::getAttribute (const StringView& name, const StringView& defaultValue) const {
+    for (size_t i = 0; i < attributes.size(); i++)
+        if (attributes[i].name == name) return attributes[i].value;
+    return defaultValue;
+}
+
+int XmlReader::getIntAttribute (const StringView& name, int defaultValue) const {
+    return parseInt(getAttribute(name), defaultValue);
+}
+
+float XmlReader::getFloatAttribute (const StringView& name, float defaultValue) const {
+    return parseFloat(getAttribute(name), defaultValue);
+}
+
+int XmlReader::parseInt (const StringView& value, int defaultValue) {
+    const char* c = value.begin();
+    while (c != value.end() && isWhitespace(*c))
+        c++;
+    bool negative = c != value.end() && *c == '-';
+    if (c != value.end() && (*c == '-' || *c == '+')) c++;
+    if (c == value.end() || (unsigned char) (*c - '0') >= 10) return defaultValue;
+    unsigned int result = 0;
+    for (; c != value.end() && (unsigned char) (*c - '0') < 10; c++)
+        result = result * 10 + (*c - '0');
+    return negative ? (int) (0u - result) : (int) result;
+}
+
+float XmlReader::parseFloat (const StringView& value, float defaultValue) {
+    const char* c = value.begin();
+    while (c != value.end() && isWhitespace(*c))
+        c++;
+    if (c == value.end()) return defaultValue;
+    return (float) JsonReader::parseNumber(c, value.end());
+}
+
+const XmlElement* XmlElement::getChild (int index) const {
+    if (index < 0) return NULL;
+    const XmlElement* child = firstChild;
+    for (; child != NULL && index > 0; index--)
+        child = child->sibling;
+    return child;
+}
+
+const XmlElement* XmlElement::getChildByName (const XmlName* name) const {
+    for (const XmlElement* child = firstChild; child != NULL; child = child->sibling)
+        if (child->name == name) return child;
+    return NULL;
+}
+
+const XmlElement* XmlElement::getChildByName (const StringView& name) const {
+    for (const XmlElement* child = firstChild; child != NULL; child = child->sibling)
+        if (child->name->str() == name) return child;
+    return NULL;
+}
+
+StringView XmlElement::getAttribute (const XmlName* name, const StringView& defaultValue) const {
+    for (int i = 0; i < attributeCount; i++)
+        if (attributes[i].name == name) return attributes[i].value;
+    return defaultValue;
+}
+
+StringView XmlElement::getAttribute (const StringView& name, const StringView& defaultValue) const {
+    for (int i = 0; i < attributeCount; i++)
+        if (attributes[i].name->str() == name) return attributes[i].value;
+    return defaultValue;
+}
+
+int XmlElement::getIntAttribute (const XmlName* name, int defaultValue) const {
+    return XmlReader::parseInt(getAttribute(name), defaultValue);
+}
+
+int XmlElement::getIntAttribute (const StringView& name, int defaultValue) const {
+    return XmlReader::parseInt(getAttribute(name), defaultValue);
+}
+
+float XmlElement::getFloatAttribute (const XmlName* name, float defaultValue) const {
+    return XmlReader::parseFloat(getAttribute(name), defaultValue);
+}
+
+float XmlElement::getFloatAttribute (const StringView& name, float defaultValue) const {
+    return XmlReader::parseFloat(getAttribute(name), defaultValue);
+}
+
+XmlDocument::XmlDocument ()
+: root(NULL)
+, names(64, (XmlName*) NULL)
+, nameCount(0)
+{
+}
+
+void XmlDocument::clear () {
+    arena.reset();
+    root = NULL;
+    std::fill(names.begin(), names.end(), (XmlName*) NULL);
+    nameCount = 0;
+}
+
+const XmlElement* XmlDocument::parse (const files::MappedFile& file) {
+    return parse(file.getData(), file.getSize());
+}
+
+const XmlElement* XmlDocument::parse (const char* xml, size_t length) {
+    clear();
+    reader.open(xml, length);
+    lastChildren.clear();
+
+    XmlElement* current = NULL;
+    while (true) {
+        switch (reader.next()) {
+        case XmlReader::START_ELEMENT: {
+            XmlElement* element = static_cast<XmlElement*>(arena.allocate(sizeof(XmlElement), alignof(XmlElement)));
+            element->name = intern(reader.getName());
+            element->text = StringView();
+            element->childCount = 0;
+            element->parent = current;
+            element->firstChild = NULL;
+            element->sibling = NULL;
+
+            int count = reader.getAttributeCount();
+            XmlAttribute* attributes = NULL;
+            if (count > 0) {
+                attributes = static_cast<XmlAttribute*>(arena.allocate(count * sizeof(XmlAttribute),
+                                                                       alignof(XmlAttribute)));
+                for (int i = 0; i < count; i++) {
+                    attributes[i].name = intern(reader.getAttributeName(i));
+                    attributes[i].value = keep(reader.getAttributeValue(i));
+                }
+            }
+            element->attributes = attributes;
+            element->attributeCount = count;
+
+            if (current == NULL) {
+                root = element;
+            } else {
+                XmlElement*& last = lastChildren.back();
+                if (last == NULL) current->firstChild = element;
+                else last->sibling = element;
+                last = element;
+                current->childCount++;
+            }
+            lastChildren.push_back(NULL);
+            current = element;
+            break;
+        }
+        case XmlReader::END_ELEMENT:
+            lastChildren.pop_back();
+            current = const_cast<XmlElement*>(current->parent);
+            break;
+        case XmlReader::TEXT:
+            if (current->text.empty()) {
+                current->text = keep(reader.getText());
+            } else {
+                // text split by child elements or CDATA is joined
+                const StringView& more = reader.getText();
+                size_t length = current->text.size() + more.size();
+                char* joined = static_cast<char*>(arena.allocate(length, 1));
+                std::memcpy(joined, current->text.data, current->text.size());
+                std::memcpy(joined + current->text.size(), more.data, more.size());
+                current->text = StringView(joined, length);
+            }
+            break;
+        case XmlReader::END_DOCUMENT:
+            return root;
+        }
+    }
+}
+
+const XmlName* XmlDocument::getName (const StringView& name) const {
+    size_t mask = names.size() - 1;
+    unsigned int hash = hashName(name);
+    for (size_t i = hash & mask; names[i] != NULL; i = (i + 1) & mask)
+        if (names[i]->hash == hash && names[i]->text == name) return names[i];
+    return NULL;
+}
+
+const XmlName* XmlDocument::intern (const StringView& name) {
+    size_t mask = names.size() - 1;
+    unsigned int hash = hashName(name);
+    size_t i = hash & mask;
+    for (; names[i] != NULL; i = (i + 1) & mask)
+        if (names[i]->hash == hash && names[i]->text == name) return names[i];
+
+    XmlName* interned = static_cast<XmlName*>(arena.allocate(sizeof(XmlName), alignof(XmlName)));
+    interned->text = name;
+    interned->hash = hash;
+    names[i] = interned;
+
+    // keep the table at most half full
+    if (++nameCount * 2 > (int) names.size()) {
+        std::vector<XmlName*> old(names.size() * 2, (XmlName*) NULL);
+        old.swap(names);
+        mask = names.size() - 1;
+        for (size_t j = 0; j < old.size(); j++) {
+            if (old[j] == NULL) continue;
+            size_t k = old[j]->hash & mask;
+            while (names[k] != NULL)
+                k = (k + 1) & mask;
+            names[k] = old[j];
+        }
+    }
+    return interned;
+}
+
+/** Copies decoded text into the arena, views into the document are kept as they are */
+StringView XmlDocument::keep (const StringView& view) {
+    if (view.empty() || (view.begin() >= reader.getBegin() && view.end() <= reader.getEnd())) return view;
+    char* copy = static_cast<char*>(arena.allocate(view.size(), 1));
+    std::memcpy(copy, view.data, view.size());
+    return StringView(copy, view.size());
+}
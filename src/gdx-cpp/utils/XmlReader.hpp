@@ -18,66 +18,243 @@
     @author Ozires Bortolon de Faria ozires@aevumlab.com
 */
 
+
 #ifndef GDX_CPP_UTILS_XMLREADER_HPP_
 #define GDX_CPP_UTILS_XMLREADER_HPP_
 
+#include "LinearAllocator.hpp"
+#include "StringView.hpp"
+
+#include <cstddef>
+#include <vector>
+
 namespace gdx_cpp {
+
+namespace files {
+class MappedFile;
+}
+
 namespace utils {
 
+/** Pulls elements, attributes and text out of an XML document one event at a time, without building a tree. Names,
+ * attribute values and text are views into the document unless they contained entities, in which case they are only
+ * valid until the next call to next().
+ *
+ * Comments, processing instructions and the doctype are skipped, as is text that is only whitespace. CDATA sections
+ * are reported as text. Malformed documents throw std::runtime_error with the line and column. */
 class XmlReader {
 public:
-    Element& parse (const std::string& xml);
-    Element& parse (const Reader& reader);
-    Element& parse (const InputStream& input);
-    Element& parse (const gdx_cpp::files::FileHandle& file);
-    Element& parse (int offset,int length);
-    std::string& getName ();
-    std::string& getAttribute (const std::string& name);
-    std::string& getAttribute (const std::string& name,const std::string& defaultValue);
-    void setAttribute (const std::string& name,const std::string& value);
-    int getChildCount ();
-    Element& getChild (int i);
-    void addChild (const Element& element);
-    std::string& getText ();
-    void setText (const std::string& text);
-    std::string& toString ();
-    std::string& toString (const std::string& indent);
-    Element& getChildByName (const std::string& name);
-    Element& getChildByNameRecursive (const std::string& name);
-    Array<Element>& getChildrenByName (const std::string& name);
-    float getFloatAttribute (const std::string& name);
-    float getFloatAttribute (const std::string& name,float defaultValue);
-    int getIntAttribute (const std::string& name);
-    int getIntAttribute (const std::string& name,int defaultValue);
-    bool getBooleanAttribute (const std::string& name);
-    bool getBooleanAttribute (const std::string& name,bool defaultValue);
-    std::string& get (const std::string& name);
-    std::string& get (const std::string& name,const std::string& defaultValue);
-    int getInt (const std::string& name);
-    int getInt (const std::string& name,int defaultValue);
-    float getFloat (const std::string& name);
-    float getFloat (const std::string& name,float defaultValue);
-    bool getBolean (const std::string& name);
-    bool getBoolean (const std::string& name,bool defaultValue);
-
-protected:
-    void open (const std::string& name);
-    void attribute (const std::string& name,const std::string& value);
-    std::string& entity (const std::string& name);
-    void text (const std::string& text);
-    void close ();
+    enum Event {
+        START_ELEMENT, END_ELEMENT, TEXT, END_DOCUMENT
+    };
+
+    XmlReader ();
+
+    /** Starts reading a document. The text has to stay around as long as the reader or its views are used. */
+    void open (const char* xml, size_t length);
+    void open (const files::MappedFile& file);
+
+    Event next ();
+
+    Event getEvent () const {
+        return event;
+    }
+
+    /** The element of START_ELEMENT and END_ELEMENT */
+    const StringView& getName () const {
+        return name;
+    }
+
+    /** The text of TEXT with entities decoded */
+    const StringView& getText () const {
+        return text;
+    }
+
+    /** The number of open elements, the root counts from its START_ELEMENT to its END_ELEMENT */
+    int getDepth () const {
+        return (int) elements.size();
+    }
+
+    /** The attributes of the current START_ELEMENT */
+    int getAttributeCount () const {
+        return (int) attributes.size();
+    }
+
+    const StringView& getAttributeName (int index) const {
+        return attributes[index].name;
+    }
+
+    const StringView& getAttributeValue (int index) const {
+        return attributes[index].value;
+    }
+
+    StringView getAttribute (const StringView& name, const StringView& defaultValue = StringView()) const;
+    int getIntAttribute (const StringView& name, int defaultValue = 0) const;
+    float getFloatAttribute (const StringView& name, float defaultValue = 0) const;
+
+    /** Where the reader is in the document, for telling apart views into the text from decoded ones */
+    const char* getBegin () const {
+        return begin;
+    }
+
+    const char* getEnd () const {
+        return end;
+    }
+
+    static int parseInt (const StringView& value, int defaultValue = 0);
+    static float parseFloat (const StringView& value, float defaultValue = 0);
+
+private:
+    struct Attribute {
+        StringView name;
+        StringView value;
+    };
+
+    XmlReader (const XmlReader&);
+    XmlReader& operator= (const XmlReader&);
+
+    void error (const char* message) const;
+    void skipPast (const char* terminator, const char* message);
+    void skipWhitespace ();
+    StringView readName ();
+    StringView decode (const char* start, const char* stop);
+    bool readTag ();
+
+    const char* p;
+    const char* begin;
+    const char* end;
+    Event event;
+    StringView name;
+    StringView text;
+    std::vector<Attribute> attributes;
+    /** names of the open elements */
+    std::vector<StringView> elements;
+    bool closePending;
+    bool sawRoot;
+    /** decoded text and values, released on every event */
+    LinearAllocator decoded;
+};
+
+/** An element or attribute name as interned by an XmlDocument. Every occurrence of a name in a document shares the same
+ * XmlName, so looking one up once and comparing pointers replaces string comparisons. */
+class XmlName {
+public:
+    const StringView& str () const {
+        return text;
+    }
 
 private:
-    static char* init__xml_actions_0 ();
-    static char* init__xml_key_offsets_0 ();
-    static char* init__xml_trans_keys_0 ();
-    static char* init__xml_single_lengths_0 ();
-    static char* init__xml_range_lengths_0 ();
-    static short* init__xml_index_offsets_0 ();
-    static char* init__xml_indicies_0 ();
-    static char* init__xml_trans_targs_0 ();
-    static char* init__xml_trans_actions_0 ();
-    String name;
+    friend class XmlDocument;
+
+    StringView text;
+    unsigned int hash;
+};
+
+struct XmlAttribute {
+    const XmlName* name;
+    StringView value;
+};
+
+/** An element of an XmlDocument, allocated in the document's arena and valid until it parses again or is cleared */
+class XmlElement {
+public:
+    const XmlName* getNameId () const {
+        return name;
+    }
+
+    const StringView& getName () const {
+        return name->str();
+    }
+
+    /** The element's text, concatenated if child elements split it */
+    const StringView& getText () const {
+        return text;
+    }
+
+    const XmlElement* getParent () const {
+        return parent;
+    }
+
+    int getChildCount () const {
+        return childCount;
+    }
+
+    /** The first child element, NULL if there is none */
+    const XmlElement* child () const {
+        return firstChild;
+    }
+
+    /** The following sibling element, NULL after the last */
+    const XmlElement* next () const {
+        return sibling;
+    }
+
+    const XmlElement* getChild (int index) const;
+    const XmlElement* getChildByName (const XmlName* name) const;
+    const XmlElement* getChildByName (const StringView& name) const;
+
+    int getAttributeCount () const {
+        return attributeCount;
+    }
+
+    const XmlAttribute& getAttribute (int index) const {
+        return attributes[index];
+    }
+
+    StringView getAttribute (const XmlName* name, const StringView& defaultValue = StringView()) const;
+    StringView getAttribute (const StringView& name, const StringView& defaultValue = StringView()) const;
+    int getIntAttribute (const XmlName* name, int defaultValue = 0) const;
+    int getIntAttribute (const StringView& name, int defaultValue = 0) const;
+    float getFloatAttribute (const XmlName* name, float defaultValue = 0) const;
+    float getFloatAttribute (const StringView& name, float defaultValue = 0) const;
+
+private:
+    friend class XmlDocument;
+
+    const XmlName* name;
+    StringView text;
+    const XmlAttribute* attributes;
+    int attributeCount;
+    int childCount;
+    const XmlElement* parent;
+    XmlElement* firstChild;
+    XmlElement* sibling;
+};
+
+/** A parsed XML document. Elements, attributes and interned names are bump allocated from the document's arena, so
+ * parsing again reuses the memory of the previous document. Text and values point into the parsed text unless they
+ * contained entities, so the text has to outlive the elements. */
+class XmlDocument {
+public:
+    XmlDocument ();
+
+    /** Parses a document, replacing the previous one, and returns its root */
+    const XmlElement* parse (const char* xml, size_t length);
+    const XmlElement* parse (const files::MappedFile& file);
+
+    const XmlElement* getRoot () const {
+        return root;
+    }
+
+    /** The interned name, NULL if no element or attribute in the document has it */
+    const XmlName* getName (const StringView& name) const;
+
+    void clear ();
+
+private:
+    XmlDocument (const XmlDocument&);
+    XmlDocument& operator= (const XmlDocument&);
+
+    const XmlName* intern (const StringView& name);
+    StringView keep (const StringView& view);
+
+    XmlReader reader;
+    LinearAllocator arena;
+    XmlElement* root;
+    /** open addressing table of the interned names, a power of two in size */
+    std::vector<XmlName*> names;
+    int nameCount;
+    std::vector<XmlElement*> lastChildren;
 };
 
 } // namespace gdx_cpp
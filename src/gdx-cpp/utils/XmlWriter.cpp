@@ -1,106 +1,206 @@
-
-/*
-    Copyright 2011 Aevum Software aevum @ aevumlab.com
-
-    Licensed under the Apache License, Version 2.0 (the "License");
-    you may not use this file except in compliance with the License.
-    You may obtain a copy of the License at
-
-        http://www.apache.org/licenses/LICENSE-2.0
-
-    Unless required by applicable law or agreed to in writing, software
-    distributed under the License is distributed on an "AS IS" BASIS,
-    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
-    See the License for the specific language governing permissions and
-    limitations under the License.
-
-    @author Victor Vicente de Carvalho victor.carvalho@aevumlab.com
-    @author Ozires Bortolon de Faria ozires@aevumlab.com
-*/
-
-#include "XmlWriter.hpp"
-
-using namespace gdx_cpp::utils;
-
-void XmlWriter::indent () throws IOException {
-    int count = indent;
-    if (currentElement != null) count++;
-    for (int i = 0; i < count; i++)
-        writer.write('\t');
-}
-
-XmlWriter& XmlWriter::element (const std::string& name) throws IOException {
-    if (startElementContent()) writer.write('\n');
-    indent();
-    writer.write('<');
-    writer.write(name);
-    currentElement = name;
-    return this;
-}
-
-XmlWriter& XmlWriter::element (const std::string& name,const Object& text) throws IOException {
-    return element(name).text(text).pop();
-}
-
-bool XmlWriter::startElementContent () throws IOException {
-    if (currentElement == null) return false;
-    indent++;
-    stack.push(currentElement);
-    currentElement = null;
-    writer.write(">");
-    return true;
-}
-
-XmlWriter& XmlWriter::attribute (const std::string& name,const Object& value) throws IOException {
-    if (currentElement == null) throw new IllegalStateException();
-    writer.write(' ');
-    writer.write(name);
-    writer.write("=\"");
-    writer.write(value == null ? "null" : value.toString());
-    writer.write('"');
-    return this;
-}
-
-XmlWriter& XmlWriter::text (const Object& text) throws IOException {
-    startElementContent();
-    String string = text == null ? "null" : text.toString();
-    indentNextClose = string.length() > 64;
-    if (indentNextClose) {
-        writer.write('\n');
-        indent();
-    }
-    writer.write(string);
-    if (indentNextClose) writer.write('\n');
-    return this;
-}
-
-XmlWriter& XmlWriter::pop () throws IOException {
-    if (currentElement != null) {
-        writer.write("/>\n");
-        currentElement = null;
-    } else {
-        indent = Math.max(indent - 1, 0);
-        if (indentNextClose) indent();
-        writer.write("</");
-        writer.write(stack.pop());
-        writer.write(">\n");
-    }
-    indentNextClose = true;
-    return this;
-}
-
-void XmlWriter::close () throws IOException {
-    while (!stack.isEmpty())
-        pop();
-    writer.close();
-}
-
-void XmlWriter::write (int off,int len) throws IOException {
-    startElementContent();
-    writer.write(cbuf, off, len);
-}
-
-void XmlWriter::flush () throws IOException {
-    writer.flush();
-}
-
+
+/*
+    Copyright 2011 Aevum Software aevum @ aevumlab.com
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+    @author Victor Vicente de Carvalho victor.carvalho@aevumlab.com
+    @author Ozires Bortolon de Faria ozires@aevumlab.com
+*/
+
+
+#include "XmlWriter.hpp"
+#include "WriteBuffer.hpp"
+
+#include <stdexcept>
+
+using namespace gdx_cpp::utils;
+
+XmlWriter::XmlWriter (WriteBuffer& out)
+: out(out)
+, inStartTag(false)
+, atLineStart(true)
+, indentation(0)
+{
+}
+
+void XmlWriter::writeEscaped (WriteBuffer& out, const StringView& text) {
+    const char* run = text.begin();
+    for (const char* c = text.begin(); c != text.end(); c++) {
+        const char* entity;
+        size_t length;
+        switch (*c) {
+            case '&': entity = "&amp;"; length = 5; break;
+            case '<': entity = "&lt;"; length = 4; break;
+            case '>': entity = "&gt;"; length = 4; break;
+            case '"': entity = "&quot;"; length = 6; break;
+            default: continue;
+        }
+        out.append(run, c - run);
+        out.append(entity, length);
+        run = c + 1;
+    }
+    out.append(run, text.end() - run);
+}
+
+void XmlWriter::indent () {
+    if (indentation == 0) return;
+    char* p = out.reserve(indentation);
+    for (int i = 0; i < indentation; i++)
+        p[i] = '\t';
+    out.commit(indentation);
+}
+
+void XmlWriter::startElementContent () {
+    if (!inStartTag) return;
+    indentation++;
+    inStartTag = false;
+    out.append('>');
+}
+
+XmlWriter& XmlWriter::element (const StringView& name) {
+    startElementContent();
+    if (!atLineStart) out.append('\n');
+    indent();
+    atLineStart = false;
+    out.append('<');
+    out.append(name);
+    nameStarts.push_back(names.size());
+    names.append(name.data, name.size());
+    inStartTag = true;
+    return *this;
+}
+
+XmlWriter& XmlWriter::element (const StringView& name, const StringView& text) {
+    return element(name).text(text).pop();
+}
+
+XmlWriter& XmlWriter::attribute (const StringView& name, const StringView& value) {
+    if (!inStartTag) throw std::runtime_error("Element must be started before an attribute is added.");
+    out.append(' ');
+    out.append(name);
+    out.append("=\"", 2);
+    writeEscaped(out, value);
+    out.append('"');
+    return *this;
+}
+
+XmlWriter& XmlWriter::attribute (const StringView& name, const char* value) {
+    return attribute(name, StringView(value));
+}
+
+XmlWriter& XmlWriter::attribute (const StringView& name, const std::string& value) {
+    return attribute(name, StringView(value));
+}
+
+XmlWriter& XmlWriter::attribute (const StringView& name, double value) {
+    char buffer[WriteBuffer::maxNumberLength];
+    return attribute(name, StringView(buffer, WriteBuffer::formatDouble(buffer, value)));
+}
+
+XmlWriter& XmlWriter::attribute (const StringView& name, float value) {
+    char buffer[WriteBuffer::maxNumberLength];
+    return attribute(name, StringView(buffer, WriteBuffer::formatFloat(buffer, value)));
+}
+
+XmlWriter& XmlWriter::attribute (const StringView& name, int value) {
+    return attribute(name, (long long) value);
+}
+
+XmlWriter& XmlWriter::attribute (const StringView& name, long long value) {
+    if (!inStartTag) throw std::runtime_error("Element must be started before an attribute is added.");
+    out.append(' ');
+    out.append(name);
+    out.append("=\"", 2);
+    out.appendInt(value);
+    out.append('"');
+    return *this;
+}
+
+XmlWriter& XmlWriter::attribute (const StringView& name, bool value) {
+    return attribute(name, value ? StringView("true", 4) : StringView("false", 5));
+}
+
+XmlWriter& XmlWriter::text (const StringView& text) {
+    startElementContent();
+    bool ownLines = text.size() > 64;
+    if (ownLines) {
+        if (!atLineStart) out.append('\n');
+        indent();
+    }
+    writeEscaped(out, text);
+    if (ownLines) out.append('\n');
+    atLineStart = ownLines;
+    return *this;
+}
+
+XmlWriter& XmlWriter::text (const char* text) {
+    return this->text(StringView(text));
+}
+
+XmlWriter& XmlWriter::text (const std::string& text) {
+    return this->text(StringView(text));
+}
+
+XmlWriter& XmlWriter::number (const char* text, int length) {
+    startElementContent();
+    atLineStart = false;
+    out.append(text, length);
+    return *this;
+}
+
+XmlWriter& XmlWriter::text (double value) {
+    char buffer[WriteBuffer::maxNumberLength];
+    return number(buffer, WriteBuffer::formatDouble(buffer, value));
+}
+
+XmlWriter& XmlWriter::text (float value) {
+    char buffer[WriteBuffer::maxNumberLength];
+    return number(buffer, WriteBuffer::formatFloat(buffer, value));
+}
+
+XmlWriter& XmlWriter::text (int value) {
+    return text((long long) value);
+}
+
+XmlWriter& XmlWriter::text (long long value) {
+    startElementContent();
+    atLineStart = false;
+    out.appendInt(value);
+    return *this;
+}
+
+XmlWriter& XmlWriter::pop () {
+    if (nameStarts.empty()) throw std::runtime_error("No element to pop.");
+    size_t start = nameStarts.back();
+    if (inStartTag) {
+        out.append("/>\n", 3);
+        inStartTag = false;
+    } else {
+        indentation--;
+        if (atLineStart) indent();
+        out.append("</", 2);
+        out.append(names.data() + start, names.size() - start);
+        out.append(">\n", 2);
+    }
+    names.resize(start);
+    nameStarts.pop_back();
+    atLineStart = true;
+    return *this;
+}
+
+void XmlWriter::close () {
+    while (!nameStarts.empty())
+        pop();
+    out.flush();
+}
@@ -18,30 +18,69 @@
     @author Ozires Bortolon de Faria ozires@aevumlab.com
 */
 
+
 #ifndef GDX_CPP_UTILS_XMLWRITER_HPP_
 #define GDX_CPP_UTILS_XMLWRITER_HPP_
 
+#include "StringView.hpp"
+
+#include <string>
+#include <vector>
+
 namespace gdx_cpp {
 namespace utils {
 
+class WriteBuffer;
+
+/** Writes indented XML straight into a WriteBuffer. Text and attribute values are escaped as they are copied, element
+ * names are written as they are. Each element starts on its own line, text longer than 64 characters too. */
 class XmlWriter {
 public:
-    XmlWriter& element (const std::string& name);
-    XmlWriter& element (const std::string& name,const Object& text);
-    XmlWriter& attribute (const std::string& name,const Object& value);
-    XmlWriter& text (const Object& text);
+    explicit XmlWriter (WriteBuffer& out);
+
+    XmlWriter& element (const StringView& name);
+    XmlWriter& element (const StringView& name, const StringView& text);
+
+    /** Adds an attribute to the element just started, throws std::runtime_error once it has content */
+    XmlWriter& attribute (const StringView& name, const StringView& value);
+    XmlWriter& attribute (const StringView& name, const char* value);
+    XmlWriter& attribute (const StringView& name, const std::string& value);
+    XmlWriter& attribute (const StringView& name, double value);
+    XmlWriter& attribute (const StringView& name, float value);
+    XmlWriter& attribute (const StringView& name, int value);
+    XmlWriter& attribute (const StringView& name, long long value);
+    XmlWriter& attribute (const StringView& name, bool value);
+
+    XmlWriter& text (const StringView& text);
+    XmlWriter& text (const char* text);
+    XmlWriter& text (const std::string& text);
+    XmlWriter& text (double value);
+    XmlWriter& text (float value);
+    XmlWriter& text (int value);
+    XmlWriter& text (long long value);
+
+    /** Ends the innermost element */
     XmlWriter& pop ();
+    /** Ends all open elements and flushes the buffer */
     void close ();
-    void write (int off,int len);
-    void flush ();
-
-protected:
 
+    /** Appends text with &, <, > and " replaced by entities */
+    static void writeEscaped (WriteBuffer& out, const StringView& text);
 
 private:
     void indent ();
-    bool startElementContent ();
-    Writer writer;
+    void startElementContent ();
+    XmlWriter& number (const char* text, int length);
+
+    WriteBuffer& out;
+    /** The names of the open elements back to back, nameStarts has where each begins */
+    std::string names;
+    std::vector<size_t> nameStarts;
+    /** The element's start tag is still open, so it can take attributes or be closed with /> */
+    bool inStartTag;
+    /** Nothing was written on the current line yet, so the next tag is indented */
+    bool atLineStart;
+    int indentation;
 };
 
 } // namespace gdx_cpp